@@ -37,6 +37,9 @@ ifeq ($(BUILD_PV_2WAY),1)
 include $(PV_TOP)/build_config/opencore_dynamic/Android_opencore_2way.mk
 ifeq ($(BUILD_PV_TEST_APPS),1)
 include $(PV_TOP)/engines/2way/test/Android.mk
+include $(PV_TOP)/protocols/systems/tools/general/test/Android.mk
+include $(PV_TOP)/protocols/systems/3g-324m_pvterminal/h223/test/Android.mk
+include $(PV_TOP)/protocols/systems/3g-324m_pvterminal/h245/per/test/Android.mk
 endif
 endif
 
@@ -44,6 +47,18 @@ ifeq ($(BUILD_PV_TEST_APPS),1)
 include $(PV_TOP)/oscl/unit_test/Android.mk
 include $(PV_TOP)/engines/player/test/Android.mk
 include $(PV_TOP)/engines/author/test/Android.mk
+include $(PV_TOP)/oscl/pvlogger/test/Android.mk
+include $(PV_TOP)/oscl/pvlogger/tools/Android.mk
+include $(PV_TOP)/baselibs/threadsafe_callback_ao/test/Android.mk
+include $(PV_TOP)/fileformats/common/parser/test/Android.mk
+include $(PV_TOP)/fileformats/mp4/composer/test/Android.mk
+include $(PV_TOP)/fileformats/mp4/composer/test/fast_start/Android.mk
+include $(PV_TOP)/pvmi/media_io/pvmiofileoutput/test/Android.mk
+include $(PV_TOP)/nodes/pvomxbasedecnode/test/Android.mk
+include $(PV_TOP)/nodes/pvdownloadmanagernode/test/Android.mk
+include $(PV_TOP)/nodes/streaming/jitterbuffernode/jitterbuffer/common/test/Android.mk
+include $(PV_TOP)/protocols/http_parcom/test/Android.mk
+include $(PV_TOP)/protocols/rtsp_parcom/test/Android.mk
 endif
 
 endif
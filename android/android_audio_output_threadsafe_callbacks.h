@@ -17,8 +17,8 @@
 #ifndef ANDROID_AUDIO_OUTPUT_THREADSAFE_CALLBACK_H_INCLUDED
 #define ANDROID_AUDIO_OUTPUT_THREADSAFE_CALLBACK_H_INCLUDED
 
-#ifndef THREADSAFE_CALLBACK_AO_H_INCLUDED
-#include "threadsafe_callback_ao.h"
+#ifndef THREADSAFE_LOCKFREE_QUEUE_H_INCLUDED
+#include "threadsafe_lockfree_queue.h"
 #endif
 
 #ifndef THREADSAFE_MEMPOOL_H_INCLUDED
@@ -29,11 +29,12 @@
 #include "oscl_mem_mempool.h"
 #endif
 
-#define PROCESS_MULTIPLE_EVENTS_IN_CALLBACK 1
-
 const char AudioOutputCallbackAOName[] = "AndroidAudioOutputTSCAO_Name";
 
-class AndroidAudioOutputThreadSafeCallbackAO : public ThreadSafeCallbackAO
+// Write completions come from the audio output thread only, so the
+// single-producer queue is used.  A burst of completions is handled with
+// one wakeup of this AO, and a full queue never blocks the audio thread.
+class AndroidAudioOutputThreadSafeCallbackAO : public ThreadSafeLockFreeCallbackAO
 {
 public:
     //Constructor
@@ -43,11 +44,6 @@ public:
                                            int32 aPriority = OsclActiveObject::EPriorityNominal
                                           );
     OsclReturnCode ProcessEvent(OsclAny* aEventData);
-    // When the following two have been implemented, make them virtual
-#if PROCESS_MULTIPLE_EVENTS_IN_CALLBACK
-    virtual void Run();
-    virtual OsclAny* Dequeue(OsclReturnCode &status);   
-#endif 
     virtual ~AndroidAudioOutputThreadSafeCallbackAO();
     ThreadSafeMemPoolFixedChunkAllocator *iMemoryPool;
 };
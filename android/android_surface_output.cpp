@@ -27,6 +27,7 @@
 #include "pvlogger.h"
 #include "pv_mime_string_utils.h"
 #include "oscl_snprintf.h"
+#include "pvmf_video.h"
 
 #include "oscl_dll.h"
 
@@ -49,6 +50,10 @@ OSCL_EXPORT_REF AndroidSurfaceOutput::AndroidSurfaceOutput() :
     mEmulation = false;
     iEosReceived = false;
     mNumberOfFramesToHold = 1;
+    mLastPostedOffset = 0;
+    mDirectPost = false;
+    mFrameSize = 0;
+    mDecoderBufferCount = 0;
 }
 
 status_t AndroidSurfaceOutput::set(PVPlayer* pvPlayer, const sp<ISurface>& surface, bool emulation)
@@ -81,6 +86,7 @@ void AndroidSurfaceOutput::initData()
     iVideoHeight = iVideoWidth = iVideoDisplayHeight = iVideoDisplayWidth = 0;
     iVideoFormat=PVMF_MIME_FORMAT_UNKNOWN;
     resetVideoParameterFlags();
+    iDecoderNumBuffers = iDecoderBufferSize = 0;
 
     iCommandCounter=0;
     iLogger=NULL;
@@ -102,6 +108,7 @@ void AndroidSurfaceOutput::ResetData()
     iVideoFormatString="";
     iVideoFormat=PVMF_MIME_FORMAT_UNKNOWN;
     resetVideoParameterFlags();
+    iDecoderNumBuffers = iDecoderBufferSize = 0;
     iIsMIOConfigured = false;
 }
 
@@ -331,7 +338,7 @@ void AndroidSurfaceOutput::postLastFrame()
 {
     // ignore if no surface or heap
     if ((mSurface == NULL) || (mBufferHeap.heap == NULL)) return;
-    mSurface->postBuffer(mFrameBuffers[mFrameBufferIndex]);
+    mSurface->postBuffer(mLastPostedOffset);
 }
 
 PVMFCommandId AndroidSurfaceOutput::Pause(const OsclAny* aContext)
@@ -763,6 +770,30 @@ PVMFStatus AndroidSurfaceOutput::getParametersSync(PvmiMIOSession aSession, Pvmi
         return PVMFSuccess;
     }
 
+    // The decoder asks for an output buffer allocator once it has sent the
+    // format specific info, which sized the decoder's part of the heap. Only
+    // offered when frames are posted without conversion; otherwise the
+    // decoder's own buffers do just as well.
+    if ((pv_mime_strcmp(aIdentifier, PVMF_BUFFER_ALLOCATOR_KEY) == 0) &&
+        mDirectPost && (mDecoderBufferCount > 0) && (mBufferHeap.heap != NULL))
+    {
+        AndroidSurfaceOutputBufferAlloc* alloc = OSCL_NEW(AndroidSurfaceOutputBufferAlloc,
+                (mBufferHeap.heap, kBufferCount * mFrameSize, mFrameSize, mDecoderBufferCount));
+        if (alloc == NULL) return PVMFErrNoMemory;
+
+        aParameters=(PvmiKvp*)oscl_malloc(sizeof(PvmiKvp));
+        if (aParameters == NULL)
+        {
+            OSCL_DELETE(alloc);
+            return PVMFErrNoMemory;
+        }
+        aParameters[0].value.key_specific_value = (PVInterface*)alloc;
+        num_parameter_elements = 1;
+
+        LOGV("offering %d decoder buffers of %d bytes", alloc->getNumBuffers(), alloc->getBufferSize());
+        return PVMFSuccess;
+    }
+
     //unrecognized key.
     return PVMFFailure;
 }
@@ -845,6 +876,24 @@ void AndroidSurfaceOutput::setParametersSync(PvmiMIOSession aSession, PvmiKvp* a
             PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_STACK_TRACE,
                 (0,"AndroidSurfaceOutput::setParametersSync() Video Display Width Key, Value %d",iVideoDisplayWidth));
         }
+        else if (pv_mime_strcmp(aParameters[i].key, PVMF_FORMAT_SPECIFIC_INFO_KEY_YUV) == 0)
+        {
+            // all the video parameters at once, plus the decoder's buffers
+            PVMFYuvFormatSpecificInfo0* yuvInfo = (PVMFYuvFormatSpecificInfo0*)aParameters[i].value.key_specific_value;
+            iVideoWidth = (int32)yuvInfo->width;
+            iVideoHeight = (int32)yuvInfo->height;
+            iVideoDisplayWidth = (int32)yuvInfo->display_width;
+            iVideoDisplayHeight = (int32)yuvInfo->display_height;
+            iVideoSubFormat = yuvInfo->video_format;
+            iVideoParameterFlags |= VIDEO_PARAMETERS_VALID;
+            iDecoderNumBuffers = yuvInfo->num_buffers;
+            iDecoderBufferSize = yuvInfo->buffer_size;
+            LOGV("yuv info %d x %d, display %d x %d, %d buffers of %d bytes", iVideoWidth, iVideoHeight,
+                    iVideoDisplayWidth, iVideoDisplayHeight, iDecoderNumBuffers, iDecoderBufferSize);
+            PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_STACK_TRACE,
+                (0,"AndroidSurfaceOutput::setParametersSync() YUV Format Specific Info, %d x %d, %d buffers of %d bytes",
+                 iVideoWidth, iVideoHeight, iDecoderNumBuffers, iDecoderBufferSize));
+        }
         else if (pv_mime_strcmp(aParameters[i].key, MOUT_VIDEO_SUBFORMAT_KEY) == 0)
         {
             iVideoSubFormat=aParameters[i].value.pChar_value;
@@ -961,38 +1010,65 @@ OSCL_EXPORT_REF bool AndroidSurfaceOutput::initCheck()
     int frameHeight = iVideoHeight;
     int frameSize;
 
-    // RGB-565 frames are 2 bytes/pixel
     displayWidth = (displayWidth + 1) & -2;
     displayHeight = (displayHeight + 1) & -2;
     frameWidth = (frameWidth + 1) & -2;
     frameHeight = (frameHeight + 1) & -2;
-    frameSize = frameWidth * frameHeight * 2;
 
-    // create frame buffer heap and register with surfaceflinger
-    sp<MemoryHeapBase> heap = new MemoryHeapBase(frameSize * kBufferCount);
+    // post the decoder's frames as is when the surface takes its format,
+    // otherwise convert them to RGB-565
+    int pixelFormat = PIXEL_FORMAT_RGB_565;
+    mDirectPost = getSurfacePixelFormat(iVideoSubFormat, pixelFormat);
+    mDecoderBufferCount = 0;
+    if (mDirectPost) {
+        if (pixelFormat == PIXEL_FORMAT_RGB_565) {
+            frameSize = frameWidth * frameHeight * 2;
+        } else {
+            // YUV420 frames are 1.5 bytes/pixel
+            frameSize = (frameWidth * frameHeight * 3) / 2;
+        }
+        if ((int)iDecoderBufferSize > frameSize) frameSize = iDecoderBufferSize;
+        frameSize = oscl_mem_aligned_size(frameSize);
+        // room for the decoder's buffers plus the frames held here
+        if (iDecoderNumBuffers > 0) {
+            mDecoderBufferCount = iDecoderNumBuffers + mNumberOfFramesToHold;
+        }
+    } else {
+        // RGB-565 frames are 2 bytes/pixel
+        frameSize = frameWidth * frameHeight * 2;
+    }
+    mFrameSize = frameSize;
+
+    // create frame buffer heap and register with surfaceflinger; the
+    // copy buffers come first, then the decoder's buffers
+    sp<MemoryHeapBase> heap = new MemoryHeapBase(frameSize * (kBufferCount + mDecoderBufferCount));
     if (heap->heapID() < 0) {
         LOGE("Error creating frame buffer heap");
         return false;
     }
-    
+
     mBufferHeap = ISurface::BufferHeap(displayWidth, displayHeight,
-            frameWidth, frameHeight, PIXEL_FORMAT_RGB_565, heap);
+            frameWidth, frameHeight, pixelFormat, heap);
     mSurface->registerBuffers(mBufferHeap);
 
     // create frame buffers
     for (int i = 0; i < kBufferCount; i++) {
         mFrameBuffers[i] = i * frameSize;
     }
+    mLastPostedOffset = mFrameBuffers[0];
 
     // initialize software color converter
-    iColorConverter = ColorConvert16::NewL();
-    iColorConverter->Init(displayWidth, displayHeight, frameWidth, displayWidth, displayHeight, displayWidth, CCROTATE_NONE);
-    iColorConverter->SetMemHeight(frameHeight);
-    iColorConverter->SetMode(1);
+    if (!mDirectPost) {
+        iColorConverter = ColorConvert16::NewL();
+        iColorConverter->Init(displayWidth, displayHeight, frameWidth, displayWidth, displayHeight, displayWidth, CCROTATE_NONE);
+        iColorConverter->SetMemHeight(frameHeight);
+        iColorConverter->SetMode(1);
+    }
 
     LOGV("video = %d x %d", displayWidth, displayHeight);
     LOGV("frame = %d x %d", frameWidth, frameHeight);
     LOGV("frame #bytes = %d", frameSize);
+    LOGV("direct post %d, %d decoder buffers", mDirectPost, mDecoderBufferCount);
 
     // register frame buffers with SurfaceFlinger
     mFrameBufferIndex = 0;
@@ -1006,13 +1082,44 @@ OSCL_EXPORT_REF PVMFStatus AndroidSurfaceOutput::writeFrameBuf(uint8* aData, uin
 {
     // post to SurfaceFlinger
     if ((mSurface != NULL) && (mBufferHeap.heap != NULL)) {
-        if (++mFrameBufferIndex == kBufferCount) mFrameBufferIndex = 0;
-        iColorConverter->Convert(aData, static_cast<uint8*>(mBufferHeap.heap->base()) + mFrameBuffers[mFrameBufferIndex]);
-        mSurface->postBuffer(mFrameBuffers[mFrameBufferIndex]);
+        uint8* base = static_cast<uint8*>(mBufferHeap.heap->base());
+        uint8* decoderBuffers = base + kBufferCount * mFrameSize;
+        uint8* heapEnd = base + mBufferHeap.heap->getSize();
+        if (mDirectPost && (aData >= decoderBuffers) && (aData + mFrameSize <= heapEnd)) {
+            // decoded into one of the buffers handed out by the allocator
+            mLastPostedOffset = aData - base;
+        } else {
+            if (++mFrameBufferIndex == kBufferCount) mFrameBufferIndex = 0;
+            uint8* dst = base + mFrameBuffers[mFrameBufferIndex];
+            if (mDirectPost) {
+                // the decoder fell back to its own buffers
+                oscl_memcpy(dst, aData, (aDataLen < mFrameSize) ? aDataLen : mFrameSize);
+            } else {
+                iColorConverter->Convert(aData, dst);
+            }
+            mLastPostedOffset = mFrameBuffers[mFrameBufferIndex];
+        }
+        mSurface->postBuffer(mLastPostedOffset);
     }
     return PVMFSuccess;
 }
 
+// Map a decoder output format to a surface pixel format the surface shows
+// without conversion. Returns false, leaving aPixelFormat alone, for formats
+// that have to be converted.
+bool AndroidSurfaceOutput::getSurfacePixelFormat(PVMFFormatType aFormat, int& aPixelFormat)
+{
+    if (aFormat == PVMF_MIME_RGB16) {
+        aPixelFormat = PIXEL_FORMAT_RGB_565;
+        return true;
+    }
+    if (aFormat == PVMF_MIME_YUV420_SEMIPLANAR_YVU) {
+        aPixelFormat = HAL_PIXEL_FORMAT_YCbCr_420_SP;
+        return true;
+    }
+    return false;
+}
+
 OSCL_EXPORT_REF void AndroidSurfaceOutput::closeFrameBuf()
 {
     LOGV("closeFrameBuf");
@@ -1029,6 +1136,7 @@ OSCL_EXPORT_REF void AndroidSurfaceOutput::closeFrameBuf()
     for (int i = 0; i < kBufferCount; i++) {
         mFrameBuffers[i] = 0;
     }
+    mLastPostedOffset = 0;
 
     // free heaps
     LOGV("free frame heap");
@@ -1049,3 +1157,75 @@ OSCL_EXPORT_REF bool AndroidSurfaceOutput::GetVideoSize(int *w, int *h) {
     *h = iVideoDisplayHeight;
     return iVideoDisplayWidth != 0 && iVideoDisplayHeight != 0;
 }
+
+AndroidSurfaceOutputBufferAlloc::AndroidSurfaceOutputBufferAlloc(const sp<IMemoryHeap>& aHeap,
+        size_t aOffset, uint32 aBufferSize, uint32 aNumBuffers)
+    : iRefCount(0), iBufferSize(aBufferSize), iNumBuffers(0), iHeap(aHeap)
+{
+    // with no memory, getNumBuffers() returns 0 and the decoder uses its
+    // own buffers
+    int32 err;
+    OSCL_TRY(err, iFreeBuffers.reserve(aNumBuffers););
+    if (err != OsclErrNone) return;
+    uint8* block = static_cast<uint8*>(iHeap->base()) + aOffset;
+    for (uint32 i = 0; i < aNumBuffers; i++) {
+        iFreeBuffers.push_back(block + i * aBufferSize);
+    }
+    iNumBuffers = aNumBuffers;
+}
+
+AndroidSurfaceOutputBufferAlloc::~AndroidSurfaceOutputBufferAlloc()
+{
+    if (iFreeBuffers.size() != iNumBuffers) {
+        LOGE("%d decoder buffers still in use", iNumBuffers - iFreeBuffers.size());
+    }
+    iHeap.clear();
+}
+
+void AndroidSurfaceOutputBufferAlloc::addRef()
+{
+    ++iRefCount;
+}
+
+void AndroidSurfaceOutputBufferAlloc::removeRef()
+{
+    if (--iRefCount <= 0) {
+        OSCL_DELETE(this);
+    }
+}
+
+bool AndroidSurfaceOutputBufferAlloc::queryInterface(const PVUuid& uuid, PVInterface*& aInterface)
+{
+    aInterface = NULL;
+    if (PVMFFixedSizeBufferAllocUUID == uuid) {
+        PVMFFixedSizeBufferAlloc* myInterface = OSCL_STATIC_CAST(PVMFFixedSizeBufferAlloc*, this);
+        addRef();
+        aInterface = OSCL_STATIC_CAST(PVInterface*, myInterface);
+        return true;
+    }
+    return false;
+}
+
+OsclAny* AndroidSurfaceOutputBufferAlloc::allocate()
+{
+    if (iFreeBuffers.empty()) return NULL;
+    OsclAny* ptr = iFreeBuffers.back();
+    iFreeBuffers.pop_back();
+    return ptr;
+}
+
+void AndroidSurfaceOutputBufferAlloc::deallocate(OsclAny* ptr)
+{
+    if (ptr == NULL) return;
+    iFreeBuffers.push_back(ptr);
+}
+
+uint32 AndroidSurfaceOutputBufferAlloc::getBufferSize()
+{
+    return iBufferSize;
+}
+
+uint32 AndroidSurfaceOutputBufferAlloc::getNumBuffers()
+{
+    return iNumBuffers;
+}
@@ -27,6 +27,8 @@
 #include "pvmi_config_and_capability.h"
 #include "oscl_string_containers.h"
 #include "pvmi_media_io_clock_extension.h"
+#include "pv_interface.h"
+#include "pvmf_fixedsize_buffer_alloc.h"
 
 #ifdef PERFORMANCE_MEASUREMENTS_ENABLED
 #include "pvprofile.h"
@@ -82,6 +84,38 @@ using namespace android;
 // FIXME: Not used?
 // typedef void (*frame_decoded_f)(void *cookie, int width, int height, int pitch, int format, uint8* data);
 
+// Fixed size allocator for the decoder's output buffers, offered through
+// PVMF_BUFFER_ALLOCATOR_KEY when the surface can show the decoder's format as
+// is. The buffers are carved out of the frame buffer heap registered with the
+// surface, so the decoder's OMX component decodes into memory that
+// writeFrameBuf posts by offset. The allocator holds a reference to the heap
+// and deletes itself when the last reference is removed.
+class AndroidSurfaceOutputBufferAlloc : public PVInterface, public PVMFFixedSizeBufferAlloc
+{
+public:
+    AndroidSurfaceOutputBufferAlloc(const sp<IMemoryHeap>& aHeap, size_t aOffset,
+            uint32 aBufferSize, uint32 aNumBuffers);
+    virtual ~AndroidSurfaceOutputBufferAlloc();
+
+    // From PVInterface
+    void addRef();
+    void removeRef();
+    bool queryInterface(const PVUuid& uuid, PVInterface*& aInterface);
+
+    // From PVMFFixedSizeBufferAlloc
+    OsclAny* allocate();
+    void deallocate(OsclAny* ptr);
+    uint32 getBufferSize();
+    uint32 getNumBuffers();
+
+private:
+    int32 iRefCount;
+    uint32 iBufferSize;
+    uint32 iNumBuffers;
+    sp<IMemoryHeap> iHeap;
+    Oscl_Vector<OsclAny*, OsclMemAllocator> iFreeBuffers;
+};
+
 // This class implements the reference media IO for file output.
 // This class constitutes the Media IO component
 
@@ -288,6 +322,10 @@ protected:
     PVMFFormatType iVideoSubFormat;
     bool iVideoSubFormatValid;
 
+    // decoder output buffers, from the format specific info; 0 until known
+    uint32 iDecoderNumBuffers;
+    uint32 iDecoderBufferSize;
+
     //For logging
     PVLogger* iLogger;
 
@@ -309,6 +347,16 @@ protected:
     int                         mFrameBufferIndex;
     ISurface::BufferHeap        mBufferHeap;
     size_t                      mFrameBuffers[kBufferCount];
+    size_t                      mLastPostedOffset;
+
+    // When the decoder's output format is one the surface takes as is, the
+    // heap is registered in that format and frames are posted without color
+    // conversion. The decoder's buffers then follow the kBufferCount copy
+    // buffers in the heap, mDecoderBufferCount of mFrameSize bytes each.
+    bool                        mDirectPost;
+    size_t                      mFrameSize;
+    uint32                      mDecoderBufferCount;
+    bool getSurfacePixelFormat(PVMFFormatType aFormat, int& aPixelFormat);
 
     void convertFrame(void* src, void* dst, size_t len);
     //This bool is set true when all necassary parameters have been received.
@@ -32,6 +32,7 @@
 #include "pv_mime_string_utils.h"
 #include "pv_id3_parcom_constants.h"
 #include "oscl_utf8conv.h"
+#include "oscl_tickcount.h"
 #include "imp3ff.h"
 #include "impeg4file.h"
 
@@ -46,6 +47,8 @@
 #include "media/mediametadataretriever.h"
 
 #include <media/thread_init.h>
+#include <utils/threads.h>
+#include <pthread.h>
 
 #define MAX_BUFF_SIZE   1024
 
@@ -68,14 +71,38 @@ PVMediaScanner::PVMediaScanner() {}
 
 PVMediaScanner::~PVMediaScanner() {}
 
-static PVMFStatus parseMP3(const char *filename, MediaScannerClient& client)
+// Per-thread state kept across the files scanned by one thread, so that
+// the file server connection and the ID3 parser are set up once instead
+// of once per file.  Must be created after InitializeForThread.
+struct ScanContext
 {
-    PVID3ParCom pvId3Param;
+    ScanContext() : fsConnected(false) {}
+    ~ScanContext()
+    {
+        if (fsConnected)
+            fs.Close();
+    }
+
+    Oscl_FileServer* fileServer()
+    {
+        if (!fsConnected && fs.Connect() == 0)
+            fsConnected = true;
+        return fsConnected ? &fs : NULL;
+    }
+
+    Oscl_FileServer fs;
+    bool fsConnected;
+    PVID3ParCom id3;
+};
+
+static PVMFStatus parseMP3(const char *filename, MediaScannerClient& client, ScanContext& context)
+{
+    PVID3ParCom& pvId3Param = context.id3;
     PVFile fileHandle;
-    Oscl_FileServer iFs;
     uint32 duration;
 
-    if (iFs.Connect() != 0)
+    Oscl_FileServer* iFs = context.fileServer();
+    if (!iFs)
     {
         LOGE("iFs.Connect failed\n");
         return PVMFFailure;
@@ -83,20 +110,23 @@ static PVMFStatus parseMP3(const char *filename, MediaScannerClient& client)
 
     oscl_wchar output[MAX_BUFF_SIZE];
     oscl_UTF8ToUnicode((const char *)filename, oscl_strlen((const char *)filename), (oscl_wchar *)output, MAX_BUFF_SIZE);
-    if (0 != fileHandle.Open((oscl_wchar *)output, Oscl_File::MODE_READ | Oscl_File::MODE_BINARY, iFs) )
+    if (0 != fileHandle.Open((oscl_wchar *)output, Oscl_File::MODE_READ | Oscl_File::MODE_BINARY, *iFs) )
     {
         LOGE("Could not open the input file for reading(Test: parse id3).\n");
         return PVMFFailure;
     }
 
+    // only index the tag while parsing; the frame values are read below and
+    // album art is returned by reference, so the picture is never copied
+    pvId3Param.Reset();
+    pvId3Param.SetLazyParsing(true);
     fileHandle.Seek(0, Oscl_File::SEEKSET);
     pvId3Param.ParseID3Tag(&fileHandle);
-    fileHandle.Close();
-    iFs.Close();
 
     //Get the frames information from ID3 library
     PvmiKvpSharedPtrVector framevector;
     pvId3Param.GetID3Frames(framevector);
+    fileHandle.Close();
 
     uint32 num_frames = framevector.size();
 
@@ -190,7 +220,7 @@ static PVMFStatus parseMP3(const char *filename, MediaScannerClient& client)
     {
         OSCL_wHeapString<OsclMemAllocator> mp3filename(output);
         MP3ErrorType    err;
-        IMpeg3File mp3File(mp3filename, err);
+        IMpeg3File mp3File(mp3filename, err, iFs);
         if (err != MP3_SUCCESS) {
             LOGE("IMpeg3File constructor returned %d for %s\n", err, filename);
             return err;
@@ -329,12 +359,10 @@ failure:
     return PVMFFailure;
 }
 
-static PVMFStatus parseMP4(const char *filename, MediaScannerClient& client)
+static PVMFStatus parseMP4(const char *filename, MediaScannerClient& client, ScanContext& context)
 {
-    PVFile fileHandle;
-    Oscl_FileServer iFs;
-
-    if (iFs.Connect() != 0)
+    Oscl_FileServer* iFs = context.fileServer();
+    if (!iFs)
     {
         LOGE("Connection with the file server for the parse id3 test failed.\n");
         return PVMFFailure;
@@ -344,7 +372,7 @@ static PVMFStatus parseMP4(const char *filename, MediaScannerClient& client)
     oscl_UTF8ToUnicode((const char *)filename, oscl_strlen((const char *)filename), (oscl_wchar *)output, MAX_BUFF_SIZE);
     OSCL_wHeapString<OsclMemAllocator> mpegfilename(output);
 
-    IMpeg4File *mp4Input = IMpeg4File::readMP4File(mpegfilename, NULL, NULL, 1 /* parsing_mode */, &iFs);
+    IMpeg4File *mp4Input = IMpeg4File::readMP4File(mpegfilename, NULL, NULL, 1 /* parsing_mode */, iFs);
     if (mp4Input)
     {
         // check to see if the file contains video
@@ -403,14 +431,12 @@ static PVMFStatus parseMP4(const char *filename, MediaScannerClient& client)
             } else if (hasAudio) {
                 if (!client.setMimeType("audio/mp4")) return PVMFFailure;
             } else {
-                iFs.Close();
                 IMpeg4File::DestroyMP4FileObject(mp4Input);
                 return PVMFFailure;
             }
         }
 
         PVMFStatus result = reportM4ATags(mp4Input, client);
-        iFs.Close();
         IMpeg4File::DestroyMP4FileObject(mp4Input);
         return result;
     }
@@ -562,25 +588,25 @@ static PVMFStatus parseWMA(const char *filename, MediaScannerClient& client)
     return PVMFSuccess;
 }
 
-status_t PVMediaScanner::processFile(const char *path, const char* mimeType, MediaScannerClient& client)
+static status_t scanFile(const char *path, const char* mimeType, const char* locale,
+        MediaScannerClient& client, ScanContext& context)
 {
     status_t result;
-    InitializeForThread();
 
-    client.setLocale(locale());
+    client.setLocale(locale);
     client.beginFile();
     
     //LOGD("processFile %s mimeType: %s\n", path, mimeType);
     const char* extension = strrchr(path, '.');
 
     if (extension && strcasecmp(extension, ".mp3") == 0) {
-        result = parseMP3(path, client);
+        result = parseMP3(path, client, context);
     } else if (extension &&
         (strcasecmp(extension, ".mp4") == 0 || strcasecmp(extension, ".m4a") == 0 ||
          strcasecmp(extension, ".3gp") == 0 || strcasecmp(extension, ".3gpp") == 0 ||
          strcasecmp(extension, ".3g2") == 0 || strcasecmp(extension, ".3gpp2") == 0 ||
          strcasecmp(extension, ".mpeg") == 0)) {
-        result = parseMP4(path, client);
+        result = parseMP4(path, client, context);
     } else if (extension && strcasecmp(extension, ".ogg") == 0) {
         result = parseOgg(path, client);
     } else if (extension &&
@@ -601,6 +627,122 @@ status_t PVMediaScanner::processFile(const char *path, const char* mimeType, Med
     return result;
 }
 
+status_t PVMediaScanner::processFile(const char *path, const char* mimeType, MediaScannerClient& client)
+{
+    InitializeForThread();
+
+    ScanContext context;
+    return scanFile(path, mimeType, locale(), client, context);
+}
+
+// State shared by the workers of one processFiles call.  Workers take the
+// next unscanned file under the lock.
+struct ScanBatch
+{
+    const char *const *paths;
+    const char *const *mimeTypes;
+    size_t count;
+    const char* locale;
+
+    Mutex lock;
+    size_t next;
+    size_t failures;
+};
+
+struct ScanWorker
+{
+    ScanBatch* batch;
+    MediaScannerClient* client;
+    pthread_t thread;
+};
+
+static void* scanWorkerThread(void* arg)
+{
+    ScanWorker* worker = (ScanWorker*)arg;
+    ScanBatch* batch = worker->batch;
+
+    // the thread exit hook set up by InitializeForThread uninitializes PV
+    InitializeForThread();
+    ScanContext* context = new ScanContext;
+
+    for (;;) {
+        size_t index;
+        {
+            Mutex::Autolock autoLock(batch->lock);
+            if (batch->next >= batch->count) break;
+            index = batch->next++;
+        }
+
+        status_t result = scanFile(batch->paths[index],
+                batch->mimeTypes ? batch->mimeTypes[index] : NULL,
+                batch->locale, *worker->client, *context);
+        if (result != PVMFSuccess) {
+            Mutex::Autolock autoLock(batch->lock);
+            batch->failures++;
+        }
+    }
+
+    delete context;
+    return NULL;
+}
+
+status_t PVMediaScanner::processFiles(
+        const char *const *paths, const char *const *mimeTypes,
+        size_t count, MediaScannerClient **clients, int numThreads,
+        BatchStats *stats)
+{
+    if (!paths || !clients) return BAD_VALUE;
+    if (numThreads < 1) numThreads = 1;
+    if ((size_t)numThreads > count) numThreads = count;
+
+    InitializeForThread();
+    uint32 startTicks = OsclTickCount::TickCount();
+
+    ScanBatch batch;
+    batch.paths = paths;
+    batch.mimeTypes = mimeTypes;
+    batch.count = count;
+    batch.locale = locale();
+    batch.next = 0;
+    batch.failures = 0;
+
+    ScanWorker* workers = new ScanWorker[numThreads];
+    int started = 0;
+    for (int i = 0; i < numThreads; ++i) {
+        workers[i].batch = &batch;
+        workers[i].client = clients[i];
+        if (pthread_create(&workers[i].thread, NULL, scanWorkerThread, &workers[i]) != 0) {
+            LOGE("processFiles: could not start worker %d", i);
+            break;
+        }
+        ++started;
+    }
+
+    if (started == 0 && count > 0) {
+        // scan on this thread rather than not at all
+        workers[0].batch = &batch;
+        workers[0].client = clients[0];
+        scanWorkerThread(&workers[0]);
+    }
+    for (int i = 0; i < started; ++i) {
+        pthread_join(workers[i].thread, NULL);
+    }
+    delete[] workers;
+
+    uint32 elapsedMs = OsclTickCount::TicksToMsec(OsclTickCount::TickCount() - startTicks);
+    uint32 filesPerSecond = elapsedMs ? (uint32)((uint64)count * 1000 / elapsedMs) : count;
+    LOGI("processFiles: %zu files (%zu failed) in %u ms on %d threads, %u files/s",
+            count, batch.failures, elapsedMs, started ? started : 1, filesPerSecond);
+
+    if (stats) {
+        stats->files = count;
+        stats->failures = batch.failures;
+        stats->elapsedMs = elapsedMs;
+        stats->filesPerSecond = filesPerSecond;
+    }
+    return OK;
+}
+
 static char* doExtractAlbumArt(PvmfApicStruct* aApic)
 {
     char *data = (char*)malloc(aApic->iGraphicDataLen + 4);
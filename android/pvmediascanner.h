@@ -19,6 +19,22 @@ public:
     // extracts album art as a block of data
     virtual char *extractAlbumArt(int fd);
 
+    struct BatchStats {
+        size_t files;
+        size_t failures;
+        uint32_t elapsedMs;
+        uint32_t filesPerSecond;
+    };
+
+    // Scans count files on numThreads worker threads.  Each worker keeps
+    // its file server connection and ID3 parser across files, and reports
+    // the tags of the files it scans to clients[worker], so a client is
+    // only ever called from one thread.  mimeTypes may be NULL.
+    status_t processFiles(
+            const char *const *paths, const char *const *mimeTypes,
+            size_t count, MediaScannerClient **clients, int numThreads,
+            BatchStats *stats = NULL);
+
     static void uninitializeForThread();
 
 private:
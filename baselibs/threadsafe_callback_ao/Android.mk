@@ -4,7 +4,9 @@ include $(CLEAR_VARS)
 LOCAL_SRC_FILES := \
 	src/threadsafe_callback_ao.cpp \
  	src/threadsafe_mempool.cpp \
- 	src/threadsafe_queue.cpp
+ 	src/threadsafe_queue.cpp \
+ 	src/threadsafe_lockfree_queue.cpp \
+ 	src/threadsafe_lockfree_mempool.cpp
 
 
 LOCAL_MODULE := libthreadsafe_callback_ao
@@ -27,6 +29,9 @@ LOCAL_COPY_HEADERS_TO := $(PV_COPY_HEADERS_TO)
 LOCAL_COPY_HEADERS := \
 	src/threadsafe_callback_ao.h \
  	src/threadsafe_mempool.h \
- 	src/threadsafe_queue.h
+ 	src/threadsafe_queue.h \
+ 	src/threadsafe_atomic.h \
+ 	src/threadsafe_lockfree_queue.h \
+ 	src/threadsafe_lockfree_mempool.h
 
 include $(BUILD_STATIC_LIBRARY)
@@ -14,11 +14,16 @@ INCSRCDIR := ../../src
 # compose final src list for actual build
 SRCS := threadsafe_callback_ao.cpp \
         threadsafe_mempool.cpp \
-        threadsafe_queue.cpp
+        threadsafe_queue.cpp \
+        threadsafe_lockfree_queue.cpp \
+        threadsafe_lockfree_mempool.cpp
 
 
 HDRS := threadsafe_callback_ao.h \
 	threadsafe_mempool.h \
-	threadsafe_queue.h
+	threadsafe_queue.h \
+	threadsafe_atomic.h \
+	threadsafe_lockfree_queue.h \
+	threadsafe_lockfree_mempool.h
 
 include $(MK)/library.mk
@@ -0,0 +1,64 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#ifndef THREADSAFE_ATOMIC_H_INCLUDED
+#define THREADSAFE_ATOMIC_H_INCLUDED
+
+#ifndef OSCL_BASE_H_INCLUDED
+#include "oscl_base.h"
+#endif
+
+/*
+** Atomic primitives for the lock-free queues and mempool.
+** OSCL has none, so GCC builtins are used where available.  A build can
+** supply its own definitions of THREADSAFE_BARRIER, THREADSAFE_CAS32 and
+** THREADSAFE_ADD32 instead.  When none are available THREADSAFE_HAS_ATOMICS
+** is 0 and the lock-free classes fall back to a mutex on the multi-producer
+** paths and for the wakeup flag; the single-producer paths then rely on the
+** platform not reordering stores, which holds for the non-preemptive OS
+** builds that lack the builtins.
+*/
+#ifndef THREADSAFE_BARRIER
+#if defined(__GNUC__)
+#define THREADSAFE_HAS_ATOMICS 1
+#define THREADSAFE_BARRIER() __sync_synchronize()
+#define THREADSAFE_CAS32(ptr, oldval, newval) __sync_bool_compare_and_swap((ptr), (oldval), (newval))
+#define THREADSAFE_ADD32(ptr, val) __sync_add_and_fetch((ptr), (val))
+#else
+#define THREADSAFE_HAS_ATOMICS 0
+#define THREADSAFE_BARRIER()
+#endif
+#else
+#define THREADSAFE_HAS_ATOMICS 1
+#endif
+
+/*
+** THREADSAFE_ORDER keeps loads and stores on either side of it in program
+** order as seen by other threads, except that a store may still pass a
+** later load.  That is all a publish or a consume needs.  x86 only
+** reorders that one case, so there it only has to stop the compiler.
+*/
+#ifndef THREADSAFE_ORDER
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define THREADSAFE_ORDER() __asm__ __volatile__("" : : : "memory")
+#else
+#define THREADSAFE_ORDER() THREADSAFE_BARRIER()
+#endif
+#endif
+
+#endif // THREADSAFE_ATOMIC_H_INCLUDED
+
@@ -0,0 +1,291 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#include "threadsafe_lockfree_mempool.h"
+
+OSCL_EXPORT_REF ThreadSafeLockFreeMemPoolFixedChunkAllocator *ThreadSafeLockFreeMemPoolFixedChunkAllocator::Create(const uint32 numchunk, const uint32 chunksize, Oscl_DefAlloc *gen_alloc, bool multithreadfree)
+{
+    OsclAny *ptr = NULL;
+    if (gen_alloc)
+    {
+        ptr = gen_alloc->ALLOCATE(sizeof(ThreadSafeLockFreeMemPoolFixedChunkAllocator));
+    }
+    else
+    {
+        ptr = OSCL_MALLOC(sizeof(ThreadSafeLockFreeMemPoolFixedChunkAllocator));
+    }
+
+    if (ptr == NULL)
+    {
+        return NULL;
+    }
+
+    ThreadSafeLockFreeMemPoolFixedChunkAllocator *self = OSCL_PLACEMENT_NEW(ptr, ThreadSafeLockFreeMemPoolFixedChunkAllocator(numchunk, chunksize, gen_alloc, multithreadfree));
+    return self;
+}
+
+OSCL_EXPORT_REF void ThreadSafeLockFreeMemPoolFixedChunkAllocator::Delete()
+{
+    Oscl_DefAlloc* alloc = iMemPoolAllocator;
+    this->~ThreadSafeLockFreeMemPoolFixedChunkAllocator();
+    if (alloc)
+    {
+        alloc->deallocate(this);
+    }
+    else
+    {
+        OSCL_FREE(this);
+    }
+}
+
+OSCL_EXPORT_REF ThreadSafeLockFreeMemPoolFixedChunkAllocator::ThreadSafeLockFreeMemPoolFixedChunkAllocator(const uint32 numchunk, const uint32 chunksize, Oscl_DefAlloc* gen_alloc, bool multithreadfree) :
+        iNumChunk(1), iChunkSize(0), iChunkSizeMemAligned(0),
+        iMemPoolAllocator(gen_alloc), iMemPool(NULL),
+        iMultiThreadFree(multithreadfree),
+        iCheckNextAvailableFreeChunk(0), iObserver(NULL),
+        iNextAvailableContextData(NULL),
+        iRefCount(1)
+{
+    iNumChunk = numchunk;
+    iChunkSize = chunksize;
+
+    if (iNumChunk == 0)
+    {
+        iNumChunk = 1;
+    }
+
+#if !THREADSAFE_HAS_ATOMICS
+    iMemPoolMutex.Create();
+#endif
+
+    if (iChunkSize > 0)
+    {
+        createmempool();
+    }
+}
+
+int32 ThreadSafeLockFreeMemPoolFixedChunkAllocator::addRef_internal(int32 aDelta)
+{
+#if THREADSAFE_HAS_ATOMICS
+    return THREADSAFE_ADD32(&iRefCount, aDelta);
+#else
+    iMemPoolMutex.Lock();
+    int32 refcount = (iRefCount += aDelta);
+    iMemPoolMutex.Unlock();
+    return refcount;
+#endif
+}
+
+OSCL_EXPORT_REF void ThreadSafeLockFreeMemPoolFixedChunkAllocator::addRef()
+{
+    addRef_internal(1);
+}
+
+OSCL_EXPORT_REF void ThreadSafeLockFreeMemPoolFixedChunkAllocator::removeRef()
+{
+    // If ref count reaches 0 then destroy this object automatically
+    if (addRef_internal(-1) <= 0)
+    {
+        Delete();
+    }
+}
+
+
+OSCL_EXPORT_REF ThreadSafeLockFreeMemPoolFixedChunkAllocator::~ThreadSafeLockFreeMemPoolFixedChunkAllocator()
+{
+    // Decrement the ref count
+    --iRefCount;
+
+    // If ref count reaches 0 then destroy this object
+    if (iRefCount <= 0)
+    {
+        destroymempool();
+    }
+#if !THREADSAFE_HAS_ATOMICS
+    iMemPoolMutex.Close();
+#endif
+}
+
+
+OSCL_EXPORT_REF OsclAny* ThreadSafeLockFreeMemPoolFixedChunkAllocator::allocate(const uint32 n)
+{
+    // Create the memory pool if it hasn't been created yet.
+    // Use the allocation size, n, as the chunk size for memory pool
+    if (iChunkSize == 0)
+    {
+        iChunkSize = n;
+        createmempool();
+    }
+    else if (n > iChunkSize)
+    {
+        OSCL_LEAVE(OsclErrArgument);
+    }
+
+    uint32 id;
+    OsclAny* freechunk;
+    if (!iFreeMemChunkList.Pop(id, freechunk))
+    {
+        // No free chunk is available
+        return NULL;
+    }
+
+    addRef_internal(1);
+    return freechunk;
+}
+
+
+OSCL_EXPORT_REF void ThreadSafeLockFreeMemPoolFixedChunkAllocator::deallocate(OsclAny* p)
+{
+    if (iMemPool == NULL)
+    {
+        // Memory pool hasn't been allocated yet so error
+        OSCL_LEAVE(OsclErrNotReady);
+    }
+
+    uint8* ptmp = (uint8*)p;
+    uint8* mptmp = (uint8*)iMemPool;
+
+    if ((ptmp < mptmp) || ptmp >= (mptmp + iNumChunk*iChunkSizeMemAligned))
+    {
+        // Returned memory is not part of this memory pool
+        OSCL_LEAVE(OsclErrArgument);
+    }
+
+    if (((ptmp - mptmp) % iChunkSizeMemAligned) != 0)
+    {
+        // Returned memory is not aligned to the chunk.
+        OSCL_LEAVE(OsclErrArgument);
+    }
+
+    // Put the returned chunk in the free pool.  The ring holds every chunk
+    // so this can't fail.
+    iFreeMemChunkList.Push(0, p);
+
+    if (addRef_internal(-1) > 0)
+    {
+        // Notify the observer about free chunk available if waiting for such
+        // callback.  Only the thread that clears the flag makes the call.
+        bool notify;
+#if THREADSAFE_HAS_ATOMICS
+        notify = iCheckNextAvailableFreeChunk && THREADSAFE_CAS32(&iCheckNextAvailableFreeChunk, 1, 0);
+#else
+        iMemPoolMutex.Lock();
+        notify = (iCheckNextAvailableFreeChunk != 0);
+        iCheckNextAvailableFreeChunk = 0;
+        iMemPoolMutex.Unlock();
+#endif
+        if (notify)
+        {
+            OsclMemPoolFixedChunkAllocatorObserver* obs = iObserver;
+            if (obs)
+            {
+                obs->freechunkavailable(iNextAvailableContextData);
+            }
+        }
+    }
+    else
+    {
+        // when the mempool is about to be destroyed, no need to
+        // notify the observer. By this time, the observer should not
+        // be expecting it
+        Delete();
+    }
+}
+
+
+OSCL_EXPORT_REF void ThreadSafeLockFreeMemPoolFixedChunkAllocator::notifyfreechunkavailable(OsclMemPoolFixedChunkAllocatorObserver& obs, OsclAny* aContextData)
+{
+    iObserver = &obs;
+    iNextAvailableContextData = aContextData;
+    // the observer must be visible before the flag that enables the callback
+    THREADSAFE_BARRIER();
+    iCheckNextAvailableFreeChunk = 1;
+}
+
+OSCL_EXPORT_REF void ThreadSafeLockFreeMemPoolFixedChunkAllocator::CancelFreeChunkAvailableCallback()
+{
+    iCheckNextAvailableFreeChunk = 0;
+    THREADSAFE_BARRIER();
+    iObserver = NULL;
+    iNextAvailableContextData = NULL;
+}
+
+OSCL_EXPORT_REF void ThreadSafeLockFreeMemPoolFixedChunkAllocator::createmempool()
+{
+    if (iChunkSize == 0 || iNumChunk == 0)
+    {
+        OSCL_LEAVE(OsclErrArgument);
+    }
+
+    // Create one block of memory for the memory pool
+    iChunkSizeMemAligned = oscl_mem_aligned_size(iChunkSize);
+    int32 leavecode = 0;
+    if (iMemPoolAllocator)
+    {
+        OSCL_TRY(leavecode, iMemPool = iMemPoolAllocator->ALLOCATE(iNumChunk * iChunkSizeMemAligned));
+    }
+    else
+    {
+        OSCL_TRY(leavecode, iMemPool = OSCL_MALLOC(iNumChunk * iChunkSizeMemAligned));
+    }
+
+    if (leavecode || iMemPool == NULL)
+    {
+        OSCL_LEAVE(OsclErrNoMemory);
+    }
+
+#if OSCL_MEM_FILL_WITH_PATTERN
+    oscl_memset(iMemPool, 0x55, iNumChunk*iChunkSizeMemAligned);
+#endif
+
+    // Set up the free mem chunk ring with room for every chunk
+    iFreeMemChunkList.Construct(iNumChunk, iMultiThreadFree);
+    uint8* chunkptr = (uint8*)iMemPool;
+
+    for (uint32 i = 0; i < iNumChunk; ++i)
+    {
+        iFreeMemChunkList.Push(0, (OsclAny*)chunkptr);
+        chunkptr += iChunkSizeMemAligned;
+    }
+}
+
+
+OSCL_EXPORT_REF void ThreadSafeLockFreeMemPoolFixedChunkAllocator::destroymempool()
+{
+    // If ref count reaches 0 then destroy this object
+    if (iRefCount <= 0)
+    {
+#if OSCL_MEM_CHECK_ALL_MEMPOOL_CHUNKS_ARE_RETURNED
+        // Assert if all of the chunks were not returned
+        OSCL_ASSERT(iFreeMemChunkList.Size() == iNumChunk);
+#endif
+
+        if (iMemPool)
+        {
+            if (iMemPoolAllocator)
+            {
+                iMemPoolAllocator->deallocate(iMemPool);
+            }
+            else
+            {
+                OSCL_FREE(iMemPool);
+            }
+
+            iMemPool = NULL;
+        }
+    }
+}
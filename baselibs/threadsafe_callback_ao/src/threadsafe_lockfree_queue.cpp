@@ -0,0 +1,419 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+
+#include "threadsafe_lockfree_queue.h"
+#include "oscl_mem.h"
+#include "oscl_procstatus.h"
+
+/////////////////////////////////////////////////////////////////////////////
+// ThreadSafeLockFreeRing
+/////////////////////////////////////////////////////////////////////////////
+
+OSCL_EXPORT_REF ThreadSafeLockFreeRing::ThreadSafeLockFreeRing()
+        : iCells(NULL),
+        iMask(0),
+        iMultiProducer(false),
+        iEnqueuePos(0),
+        iDequeuePos(0)
+{
+#if !THREADSAFE_HAS_ATOMICS
+    iProducerLock.Create();
+#endif
+}
+
+OSCL_EXPORT_REF ThreadSafeLockFreeRing::~ThreadSafeLockFreeRing()
+{
+    if (iCells)
+    {
+        OSCL_FREE(iCells);
+        iCells = NULL;
+    }
+#if !THREADSAFE_HAS_ATOMICS
+    iProducerLock.Close();
+#endif
+}
+
+OSCL_EXPORT_REF void ThreadSafeLockFreeRing::Construct(uint32 aCapacity, bool aMultiProducer)
+{
+    uint32 capacity = 2;
+    while (capacity < aCapacity)
+    {
+        capacity <<= 1;
+    }
+
+    Cell* cells = (Cell*)OSCL_MALLOC(capacity * sizeof(Cell));
+    if (cells == NULL)
+    {
+        OSCL_LEAVE(OsclErrNoMemory);
+    }
+
+    if (iCells)
+    {
+        OSCL_FREE(iCells);
+    }
+    iCells = cells;
+    iMask = capacity - 1;
+    iMultiProducer = aMultiProducer;
+    iEnqueuePos = 0;
+    iDequeuePos = 0;
+
+    // a cell is free for the producer at position pos when its sequence is pos,
+    // and holds an item for the consumer at position pos when it is pos + 1
+    for (uint32 i = 0; i < capacity; i++)
+    {
+        iCells[i].iSeq = i;
+        iCells[i].iId = 0;
+        iCells[i].iData = NULL;
+    }
+    THREADSAFE_BARRIER();
+}
+
+OSCL_EXPORT_REF bool ThreadSafeLockFreeRing::Push(uint32 aId, OsclAny* aData)
+{
+    Cell* cell;
+    uint32 pos;
+
+#if THREADSAFE_HAS_ATOMICS
+    if (iMultiProducer)
+    {
+        // claim the cell at the enqueue position, retrying when another
+        // producer got there first
+        for (;;)
+        {
+            pos = iEnqueuePos;
+            cell = &iCells[pos & iMask];
+            int32 dif = (int32)(cell->iSeq - pos);
+            if (dif == 0)
+            {
+                if (THREADSAFE_CAS32(&iEnqueuePos, pos, pos + 1))
+                {
+                    break;
+                }
+            }
+            else if (dif < 0)
+            {
+                // full
+                return false;
+            }
+        }
+    }
+    else
+#else
+    if (iMultiProducer)
+    {
+        iProducerLock.Lock();
+    }
+#endif
+    {
+        pos = iEnqueuePos;
+        cell = &iCells[pos & iMask];
+        if (cell->iSeq != pos)
+        {
+#if !THREADSAFE_HAS_ATOMICS
+            if (iMultiProducer)
+            {
+                iProducerLock.Unlock();
+            }
+#endif
+            return false;
+        }
+        // don't let the stores below pass the consumer's release of the cell
+        THREADSAFE_ORDER();
+        iEnqueuePos = pos + 1;
+#if !THREADSAFE_HAS_ATOMICS
+        if (iMultiProducer)
+        {
+            iProducerLock.Unlock();
+        }
+#endif
+    }
+
+    cell->iId = aId;
+    cell->iData = aData;
+    // publish the item
+    THREADSAFE_ORDER();
+    cell->iSeq = pos + 1;
+    return true;
+}
+
+OSCL_EXPORT_REF bool ThreadSafeLockFreeRing::Pop(uint32& aId, OsclAny*& aData)
+{
+    uint32 pos = iDequeuePos;
+    Cell* cell = &iCells[pos & iMask];
+    if (cell->iSeq != pos + 1)
+    {
+        // empty, or the producer that claimed this cell has not published it yet
+        return false;
+    }
+    THREADSAFE_ORDER();
+    aId = cell->iId;
+    aData = cell->iData;
+    // hand the cell back to the producers for the next lap
+    THREADSAFE_ORDER();
+    cell->iSeq = pos + iMask + 1;
+    iDequeuePos = pos + 1;
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Wakeup flag shared by ThreadSafeLockFreeQueue and ThreadSafeLockFreeCallbackAO.
+// A producer that sets the flag schedules the AO; Run clears it before it
+// empties the queue, so an item added after the clear either is seen by Run
+// or sets the flag and schedules the AO again.
+/////////////////////////////////////////////////////////////////////////////
+
+#if THREADSAFE_HAS_ATOMICS
+#define THREADSAFE_CLAIM_WAKEUP(flag, lock) THREADSAFE_CAS32(&(flag), 0, 1)
+#define THREADSAFE_CLEAR_WAKEUP(flag, lock) \
+    { \
+        THREADSAFE_BARRIER(); \
+        (flag) = 0; \
+        THREADSAFE_BARRIER(); \
+    }
+#else
+static bool ThreadSafeClaimWakeup(volatile uint32& aFlag, OsclNoYieldMutex& aLock)
+{
+    aLock.Lock();
+    bool claimed = (aFlag == 0);
+    aFlag = 1;
+    aLock.Unlock();
+    return claimed;
+}
+#define THREADSAFE_CLAIM_WAKEUP(flag, lock) ThreadSafeClaimWakeup((flag), (lock))
+#define THREADSAFE_CLEAR_WAKEUP(flag, lock) \
+    { \
+        (lock).Lock(); \
+        (flag) = 0; \
+        (lock).Unlock(); \
+    }
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+// ThreadSafeLockFreeQueue
+/////////////////////////////////////////////////////////////////////////////
+
+OSCL_EXPORT_REF ThreadSafeLockFreeQueue::ThreadSafeLockFreeQueue(const char* aName, int32 aPriority)
+        : OsclActiveObject(aPriority, aName),
+        iObserver(NULL),
+        iWakePending(0),
+        iCounter(1),
+        iMultiProducer(true),
+        iNumWakeups(0)
+{
+    if (OsclThread::GetId(iThreadId) != OsclProcStatus::SUCCESS_ERROR)
+        OsclError::Leave(OsclErrSystemCallFailed);
+#if !THREADSAFE_HAS_ATOMICS
+    iLock.Create();
+#endif
+    AddToScheduler();
+    PendForExec();
+}
+
+OSCL_EXPORT_REF ThreadSafeLockFreeQueue::~ThreadSafeLockFreeQueue()
+{
+    RemoveFromScheduler();
+#if !THREADSAFE_HAS_ATOMICS
+    iLock.Close();
+#endif
+}
+
+OSCL_EXPORT_REF bool ThreadSafeLockFreeQueue::IsInThread()
+{
+    TOsclThreadId id;
+    if (OsclThread::GetId(id) == OsclProcStatus::SUCCESS_ERROR)
+    {
+        return OsclThread::CompareId(id, iThreadId);
+    }
+    return false;
+}
+
+OSCL_EXPORT_REF void ThreadSafeLockFreeQueue::Configure(ThreadSafeLockFreeQueueObserver* aObs, uint32 aCapacity, bool aMultiProducer, uint32 aId)
+{
+    iRing.Construct(aCapacity, aMultiProducer);
+    iObserver = aObs;
+    iMultiProducer = aMultiProducer;
+    iCounter = aId;
+    THREADSAFE_BARRIER();
+}
+
+OSCL_EXPORT_REF ThreadSafeQueueId ThreadSafeLockFreeQueue::AddToQueue(OsclAny *aData, ThreadSafeQueueId* aId)
+{
+    uint32 id;
+    if (aId)
+    {
+        id = *aId;
+    }
+    else if (!iMultiProducer)
+    {
+        id = ++iCounter;
+    }
+    else
+    {
+#if THREADSAFE_HAS_ATOMICS
+        id = THREADSAFE_ADD32(&iCounter, 1);
+#else
+        iLock.Lock();
+        id = ++iCounter;
+        iLock.Unlock();
+#endif
+    }
+
+    if (!iRing.Push(id, aData))
+    {
+        return 0;
+    }
+
+    //Signal the AO unless a wakeup is already pending, in which case this
+    //item will be picked up by the same Run.
+    if (THREADSAFE_CLAIM_WAKEUP(iWakePending, iLock))
+    {
+        PendComplete(OSCL_REQUEST_ERR_NONE);
+    }
+
+    return id;
+}
+
+OSCL_EXPORT_REF uint32 ThreadSafeLockFreeQueue::DeQueue(ThreadSafeQueueId& aId, OsclAny*& aData)
+{
+    uint32 id;
+    if (iRing.Pop(id, aData))
+    {
+        aId = id;
+        return 1;
+    }
+    return 0;
+}
+
+void ThreadSafeLockFreeQueue::Run()
+{
+    PendForExec();
+    THREADSAFE_CLEAR_WAKEUP(iWakePending, iLock);
+    iNumWakeups++;
+
+    if (iObserver)
+        iObserver->ThreadSafeLockFreeQueueDataAvailable(this);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// ThreadSafeLockFreeCallbackAO
+/////////////////////////////////////////////////////////////////////////////
+
+OSCL_EXPORT_REF void ThreadSafeLockFreeCallbackAO::ThreadLogon()
+{
+    if (!IsAdded())
+    {
+        AddToScheduler();
+    }
+
+    iLogger = PVLogger::GetLoggerObject(iLoggerString);
+}
+
+OSCL_EXPORT_REF void ThreadSafeLockFreeCallbackAO::ThreadLogoff()
+{
+    if (IsAdded())
+    {
+        RemoveFromScheduler();
+    }
+
+    iLogger = NULL;
+}
+
+OSCL_EXPORT_REF ThreadSafeLockFreeCallbackAO::ThreadSafeLockFreeCallbackAO(void *aObserver, uint32 aDepth, const char *aAOname, int32 aPriority, bool aMultiProducer)
+        : OsclActiveObject(aPriority, aAOname),
+        iLogger(NULL),
+        iLoggerString(aAOname),
+        iObserver(aObserver),
+        iWakePending(0),
+        iMultiProducer(aMultiProducer),
+        iNumWakeups(0)
+{
+    int32 err = 0;
+
+#if !THREADSAFE_HAS_ATOMICS
+    iLock.Create();
+#endif
+
+    OSCL_TRY(err,
+             iRing.Construct(aDepth, aMultiProducer); //create the queue
+             ThreadLogon(); // add to scheduler
+            );
+
+    if (err != 0)
+    {
+        OSCL_LEAVE(OsclFailure);
+    }
+
+    PendForExec(); // make sure to "prime" the callback AO for the first event that arrives
+}
+
+OSCL_EXPORT_REF ThreadSafeLockFreeCallbackAO::~ThreadSafeLockFreeCallbackAO()
+{
+    ThreadLogoff();
+#if !THREADSAFE_HAS_ATOMICS
+    iLock.Close();
+#endif
+    iObserver = NULL;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// NOTE: THIS METHOD IS EXECUTED IN THE REMOTE THREAD CONTEXT.
+// See ThreadSafeCallbackAO::ReceiveEvent for how to pack the event data.
+// YOU MUST NOT USE LOGGER IN THE CALLBACK (IN THE REMOTE THREAD CONTEXT)
+/////////////////////////////////////////////////////////////////////////////
+OSCL_EXPORT_REF OsclReturnCode ThreadSafeLockFreeCallbackAO::ReceiveEvent(OsclAny *EventData)
+{
+    if (!iRing.Push(0, EventData))
+    {
+        // full; the AO is already scheduled to empty the queue
+        return OsclErrBusy;
+    }
+
+    if (THREADSAFE_CLAIM_WAKEUP(iWakePending, iLock))
+    {
+        PendComplete(OSCL_REQUEST_ERR_NONE);
+    }
+    return OsclSuccess;
+}
+
+OSCL_EXPORT_REF OsclReturnCode ThreadSafeLockFreeCallbackAO::ProcessEvent(OsclAny *EventData)
+{
+    OSCL_UNUSED_ARG(EventData);
+// DO NOTHING. OVERLOAD THIS METHOD IN THE DERIVED CLASS TO DO SOMETHING MEANINGFUL
+    PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_STACK_TRACE, (0, "ThreadSafeLockFreeCallbackAO::ProcessEvent() In and Out"));
+    return OsclSuccess;
+}
+
+OSCL_EXPORT_REF void ThreadSafeLockFreeCallbackAO::Run()
+{
+    PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_STACK_TRACE, (0, "ThreadSafeLockFreeCallbackAO::Run() In"));
+
+    PendForExec();
+    THREADSAFE_CLEAR_WAKEUP(iWakePending, iLock);
+    iNumWakeups++;
+
+    // process every event queued so far with this one wakeup
+    uint32 id;
+    OsclAny *P;
+    while (iRing.Pop(id, P))
+    {
+        ProcessEvent(P);
+    }
+
+    PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_STACK_TRACE, (0, "ThreadSafeLockFreeCallbackAO::Run() Out"));
+}
+
@@ -0,0 +1,267 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#ifndef THREADSAFE_LOCKFREE_QUEUE_H_INCLUDED
+#define THREADSAFE_LOCKFREE_QUEUE_H_INCLUDED
+
+#ifndef OSCL_BASE_H_INCLUDED
+#include "oscl_base.h"
+#endif
+
+#ifndef OSCL_SCHEDULER_AO_H_INCLUDED
+#include "oscl_scheduler_ao.h"
+#endif
+
+#ifndef OSCL_ERROR_CODES_H_INCLUDED
+#include "oscl_error_codes.h"
+#endif
+
+#ifndef PVLOGGER_H_INCLUDED
+#include "pvlogger.h"
+#endif
+
+#ifndef OSCL_MUTEX_H_INCLUDED
+#include "oscl_mutex.h"
+#endif
+
+#ifndef THREADSAFE_ATOMIC_H_INCLUDED
+#include "threadsafe_atomic.h"
+#endif
+
+#ifndef THREADSAFE_QUEUE_H_INCLUDED
+#include "threadsafe_queue.h"
+#endif
+
+#define DEFAULT_LOCKFREE_QUEUE_DEPTH 16
+
+/*
+** A bounded ring of (id, data) pairs with a single consumer and either
+** one or many producers.  Each cell carries a sequence number that tells
+** producers and the consumer whose turn it is, so neither side takes a
+** lock.  With one producer no atomic operation is needed at all; with
+** several, producers claim a cell with a compare-and-swap.
+** The capacity is rounded up to a power of two.
+*/
+class ThreadSafeLockFreeRing
+{
+    public:
+        OSCL_IMPORT_REF ThreadSafeLockFreeRing();
+        OSCL_IMPORT_REF ~ThreadSafeLockFreeRing();
+
+        /*
+        ** Allocate the ring.  Leaves if out of memory.
+        ** @param (in) aCapacity: minimum number of items the ring can hold.
+        ** @param (in) aMultiProducer: true if more than one thread may Push.
+        */
+        OSCL_IMPORT_REF void Construct(uint32 aCapacity, bool aMultiProducer);
+
+        /*
+        ** Add an item.  Any producer thread.
+        ** @return false if the ring is full.
+        */
+        OSCL_IMPORT_REF bool Push(uint32 aId, OsclAny* aData);
+
+        /*
+        ** Remove the oldest item.  Consumer thread only.
+        ** @return false if the ring is empty.
+        */
+        OSCL_IMPORT_REF bool Pop(uint32& aId, OsclAny*& aData);
+
+        /*
+        ** Number of items, exact in the consumer thread when no push is
+        ** in progress, approximate otherwise.
+        */
+        uint32 Size() const
+        {
+            return iEnqueuePos - iDequeuePos;
+        }
+
+        uint32 Capacity() const
+        {
+            return iMask + 1;
+        }
+
+    private:
+        struct Cell
+        {
+            volatile uint32 iSeq;
+            uint32 iId;
+            OsclAny* iData;
+        };
+
+        Cell* iCells;
+        uint32 iMask;
+        bool iMultiProducer;
+        volatile uint32 iEnqueuePos;
+        volatile uint32 iDequeuePos;
+#if !THREADSAFE_HAS_ATOMICS
+        OsclNoYieldMutex iProducerLock;
+#endif
+};
+
+class ThreadSafeLockFreeQueue;
+class ThreadSafeLockFreeQueueObserver
+{
+    public:
+        virtual ~ThreadSafeLockFreeQueueObserver() {};
+        /*
+        ** Called in the queue thread when data has been added.  However many
+        ** items were added since the last call, there is one call, so the
+        ** observer should empty the queue when it receives this notice.
+        **
+        ** param (in) aQueue: originating queue, in case multiple queues share an observer.
+        */
+        OSCL_IMPORT_REF virtual void ThreadSafeLockFreeQueueDataAvailable(ThreadSafeLockFreeQueue* aQueue) = 0;
+};
+
+/*
+** A lock-free counterpart of ThreadSafeQueue.
+** The queue resides in a thread that has a scheduler and that thread is
+** the only one that may DeQueue.  One thread, or any threads when
+** configured as multi-producer, can add data.
+**
+** Wakeups are coalesced: the first item added after the observer has been
+** called schedules the AO, and items added before the AO runs ride on that
+** wakeup, so a burst of N items costs one scheduler wake instead of N.
+** Unlike ThreadSafeQueue the queue is bounded and AddToQueue fails rather
+** than grows when it is full.
+*/
+class ThreadSafeLockFreeQueue: public OsclActiveObject
+{
+    public:
+
+        OSCL_IMPORT_REF ThreadSafeLockFreeQueue(const char* aName = "ThreadSafeLockFreeQueue",
+                                                int32 aPriority = OsclActiveObject::EPriorityNominal);
+        OSCL_IMPORT_REF virtual ~ThreadSafeLockFreeQueue();
+
+        /*
+        ** Configure.  Must be called in the queue thread before any data is
+        ** added.  Leaves if out of memory.
+        ** @param (in) aObs: observer
+        ** @param (in) aCapacity: maximum number of queued items, rounded up to a power of two.
+        ** @param (in) aMultiProducer: true if more than one thread adds data.
+        ** @param (in) aId: initial value for the assigned data IDs.
+        */
+        OSCL_IMPORT_REF void Configure(ThreadSafeLockFreeQueueObserver* aObs, uint32 aCapacity = DEFAULT_LOCKFREE_QUEUE_DEPTH,
+                                       bool aMultiProducer = true, uint32 aId = 0);
+
+        /*
+        ** Add data to the queue from a producer thread.
+        ** @param (in) aData: item to queue
+        ** @param (in) aId: optional command ID.  If none is input, then one will be
+        **   generated from the internal counter.
+        ** @return: a unique ID for the data, or 0 if the queue is full.
+        */
+        OSCL_IMPORT_REF ThreadSafeQueueId AddToQueue(OsclAny *aData, ThreadSafeQueueId* aId = NULL);
+
+        /*
+        ** DeQueue data in the queue thread.  Data is returned in FIFO order.
+        ** @param (out) aId: the ID that was returned by AddToQueue.
+        ** @param (out) aData: the queued item.
+        ** @return: number of items de-queued (either 0 or 1)
+        */
+        OSCL_IMPORT_REF uint32 DeQueue(ThreadSafeQueueId& aId, OsclAny*& aData);
+
+        /*
+        ** Checks whether calling context is the same as the queue thread context.
+        ** @return true if same thread context.
+        */
+        OSCL_IMPORT_REF bool IsInThread();
+
+        /*
+        ** Number of times the AO has been woken, for measuring the coalescing.
+        */
+        uint32 NumWakeups() const
+        {
+            return iNumWakeups;
+        }
+
+    protected:
+
+        void Run();
+
+        ThreadSafeLockFreeQueueObserver *iObserver;
+
+        ThreadSafeLockFreeRing iRing;
+
+        // set by the producer that schedules the AO, cleared by Run
+        volatile uint32 iWakePending;
+
+        volatile uint32 iCounter;//data ID counter
+        bool iMultiProducer;
+        uint32 iNumWakeups;
+
+        TOsclThreadId iThreadId;
+
+#if !THREADSAFE_HAS_ATOMICS
+        OsclNoYieldMutex iLock;
+#endif
+};
+
+const char thisLockFreeAOname[] = "threadsafelockfreecallbackAO";
+
+/*
+** A lock-free counterpart of ThreadSafeCallbackAO with the same generic
+** callback API.  Events are queued on a ThreadSafeLockFreeRing and wakeups
+** are coalesced as in ThreadSafeLockFreeQueue, and Run hands every queued
+** event to ProcessEvent.
+** ReceiveEvent never blocks the remote thread: when the queue is full it
+** returns OsclErrBusy.  A wakeup is always pending while the queue is full.
+*/
+class ThreadSafeLockFreeCallbackAO: public OsclActiveObject
+{
+    public:
+        // constructor
+        OSCL_IMPORT_REF ThreadSafeLockFreeCallbackAO(void *aObserver = NULL,
+                uint32 aDepth = DEFAULT_LOCKFREE_QUEUE_DEPTH,
+                const char *aAOname = thisLockFreeAOname,
+                int32 aPriority = OsclActiveObject::EPriorityNominal,
+                bool aMultiProducer = false);
+        // destructor
+        OSCL_IMPORT_REF virtual ~ThreadSafeLockFreeCallbackAO();
+
+        OSCL_IMPORT_REF void ThreadLogon();
+        OSCL_IMPORT_REF void ThreadLogoff();
+
+        OSCL_IMPORT_REF OsclReturnCode ReceiveEvent(OsclAny *EventData); // Generic callback API, remote thread
+        OSCL_IMPORT_REF virtual OsclReturnCode ProcessEvent(OsclAny *EventData); // Process data
+
+        /*
+        ** Number of times the AO has been woken, for measuring the coalescing.
+        */
+        uint32 NumWakeups() const
+        {
+            return iNumWakeups;
+        }
+
+    protected:
+        OSCL_IMPORT_REF virtual void Run();
+
+        PVLogger* iLogger;
+        const char *iLoggerString;
+        void *iObserver;
+
+        ThreadSafeLockFreeRing iRing; // queue of events
+        volatile uint32 iWakePending;
+        bool iMultiProducer;
+        uint32 iNumWakeups;
+#if !THREADSAFE_HAS_ATOMICS
+        OsclNoYieldMutex iLock;
+#endif
+};
+
+#endif
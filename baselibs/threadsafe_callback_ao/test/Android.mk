@@ -0,0 +1,31 @@
+LOCAL_PATH := $(call my-dir)
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES := \
+ 	src/threadsafe_lockfree_test.cpp
+
+
+LOCAL_MODULE := pv_threadsafe_lockfree_test
+
+LOCAL_CFLAGS :=  $(PV_CFLAGS)
+
+
+
+LOCAL_STATIC_LIBRARIES := 
+
+LOCAL_SHARED_LIBRARIES := libopencore_common
+
+LOCAL_C_INCLUDES := \
+	$(PV_TOP)/baselibs/threadsafe_callback_ao/test/src \
+ 	$(PV_TOP)/baselibs/threadsafe_callback_ao/test/src \
+ 	$(PV_TOP)/baselibs/threadsafe_callback_ao/src \
+ 	$(PV_INCLUDES)
+
+LOCAL_COPY_HEADERS_TO := $(PV_COPY_HEADERS_TO)
+
+LOCAL_COPY_HEADERS := \
+ 	
+
+-include $(PV_TOP)/Android_system_extras.mk
+
+include $(BUILD_EXECUTABLE)
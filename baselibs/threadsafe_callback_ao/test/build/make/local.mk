@@ -0,0 +1,23 @@
+# Get the current local path as the first operation
+LOCAL_PATH := $(call get_makefile_dir)
+
+# Clear out the variables used in the local makefiles
+include $(MK)/clear.mk
+
+TARGET := pv_threadsafe_lockfree_test
+
+
+XCXXFLAGS += $(FLAG_COMPILE_WARNINGS_AS_ERRORS)
+
+XINCDIRS += ../../../src
+
+SRCDIR := ../../src
+INCSRCDIR := ../../src
+
+SRCS := threadsafe_lockfree_test.cpp
+
+LIBS := opencore_common
+
+SYSLIBS += $(SYS_THREAD_LIB)
+
+include $(MK)/prog.mk
@@ -0,0 +1,980 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+// Checks the lock-free ring, queue, callback AO and mempool: full and empty
+// rings, wrap-around of the cells, FIFO order with one and with several
+// producer threads, and that no item is stranded when a producer adds it
+// while the consumer clears the wakeup flag.  A lost wakeup shows up as a
+// timeout rather than a hang.
+//
+// With -benchmark it also compares the lock-free classes with the mutex
+// based ones under contention from 1, 2 and 4 threads.
+
+#include "stdio.h"
+#include "oscl_base.h"
+#include "oscl_mem.h"
+#include "oscl_error.h"
+#include "oscl_stdstring.h"
+#include "oscl_tickcount.h"
+#include "oscl_thread.h"
+#include "oscl_semaphore.h"
+#include "oscl_scheduler.h"
+#include "pvlogger.h"
+#include "threadsafe_queue.h"
+#include "threadsafe_callback_ao.h"
+#include "threadsafe_mempool.h"
+#include "threadsafe_lockfree_queue.h"
+#include "threadsafe_lockfree_mempool.h"
+
+#define TEST_NUM_ITEMS          100000
+#define TEST_NUM_LOCKSTEP_ITEMS 20000
+#define TEST_MAX_THREADS        4
+#define TEST_TIMEOUT_MSEC       30000
+#define TEST_POOL_CHUNKS        32
+#define TEST_CHUNK_SIZE         64
+#define TEST_CHUNK_IN_USE       0x1badc0de
+
+#define BENCH_NUM_ITEMS         400000
+#define BENCH_BURST             32
+
+// set to release the producer threads, and to make them give up
+static volatile uint32 TestGo = 0;
+static volatile uint32 TestAbort = 0;
+
+// An item carries the producer index in its top byte and its sequence
+// number, counted from 1, below that.
+static OsclAny* TestItem(uint32 aProducer, uint32 aSeqNum)
+{
+    return (OsclAny*)(size_t)((aProducer << 24) | aSeqNum);
+}
+
+static bool TimedOut(uint32 aStartTicks)
+{
+    return OsclTickCount::TicksToMsec(OsclTickCount::TickCount() - aStartTicks) > TEST_TIMEOUT_MSEC;
+}
+
+// Checks that the items of each producer arrive in the order they were
+// added, with none lost or repeated
+class TestOrderCheck
+{
+    public:
+        TestOrderCheck(uint32 aNumProducers): iNumProducers(aNumProducers), iNumItems(0), iNumBad(0)
+        {
+            for (uint32 i = 0; i < TEST_MAX_THREADS; i++)
+            {
+                iNextSeqNum[i] = 1;
+            }
+        }
+
+        void Check(OsclAny* aItem)
+        {
+            uint32 value = (uint32)(size_t)aItem;
+            uint32 producer = value >> 24;
+            if ((producer >= iNumProducers) || ((value & 0xffffff) != iNextSeqNum[producer]))
+            {
+                iNumBad++;
+            }
+            else
+            {
+                iNextSeqNum[producer]++;
+            }
+            iNumItems++;
+        }
+
+        // true when every producer's aPerProducer items came in order
+        bool Complete(uint32 aPerProducer)
+        {
+            bool ok = (iNumBad == 0);
+            for (uint32 i = 0; i < iNumProducers; i++)
+            {
+                ok = ok && (iNextSeqNum[i] == aPerProducer + 1);
+            }
+            if (!ok)
+            {
+                printf("  %d items received, %d out of order\n", iNumItems, iNumBad);
+            }
+            return ok;
+        }
+
+        uint32 iNumProducers;
+        uint32 iNumItems;
+        uint32 iNumBad;
+        uint32 iNextSeqNum[TEST_MAX_THREADS];
+};
+
+// What the producer threads add to
+class TestSink
+{
+    public:
+        virtual ~TestSink() {}
+
+        // returns false if the item can't be taken now
+        virtual bool Add(OsclAny* aItem) = 0;
+};
+
+struct TestProducerArg
+{
+    TestSink* iSink;
+    uint32 iIndex;
+    uint32 iNumItems;
+    uint32 iBurst;
+    // when set, each item is added only once the last one was received
+    TestOrderCheck* iLockStep;
+    OsclSemaphore* iExitSem;
+};
+
+static TOsclThreadFuncRet OSCL_THREAD_DECL TestProducerThread(TOsclThreadFuncArg aArg)
+{
+    TestProducerArg* arg = (TestProducerArg*)aArg;
+    while (!TestGo && !TestAbort)
+    {
+        OsclThread::SleepMillisec(0);
+    }
+    for (uint32 seqNum = 1; (seqNum <= arg->iNumItems) && !TestAbort; seqNum++)
+    {
+        while (!arg->iSink->Add(TestItem(arg->iIndex, seqNum)) && !TestAbort)
+        {
+            OsclThread::SleepMillisec(0);
+        }
+        // an item that is stranded behind a lost wakeup stops this thread
+        // here until the watchdog fires
+        while (arg->iLockStep && (((volatile uint32*)arg->iLockStep->iNextSeqNum)[arg->iIndex] <= seqNum) && !TestAbort)
+        {
+            OsclThread::SleepMillisec(0);
+        }
+        // give up the CPU between bursts, so that adds land while the
+        // consumer is emptying the queue
+        if ((seqNum % arg->iBurst) == 0)
+        {
+            OsclThread::SleepMillisec(0);
+        }
+    }
+    arg->iExitSem->Signal();
+    return 0;
+}
+
+// Producer threads that each add aNumItems items to one sink
+class TestProducers
+{
+    public:
+        TestProducers(): iNumStarted(0)
+        {
+            iExitSem.Create();
+        }
+
+        ~TestProducers()
+        {
+            Wait();
+            iExitSem.Close();
+        }
+
+        // starts the threads, which wait for Go
+        bool Start(TestSink* aSink, uint32 aNumThreads, uint32 aNumItems, uint32 aBurst,
+                   TestOrderCheck* aLockStep = NULL)
+        {
+            TestGo = 0;
+            TestAbort = 0;
+            for (uint32 i = 0; i < aNumThreads; i++)
+            {
+                iArgs[i].iSink = aSink;
+                iArgs[i].iIndex = i;
+                iArgs[i].iNumItems = aNumItems;
+                iArgs[i].iBurst = aBurst;
+                iArgs[i].iLockStep = aLockStep;
+                iArgs[i].iExitSem = &iExitSem;
+                OsclThread thread;
+                if (thread.Create(TestProducerThread, 0, &iArgs[i]) != OsclProcStatus::SUCCESS_ERROR)
+                {
+                    printf("  thread create failed\n");
+                    TestAbort = 1;
+                    return false;
+                }
+                iNumStarted++;
+            }
+            return true;
+        }
+
+        void Go()
+        {
+            TestGo = 1;
+        }
+
+        // waits for the threads to finish
+        void Wait()
+        {
+            for (; iNumStarted > 0; iNumStarted--)
+            {
+                iExitSem.Wait();
+            }
+        }
+
+    private:
+        OsclSemaphore iExitSem;
+        TestProducerArg iArgs[TEST_MAX_THREADS];
+        uint32 iNumStarted;
+};
+
+// Stops the scheduler when a test has not finished in time
+class TestWatchdog : public OsclTimerObject
+{
+    public:
+        TestWatchdog(): OsclTimerObject(OsclActiveObject::EPriorityNominal, "TestWatchdog"), iFired(false)
+        {
+            AddToScheduler();
+        }
+
+        ~TestWatchdog()
+        {
+            RemoveFromScheduler();
+        }
+
+        // runs the scheduler until a test object stops it, or the time is up
+        bool RunScheduler()
+        {
+            iFired = false;
+            RunIfNotReady(TEST_TIMEOUT_MSEC * 1000);
+            OsclExecScheduler::Current()->StartScheduler();
+            Cancel();
+            if (iFired)
+            {
+                printf("  timed out\n");
+            }
+            return !iFired;
+        }
+
+    private:
+        void Run()
+        {
+            iFired = true;
+            TestAbort = 1;
+            OsclExecScheduler::Current()->StopScheduler();
+        }
+
+        bool iFired;
+};
+
+static void StopScheduler()
+{
+    OsclExecScheduler::Current()->StopScheduler();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// ThreadSafeLockFreeRing
+/////////////////////////////////////////////////////////////////////////////
+
+static bool PushItems(ThreadSafeLockFreeRing& aRing, uint32& aNext, uint32 aCount)
+{
+    for (uint32 i = 0; i < aCount; i++, aNext++)
+    {
+        if (!aRing.Push(aNext, TestItem(0, aNext)))
+        {
+            printf("  push %d failed\n", aNext);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool PopItems(ThreadSafeLockFreeRing& aRing, uint32& aExpected, uint32 aCount)
+{
+    for (uint32 i = 0; i < aCount; i++, aExpected++)
+    {
+        uint32 id = 0;
+        OsclAny* data = NULL;
+        if (!aRing.Pop(id, data) || (id != aExpected) || (data != TestItem(0, aExpected)))
+        {
+            printf("  pop %d failed\n", aExpected);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Full and empty rings, and many laps of the cells at every fill level
+static bool TestRingFullEmptyWrap(bool aMultiProducer)
+{
+    ThreadSafeLockFreeRing ring;
+    ring.Construct(5, aMultiProducer);
+    if (ring.Capacity() != 8)
+    {
+        printf("  capacity %d\n", ring.Capacity());
+        return false;
+    }
+
+    uint32 id = 0;
+    OsclAny* data = NULL;
+    uint32 next = 1;
+    uint32 expected = 1;
+    bool ok = !ring.Pop(id, data)
+              && PushItems(ring, next, 8)
+              && !ring.Push(next, NULL)
+              && (ring.Size() == 8)
+              && PopItems(ring, expected, 3)
+              && PushItems(ring, next, 3)
+              && !ring.Push(next, NULL)
+              && PopItems(ring, expected, 8)
+              && !ring.Pop(id, data)
+              && (ring.Size() == 0);
+
+    for (uint32 lap = 0; ok && (lap < 1000); lap++)
+    {
+        uint32 count = 1 + (lap % 8);
+        ok = PushItems(ring, next, count)
+             && ((count < 8) || !ring.Push(next, NULL))
+             && PopItems(ring, expected, count)
+             && !ring.Pop(id, data);
+    }
+    return ok;
+}
+
+class TestRingSink : public TestSink
+{
+    public:
+        TestRingSink(uint32 aCapacity, bool aMultiProducer)
+        {
+            iRing.Construct(aCapacity, aMultiProducer);
+        }
+
+        bool Add(OsclAny* aItem)
+        {
+            return iRing.Push(0, aItem);
+        }
+
+        ThreadSafeLockFreeRing iRing;
+};
+
+// Producer threads push through a small ring, so it is often full and the
+// cells wrap many times; this thread pops
+static bool TestRingThreads(uint32 aNumProducers)
+{
+    TestRingSink sink(16, aNumProducers > 1);
+    TestOrderCheck order(aNumProducers);
+    uint32 perProducer = TEST_NUM_ITEMS / aNumProducers;
+    TestProducers producers;
+    if (!producers.Start(&sink, aNumProducers, perProducer, 8))
+    {
+        return false;
+    }
+
+    uint32 start = OsclTickCount::TickCount();
+    producers.Go();
+    while (order.iNumItems < perProducer * aNumProducers)
+    {
+        uint32 id = 0;
+        OsclAny* data = NULL;
+        if (sink.iRing.Pop(id, data))
+        {
+            order.Check(data);
+        }
+        else if (TimedOut(start))
+        {
+            printf("  timed out\n");
+            TestAbort = 1;
+            break;
+        }
+        else
+        {
+            OsclThread::SleepMillisec(0);
+        }
+    }
+    producers.Wait();
+    return order.Complete(perProducer);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// ThreadSafeLockFreeQueue
+/////////////////////////////////////////////////////////////////////////////
+
+class TestQueue : public TestSink, public ThreadSafeLockFreeQueueObserver
+{
+    public:
+        TestQueue(uint32 aCapacity, uint32 aNumProducers, uint32 aStopAt)
+                : iOrder(aNumProducers), iNumCalls(0), iStopAt(aStopAt), iNumLateAdds(0)
+        {
+            iQueue.Configure(this, aCapacity, aNumProducers > 1);
+        }
+
+        bool Add(OsclAny* aItem)
+        {
+            return (iQueue.AddToQueue(aItem) != 0);
+        }
+
+        void ThreadSafeLockFreeQueueDataAvailable(ThreadSafeLockFreeQueue* aQueue)
+        {
+            iNumCalls++;
+            ThreadSafeQueueId id;
+            OsclAny* data;
+            while (aQueue->DeQueue(id, data))
+            {
+                iOrder.Check(data);
+            }
+            // as a producer would that adds just after the queue was emptied
+            if (iNumLateAdds > 0)
+            {
+                iNumLateAdds--;
+                Add(TestItem(0, iOrder.iNextSeqNum[0]));
+            }
+            if (iOrder.iNumItems >= iStopAt)
+            {
+                StopScheduler();
+            }
+        }
+
+        ThreadSafeLockFreeQueue iQueue;
+        TestOrderCheck iOrder;
+        uint32 iNumCalls;
+        uint32 iStopAt;
+        uint32 iNumLateAdds;
+};
+
+// A full queue refuses an item, and a burst costs one wakeup
+static bool TestQueueFullCoalesced(TestWatchdog& aWatchdog)
+{
+    TestQueue queue(4, 1, 4);
+    uint32 seqNum = 1;
+    bool ok = true;
+    for (; ok && (seqNum <= 4); seqNum++)
+    {
+        ok = (queue.iQueue.AddToQueue(TestItem(0, seqNum)) == seqNum);
+    }
+    if (!ok || (queue.iQueue.AddToQueue(TestItem(0, seqNum)) != 0))
+    {
+        printf("  full queue took an item\n");
+        return false;
+    }
+
+    ok = aWatchdog.RunScheduler() && (queue.iNumCalls == 1) && (queue.iOrder.iNumItems == 4);
+
+    queue.iStopAt = 6;
+    ok = ok && queue.Add(TestItem(0, 5)) && queue.Add(TestItem(0, 6))
+         && aWatchdog.RunScheduler()
+         && (queue.iNumCalls == 2)
+         && (queue.iQueue.NumWakeups() == 2);
+    return ok && queue.iOrder.Complete(6);
+}
+
+// An item added after the observer has emptied the queue, but before it
+// returns, gets a wakeup of its own
+static bool TestQueueLateAdd(TestWatchdog& aWatchdog)
+{
+    TestQueue queue(4, 1, 4);
+    queue.iNumLateAdds = 3;
+    bool ok = queue.Add(TestItem(0, 1))
+              && aWatchdog.RunScheduler()
+              && (queue.iNumCalls == 4)
+              && (queue.iQueue.NumWakeups() == 4);
+    return ok && queue.iOrder.Complete(4);
+}
+
+// Producer threads add while the queue thread empties the queue.  In lock
+// step every add comes just as the observer returns, so it races the
+// clearing of the wakeup flag.
+static bool TestQueueThreads(TestWatchdog& aWatchdog, uint32 aNumProducers, bool aLockStep)
+{
+    uint32 perProducer = (aLockStep ? TEST_NUM_LOCKSTEP_ITEMS : TEST_NUM_ITEMS) / aNumProducers;
+    TestQueue queue(64, aNumProducers, perProducer * aNumProducers);
+    TestProducers producers;
+    if (!producers.Start(&queue, aNumProducers, perProducer, 8, aLockStep ? &queue.iOrder : NULL))
+    {
+        return false;
+    }
+    producers.Go();
+    bool ok = aWatchdog.RunScheduler();
+    producers.Wait();
+    ok = ok && queue.iOrder.Complete(perProducer);
+    printf("  %d producer(s): %d items, %d wakeups\n",
+           aNumProducers, queue.iOrder.iNumItems, queue.iQueue.NumWakeups());
+    return ok && (queue.iQueue.NumWakeups() == queue.iNumCalls);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// ThreadSafeLockFreeCallbackAO
+/////////////////////////////////////////////////////////////////////////////
+
+class TestCallbackAO : public TestSink, public ThreadSafeLockFreeCallbackAO
+{
+    public:
+        TestCallbackAO(uint32 aDepth, uint32 aNumProducers, uint32 aStopAt)
+                : ThreadSafeLockFreeCallbackAO(NULL, aDepth, "TestCallbackAO",
+                                               OsclActiveObject::EPriorityNominal, aNumProducers > 1)
+                , iOrder(aNumProducers)
+                , iStopAt(aStopAt)
+        {
+        }
+
+        bool Add(OsclAny* aItem)
+        {
+            return (ReceiveEvent(aItem) == OsclSuccess);
+        }
+
+        OsclReturnCode ProcessEvent(OsclAny* aEventData)
+        {
+            iOrder.Check(aEventData);
+            if (iOrder.iNumItems == iStopAt)
+            {
+                StopScheduler();
+            }
+            return OsclSuccess;
+        }
+
+        TestOrderCheck iOrder;
+        uint32 iStopAt;
+};
+
+// A full AO queue returns busy without blocking, and a burst is processed
+// in one Run
+static bool TestCallbackAOFullCoalesced(TestWatchdog& aWatchdog)
+{
+    TestCallbackAO ao(4, 1, 4);
+    bool ok = true;
+    for (uint32 seqNum = 1; ok && (seqNum <= 4); seqNum++)
+    {
+        ok = ao.Add(TestItem(0, seqNum));
+    }
+    if (!ok || (ao.ReceiveEvent(TestItem(0, 5)) != OsclErrBusy))
+    {
+        printf("  full queue took an event\n");
+        return false;
+    }
+    ok = aWatchdog.RunScheduler() && (ao.NumWakeups() == 1);
+    return ok && ao.iOrder.Complete(4);
+}
+
+static bool TestCallbackAOThreads(TestWatchdog& aWatchdog, uint32 aNumProducers, bool aLockStep)
+{
+    uint32 perProducer = (aLockStep ? TEST_NUM_LOCKSTEP_ITEMS : TEST_NUM_ITEMS) / aNumProducers;
+    TestCallbackAO ao(64, aNumProducers, perProducer * aNumProducers);
+    TestProducers producers;
+    if (!producers.Start(&ao, aNumProducers, perProducer, 8, aLockStep ? &ao.iOrder : NULL))
+    {
+        return false;
+    }
+    producers.Go();
+    bool ok = aWatchdog.RunScheduler();
+    producers.Wait();
+    printf("  %d producer(s): %d events, %d wakeups\n",
+           aNumProducers, ao.iOrder.iNumItems, ao.NumWakeups());
+    return ok && ao.iOrder.Complete(perProducer);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// ThreadSafeLockFreeMemPoolFixedChunkAllocator
+/////////////////////////////////////////////////////////////////////////////
+
+class TestPoolObserver : public OsclMemPoolFixedChunkAllocatorObserver
+{
+    public:
+        TestPoolObserver(): iNumCalls(0), iContext(NULL) {}
+
+        void freechunkavailable(OsclAny* aContextData)
+        {
+            iNumCalls++;
+            iContext = aContextData;
+        }
+
+        uint32 iNumCalls;
+        OsclAny* iContext;
+};
+
+// An empty pool returns NULL, and the free chunk callback is made once
+static bool TestPoolEmptyNotify()
+{
+    ThreadSafeLockFreeMemPoolFixedChunkAllocator* pool =
+        ThreadSafeLockFreeMemPoolFixedChunkAllocator::Create(4, TEST_CHUNK_SIZE, NULL, false);
+    OsclAny* chunks[4];
+    bool ok = true;
+    for (uint32 i = 0; i < 4; i++)
+    {
+        chunks[i] = pool->allocate(TEST_CHUNK_SIZE);
+        ok = ok && (chunks[i] != NULL);
+        for (uint32 j = 0; j < i; j++)
+        {
+            ok = ok && (chunks[i] != chunks[j]);
+        }
+    }
+    ok = ok && (pool->allocate(TEST_CHUNK_SIZE) == NULL);
+
+    int32 err = OsclErrNone;
+    OSCL_TRY(err, pool->allocate(TEST_CHUNK_SIZE + 1););
+    ok = ok && (err == OsclErrArgument);
+
+    TestPoolObserver observer;
+    int32 context = 0;
+    pool->notifyfreechunkavailable(observer, &context);
+    pool->deallocate(chunks[0]);
+    pool->deallocate(chunks[1]);
+    ok = ok && (observer.iNumCalls == 1) && (observer.iContext == &context);
+
+    chunks[0] = pool->allocate(TEST_CHUNK_SIZE);
+    chunks[1] = pool->allocate(TEST_CHUNK_SIZE);
+    ok = ok && (chunks[0] != NULL) && (chunks[1] != NULL);
+    for (uint32 i = 0; i < 4; i++)
+    {
+        pool->deallocate(chunks[i]);
+    }
+    ok = ok && (observer.iNumCalls == 1);
+    pool->removeRef();
+    return ok;
+}
+
+struct TestFreerArg
+{
+    OsclMemPoolFixedChunkAllocator* iPool;
+    ThreadSafeLockFreeRing iRing;
+    uint32 iNumChunks;
+    OsclSemaphore* iExitSem;
+};
+
+// frees the chunks handed over on its ring
+static TOsclThreadFuncRet OSCL_THREAD_DECL TestFreerThread(TOsclThreadFuncArg aArg)
+{
+    TestFreerArg* arg = (TestFreerArg*)aArg;
+    uint32 numFreed = 0;
+    while ((numFreed < arg->iNumChunks) && !TestAbort)
+    {
+        uint32 id;
+        OsclAny* chunk;
+        if (arg->iRing.Pop(id, chunk))
+        {
+            *(volatile uint32*)chunk = 0;
+            arg->iPool->deallocate(chunk);
+            numFreed++;
+        }
+        else
+        {
+            OsclThread::SleepMillisec(0);
+        }
+    }
+    arg->iExitSem->Signal();
+    return 0;
+}
+
+// This thread allocates aNumChunks chunks from aPool, handing each to one
+// of aNumFreers threads to free.  A chunk handed out twice is caught by the
+// in-use mark and counted in aNumBad.  Returns the msec taken, or 0 when
+// the test gave up.
+static uint32 RunPoolThreads(OsclMemPoolFixedChunkAllocator* aPool, uint32 aNumFreers, uint32 aNumChunks, uint32& aNumBad)
+{
+    OsclSemaphore exitSem;
+    exitSem.Create();
+    TestFreerArg args[TEST_MAX_THREADS];
+    uint32 perFreer = aNumChunks / aNumFreers;
+    uint32 numStarted = 0;
+    TestAbort = 0;
+    for (uint32 i = 0; i < aNumFreers; i++)
+    {
+        args[i].iPool = aPool;
+        args[i].iRing.Construct(16, false);
+        args[i].iNumChunks = perFreer;
+        args[i].iExitSem = &exitSem;
+        OsclThread thread;
+        if (thread.Create(TestFreerThread, 0, &args[i]) != OsclProcStatus::SUCCESS_ERROR)
+        {
+            printf("  thread create failed\n");
+            TestAbort = 1;
+            break;
+        }
+        numStarted++;
+    }
+
+    aNumBad = 0;
+    uint32 start = OsclTickCount::TickCount();
+    for (uint32 n = 0; (n < perFreer * aNumFreers) && !TestAbort;)
+    {
+        OsclAny* chunk = aPool->allocate(TEST_CHUNK_SIZE);
+        if (chunk == NULL)
+        {
+            if (TimedOut(start))
+            {
+                printf("  timed out\n");
+                TestAbort = 1;
+            }
+            OsclThread::SleepMillisec(0);
+            continue;
+        }
+        if (*(volatile uint32*)chunk == TEST_CHUNK_IN_USE)
+        {
+            aNumBad++;
+        }
+        *(volatile uint32*)chunk = TEST_CHUNK_IN_USE;
+        while (!args[n % aNumFreers].iRing.Push(0, chunk) && !TestAbort)
+        {
+            OsclThread::SleepMillisec(0);
+        }
+        n++;
+    }
+    for (; numStarted > 0; numStarted--)
+    {
+        exitSem.Wait();
+    }
+    exitSem.Close();
+    uint32 msec = OsclTickCount::TicksToMsec(OsclTickCount::TickCount() - start);
+    if (TestAbort)
+    {
+        return 0;
+    }
+    return (msec > 0) ? msec : 1;
+}
+
+static bool TestPoolThreads(uint32 aNumFreers)
+{
+    ThreadSafeLockFreeMemPoolFixedChunkAllocator* pool =
+        ThreadSafeLockFreeMemPoolFixedChunkAllocator::Create(TEST_POOL_CHUNKS, TEST_CHUNK_SIZE, NULL, aNumFreers > 1);
+    uint32 numBad = 0;
+    bool ok = (RunPoolThreads(pool, aNumFreers, TEST_NUM_ITEMS, numBad) != 0) && (numBad == 0);
+    if (numBad)
+    {
+        printf("  %d chunks handed out twice\n", numBad);
+    }
+
+    // every chunk came back
+    OsclAny* chunks[TEST_POOL_CHUNKS];
+    uint32 numChunks = 0;
+    for (; numChunks < TEST_POOL_CHUNKS; numChunks++)
+    {
+        chunks[numChunks] = pool->allocate(TEST_CHUNK_SIZE);
+        if (chunks[numChunks] == NULL)
+        {
+            printf("  %d chunks lost\n", TEST_POOL_CHUNKS - numChunks);
+            ok = false;
+            break;
+        }
+    }
+    ok = ok && (pool->allocate(TEST_CHUNK_SIZE) == NULL);
+    while (numChunks > 0)
+    {
+        pool->deallocate(chunks[--numChunks]);
+    }
+    pool->removeRef();
+    return ok;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Benchmark
+/////////////////////////////////////////////////////////////////////////////
+
+class BenchMutexQueue : public TestSink, public ThreadSafeQueueObserver
+{
+    public:
+        BenchMutexQueue(): iNumItems(0), iNumWakeups(0)
+        {
+            iQueue.Configure(this, 64);
+        }
+
+        bool Add(OsclAny* aItem)
+        {
+            iQueue.AddToQueue(aItem);
+            return true;
+        }
+
+        void ThreadSafeQueueDataAvailable(ThreadSafeQueue* aQueue)
+        {
+            iNumWakeups++;
+            ThreadSafeQueueId id;
+            OsclAny* data;
+            while (aQueue->DeQueue(id, data))
+            {
+                iNumItems++;
+            }
+            if (iNumItems == BENCH_NUM_ITEMS)
+            {
+                StopScheduler();
+            }
+        }
+
+        ThreadSafeQueue iQueue;
+        uint32 iNumItems;
+        uint32 iNumWakeups;
+};
+
+class BenchMutexCallbackAO : public TestSink, public ThreadSafeCallbackAO
+{
+    public:
+        BenchMutexCallbackAO(): ThreadSafeCallbackAO(NULL, 64), iNumItems(0), iNumWakeups(0) {}
+
+        bool Add(OsclAny* aItem)
+        {
+            return (ReceiveEvent(aItem) == OsclSuccess);
+        }
+
+        void Run()
+        {
+            iNumWakeups++;
+            ThreadSafeCallbackAO::Run();
+        }
+
+        OsclReturnCode ProcessEvent(OsclAny* aEventData)
+        {
+            OSCL_UNUSED_ARG(aEventData);
+            if (++iNumItems == BENCH_NUM_ITEMS)
+            {
+                StopScheduler();
+            }
+            return OsclSuccess;
+        }
+
+        uint32 iNumItems;
+        uint32 iNumWakeups;
+};
+
+// msec for aNumProducers threads to send BENCH_NUM_ITEMS items to aSink
+static uint32 BenchRun(TestWatchdog& aWatchdog, TestSink* aSink, uint32 aNumProducers, bool& aOk)
+{
+    TestProducers producers;
+    if (!producers.Start(aSink, aNumProducers, BENCH_NUM_ITEMS / aNumProducers, BENCH_BURST))
+    {
+        aOk = false;
+        return 0;
+    }
+    uint32 start = OsclTickCount::TickCount();
+    producers.Go();
+    aOk = aWatchdog.RunScheduler() && aOk;
+    uint32 msec = OsclTickCount::TicksToMsec(OsclTickCount::TickCount() - start);
+    producers.Wait();
+    return (msec > 0) ? msec : 1;
+}
+
+static uint32 NsPerItem(uint32 aMsec)
+{
+    return (uint32)(((uint64)aMsec * 1000000) / BENCH_NUM_ITEMS);
+}
+
+// Mutex against lock-free, with 1, 2 and 4 producer or freeing threads
+static bool Benchmark(TestWatchdog& aWatchdog)
+{
+    bool ok = true;
+    uint32 numThreads[] = {1, 2, 4};
+    for (uint32 i = 0; i < 3; i++)
+    {
+        BenchMutexQueue mutexQueue;
+        uint32 mutexMsec = BenchRun(aWatchdog, &mutexQueue, numThreads[i], ok);
+        TestQueue lockFreeQueue(1024, numThreads[i], BENCH_NUM_ITEMS);
+        uint32 lockFreeMsec = BenchRun(aWatchdog, &lockFreeQueue, numThreads[i], ok);
+        printf("  queue, %d producer(s): mutex %d ns/item (%d wakeups), lock-free %d ns/item (%d wakeups)\n",
+               numThreads[i], NsPerItem(mutexMsec), mutexQueue.iNumWakeups,
+               NsPerItem(lockFreeMsec), lockFreeQueue.iQueue.NumWakeups());
+    }
+    for (uint32 i = 0; i < 3; i++)
+    {
+        BenchMutexCallbackAO mutexAO;
+        uint32 mutexMsec = BenchRun(aWatchdog, &mutexAO, numThreads[i], ok);
+        TestCallbackAO lockFreeAO(64, numThreads[i], BENCH_NUM_ITEMS);
+        uint32 lockFreeMsec = BenchRun(aWatchdog, &lockFreeAO, numThreads[i], ok);
+        printf("  callback AO, %d producer(s): mutex %d ns/event (%d wakeups), lock-free %d ns/event (%d wakeups)\n",
+               numThreads[i], NsPerItem(mutexMsec), mutexAO.iNumWakeups,
+               NsPerItem(lockFreeMsec), lockFreeAO.NumWakeups());
+    }
+    for (uint32 i = 0; i < 3; i++)
+    {
+        uint32 numBad = 0;
+        ThreadSafeMemPoolFixedChunkAllocator* mutexPool =
+            ThreadSafeMemPoolFixedChunkAllocator::Create(TEST_POOL_CHUNKS, TEST_CHUNK_SIZE);
+        uint32 mutexMsec = RunPoolThreads(mutexPool, numThreads[i], BENCH_NUM_ITEMS, numBad);
+        mutexPool->removeRef();
+        ThreadSafeLockFreeMemPoolFixedChunkAllocator* lockFreePool =
+            ThreadSafeLockFreeMemPoolFixedChunkAllocator::Create(TEST_POOL_CHUNKS, TEST_CHUNK_SIZE, NULL, numThreads[i] > 1);
+        uint32 lockFreeMsec = RunPoolThreads(lockFreePool, numThreads[i], BENCH_NUM_ITEMS, numBad);
+        lockFreePool->removeRef();
+        ok = ok && (mutexMsec != 0) && (lockFreeMsec != 0);
+        printf("  mempool, %d freeing thread(s): mutex %d ns/chunk, lock-free %d ns/chunk\n",
+               numThreads[i], NsPerItem(mutexMsec), NsPerItem(lockFreeMsec));
+    }
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    OsclBase::Init();
+    OsclErrorTrap::Init();
+    OsclMem::Init();
+    PVLogger::Init();
+    OsclScheduler::Init("ThreadSafeLockFreeTest");
+
+    uint32 failures = 0;
+    {
+        TestWatchdog watchdog;
+        uint32 numThreads[] = {1, 2, 4};
+
+        bool ok = TestRingFullEmptyWrap(false) && TestRingFullEmptyWrap(true);
+        printf("ring full, empty and wrap-around: %s\n", ok ? "pass" : "FAIL");
+        failures += ok ? 0 : 1;
+
+        ok = true;
+        for (uint32 i = 0; i < 3; i++)
+        {
+            ok = TestRingThreads(numThreads[i]) && ok;
+        }
+        printf("ring order with 1, 2 and 4 producer threads: %s\n", ok ? "pass" : "FAIL");
+        failures += ok ? 0 : 1;
+
+        ok = TestQueueFullCoalesced(watchdog);
+        printf("queue full and wakeup coalescing: %s\n", ok ? "pass" : "FAIL");
+        failures += ok ? 0 : 1;
+
+        ok = TestQueueLateAdd(watchdog);
+        printf("queue item added as the observer returns: %s\n", ok ? "pass" : "FAIL");
+        failures += ok ? 0 : 1;
+
+        ok = true;
+        for (uint32 i = 0; i < 3; i++)
+        {
+            ok = TestQueueThreads(watchdog, numThreads[i], false) && ok;
+            ok = TestQueueThreads(watchdog, numThreads[i], true) && ok;
+        }
+        printf("queue with producers racing the wakeup: %s\n", ok ? "pass" : "FAIL");
+        failures += ok ? 0 : 1;
+
+        ok = TestCallbackAOFullCoalesced(watchdog);
+        printf("callback AO full and wakeup coalescing: %s\n", ok ? "pass" : "FAIL");
+        failures += ok ? 0 : 1;
+
+        ok = true;
+        for (uint32 i = 0; i < 3; i++)
+        {
+            ok = TestCallbackAOThreads(watchdog, numThreads[i], false) && ok;
+            ok = TestCallbackAOThreads(watchdog, numThreads[i], true) && ok;
+        }
+        printf("callback AO with producers racing the wakeup: %s\n", ok ? "pass" : "FAIL");
+        failures += ok ? 0 : 1;
+
+        ok = TestPoolEmptyNotify();
+        printf("mempool empty and free chunk callback: %s\n", ok ? "pass" : "FAIL");
+        failures += ok ? 0 : 1;
+
+        ok = true;
+        for (uint32 i = 0; i < 3; i++)
+        {
+            ok = TestPoolThreads(numThreads[i]) && ok;
+        }
+        printf("mempool with 1, 2 and 4 freeing threads: %s\n", ok ? "pass" : "FAIL");
+        failures += ok ? 0 : 1;
+
+        if ((argc > 1) && (oscl_strcmp(argv[1], "-benchmark") == 0))
+        {
+            ok = Benchmark(watchdog);
+            printf("contention benchmark: %s\n", ok ? "pass" : "FAIL");
+            failures += ok ? 0 : 1;
+        }
+    }
+
+    OsclScheduler::Cleanup();
+    PVLogger::Cleanup();
+    OsclMem::Cleanup();
+    OsclErrorTrap::Cleanup();
+    OsclBase::Cleanup();
+    return (failures == 0) ? 0 : 1;
+}
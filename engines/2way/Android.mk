@@ -13,7 +13,8 @@ LOCAL_SRC_FILES := \
  	src/pv_2way_rec_datapath.cpp \
  	src/pv_2way_engine_factory.cpp \
  	src/pv_2way_proxy_adapter.cpp \
- 	src/pv_2way_proxy_factory.cpp
+ 	src/pv_2way_proxy_factory.cpp \
+ 	src/pv_2way_call_pool.cpp
 
 
 LOCAL_MODULE := libpv2wayengine
@@ -57,6 +58,7 @@ LOCAL_COPY_HEADERS_TO := $(PV_COPY_HEADERS_TO)
 LOCAL_COPY_HEADERS := \
 	include/pv_2way_interface.h \
  	include/pv_2way_engine_factory.h \
- 	include/pv_2way_proxy_factory.h
+ 	include/pv_2way_proxy_factory.h \
+ 	include/pv_2way_call_pool.h
 
 include $(BUILD_STATIC_LIBRARY)
@@ -66,11 +66,13 @@ SRCS := pv_2way_datapath.cpp \
 	pv_2way_rec_datapath.cpp \
 	pv_2way_engine_factory.cpp \
 	pv_2way_proxy_adapter.cpp \
-	pv_2way_proxy_factory.cpp
+	pv_2way_proxy_factory.cpp \
+	pv_2way_call_pool.cpp
 
 HDRS := pv_2way_interface.h \
 	pv_2way_engine_factory.h \
-	pv_2way_proxy_factory.h 
+	pv_2way_proxy_factory.h \
+	pv_2way_call_pool.h
 
 ## This file is need by PLATFORM_EXTRAS in library.mk
 sdkinfo_header_name := pv_2way_sdkinfo.h
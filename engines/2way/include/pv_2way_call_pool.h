@@ -0,0 +1,167 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#ifndef PV_2WAY_CALL_POOL_H_INCLUDED
+#define PV_2WAY_CALL_POOL_H_INCLUDED
+
+#ifndef PV_COMMON_TYPES_H_INCLUDED
+#include "pv_common_types.h"
+#endif
+
+#ifndef PV_2WAY_INTERFACE_H_INCLUDED
+#include "pv_2way_interface.h"
+#endif
+
+#ifndef PV_ENGINE_OBSERVER_H_INCLUDED
+#include "pv_engine_observer.h"
+#endif
+
+#ifndef OSCL_VECTOR_H_INCLUDED
+#include "oscl_vector.h"
+#endif
+
+class CPV2WayCallWorker;
+class CPV2WayProxyAdapter;
+
+/**
+ * Latency figures for one call on a CPV2WayCallPool.  All latencies are
+ * in milliseconds.  The dispatch latency is the time a command waits
+ * for the worker thread shared with the other calls; the command latency
+ * runs from the API call to the completion reaching the observer.
+ **/
+class PV2WayCallStats
+{
+    public:
+        PV2WayCallStats() : iWorker(0),
+                iNumCommands(0),
+                iMeanDispatchLatency(0),
+                iMaxDispatchLatency(0),
+                iMeanCommandLatency(0),
+                iMaxCommandLatency(0)
+        {};
+
+        uint32 iWorker;
+        uint32 iNumCommands;
+        uint32 iMeanDispatchLatency;
+        uint32 iMaxDispatchLatency;
+        uint32 iMeanCommandLatency;
+        uint32 iMaxCommandLatency;
+};
+
+/**
+ * Aggregate figures for a CPV2WayCallPool.  Command counts and latencies
+ * include the calls already deleted from the pool.  The pool is normally
+ * sized with one worker per core, in which case iCallsPerWorkerX100 is
+ * the current number of calls per core scaled by 100.
+ **/
+class PV2WayCallPoolStats
+{
+    public:
+        PV2WayCallPoolStats() : iNumWorkers(0),
+                iNumCalls(0),
+                iMaxCallsPerWorker(0),
+                iCallsPerWorkerX100(0),
+                iNumCommands(0),
+                iMeanDispatchLatency(0),
+                iMaxDispatchLatency(0),
+                iMeanCommandLatency(0),
+                iMaxCommandLatency(0)
+        {};
+
+        uint32 iNumWorkers;
+        uint32 iNumCalls;
+        uint32 iMaxCallsPerWorker;
+        uint32 iCallsPerWorkerX100;
+        uint32 iNumCommands;
+        uint32 iMeanDispatchLatency;
+        uint32 iMaxDispatchLatency;
+        uint32 iMeanCommandLatency;
+        uint32 iMaxCommandLatency;
+};
+
+/**
+ * CPV2WayCallPool Class
+ *
+ * A set of PV threads shared by many 324m terminals.  Each terminal
+ * created from the pool behaves like one from CPV2WayProxyFactory, but
+ * instead of starting a thread of its own it runs its engine, including
+ * its H.223 mux, on the scheduler of the least loaded worker.  The pool
+ * must be created and used from a thread with an Oscl scheduler, which
+ * is where command completions and events are delivered.
+ *
+ * Pools are created and deleted with CPV2WayProxyFactory.
+ **/
+class CPV2WayCallPool
+{
+    public:
+        /**
+         * Creates a terminal on the least loaded worker.
+         *
+         * @param aTerminalType the type of terminal to be created.
+         * @param aCmdStatusObserver     the observer for command status
+         * @param aInfoEventObserver     the observer for unsolicited informational events
+         * @param aErrorEventObserver     the observer for unsolicited error events
+         *
+         * @returns A pointer to a terminal, NULL if the type is not supported.  Leaves if the system is out of resources
+         **/
+        OSCL_IMPORT_REF CPV2WayInterface *CreateTerminal(TPVTerminalType aTerminalType,
+                PVCommandStatusObserver* aCmdStatusObserver,
+                PVInformationalEventObserver *aInfoEventObserver,
+                PVErrorEventObserver *aErrorEventObserver);
+
+        /**
+         * Deletes a terminal created by this pool.  As with
+         * CPV2WayProxyFactory::DeleteTerminal the terminal should be idle.
+         *
+         * @param aTerminal the terminal to be deleted.
+         **/
+        OSCL_IMPORT_REF void DeleteTerminal(CPV2WayInterface* aTerminal);
+
+        /**
+         * Fills in the aggregate figures for the pool.
+         **/
+        OSCL_IMPORT_REF void GetStats(PV2WayCallPoolStats& aStats);
+
+        /**
+         * Fills in the figures for one call.
+         *
+         * @returns false if the terminal was not created by this pool.
+         **/
+        OSCL_IMPORT_REF bool GetCallStats(CPV2WayInterface* aTerminal, PV2WayCallStats& aStats);
+
+    private:
+        CPV2WayCallPool();
+        ~CPV2WayCallPool();
+
+        void ConstructL(uint32 aNumWorkers);
+        int32 FindCall(CPV2WayInterface* aTerminal);
+
+        Oscl_Vector<CPV2WayCallWorker*, OsclMemAllocator> iWorkers;
+        Oscl_Vector<CPV2WayProxyAdapter*, OsclMemAllocator> iCalls;
+
+        // totals from deleted calls
+        uint32 iRetiredDispatches;
+        uint32 iRetiredCommands;
+        uint32 iRetiredDispatchMax;
+        uint32 iRetiredCommandMax;
+        uint64 iRetiredDispatchTotal;
+        uint64 iRetiredCommandTotal;
+
+        friend class CPV2WayProxyFactory;
+};
+
+#endif // PV_2WAY_CALL_POOL_H_INCLUDED
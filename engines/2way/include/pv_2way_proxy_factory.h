@@ -30,6 +30,8 @@
 #include "pv_engine_observer.h"
 #endif
 
+class CPV2WayCallPool;
+
 class CPV2WayProxyFactory
 {
     public:
@@ -63,6 +65,25 @@ class CPV2WayProxyFactory
          *
          **/
         OSCL_IMPORT_REF static void DeleteTerminal(CPV2WayInterface* terminal);
+
+        /**
+         * Creates a pool of PV threads for running many terminals at once.
+         * Terminals are then created with CPV2WayCallPool::CreateTerminal
+         * and share the pool's threads instead of each starting one.
+         *
+         * @param aNumWorkers the number of threads, normally one per core.
+         *
+         * @returns A pointer to the pool or leaves if the system is out of resources
+         **/
+        OSCL_IMPORT_REF static CPV2WayCallPool *CreateCallPool(uint32 aNumWorkers);
+
+        /**
+         * Deletes a pool, together with any terminals still on it, and
+         * stops its threads.
+         *
+         * @param aPool the pool to be deleted.
+         **/
+        OSCL_IMPORT_REF static void DeleteCallPool(CPV2WayCallPool* aPool);
 };
 
 #endif // PV_2WAY_PROXY_FACTORY_H_INCLUDED
@@ -0,0 +1,347 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#include "pv_2way_call_pool.h"
+#include "pv_2way_call_worker.h"
+#include "pv_2way_proxy_adapter.h"
+#include "pvlogger.h"
+
+//
+// CPV2WayCallWorker
+//
+
+CPV2WayCallWorker* CPV2WayCallWorker::NewL(uint32 aIndex)
+{
+    CPV2WayCallWorker* self = OSCL_NEW(CPV2WayCallWorker, (aIndex));
+    if (self == NULL)
+    {
+        OSCL_LEAVE(PVMFErrNoMemory);
+    }
+
+    int32 error;
+    OSCL_TRY(error, self->ConstructL());
+    if (error)
+    {
+        self->Delete();
+        OSCL_LEAVE(error);
+    }
+    return self;
+}
+
+void CPV2WayCallWorker::Delete()
+{
+    OSCL_DELETE(this);
+}
+
+CPV2WayCallWorker::CPV2WayCallWorker(uint32 aIndex) :
+        iIndex(aIndex),
+        iNumCalls(0),
+        iPVProxy(NULL),
+        iProxyId(0),
+        iLogger(NULL)
+{
+    iLogger = PVLogger::GetLoggerObject("2wayEngine.CallPool");
+}
+
+CPV2WayCallWorker::~CPV2WayCallWorker()
+{
+    PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_STACK_TRACE, (0, "CPV2WayCallWorker::~CPV2WayCallWorker worker %d", iIndex));
+    if (iPVProxy)
+    {
+        iPVProxy->StopPVThread();
+        iPVProxy->Delete();
+    }
+    iDoneSem.Close();
+    iStatsLock.Close();
+}
+
+void CPV2WayCallWorker::ConstructL()
+{
+    if (iDoneSem.Create() != OsclProcStatus::SUCCESS_ERROR
+            || iStatsLock.Create() != OsclProcStatus::SUCCESS_ERROR)
+    {
+        OSCL_LEAVE(PVMFFailure);
+    }
+
+    iPVProxy = CPVInterfaceProxy::NewL(*this, NULL, PV_2WAY_CALL_WORKER_STACK_SIZE,
+                                       PV_2WAY_CALL_WORKER_RESERVE,
+                                       PV_2WAY_CALL_WORKER_RESERVE);
+    if (iPVProxy == NULL)
+    {
+        OSCL_LEAVE(PVMFErrNoMemory);
+    }
+    iProxyId = iPVProxy->RegisterProxiedInterface(*this, *this);
+    if (!iPVProxy->StartPVThread())
+    {
+        OSCL_LEAVE(PVMFFailure);
+    }
+}
+
+int32 CPV2WayCallWorker::Run(TRequestType aType, CPV2WayProxyAdapter* aAdapter)
+//called in the app thread, blocks until the PV thread has handled the request.
+{
+    Request request;
+    request.iType = aType;
+    request.iAdapter = aAdapter;
+    request.iError = 0;
+    iPVProxy->SendCommand(iProxyId, (OsclAny*)&request);
+    iDoneSem.Wait();
+    return request.iError;
+}
+
+void CPV2WayCallWorker::CreateTerminalL(CPV2WayProxyAdapter* aAdapter)
+{
+    int32 error = Run(ECreateTerminal, aAdapter);
+    if (error)
+    {
+        OSCL_LEAVE(error);
+    }
+    iNumCalls++;
+    PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_INFO, (0, "CPV2WayCallWorker::CreateTerminalL worker %d calls %d", iIndex, iNumCalls));
+}
+
+void CPV2WayCallWorker::DeleteTerminal(CPV2WayProxyAdapter* aAdapter)
+{
+    Run(EDeleteTerminal, aAdapter);
+    if (iNumCalls)
+    {
+        iNumCalls--;
+    }
+    PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_INFO, (0, "CPV2WayCallWorker::DeleteTerminal worker %d calls %d", iIndex, iNumCalls));
+}
+
+void CPV2WayCallWorker::PVThreadLogon(PVMainProxy &proxy)
+{
+    OSCL_UNUSED_ARG(proxy);
+}
+
+void CPV2WayCallWorker::PVThreadLogoff(PVMainProxy &proxy)
+{
+    OSCL_UNUSED_ARG(proxy);
+}
+
+void CPV2WayCallWorker::HandleCommand(TPVProxyMsgId aMsgId, OsclAny* aMsg)
+//called in the PV thread.
+{
+    OSCL_UNUSED_ARG(aMsgId);
+    Request* request = (Request*)aMsg;
+    switch (request->iType)
+    {
+        case ECreateTerminal:
+            OSCL_TRY(request->iError, request->iAdapter->CreateTerminal(iLogger));
+            break;
+
+        case EDeleteTerminal:
+            request->iAdapter->DeleteTerminal(iLogger);
+            break;
+    }
+    iDoneSem.Signal();
+}
+
+void CPV2WayCallWorker::CleanupNotification(TPVProxyMsgId aId, OsclAny* aMsg)
+{
+    OSCL_UNUSED_ARG(aId);
+    OSCL_UNUSED_ARG(aMsg);
+}
+
+void CPV2WayCallWorker::HandleNotification(TPVProxyMsgId aId, OsclAny* aMsg)
+{
+    OSCL_UNUSED_ARG(aId);
+    OSCL_UNUSED_ARG(aMsg);
+}
+
+void CPV2WayCallWorker::CleanupCommand(TPVProxyMsgId aId, OsclAny* aMsg)
+{
+    OSCL_UNUSED_ARG(aId);
+    OSCL_UNUSED_ARG(aMsg);
+}
+
+//
+// CPV2WayCallPool
+//
+
+CPV2WayCallPool::CPV2WayCallPool() :
+        iRetiredDispatches(0),
+        iRetiredCommands(0),
+        iRetiredDispatchMax(0),
+        iRetiredCommandMax(0),
+        iRetiredDispatchTotal(0),
+        iRetiredCommandTotal(0)
+{
+}
+
+CPV2WayCallPool::~CPV2WayCallPool()
+{
+    while (!iCalls.empty())
+    {
+        DeleteTerminal(iCalls.back());
+    }
+    for (uint32 i = 0; i < iWorkers.size(); i++)
+    {
+        iWorkers[i]->Delete();
+    }
+}
+
+void CPV2WayCallPool::ConstructL(uint32 aNumWorkers)
+{
+    if (aNumWorkers == 0)
+    {
+        aNumWorkers = 1;
+    }
+    iWorkers.reserve(aNumWorkers);
+    for (uint32 i = 0; i < aNumWorkers; i++)
+    {
+        iWorkers.push_back(CPV2WayCallWorker::NewL(i));
+    }
+}
+
+int32 CPV2WayCallPool::FindCall(CPV2WayInterface* aTerminal)
+{
+    for (uint32 i = 0; i < iCalls.size(); i++)
+    {
+        if ((CPV2WayInterface*)iCalls[i] == aTerminal)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+OSCL_EXPORT_REF CPV2WayInterface *CPV2WayCallPool::CreateTerminal(TPVTerminalType aTerminalType,
+        PVCommandStatusObserver* aCmdStatusObserver,
+        PVInformationalEventObserver *aInfoEventObserver,
+        PVErrorEventObserver *aErrorEventObserver)
+{
+    if (aTerminalType != PV_324M)
+    {
+        return NULL;
+    }
+
+    CPV2WayCallWorker* worker = iWorkers[0];
+    for (uint32 i = 1; i < iWorkers.size(); i++)
+    {
+        if (iWorkers[i]->NumCalls() < worker->NumCalls())
+        {
+            worker = iWorkers[i];
+        }
+    }
+
+    // make sure the call can be recorded before creating it
+    if (iCalls.size() == iCalls.capacity())
+    {
+        iCalls.reserve(2 * iCalls.size() + 1);
+    }
+    CPV2WayProxyAdapter* call = CPV2WayProxyAdapter::New(aTerminalType,
+                                aCmdStatusObserver,
+                                aInfoEventObserver,
+                                aErrorEventObserver,
+                                worker);
+    iCalls.push_back(call);
+    return call;
+}
+
+OSCL_EXPORT_REF void CPV2WayCallPool::DeleteTerminal(CPV2WayInterface* aTerminal)
+{
+    int32 index = FindCall(aTerminal);
+    if (index < 0)
+    {
+        return;
+    }
+    CPV2WayProxyAdapter* call = iCalls[index];
+    iCalls.erase(iCalls.begin() + index);
+
+    PV2WayCallLatency latency;
+    call->GetLatency(latency);
+    iRetiredDispatches += latency.iDispatchCount;
+    iRetiredCommands += latency.iCommandCount;
+    iRetiredDispatchTotal += latency.iDispatchTotal;
+    iRetiredCommandTotal += latency.iCommandTotal;
+    if (latency.iDispatchMax > iRetiredDispatchMax)
+    {
+        iRetiredDispatchMax = latency.iDispatchMax;
+    }
+    if (latency.iCommandMax > iRetiredCommandMax)
+    {
+        iRetiredCommandMax = latency.iCommandMax;
+    }
+
+    OSCL_DELETE(call);
+}
+
+OSCL_EXPORT_REF void CPV2WayCallPool::GetStats(PV2WayCallPoolStats& aStats)
+{
+    aStats.iNumWorkers = iWorkers.size();
+    aStats.iNumCalls = iCalls.size();
+    aStats.iMaxCallsPerWorker = 0;
+    for (uint32 i = 0; i < iWorkers.size(); i++)
+    {
+        if (iWorkers[i]->NumCalls() > aStats.iMaxCallsPerWorker)
+        {
+            aStats.iMaxCallsPerWorker = iWorkers[i]->NumCalls();
+        }
+    }
+    aStats.iCallsPerWorkerX100 = (aStats.iNumCalls * 100) / aStats.iNumWorkers;
+
+    // dispatches are counted separately since a command may not have
+    // completed yet
+    uint32 dispatches = iRetiredDispatches;
+    uint32 commands = iRetiredCommands;
+    uint64 dispatchTotal = iRetiredDispatchTotal;
+    uint64 commandTotal = iRetiredCommandTotal;
+    aStats.iMaxDispatchLatency = iRetiredDispatchMax;
+    aStats.iMaxCommandLatency = iRetiredCommandMax;
+    for (uint32 j = 0; j < iCalls.size(); j++)
+    {
+        PV2WayCallLatency latency;
+        iCalls[j]->GetLatency(latency);
+        dispatches += latency.iDispatchCount;
+        commands += latency.iCommandCount;
+        dispatchTotal += latency.iDispatchTotal;
+        commandTotal += latency.iCommandTotal;
+        if (latency.iDispatchMax > aStats.iMaxDispatchLatency)
+        {
+            aStats.iMaxDispatchLatency = latency.iDispatchMax;
+        }
+        if (latency.iCommandMax > aStats.iMaxCommandLatency)
+        {
+            aStats.iMaxCommandLatency = latency.iCommandMax;
+        }
+    }
+    aStats.iNumCommands = commands;
+    aStats.iMeanDispatchLatency = dispatches ? (uint32)(dispatchTotal / dispatches) : 0;
+    aStats.iMeanCommandLatency = commands ? (uint32)(commandTotal / commands) : 0;
+}
+
+OSCL_EXPORT_REF bool CPV2WayCallPool::GetCallStats(CPV2WayInterface* aTerminal, PV2WayCallStats& aStats)
+{
+    int32 index = FindCall(aTerminal);
+    if (index < 0)
+    {
+        return false;
+    }
+    CPV2WayProxyAdapter* call = iCalls[index];
+    PV2WayCallLatency latency;
+    call->GetLatency(latency);
+
+    aStats.iWorker = call->Worker()->Index();
+    aStats.iNumCommands = latency.iCommandCount;
+    aStats.iMeanDispatchLatency = latency.iDispatchCount ? (uint32)(latency.iDispatchTotal / latency.iDispatchCount) : 0;
+    aStats.iMaxDispatchLatency = latency.iDispatchMax;
+    aStats.iMeanCommandLatency = latency.iCommandCount ? (uint32)(latency.iCommandTotal / latency.iCommandCount) : 0;
+    aStats.iMaxCommandLatency = latency.iCommandMax;
+    return true;
+}
@@ -0,0 +1,125 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#ifndef PV_2WAY_CALL_WORKER_H_INCLUDED
+#define PV_2WAY_CALL_WORKER_H_INCLUDED
+
+#ifndef PV_INTERFACE_PROXY_H_INCLUDED
+#include "pv_interface_proxy.h"
+#endif
+
+#ifndef OSCL_SEMAPHORE_H_INCLUDED
+#include "oscl_semaphore.h"
+#endif
+
+#ifndef OSCL_MUTEX_H_INCLUDED
+#include "oscl_mutex.h"
+#endif
+
+class CPV2WayProxyAdapter;
+class PVLogger;
+
+#define PV_2WAY_CALL_WORKER_STACK_SIZE 16384
+// reserve for the proxy's interface and message lists, per worker
+#define PV_2WAY_CALL_WORKER_RESERVE 64
+
+/**
+ * One PV thread of a CPV2WayCallPool.
+ *
+ * The worker owns the proxy and its thread.  Each pooled
+ * CPV2WayProxyAdapter registers on the worker's proxy as an ordinary
+ * proxied interface, so its commands and notifications travel the same
+ * way as for a private thread.  The worker also registers itself so
+ * the app thread can have a call's engine created and deleted in the
+ * PV thread; those requests are synchronous.
+ **/
+class CPV2WayCallWorker :
+        public PVProxiedEngine,
+        public PVProxiedInterfaceServer,
+        public PVProxiedInterfaceClient
+{
+    public:
+        static CPV2WayCallWorker* NewL(uint32 aIndex);
+        void Delete();
+
+        CPVInterfaceProxy* Proxy()
+        {
+            return iPVProxy;
+        }
+        uint32 Index() const
+        {
+            return iIndex;
+        }
+
+        /* Number of calls on this worker.  App thread only. */
+        uint32 NumCalls() const
+        {
+            return iNumCalls;
+        }
+
+        /* Create or delete the call's engine in the PV thread. */
+        void CreateTerminalL(CPV2WayProxyAdapter* aAdapter);
+        void DeleteTerminal(CPV2WayProxyAdapter* aAdapter);
+
+        /* Guards the latency counters of this worker's calls. */
+        OsclMutex& StatsLock()
+        {
+            return iStatsLock;
+        }
+
+        //from PVProxiedEngine
+        void CreateLoggerAppenders() {};
+        void PVThreadLogon(PVMainProxy &proxy);
+        void PVThreadLogoff(PVMainProxy &proxy);
+
+        //from PVProxiedInterfaceServer
+        void HandleCommand(TPVProxyMsgId aMsgId, OsclAny* aMsg);
+        void CleanupNotification(TPVProxyMsgId aId, OsclAny* aMsg);
+
+        //from PVProxiedInterfaceClient
+        void HandleNotification(TPVProxyMsgId aId, OsclAny* aMsg);
+        void CleanupCommand(TPVProxyMsgId aId, OsclAny* aMsg);
+
+    private:
+        enum TRequestType
+        {
+            ECreateTerminal,
+            EDeleteTerminal
+        };
+
+        struct Request
+        {
+            TRequestType iType;
+            CPV2WayProxyAdapter* iAdapter;
+            int32 iError;
+        };
+
+        CPV2WayCallWorker(uint32 aIndex);
+        ~CPV2WayCallWorker();
+        void ConstructL();
+        int32 Run(TRequestType aType, CPV2WayProxyAdapter* aAdapter);
+
+        uint32 iIndex;
+        uint32 iNumCalls;
+        CPVInterfaceProxy* iPVProxy;
+        TPVProxyId iProxyId;
+        OsclSemaphore iDoneSem;
+        OsclMutex iStatsLock;
+        PVLogger* iLogger;
+};
+
+#endif // PV_2WAY_CALL_WORKER_H_INCLUDED
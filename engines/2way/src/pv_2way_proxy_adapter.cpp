@@ -21,6 +21,8 @@
 #include "pvt_common.h"
 #include "pv_2way_engine_factory.h"
 #include "oscl_error_trapcleanup.h"
+#include "oscl_tickcount.h"
+#include "pv_2way_call_worker.h"
 
 #define DEFAULT_2WAY_STACK_SIZE 8192
 
@@ -86,7 +88,8 @@ void PVCmnAsyncErrorEvent::Set(PVEventType aEventType,
 CPV2WayProxyAdapter *CPV2WayProxyAdapter::New(TPVTerminalType aTerminalType,
         PVCommandStatusObserver* aCmdStatusObserver,
         PVInformationalEventObserver *aInfoEventObserver,
-        PVErrorEventObserver *aErrorEventObserver)
+        PVErrorEventObserver *aErrorEventObserver,
+        CPV2WayCallWorker* aWorker)
 //called by the factory to create a new proxied 2way interface.
 {
     int32 error;
@@ -95,7 +98,8 @@ CPV2WayProxyAdapter *CPV2WayProxyAdapter::New(TPVTerminalType aTerminalType,
     {
         error = Construct(aRet, aTerminalType, aCmdStatusObserver,
                           aInfoEventObserver,
-                          aErrorEventObserver);
+                          aErrorEventObserver,
+                          aWorker);
         if (error)
         {
             OSCL_DELETE(aRet);
@@ -115,20 +119,23 @@ int32 CPV2WayProxyAdapter::Construct(CPV2WayProxyAdapter*& aRet,
                                      TPVTerminalType aTerminalType,
                                      PVCommandStatusObserver* aCmdStatusObserver,
                                      PVInformationalEventObserver *aInfoEventObserver,
-                                     PVErrorEventObserver *aErrorEventObserver)
+                                     PVErrorEventObserver *aErrorEventObserver,
+                                     CPV2WayCallWorker* aWorker)
 {
     int32 error;
     OSCL_TRY(error, aRet->ConstructL(aTerminalType,
                                      aCmdStatusObserver,
                                      aInfoEventObserver,
-                                     aErrorEventObserver));
+                                     aErrorEventObserver,
+                                     aWorker));
     return error;
 }
 
 OsclAny CPV2WayProxyAdapter::ConstructL(TPVTerminalType aTerminalType,
                                         PVCommandStatusObserver* aCmdStatusObserver,
                                         PVInformationalEventObserver *aInfoEventObserver,
-                                        PVErrorEventObserver *aErrorEventObserver)
+                                        PVErrorEventObserver *aErrorEventObserver,
+                                        CPV2WayCallWorker* aWorker)
 {
     OSCL_UNUSED_ARG(aTerminalType);
     iCmdStatusObserver = aCmdStatusObserver;
@@ -151,6 +158,26 @@ OsclAny CPV2WayProxyAdapter::ConstructL(TPVTerminalType aTerminalType,
         iFreeErrorMsg.push_back(&iErrorMsg[i]);
     }
 
+    if (aWorker)
+    {
+        //Share the worker's proxy and thread with the other calls on it.
+        iPVProxy = aWorker->Proxy();
+        iProxyId = iPVProxy->RegisterProxiedInterface(*this, *this);
+        //Create the engine under the worker's PV thread.
+        int32 error = OsclErrNone;
+        OSCL_TRY(error, aWorker->CreateTerminalL(this));
+        if (error)
+        {
+            //The worker did not count this call.  Drop the proxy so the
+            //destructor neither deletes a terminal nor the shared proxy.
+            iPVProxy->UnregisterProxiedInterface(iProxyId);
+            iPVProxy = NULL;
+            OSCL_LEAVE(error);
+        }
+        iWorker = aWorker;
+        return;
+    }
+
     //Create proxy
     iPVProxy = CPVInterfaceProxy::NewL(*this, NULL, 2 * DEFAULT_2WAY_STACK_SIZE);
     //Register ourself as a proxied interface
@@ -164,7 +191,13 @@ OsclAny CPV2WayProxyAdapter::ConstructL(TPVTerminalType aTerminalType,
 CPV2WayProxyAdapter::~CPV2WayProxyAdapter()
 {
     PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_STACK_TRACE, (0, "CPV2WayProxyAdapter::~CPV2WayProxyAdapter iterminalEngine(%x)", iterminalEngine));
-    if (iPVProxy)
+    if (iWorker)
+    {
+        //The proxy belongs to the worker; only this call goes.
+        iWorker->DeleteTerminal(this);
+        iPVProxy->UnregisterProxiedInterface(iProxyId);
+    }
+    else if (iPVProxy)
     {
         iPVProxy->StopPVThread();
         iPVProxy->Delete();
@@ -266,6 +299,13 @@ OSCL_EXPORT_REF void CPV2WayProxyAdapter::HandleCommand(TPVProxyMsgId aMsgId, Os
 {
     CPVCmnInterfaceCmdMessage *msg = (CPVCmnInterfaceCmdMessage*)aMsg;
     msg->SetId(aMsgId);
+    if (iWorker)
+    {
+        uint32 wait = OsclTickCount::TicksToMsec(OsclTickCount::TickCount() - msg->GetSendTime());
+        iWorker->StatsLock().Lock();
+        iLatency.AddDispatch(wait);
+        iWorker->StatsLock().Unlock();
+    }
     ProcessMessage(msg);
 }
 
@@ -305,6 +345,25 @@ OSCL_EXPORT_REF void CPV2WayProxyAdapter::CleanupCommand(TPVProxyMsgId aId, Oscl
 // proxied 2way API implementation.
 //
 
+PVCommandId CPV2WayProxyAdapter::SendCommand(CPVCmnInterfaceCmdMessage *aMsg)
+{
+    if (iWorker)
+    {
+        aMsg->SetSendTime(OsclTickCount::TickCount());
+    }
+    return iPVProxy->SendCommand(iProxyId, (OsclAny*)aMsg);
+}
+
+void CPV2WayProxyAdapter::GetLatency(PV2WayCallLatency& aLatency)
+{
+    if (iWorker)
+    {
+        iWorker->StatsLock().Lock();
+        aLatency = iLatency;
+        iWorker->StatsLock().Unlock();
+    }
+}
+
 PVCommandId CPV2WayProxyAdapter::GetSDKInfo(PVSDKInfo &aSDKInfo, OsclAny* aContextData)
 {
     PV2WayMessageGetSDKInfo *msg = OSCL_NEW(PV2WayMessageGetSDKInfo, (aSDKInfo, aContextData));
@@ -312,7 +371,7 @@ PVCommandId CPV2WayProxyAdapter::GetSDKInfo(PVSDKInfo &aSDKInfo, OsclAny* aConte
     {
         OSCL_LEAVE(PVMFErrNoMemory);
     }
-    return iPVProxy->SendCommand(iProxyId, (OsclAny*)msg);
+    return SendCommand(msg);
 }
 
 PVCommandId CPV2WayProxyAdapter::GetSDKModuleInfo(PVSDKModuleInfo &aSDKModuleInfo, OsclAny* aContextData)
@@ -322,7 +381,7 @@ PVCommandId CPV2WayProxyAdapter::GetSDKModuleInfo(PVSDKModuleInfo &aSDKModuleInf
     {
         OSCL_LEAVE(PVMFErrNoMemory);
     }
-    return iPVProxy->SendCommand(iProxyId, (OsclAny*)msg);
+    return SendCommand(msg);
 }
 
 PVCommandId CPV2WayProxyAdapter::Init(PV2WayInitInfo& aInitInfo, OsclAny* aContextData)
@@ -332,7 +391,7 @@ PVCommandId CPV2WayProxyAdapter::Init(PV2WayInitInfo& aInitInfo, OsclAny* aConte
     {
         OSCL_LEAVE(PVMFErrNoMemory);
     }
-    return iPVProxy->SendCommand(iProxyId, (OsclAny*)msg);
+    return SendCommand(msg);
 }
 
 
@@ -343,7 +402,7 @@ PVCommandId CPV2WayProxyAdapter::Reset(OsclAny* aContextData)
     {
         OSCL_LEAVE(PVMFErrNoMemory);
     }
-    return iPVProxy->SendCommand(iProxyId, (OsclAny*)msg);
+    return SendCommand(msg);
 }
 
 PVCommandId CPV2WayProxyAdapter::AddDataSource(PVTrackId aTrackId,
@@ -355,7 +414,7 @@ PVCommandId CPV2WayProxyAdapter::AddDataSource(PVTrackId aTrackId,
     {
         OSCL_LEAVE(PVMFErrNoMemory);
     }
-    return iPVProxy->SendCommand(iProxyId, (OsclAny*)msg);
+    return SendCommand(msg);
 }
 
 PVCommandId CPV2WayProxyAdapter::RemoveDataSource(PVMFNodeInterface& aDataSource, OsclAny* aContextData)
@@ -365,7 +424,7 @@ PVCommandId CPV2WayProxyAdapter::RemoveDataSource(PVMFNodeInterface& aDataSource
     {
         OSCL_LEAVE(PVMFErrNoMemory);
     }
-    return iPVProxy->SendCommand(iProxyId, (OsclAny*)msg);
+    return SendCommand(msg);
 }
 
 PVCommandId CPV2WayProxyAdapter::AddDataSink(PVTrackId aTrackId,
@@ -377,7 +436,7 @@ PVCommandId CPV2WayProxyAdapter::AddDataSink(PVTrackId aTrackId,
     {
         OSCL_LEAVE(PVMFErrNoMemory);
     }
-    return iPVProxy->SendCommand(iProxyId, (OsclAny*)msg);
+    return SendCommand(msg);
 }
 
 PVCommandId CPV2WayProxyAdapter::RemoveDataSink(PVMFNodeInterface& aDataSink, OsclAny* aContextData)
@@ -387,7 +446,7 @@ PVCommandId CPV2WayProxyAdapter::RemoveDataSink(PVMFNodeInterface& aDataSink, Os
     {
         OSCL_LEAVE(PVMFErrNoMemory);
     }
-    return iPVProxy->SendCommand(iProxyId, (OsclAny*)msg);
+    return SendCommand(msg);
 }
 
 PVCommandId CPV2WayProxyAdapter::Connect(const PV2WayConnectOptions& aOptions,
@@ -399,7 +458,7 @@ PVCommandId CPV2WayProxyAdapter::Connect(const PV2WayConnectOptions& aOptions,
     {
         OSCL_LEAVE(PVMFErrNoMemory);
     }
-    return iPVProxy->SendCommand(iProxyId, (OsclAny*)msg);
+    return SendCommand(msg);
 }
 
 PVCommandId CPV2WayProxyAdapter::Disconnect(OsclAny* aContextData)
@@ -409,7 +468,7 @@ PVCommandId CPV2WayProxyAdapter::Disconnect(OsclAny* aContextData)
     {
         OSCL_LEAVE(PVMFErrNoMemory);
     }
-    return iPVProxy->SendCommand(iProxyId, (OsclAny*)msg);
+    return SendCommand(msg);
 }
 
 PVCommandId CPV2WayProxyAdapter::GetState(PV2WayState& aState, OsclAny* aContextData)
@@ -419,7 +478,7 @@ PVCommandId CPV2WayProxyAdapter::GetState(PV2WayState& aState, OsclAny* aContext
     {
         OSCL_LEAVE(PVMFErrNoMemory);
     }
-    return iPVProxy->SendCommand(iProxyId, (OsclAny*)msg);
+    return SendCommand(msg);
 }
 
 PVCommandId CPV2WayProxyAdapter::Pause(PV2WayDirection aDirection,
@@ -431,7 +490,7 @@ PVCommandId CPV2WayProxyAdapter::Pause(PV2WayDirection aDirection,
     {
         OSCL_LEAVE(PVMFErrNoMemory);
     }
-    return iPVProxy->SendCommand(iProxyId, (OsclAny*)msg);
+    return SendCommand(msg);
 }
 
 PVCommandId CPV2WayProxyAdapter::Resume(PV2WayDirection aDirection,
@@ -443,7 +502,7 @@ PVCommandId CPV2WayProxyAdapter::Resume(PV2WayDirection aDirection,
     {
         OSCL_LEAVE(PVMFErrNoMemory);
     }
-    return iPVProxy->SendCommand(iProxyId, (OsclAny*)msg);
+    return SendCommand(msg);
 }
 
 PVCommandId CPV2WayProxyAdapter::SetLogAppender(const char* aTag, OsclSharedPtr<PVLoggerAppender>& aAppender, OsclAny* aContextData)
@@ -472,7 +531,7 @@ PVCommandId CPV2WayProxyAdapter::SetLogAppender(const char* aTag, OsclSharedPtr<
 
     OsclError::Pop();
 
-    return iPVProxy->SendCommand(iProxyId, (OsclAny*)msg);
+    return SendCommand(msg);
 }
 
 PVCommandId CPV2WayProxyAdapter::RemoveLogAppender(const char* aTag, OsclSharedPtr<PVLoggerAppender>& aAppender, OsclAny* aContextData)
@@ -501,7 +560,7 @@ PVCommandId CPV2WayProxyAdapter::RemoveLogAppender(const char* aTag, OsclSharedP
 
     OsclError::Pop();
 
-    return iPVProxy->SendCommand(iProxyId, (OsclAny*)msg);
+    return SendCommand(msg);
 }
 
 PVCommandId CPV2WayProxyAdapter::SetLogLevel(const char *aTag, int32 aLevel, bool aSetSubtree, OsclAny* aContextData)
@@ -534,7 +593,7 @@ PVCommandId CPV2WayProxyAdapter::SetLogLevel(const char *aTag, int32 aLevel, boo
 
     OsclError::Pop();
 
-    return iPVProxy->SendCommand(iProxyId, (OsclAny*)msg);
+    return SendCommand(msg);
 }
 
 PVCommandId CPV2WayProxyAdapter::GetLogLevel(const char *aTag, int32 &aLogLevel, OsclAny* aContextData)
@@ -563,7 +622,7 @@ PVCommandId CPV2WayProxyAdapter::GetLogLevel(const char *aTag, int32 &aLogLevel,
 
     OsclError::Pop();
 
-    return iPVProxy->SendCommand(iProxyId, (OsclAny*)msg);
+    return SendCommand(msg);
 }
 
 
@@ -575,7 +634,7 @@ PVCommandId CPV2WayProxyAdapter::QueryUUID(const PvmfMimeString& aMimeType, Oscl
     {
         OSCL_LEAVE(PVMFErrNoMemory);
     }
-    return iPVProxy->SendCommand(iProxyId, (OsclAny*)msg);
+    return SendCommand(msg);
 }
 
 PVCommandId CPV2WayProxyAdapter::QueryInterface(const PVUuid& aUuid, PVInterface*& aInterfacePtr, OsclAny* aContextData)
@@ -585,7 +644,7 @@ PVCommandId CPV2WayProxyAdapter::QueryInterface(const PVUuid& aUuid, PVInterface
     {
         OSCL_LEAVE(PVMFErrNoMemory);
     }
-    return iPVProxy->SendCommand(iProxyId, (OsclAny*)msg);
+    return SendCommand(msg);
 
     // proxiedinterface->QueryProxiedInterface(uuid, iface);
 
@@ -598,7 +657,7 @@ PVCommandId CPV2WayProxyAdapter::CancelAllCommands(OsclAny* aContextData)
     {
         OSCL_LEAVE(PVMFErrNoMemory);
     }
-    return iPVProxy->SendCommand(iProxyId, (OsclAny*)msg);
+    return SendCommand(msg);
 }
 
 //
@@ -880,6 +939,13 @@ void CPV2WayProxyAdapter::ProcessNotificationL(CPVCmnInterfaceObserverMessage *a
             //original context data.
             resp->SetId(cmd->GetCommandId());
             resp->SetContextData(cmd->GetContextData());
+            if (iWorker)
+            {
+                uint32 latency = OsclTickCount::TicksToMsec(OsclTickCount::TickCount() - cmd->GetSendTime());
+                iWorker->StatsLock().Lock();
+                iLatency.AddCommand(latency);
+                iWorker->StatsLock().Unlock();
+            }
             OSCL_TRY(err, iCmdStatusObserver->CommandCompleted(*resp));
             //ignore any leave from the observer function.
 
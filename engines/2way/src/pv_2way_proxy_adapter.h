@@ -48,6 +48,50 @@
 
 class PVLogger;
 class PVMFNodeInterface;
+class CPV2WayCallWorker;
+
+/**
+ * Latency counters of a call running on a CPV2WayCallPool, in
+ * milliseconds.  Updated under the worker's stats lock.
+ **/
+class PV2WayCallLatency
+{
+    public:
+        PV2WayCallLatency() : iDispatchCount(0),
+                iDispatchMax(0),
+                iCommandCount(0),
+                iCommandMax(0),
+                iDispatchTotal(0),
+                iCommandTotal(0)
+        {};
+
+        void AddDispatch(uint32 aMsec)
+        {
+            iDispatchCount++;
+            iDispatchTotal += aMsec;
+            if (aMsec > iDispatchMax)
+            {
+                iDispatchMax = aMsec;
+            }
+        }
+
+        void AddCommand(uint32 aMsec)
+        {
+            iCommandCount++;
+            iCommandTotal += aMsec;
+            if (aMsec > iCommandMax)
+            {
+                iCommandMax = aMsec;
+            }
+        }
+
+        uint32 iDispatchCount;
+        uint32 iDispatchMax;
+        uint32 iCommandCount;
+        uint32 iCommandMax;
+        uint64 iDispatchTotal;
+        uint64 iCommandTotal;
+};
 
 
 class PVCmnCmdRespMsg : public CPVCmnInterfaceObserverMessage,
@@ -139,9 +183,18 @@ class CPV2WayProxyAdapter :
         static CPV2WayProxyAdapter* New(TPVTerminalType aTerminalType,
                                         PVCommandStatusObserver* aCmdStatusObserver,
                                         PVInformationalEventObserver *aInfoEventObserver,
-                                        PVErrorEventObserver *aErrorEventObserver);
+                                        PVErrorEventObserver *aErrorEventObserver,
+                                        CPV2WayCallWorker* aWorker = NULL);
         ~CPV2WayProxyAdapter();
 
+        // The pool worker this call runs on, NULL if it has its own thread.
+        CPV2WayCallWorker* Worker()
+        {
+            return iWorker;
+        }
+        // Copies the latency counters of a pooled call.
+        void GetLatency(PV2WayCallLatency& aLatency);
+
         // CPV2WayInterface virtuals
         PVCommandId GetSDKInfo(PVSDKInfo &aSDKInfo, OsclAny* aContextData = NULL);
         PVCommandId GetSDKModuleInfo(PVSDKModuleInfo &aSDKModuleInfo, OsclAny* aContextData = NULL);
@@ -209,13 +262,18 @@ class CPV2WayProxyAdapter :
                 iterminalType(PV_TERMINAL_TYPE_NONE),
                 iterminalEngine(NULL),
                 iLogger(NULL),
-                iPVProxy(NULL)
+                iPVProxy(NULL),
+                iProxyId(0),
+                iWorker(NULL)
         {};
 
         OsclAny ConstructL(TPVTerminalType aTerminalType,
                            PVCommandStatusObserver* aCmdStatusObserver,
                            PVInformationalEventObserver *aInfoEventObserver,
-                           PVErrorEventObserver *aErrorEventObserver);
+                           PVErrorEventObserver *aErrorEventObserver,
+                           CPV2WayCallWorker* aWorker);
+
+        PVCommandId SendCommand(CPVCmnInterfaceCmdMessage *aMsg);
 
         PVCmnCmdRespMsg *GetCmdMsgL();
         void FreeCmdMsg(PVCmnCmdRespMsg *msg)
@@ -239,7 +297,8 @@ class CPV2WayProxyAdapter :
                              TPVTerminalType aTerminalType,
                              PVCommandStatusObserver* aCmdStatusObserver,
                              PVInformationalEventObserver *aInfoEventObserver,
-                             PVErrorEventObserver *aErrorEventObserver);
+                             PVErrorEventObserver *aErrorEventObserver,
+                             CPV2WayCallWorker* aWorker);
 
 
         PVCommandStatusObserver *iCmdStatusObserver;
@@ -270,6 +329,9 @@ class CPV2WayProxyAdapter :
         CPVInterfaceProxy *iPVProxy;
         friend class CPV2WayFactory;
         TPVProxyId iProxyId;
+
+        CPV2WayCallWorker* iWorker;
+        PV2WayCallLatency iLatency;
 };
 
 #endif //
@@ -18,6 +18,7 @@
 #include "pv_2way_proxy_factory.h"
 #include "pv_2way_engine_factory.h"
 #include "pv_2way_proxy_adapter.h"
+#include "pv_2way_call_pool.h"
 #include "pv_2way_engine.h"
 
 OSCL_EXPORT_REF void CPV2WayProxyFactory::Init()
@@ -52,3 +53,26 @@ OSCL_EXPORT_REF void CPV2WayProxyFactory::DeleteTerminal(CPV2WayInterface* termi
 {
     OSCL_DELETE((CPV2WayProxyAdapter*)terminal);
 }
+
+OSCL_EXPORT_REF CPV2WayCallPool *CPV2WayProxyFactory::CreateCallPool(uint32 aNumWorkers)
+{
+    CPV2WayCallPool* pool = OSCL_NEW(CPV2WayCallPool, ());
+    if (pool == NULL)
+    {
+        OSCL_LEAVE(PVMFErrNoMemory);
+    }
+
+    int32 error;
+    OSCL_TRY(error, pool->ConstructL(aNumWorkers));
+    if (error)
+    {
+        OSCL_DELETE(pool);
+        OSCL_LEAVE(error);
+    }
+    return pool;
+}
+
+OSCL_EXPORT_REF void CPV2WayProxyFactory::DeleteCallPool(CPV2WayCallPool* aPool)
+{
+    OSCL_DELETE(aPool);
+}
@@ -4,6 +4,9 @@ include $(CLEAR_VARS)
 LOCAL_SRC_FILES := \
 	src/alloc_dealloc_test.cpp \
  	src/av_duplicate_test.cpp \
+ 	src/crc_test.cpp \
+ 	src/h245_per_test.cpp \
+ 	src/multi_call_test.cpp \
  	src/test_engine.cpp \
  	src/init_cancel_test.cpp \
  	src/init_test.cpp \
@@ -35,6 +35,8 @@ XINCDIRS +=  ../../../pvlogger/src
 
 SRCS := alloc_dealloc_test.cpp \
 	av_duplicate_test.cpp \
+	crc_test.cpp \
+	h245_per_test.cpp \
 	test_engine.cpp \
 	init_cancel_test.cpp \
 	init_test.cpp \
@@ -44,6 +46,7 @@ SRCS := alloc_dealloc_test.cpp \
 SRCS_324 = av_test.cpp \
 	connect_cancel_test.cpp \
 	connect_test.cpp \
+	multi_call_test.cpp \
 	audio_only_test.cpp \
 	video_only_test.cpp \
 	user_input_test.cpp
@@ -0,0 +1,53 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#ifndef CRC_TEST_H_INCLUDED
+#define CRC_TEST_H_INCLUDED
+
+#include "test_engine.h"
+
+#ifndef CRCCHECK_CPP_H_INCLUDED
+#include "crccheck_cpp.h"
+#endif
+
+/**
+ * Checks the table driven H.223 CRCs against a bitwise reference, and
+ * that a CRC appended the way AL2 and AL3 send it is accepted on the
+ * receive side and a corrupted PDU is not.  The throughput benchmark is
+ * protocols/systems/tools/general/test.
+ */
+class crc_test : public test_case
+{
+    public:
+        crc_test() {};
+
+        ~crc_test() {};
+
+        void test();
+
+    private:
+        void check_crc8(uint8* aBuf, uint32 aSize);
+        void check_crc16(uint8* aBuf, uint32 aSize);
+        void check_round_trip(uint8* aBuf, uint32 aSize);
+
+        CRC iCrc;
+};
+
+
+#endif
+
+
@@ -0,0 +1,57 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#ifndef H245_PER_TEST_H_INCLUDED
+#define H245_PER_TEST_H_INCLUDED
+
+#include "test_engine.h"
+
+#ifndef PER_ARENA_H_INCLUDED
+#include "per_arena.h"
+#endif
+
+#include "h245def.h"
+
+/**
+ * Decodes a TerminalCapabilitySet into the heap and into a PerArena and
+ * checks that both, and a copy, re-encode to the original.  Also runs
+ * messages built here through encode and decode and compares the
+ * fields.  The decode rate benchmark is
+ * protocols/systems/3g-324m_pvterminal/h245/per/test.
+ */
+class h245_per_test : public test_case
+{
+    public:
+        h245_per_test() {};
+
+        ~h245_per_test() {};
+
+        void test();
+
+    private:
+        bool matches(PS_TerminalCapabilitySet aTcs);
+        void check_heap();
+        void check_arena();
+        void check_copy();
+        void check_msd_round_trip(uint8 aTerminalType, uint32 aNumber);
+        void check_user_input_round_trip(uint32 aLength);
+};
+
+
+#endif
+
+
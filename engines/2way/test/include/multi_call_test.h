@@ -0,0 +1,121 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#ifndef MULTI_CALL_TEST_H_INCLUDED
+#define MULTI_CALL_TEST_H_INCLUDED
+
+#include "test_engine.h"
+
+#ifndef PV_2WAY_CALL_POOL_H_INCLUDED
+#include "pv_2way_call_pool.h"
+#endif
+
+#define MULTI_CALL_TEST_CALLS 8
+#define MULTI_CALL_TEST_WORKERS 2
+
+class multi_call_test;
+
+/**
+ * One call of multi_call_test.  Runs init, connect over its own comm
+ * loopback, disconnect and reset, then reports back to the test.
+ */
+class multi_call_test_call : public PVCommandStatusObserver,
+        public PVInformationalEventObserver,
+        public PVErrorEventObserver
+{
+    public:
+        multi_call_test_call() : iTerminal(NULL),
+                iConnected(false),
+                iDone(false),
+                iTest(NULL),
+                iCommServer(NULL),
+                iCommServerIOControl(NULL),
+                iInitCmdId(-1),
+                iConnectCmdId(-1),
+                iDisCmdId(-1),
+                iRstCmdId(-1)
+        {};
+
+        ~multi_call_test_call() {};
+
+        bool Start(multi_call_test* aTest, CPV2WayCallPool* aPool);
+        void Cleanup(CPV2WayCallPool* aPool);
+
+        void CommandCompleted(const PVCmdResponse& aResponse);
+        void HandleInformationalEvent(const PVAsyncInformationalEvent& aEvent);
+        void HandleErrorEvent(const PVAsyncErrorEvent& aEvent);
+
+        CPV2WayInterface* iTerminal;
+        bool iConnected;
+        bool iDone;
+
+    private:
+        void Connect();
+        void Disconnect();
+        void Reset();
+        void Finish();
+
+        multi_call_test* iTest;
+        PVMFNodeInterface* iCommServer;
+        PvmiMIOControl* iCommServerIOControl;
+        PvmiMIOCommLoopbackSettings iCommSettings;
+        PV2Way324InitInfo iSdkInitInfo;
+        PV2Way324ConnectOptions iConnectOptions;
+        PVCommandId iInitCmdId;
+        PVCommandId iConnectCmdId;
+        PVCommandId iDisCmdId;
+        PVCommandId iRstCmdId;
+};
+
+/**
+ * Runs several loopback calls at once on a CPV2WayCallPool and reports
+ * the pool's calls per worker and command latencies.  Engine test 1,
+ * in the default test range.
+ */
+class multi_call_test : public test_case,
+        public OsclActiveObject
+{
+    public:
+        multi_call_test() : OsclActiveObject(OsclActiveObject::EPriorityNominal, "Multi Call Test"),
+                iPool(NULL),
+                scheduler(NULL),
+                iNumDone(0)
+        {};
+
+        ~multi_call_test() {};
+
+        void test();
+
+        void Run();
+
+        void DoCancel() {};
+
+        void CallDone(multi_call_test_call* aCall);
+
+    private:
+        void check_stats();
+        void finish();
+
+        multi_call_test_call iCalls[MULTI_CALL_TEST_CALLS];
+        CPV2WayCallPool* iPool;
+        OsclExecScheduler* scheduler;
+        int iNumDone;
+};
+
+#endif
+
+
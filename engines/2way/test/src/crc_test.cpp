@@ -0,0 +1,158 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#include "crc_test.h"
+
+#define CRC_TEST_MAX_SIZE 4096
+
+static const uint32 CrcTestSizes[] = {8, 64, 256, 1500, CRC_TEST_MAX_SIZE};
+
+// Bitwise versions of the H.223 CRCs, used as the reference.
+static uint8 RefCrc8(const uint8* aData, uint32 aSize)
+{
+    uint8 crc = CRC8_INIT;
+    for (uint32 i = 0; i < aSize; i++)
+    {
+        crc ^= aData[i];
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (uint8)((crc & 1) ? ((crc >> 1) ^ 0xe0) : (crc >> 1));
+        }
+    }
+    return crc;
+}
+
+static uint16 RefCrc16(const uint8* aData, uint32 aSize)
+{
+    uint16 crc = CRC16_INIT;
+    for (uint32 i = 0; i < aSize; i++)
+    {
+        crc ^= aData[i];
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (uint16)((crc & 1) ? ((crc >> 1) ^ 0x8408) : (crc >> 1));
+        }
+    }
+    return (uint16)(crc ^ 0xffff);
+}
+
+void crc_test::check_crc8(uint8* aBuf, uint32 aSize)
+{
+    uint8 ref = RefCrc8(aBuf, aSize);
+    test_is_true(iCrc.Crc8Check(aBuf, aSize) == ref);
+
+    // the result must not depend on how the data is split.
+    uint32 split = aSize / 3;
+    uint8 crc = iCrc.Crc8Update(CRC8_INIT, aBuf, split);
+    crc = iCrc.Crc8Update(crc, aBuf + split, aSize - split);
+    test_is_true(crc == ref);
+}
+
+void crc_test::check_crc16(uint8* aBuf, uint32 aSize)
+{
+    uint16 ref = RefCrc16(aBuf, aSize);
+    test_is_true(iCrc.Crc16Check(aBuf, aSize) == ref);
+
+    uint32 split = (aSize * 2) / 3 + 1;
+    if (split > aSize)
+    {
+        split = aSize;
+    }
+    uint16 crc = iCrc.Crc16Update(CRC16_INIT, aBuf, split);
+    crc = iCrc.Crc16Update(crc, aBuf + split, aSize - split);
+    test_is_true((uint16)(crc ^ 0xffff) == ref);
+}
+
+void crc_test::check_round_trip(uint8* aBuf, uint32 aSize)
+{
+    // AL2 appends the CRC8, AL3 the CRC16 low byte first.  Running the
+    // CRC over data plus CRC gives a constant the receiver checks for.
+    uint8 crc8 = iCrc.Crc8Check(aBuf, aSize);
+    aBuf[aSize] = crc8;
+    test_is_true(iCrc.Crc8Update(CRC8_INIT, aBuf, aSize + 1) == CRC8_RESIDUE);
+
+    // both CRCs catch every single bit error, including one in the CRC.
+    uint32 missed = 0;
+    for (uint32 bit = 0; bit < (aSize + 1) * 8; bit++)
+    {
+        aBuf[bit >> 3] ^= (uint8)(1 << (bit & 7));
+        if (iCrc.Crc8Update(CRC8_INIT, aBuf, aSize + 1) == CRC8_RESIDUE)
+        {
+            missed++;
+        }
+        aBuf[bit >> 3] ^= (uint8)(1 << (bit & 7));
+    }
+    test_is_true(missed == 0);
+
+    uint16 crc16 = iCrc.Crc16Check(aBuf, aSize);
+    aBuf[aSize] = (uint8)(crc16 & 0xff);
+    aBuf[aSize + 1] = (uint8)(crc16 >> 8);
+    test_is_true(iCrc.Crc16Update(CRC16_INIT, aBuf, aSize + 2) == CRC16_RESIDUE);
+
+    missed = 0;
+    for (uint32 bit = 0; bit < (aSize + 2) * 8; bit++)
+    {
+        aBuf[bit >> 3] ^= (uint8)(1 << (bit & 7));
+        if (iCrc.Crc16Update(CRC16_INIT, aBuf, aSize + 2) == CRC16_RESIDUE)
+        {
+            missed++;
+        }
+        aBuf[bit >> 3] ^= (uint8)(1 << (bit & 7));
+    }
+    test_is_true(missed == 0);
+}
+
+void crc_test::test()
+{
+    fprintf(fileoutput, "Start crc test.\n");
+
+    // room for the largest buffer plus a trailing CRC16.
+    uint8* buf = (uint8*)OSCL_MALLOC(CRC_TEST_MAX_SIZE + 2);
+    if (buf == NULL)
+    {
+        test_is_true(false);
+        return;
+    }
+
+    uint32 seed = 0x12345678;
+    for (uint32 i = 0; i < CRC_TEST_MAX_SIZE + 2; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        buf[i] = (uint8)(seed >> 16);
+    }
+
+    // every length up to a few slices, then some larger ones, at odd
+    // offsets so that the unaligned paths are covered.
+    for (uint32 size = 0; size <= 40; size++)
+    {
+        check_crc8(buf + 1, size);
+        check_crc16(buf + 3, size);
+    }
+    for (uint32 i = 0; i < sizeof(CrcTestSizes) / sizeof(CrcTestSizes[0]); i++)
+    {
+        check_crc8(buf, CrcTestSizes[i] - 1);
+        check_crc16(buf + 1, CrcTestSizes[i] - 1);
+    }
+    for (uint32 size = 0; size <= 100; size += 25)
+    {
+        check_round_trip(buf + 1, size);
+    }
+
+    OSCL_FREE(buf);
+    fprintf(fileoutput, "Finish crc test.\n");
+}
+
@@ -0,0 +1,212 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#include "h245_per_test.h"
+
+#include "h245_decoder.h"
+#include "h245_encoder.h"
+#include "h245_deleter.h"
+#include "h245_copier.h"
+
+#define PER_TEST_ARENA_SIZE 2048
+
+// TerminalCapabilitySet sent by this terminal for AMR, G.723, H.263
+// and MPEG-4 in both directions plus DTMF and basic string input.
+static const uint8 TestTcs[] =
+{
+    0x70, 0x00, 0x06, 0x00, 0x08, 0x81, 0x75, 0x00, 0x06, 0x57, 0x40, 0x01,
+    0x00, 0x01, 0x00, 0x00, 0x0a, 0x03, 0xe0, 0x01, 0x80, 0x01, 0x80, 0x01,
+    0x08, 0x09, 0x80, 0x00, 0x00, 0x24, 0x30, 0x11, 0x60, 0x00, 0x07, 0x00,
+    0x08, 0x81, 0x75, 0x01, 0x01, 0x01, 0x00, 0x7a, 0x01, 0x00, 0x02, 0x00,
+    0x01, 0x80, 0x00, 0x01, 0x22, 0x00, 0x00, 0x40, 0x00, 0x02, 0x09, 0xf0,
+    0x04, 0x28, 0x02, 0x08, 0x08, 0x70, 0x40, 0x01, 0x00, 0x80, 0x00, 0x03,
+    0x0c, 0x00, 0x12, 0x50, 0x00, 0x07, 0x00, 0x08, 0x81, 0x75, 0x01, 0x00,
+    0x00, 0x40, 0x02, 0x09, 0x01, 0x00, 0x03, 0x00, 0x08, 0x80, 0x00, 0x04,
+    0x83, 0x01, 0x40, 0x80, 0x00, 0x05, 0x83, 0x01, 0x10, 0x80, 0x00, 0x06,
+    0x2c, 0x30, 0x11, 0x60, 0x00, 0x07, 0x00, 0x08, 0x81, 0x75, 0x01, 0x01,
+    0x01, 0x00, 0x7a, 0x01, 0x00, 0x02, 0x00, 0x01, 0x80, 0x00, 0x07, 0x2a,
+    0x00, 0x00, 0x40, 0x00, 0x08, 0x11, 0xf0, 0x04, 0x28, 0x02, 0x08, 0x08,
+    0x70, 0x40, 0x01, 0x00, 0x80, 0x00, 0x09, 0x14, 0x00, 0x12, 0x50, 0x00,
+    0x07, 0x00, 0x08, 0x81, 0x75, 0x01, 0x00, 0x00, 0x40, 0x02, 0x09, 0x01,
+    0x00, 0x03, 0x00, 0x08, 0x00, 0x80, 0x00, 0x02, 0x01, 0x00, 0x00, 0x00,
+    0x01, 0x01, 0x00, 0x02, 0x00, 0x03, 0x01, 0x00, 0x04, 0x00, 0x05
+};
+
+static void StartInStream(S_InStream& aStream, PerArena* aArena)
+{
+    aStream.data = (uint8*)TestTcs;
+    aStream.bitIndex = 0;
+    aStream.arena = aArena;
+}
+
+bool h245_per_test::matches(PS_TerminalCapabilitySet aTcs)
+{
+    PS_OutStream stream = NewOutStream();
+    Encode_TerminalCapabilitySet(aTcs, stream);
+    WriteRemainingBits(stream);
+    bool same = (stream->byteIndex == sizeof(TestTcs) &&
+                 oscl_memcmp(stream->data, TestTcs, sizeof(TestTcs)) == 0);
+    FreeOutStream(stream);
+    return same;
+}
+
+void h245_per_test::check_heap()
+{
+    S_InStream stream;
+    StartInStream(stream, NULL);
+    PS_TerminalCapabilitySet tcs = (PS_TerminalCapabilitySet)PerDecodeMalloc(&stream, sizeof(S_TerminalCapabilitySet));
+    Decode_TerminalCapabilitySet(tcs, &stream);
+    test_is_true(stream.data == TestTcs + sizeof(TestTcs));
+    test_is_true(matches(tcs));
+    Delete_TerminalCapabilitySet(tcs);
+    OSCL_DEFAULT_FREE(tcs);
+}
+
+void h245_per_test::check_arena()
+{
+    // a small buffer so that the message runs on into chained blocks.
+    uint64 buffer[16];
+    PerArena arena(buffer, sizeof(buffer));
+    S_InStream stream;
+    StartInStream(stream, &arena);
+    PS_TerminalCapabilitySet tcs = (PS_TerminalCapabilitySet)PerDecodeMalloc(&stream, sizeof(S_TerminalCapabilitySet));
+    Decode_TerminalCapabilitySet(tcs, &stream);
+    test_is_true(stream.data == TestTcs + sizeof(TestTcs));
+    test_is_true(matches(tcs));
+    test_is_true(arena.BytesUsed() > sizeof(buffer));
+    fprintf(fileoutput, "  decoded TerminalCapabilitySet uses %d arena bytes\n", arena.BytesUsed());
+
+    arena.Reset();
+    test_is_true(arena.BytesUsed() == 0);
+}
+
+void h245_per_test::check_copy()
+{
+    uint8* space = (uint8*)OSCL_DEFAULT_MALLOC(PER_TEST_ARENA_SIZE);
+    PerArena arena(space, PER_TEST_ARENA_SIZE);
+    S_InStream stream;
+    StartInStream(stream, &arena);
+    PS_TerminalCapabilitySet tcs = (PS_TerminalCapabilitySet)PerDecodeMalloc(&stream, sizeof(S_TerminalCapabilitySet));
+    Decode_TerminalCapabilitySet(tcs, &stream);
+
+    // copies of a received message are kept on the heap.
+    PS_TerminalCapabilitySet copy = Copy_TerminalCapabilitySet(tcs);
+    arena.Reset();
+    test_is_true(matches(copy));
+    Delete_TerminalCapabilitySet(copy);
+    OSCL_DEFAULT_FREE(copy);
+    OSCL_DEFAULT_FREE(space);
+}
+
+void h245_per_test::check_msd_round_trip(uint8 aTerminalType, uint32 aNumber)
+{
+    S_MasterSlaveDetermination msd;
+    msd.terminalType = aTerminalType;
+    msd.statusDeterminationNumber = aNumber;
+
+    PS_OutStream out = NewOutStream();
+    Encode_MasterSlaveDetermination(&msd, out);
+    WriteRemainingBits(out);
+
+    S_InStream in;
+    in.data = out->data;
+    in.bitIndex = 0;
+    in.arena = NULL;
+    S_MasterSlaveDetermination decoded;
+    Decode_MasterSlaveDetermination(&decoded, &in);
+    test_is_true(decoded.terminalType == aTerminalType);
+    test_is_true(decoded.statusDeterminationNumber == aNumber);
+    Delete_MasterSlaveDetermination(&decoded);
+    FreeOutStream(out);
+}
+
+void h245_per_test::check_user_input_round_trip(uint32 aLength)
+{
+    static const char digits[] = "0123456789#*ABCD";
+    uint8* text = (uint8*)OSCL_DEFAULT_MALLOC(aLength);
+    for (uint32 i = 0; i < aLength; i++)
+    {
+        text[i] = (uint8)digits[i % (sizeof(digits) - 1)];
+    }
+
+    S_int8STRING alphanumeric;
+    alphanumeric.size = (uint16)aLength;
+    alphanumeric.data = text;
+    S_UserInputIndication uii;
+    uii.index = 1;
+    uii.alphanumeric = &alphanumeric;
+
+    PS_OutStream out = NewOutStream();
+    Encode_UserInputIndication(&uii, out);
+    WriteRemainingBits(out);
+
+    // decode on the heap, then into an arena small enough that a long
+    // string needs a block of its own.
+    uint64 buffer[8];
+    PerArena arena(buffer, sizeof(buffer));
+    for (uint32 pass = 0; pass < 2; pass++)
+    {
+        S_InStream in;
+        in.data = out->data;
+        in.bitIndex = 0;
+        in.arena = pass ? &arena : NULL;
+        S_UserInputIndication decoded;
+        Decode_UserInputIndication(&decoded, &in);
+        test_is_true(in.data == out->data + out->byteIndex);
+        test_is_true(decoded.index == 1);
+        if (decoded.index != 1)
+        {
+            break;
+        }
+
+        // the decoder NUL terminates the string and counts the NUL.
+        PS_int8STRING str = decoded.alphanumeric;
+        test_is_true(str->size == aLength + 1);
+        test_is_true(str->size == aLength + 1 &&
+                     oscl_memcmp(str->data, text, aLength) == 0 &&
+                     str->data[aLength] == 0);
+        if (in.arena == NULL)
+        {
+            Delete_UserInputIndication(&decoded);
+        }
+    }
+
+    FreeOutStream(out);
+    OSCL_DEFAULT_FREE(text);
+}
+
+void h245_per_test::test()
+{
+    fprintf(fileoutput, "Start h245 per test.\n");
+
+    int32 leave_status = 0;
+    OSCL_TRY(leave_status,
+             check_heap();
+             check_arena();
+             check_copy();
+             check_msd_round_trip(0, 0);
+             check_msd_round_trip(128, 0x123456);
+             check_msd_round_trip(255, 16777215);
+             // one and two octet length determinants
+             check_user_input_round_trip(1);
+             check_user_input_round_trip(127);
+             check_user_input_round_trip(128);
+             check_user_input_round_trip(3000););
+    OSCL_FIRST_CATCH_ANY(leave_status, test_is_true(false));
+
+    fprintf(fileoutput, "Finish h245 per test.\n");
+}
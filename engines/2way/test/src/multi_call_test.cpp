@@ -0,0 +1,269 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#include "multi_call_test.h"
+
+
+bool multi_call_test_call::Start(multi_call_test* aTest, CPV2WayCallPool* aPool)
+{
+    iTest = aTest;
+
+    int error = 0;
+    OSCL_TRY(error, iTerminal = aPool->CreateTerminal(PV_324M,
+                                (PVCommandStatusObserver *) this,
+                                (PVInformationalEventObserver *) this,
+                                (PVErrorEventObserver *) this));
+    if (error || iTerminal == NULL)
+    {
+        iTerminal = NULL;
+        return false;
+    }
+
+    iCommSettings.iMediaFormat = PVMF_MIME_H223;
+    iCommSettings.iTestObserver = NULL;
+    iCommServerIOControl = PvmiMIOCommLoopbackFactory::Create(iCommSettings);
+    iCommServer = PVCommsIONodeFactory::Create(iCommServerIOControl, false);
+    iConnectOptions.iLoopbackMode = PV_LOOPBACK_MUX;
+
+    iSdkInitInfo.iIncomingAudioFormats.push_back(PVMF_MIME_AMR_IF2);
+    iSdkInitInfo.iOutgoingAudioFormats.push_back(PVMF_MIME_AMR_IF2);
+    iSdkInitInfo.iIncomingVideoFormats.push_back(PVMF_MIME_YUV420);
+    iSdkInitInfo.iOutgoingVideoFormats.push_back(PVMF_MIME_YUV420);
+
+    OSCL_TRY(error, iInitCmdId = iTerminal->Init(iSdkInitInfo));
+    if (error)
+    {
+        return false;
+    }
+    return true;
+}
+
+void multi_call_test_call::Cleanup(CPV2WayCallPool* aPool)
+{
+    if (iTerminal)
+    {
+        aPool->DeleteTerminal(iTerminal);
+        iTerminal = NULL;
+    }
+
+    if (iCommServer)
+    {
+        PVCommsIONodeFactory::Delete(iCommServer);
+        iCommServer = NULL;
+    }
+
+    if (iCommServerIOControl)
+    {
+        PvmiMIOCommLoopbackFactory::Delete(iCommServerIOControl);
+        iCommServerIOControl = NULL;
+    }
+}
+
+void multi_call_test_call::Connect()
+{
+    int error = 0;
+    OSCL_TRY(error, iConnectCmdId = iTerminal->Connect(iConnectOptions, iCommServer));
+    if (error)
+    {
+        Reset();
+    }
+}
+
+void multi_call_test_call::Disconnect()
+{
+    int error = 0;
+    OSCL_TRY(error, iDisCmdId = iTerminal->Disconnect());
+    if (error)
+    {
+        Reset();
+    }
+}
+
+void multi_call_test_call::Reset()
+{
+    int error = 0;
+    OSCL_TRY(error, iRstCmdId = iTerminal->Reset());
+    if (error)
+    {
+        Finish();
+    }
+}
+
+void multi_call_test_call::Finish()
+{
+    iDone = true;
+    iTest->CallDone(this);
+}
+
+void multi_call_test_call::CommandCompleted(const PVCmdResponse& aResponse)
+{
+    PVCommandId cmdId = aResponse.GetCmdId();
+    bool ok = (aResponse.GetCmdStatus() == PVMFSuccess);
+
+    if (cmdId == iInitCmdId)
+    {
+        if (ok)
+        {
+            Connect();
+        }
+        else
+        {
+            Reset();
+        }
+    }
+    else if (cmdId == iConnectCmdId)
+    {
+        iConnected = ok;
+        Disconnect();
+    }
+    else if (cmdId == iDisCmdId)
+    {
+        Reset();
+    }
+    else if (cmdId == iRstCmdId)
+    {
+        Finish();
+    }
+}
+
+void multi_call_test_call::HandleInformationalEvent(const PVAsyncInformationalEvent& aEvent)
+{
+    OSCL_UNUSED_ARG(aEvent);
+}
+
+void multi_call_test_call::HandleErrorEvent(const PVAsyncErrorEvent& aEvent)
+{
+    OSCL_UNUSED_ARG(aEvent);
+}
+
+
+void multi_call_test::test()
+{
+    fprintf(fileoutput, "Start multi call test, %d calls on %d workers.\n", MULTI_CALL_TEST_CALLS, MULTI_CALL_TEST_WORKERS);
+    int error = 0;
+
+    scheduler = OsclExecScheduler::Current();
+
+    this->AddToScheduler();
+
+    OSCL_TRY(error, iPool = CPV2WayProxyFactory::CreateCallPool(MULTI_CALL_TEST_WORKERS));
+    if (error || iPool == NULL)
+    {
+        test_is_true(false);
+        this->RemoveFromScheduler();
+        return;
+    }
+
+    for (int i = 0; i < MULTI_CALL_TEST_CALLS; i++)
+    {
+        if (!iCalls[i].Start(this, iPool))
+        {
+            test_is_true(false);
+            iCalls[i].iDone = true;
+            iNumDone++;
+        }
+    }
+
+    if (iNumDone < MULTI_CALL_TEST_CALLS)
+    {
+        check_stats();
+        OSCL_TRY(error, scheduler->StartScheduler());
+        if (error != 0)
+        {
+            OSCL_LEAVE(error);
+        }
+    }
+    else
+    {
+        finish();
+    }
+
+    this->RemoveFromScheduler();
+}
+
+void multi_call_test::check_stats()
+{
+    PV2WayCallPoolStats stats;
+    iPool->GetStats(stats);
+
+    // calls are spread evenly over the workers
+    test_is_true(stats.iNumWorkers == MULTI_CALL_TEST_WORKERS);
+    test_is_true(stats.iNumCalls == MULTI_CALL_TEST_CALLS);
+    test_is_true(stats.iMaxCallsPerWorker == (MULTI_CALL_TEST_CALLS + MULTI_CALL_TEST_WORKERS - 1) / MULTI_CALL_TEST_WORKERS);
+    test_is_true(stats.iCallsPerWorkerX100 == (MULTI_CALL_TEST_CALLS * 100) / MULTI_CALL_TEST_WORKERS);
+}
+
+void multi_call_test::CallDone(multi_call_test_call* aCall)
+{
+    OSCL_UNUSED_ARG(aCall);
+    if (++iNumDone == MULTI_CALL_TEST_CALLS)
+    {
+        RunIfNotReady();
+    }
+}
+
+void multi_call_test::Run()
+{
+    finish();
+    scheduler->StopScheduler();
+}
+
+void multi_call_test::finish()
+{
+    PV2WayCallPoolStats stats;
+    int i;
+    for (i = 0; i < MULTI_CALL_TEST_CALLS; i++)
+    {
+        test_is_true(iCalls[i].iConnected);
+
+        PV2WayCallStats callStats;
+        if (iCalls[i].iTerminal && iPool->GetCallStats(iCalls[i].iTerminal, callStats))
+        {
+            // init, connect, disconnect and reset
+            test_is_true(callStats.iNumCommands == 4);
+            fprintf(fileoutput, "  call %d worker %d: %d commands, dispatch latency mean %d max %d ms, command latency mean %d max %d ms\n",
+                    i, callStats.iWorker, callStats.iNumCommands,
+                    callStats.iMeanDispatchLatency, callStats.iMaxDispatchLatency,
+                    callStats.iMeanCommandLatency, callStats.iMaxCommandLatency);
+        }
+    }
+
+    iPool->GetStats(stats);
+    fprintf(fileoutput, "  %d calls on %d workers, %d.%02d calls per worker, max %d\n",
+            stats.iNumCalls, stats.iNumWorkers,
+            stats.iCallsPerWorkerX100 / 100, stats.iCallsPerWorkerX100 % 100,
+            stats.iMaxCallsPerWorker);
+
+    for (i = 0; i < MULTI_CALL_TEST_CALLS; i++)
+    {
+        iCalls[i].Cleanup(iPool);
+    }
+
+    // the figures of deleted calls are kept
+    PV2WayCallPoolStats after;
+    iPool->GetStats(after);
+    test_is_true(after.iNumCalls == 0);
+    test_is_true(after.iNumCommands == stats.iNumCommands);
+    test_is_true(after.iMaxCommandLatency == stats.iMaxCommandLatency);
+    fprintf(fileoutput, "  %d commands, dispatch latency mean %d max %d ms, command latency mean %d max %d ms\n",
+            after.iNumCommands,
+            after.iMeanDispatchLatency, after.iMaxDispatchLatency,
+            after.iMeanCommandLatency, after.iMaxCommandLatency);
+
+    CPV2WayProxyFactory::DeleteCallPool(iPool);
+    iPool = NULL;
+}
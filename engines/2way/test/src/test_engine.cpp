@@ -28,6 +28,9 @@
 #include "connect_cancel_test.h"
 #include "audio_only_test.h"
 #include "av_duplicate_test.h"
+#include "crc_test.h"
+#include "h245_per_test.h"
+#include "multi_call_test.h"
 #include "pvmf_fileoutput_factory.h"
 #endif
 
@@ -311,7 +314,14 @@ void engine_test_suite::proxy_tests(const bool aProxy)
     FindTestRange(global_cmd_line, firstTest, lastTest, fileoutput);
 #ifndef NO_2WAY_324
     if (firstTest == 0)
+    {
         adopt_test_case(new alloc_dealloc_test(aProxy));
+        // these check the protocol code directly and need no terminal
+        adopt_test_case(new crc_test());
+        adopt_test_case(new h245_per_test());
+    }
+    if (firstTest <= 1 && lastTest >= 1)
+        adopt_test_case(new multi_call_test());
     if (firstTest <= 2 && lastTest >= 2)
         adopt_test_case(new init_test(aProxy, 1));
     if (firstTest <= 3 && lastTest >= 3)
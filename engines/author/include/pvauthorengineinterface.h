@@ -447,6 +447,17 @@ class PVAuthorEngineInterface
          */
         virtual PVAEState GetPVAuthorState() = 0;
 
+        /**
+         * This function returns runtime telemetry for the nodes in the current authoring
+         * graph as a JSON array, one object per node with its Run() time and per-port
+         * message rates, queue depth histograms and time-in-queue percentiles.
+         * Must be called from the thread in which the pvAuthor Engine runs.
+         *
+         * @param aJSON Output string to which the JSON array is appended
+         * @returns Status indicating whether the command succeeded or not.
+         */
+        virtual PVMFStatus GetGraphTelemetry(OSCL_String& aJSON) = 0;
+
         /**
          * Discover the UUIDs of interfaces associated with the specified MIME type and node
          *
@@ -441,6 +441,20 @@ OSCL_EXPORT_REF PVAEState PVAuthorEngine::GetPVAuthorState()
     return GetPVAEState();
 }
 
+////////////////////////////////////////////////////////////////////////////
+OSCL_EXPORT_REF PVMFStatus PVAuthorEngine::GetGraphTelemetry(OSCL_String& aJSON)
+{
+    LOG_STACK_TRACE((0, "PVAuthorEngine::GetGraphTelemetry"));
+
+    int32 err = OsclErrNone;
+    OSCL_TRY(err, AppendGraphTelemetry(aJSON));
+    OSCL_FIRST_CATCH_ANY(err,
+                         LOG_ERR((0, "PVAuthorEngine::GetGraphTelemetry: Error - Out of memory"));
+                         return PVMFErrNoMemory;
+                        );
+    return PVMFSuccess;
+}
+
 ////////////////////////////////////////////////////////////////////////////
 OSCL_EXPORT_REF PVCommandId PVAuthorEngine::GetSDKInfo(PVSDKInfo &aSDKInfo, const OsclAny* aContextData)
 {
@@ -2923,6 +2937,36 @@ PVAuthorEngineInterface::GetSDKInfo
     aSdkInfo.iDate  = PVAUTHOR_ENGINE_SDKINFO_DATE;
 }
 
+////////////////////////////////////////////////////////////////////////////
+void PVAuthorEngine::AppendGraphTelemetry(OSCL_String& aJSON)
+{
+    bool first = true;
+    aJSON += "[";
+    AppendNodeTelemetry(aJSON, "source", iDataSourceNodes, first);
+    AppendNodeTelemetry(aJSON, "encoder", iEncoderNodes, first);
+    AppendNodeTelemetry(aJSON, "composer", iComposerNodes, first);
+    aJSON += "]";
+}
+
+////////////////////////////////////////////////////////////////////////////
+void PVAuthorEngine::AppendNodeTelemetry(OSCL_String& aJSON, const char* aLabel, PVAENodeContainerVector& aNodes, bool& aFirst)
+{
+    for (uint32 i = 0; i < aNodes.size(); i++)
+    {
+        if (!aNodes[i] || !aNodes[i]->iNode)
+            continue;
+
+        PVMFNodeTelemetry telemetry;
+        if (aNodes[i]->iNode->GetNodeTelemetry(telemetry) != PVMFSuccess)
+            continue;
+
+        if (!aFirst)
+            aJSON += ",";
+        aFirst = false;
+        PVMFTelemetryJSON::AppendNode(aJSON, aLabel, telemetry);
+    }
+}
+
 PVMFStatus PVAuthorEngine::SendAuthoringClockToDataSources(bool aReset)
 {
     // Create the kvp for the Authoring clock
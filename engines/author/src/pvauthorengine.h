@@ -202,6 +202,7 @@ class PVAuthorEngine : public PVAuthorEngineInterface,
                 PVInterface*& aInterfacePtr,
                 const OsclAny* aContextData = NULL);
         OSCL_IMPORT_REF PVAEState GetPVAuthorState();
+        OSCL_IMPORT_REF PVMFStatus GetGraphTelemetry(OSCL_String& aJSON);
         OSCL_IMPORT_REF PVCommandId GetSDKInfo(PVSDKInfo& aSDKInfo, const OsclAny* aContextData = NULL);
         OSCL_IMPORT_REF PVCommandId GetSDKModuleInfo(PVSDKModuleInfo& aSDKModuleInfo, const OsclAny* aContextData = NULL);
         OSCL_IMPORT_REF PVCommandId CancelAllCommands(const OsclAny* aContextData = NULL);
@@ -391,6 +392,8 @@ class PVAuthorEngine : public PVAuthorEngineInterface,
         PVMFTimebase_Tickcount iAuthorClockTimebase;
         PVMFMediaClock iAuthorClock;
         PVMFStatus SendAuthoringClockToDataSources(bool aReset = false);
+        void AppendGraphTelemetry(OSCL_String& aJSON);
+        void AppendNodeTelemetry(OSCL_String& aJSON, const char* aLabel, PVAENodeContainerVector& aNodes, bool& aFirst);
 
         PVMFStatus lastNodeCommandError;
 };
@@ -90,6 +90,8 @@
 
 #define K3GPPDOWNLOADMODE_OUTPUT                    "3GPPDownloadAuthoring_output.3gp"
 #define K3GPPPROGRESSIVEDOWNLOADMODE_OUTPUT         "3GPPProgressiveDownloadAuthoring_output.3gp"
+#define K3GPPFASTSTARTMODE_OUTPUT                   "3GPPFastStartAuthoring_output.3gp"
+#define K3GPPFASTSTARTMODE_EXPECTED_SAMPLE_COUNT    2000
 #define KMOVIEFRAGMENTMODE_OUTPUT                   "MovieFragment_output.3gp"
 #define KCAPCONFIG_OUTPUT                           "CapConfig_TestOutput.3gp"
 #define KAVI_Input_Long_OUTPUT                      "Avi_Input_long_output.3gp"
@@ -480,6 +480,11 @@ bool pv_mediainput_async_test_opencomposestop::ConfigMp43gpComposer()
     {
         clipConfig->SetAuthoringMode(PVMP4FFCN_3GPP_PROGRESSIVE_DOWNLOAD_MODE);
     }
+    else if (iTestCaseNum == K3GPPFastStartModeTest)
+    {
+        clipConfig->SetAuthoringMode(PVMP4FFCN_3GPP_FAST_START_MODE);
+        clipConfig->SetExpectedSampleCount(K3GPPFASTSTARTMODE_EXPECTED_SAMPLE_COUNT);
+    }
     else if (iTestCaseNum == KMovieFragmentModeTest || iTestCaseNum == KMovieFragmentModeLongetivityTest)
     {
         clipConfig->SetAuthoringMode(PVMP4FFCN_MOVIE_FRAGMENT_MODE);
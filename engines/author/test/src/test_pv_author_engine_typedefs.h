@@ -292,6 +292,7 @@ typedef enum
 
     K3GPPDownloadModeTest = 210,                            //.amr+.yuv
     K3GPPProgressiveDownloadModeTest = 211,             //.amr+.yuv
+    K3GPPFastStartModeTest = 212,                       //.amr+.yuv
 
     KMovieFragmentModeTest = 213,
     CapConfigTest = 214,
@@ -311,6 +311,13 @@ bool PVMediaInputAuthorEngineTest::Set_Default_Params(int32 aTestnum, PVMediaInp
         }
         break;
 
+        case K3GPPFastStartModeTest:
+        {
+            aMediaInputParam.iIPFileInfo = KPCM_YUV_AVI_FILENAME;
+            aMediaInputParam.iOPFileInfo = K3GPPFASTSTARTMODE_OUTPUT;
+        }
+        break;
+
         case KMovieFragmentModeTest:
         {
             aMediaInputParam.iIPFileInfo = KPCM_YUV_AVI_FILENAME;
@@ -491,6 +498,7 @@ void PVMediaInputAuthorEngineTest::test()
 
             case K3GPPDownloadModeTest:
             case K3GPPProgressiveDownloadModeTest:
+            case K3GPPFastStartModeTest:
             case CapConfigTest:
             case AVI_Input_Longetivity_Test:
             case KMaxFileSizeLongetivityTest:
@@ -960,6 +968,11 @@ void PVMediaInputAuthorEngineTest::Print_TestCase_Name(int32 aTestnum)
             fprintf(iFile, "3GPPProgressiveDownloadMode test \n");
         }
         break;
+        case K3GPPFastStartModeTest:
+        {
+            fprintf(iFile, "3GPPFastStartMode test \n");
+        }
+        break;
         case KMovieFragmentModeTest:
         {
             fprintf(iFile, "Movie Fragment test \n");
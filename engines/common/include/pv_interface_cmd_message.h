@@ -43,7 +43,8 @@ class CPVCmnInterfaceCmdMessage
                                   OsclAny* aContextData) : iId(0),
                 iType(aType),
                 iPriority(0),
-                iContextData(aContextData) {};
+                iContextData(aContextData),
+                iSendTime(0) {};
 
         CPVCmnInterfaceCmdMessage() {};
 
@@ -87,11 +88,25 @@ class CPVCmnInterfaceCmdMessage
             iId = aId;
         }
 
+        /**
+         * Tick count at which the message was handed to the proxy, for
+         * proxies that measure command latency.
+         */
+        void SetSendTime(uint32 aTicks)
+        {
+            iSendTime = aTicks;
+        }
+        uint32 GetSendTime() const
+        {
+            return iSendTime;
+        }
+
     protected:
         PVCommandId iId;
         int iType;
         int32 iPriority;
         OsclAny* iContextData;
+        uint32 iSendTime;
 
         friend class PVInterfaceProxy;
 };
@@ -316,6 +316,18 @@ class PVPlayerInterface
          **/
         virtual PVMFStatus GetPVPlayerStateSync(PVPlayerState& aState) = 0;
 
+        /**
+         * This function returns runtime telemetry for the nodes in the current playback
+         * graph as a JSON array, one object per node with its Run() time and per-port
+         * message rates, queue depth histograms and time-in-queue percentiles.
+         * The JSON is appended to aJSON.
+         *
+         * @param aJSON
+         *         A reference to a string to which the JSON array is appended.
+         * @returns Status indicating whether the command succeeded or not.
+         **/
+        virtual PVMFStatus GetGraphTelemetrySync(OSCL_String& aJSON) = 0;
+
         /**
          * This function allows a player data source to be specified for playback. This function must be called
          * when pvPlayer is in PVP_STATE_IDLE state and before calling Init. The specified data source must be a valid PVPlayerDataSource to
@@ -985,6 +985,83 @@ PVMFStatus PVPlayerEngine::DoGetLicenseStatusSync(PVPlayerEngineCommand& aCmd)
     return status;
 }
 
+PVMFStatus PVPlayerEngine::GetGraphTelemetrySync(OSCL_String& aJSON)
+{
+    PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_STACK_TRACE, (0, "PVPlayerEngine::GetGraphTelemetrySync()"));
+    Oscl_Vector<PVPlayerEngineCommandParamUnion, OsclMemAllocator> paramvec;
+    paramvec.reserve(1);
+    paramvec.clear();
+    PVPlayerEngineCommandParamUnion param;
+    param.pOsclAny_value = (OsclAny*) & aJSON;
+    paramvec.push_back(param);
+    if (iThreadSafeQueue.IsInThread())
+    {
+        PVPlayerEngineCommand cmd(PVP_ENGINE_COMMAND_GET_GRAPH_TELEMETRY_OOTSYNC, -1, NULL, &paramvec);
+        return DoGetGraphTelemetrySync(cmd);
+    }
+    else
+    {
+        return DoOOTSyncCommand(PVP_ENGINE_COMMAND_GET_GRAPH_TELEMETRY_OOTSYNC, &paramvec);
+    }
+}
+
+PVMFStatus PVPlayerEngine::DoGetGraphTelemetrySync(PVPlayerEngineCommand& aCmd)
+{
+    PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_STACK_TRACE, (0, "PVPlayerEngine::DoGetGraphTelemetrySync() In"));
+
+    OSCL_String* json = (OSCL_String*)(aCmd.GetParam(0).pOsclAny_value);
+    if (json == NULL)
+    {
+        PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_ERR, (0, "PVPlayerEngine::DoGetGraphTelemetrySync() Passed in parameter invalid."));
+        return PVMFErrArgument;
+    }
+
+    int32 leavecode = 0;
+    OSCL_TRY(leavecode, AppendGraphTelemetry(*json));
+    OSCL_FIRST_CATCH_ANY(leavecode,
+                         PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_ERR, (0, "PVPlayerEngine::DoGetGraphTelemetrySync() Out of memory"));
+                         return PVMFErrNoMemory;
+                        );
+
+    PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_STACK_TRACE, (0, "PVPlayerEngine::DoGetGraphTelemetrySync() Out"));
+    return PVMFSuccess;
+}
+
+void PVPlayerEngine::AppendGraphTelemetry(OSCL_String& aJSON)
+{
+    bool first = true;
+    aJSON += "[";
+    AppendNodeTelemetry(aJSON, "source", iSourceNode, first);
+    for (uint32 i = 0; i < iDatapathList.size(); ++i)
+    {
+        AppendNodeTelemetry(aJSON, "decoder", iDatapathList[i].iDecNode, first);
+        AppendNodeTelemetry(aJSON, "sink", iDatapathList[i].iSinkNode, first);
+    }
+    aJSON += "]";
+}
+
+void PVPlayerEngine::AppendNodeTelemetry(OSCL_String& aJSON, const char* aLabel, PVMFNodeInterface* aNode, bool& aFirst)
+{
+    if (aNode == NULL)
+    {
+        return;
+    }
+
+    PVMFNodeTelemetry telemetry;
+    if (aNode->GetNodeTelemetry(telemetry) != PVMFSuccess)
+    {
+        // Node does not support telemetry
+        return;
+    }
+
+    if (!aFirst)
+    {
+        aJSON += ",";
+    }
+    aFirst = false;
+    PVMFTelemetryJSON::AppendNode(aJSON, aLabel, telemetry);
+}
+
 void PVPlayerEngine::addRef()
 {
 }
@@ -1608,6 +1685,11 @@ void PVPlayerEngine::Run()
                 cmdstatus = DoGetLicenseStatusSync(cmd);
                 break;
 
+            case PVP_ENGINE_COMMAND_GET_GRAPH_TELEMETRY_OOTSYNC:
+                ootsync = true;
+                cmdstatus = DoGetGraphTelemetrySync(cmd);
+                break;
+
             case PVP_ENGINE_COMMAND_CANCEL_COMMAND:
                 // Cancel() should not be handled here
                 PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_ERR, (0, "PVPlayerEngine::Run() CancelCommand should be not handled in here. Return Failure"));
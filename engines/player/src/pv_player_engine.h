@@ -383,6 +383,7 @@ typedef enum
     PVP_ENGINE_COMMAND_CAPCONFIG_GET_PARAMETERS_OOTSYNC,
     PVP_ENGINE_COMMAND_CAPCONFIG_RELEASE_PARAMETERS_OOTSYNC,
     PVP_ENGINE_COMMAND_CAPCONFIG_VERIFY_PARAMETERS_OOTSYNC,
+    PVP_ENGINE_COMMAND_GET_GRAPH_TELEMETRY_OOTSYNC,
     // Internal engine commands
     PVP_ENGINE_COMMAND_PAUSE_DUE_TO_ENDTIME_REACHED,
     PVP_ENGINE_COMMAND_PAUSE_DUE_TO_ENDOFCLIP,
@@ -910,6 +911,7 @@ class PVPlayerEngine : public OsclTimerObject,
         PVCommandId CancelAllCommands(const OsclAny* aContextData = NULL);
         PVCommandId GetPVPlayerState(PVPlayerState& aState, const OsclAny* aContextData = NULL);
         PVMFStatus GetPVPlayerStateSync(PVPlayerState& aState);
+        PVMFStatus GetGraphTelemetrySync(OSCL_String& aJSON);
         PVCommandId AddDataSource(PVPlayerDataSource& aDataSource, const OsclAny* aContextData = NULL);
         PVCommandId Init(const OsclAny* aContextData = NULL);
         PVCommandId GetMetadataKeys(PVPMetadataList& aKeyList, int32 aStartingIndex = 0, int32 aMaxEntries = -1, char* aQueryKey = NULL, const OsclAny* aContextData = NULL);
@@ -1168,6 +1170,9 @@ class PVPlayerEngine : public OsclTimerObject,
 
         PVMFStatus DoSetObserverSync(PVPlayerEngineCommand& aCmd);
         PVMFStatus DoGetLicenseStatusSync(PVPlayerEngineCommand& aCmd);
+        PVMFStatus DoGetGraphTelemetrySync(PVPlayerEngineCommand& aCmd);
+        void AppendGraphTelemetry(OSCL_String& aJSON);
+        void AppendNodeTelemetry(OSCL_String& aJSON, const char* aLabel, PVMFNodeInterface* aNode, bool& aFirst);
         PVMFStatus DoGetParametersSync(PVPlayerEngineCommand& aCmd);
         PVMFStatus DoReleaseParametersSync(PVPlayerEngineCommand& aCmd);
         PVMFStatus DoVerifyParametersSync(PVPlayerEngineCommand& aCmd);
@@ -131,6 +131,10 @@
 #include "pvlogger_mem_appender.h"
 #endif
 
+#ifndef PVLOGGER_ASYNC_APPENDER_H_INCLUDED
+#include "pvlogger_async_appender.h"
+#endif
+
 #ifndef __UNIT_TEST_TEST_ARGS__
 #include "unit_test_args.h"
 #endif
@@ -175,6 +179,7 @@ class PVLoggerConfigFile
             0 -> ErrAppender will be used
             1 -> File Appender will be used
             2 -> Mem Appender will be used
+            3 -> Async binary file appender will be used (decode player.pvlog with pvlogger_async_decode)
             Entries after this will decide the module whose logging has to be taken.For example, contents of one sample config file could be
             1
             1,PVPlayerEngine
@@ -326,6 +331,15 @@ class PVLoggerConfigFile
                     new OsclRefCounterSA<LogAppenderDestructDealloc<TextFileAppender<TimeAndIdLayout, 1024> > >(appender);
                 refCounter = appenderRefCounter;
             }
+            else if (iAppenderType == 3)
+            {
+                OSCL_wHeapString<OsclMemAllocator> logfilename(OUTPUTNAME_PREPEND_WSTRING);
+                logfilename += _STRLIT_WCHAR("player.pvlog");
+                appender = (PVLoggerAppender*)AsyncBinaryFileAppender<>::CreateAppender(logfilename.get_str());
+                OsclRefCounterSA<LogAppenderDestructDealloc<AsyncBinaryFileAppender<> > > *appenderRefCounter =
+                    new OsclRefCounterSA<LogAppenderDestructDealloc<AsyncBinaryFileAppender<> > >(appender);
+                refCounter = appenderRefCounter;
+            }
             else
             {
                 OSCL_wHeapString<OsclMemAllocator> logfilename(OUTPUTNAME_PREPEND_WSTRING);
@@ -359,7 +373,7 @@ class PVLoggerConfigFile
                 char *iLoggerString;
                 int8 iLogLevel;
         };
-        int8 iAppenderType; //Type of appender to be used for the logging 0-> Err Appender, 1-> File Appender
+        int8 iAppenderType; //Type of appender to be used for the logging 0-> Err Appender, 1-> File Appender, 2-> Mem Appender, 3-> Async Appender
         bool iLogFileRead;
         Oscl_File iLogFile;
         Oscl_FileServer iFileServer;
@@ -102,6 +102,20 @@ class PVAviFile: public PVAviFileParserStatus
         OSCL_IMPORT_REF virtual PV_AVI_FILE_PARSER_ERROR_TYPE
         GetNextStreamSampleInfo(uint32 aStreamNo, uint32& arSize, uint32& arOffset) = 0;
 
+        /**
+         * function to reposition a video stream to the last key frame at or before
+         * the target time. the next GetNextStreamMediaSample call on the stream returns
+         * that key frame. requires an index table (idx1 or OpenDML); other streams
+         * are not repositioned.
+         *
+         * @param aStreamNo video stream number
+         * @param aTargetTimeMs target time in milliseconds
+         * @return arKeyFrameTimeMs timestamp of the key frame
+         */
+
+        OSCL_IMPORT_REF virtual PV_AVI_FILE_PARSER_ERROR_TYPE
+        SeekToKeyFrame(uint32 aStreamNo, uint32 aTargetTimeMs, uint32& arKeyFrameTimeMs) = 0;
+
         /**
          * function to reset stream pointers to retrieve data from the begining. .
          * @param
@@ -152,6 +152,11 @@ class PVAviFileHeader: public PVAviFileParserStatus
             return (iStreamList[aStreamNum].GetStreamMimeType());
         }
 
+        Oscl_Vector<PVAviFileSuperIndexEntry, OsclMemAllocator>& GetSuperIndex(uint32 aStreamNum)
+        {
+            return (iStreamList[aStreamNum].GetSuperIndex());
+        }
+
         bool PalletChangeAvailable(uint32 aStreamNum)
         {
             return (iStreamList[aStreamNum].PalletChangeAvailable());
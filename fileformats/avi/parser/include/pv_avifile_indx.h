@@ -28,31 +28,52 @@
 
 typedef Oscl_Vector<IdxTblType, OsclMemAllocator> IndxTblVector;
 
+//number of index entries of a stream held in memory at a time
+const uint32 PVAVIFILE_IDX_WINDOW_SIZE = 256;
+
+//run of consecutive samples of one stream whose index entries are read
+//starting at iFileOffset. For idx1 the entries of other streams are
+//interleaved, for OpenDML a block is one standard index ('ix##') chunk.
+typedef struct
+{
+    uint32  iFirstSample;
+    uint32  iNumSamples;
+    uint32  iFileOffset;
+    uint32  iBaseOffset;    //qwBaseOffset of the standard index, unused for idx1
+    uint32  iChunkId;       //dwChunkId of the standard index, unused for idx1
+
+} PVAviFileIdxBlock;
+
+typedef Oscl_Vector<PVAviFileIdxBlock, OsclMemAllocator> IdxBlockVector;
+
 //class to parse values in index chunk. index chunk contains offset and size info of media sample.
+//Only one block offset per PVAVIFILE_IDX_WINDOW_SIZE samples is kept for idx1 and one per
+//standard index for OpenDML; the entries themselves are read on demand, a window per stream.
 class PVAviFileIdxChunk: public PVAviFileParserStatus
 {
 
     public:
 
-        //constructor
+        //constructor for idx1 chunk. file pointer is left at the end of the chunk.
         PVAviFileIdxChunk(PVFile* aFp, uint32 aIndxSize, uint32 aNumStreams);
 
+        //constructor for OpenDML index, using the super index of every stream.
+        PVAviFileIdxChunk(PVFile* aFp, PVAviFileHeader* aFileHeader, uint32 aNumStreams);
+
         //destructor
-        ~PVAviFileIdxChunk() { };
+        ~PVAviFileIdxChunk();
 
-        uint32 GetOffset(uint32 aStreamNo, uint32 aSampleNo)
-        {
-            return (((iIndexTable[aStreamNo])[aSampleNo]).offset);
-        }
+        //fills arEntry with the index entry of a sample, returns false on read error
+        //or if the sample does not exist.
+        bool GetSampleEntry(uint32 aStreamNo, uint32 aSampleNo, IdxTblType& arEntry);
 
-        uint32 GetSampleSize(uint32 aStreamNo, uint32 aSampleNo)
-        {
-            return (((iIndexTable[aStreamNo])[aSampleNo]).size);
-        }
+        //finds the last key frame at or before aSampleNo. arKeySampleNo is 0 if no
+        //sample is flagged as key frame. returns false on read error.
+        bool GetKeyFrameAtOrBefore(uint32 aStreamNo, uint32 aSampleNo, uint32& arKeySampleNo);
 
         uint32 GetNumberOfSamplesInStream(uint32 aStreamNo)
         {
-            return ((iIndexTable[aStreamNo]).size());
+            return iNumSamples[aStreamNo];
         }
 
         bool IsOffsetFromMoviList()
@@ -60,23 +81,32 @@ class PVAviFileIdxChunk: public PVAviFileParserStatus
             return iOffsetFrmMoviLst;
         }
 
-        Oscl_Vector<IndxTblVector, OsclMemAllocator>
-        GetIndexTable()
-        {
-            return iIndexTable;
-        }
-
     private:
 
-        // variable iIndexTable stores the offset and size info of ever sample in a stream
-        // size of IndxTblTypeVector = number of samples ("movi" Subchunks) in a stream.
-        // size of iIndexTable = number of streams.
+        void Init(PVFile* aFp, uint32 aNumStreams);
+
+        bool FindBlock(uint32 aStreamNo, uint32 aSampleNo, uint32& arBlockNo);
+
+        bool LoadWindow(uint32 aStreamNo, uint32 aSampleNo);
+
+        bool LoadIdx1Window(uint32 aStreamNo, const PVAviFileIdxBlock& aBlock);
+
+        bool LoadStdIndexWindow(uint32 aStreamNo, const PVAviFileIdxBlock& aBlock, uint32 aSampleNo);
 
-        Oscl_Vector < IndxTblVector,
-        OsclMemAllocator >    iIndexTable;
+        PVFile*                          ipFilePtr;
+        uint8*                           ipReadBuffer;
+        uint32                           iIndexStartOffset;
         uint32                           iIndexSize;
         uint32                           iNumStreams;
         bool                             iOffsetFrmMoviLst;
+        bool                             iOpenDml;
+
+        // iIndexBlocks, iNumSamples and iWindow have one element per stream.
+        // iWindow holds the entries of samples iWindowStart[n] onwards.
+        Oscl_Vector<IdxBlockVector, OsclMemAllocator>  iIndexBlocks;
+        Oscl_Vector<uint32, OsclMemAllocator>          iNumSamples;
+        Oscl_Vector<IndxTblVector, OsclMemAllocator>   iWindow;
+        Oscl_Vector<uint32, OsclMemAllocator>          iWindowStart;
 
 };
 
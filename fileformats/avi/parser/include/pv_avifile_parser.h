@@ -67,6 +67,10 @@ class PVAviFileParser: public PVAviFile
         PV_AVI_FILE_PARSER_ERROR_TYPE
         GetNextStreamSampleInfo(uint32 aStreamNo, uint32& arSize, uint32& arOffset);
 
+        //reposition a video stream to the last key frame at or before aTargetTimeMs
+        OSCL_IMPORT_REF PV_AVI_FILE_PARSER_ERROR_TYPE
+        SeekToKeyFrame(uint32 aStreamNo, uint32 aTargetTimeMs, uint32& arKeyFrameTimeMs);
+
         //methods to retrieve file properties
         PVAviFileMainHeaderStruct GetMainHeaderStruct()
         {
@@ -229,6 +233,8 @@ class PVAviFileParser: public PVAviFile
 
     private:
 
+        PV_AVI_FILE_PARSER_ERROR_TYPE ParseIndex();
+
         PV_AVI_FILE_PARSER_ERROR_TYPE
         GetStreamOffsetFromIndexTable(uint32 aStreamNo, uint32& arSize, uint32& aOffset);
 
@@ -246,6 +252,10 @@ class PVAviFileParser: public PVAviFile
         //store the offset of first sample. used if index table is not present.
         uint32                  iMovieChunkStartOffset;
         uint32                  iIndxChunkSize;
+        uint32                  iIndxChunkStartOffset;
+
+        //size of the file on disk, includes RIFF-AVIX chunks of OpenDML files
+        uint32                  iPhysicalFileSize;
         Oscl_Vector < uint32,
         OsclMemAllocator >  iStreamCount;
 
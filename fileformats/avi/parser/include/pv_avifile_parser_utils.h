@@ -40,6 +40,14 @@ class PVAviFileParserUtils
 
         static int32 GetStreamNumber(uint32 aData);
 
+        //decode fields of a block already read into memory; byte order as
+        //returned by read32(aFp, aBuff, true) and read32(aFp, aBuff)
+        static uint32 GetLE32(const uint8* aBuff);
+
+        static uint16 GetLE16(const uint8* aBuff);
+
+        static uint32 GetFourcc(const uint8* aBuff);
+
 
 };
 
@@ -172,9 +172,17 @@ const uint32    AVISF_DISABLED          = 0x01000000;
 const uint32    AVISF_VIDEO_PALCHANGES  = 0x10000000;
 
 //idx1 flags
-const uint32    AVIIF_KEYFRAME          = 0x01000000;
-const uint32    AVIIF_LIST              = 0x10000000;
-const uint32    AVIIF_NO_TIME           = 0x100000;
+const uint32    AVIIF_LIST              = 0x01000000;
+const uint32    AVIIF_KEYFRAME          = 0x10000000;
+const uint32    AVIIF_NO_TIME           = 0x00010000;
+
+//OpenDML index types and flags
+const uint8     AVI_INDEX_OF_INDEXES    = 0x00;
+const uint8     AVI_INDEX_OF_CHUNKS     = 0x01;
+const uint32    AVI_INDEX_DELTA_FRAME   = 0x80000000;   //standard index entry size bit set for non key frames
+const uint32    AVI_INDEX_HEADER_SIZE   = 24;           //index header following the chunk type and size
+const uint32    AVI_IDX1_ENTRY_SIZE     = 16;
+const uint32    AVI_STD_INDEX_ENTRY_SIZE = 8;
 
 typedef struct
 {
@@ -347,6 +355,17 @@ typedef struct
 
 } IdxTblType;
 
+//entry of an OpenDML super index ('indx' chunk in strl), pointing to one
+//standard index chunk of the stream.
+typedef struct
+{
+    uint32  offset;
+    uint32  offsetHigh;
+    uint32  size;
+    uint32  duration;
+
+} PVAviFileSuperIndexEntry;
+
 typedef struct
 {
     uint8 Red;
@@ -17,108 +17,435 @@
  */
 #include "pv_avifile_indx.h"
 
+#ifndef PV_AVIFILE_HEADER_H_INCLUDED
+#include "pv_avifile_header.h"
+#endif
+
+//size of standard index chunk header including chunk type and size
+#define PVAVIFILE_STD_INDEX_CHUNK_HDR_SIZE (CHUNK_SIZE + CHUNK_SIZE + AVI_INDEX_HEADER_SIZE)
+
 PVAviFileIdxChunk::PVAviFileIdxChunk(PVFile* aFp, uint32 aIndxSize, uint32 aNumStreams)
 {
+    Init(aFp, aNumStreams);
+    iIndexStartOffset = aFp->Tell();
     iIndexSize = aIndxSize;
-    iNumStreams = aNumStreams;
-    uint32 bytesRead = 0;
-    int32 strNum = 0;
-    uint32 data = 0;
-    iError = PV_AVI_FILE_PARSER_SUCCESS;
-    iOffsetFrmMoviLst = false;
-    bool firstSample = true;
 
-    for (uint32 ii = 0; ii < iNumStreams; ii++)
+    if (PV_AVI_FILE_PARSER_SUCCESS != iError)
     {
-        IndxTblVector  xtbl;
-        iIndexTable.push_back(xtbl);
+        return;
     }
 
+    // scan the table a block at a time, keeping the file offset of every
+    // PVAVIFILE_IDX_WINDOW_SIZE'th entry of each stream.
+    const uint32 readBufSize = PVAVIFILE_IDX_WINDOW_SIZE * AVI_IDX1_ENTRY_SIZE;
+    uint32 bytesRead = 0;
+    bool firstSample = true;
+
     while (bytesRead < iIndexSize)
     {
-        if (PV_AVI_FILE_PARSER_SUCCESS != PVAviFileParserUtils::read32(aFp, data))
+        uint32 readSize = iIndexSize - bytesRead;
+        if (readSize > readBufSize)
         {
-            iError = PV_AVI_FILE_PARSER_READ_ERROR;
-            break;
+            readSize = readBufSize;
         }
-        bytesRead += CHUNK_SIZE;
-        if (bytesRead > iIndexSize)
+
+        if (aFp->Read(ipReadBuffer, 1, readSize) != readSize)
         {
-            iError = PV_AVI_FILE_PARSER_BYTE_COUNT_ERROR;
+            iError = PV_AVI_FILE_PARSER_READ_ERROR;
             break;
         }
 
-        strNum = PVAviFileParserUtils::GetStreamNumber(data);
-
-        if ((strNum < 0) || (strNum >= (int32)iNumStreams))
+        uint32 numEntries = readSize / AVI_IDX1_ENTRY_SIZE;
+        const uint8* entry = ipReadBuffer;
+        for (uint32 ii = 0; ii < numEntries; ii++, entry += AVI_IDX1_ENTRY_SIZE)
         {
-            //bogus entry skip it.
-            aFp->Seek((CHUNK_SIZE + CHUNK_SIZE + CHUNK_SIZE), Oscl_File::SEEKCUR);
+            int32 strNum = PVAviFileParserUtils::GetStreamNumber(PVAviFileParserUtils::GetFourcc(entry));
+
+            if ((strNum < 0) || (strNum >= (int32)iNumStreams))
+            {
+                //bogus entry skip it.
+                continue;
+            }
+
+            if (firstSample)
+            {
+                firstSample = false;
+                if (OFFSET_FROM_MOVI_LST == PVAviFileParserUtils::GetLE32(entry + 8))
+                {
+                    iOffsetFrmMoviLst = true;
+                }
+            }
+
+            uint32 sampleCount = iNumSamples[strNum];
+            if (0 == (sampleCount % PVAVIFILE_IDX_WINDOW_SIZE))
+            {
+                PVAviFileIdxBlock blk;
+                blk.iFirstSample = sampleCount;
+                blk.iNumSamples = 0;
+                blk.iFileOffset = iIndexStartOffset + bytesRead + (ii * AVI_IDX1_ENTRY_SIZE);
+                blk.iBaseOffset = 0;
+                blk.iChunkId = 0;
+                (iIndexBlocks[strNum]).push_back(blk);
+            }
 
-            bytesRead += CHUNK_SIZE + CHUNK_SIZE + CHUNK_SIZE ; //flags+offset+size
-            continue;
+            (iIndexBlocks[strNum]).back().iNumSamples++;
+            iNumSamples[strNum] = sampleCount + 1;
         }
 
-        IdxTblType tbl;
-        tbl.chunkId = data;
+        bytesRead += readSize;
 
-        if (PV_AVI_FILE_PARSER_SUCCESS != PVAviFileParserUtils::read32(aFp, (tbl.flags)))
+        if ((readSize % AVI_IDX1_ENTRY_SIZE) != 0)
         {
-            iError = PV_AVI_FILE_PARSER_READ_ERROR;
+            //partial entry at the end of the table
+            iError = PV_AVI_FILE_PARSER_BYTE_COUNT_ERROR;
             break;
         }
+    }
+}
+
+PVAviFileIdxChunk::PVAviFileIdxChunk(PVFile* aFp, PVAviFileHeader* aFileHeader, uint32 aNumStreams)
+{
+    Init(aFp, aNumStreams);
+    iOpenDml = true;
+
+    if (PV_AVI_FILE_PARSER_SUCCESS != iError)
+    {
+        return;
+    }
+
+    uint8 hdr[PVAVIFILE_STD_INDEX_CHUNK_HDR_SIZE];
 
-        bytesRead += CHUNK_SIZE;
-        if (bytesRead > iIndexSize)
+    for (uint32 strNum = 0; strNum < iNumStreams; strNum++)
+    {
+        Oscl_Vector<PVAviFileSuperIndexEntry, OsclMemAllocator>& superIdx = aFileHeader->GetSuperIndex(strNum);
+
+        for (uint32 ii = 0; ii < superIdx.size(); ii++)
         {
-            iError = PV_AVI_FILE_PARSER_BYTE_COUNT_ERROR;
-            break;
+            if (superIdx[ii].offsetHigh != 0)
+            {
+                //PVFile offsets are 32 bit
+                PVAVIFILE_LOGERROR((0, "PVAviFileIdxChunk::PVAviFileIdxChunk: Standard index beyond 4GB"));
+                iError = PV_AVI_FILE_PARSER_WRONG_OFFSET;
+                return;
+            }
+
+            if ((0 != aFp->Seek(superIdx[ii].offset, Oscl_File::SEEKSET)) ||
+                    (aFp->Read(hdr, 1, PVAVIFILE_STD_INDEX_CHUNK_HDR_SIZE) != PVAVIFILE_STD_INDEX_CHUNK_HDR_SIZE))
+            {
+                iError = PV_AVI_FILE_PARSER_READ_ERROR;
+                return;
+            }
+
+            uint32 chunkSize = PVAviFileParserUtils::GetLE32(hdr + CHUNK_SIZE);
+            const uint8* idxHdr = hdr + CHUNK_SIZE + CHUNK_SIZE;
+            uint16 longsPerEntry = PVAviFileParserUtils::GetLE16(idxHdr);
+            uint8 indexType = idxHdr[3];
+            uint32 entriesInUse = PVAviFileParserUtils::GetLE32(idxHdr + 4);
+            uint32 chunkId = PVAviFileParserUtils::GetFourcc(idxHdr + 8);
+            uint32 baseOffset = PVAviFileParserUtils::GetLE32(idxHdr + 12);
+            uint32 baseOffsetHigh = PVAviFileParserUtils::GetLE32(idxHdr + 16);
+
+            if ((AVI_INDEX_OF_CHUNKS != indexType) || (2 != longsPerEntry) ||
+                    (chunkSize < AVI_INDEX_HEADER_SIZE) || (0 != baseOffsetHigh))
+            {
+                PVAVIFILE_LOGINFO((0, "PVAviFileIdxChunk::PVAviFileIdxChunk: Unsupported standard index skipped"));
+                continue;
+            }
+
+            uint32 maxEntries = (chunkSize - AVI_INDEX_HEADER_SIZE) / AVI_STD_INDEX_ENTRY_SIZE;
+            if (entriesInUse > maxEntries)
+            {
+                entriesInUse = maxEntries;
+            }
+
+            if (0 == entriesInUse)
+            {
+                continue;
+            }
+
+            PVAviFileIdxBlock blk;
+            blk.iFirstSample = iNumSamples[strNum];
+            blk.iNumSamples = entriesInUse;
+            blk.iFileOffset = superIdx[ii].offset + PVAVIFILE_STD_INDEX_CHUNK_HDR_SIZE;
+            blk.iBaseOffset = baseOffset;
+            blk.iChunkId = chunkId;
+            (iIndexBlocks[strNum]).push_back(blk);
+
+            iNumSamples[strNum] += entriesInUse;
         }
+    }
+}
+
+PVAviFileIdxChunk::~PVAviFileIdxChunk()
+{
+    if (ipReadBuffer)
+    {
+        oscl_free(ipReadBuffer);
+        ipReadBuffer = NULL;
+    }
+}
 
-        if (tbl.flags & AVIIF_KEYFRAME)
-            tbl.isKeyFrame = true;
-        if (tbl.flags & AVIIF_LIST)
-            tbl.ifRecList = true;
-        if (tbl.flags & AVIIF_NO_TIME)
-            tbl.ifNoTime  = true;
+void PVAviFileIdxChunk::Init(PVFile* aFp, uint32 aNumStreams)
+{
+    ipFilePtr = aFp;
+    iIndexStartOffset = 0;
+    iIndexSize = 0;
+    iNumStreams = aNumStreams;
+    iError = PV_AVI_FILE_PARSER_SUCCESS;
+    iOffsetFrmMoviLst = false;
+    iOpenDml = false;
+
+    for (uint32 ii = 0; ii < iNumStreams; ii++)
+    {
+        IdxBlockVector blocks;
+        iIndexBlocks.push_back(blocks);
+        IndxTblVector  xtbl;
+        iWindow.push_back(xtbl);
+        iNumSamples.push_back(0);
+        iWindowStart.push_back(0);
+    }
+
+    ipReadBuffer = (uint8*)oscl_malloc(PVAVIFILE_IDX_WINDOW_SIZE * AVI_IDX1_ENTRY_SIZE);
+    if (!ipReadBuffer)
+    {
+        iError = PV_AVI_FILE_PARSER_INSUFFICIENT_MEMORY;
+    }
+}
+
+bool PVAviFileIdxChunk::GetSampleEntry(uint32 aStreamNo, uint32 aSampleNo, IdxTblType& arEntry)
+{
+    if ((aStreamNo >= iNumStreams) || (aSampleNo >= iNumSamples[aStreamNo]))
+    {
+        return false;
+    }
 
-        if (PV_AVI_FILE_PARSER_SUCCESS != PVAviFileParserUtils::read32(aFp, tbl.offset, true))
+    uint32 windowStart = iWindowStart[aStreamNo];
+    if ((aSampleNo < windowStart) || (aSampleNo >= (windowStart + iWindow[aStreamNo].size())))
+    {
+        if (!LoadWindow(aStreamNo, aSampleNo))
         {
-            iError = PV_AVI_FILE_PARSER_READ_ERROR;
-            break;
+            return false;
         }
+        windowStart = iWindowStart[aStreamNo];
+    }
 
-        bytesRead += CHUNK_SIZE;
-        if (bytesRead > iIndexSize)
+    arEntry = (iWindow[aStreamNo])[aSampleNo - windowStart];
+    return true;
+}
+
+bool PVAviFileIdxChunk::GetKeyFrameAtOrBefore(uint32 aStreamNo, uint32 aSampleNo, uint32& arKeySampleNo)
+{
+    arKeySampleNo = 0;
+
+    if ((aStreamNo >= iNumStreams) || (0 == iNumSamples[aStreamNo]))
+    {
+        return false;
+    }
+
+    if (aSampleNo >= iNumSamples[aStreamNo])
+    {
+        aSampleNo = iNumSamples[aStreamNo] - 1;
+    }
+
+    // walk backwards one window at a time
+    uint32 sampleNo = aSampleNo + 1;
+    while (sampleNo > 0)
+    {
+        if (!LoadWindow(aStreamNo, sampleNo - 1))
         {
-            iError = PV_AVI_FILE_PARSER_BYTE_COUNT_ERROR;
-            break;
+            return false;
         }
 
-        if (firstSample)
+        uint32 windowStart = iWindowStart[aStreamNo];
+        for (; sampleNo > windowStart; sampleNo--)
         {
-            firstSample = false;
-            if (OFFSET_FROM_MOVI_LST == tbl.offset)
+            if (((iWindow[aStreamNo])[sampleNo - 1 - windowStart]).isKeyFrame)
             {
-                iOffsetFrmMoviLst = true;
+                arKeySampleNo = sampleNo - 1;
+                return true;
             }
         }
+    }
+
+    return true;
+}
 
-        if (PV_AVI_FILE_PARSER_SUCCESS != PVAviFileParserUtils::read32(aFp, tbl.size, true))
+bool PVAviFileIdxChunk::FindBlock(uint32 aStreamNo, uint32 aSampleNo, uint32& arBlockNo)
+{
+    IdxBlockVector& blocks = iIndexBlocks[aStreamNo];
+    if (blocks.empty())
+    {
+        return false;
+    }
+
+    // blocks are sorted by first sample
+    uint32 lo = 0;
+    uint32 hi = blocks.size();
+    while ((hi - lo) > 1)
+    {
+        uint32 mid = (lo + hi) / 2;
+        if (blocks[mid].iFirstSample <= aSampleNo)
         {
-            iError = PV_AVI_FILE_PARSER_READ_ERROR;
-            break;
+            lo = mid;
         }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    if ((aSampleNo < blocks[lo].iFirstSample) ||
+            (aSampleNo >= (blocks[lo].iFirstSample + blocks[lo].iNumSamples)))
+    {
+        return false;
+    }
+
+    arBlockNo = lo;
+    return true;
+}
+
+bool PVAviFileIdxChunk::LoadWindow(uint32 aStreamNo, uint32 aSampleNo)
+{
+    uint32 windowStart = iWindowStart[aStreamNo];
+    if ((aSampleNo >= windowStart) && (aSampleNo < (windowStart + iWindow[aStreamNo].size())))
+    {
+        return true;
+    }
+
+    uint32 blockNo = 0;
+    if (!FindBlock(aStreamNo, aSampleNo, blockNo))
+    {
+        return false;
+    }
+
+    const PVAviFileIdxBlock& blk = (iIndexBlocks[aStreamNo])[blockNo];
+    iWindow[aStreamNo].clear();
 
-        bytesRead += CHUNK_SIZE;
-        if (bytesRead > iIndexSize)
+    bool loaded = false;
+    if (iOpenDml)
+    {
+        loaded = LoadStdIndexWindow(aStreamNo, blk, aSampleNo);
+    }
+    else
+    {
+        loaded = LoadIdx1Window(aStreamNo, blk);
+    }
+
+    if (!loaded)
+    {
+        PVAVIFILE_LOGERROR((0, "PVAviFileIdxChunk::LoadWindow: Index Read Error"));
+        iWindow[aStreamNo].clear();
+    }
+
+    return loaded;
+}
+
+bool PVAviFileIdxChunk::LoadIdx1Window(uint32 aStreamNo, const PVAviFileIdxBlock& aBlock)
+{
+    IndxTblVector& window = iWindow[aStreamNo];
+    const uint32 readBufSize = PVAVIFILE_IDX_WINDOW_SIZE * AVI_IDX1_ENTRY_SIZE;
+    uint32 indexEnd = iIndexStartOffset + iIndexSize;
+    uint32 pos = aBlock.iFileOffset;
+
+    if (0 != ipFilePtr->Seek(pos, Oscl_File::SEEKSET))
+    {
+        return false;
+    }
+
+    while ((window.size() < aBlock.iNumSamples) && (pos < indexEnd))
+    {
+        uint32 readSize = indexEnd - pos;
+        if (readSize > readBufSize)
+        {
+            readSize = readBufSize;
+        }
+        readSize -= (readSize % AVI_IDX1_ENTRY_SIZE);
+        if (0 == readSize)
         {
-            iError = PV_AVI_FILE_PARSER_BYTE_COUNT_ERROR;
             break;
         }
 
-        (iIndexTable[strNum]).push_back(tbl);
+        if (ipFilePtr->Read(ipReadBuffer, 1, readSize) != readSize)
+        {
+            return false;
+        }
 
+        const uint8* entry = ipReadBuffer;
+        for (uint32 ii = 0; ii < readSize; ii += AVI_IDX1_ENTRY_SIZE, entry += AVI_IDX1_ENTRY_SIZE)
+        {
+            uint32 chunkId = PVAviFileParserUtils::GetFourcc(entry);
+            if (PVAviFileParserUtils::GetStreamNumber(chunkId) != (int32)aStreamNo)
+            {
+                continue;
+            }
+
+            IdxTblType tbl;
+            tbl.chunkId = chunkId;
+            tbl.flags = PVAviFileParserUtils::GetFourcc(entry + 4);
+            tbl.isKeyFrame = ((tbl.flags & AVIIF_KEYFRAME) != 0);
+            tbl.ifRecList = ((tbl.flags & AVIIF_LIST) != 0);
+            tbl.ifNoTime = ((tbl.flags & AVIIF_NO_TIME) != 0);
+            tbl.offset = PVAviFileParserUtils::GetLE32(entry + 8);
+            tbl.size = PVAviFileParserUtils::GetLE32(entry + 12);
+            window.push_back(tbl);
+
+            if (window.size() == aBlock.iNumSamples)
+            {
+                break;
+            }
+        }
+
+        pos += readSize;
+    }
+
+    if (window.size() != aBlock.iNumSamples)
+    {
+        return false;
     }
+
+    iWindowStart[aStreamNo] = aBlock.iFirstSample;
+    return true;
 }
 
+bool PVAviFileIdxChunk::LoadStdIndexWindow(uint32 aStreamNo, const PVAviFileIdxBlock& aBlock, uint32 aSampleNo)
+{
+    IndxTblVector& window = iWindow[aStreamNo];
+
+    // align the window inside the standard index so neighbouring lookups hit it
+    uint32 first = aBlock.iFirstSample +
+                   (((aSampleNo - aBlock.iFirstSample) / PVAVIFILE_IDX_WINDOW_SIZE) * PVAVIFILE_IDX_WINDOW_SIZE);
+    uint32 count = aBlock.iFirstSample + aBlock.iNumSamples - first;
+    if (count > PVAVIFILE_IDX_WINDOW_SIZE)
+    {
+        count = PVAVIFILE_IDX_WINDOW_SIZE;
+    }
+
+    uint32 pos = aBlock.iFileOffset + ((first - aBlock.iFirstSample) * AVI_STD_INDEX_ENTRY_SIZE);
+    uint32 readSize = count * AVI_STD_INDEX_ENTRY_SIZE;
+
+    if ((0 != ipFilePtr->Seek(pos, Oscl_File::SEEKSET)) ||
+            (ipFilePtr->Read(ipReadBuffer, 1, readSize) != readSize))
+    {
+        return false;
+    }
+
+    const uint8* entry = ipReadBuffer;
+    for (uint32 ii = 0; ii < count; ii++, entry += AVI_STD_INDEX_ENTRY_SIZE)
+    {
+        uint32 size = PVAviFileParserUtils::GetLE32(entry + 4);
+
+        IdxTblType tbl;
+        tbl.chunkId = aBlock.iChunkId;
+        tbl.isKeyFrame = ((size & AVI_INDEX_DELTA_FRAME) == 0);
+        tbl.flags = tbl.isKeyFrame ? AVIIF_KEYFRAME : 0;
+        tbl.ifRecList = false;
+        tbl.ifNoTime = false;
+        // entry offsets point at the chunk data, idx1 offsets at the chunk header
+        tbl.offset = aBlock.iBaseOffset + PVAviFileParserUtils::GetLE32(entry) - (CHUNK_SIZE + CHUNK_SIZE);
+        tbl.size = size & ~AVI_INDEX_DELTA_FRAME;
+        window.push_back(tbl);
+    }
+
+    iWindowStart[aStreamNo] = first;
+    return true;
+}
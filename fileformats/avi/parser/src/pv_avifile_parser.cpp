@@ -29,6 +29,8 @@ PVAviFileParser::PVAviFileParser(OSCL_wHeapString<OsclMemAllocator> aFileName, i
     iMovieChunkSize = 0;
     iMovieChunkStartOffset = 0;
     iIndxChunkSize = 0;
+    iIndxChunkStartOffset = 0;
+    iPhysicalFileSize = 0;
     iSampleOffset = 0;
     iTimeStampVideo = 0;
     iTimeStampAudio = 0;
@@ -63,6 +65,7 @@ PVAviFileParser::ParseFile()
         return iError;
     }
     filesize = ipFilePtr->Tell();
+    iPhysicalFileSize = filesize;
 
     // Seek back to the beginning
     ipFilePtr->Seek(0, Oscl_File::SEEKSET);
@@ -240,19 +243,10 @@ PVAviFileParser::ParseFile()
                 iError = PV_AVI_FILE_PARSER_WRONG_SIZE;
                 break;
             }
-            uint32 numStreams = GetNumStreams();
-            ipIdxChunk = OSCL_NEW(PVAviFileIdxChunk, (ipFilePtr, iIndxChunkSize, numStreams));
-            if (ipIdxChunk != NULL)
-            {
-                iError = ipIdxChunk->GetStatus();
-                if (iError != PV_AVI_FILE_PARSER_SUCCESS)
-                {
-                    OSCL_DELETE(ipIdxChunk);
-                    ipIdxChunk = NULL;
-                    break;
-                }
-                iIdxChunkPresent = true;
-            }
+
+            //index is parsed once the stream headers are known to carry an OpenDML index or not
+            iIndxChunkStartOffset = ipFilePtr->Tell();
+            ipFilePtr->Seek(iIndxChunkSize, Oscl_File::SEEKCUR);
             bytesRead += iIndxChunkSize;
         }
         else if (JUNK == chunkType)
@@ -295,9 +289,75 @@ PVAviFileParser::ParseFile()
 
     }   //while (bytesRead <= iFileSize)
 
+    if (PV_AVI_FILE_PARSER_SUCCESS == iError)
+    {
+        iError = ParseIndex();
+    }
+
     return iError;
 }
 
+PV_AVI_FILE_PARSER_ERROR_TYPE
+PVAviFileParser::ParseIndex()
+{
+    if (NULL == ipFileHeader)
+    {
+        return PV_AVI_FILE_PARSER_SUCCESS;
+    }
+
+    uint32 numStreams = GetNumStreams();
+    bool superIndexPresent = false;
+    for (uint32 ii = 0; ii < numStreams; ii++)
+    {
+        if (!ipFileHeader->GetSuperIndex(ii).empty())
+        {
+            superIndexPresent = true;
+            break;
+        }
+    }
+
+    //OpenDML index covers the RIFF-AVIX extensions as well, prefer it over idx1
+    if (superIndexPresent)
+    {
+        PVAVIFILE_LOGINFO((0, "PVAviFileParser::ParseIndex: Using OpenDML Index"));
+
+        ipIdxChunk = OSCL_NEW(PVAviFileIdxChunk, (ipFilePtr, ipFileHeader, numStreams));
+        if (ipIdxChunk != NULL)
+        {
+            if (PV_AVI_FILE_PARSER_SUCCESS == ipIdxChunk->GetStatus())
+            {
+                iIdxChunkPresent = true;
+                return PV_AVI_FILE_PARSER_SUCCESS;
+            }
+
+            PVAVIFILE_LOGERROR((0, "PVAviFileParser::ParseIndex: OpenDML Index Error"));
+            OSCL_DELETE(ipIdxChunk);
+            ipIdxChunk = NULL;
+        }
+    }
+
+    if (iIndxChunkSize > 0)
+    {
+        PVAVIFILE_LOGINFO((0, "PVAviFileParser::ParseIndex: Using idx1 Index"));
+
+        ipFilePtr->Seek(iIndxChunkStartOffset, Oscl_File::SEEKSET);
+        ipIdxChunk = OSCL_NEW(PVAviFileIdxChunk, (ipFilePtr, iIndxChunkSize, numStreams));
+        if (ipIdxChunk != NULL)
+        {
+            PV_AVI_FILE_PARSER_ERROR_TYPE error = ipIdxChunk->GetStatus();
+            if (error != PV_AVI_FILE_PARSER_SUCCESS)
+            {
+                OSCL_DELETE(ipIdxChunk);
+                ipIdxChunk = NULL;
+                return error;
+            }
+            iIdxChunkPresent = true;
+        }
+    }
+
+    return PV_AVI_FILE_PARSER_SUCCESS;
+}
+
 PV_AVI_FILE_PARSER_ERROR_TYPE
 PVAviFileParser::GetNextMediaSample(uint32& arStreamNo, uint8* aBuffer,
                                     uint32& arSize, uint32& arTimeStamp)
@@ -521,8 +581,15 @@ PVAviFileParser::GetStreamOffsetFromIndexTable(uint32 aStreamNo, uint32& arSize,
         return PV_AVI_FILE_PARSER_EOS_REACHED;
     }
 
-    sampleOffset = ipIdxChunk->GetOffset(aStreamNo, iStreamSampleCount[aStreamNo]);
-    uint32 size = ipIdxChunk->GetSampleSize(aStreamNo, iStreamSampleCount[aStreamNo]);
+    IdxTblType entry;
+    if (!ipIdxChunk->GetSampleEntry(aStreamNo, iStreamSampleCount[aStreamNo], entry))
+    {
+        PVAVIFILE_LOGERROR((0, "PVAviFileParser::GetNextMediaSample: Index Read Error"));
+        return PV_AVI_FILE_PARSER_READ_ERROR;
+    }
+
+    sampleOffset = entry.offset;
+    uint32 size = entry.size;
 
     if (size > arSize)
     {
@@ -543,7 +610,8 @@ PVAviFileParser::GetStreamOffsetFromIndexTable(uint32 aStreamNo, uint32& arSize,
 
     arOffset += (CHUNK_SIZE + CHUNK_SIZE); //add 4 bytes each for sample type and data size param.
 
-    if ((arOffset > iFileSize))
+    //OpenDML samples may lie in RIFF-AVIX lists beyond the first RIFF chunk
+    if ((arOffset > iPhysicalFileSize))
     {
         PVAVIFILE_LOGERROR((0, "PVAviFileParser::GetNextMediaSample: File Size & Byte Count mismatch"));
         return PV_AVI_FILE_PARSER_BYTE_COUNT_ERROR;
@@ -639,6 +707,54 @@ PVAviFileParser::GetStreamOffset(uint32 aStreamNo, uint32& arSampleSize, uint32&
     }
 }
 
+OSCL_EXPORT_REF PV_AVI_FILE_PARSER_ERROR_TYPE
+PVAviFileParser::SeekToKeyFrame(uint32 aStreamNo, uint32 aTargetTimeMs, uint32& arKeyFrameTimeMs)
+{
+    arKeyFrameTimeMs = 0;
+
+    if (false == iIdxChunkPresent)
+    {
+        return PV_AVI_FILE_PARSER_NO_INDEX_CHUNK;
+    }
+
+    if ((aStreamNo >= GetNumStreams()) ||
+            (NULL == oscl_strstr(GetStreamMimeType(aStreamNo).get_str(), "video")))
+    {
+        PVAVIFILE_LOGERROR((0, "PVAviFileParser::SeekToKeyFrame: Not a video stream"));
+        return PV_AVI_FILE_PARSER_ERROR_WRONG_STREAM_NUM;
+    }
+
+    uint32 numSamples = ipIdxChunk->GetNumberOfSamplesInStream(aStreamNo);
+    if (0 == numSamples)
+    {
+        return PV_AVI_FILE_PARSER_EOS_REACHED;
+    }
+
+    uint32 frameDurationInms = GetFrameDuration() / 1000;
+    uint32 targetSample = 0;
+    if (frameDurationInms > 0)
+    {
+        targetSample = aTargetTimeMs / frameDurationInms;
+    }
+
+    if (targetSample >= numSamples)
+    {
+        targetSample = numSamples - 1;
+    }
+
+    uint32 keySample = 0;
+    if (!ipIdxChunk->GetKeyFrameAtOrBefore(aStreamNo, targetSample, keySample))
+    {
+        PVAVIFILE_LOGERROR((0, "PVAviFileParser::SeekToKeyFrame: Index Read Error"));
+        return PV_AVI_FILE_PARSER_READ_ERROR;
+    }
+
+    iStreamSampleCount[aStreamNo] = keySample;
+    arKeyFrameTimeMs = keySample * frameDurationInms;
+
+    return PV_AVI_FILE_PARSER_SUCCESS;
+}
+
 OSCL_EXPORT_REF void PVAviFileParser::Reset()
 {
     PVAVIFILE_LOGINFO((0, "PVAviFileParser::Reset"));
@@ -48,6 +48,7 @@ PVAviFileParserUtils::ReadNextChunkType(PVFile* aFp, uint32& aChkType)
             || aChkType == STRN
             || aChkType == STRD
             || aChkType == IDX1
+            || aChkType == INDX
             || aChkType == VIDS
             || aChkType == AUDS
             || aChkType == MIDS
@@ -151,4 +152,19 @@ int32 PVAviFileParserUtils::GetStreamNumber(uint32 aData)
     }
 }
 
+uint32 PVAviFileParserUtils::GetLE32(const uint8* aBuff)
+{
+    return ((uint32)aBuff[0] | ((uint32)aBuff[1] << 8) |
+            ((uint32)aBuff[2] << 16) | ((uint32)aBuff[3] << 24));
+}
 
+uint16 PVAviFileParserUtils::GetLE16(const uint8* aBuff)
+{
+    return (uint16)(aBuff[0] | (aBuff[1] << 8));
+}
+
+uint32 PVAviFileParserUtils::GetFourcc(const uint8* aBuff)
+{
+    return (((uint32)aBuff[0] << 24) | ((uint32)aBuff[1] << 16) |
+            ((uint32)aBuff[2] << 8) | (uint32)aBuff[3]);
+}
@@ -242,6 +242,41 @@ PVAviFileStreamlist::PVAviFileStreamlist(PVFile *aFp, uint32 aStrListSz)
             }
 
         }
+        else if (INDX == chunkType)
+        {
+            PVAVIFILE_LOGINFO((0, "PVAviFileStreamlist::PVAviFileStreamlist: Found OpenDML Super Index"));
+
+            uint32 indxSize = 0;
+            if (PV_AVI_FILE_PARSER_SUCCESS != PVAviFileParserUtils::read32(aFp, indxSize, true))
+            {
+                PVAVIFILE_LOGERROR((0, "PVAviFileStreamlist::PVAviFileStreamlist: File Read Error"));
+                iError =  PV_AVI_FILE_PARSER_READ_ERROR;
+                break;
+            }
+
+            bytesRead += CHUNK_SIZE;
+
+            if ((indxSize <= 0) || (indxSize > iStreamListSize))
+            {
+                PVAVIFILE_LOGERROR((0, "PVAviFileStreamlist::PVAviFileStreamlist: Super index size greater than stream list size"));
+                iError = PV_AVI_FILE_PARSER_WRONG_SIZE;
+                break;
+            }
+
+            if ((iError = ParseSuperIndex(aFp, indxSize)) != PV_AVI_FILE_PARSER_SUCCESS)
+            {
+                PVAVIFILE_LOGERROR((0, "PVAviFileStreamlist::PVAviFileStreamlist: ParseSuperIndex returned error"));
+                break;
+            }
+
+            bytesRead += indxSize;
+            if (bytesRead > iStreamListSize)
+            {
+                PVAVIFILE_LOGERROR((0, "PVAviFileStreamlist::PVAviFileStreamlist: File Size & Byte Count Mismatch"));
+                iError =  PV_AVI_FILE_PARSER_BYTE_COUNT_ERROR;
+                break;
+            }
+        }
         else if (JUNK == chunkType)
         {
             PVAVIFILE_LOGINFO((0, "PVAviFileStreamlist::PVAviFileStreamlist: Skip Junk Data"));
@@ -292,6 +327,56 @@ PVAviFileStreamlist::PVAviFileStreamlist(PVFile *aFp, uint32 aStrListSz)
 }
 
 
+//Only an index of indexes is kept; the standard index chunks it points to
+//are read on demand by PVAviFileIdxChunk. Any other index type is skipped.
+PV_AVI_FILE_PARSER_ERROR_TYPE
+PVAviFileStreamlist::ParseSuperIndex(PVFile *aFp, uint32 aIndxSize)
+{
+    iSuperIndex.clear();
+
+    uint8* indx = (uint8*)oscl_malloc(aIndxSize);
+    if (!indx)
+    {
+        return PV_AVI_FILE_PARSER_INSUFFICIENT_MEMORY;
+    }
+
+    if (aFp->Read(indx, 1, aIndxSize) != aIndxSize)
+    {
+        oscl_free(indx);
+        return PV_AVI_FILE_PARSER_READ_ERROR;
+    }
+
+    if (aIndxSize >= AVI_INDEX_HEADER_SIZE)
+    {
+        uint16 longsPerEntry = PVAviFileParserUtils::GetLE16(indx);
+        uint8 indexType = indx[3];
+        uint32 entriesInUse = PVAviFileParserUtils::GetLE32(indx + 4);
+        uint32 entrySize = longsPerEntry * sizeof(uint32);
+
+        if ((AVI_INDEX_OF_INDEXES == indexType) && (4 == longsPerEntry) &&
+                (entriesInUse <= ((aIndxSize - AVI_INDEX_HEADER_SIZE) / entrySize)))
+        {
+            const uint8* entry = indx + AVI_INDEX_HEADER_SIZE;
+            for (uint32 ii = 0; ii < entriesInUse; ii++, entry += entrySize)
+            {
+                PVAviFileSuperIndexEntry superIdx;
+                superIdx.offset = PVAviFileParserUtils::GetLE32(entry);
+                superIdx.offsetHigh = PVAviFileParserUtils::GetLE32(entry + 4);
+                superIdx.size = PVAviFileParserUtils::GetLE32(entry + 8);
+                superIdx.duration = PVAviFileParserUtils::GetLE32(entry + 12);
+                iSuperIndex.push_back(superIdx);
+            }
+        }
+        else
+        {
+            PVAVIFILE_LOGINFO((0, "PVAviFileStreamlist::ParseSuperIndex: Unsupported index type skipped"));
+        }
+    }
+
+    oscl_free(indx);
+    return PV_AVI_FILE_PARSER_SUCCESS;
+}
+
 PV_AVI_FILE_PARSER_ERROR_TYPE
 PVAviFileStreamlist::ParseStreamHeader(PVFile *aFp, uint32 aHdrSize)
 {
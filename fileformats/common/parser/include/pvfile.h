@@ -39,6 +39,12 @@
 #ifndef OSCL_FILE_IO_H_INCLUDED
 #include "oscl_file_io.h"
 #endif
+#ifndef OSCL_REFCOUNTER_H_INCLUDED
+#include "oscl_refcounter.h"
+#endif
+#ifndef OSCL_MUTEX_H_INCLUDED
+#include "oscl_mutex.h"
+#endif
 
 /**
 * PVFile is a class with an API similar to Oscl File I/O.
@@ -52,6 +58,13 @@ class PVMIDataStreamSyncInterface;
 class PvmiDataStreamObserver;
 
 #define PVFILE_DEFAULT_CACHE_SIZE 4*1024
+//Read-ahead is off unless a parser asks for it with iCacheReadAheadSize:
+//it costs a thread and a second cache buffer per open file, which only pays
+//off for the sequential reads of media playback.
+#define PVFILE_DEFAULT_CACHE_READ_AHEAD_SIZE 0
+//Read-ahead limit for parsers that read a clip sequentially during playback;
+//the cache grows up to this size to keep up with the media bitrate.
+#define PVFILE_PLAYBACK_CACHE_READ_AHEAD_SIZE 256*1024
 #define PVFILE_DEFAULT_ASYNC_READ_BUFFER_SIZE 0
 #define PVFILE_DEFAULT_NATIVE_ACCESS_MODE 0
 
@@ -61,6 +74,7 @@ class PVFileCacheParams
         PVFileCacheParams()
         {
             iCacheSize = PVFILE_DEFAULT_CACHE_SIZE;
+            iCacheReadAheadSize = PVFILE_DEFAULT_CACHE_READ_AHEAD_SIZE;
             iAsyncReadBuffSize = PVFILE_DEFAULT_ASYNC_READ_BUFFER_SIZE;
             iNativeAccessMode = PVFILE_DEFAULT_NATIVE_ACCESS_MODE;
             iPVLoggerEnableFlag = false;
@@ -85,6 +99,7 @@ class PVFileCacheParams
         }
 
         uint32 iCacheSize;
+        uint32 iCacheReadAheadSize;
         uint32 iAsyncReadBuffSize;
         bool iPVLoggerEnableFlag;
         bool iPVLoggerStateEnableFlag;
@@ -94,6 +109,7 @@ class PVFileCacheParams
         void MyCopy(const PVFileCacheParams& a)
         {
             iCacheSize = a.iCacheSize;
+            iCacheReadAheadSize = a.iCacheReadAheadSize;
             iAsyncReadBuffSize = a.iAsyncReadBuffSize;
             iPVLoggerEnableFlag = a.iPVLoggerEnableFlag;
             iPVLoggerStateEnableFlag = a.iPVLoggerStateEnableFlag;
@@ -101,6 +117,44 @@ class PVFileCacheParams
         }
 };
 
+/**
+* PVFileMapping is a read-only memory view of a whole local file.
+* It is reference counted so that parser output can point into the
+* mapping and be handed downstream without copying; the mapping is
+* released when the last reference is removed, which may be after
+* the PVFile itself has been closed.  Like OsclRefCounterMTSA, the
+* count is kept under a lock since those references may be dropped on
+* other threads.
+*/
+class PVFileMapping : public OsclRefCounter
+{
+    public:
+        const uint8* Base() const
+        {
+            return iBase;
+        }
+
+        uint32 Size() const
+        {
+            return iSize;
+        }
+
+        OSCL_IMPORT_REF void addRef();
+        OSCL_IMPORT_REF void removeRef();
+        OSCL_IMPORT_REF uint32 getCount();
+
+    private:
+        friend class PVFile;
+        PVFileMapping(uint8* aBase, uint32 aSize, TOsclFileOffset aMappedSize);
+        ~PVFileMapping();
+
+        uint8* iBase;
+        uint32 iSize;
+        TOsclFileOffset iMappedSize;
+        OsclThreadLock iLock;
+        uint32 iRefCnt;
+};
+
 class PVFile
 {
     public:
@@ -245,6 +299,13 @@ class PVFile
         // returns the byte range availabe in the stream cache
         OSCL_IMPORT_REF void GetCurrentByteRange(uint32& aCurrentFirstByteOffset, uint32& aCurrentLastByteOffset);
 
+        // For local files accessed through Oscl_File only.
+        // Maps the whole file read-only and returns the mapping with one
+        // reference owned by the caller, or NULL if the file is accessed
+        // through CPM/data stream, exceeds 32 bits, or cannot be mapped
+        // on this platform.
+        OSCL_IMPORT_REF PVFileMapping* CreateMapping();
+
     private:
         //Access parameters from local source data
         PVMFCPMPluginAccessInterfaceFactory* iCPMAccessFactory;
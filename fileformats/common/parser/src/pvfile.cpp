@@ -233,6 +233,7 @@ OSCL_EXPORT_REF int32 PVFile::Open(const oscl_wchar *filename,
 
 
             iFile->SetPVCacheSize(iOsclFileCacheParams.iCacheSize);
+            iFile->SetPVCacheReadAheadSize(iOsclFileCacheParams.iCacheReadAheadSize);
 
 
             iFile->SetSummaryStatsLoggingEnable(iOsclFileCacheParams.iPVLoggerStateEnableFlag);
@@ -414,3 +415,70 @@ PVFile::GetCurrentByteRange(uint32& aCurrentFirstByteOffset, uint32& aCurrentLas
     }
 }
 
+
+OSCL_EXPORT_REF PVFileMapping*
+PVFile::CreateMapping()
+{
+    Oscl_File* file = (iFile) ? iFile : iFilePtr;
+    if (file == NULL || iDataStreamAccess)
+    {
+        return NULL;
+    }
+
+    TOsclFileOffset mappedSize = 0;
+    OsclAny* base = file->MapReadOnly(mappedSize);
+    if (base == NULL)
+    {
+        return NULL;
+    }
+    if ((uint64)mappedSize > (uint64)0xFFFFFFFF)
+    {
+        //sample offsets handed out by the parsers are 32-bit
+        Oscl_File::Unmap(base, mappedSize);
+        return NULL;
+    }
+
+    PVFileMapping* mapping = NULL;
+    int32 errcode = 0;
+    OSCL_TRY(errcode, mapping = OSCL_NEW(PVFileMapping, ((uint8*)base, (uint32)mappedSize, mappedSize)));
+    OSCL_FIRST_CATCH_ANY(errcode,
+                         Oscl_File::Unmap(base, mappedSize);
+                         return NULL;);
+    return mapping;
+}
+
+PVFileMapping::PVFileMapping(uint8* aBase, uint32 aSize, TOsclFileOffset aMappedSize)
+        : iBase(aBase)
+        , iSize(aSize)
+        , iMappedSize(aMappedSize)
+        , iRefCnt(1)
+{
+}
+
+PVFileMapping::~PVFileMapping()
+{
+    Oscl_File::Unmap(iBase, iMappedSize);
+}
+
+OSCL_EXPORT_REF void PVFileMapping::addRef()
+{
+    iLock.Lock();
+    ++iRefCnt;
+    iLock.Unlock();
+}
+
+OSCL_EXPORT_REF void PVFileMapping::removeRef()
+{
+    iLock.Lock();
+    uint32 refCnt = --iRefCnt;
+    iLock.Unlock();
+    if (refCnt == 0)
+    {
+        OSCL_DELETE(this);
+    }
+}
+
+OSCL_EXPORT_REF uint32 PVFileMapping::getCount()
+{
+    return iRefCnt;
+}
@@ -0,0 +1,31 @@
+LOCAL_PATH := $(call my-dir)
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES := \
+ 	src/test_pvfile_read_ahead.cpp
+
+
+LOCAL_MODULE := test_pvfile_read_ahead
+
+LOCAL_CFLAGS :=  $(PV_CFLAGS)
+
+
+
+LOCAL_STATIC_LIBRARIES := 
+
+LOCAL_SHARED_LIBRARIES := libopencore_common
+
+LOCAL_C_INCLUDES := \
+	$(PV_TOP)/fileformats/common/parser/test/src \
+ 	$(PV_TOP)/fileformats/common/parser/test/src \
+ 	$(PV_TOP)/fileformats/common/parser/include \
+ 	$(PV_INCLUDES)
+
+LOCAL_COPY_HEADERS_TO := $(PV_COPY_HEADERS_TO)
+
+LOCAL_COPY_HEADERS := \
+ 	
+
+-include $(PV_TOP)/Android_system_extras.mk
+
+include $(BUILD_EXECUTABLE)
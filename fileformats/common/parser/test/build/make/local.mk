@@ -0,0 +1,23 @@
+# Get the current local path as the first operation
+LOCAL_PATH := $(call get_makefile_dir)
+
+# Clear out the variables used in the local makefiles
+include $(MK)/clear.mk
+
+TARGET := test_pvfile_read_ahead
+
+
+XCXXFLAGS += $(FLAG_COMPILE_WARNINGS_AS_ERRORS)
+
+XINCDIRS += ../../../include
+
+SRCDIR := ../../src
+INCSRCDIR := ../../src
+
+SRCS := test_pvfile_read_ahead.cpp
+
+LIBS := opencore_common
+
+SYSLIBS += $(SYS_THREAD_LIB)
+
+include $(MK)/prog.mk
@@ -0,0 +1,163 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+// Checks PVFile cache read-ahead: it is off unless the caller asks for it,
+// and with it on, sequential reads and reads after seeks return the same
+// bytes as the file holds.
+
+#include "stdio.h"
+#include "oscl_base.h"
+#include "oscl_mem.h"
+#include "oscl_error.h"
+#include "oscl_file_io.h"
+#include "pvfile.h"
+
+#define TEST_FILE           _STRLIT_WCHAR("test_pvfile_read_ahead.bin")
+#define TEST_FILE_SIZE      (1024 * 1024)
+#define TEST_READ_SIZE      1000
+
+static uint8 TestByte(uint32 aOffset)
+{
+    return (uint8)((aOffset * 31) ^ (aOffset >> 8));
+}
+
+static bool WriteTestFile(Oscl_FileServer& aFs)
+{
+    Oscl_File file;
+    if (file.Open(TEST_FILE, Oscl_File::MODE_READWRITE | Oscl_File::MODE_BINARY, aFs) != 0)
+    {
+        printf("  can't create %s\n", "test_pvfile_read_ahead.bin");
+        return false;
+    }
+    uint8 block[4096];
+    bool ok = true;
+    for (uint32 offset = 0; offset < TEST_FILE_SIZE && ok; offset += sizeof(block))
+    {
+        for (uint32 i = 0; i < sizeof(block); i++)
+        {
+            block[i] = TestByte(offset + i);
+        }
+        ok = (file.Write(block, 1, sizeof(block)) == sizeof(block));
+    }
+    file.Close();
+    return ok;
+}
+
+static bool CheckRead(PVFile& aFile, uint32 aOffset, uint32 aSize)
+{
+    uint8 buf[TEST_READ_SIZE];
+    uint32 numRead = aFile.Read(buf, 1, aSize);
+    uint32 expected = (aOffset + aSize <= TEST_FILE_SIZE) ? aSize : TEST_FILE_SIZE - aOffset;
+    if (numRead != expected)
+    {
+        printf("  read at %d returned %d of %d bytes\n", aOffset, numRead, expected);
+        return false;
+    }
+    for (uint32 i = 0; i < numRead; i++)
+    {
+        if (buf[i] != TestByte(aOffset + i))
+        {
+            printf("  byte %d differs\n", aOffset + i);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Reads the whole file front to back, then again with seeks back and
+// forth across the read-ahead window.
+static bool ReadTestFile(Oscl_FileServer& aFs, uint32 aReadAheadSize)
+{
+    PVFile file;
+    PVFileCacheParams cacheParams;
+    cacheParams.iCacheReadAheadSize = aReadAheadSize;
+    file.SetFileCacheParams(cacheParams);
+    if (file.Open(TEST_FILE, Oscl_File::MODE_READ | Oscl_File::MODE_BINARY, aFs) != 0)
+    {
+        printf("  can't open %s\n", "test_pvfile_read_ahead.bin");
+        return false;
+    }
+
+    bool ok = true;
+    for (uint32 offset = 0; offset < TEST_FILE_SIZE && ok; offset += TEST_READ_SIZE)
+    {
+        ok = CheckRead(file, offset, TEST_READ_SIZE);
+    }
+
+    uint32 offsets[] = {4096, 700000, 65536, 65536 + 4000, 1000000, 12345, 300000, TEST_FILE_SIZE - 10};
+    for (uint32 i = 0; i < sizeof(offsets) / sizeof(offsets[0]) && ok; i++)
+    {
+        if (file.Seek(offsets[i], Oscl_File::SEEKSET) != 0)
+        {
+            printf("  seek to %d failed\n", offsets[i]);
+            ok = false;
+            break;
+        }
+        // a few sequential reads after each seek, so read-ahead kicks in again
+        for (uint32 j = 0; j < 8 && ok; j++)
+        {
+            uint32 offset = offsets[i] + j * TEST_READ_SIZE;
+            if (offset >= TEST_FILE_SIZE)
+                break;
+            ok = CheckRead(file, offset, TEST_READ_SIZE);
+        }
+    }
+    file.Close();
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    OSCL_UNUSED_ARG(argc);
+    OSCL_UNUSED_ARG(argv);
+
+    OsclBase::Init();
+    OsclErrorTrap::Init();
+    OsclMem::Init();
+
+    uint32 failures = 0;
+
+    PVFileCacheParams defaults;
+    bool ok = (defaults.iCacheReadAheadSize == 0);
+    printf("read-ahead is off by default: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    Oscl_FileServer fs;
+    fs.Connect();
+    ok = WriteTestFile(fs);
+    printf("test file written: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    if (ok)
+    {
+        ok = ReadTestFile(fs, PVFILE_DEFAULT_CACHE_READ_AHEAD_SIZE);
+        printf("reads without read-ahead: %s\n", ok ? "pass" : "FAIL");
+        failures += ok ? 0 : 1;
+
+        ok = ReadTestFile(fs, PVFILE_PLAYBACK_CACHE_READ_AHEAD_SIZE);
+        printf("reads with playback read-ahead: %s\n", ok ? "pass" : "FAIL");
+        failures += ok ? 0 : 1;
+
+        fs.Oscl_DeleteFile(TEST_FILE);
+    }
+    fs.Close();
+
+    OsclMem::Cleanup();
+    OsclErrorTrap::Cleanup();
+    OsclBase::Cleanup();
+    return (failures == 0) ? 0 : 1;
+}
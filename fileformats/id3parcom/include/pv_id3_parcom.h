@@ -143,6 +143,19 @@ class PVID3ParCom
          */
         OSCL_IMPORT_REF PVMFStatus ParseID3Tag(PVFile* aFile, uint32 buffsize = 100);
 
+        /**
+         * Enables or disables lazy parsing of ID3v2 tags. In lazy mode ParseID3Tag() only
+         * records the location of each ID3v2 frame; a frame value is read from the file the
+         * first time it is requested through GetID3Frame() or GetID3Frames(), so the file
+         * passed to ParseID3Tag() must remain open until then. Album art is returned by
+         * reference: the picture data is not read, iGraphicData is NULL and the file offset
+         * of the data is carried in the "offset=" parameter of the key. The setting is kept
+         * across Reset() and must be made before ParseID3Tag() is called.
+         *
+         * @param aLazy true to enable lazy parsing. Disabled by default.
+         */
+        OSCL_IMPORT_REF void SetLazyParsing(bool aLazy);
+
         /**
          * Parse an ID3 tag from the specified memory fragment.
          *
@@ -251,7 +264,8 @@ class PVID3ParCom
         OSCL_IMPORT_REF PVMFStatus ComposeID3Tag(OsclRefCounterMemFrag& aTag);
 
         /**
-         * Reset the parser-composer and remove all ID3 frames.
+         * Reset the parser-composer and remove all ID3 frames.  After a reset
+         * the object can be used to parse the tag of another file.
          *
          * @return Completion status.
          */
@@ -367,6 +381,44 @@ class PVID3ParCom
 
         };
 
+        /**
+         * @brief Location of an ID3v2 frame recorded in lazy parsing mode.
+         */
+        struct TID3FrameIndexEntry
+        {
+            PVID3FrameType iFrameType;
+            PVID3Version iVersion;
+            // file offset of the text encoding byte, or of the frame header for
+            // unrecognized frames
+            uint32    iDataPos;
+            uint32    iFrameLength;
+            uint8     iFrameID[5];
+            bool      iMaterialized;
+        };
+
+        /**
+         * @brief Reads the value of an ID3v2 frame and adds it to the frame vector.
+         * @param aFrameType frame type
+         * @param aDataPos file offset of the text encoding byte of the frame
+         * @param aFrameLength size of the frame data
+         * @return false if the frame could not be read
+         */
+        bool ReadFrameValue(PVID3FrameType aFrameType, uint32 aDataPos, uint32 aFrameLength);
+
+        /**
+         * @brief Reads a frame recorded in lazy parsing mode into the frame vector,
+         * restoring the file position afterwards.
+         * @param aEntry index entry of the frame
+         * @return Completion status
+         */
+        PVMFStatus ReadIndexedFrame(TID3FrameIndexEntry& aEntry);
+
+        /**
+         * @brief Records the location of the current ID3v2 frame in lazy parsing mode.
+         * @return Completion status
+         */
+        PVMFStatus AddFrameIndexEntry(PVID3FrameType aFrameType, uint32 aDataPos, uint32 aFrameLength);
+
         /**
          * @brief Checks the ID3 Tag v2.4 frame size whether it is syncsafe or not.
          *
@@ -907,6 +959,11 @@ class PVID3ParCom
         bool iTagAtBof;
         bool iSeekFrameFound;
 
+        // Variables for lazy parsing
+        bool iLazyParsing;
+        PVFile* iLazyFile;
+        Oscl_Vector<TID3FrameIndexEntry, OsclMemAllocator> iFrameIndex;
+
         OsclMemAllocator iAlloc;
         PVLogger* iLogger;
 };
@@ -331,6 +331,8 @@
 #define KVP_PARAM_LANGUAGE_CODE "iso-639-2-lang="
 #define KVP_PARAM_LANGUAGE_CODE_LEN 15
 #define KVP_VALTYPE_DURATION "timescale=1000;valtype=uint32"
+#define KVP_PARAM_ALBUMART_OFFSET "offset="
+#define KVP_PARAM_ALBUMART_OFFSET_LEN 7
 #define KVP_PARAM_CHAR_ENCODING_UTF16BE "char-encoding=UTF16BE"
 #define KVP_PARAM_CHAR_ENCODING_UTF8 "char-encoding=UTF8"
 #define KVP_FORMAT_ALBUMART  "format=APIC"
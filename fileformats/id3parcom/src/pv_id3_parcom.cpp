@@ -93,7 +93,9 @@ OSCL_EXPORT_REF PVID3ParCom::PVID3ParCom()
         iMaxTagSize(0),
         iUsePadding(false),
         iTagAtBof(false),
-        iSeekFrameFound(false)
+        iSeekFrameFound(false),
+        iLazyParsing(false),
+        iLazyFile(NULL)
 {
     iLogger = PVLogger::GetLoggerObject("PVID3ParCom");
     iID3TagInfo.iID3V2ExtendedHeaderSize = 0;
@@ -110,6 +112,7 @@ OSCL_EXPORT_REF PVID3ParCom::PVID3ParCom()
 OSCL_EXPORT_REF PVID3ParCom::~PVID3ParCom()
 {
     iFrames.clear();
+    iFrameIndex.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -264,6 +267,7 @@ OSCL_EXPORT_REF PVMFStatus PVID3ParCom::ParseID3Tag(PVFile* aFile, uint32 buffsi
     }
 
     iInputFile = aFile;
+    iLazyFile = iLazyParsing ? aFile : NULL;
 
     int32 currentFilePosn = 0;
 
@@ -330,6 +334,12 @@ OSCL_EXPORT_REF PVMFStatus PVID3ParCom::ParseID3Tag(PVFile* aFile, uint32 buffsi
     return PVMFSuccess;
 }
 
+////////////////////////////////////////////////////////////////////////////
+OSCL_EXPORT_REF void PVID3ParCom::SetLazyParsing(bool aLazy)
+{
+    iLazyParsing = aLazy;
+}
+
 ////////////////////////////////////////////////////////////////////////////
 OSCL_EXPORT_REF PVID3Version PVID3ParCom::GetID3Version() const
 {
@@ -351,6 +361,13 @@ OSCL_EXPORT_REF bool PVID3ParCom::IsID3V2Present() const
 ////////////////////////////////////////////////////////////////////////////
 OSCL_EXPORT_REF PVMFStatus PVID3ParCom::GetID3Frames(PvmiKvpSharedPtrVector& aFrames)
 {
+    for (uint32 i = 0; i < iFrameIndex.size(); i++)
+    {
+        if (!iFrameIndex[i].iMaterialized)
+        {
+            ReadIndexedFrame(iFrameIndex[i]);
+        }
+    }
     aFrames = iFrames;
     return PVMFSuccess;
 }
@@ -359,6 +376,21 @@ OSCL_EXPORT_REF PVMFStatus PVID3ParCom::GetID3Frames(PvmiKvpSharedPtrVector& aFr
 OSCL_EXPORT_REF PVMFStatus PVID3ParCom::GetID3Frame(const OSCL_String& aFrameType, PvmiKvpSharedPtrVector& aFrameVector)
 {
     uint32 i;
+    OSCL_StackString<128> keyStr;
+    for (i = 0; i < iFrameIndex.size(); i++)
+    {
+        // only the frames of the requested type are read in lazy mode
+        if (!iFrameIndex[i].iMaterialized)
+        {
+            oscl_memcpy(iID3TagInfo.iID3V2FrameID, iFrameIndex[i].iFrameID, sizeof(iFrameIndex[i].iFrameID));
+            if ((ConstructKvpKey(keyStr, iFrameIndex[i].iFrameType, PV_ID3_CHARSET_ISO88591) == PVMFSuccess) &&
+                    (pv_mime_strcmp(keyStr.get_cstr(), aFrameType.get_str()) == 0))
+            {
+                ReadIndexedFrame(iFrameIndex[i]);
+            }
+        }
+    }
+
     for (i = 0; i < iFrames.size(); i++)
     {
         if (pv_mime_strcmp(iFrames[i]->key, aFrameType.get_str()) == 0)
@@ -382,6 +414,20 @@ OSCL_EXPORT_REF bool PVID3ParCom::IsID3FrameAvailable(const OSCL_String& aFrameT
         }
     }
 
+    OSCL_StackString<128> keyStr;
+    for (i = 0; i < iFrameIndex.size(); i++)
+    {
+        if (!iFrameIndex[i].iMaterialized)
+        {
+            oscl_memcpy(iID3TagInfo.iID3V2FrameID, iFrameIndex[i].iFrameID, sizeof(iFrameIndex[i].iFrameID));
+            if ((ConstructKvpKey(keyStr, iFrameIndex[i].iFrameType, PV_ID3_CHARSET_ISO88591) == PVMFSuccess) &&
+                    (pv_mime_strcmp(keyStr.get_cstr(), aFrameType.get_str()) == 0))
+            {
+                return true;
+            }
+        }
+    }
+
     return false;
 }
 
@@ -520,6 +566,31 @@ OSCL_EXPORT_REF PVMFStatus PVID3ParCom::ComposeID3Tag(OsclRefCounterMemFrag& aTa
 OSCL_EXPORT_REF PVMFStatus PVID3ParCom::Reset()
 {
     iFrames.clear();
+
+    // Clear the parsing state so the same object can parse another file.
+    // The composing options are left as they were set.
+    iInputFile = NULL;
+    iLazyFile = NULL;
+    iFrameIndex.clear();
+    iTitleFoundFlag = false;
+    iArtistFoundFlag = false;
+    iAlbumFoundFlag = false;
+    iYearFoundFlag = false;
+    iCommentFoundFlag = false;
+    iTrackNumberFoundFlag = false;
+    iGenereFoundFlag = false;
+    iFileSizeInBytes = 0;
+    iByteOffsetToStartOfAudioFrames = 0;
+    iID3V1Present = false;
+    iID3V2Present = false;
+    iVersion = PV_ID3_INVALID_VERSION;
+    iSeekFrameFound = false;
+    iID3TagInfo.iID3V2ExtendedHeaderSize = 0;
+    iID3TagInfo.iID3V2FrameSize = 0;
+    iID3TagInfo.iID3V2TagFlagsV2 = 0;
+    iID3TagInfo.iID3V2TagSize = 0 ;
+    iID3TagInfo.iFooterPresent = false;
+    oscl_memset(&iID3TagInfo.iID3V2FrameFlag, 0, sizeof(iID3TagInfo.iID3V2FrameFlag));
     return PVMFSuccess;
 }
 
@@ -1148,6 +1219,10 @@ bool PVID3ParCom::ReadExtendedHeader()
             while (iFrames.size() > 0)
                 iFrames.pop_back();
         }
+        if (!(exthdrflg & EXTHDR_UPDMASK))
+        {
+            iFrameIndex.clear();
+        }
 
         //subtract 2 bytes for flg size and flg from ext hdr size.
         iID3TagInfo.iID3V2ExtendedHeaderSize = iID3TagInfo.iID3V2ExtendedHeaderSize - 2;
@@ -1244,48 +1319,17 @@ int PVID3ParCom::ReadTagID3V2(PVID3Version aVersion)
                                        && frameType != PV_ID3_FRAME_EEND
                                        && frameType != PV_ID3_FRAME_CANDIDATE)))
         {
-            uint8 unicodeCheck;
-
-            if (read8(iInputFile, unicodeCheck) == false)
-            {
-                return count;
-            }
-
-            if ((frameType == PV_ID3_FRAME_LYRICS) || (frameType == PV_ID3_FRAME_COMMENT))
-            {
-                ReadLyricsCommFrame(unicodeCheck, currFrameLength - 1, frameType);
-
-            }
-            else if ((frameType == PV_ID3_FRAME_APIC) || (frameType == PV_ID3_FRAME_PIC))
-            {
-                if (currFrameLength > 3000000)
-                {
-                    // TODO: scale down album art to something manageable right here
-                    LOG_DEBUG((0, "PVID3ParCom::ReadTagID3V2: skipping > 3MB album art"));
-                }
-                else
-                {
-                    if (ReadAlbumArtFrame(frameType, unicodeCheck, currFrameLength)  != PVMFSuccess)
-                    {
-                        LOG_ERR((0, "PVID3ParCom::ReadTagID3V2: Error - ReadAPICFrame failed"));
-                        return count;
-                    }
-                }
-            }
-            else if (unicodeCheck < PV_ID3_CHARSET_END)
+            uint32 dataPos = current_file_pos + i + frame_header_size + data_len_indicator_size;
+            if (iLazyParsing)
             {
-
-                if (!ReadFrameData(unicodeCheck, frameType,
-                                   current_file_pos + i + frame_header_size + data_len_indicator_size + 1,
-                                   currFrameLength))
+                if (AddFrameIndexEntry(frameType, dataPos, currFrameLength) != PVMFSuccess)
                 {
                     return count;
                 }
             }
-            else
+            else if (!ReadFrameValue(frameType, dataPos, currFrameLength))
             {
-                // This case is when no text type is defined in the frame.
-                HandleID3V2FrameDataASCII(frameType, i + frame_header_size + data_len_indicator_size, currFrameLength);
+                return count;
             }
             count++;
         }
@@ -1301,9 +1345,17 @@ int PVID3ParCom::ReadTagID3V2(PVID3Version aVersion)
             {
                 if (i < iID3TagInfo.iID3V2TagSize)
                 {
-                    HandleID3V2FrameUnsupported(frameType,
-                                                current_file_pos + i,
-                                                currFrameLength + frame_header_size + data_len_indicator_size);
+                    if (iLazyParsing)
+                    {
+                        AddFrameIndexEntry(frameType, current_file_pos + i,
+                                           currFrameLength + frame_header_size + data_len_indicator_size);
+                    }
+                    else
+                    {
+                        HandleID3V2FrameUnsupported(frameType,
+                                                    current_file_pos + i,
+                                                    currFrameLength + frame_header_size + data_len_indicator_size);
+                    }
                 }
             }
         }
@@ -1313,6 +1365,112 @@ int PVID3ParCom::ReadTagID3V2(PVID3Version aVersion)
     return count;
 }
 
+/////////////////////////////////////////////////////////////////////////////////
+bool PVID3ParCom::ReadFrameValue(PVID3FrameType aFrameType, uint32 aDataPos, uint32 aFrameLength)
+{
+    if ((aFrameType == PV_ID3_FRAME_UNRECOGNIZED) || (aFrameType == PV_ID3_FRAME_CANDIDATE))
+    {
+        HandleID3V2FrameUnsupported(aFrameType, aDataPos, aFrameLength);
+        return true;
+    }
+
+    if (iInputFile->Seek(aDataPos, Oscl_File::SEEKSET) == -1)
+    {
+        return false;
+    }
+
+    uint8 unicodeCheck;
+    if (read8(iInputFile, unicodeCheck) == false)
+    {
+        return false;
+    }
+
+    if ((aFrameType == PV_ID3_FRAME_LYRICS) || (aFrameType == PV_ID3_FRAME_COMMENT))
+    {
+        ReadLyricsCommFrame(unicodeCheck, aFrameLength - 1, aFrameType);
+    }
+    else if ((aFrameType == PV_ID3_FRAME_APIC) || (aFrameType == PV_ID3_FRAME_PIC))
+    {
+        if (aFrameLength > 3000000)
+        {
+            // TODO: scale down album art to something manageable right here
+            LOG_DEBUG((0, "PVID3ParCom::ReadFrameValue: skipping > 3MB album art"));
+        }
+        else
+        {
+            if (ReadAlbumArtFrame(aFrameType, unicodeCheck, aFrameLength)  != PVMFSuccess)
+            {
+                LOG_ERR((0, "PVID3ParCom::ReadFrameValue: Error - ReadAPICFrame failed"));
+                return false;
+            }
+        }
+    }
+    else if (unicodeCheck < PV_ID3_CHARSET_END)
+    {
+        if (!ReadFrameData(unicodeCheck, aFrameType, aDataPos + 1, aFrameLength))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        // This case is when no text type is defined in the frame.
+        HandleID3V2FrameDataASCII(aFrameType, aDataPos, aFrameLength);
+    }
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+PVMFStatus PVID3ParCom::AddFrameIndexEntry(PVID3FrameType aFrameType, uint32 aDataPos, uint32 aFrameLength)
+{
+    TID3FrameIndexEntry entry;
+    entry.iFrameType = aFrameType;
+    entry.iVersion = iVersion;
+    entry.iDataPos = aDataPos;
+    entry.iFrameLength = aFrameLength;
+    oscl_memcpy(entry.iFrameID, iID3TagInfo.iID3V2FrameID, sizeof(entry.iFrameID));
+    entry.iMaterialized = false;
+
+    int32 err = OsclErrNone;
+    OSCL_TRY(err, iFrameIndex.push_back(entry););
+    OSCL_FIRST_CATCH_ANY(err,
+                         LOG_ERR((0, "PVID3ParCom::AddFrameIndexEntry: Error - iFrameIndex.push_back failed"));
+                         return PVMFErrNoMemory;);
+    return PVMFSuccess;
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+PVMFStatus PVID3ParCom::ReadIndexedFrame(TID3FrameIndexEntry& aEntry)
+{
+    aEntry.iMaterialized = true;
+    if (iLazyFile == NULL)
+    {
+        return PVMFFailure;
+    }
+
+    // the tag may have been parsed under a different version than the one
+    // reported now (e.g. id3v1 found after id3v2), keys depend on it
+    PVID3Version version = iVersion;
+    iVersion = aEntry.iVersion;
+    oscl_memcpy(iID3TagInfo.iID3V2FrameID, aEntry.iFrameID, sizeof(aEntry.iFrameID));
+
+    iInputFile = iLazyFile;
+    int32 currentFilePosn = iInputFile->Tell();
+    bool result = false;
+    int32 err = OsclErrNone;
+    OSCL_TRY(err, result = ReadFrameValue(aEntry.iFrameType, aEntry.iDataPos, aEntry.iFrameLength););
+    iInputFile->Seek(currentFilePosn, Oscl_File::SEEKSET);
+    iInputFile = NULL;
+    iVersion = version;
+
+    if ((err != OsclErrNone) || !result)
+    {
+        LOG_ERR((0, "PVID3ParCom::ReadIndexedFrame: Error - failed to read frame %s", aEntry.iFrameID));
+        return PVMFFailure;
+    }
+    return PVMFSuccess;
+}
+
 bool PVID3ParCom::ValidateFrameV2_4(PVID3FrameType& frameType, bool bUseSyncSafeFrameSize)
 {
     // Initialize OUT param
@@ -2828,6 +2986,9 @@ PVMFStatus PVID3ParCom::ReadAlbumArtFrame(PVID3FrameType aFrameType, uint8 unico
     int32 err = OsclErrNone;
     PvmiKvpSharedPtr kvpPtr;
     OSCL_StackString<128> keyStr;
+    // in lazy mode the picture data is left in the file and referenced by offset
+    bool byReference = iLazyParsing;
+    char str_data_offset[MAX_RANGE_INT_SIZE + 1] = {0};
 
     if (ConstructKvpKey(keyStr, PV_ID3_FRAME_APIC, PV_ID3_CHARSET_INVALID) != PVMFSuccess)
     {
@@ -2854,9 +3015,16 @@ PVMFStatus PVID3ParCom::ReadAlbumArtFrame(PVID3FrameType aFrameType, uint8 unico
             keyStr += KVP_FORMAT_ALBUMART;
             keyStr += SEMI_COLON;
             keyStr += KVP_VALTYPE_ALBUMART;
+            if (byReference)
+            {
+                oscl_snprintf(str_data_offset, MAX_RANGE_INT_SIZE + 1, "%d", iInputFile->Tell());
+                keyStr += SEMI_COLON;
+                keyStr += KVP_PARAM_ALBUMART_OFFSET;
+                keyStr += _STRLIT_CHAR(str_data_offset);
+            }
 
             //description and image format are stored as wchar.
-            uint32 rfs = aFrameSize - (ImageFormat.get_size() + description.get_size());
+            uint32 rfs = byReference ? 0 : aFrameSize - (ImageFormat.get_size() + description.get_size());
             uint32 wchar_size = sizeof(oscl_wchar); //for platforms that store wchar as 4 bytes.
             uint32 total_size = sizeof(PvmfApicStruct) + rfs + ((wchar_size) * (ImageFormat.get_size() + description.get_size())) + 2 * sizeof(oscl_wchar) ;
 
@@ -2910,9 +3078,16 @@ PVMFStatus PVID3ParCom::ReadAlbumArtFrame(PVID3FrameType aFrameType, uint8 unico
             keyStr += KVP_FORMAT_ALBUMART;
             keyStr += SEMI_COLON;
             keyStr += KVP_VALTYPE_ALBUMART;
+            if (byReference)
+            {
+                oscl_snprintf(str_data_offset, MAX_RANGE_INT_SIZE + 1, "%d", iInputFile->Tell());
+                keyStr += SEMI_COLON;
+                keyStr += KVP_PARAM_ALBUMART_OFFSET;
+                keyStr += _STRLIT_CHAR(str_data_offset);
+            }
 
             //image format is stored as wchar.
-            uint32 rfs = aFrameSize - (ImageFormat.get_size() + (2 * oscl_strlen(description.get_str())));
+            uint32 rfs = byReference ? 0 : aFrameSize - (ImageFormat.get_size() + (2 * oscl_strlen(description.get_str())));
             uint32 wchar_size = sizeof(oscl_wchar); //for platforms that store wchar as 4 bytes.
             uint32 total_size = sizeof(PvmfApicStruct) + rfs + (wchar_size * (ImageFormat.get_size() + description.get_size())) + (2 * wchar_size);
 
@@ -2990,7 +3165,12 @@ PVMFStatus PVID3ParCom::ReadAlbumArtFrame(PVID3FrameType aFrameType, uint8 unico
     else
     {
         aApicStruct = OSCL_STATIC_CAST(PvmfApicStruct *, kvpPtr->value.key_specific_value);
-        if (readByteData(iInputFile, dataLen, aApicStruct->iGraphicData) == false)
+        if (byReference)
+        {
+            // iGraphicDataLen still holds the size of the picture data
+            aApicStruct->iGraphicData = NULL;
+        }
+        else if (readByteData(iInputFile, dataLen, aApicStruct->iGraphicData) == false)
             return PVMFFailure;
     }
 
@@ -431,6 +431,34 @@ class IMpeg3File
 
         OSCL_EXPORT_REF MP3ErrorType ScanMP3File(uint32 aFramesToScan);
 
+        /**
+        * @brief Retrieves the size of the frame index built by the duration scan
+        *
+        * @returns size in bytes, 0 if the scan has not completed yet
+        */
+        OSCL_IMPORT_REF uint32 GetFrameIndexSize();
+
+        /**
+        * @brief Serializes the frame index, so that the caller can store it
+        * and restore it when the same clip is opened again
+        *
+        * @param aBuffer buffer of at least GetFrameIndexSize() bytes
+        * @param aBufferSize size of aBuffer
+        * @returns true if the index was written
+        */
+        OSCL_IMPORT_REF bool SerializeFrameIndex(uint8* aBuffer, uint32 aBufferSize);
+
+        /**
+        * @brief Restores a previously serialized frame index. Must be called
+        * after ParseMp3File. A restored index makes the duration scan
+        * unnecessary and seeks frame accurate.
+        *
+        * @param aBuffer serialized index
+        * @param aBufferSize size of aBuffer
+        * @returns MP3_SUCCESS if the index matches the clip
+        */
+        OSCL_IMPORT_REF MP3ErrorType DeserializeFrameIndex(const uint8* aBuffer, uint32 aBufferSize);
+
     private:
         OsclAny* AllocateKVPKeyArray(int32& leavecode, PvmiKvpValueType aValueType, int32 aNumElements);
         int32 PushKVPValue(PvmiKvp aKVP, Oscl_Vector<PvmiKvp, OsclMemAllocator>& aValueList);
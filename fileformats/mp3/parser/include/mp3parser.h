@@ -101,6 +101,15 @@
 
 #define MAX_TOC_ENTRY_COUNT 200
 
+// duration scan reads the file in blocks of this size
+#define MP3_SCAN_BUFFER_SIZE 32768
+// the frame index records the offset of every Nth frame
+#define MP3_FRAME_INDEX_STRIDE 4
+// serialized frame index layout: header words followed by one word per entry
+#define MP3_FRAME_INDEX_MAGIC 0x4933504D /* "MP3I" */
+#define MP3_FRAME_INDEX_VERSION 1
+#define MP3_FRAME_INDEX_HEADER_WORDS 9
+
 typedef struct mp3Header_tag
 {
     int32 SamplingRate;
@@ -404,8 +413,42 @@ class MP3Parser
         }
 
         MP3ErrorType ScanMP3File(PVFile * fpUsed, uint32 aFramesToScan);
+
+        /**
+        * @brief Returns the number of bytes needed to serialize the frame index.
+        * The index is only available once the duration scan has completed.
+        *
+        * @returns size in bytes, 0 if no complete index is available
+        */
+        uint32 GetFrameIndexSize();
+
+        /**
+        * @brief Writes the frame index built by the duration scan into the
+        * supplied buffer, so that it can be stored alongside the clip.
+        *
+        * @param aBuffer buffer of at least GetFrameIndexSize() bytes
+        * @param aBufferSize size of aBuffer
+        * @returns true if the index was written
+        */
+        bool SerializeFrameIndex(uint8* aBuffer, uint32 aBufferSize);
+
+        /**
+        * @brief Restores a frame index written by SerializeFrameIndex.
+        * The index is rejected if it does not match the opened clip. Once
+        * restored, no duration scan is needed and seeks are frame accurate.
+        *
+        * @param aBuffer serialized index
+        * @param aBufferSize size of aBuffer
+        * @returns MP3_SUCCESS if the index was accepted
+        */
+        MP3ErrorType DeserializeFrameIndex(const uint8* aBuffer, uint32 aBufferSize);
+
     private:
         MP3ErrorType ScanMP3File(PVFile* fpUsed);
+        MP3ErrorType EndScan(uint32 aFilePos, uint32 aTimestamp, MP3ErrorType aStatus);
+        uint8* ScanBufferPeek(PVFile* aFile, uint32 aOffset, uint32 aLength);
+        bool FindSyncInScanBuffer(uint32 aOffset, uint32 &aSyncOffset);
+        bool SeekPointFromFrameIndex(uint32 &aTimestamp, uint32 &aSeekPoint);
         MP3ErrorType GetDurationFromVBRIHeader(uint32 &aDuration);
         MP3ErrorType GetDurationFromRandomScan(uint32 &aDuration);
         MP3ErrorType ComputeDurationFromNRandomFrames(PVFile * fpUsed, int32 aNumFrames = MIN_RANDOM_FRAMES_TO_SCAN, int32 aNumRandomLoc = MIN_RANDOM_LOCATION_TO_SCAN);
@@ -464,6 +507,13 @@ class MP3Parser
         uint32 iTimestampPrev;
         uint32 iScanTimestamp;
         uint32 iBinWidth;
+        /* block read buffer used by the duration scan */
+        uint8* pScanBuffer;
+        uint32 iScanBufferOffset;
+        uint32 iScanBufferLength;
+        /* offset (from StartOffset) of every MP3_FRAME_INDEX_STRIDE'th frame */
+        Oscl_Vector<uint32, OsclMemAllocator> iFrameIndex;
+        bool iFrameIndexEnabled;
 
         uint32 iSamplingRate;
         uint32 iSamplesPerFrame;
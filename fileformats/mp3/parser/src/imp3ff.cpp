@@ -111,9 +111,13 @@ OSCL_EXPORT_REF IMpeg3File::IMpeg3File(OSCL_wString& filename, MP3ErrorType &bSu
     iAvailableMetadataKeys.clear();
 
     iEnableCrcCalc = enableCRC;
-    // Open the specified MP3 file
+    // Open the specified MP3 file.  Frames are read sequentially during
+    // playback, so let the cache read ahead.
     iMP3File.SetCPM(aCPM);
     iMP3File.SetFileHandle(aFileHandle);
+    PVFileCacheParams cacheParams;
+    cacheParams.iCacheReadAheadSize = PVFILE_PLAYBACK_CACHE_READ_AHEAD_SIZE;
+    iMP3File.SetFileCacheParams(cacheParams);
     if (iMP3File.Open(filename.get_cstr(), (Oscl_File::MODE_READ | Oscl_File::MODE_BINARY), *fileServSession) != 0)
     {
         bSuccess = MP3_FILE_OPEN_ERR;
@@ -1510,6 +1514,27 @@ OSCL_EXPORT_REF MP3ErrorType IMpeg3File::ScanMP3File(uint32 aFramesToScan)
     return MP3_ERROR_UNKNOWN;
 }
 
+OSCL_EXPORT_REF uint32 IMpeg3File::GetFrameIndexSize()
+{
+    if (pMP3Parser)
+        return pMP3Parser->GetFrameIndexSize();
+    return 0;
+}
+
+OSCL_EXPORT_REF bool IMpeg3File::SerializeFrameIndex(uint8* aBuffer, uint32 aBufferSize)
+{
+    if (pMP3Parser)
+        return pMP3Parser->SerializeFrameIndex(aBuffer, aBufferSize);
+    return false;
+}
+
+OSCL_EXPORT_REF MP3ErrorType IMpeg3File::DeserializeFrameIndex(const uint8* aBuffer, uint32 aBufferSize)
+{
+    if (pMP3Parser)
+        return pMP3Parser->DeserializeFrameIndex(aBuffer, aBufferSize);
+    return MP3_ERROR_UNKNOWN;
+}
+
 OsclAny* IMpeg3File::AllocateKVPKeyArray(int32& aLeaveCode, PvmiKvpValueType aValueType, int32 aNumElements)
 {
     int32 leaveCode = OsclErrNone;
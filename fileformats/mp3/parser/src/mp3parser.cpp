@@ -348,6 +348,11 @@ MP3Parser::MP3Parser(PVFile* aFileHandle)
     iScanTimestamp = 0;
     iBinWidth = 0;
 
+    pScanBuffer = NULL;
+    iScanBufferOffset = 0;
+    iScanBufferLength = 0;
+    iFrameIndexEnabled = true;
+
     iVbriHeader.TOC = NULL;
     oscl_memset(&iMP3ConfigInfo, 0, sizeof(iMP3ConfigInfo));
     oscl_memset(&iMP3HeaderInfo, 0, sizeof(iMP3HeaderInfo));
@@ -394,6 +399,13 @@ MP3Parser::~MP3Parser()
         iTOC = NULL;
     }
 
+    if (pScanBuffer)
+    {
+        OSCL_ARRAY_DELETE(pScanBuffer);
+        pScanBuffer = NULL;
+    }
+    iFrameIndex.clear();
+
     oscl_memset(&iMP3ConfigInfo, 0, sizeof(iMP3ConfigInfo));
     oscl_memset(&iMP3HeaderInfo, 0, sizeof(iMP3HeaderInfo));
     oscl_memset(&iXingHeader, 0, sizeof(iXingHeader));
@@ -694,8 +706,9 @@ MP3ErrorType MP3Parser::ParseMP3File(PVFile * fpUsed, bool aEnableCRC)
 MP3ErrorType MP3Parser::ScanMP3File(PVFile * fpUsed, uint32 aFramesToScan)
 {
     uint32 firstHeader = 0;
-    uint8 pFrameHeader[MP3_FRAME_HEADER_SIZE];
-    int32 audioOffset = 0;
+    uint8* pFrameHeader = NULL;
+    uint32 audioOffset = 0;
+    uint32 scanPos = 0;
     uint32 seekOffset = 0;
     MP3ErrorType status = MP3_ERROR_UNKNOWN;
     MP3HeaderType mp3HeaderInfo;
@@ -711,6 +724,12 @@ MP3ErrorType MP3Parser::ScanMP3File(PVFile * fpUsed, uint32 aFramesToScan)
         return MP3_DURATION_PRESENT;
     }
 
+    if (iDurationScanComplete)
+    {
+        // scan has already been done, or the frame index was restored
+        return MP3_DURATION_PRESENT;
+    }
+
     if (iTOCFilledCount == MAX_TOC_ENTRY_COUNT)
     {
         status = FillTOCTable(0, 0);
@@ -726,23 +745,30 @@ MP3ErrorType MP3Parser::ScanMP3File(PVFile * fpUsed, uint32 aFramesToScan)
         return MP3_SUCCESS;
     }
 
-    if (iFirstScan)
+    if (pScanBuffer == NULL)
     {
-        if (iTagSize > 0)
+        int32 leavecode = OsclErrNone;
+        OSCL_TRY(leavecode, pScanBuffer = OSCL_ARRAY_NEW(uint8, MP3_SCAN_BUFFER_SIZE));
+        if (leavecode || pScanBuffer == NULL)
         {
-            audioOffset = StartOffset;
-            MP3ErrorType err = MP3Utils::SeektoOffset(fpUsed, audioOffset, Oscl_File::SEEKSET);
-            if (MP3_SUCCESS != err)
-            {
-                return err;
-            }
+            return MP3_ERR_NO_MEMORY;
         }
+        iScanBufferOffset = 0;
+        iScanBufferLength = 0;
+    }
+
+    // The scan walks the frame headers by absolute offset out of a block
+    // buffer, so the position of fpUsed is only relevant for mp3FindSync.
+    if (iFirstScan)
+    {
+        scanPos = StartOffset;
         iFirstScan = false;
     }
     else
     {
-        audioOffset = iLastScanPosition;
+        scanPos = iLastScanPosition;
     }
+    audioOffset = scanPos;
 
     // Set length of initial search to the min between default and filesize
     iInitSearchFileSize = OSCL_MIN(iInitSearchFileSize, iLocalFileSize);
@@ -753,112 +779,72 @@ MP3ErrorType MP3Parser::ScanMP3File(PVFile * fpUsed, uint32 aFramesToScan)
 
     while (numFrames < aFramesToScan)
     {
-        firstHeader = 0;
-        oscl_memset(&pFrameHeader, 0, sizeof(pFrameHeader));
-
-        if (fpUsed->Read(pFrameHeader, 1, MP3_FRAME_HEADER_SIZE) != MP3_FRAME_HEADER_SIZE)
+        pFrameHeader = ScanBufferPeek(fpUsed, scanPos, MP3_FRAME_HEADER_SIZE);
+        if (pFrameHeader == NULL)
         {
             if (fpUsed->GetFileBufferingCapacity() == 0)
             {
                 iDurationScanComplete = true;
             }
-            status = FillTOCTable(audioOffset, 0);
-            if (status == MP3_ERROR_UNKNOWN)
-            {
-                // This will happen when FillTocTable returns error because of
-                // NULL TOCTable.
-                // Not a valid condition this should never happen, except if
-                // there was memory allocation failure during ParseMP3File.
-                // If happens return Duration Present to avoid any further ScanMp3File calls.
-                return MP3_DURATION_PRESENT;
-            }
-            return MP3_INSUFFICIENT_DATA;
+            return EndScan(audioOffset, 0, MP3_INSUFFICIENT_DATA);
         }
         firstHeader = SwapFileToHostByteOrderInt32(pFrameHeader);
-        uint32 offset = MP3Utils::getCurrentFilePosition(fpUsed);
         if (!GetMP3Header(firstHeader, mp3HeaderInfo))
         {
-            MP3Utils::SeektoOffset(fp, 0 - MP3_FRAME_HEADER_SIZE, Oscl_File::SEEKCUR);
-            MP3ErrorType err = mp3FindSync(offset, seekOffset, fpUsed);
-            if (err == MP3_SUCCESS)
+            // lost sync, look for the next frame in the buffered block first
+            uint32 syncPos = 0;
+            if (!FindSyncInScanBuffer(scanPos + 1, syncPos))
             {
-                offset += seekOffset;
-                err = MP3Utils::SeektoOffset(fpUsed, seekOffset, Oscl_File::SEEKCUR);
-                if (MP3_SUCCESS != err)
-                {
-                    return err;
-                }
-
-                if (!MP3FileIO::readByteData(fpUsed, MP3_FRAME_HEADER_SIZE, pFrameHeader))
+                MP3Utils::SeektoOffset(fpUsed, scanPos, Oscl_File::SEEKSET);
+                MP3ErrorType err = mp3FindSync(scanPos, seekOffset, fpUsed);
+                if (err != MP3_SUCCESS)
                 {
                     iDurationScanComplete = true;
-                    status = FillTOCTable(offset, iScanTimestamp);
-                    if (status == MP3_ERROR_UNKNOWN)
-                    {
-                        // This will happen when FillTocTable returns error because of
-                        // NULL TOCTable.
-                        // Not a valid condition this should never happen, except if
-                        // there was memory allocation failure during ParseMP3File.
-                        // If happens return Duration Present to avoid any further ScanMp3File calls.
-                        return MP3_DURATION_PRESENT;
-                    }
-                    return MP3_INSUFFICIENT_DATA;
+                    return EndScan(scanPos, iScanTimestamp, err);
                 }
+                syncPos = scanPos + seekOffset;
+            }
+            scanPos = syncPos;
 
-                firstHeader = SwapFileToHostByteOrderInt32(pFrameHeader);
-                if (! GetMP3Header(firstHeader, mp3HeaderInfo))
-                {
-                    iDurationScanComplete = true;
-                    status = FillTOCTable(offset, iScanTimestamp);
-                    if (status == MP3_ERROR_UNKNOWN)
-                    {
-                        // This will happen when FillTocTable returns error because of
-                        // NULL TOCTable.
-                        // Not a valid condition this should never happen, except if
-                        // there was memory allocation failure during ParseMP3File.
-                        // If happens return Duration Present to avoid any further ScanMp3File calls.
-                        return MP3_DURATION_PRESENT;
-                    }
-                    return MP3_FILE_HDR_READ_ERR;
-                }
+            pFrameHeader = ScanBufferPeek(fpUsed, scanPos, MP3_FRAME_HEADER_SIZE);
+            if (pFrameHeader == NULL)
+            {
+                iDurationScanComplete = true;
+                return EndScan(scanPos, iScanTimestamp, MP3_INSUFFICIENT_DATA);
             }
-            else
+
+            firstHeader = SwapFileToHostByteOrderInt32(pFrameHeader);
+            if (! GetMP3Header(firstHeader, mp3HeaderInfo))
             {
                 iDurationScanComplete = true;
-                status = FillTOCTable(offset, iScanTimestamp);
-                if (status == MP3_ERROR_UNKNOWN)
-                {
-                    // This will happen when FillTocTable returns error because of
-                    // NULL TOCTable.
-                    // Not a valid condition this should never happen, except if
-                    // there was memory allocation failure during ParseMP3File.
-                    // If happens return Duration Present to avoid any further ScanMp3File calls.
-                    return MP3_DURATION_PRESENT;
-                }
-                return err;
+                return EndScan(scanPos, iScanTimestamp, MP3_FILE_HDR_READ_ERR);
             }
         }
 
-        if (!DecodeMP3Header(mp3HeaderInfo, mp3ConfigInfo, false))
+        if (!DecodeMP3Header(mp3HeaderInfo, mp3ConfigInfo, false) ||
+                (mp3ConfigInfo.FrameLengthInBytes <= MP3_FRAME_HEADER_SIZE) ||
+                (mp3ConfigInfo.BitRate <= 0))
         {
             iDurationScanComplete = true;
-            status = FillTOCTable(offset, iScanTimestamp);
-            if (status == MP3_ERROR_UNKNOWN)
+            return EndScan(scanPos, iScanTimestamp, MP3_FILE_HDR_DECODE_ERR);
+        }
+
+        if (iFrameIndexEnabled && ((iScannedFrameCount % MP3_FRAME_INDEX_STRIDE) == 0))
+        {
+            int32 leavecode = OsclErrNone;
+            OSCL_TRY(leavecode, iFrameIndex.push_back(scanPos - StartOffset));
+            if (leavecode != OsclErrNone)
             {
-                // This will happen when FillTocTable returns error because of
-                // NULL TOCTable.
-                // Not a valid condition this should never happen, except if
-                // there was memory allocation failure during ParseMP3File.
-                // If happens return Duration Present to avoid any further ScanMp3File calls.
-                return MP3_DURATION_PRESENT;
+                // a partial index would no longer map entries to frame numbers
+                iFrameIndex.clear();
+                iFrameIndexEnabled = false;
             }
-            return MP3_FILE_HDR_DECODE_ERR;
         }
 
-        MP3Utils::SeektoOffset(fpUsed, mp3ConfigInfo.FrameLengthInBytes - MP3_FRAME_HEADER_SIZE, Oscl_File::SEEKCUR);
+        scanPos += mp3ConfigInfo.FrameLengthInBytes;
         bitrate = mp3ConfigInfo.BitRate;
         frameDur = frameDur + (uint32)((OsclFloat) mp3ConfigInfo.FrameLengthInBytes * 8000.00f / mp3ConfigInfo.BitRate);
-        iLastScanPosition = fpUsed->Tell();
+        iLastScanPosition = scanPos;
         numFrames++;
         iScannedFrameCount++;
 
@@ -892,7 +878,113 @@ MP3ErrorType MP3Parser::ScanMP3File(PVFile * fpUsed, uint32 aFramesToScan)
     return MP3_SUCCESS;
 }
 
+/***********************************************************************
+ *  Function : EndScan
+ *  Purpose  : Records the last scanned position in the TOC table when
+ *             the duration scan stops early.
+ *  Input    : aFilePos, aTimestamp, aStatus - status to report
+ *  Return   : aStatus, or MP3_DURATION_PRESENT if the TOC is unusable
+ ***********************************************************************/
+MP3ErrorType MP3Parser::EndScan(uint32 aFilePos, uint32 aTimestamp, MP3ErrorType aStatus)
+{
+    if (iDurationScanComplete && pScanBuffer)
+    {
+        // nothing more to read, release the block buffer
+        OSCL_ARRAY_DELETE(pScanBuffer);
+        pScanBuffer = NULL;
+        iScanBufferLength = 0;
+    }
+
+    if (FillTOCTable(aFilePos, aTimestamp) == MP3_ERROR_UNKNOWN)
+    {
+        // This will happen when FillTocTable returns error because of
+        // NULL TOCTable.
+        // Not a valid condition this should never happen, except if
+        // there was memory allocation failure during ParseMP3File.
+        // If happens return Duration Present to avoid any further ScanMp3File calls.
+        return MP3_DURATION_PRESENT;
+    }
+    return aStatus;
+}
+
+/***********************************************************************
+ *  Function : ScanBufferPeek
+ *  Purpose  : Returns a pointer to aLength bytes at file offset aOffset,
+ *             refilling the scan buffer with a single large read when
+ *             the range is not already buffered.
+ *  Return   : NULL if the data is not (yet) available
+ ***********************************************************************/
+uint8* MP3Parser::ScanBufferPeek(PVFile* aFile, uint32 aOffset, uint32 aLength)
+{
+    if ((aOffset >= iScanBufferOffset) &&
+            ((aOffset + aLength) <= (iScanBufferOffset + iScanBufferLength)))
+    {
+        return pScanBuffer + (aOffset - iScanBufferOffset);
+    }
+
+    iScanBufferOffset = aOffset;
+    iScanBufferLength = 0;
+    if (aFile->Seek(aOffset, Oscl_File::SEEKSET) != 0)
+    {
+        return NULL;
+    }
+    int32 bytesRead = aFile->Read(pScanBuffer, 1, MP3_SCAN_BUFFER_SIZE);
+    if (bytesRead > 0)
+    {
+        iScanBufferLength = (uint32)bytesRead;
+    }
+    if (iScanBufferLength < aLength)
+    {
+        return NULL;
+    }
+    return pScanBuffer;
+}
+
+/***********************************************************************
+ *  Function : FindSyncInScanBuffer
+ *  Purpose  : Searches the buffered block from aOffset for a frame
+ *             header which is followed by another valid header.
+ *  Output   : aSyncOffset - absolute file offset of the frame found
+ *  Return   : false if no frame could be confirmed inside the buffer
+ ***********************************************************************/
+bool MP3Parser::FindSyncInScanBuffer(uint32 aOffset, uint32 &aSyncOffset)
+{
+    if ((aOffset < iScanBufferOffset) || (iScanBufferLength < (2 * MP3_FRAME_HEADER_SIZE)))
+    {
+        return false;
+    }
 
+    MP3HeaderType hdrInfo;
+    MP3ConfigInfoType cfgInfo;
+    uint32 end = iScanBufferLength - MP3_FRAME_HEADER_SIZE;
+    for (uint32 i = aOffset - iScanBufferOffset; i < end; i++)
+    {
+        if ((pScanBuffer[i] != 0xFF) || ((pScanBuffer[i+1] & 0xE0) != 0xE0))
+        {
+            continue;
+        }
+        uint32 header = SwapFileToHostByteOrderInt32(pScanBuffer + i);
+        if (!GetMP3Header(header, hdrInfo) || !DecodeMP3Header(hdrInfo, cfgInfo, false) ||
+                (cfgInfo.FrameLengthInBytes <= MP3_FRAME_HEADER_SIZE))
+        {
+            continue;
+        }
+        uint32 next = i + cfgInfo.FrameLengthInBytes;
+        if (next > end)
+        {
+            // can't confirm it from the buffer, let mp3FindSync decide
+            return false;
+        }
+        uint32 srIndex = hdrInfo.srIndex;
+        header = SwapFileToHostByteOrderInt32(pScanBuffer + next);
+        if (GetMP3Header(header, hdrInfo) && (hdrInfo.srIndex == srIndex))
+        {
+            aSyncOffset = iScanBufferOffset + i;
+            return true;
+        }
+    }
+    return false;
+}
 
 /***********************************************************************
  * FUNCTION:    GetMP3Header
@@ -1829,6 +1921,11 @@ uint32 MP3Parser::SeekPointFromTimestamp(uint32 &timestamp)
 
     bool bUseTOCForRepos = false;
 
+    if (SeekPointFromFrameIndex(timestamp, seekPoint))
+    {
+        return seekPoint;
+    }
+
     uint32 maxTSInTOC = iTOCFilledCount * iBinWidth;
     if (iTOCFilledCount > 1 && (timestamp < maxTSInTOC || iDurationScanComplete))
     {
@@ -1970,7 +2067,7 @@ uint32 MP3Parser::SeekPointFromTimestamp(uint32 &timestamp)
         {
             seekPoint += seekOffset;
             MP3Utils::SeektoOffset(fp, seekOffset, Oscl_File::SEEKCUR);
-            if (iDurationScanComplete)
+            if (iDurationScanComplete && bUseTOCForRepos)
             {
                 uint32 offsetDiff = iTOC[binNo+1] - iTOC[binNo];
                 timestamp = (binNo * iBinWidth) + (iBinWidth * (seekPoint - iTOC[binNo]) / offsetDiff);
@@ -2011,6 +2108,74 @@ uint32 MP3Parser::SeekPointFromTimestamp(uint32 &timestamp)
 }
 
 
+/***********************************************************************
+ * FUNCTION:    SeekPointFromFrameIndex
+ * DESCRIPTION: Resolves the timestamp to the exact frame using the frame
+ *              index built by the duration scan. The nearest indexed
+ *              frame is taken and, for local clips, the remaining frames
+ *              up to the target are walked header by header.
+ * INPUT/OUTPUT PARAMETERS: aTimestamp - updated to the frame's timestamp
+ * RETURN VALUE: false if the index does not cover the timestamp
+ * SIDE EFFECTS: updates iCurrFrameNumber and iTimestamp
+ ***********************************************************************/
+bool MP3Parser::SeekPointFromFrameIndex(uint32 &aTimestamp, uint32 &aSeekPoint)
+{
+    if (iFrameIndex.empty() || (iSamplesPerFrame == 0) || (iSamplingRate == 0))
+    {
+        return false;
+    }
+
+    uint32 targetFrame = (uint32)((OsclFloat)aTimestamp * (OsclFloat)iSamplingRate /
+                                  ((OsclFloat)iSamplesPerFrame * 1000.0f));
+    uint32 entry = targetFrame / MP3_FRAME_INDEX_STRIDE;
+    if (iDurationScanComplete)
+    {
+        if (targetFrame >= iScannedFrameCount)
+        {
+            // at or beyond the end of the clip
+            return false;
+        }
+    }
+    else if ((entry + 1) >= iFrameIndex.size())
+    {
+        // not scanned that far yet
+        return false;
+    }
+
+    uint32 frame = entry * MP3_FRAME_INDEX_STRIDE;
+    uint32 seekPoint = iFrameIndex[entry];
+
+    if (fp->GetFileBufferingCapacity() == 0)
+    {
+        uint8 frameHeader[MP3_FRAME_HEADER_SIZE];
+        MP3HeaderType hdrInfo;
+        MP3ConfigInfoType cfgInfo;
+        while (frame < targetFrame)
+        {
+            if ((MP3Utils::SeektoOffset(fp, seekPoint + StartOffset, Oscl_File::SEEKSET) != MP3_SUCCESS) ||
+                    !MP3FileIO::readByteData(fp, MP3_FRAME_HEADER_SIZE, frameHeader))
+            {
+                break;
+            }
+            uint32 header = SwapFileToHostByteOrderInt32(frameHeader);
+            if (!GetMP3Header(header, hdrInfo) || !DecodeMP3Header(hdrInfo, cfgInfo, false) ||
+                    (cfgInfo.FrameLengthInBytes <= MP3_FRAME_HEADER_SIZE))
+            {
+                break;
+            }
+            seekPoint += cfgInfo.FrameLengthInBytes;
+            frame++;
+        }
+    }
+
+    aTimestamp = (uint32)((OsclFloat)frame * (OsclFloat)iSamplesPerFrame * 1000.0f / (OsclFloat)iSamplingRate);
+    aSeekPoint = seekPoint;
+    iCurrFrameNumber = frame;
+    iTimestamp = aTimestamp;
+    return true;
+}
+
+
 /***********************************************************************
  * FUNCTION:    mp3FindSync
  * DESCRIPTION: This function reads the whole file searching for a sync
@@ -3068,6 +3233,136 @@ MP3ErrorType MP3Parser::FillTOCTable(uint32 aFilePos, uint32 aTimeStampToFrame)
     return MP3_SUCCESS;
 }
 
+/***********************************************************************
+ *  Function : GetFrameIndexSize
+ *  Purpose  : Size of the serialized frame index
+ *  Return   : size in bytes, 0 when the scan has not completed
+ ***********************************************************************/
+uint32 MP3Parser::GetFrameIndexSize()
+{
+    if (!iDurationScanComplete || iFrameIndex.empty())
+    {
+        return 0;
+    }
+    return (MP3_FRAME_INDEX_HEADER_WORDS + iFrameIndex.size()) * sizeof(uint32);
+}
+
+static void PutLE32(uint8* &aPtr, uint32 aValue)
+{
+    aPtr[0] = (uint8)(aValue & 0xFF);
+    aPtr[1] = (uint8)((aValue >> 8) & 0xFF);
+    aPtr[2] = (uint8)((aValue >> 16) & 0xFF);
+    aPtr[3] = (uint8)((aValue >> 24) & 0xFF);
+    aPtr += 4;
+}
+
+static uint32 GetLE32(const uint8* &aPtr)
+{
+    uint32 value = (uint32)aPtr[0] | ((uint32)aPtr[1] << 8) |
+                   ((uint32)aPtr[2] << 16) | ((uint32)aPtr[3] << 24);
+    aPtr += 4;
+    return value;
+}
+
+/***********************************************************************
+ *  Function : SerializeFrameIndex
+ *  Purpose  : Writes the frame index as little endian 32 bit words:
+ *             magic, version, file size, start offset, first frame
+ *             header, stride, frame count, average bitrate, entry count
+ *             followed by the entries.
+ ***********************************************************************/
+bool MP3Parser::SerializeFrameIndex(uint8* aBuffer, uint32 aBufferSize)
+{
+    uint32 size = GetFrameIndexSize();
+    if ((size == 0) || (aBuffer == NULL) || (aBufferSize < size))
+    {
+        return false;
+    }
+
+    uint8* ptr = aBuffer;
+    PutLE32(ptr, MP3_FRAME_INDEX_MAGIC);
+    PutLE32(ptr, MP3_FRAME_INDEX_VERSION);
+    PutLE32(ptr, iLocalFileSize);
+    PutLE32(ptr, StartOffset);
+    PutLE32(ptr, SwapFileToHostByteOrderInt32(ConfigData));
+    PutLE32(ptr, MP3_FRAME_INDEX_STRIDE);
+    PutLE32(ptr, iScannedFrameCount);
+    PutLE32(ptr, (uint32)iAvgBitrateInbpsFromCompleteScan);
+    PutLE32(ptr, iFrameIndex.size());
+    for (uint32 i = 0; i < iFrameIndex.size(); i++)
+    {
+        PutLE32(ptr, iFrameIndex[i]);
+    }
+    return true;
+}
+
+/***********************************************************************
+ *  Function : DeserializeFrameIndex
+ *  Purpose  : Restores an index written by SerializeFrameIndex. It is
+ *             only accepted if it was built for a clip with the same
+ *             size, audio start offset and first frame header.
+ ***********************************************************************/
+MP3ErrorType MP3Parser::DeserializeFrameIndex(const uint8* aBuffer, uint32 aBufferSize)
+{
+    if ((aBuffer == NULL) || (aBufferSize < MP3_FRAME_INDEX_HEADER_WORDS * sizeof(uint32)))
+    {
+        return MP3_ERROR_UNKNOWN;
+    }
 
+    const uint8* ptr = aBuffer;
+    uint32 magic = GetLE32(ptr);
+    uint32 version = GetLE32(ptr);
+    uint32 fileSize = GetLE32(ptr);
+    uint32 startOffset = GetLE32(ptr);
+    uint32 firstHeader = GetLE32(ptr);
+    uint32 stride = GetLE32(ptr);
+    uint32 frameCount = GetLE32(ptr);
+    uint32 avgBitrate = GetLE32(ptr);
+    uint32 numEntries = GetLE32(ptr);
+
+    if ((magic != MP3_FRAME_INDEX_MAGIC) || (version != MP3_FRAME_INDEX_VERSION) ||
+            (stride != MP3_FRAME_INDEX_STRIDE) ||
+            (fileSize != iLocalFileSize) || (startOffset != StartOffset) ||
+            (firstHeader != SwapFileToHostByteOrderInt32(ConfigData)) ||
+            (numEntries == 0) || (numEntries != ((frameCount + stride - 1) / stride)) ||
+            ((aBufferSize / sizeof(uint32)) - MP3_FRAME_INDEX_HEADER_WORDS < numEntries))
+    {
+        return MP3_ERROR_UNKNOWN;
+    }
 
+    int32 leavecode = OsclErrNone;
+    iFrameIndex.clear();
+    OSCL_TRY(leavecode, iFrameIndex.reserve(numEntries));
+    if (leavecode != OsclErrNone)
+    {
+        return MP3_ERR_NO_MEMORY;
+    }
+    uint32 prevOffset = 0;
+    for (uint32 i = 0; i < numEntries; i++)
+    {
+        uint32 offset = GetLE32(ptr);
+        if ((offset < prevOffset) || (offset >= fileSize))
+        {
+            iFrameIndex.clear();
+            return MP3_ERROR_UNKNOWN;
+        }
+        iFrameIndex.push_back(offset);
+        prevOffset = offset;
+    }
 
+    iScannedFrameCount = frameCount;
+    iAvgBitrateInbpsFromCompleteScan = (int32)avgBitrate;
+    iDurationScanComplete = true;
+    iFirstScan = false;
+    iFrameIndexEnabled = false;
+    if (pScanBuffer)
+    {
+        OSCL_ARRAY_DELETE(pScanBuffer);
+        pScanBuffer = NULL;
+        iScanBufferLength = 0;
+    }
+    // recompute the clip duration from the restored frame count
+    iClipDurationComputed = 0;
+    GetDurationFromCompleteScan(iClipDurationInMsec);
+    return MP3_SUCCESS;
+}
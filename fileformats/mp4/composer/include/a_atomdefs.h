@@ -304,6 +304,22 @@ typedef enum
  */
 #define PVMP4FF_3GPP_DOWNLOAD_MODE  0x00000009
 
+/**
+ * This mode authors 3GPP Progressive Downloadable output files without temp files:
+ * Meta Data is upfront, in space reserved ahead of the media data.
+ * Media Data is interleaved and written once, directly to the output file.
+ * The reserved space is sized from setExpectedSampleCount(); if the movie
+ * atom outgrows it, the space is left as a free atom and the movie atom is
+ * written at the end of the clip, as in PVMP4FF_3GPP_DOWNLOAD_MODE.
+ */
+#define PVMP4FF_3GPP_FAST_START_MODE    0x0000000B
+
+// Movie atom space reserved per expected sample in PVMP4FF_3GPP_FAST_START_MODE:
+// worst case stts (8) + ctts (8) + stsz (4) + stss (4) + stco/stsc share (8)
+#define PVMP4FF_FAST_START_BYTES_PER_SAMPLE     32
+// Allowance for decoder specific info and meta data set after prepareToEncode()
+#define PVMP4FF_FAST_START_GUARD_BAND           4096
+
 #define PVMP4FF_SET_FIRST_SAMPLE_EDIT_MODE  0x00000010
 
 // movie fragment mode
@@ -58,6 +58,32 @@ typedef Oscl_File* MP4_AUTHOR_FF_FILE_HANDLE;
 
 struct GAU;
 
+/**
+ * Observer notified in PVMP4FF_MOVIE_FRAGMENT_MODE each time a segment of the
+ * output is complete and flushed, so it can be served while authoring goes on.
+ * It is called from the context adding the samples.
+ */
+class PVA_FF_MovieFragmentSegmentObserver
+{
+    public:
+        virtual ~PVA_FF_MovieFragmentSegmentObserver() {}
+
+        /**
+         * @param aSequenceNumber   0 for the initialization segment (ftyp, moov
+         *                          and the media preceding the first fragment),
+         *                          else the sequence number of the movie fragment.
+         *                          The moov of segment 0 is patched with the final
+         *                          durations when the file is rendered.
+         * @param aFileName         File holding the segment; empty when it is the
+         *                          output file and that was passed in as a handle.
+         * @param aOffset, aSize    Byte range of the segment within that file.
+         */
+        virtual void MovieFragmentSegmentReady(uint32 aSequenceNumber,
+                                               PVA_FF_UNICODE_STRING_PARAM aFileName,
+                                               uint32 aOffset,
+                                               uint32 aSize) = 0;
+};
+
 class PVA_FF_IMpeg4File : public PVA_FF_ISucceedFail
 {
     public:
@@ -335,6 +361,9 @@ class PVA_FF_IMpeg4File : public PVA_FF_ISucceedFail
 
         virtual bool prepareToEncode() = 0;
 
+        // PVMP4FF_3GPP_FAST_START_MODE: number of samples expected over all
+        // tracks, used to reserve the movie atom space. Call before prepareToEncode().
+        virtual bool setExpectedSampleCount(uint32 sampleCount) = 0;
 
         virtual bool setInterLeaveInterval(int32 interval) = 0;
 
@@ -347,6 +376,13 @@ class PVA_FF_IMpeg4File : public PVA_FF_ISucceedFail
         virtual void setMovieFragmentDuration(uint32 duration) = 0;
         virtual uint32 getMovieFragmentDuration() = 0;
 
+        // movie fragment segment output, to be set before the first fragment starts.
+        // With a segment file name, every fragment (moof followed by its mdat) goes
+        // to its own file <baseFileName><sequence number>.m4s, with data offsets
+        // relative to that file, and no mfra is written.
+        virtual void setMovieFragmentSegmentObserver(PVA_FF_MovieFragmentSegmentObserver *observer) = 0;
+        virtual bool setMovieFragmentSegmentFileName(PVA_FF_UNICODE_STRING_PARAM baseFileName) = 0;
+
         OSCL_IMPORT_REF static void DestroyMP4FileObject(PVA_FF_IMpeg4File* aMP4FileObject);
 };
 
@@ -53,6 +53,10 @@ class PVA_FF_MovieFragmentAtom : public PVA_FF_Atom
 
         void    setTrackFragmentBaseDataOffset(uint32 trackId, uint32 offset);
 
+        // set data offsets of all track fragments relative to this moof,
+        // written at moofOffset and followed by its mdat
+        void    setMovieFragmentOffset(uint32 moofOffset, uint32 mdatHeaderSize);
+
         uint32  getTrackFragmentNumber(uint32 trackId);
 
         virtual bool renderToFileStream(MP4_AUTHOR_FF_FILE_IO_WRAP* fp);
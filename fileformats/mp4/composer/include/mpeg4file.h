@@ -232,6 +232,8 @@ class PVA_FF_Mpeg4File : public PVA_FF_IMpeg4File, public PVA_FF_Parentable
 
         void populateUserDataAtom();
 
+        bool setExpectedSampleCount(uint32 sampleCount);
+        bool renderReservedMovieAtom(MP4_AUTHOR_FF_FILE_IO_WRAP *fp);
 
         virtual bool setInterLeaveInterval(int32 interval)
         {
@@ -272,8 +274,15 @@ class PVA_FF_Mpeg4File : public PVA_FF_IMpeg4File, public PVA_FF_Parentable
         void setMovieFragmentDuration(uint32 duration);
         uint32 getMovieFragmentDuration();
 
+        void setMovieFragmentSegmentObserver(PVA_FF_MovieFragmentSegmentObserver *observer);
+        bool setMovieFragmentSegmentFileName(PVA_FF_UNICODE_STRING_PARAM baseFileName);
+
         bool renderMoovAtom();
         bool renderMovieFragments();
+        bool startMovieFragmentMediaData();
+        void notifySegmentReady(uint32 sequenceNumber, MP4_AUTHOR_FF_FILE_HANDLE fileHandle,
+                                PVA_FF_UNICODE_STRING_PARAM fileName,
+                                uint32 offset, uint32 size);
 
     private:
 
@@ -351,13 +360,18 @@ class PVA_FF_Mpeg4File : public PVA_FF_IMpeg4File, public PVA_FF_Parentable
         // Movie Fragment mode parameters
         bool        _oMovieFragmentEnabled;
         bool        _oComposeMoofAtom;          // flag when true, samples are added in MOOF
-        uint32      _currentMoofOffset;         // contains the offset of current MOOF before MDAT,
-        // actual offset is current offset + size of MDAT for this MOOF
+        uint32      _currentMoofOffset;         // offset of current MOOF, its MDAT follows it
         uint32      _movieFragmentDuration;     // always in milliseconds : decides total sample length in MOOF and MOOV
         bool        _oTrunStart;                // true when new TRUN is to be added in MOOF from interleave buffer
         // made true for 1st sample of interleave buffer
         uint32      _sequenceNumber;            // keep track of number of movie fragments added
 
+        // Movie fragment segment output
+        PVA_FF_MovieFragmentSegmentObserver *_pSegmentObserver;
+        bool        _oRollingSegmentFiles;      // true when each fragment goes to its own file
+        PVA_FF_UNICODE_HEAP_STRING _segmentFileBaseName;
+        PVA_FF_UNICODE_HEAP_STRING _segmentFileName;   // file of the current fragment
+
         // interleave buffers and vectors
         Oscl_Vector<PVA_FF_InterLeaveBuffer*, OsclMemAllocator> *_pInterLeaveBufferVec;
 
@@ -414,6 +428,12 @@ class PVA_FF_Mpeg4File : public PVA_FF_IMpeg4File, public PVA_FF_Parentable
         uint32      _initialUserDataSize;
         uint32      _directRenderFileOffset;
 
+        // Fast start mode: movie atom written into space reserved after ftyp
+        bool        _oFastStartEnabled;
+        uint32      _expectedSampleCount;
+        uint32      _movieAtomReserveOffset;
+        uint32      _movieAtomReserveSize;
+
         PVA_FF_UNICODE_HEAP_STRING _outputFileName;
         MP4_AUTHOR_FF_FILE_HANDLE  _outputFileHandle;
 
@@ -55,6 +55,8 @@ class PVA_FF_TrackFragmentAtom : public PVA_FF_Atom
 
         void    setTrackFragmentBaseDataOffset(uint64 offset);
 
+        void    setMovieFragmentOffset(uint64 moofOffset, uint32 mediaDataOffset);
+
         void    updateLastTSEntry(uint32 ts);
 
         virtual bool renderToFileStream(MP4_AUTHOR_FF_FILE_IO_WRAP* fp);
@@ -82,7 +84,6 @@ class PVA_FF_TrackFragmentAtom : public PVA_FF_Atom
         uint32  _prevTS;
         uint32  _interleaveDuration;    // determines duration of each TRUN
         uint32  _fragmentDuration;      // determines the duration of samples in this fragment
-        bool    _ofirstTrun;
 
         virtual void recomputeSize();
 
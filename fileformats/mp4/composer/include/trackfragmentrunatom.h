@@ -53,6 +53,10 @@ class PVA_FF_TrackFragmentRunAtom : public PVA_FF_FullAtom
         {
             return _sampleCount;
         }
+        uint32 getDataOffset() const
+        {
+            return _dataOffset;
+        }
     private:
 
         uint32      _currentTimestamp;
@@ -267,16 +267,26 @@ PVA_FF_MediaDataAtom::prepareTargetFile(uint32 mediaStartOffset)
         {
             if (mediaStartOffset > 0)
             {
-                // Write zeros to accomodate the user data upfront
+                // Write zeros to accomodate the user data upfront. This can
+                // include the reserved movie atom space in fast start mode,
+                // so write it in blocks rather than allocating it all.
+                uint32 blockSize = (mediaStartOffset < TEMP_TO_TARGET_FILE_COPY_BLOCK_SIZE) ?
+                                   mediaStartOffset : TEMP_TO_TARGET_FILE_COPY_BLOCK_SIZE;
                 uint8* tempBuffer = NULL;
-                PV_MP4_FF_ARRAY_NEW(NULL, uint8, mediaStartOffset, tempBuffer);
+                PV_MP4_FF_ARRAY_NEW(NULL, uint8, blockSize, tempBuffer);
 
-                oscl_memset(tempBuffer, 0, mediaStartOffset);
+                oscl_memset(tempBuffer, 0, blockSize);
 
-                if (!(PVA_FF_AtomUtils::renderByteData(&_pofstream, mediaStartOffset, tempBuffer)))
+                uint32 remaining = mediaStartOffset;
+                while (remaining > 0)
                 {
-                    PV_MP4_ARRAY_DELETE(NULL, tempBuffer);
-                    return false;
+                    uint32 writeSize = (remaining < blockSize) ? remaining : blockSize;
+                    if (!(PVA_FF_AtomUtils::renderByteData(&_pofstream, writeSize, tempBuffer)))
+                    {
+                        PV_MP4_ARRAY_DELETE(NULL, tempBuffer);
+                        return false;
+                    }
+                    remaining -= writeSize;
                 }
                 PV_MP4_ARRAY_DELETE(NULL, tempBuffer);
             }
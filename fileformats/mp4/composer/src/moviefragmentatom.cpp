@@ -196,6 +196,19 @@ PVA_FF_MovieFragmentAtom::setTrackFragmentBaseDataOffset(uint32 trackId, uint32
 
 
 
+// the mdat payload starts right after this moof and the mdat header
+void
+PVA_FF_MovieFragmentAtom::setMovieFragmentOffset(uint32 moofOffset, uint32 mdatHeaderSize)
+{
+    uint32 mediaDataOffset = getSize() + mdatHeaderSize;
+
+    for (uint32 ii = 0; ii < _pTrafList->size(); ii++)
+    {
+        ((*_pTrafList)[ii])->setMovieFragmentOffset(moofOffset, mediaDataOffset);
+    }
+}
+
+
 // recompute size of atom
 void
 PVA_FF_MovieFragmentAtom::recomputeSize()
@@ -27,6 +27,9 @@
 #ifndef OSCL_STRING_UTILS_H_INCLUDED
 #include "oscl_string_utils.h"
 #endif
+#ifndef OSCL_SNPRINTF_H_INCLUDED
+#include "oscl_snprintf.h"
+#endif
 
 #include "mpeg4file.h"
 #include "a_atomdefs.h"
@@ -227,6 +230,8 @@ PVA_FF_Mpeg4File::init(int32 mediaType,
     _pCurrentMediaDataAtom      = NULL;
     _currentMoofOffset          = 0;
     _sequenceNumber             = 0;
+    _pSegmentObserver           = NULL;
+    _oRollingSegmentFiles       = false;
 
 
     _aFs = osclFileServerSession;
@@ -243,6 +248,11 @@ PVA_FF_Mpeg4File::init(int32 mediaType,
     _initialUserDataSize     = 0;
     _oDirectRenderEnabled    = false;
 
+    _oFastStartEnabled       = false;
+    _expectedSampleCount     = 0;
+    _movieAtomReserveOffset  = 0;
+    _movieAtomReserveSize    = 0;
+
     _oSetTitleDone          = false;
     _oSetAuthorDone         = false;
     _oSetCopyrightDone      = false;
@@ -310,6 +320,15 @@ PVA_FF_Mpeg4File::init(int32 mediaType,
         _oUserDataUpFront     = false;
     }
 
+    /*
+     * Meta data upfront without temp files: the movie atom goes into
+     * space reserved ahead of the directly rendered media data.
+     */
+    if (_oMovieAtomUpfront && _totalTempFileRemoval && !_oMovieFragmentEnabled)
+    {
+        _oFastStartEnabled = true;
+    }
+
     // Create user data atom
     PV_MP4_FF_NEW(fp->auditCB, PVA_FF_UserDataAtom, (), _puserDataAtom);
 
@@ -1343,6 +1362,11 @@ PVA_FF_Mpeg4File::renderToFileStream(MP4_AUTHOR_FF_FILE_IO_WRAP *fp)
             }
         }
     }
+    if (_oFastStartEnabled)
+    {
+        _oFileRenderCalled = true;
+        return renderReservedMovieAtom(fp);
+    }
     if ((_oDirectRenderEnabled) || (_totalTempFileRemoval))
     {
         PVA_FF_AtomUtils::seekFromStart(fp, _directRenderFileOffset);
@@ -1645,7 +1669,11 @@ PVA_FF_Mpeg4File::renderToFile(PVA_FF_UNICODE_STRING_PARAM filename)
 
         fp._filePtr = _targetFileHandle;
         fp._osclFileServerSession = OSCL_STATIC_CAST(Oscl_FileServer*, _aFs);
-        _pMfraAtom->renderToFileStream(&fp);
+        if (!_oRollingSegmentFiles)
+        {
+            // moof offsets are only meaningful when all fragments are in this file
+            _pMfraAtom->renderToFileStream(&fp);
+        }
         _pmovieAtom->writeMaxSampleSize(&fp);
         if (_oIsFileOpen)
         {
@@ -2484,6 +2512,19 @@ PVA_FF_Mpeg4File::prepareToEncode()
 
     _oFtypPopulated = true;
 
+    if (_oFastStartEnabled)
+    {
+        /*
+         * Reserve the movie atom space between ftyp and mdat, sized from
+         * the movie atom as it is now plus its growth per expected sample.
+         */
+        _movieAtomReserveOffset = _initialUserDataSize;
+        _movieAtomReserveSize = _pmovieAtom->getSize() +
+                                (_expectedSampleCount * PVMP4FF_FAST_START_BYTES_PER_SAMPLE) +
+                                PVMP4FF_FAST_START_GUARD_BAND;
+        _initialUserDataSize += _movieAtomReserveSize;
+    }
+
     if (_oDirectRenderEnabled)
     {
         if ((_oSetTitleDone        == false) ||
@@ -2559,6 +2600,95 @@ PVA_FF_Mpeg4File::populateUserDataAtom()
     _oUserDataPopulated = true;
 }
 
+bool
+PVA_FF_Mpeg4File::setExpectedSampleCount(uint32 sampleCount)
+{
+    if (!_oFastStartEnabled || _oFtypPopulated)
+    {
+        // Only meaningful in fast start mode, before the space is reserved
+        return false;
+    }
+    _expectedSampleCount = sampleCount;
+    return true;
+}
+
+bool
+PVA_FF_Mpeg4File::renderReservedMovieAtom(MP4_AUTHOR_FF_FILE_IO_WRAP *fp)
+{
+    _pmovieAtom->prepareToRender();
+
+    // The media data is already in its final place, only fix up the chunk offsets
+    for (uint32 i = 0; i < _pmediaDataAtomVec->size(); i++)
+    {
+        uint32 chunkFileOffset =
+            (*_pmediaDataAtomVec)[i]->getFileOffsetForChunkStart();
+
+        if (chunkFileOffset != 0)
+        {
+            Oscl_Vector<PVA_FF_TrackAtom*, OsclMemAllocator> *trefVec =
+                (*_pmediaDataAtomVec)[i]->getTrackReferencePtrVec();
+
+            if (trefVec != NULL)
+            {
+                for (uint32 trefVecIndex = 0;
+                        trefVecIndex < trefVec->size();
+                        trefVecIndex++)
+                {
+                    (*trefVec)[trefVecIndex]->updateAtomFileOffsets(chunkFileOffset);
+                }
+            }
+        }
+    }
+
+    uint32 movieAtomSize = _pmovieAtom->getSize();
+    uint32 freeSpaceSize = _movieAtomReserveSize;
+
+    PVA_FF_AtomUtils::seekFromStart(fp, _movieAtomReserveOffset);
+
+    if ((movieAtomSize == _movieAtomReserveSize) ||
+            (movieAtomSize + DEFAULT_ATOM_SIZE <= _movieAtomReserveSize))
+    {
+        // Patch the movie atom in place, only the moov bytes are written
+        if (!_pmovieAtom->renderToFileStream(fp))
+        {
+            return false;
+        }
+        freeSpaceSize -= movieAtomSize;
+    }
+
+    /*
+     * Mark the unused part of the reservation (already zero filled by
+     * prepareTargetFile) as a free atom. If the movie atom did not fit,
+     * the whole reservation is free and the movie atom is appended after
+     * the media data instead.
+     */
+    if (freeSpaceSize > 0)
+    {
+        if (!PVA_FF_AtomUtils::render32(fp, freeSpaceSize))
+        {
+            return false;
+        }
+        if (!PVA_FF_AtomUtils::render32(fp, FREE_SPACE_ATOM))
+        {
+            return false;
+        }
+    }
+
+    if (freeSpaceSize == _movieAtomReserveSize)
+    {
+        PVA_FF_AtomUtils::seekFromStart(fp, _directRenderFileOffset);
+
+        if (!_pmovieAtom->renderToFileStream(fp))
+        {
+            return false;
+        }
+    }
+
+    _tempFileIndex = 'a';
+
+    return true;
+}
+
 bool
 PVA_FF_Mpeg4File::addMediaSampleInterleave(uint32 trackID,
         Oscl_Vector < OsclMemoryFragment,
@@ -2616,6 +2746,9 @@ PVA_FF_Mpeg4File::addMediaSampleInterleave(uint32 trackID,
             // render MOOV and MDAT atoms
             renderMoovAtom();
 
+            // ftyp, moov and the media so far make up the initialization segment
+            notifySegmentReady(0, _targetFileHandle, _outputFileName, 0, _directRenderFileOffset);
+
             _oComposeMoofAtom = true;
 
             // allocate Moof movie fragments
@@ -2659,16 +2792,11 @@ PVA_FF_Mpeg4File::addMediaSampleInterleave(uint32 trackID,
             }
 
             // form new MDAT atom
-            PVA_FF_MediaDataAtom *pMdatAtom = NULL;
-            PV_MP4_FF_NEW(fp->auditCB, PVA_FF_MediaDataAtom, (_targetFileHandle, _aFs, iCacheSize), pMdatAtom);
-
-            _pCurrentMediaDataAtom = pMdatAtom;
-
-            // current moof offset set at start of mdat, (later updated by size of mdat atom)
-            _currentMoofOffset = _baseOffset;
-
-            // base offset set to start of mdat (after fourcc code) as base data offset
-            _baseOffset += _pCurrentMediaDataAtom->prepareTargetFileForFragments(_directRenderFileOffset);
+            if (!startMovieFragmentMediaData())
+            {
+                _fileWriteFailed = true;
+                return false;
+            }
 
         }
 
@@ -3061,16 +3189,11 @@ PVA_FF_Mpeg4File::addMediaSampleInterleave(uint32 trackID,
             PV_MP4_FF_DELETE(NULL, PVA_FF_MediaDataAtom, _pCurrentMediaDataAtom);
 
             // form new MDAT atom
-            PVA_FF_MediaDataAtom *pMdatAtom = NULL;
-            PV_MP4_FF_NEW(fp->auditCB, PVA_FF_MediaDataAtom, (_targetFileHandle, _aFs, iCacheSize), pMdatAtom);
-
-            _pCurrentMediaDataAtom = pMdatAtom;
-
-            // current moof offset set at start of mdat, (later updated by size of mdat atom)
-            _currentMoofOffset = _baseOffset;
-
-            // base offset set to start of mdat (after fourcc code) as base data offset
-            _baseOffset += _pCurrentMediaDataAtom->prepareTargetFileForFragments(_directRenderFileOffset);
+            if (!startMovieFragmentMediaData())
+            {
+                _fileWriteFailed = true;
+                return false;
+            }
 
         }
 
@@ -3363,7 +3486,6 @@ PVA_FF_Mpeg4File::renderMoovAtom()
         return false;
     }
     _directRenderFileOffset = PVA_FF_AtomUtils::getCurrentFilePosition(&fp);    // hereafter movie fragments are written
-    _baseOffset = _directRenderFileOffset;  // base offset is used to set base data offset of Moof
 
 
     // store target file handle used to write further movie fragments
@@ -3375,34 +3497,130 @@ PVA_FF_Mpeg4File::renderMoovAtom()
 bool
 PVA_FF_Mpeg4File::renderMovieFragments()
 {
-    uint32 size;
-
-    uint32 fileWriteOffset;
-
     MP4_AUTHOR_FF_FILE_IO_WRAP fp;
 
-    fp._filePtr = _pCurrentMediaDataAtom->getTargetFilePtr();
+    fp._filePtr = NULL;
     fp._osclFileServerSession = OSCL_STATIC_CAST(Oscl_FileServer*, _aFs);
 
-    fileWriteOffset = PVA_FF_AtomUtils::getCurrentFilePosition(&fp);
+    if (_oRollingSegmentFiles)
+    {
+        if (!PVA_FF_AtomUtils::openFile(&fp, _segmentFileName, Oscl_File::MODE_READWRITE | Oscl_File::MODE_BINARY, iCacheSize))
+        {
+            if (fp._filePtr != NULL)
+            {
+                PVA_FF_AtomUtils::closeFile(&fp);
+            }
+            return false;
+        }
+    }
+    else
+    {
+        fp._filePtr = _targetFileHandle;
+        PVA_FF_AtomUtils::seekFromStart(&fp, _currentMoofOffset);
+    }
 
-    _pCurrentMediaDataAtom->closeTargetFile();
+    // moof then its mdat, with the sample data offsets relative to the moof
+    _pCurrentMoofAtom->setMovieFragmentOffset(_currentMoofOffset,
+            _pCurrentMediaDataAtom->getDefaultSize());
 
-    size = _pCurrentMediaDataAtom->getMediaDataSize();
+    bool status = (_pCurrentMoofAtom->renderToFileStream(&fp) &&
+                   _pCurrentMediaDataAtom->renderToFileStream(&fp));
 
-    _pMfraAtom->updateMoofOffset(size);
+    if (status)
+    {
+        _directRenderFileOffset = PVA_FF_AtomUtils::getCurrentFilePosition(&fp);    // hereafter further movie fragments are written
 
-    PVA_FF_AtomUtils::seekFromStart(&fp, fileWriteOffset);
+        // the fragment runs from the start of its moof to the end of its mdat
+        notifySegmentReady(_sequenceNumber, fp._filePtr,
+                           (_oRollingSegmentFiles ? _segmentFileName : _outputFileName),
+                           _currentMoofOffset, _directRenderFileOffset - _currentMoofOffset);
+    }
 
+    if (_oRollingSegmentFiles)
+    {
+        PVA_FF_AtomUtils::closeFile(&fp);
+    }
 
-    if (!(_pCurrentMoofAtom->renderToFileStream(&fp)))
+    return status;
+}
+
+bool
+PVA_FF_Mpeg4File::startMovieFragmentMediaData()
+{
+    PVA_FF_MediaDataAtom *pMdatAtom = NULL;
+
+    // The moof size is only known once the fragment is complete, so the
+    // samples are kept in a temp file and copied after the moof. The
+    // previous fragment's temp file is gone by now, so its index is reused.
+    PV_MP4_FF_NEW(fp->auditCB, PVA_FF_MediaDataAtom, (_tempOutputPath,
+                  _tempFilePostfix,
+                  _tempFileIndex,
+                  MEDIA_DATA_ON_DISK,
+                  _aFs, iCacheSize),
+                  pMdatAtom);
+
+    _pCurrentMediaDataAtom = pMdatAtom;
+
+    if ((pMdatAtom->getTargetFilePtr() == NULL) || (pMdatAtom->_targetFileWriteError))
     {
         return false;
     }
 
-    _directRenderFileOffset = PVA_FF_AtomUtils::getCurrentFilePosition(&fp);    // hereafter further movie fragments are written
-    _baseOffset = _directRenderFileOffset;  // base offset is used to set base data offset of Moof
+    if (_oRollingSegmentFiles)
+    {
+        // <base file name><sequence number>.m4s, data offsets relative to it
+        char seqNum[16];
+        oscl_snprintf(seqNum, sizeof(seqNum), "%05d", _sequenceNumber);
+
+        _segmentFileName = _segmentFileBaseName;
+        for (uint32 i = 0; seqNum[i] != '\0'; i++)
+        {
+            _segmentFileName += (oscl_wchar)seqNum[i];
+        }
+        _segmentFileName += _STRLIT(".m4s");
+
+        _directRenderFileOffset = 0;
+    }
+
+    // moof goes where the previous fragment ended
+    _currentMoofOffset = _directRenderFileOffset;
+
+    // sample data offsets are within the mdat payload until the moof is rendered
+    _baseOffset = 0;
+
+    return true;
+}
+
+void
+PVA_FF_Mpeg4File::notifySegmentReady(uint32 sequenceNumber,
+                                     MP4_AUTHOR_FF_FILE_HANDLE fileHandle,
+                                     PVA_FF_UNICODE_STRING_PARAM fileName,
+                                     uint32 offset, uint32 size)
+{
+    if ((_pSegmentObserver != NULL) && (fileHandle != NULL))
+    {
+        // readers of the segment must see all of it
+        fileHandle->Flush();
+        _pSegmentObserver->MovieFragmentSegmentReady(sequenceNumber, fileName, offset, size);
+    }
+}
+
+void
+PVA_FF_Mpeg4File::setMovieFragmentSegmentObserver(PVA_FF_MovieFragmentSegmentObserver *observer)
+{
+    _pSegmentObserver = observer;
+}
 
+bool
+PVA_FF_Mpeg4File::setMovieFragmentSegmentFileName(PVA_FF_UNICODE_STRING_PARAM baseFileName)
+{
+    if (!_oMovieFragmentEnabled || _oComposeMoofAtom)
+    {
+        // Only in movie fragment mode, before the first fragment is started
+        return false;
+    }
+    _segmentFileBaseName = baseFileName;
+    _oRollingSegmentFiles = (baseFileName.get_size() > 0);
     return true;
 }
 
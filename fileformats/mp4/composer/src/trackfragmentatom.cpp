@@ -43,7 +43,6 @@ PVA_FF_TrackFragmentAtom::PVA_FF_TrackFragmentAtom(uint32 mediaType,
     _prevTS = 0;
     _interleaveDuration = interleaveDuration;
     _fragmentDuration = 0;
-    _ofirstTrun = true;
 
     // intialise track fragment header atom
     PV_MP4_FF_NEW(fp->auditCB, PVA_FF_TrackFragmentHeaderAtom, (trackId), _pTfhdAtom);
@@ -106,21 +105,11 @@ PVA_FF_TrackFragmentAtom::addSampleToFragment(uint32 size, uint32 ts, uint8 flag
     }
     else
     {
-        // make new trun
+        // make new trun, offset is within the mdat payload until the
+        // fragment is rendered (see setMovieFragmentOffset)
         PVA_FF_TrackFragmentRunAtom*    pTrunAtom = addTrackRun();
 
-        if (_ofirstTrun)
-        {
-            _ofirstTrun = false;
-            setTrackFragmentBaseDataOffset(baseOffset);
-            pTrunAtom->setDataOffset(0);
-        }
-        else
-        {
-            uint32 offset = _pTfhdAtom->getBaseDataOffset();
-
-            pTrunAtom->setDataOffset(baseOffset - offset);
-        }
+        pTrunAtom->setDataOffset(baseOffset);
         pTrunAtom->addSample(size, ts, flags);
     }
 
@@ -159,6 +148,21 @@ PVA_FF_TrackFragmentAtom::setTrackFragmentBaseDataOffset(uint64 offset)
 }
 
 
+// make the data offsets relative to the start of the moof: base data offset
+// is the moof offset and each trun is moved by the start of the mdat payload
+void
+PVA_FF_TrackFragmentAtom::setMovieFragmentOffset(uint64 moofOffset, uint32 mediaDataOffset)
+{
+    setTrackFragmentBaseDataOffset(moofOffset);
+
+    for (uint32 ii = 0; ii < _pTrunList->size(); ii++)
+    {
+        PVA_FF_TrackFragmentRunAtom* pTrunAtom = (*_pTrunList)[ii];
+        pTrunAtom->setDataOffset(pTrunAtom->getDataOffset() + mediaDataOffset);
+    }
+}
+
+
 // recompute size of atom
 void
 PVA_FF_TrackFragmentAtom::recomputeSize()
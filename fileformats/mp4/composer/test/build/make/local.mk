@@ -0,0 +1,23 @@
+# Get the current local path as the first operation
+LOCAL_PATH := $(call get_makefile_dir)
+
+# Clear out the variables used in the local makefiles
+include $(MK)/clear.mk
+
+TARGET := test_mp4_movie_fragments
+
+
+XCXXFLAGS += $(FLAG_COMPILE_WARNINGS_AS_ERRORS)
+
+XINCDIRS += ../../../include ../../../config/opencore
+
+SRCDIR := ../../src
+INCSRCDIR := ../../src
+
+SRCS := test_mp4_movie_fragments.cpp
+
+LIBS := opencore_author opencore_common
+
+SYSLIBS += $(SYS_THREAD_LIB)
+
+include $(MK)/prog.mk
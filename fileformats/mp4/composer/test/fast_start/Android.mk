@@ -0,0 +1,32 @@
+LOCAL_PATH := $(call my-dir)
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES := \
+ 	src/test_mp4_fast_start.cpp
+
+
+LOCAL_MODULE := test_mp4_fast_start
+
+LOCAL_CFLAGS :=  $(PV_CFLAGS)
+
+
+
+LOCAL_STATIC_LIBRARIES :=  
+
+LOCAL_SHARED_LIBRARIES := libopencore_author libopencore_common
+
+LOCAL_C_INCLUDES := \
+	$(PV_TOP)/fileformats/mp4/composer/test/fast_start/src \
+ 	$(PV_TOP)/fileformats/mp4/composer/test/fast_start/src \
+ 	$(PV_TOP)/fileformats/mp4/composer/include \
+ 	$(PV_TOP)/fileformats/mp4/composer/config/opencore \
+ 	$(PV_INCLUDES)
+
+LOCAL_COPY_HEADERS_TO := $(PV_COPY_HEADERS_TO)
+
+LOCAL_COPY_HEADERS := \
+ 	
+
+-include $(PV_TOP)/Android_system_extras.mk
+
+include $(BUILD_EXECUTABLE)
@@ -0,0 +1,318 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+// Checks the fast start layout written by the composer: the moov goes into
+// the space reserved ahead of the mdat when the expected sample count covers
+// the clip, and after the mdat when it does not. In both cases the chunk
+// offsets point at the samples.
+
+#include "stdio.h"
+#include "oscl_base.h"
+#include "oscl_mem.h"
+#include "oscl_error.h"
+#include "oscl_file_io.h"
+#include "oscl_vector.h"
+#include "a_impeg4file.h"
+
+#define TEST_FILE           _STRLIT_WCHAR("test_mp4_fast_start.mp4")
+#define TEST_NUM_SAMPLES    3000
+#define TEST_SAMPLE_MS      64
+
+static uint32 ReadUint32(const uint8* aPtr)
+{
+    return ((uint32)aPtr[0] << 24) | ((uint32)aPtr[1] << 16) | ((uint32)aPtr[2] << 8) | aPtr[3];
+}
+
+static uint32 BoxType(const char* aType)
+{
+    return ReadUint32((const uint8*)aType);
+}
+
+// Sample i starts with its index, followed by a pattern, so the data a
+// chunk offset points at can be matched to the sample it describes.
+static uint32 SampleSize(uint32 aIndex)
+{
+    return 100 + (aIndex % 50);
+}
+
+static void MakeSample(uint32 aIndex, uint8* aBuf)
+{
+    aBuf[0] = (uint8)(aIndex >> 24);
+    aBuf[1] = (uint8)(aIndex >> 16);
+    aBuf[2] = (uint8)(aIndex >> 8);
+    aBuf[3] = (uint8)aIndex;
+    for (uint32 i = 4; i < SampleSize(aIndex); i++)
+    {
+        aBuf[i] = (uint8)(aIndex + i);
+    }
+}
+
+static bool CheckSample(uint32 aIndex, const uint8* aData, uint32 aSize)
+{
+    if (aSize != SampleSize(aIndex))
+    {
+        printf("  sample %d has size %d\n", aIndex, aSize);
+        return false;
+    }
+    uint8 expected[256];
+    MakeSample(aIndex, expected);
+    if (oscl_memcmp(expected, aData, aSize) != 0)
+    {
+        printf("  sample %d data differs\n", aIndex);
+        return false;
+    }
+    return true;
+}
+
+static bool AuthorFile(Oscl_FileServer& aFs, uint32 aExpectedSampleCount)
+{
+    PVA_FF_UNICODE_HEAP_STRING fileName(TEST_FILE);
+    PVA_FF_IMpeg4File* mp4 = PVA_FF_IMpeg4File::createMP4File(FILE_TYPE_AUDIO,
+                             PVA_FF_UNICODE_HEAP_STRING(_STRLIT_WCHAR("")),
+                             PVA_FF_UNICODE_HEAP_STRING(_STRLIT_WCHAR("test")), (void*)&aFs,
+                             PVMP4FF_3GPP_FAST_START_MODE, fileName);
+    if (mp4 == NULL)
+    {
+        printf("  can't create the composer\n");
+        return false;
+    }
+    if (!mp4->setExpectedSampleCount(aExpectedSampleCount))
+    {
+        printf("  expected sample count not taken\n");
+        PVA_FF_IMpeg4File::DestroyMP4FileObject(mp4);
+        return false;
+    }
+
+    uint32 trackId = mp4->addTrack(MEDIA_TYPE_AUDIO, CODEC_TYPE_AAC_AUDIO);
+    mp4->setTargetBitrate(trackId, 32000);
+    mp4->setTimeScale(trackId, 1000);
+    PVMP4FFComposerAudioEncodeParams audioParams;
+    audioParams.numberOfChannels = 1;
+    audioParams.samplingRate = 16000;
+    audioParams.bitsPerSample = 16;
+    mp4->setAudioEncodeParams(trackId, audioParams);
+    uint8 config[2] = {0x14, 0x08};
+    mp4->setDecoderSpecificInfo(config, sizeof(config), trackId);
+
+    bool ok = mp4->prepareToEncode();
+    // too late once the space is reserved
+    ok = ok && !mp4->setExpectedSampleCount(aExpectedSampleCount);
+    uint8 sample[256];
+    for (uint32 i = 0; i < TEST_NUM_SAMPLES && ok; i++)
+    {
+        MakeSample(i, sample);
+        Oscl_Vector<OsclMemoryFragment, OsclMemAllocator> fragments;
+        OsclMemoryFragment fragment;
+        fragment.ptr = sample;
+        fragment.len = SampleSize(i);
+        fragments.push_back(fragment);
+        ok = mp4->addSampleToTrack(trackId, fragments, i * TEST_SAMPLE_MS, 0);
+    }
+    if (ok)
+    {
+        ok = mp4->renderToFile(fileName);
+    }
+    if (!ok)
+    {
+        printf("  authoring failed\n");
+    }
+    PVA_FF_IMpeg4File::DestroyMP4FileObject(mp4);
+    return ok;
+}
+
+static uint8* ReadFile(Oscl_FileServer& aFs, uint32& aSize)
+{
+    Oscl_File file;
+    if (file.Open(TEST_FILE, Oscl_File::MODE_READ | Oscl_File::MODE_BINARY, aFs) != 0)
+    {
+        printf("  can't open the output file\n");
+        return NULL;
+    }
+    aSize = (uint32)file.Size();
+    uint8* data = (uint8*)oscl_malloc(aSize);
+    if (data != NULL && file.Read(data, 1, aSize) != aSize)
+    {
+        oscl_free(data);
+        data = NULL;
+    }
+    file.Close();
+    return data;
+}
+
+// Returns the offset of the first aType box between aStart and aEnd, 0 if none.
+static uint32 FindBox(const uint8* aData, uint32 aStart, uint32 aEnd, const char* aType)
+{
+    uint32 offset = aStart;
+    while (offset + 8 <= aEnd)
+    {
+        uint32 boxSize = ReadUint32(aData + offset);
+        if (ReadUint32(aData + offset + 4) == BoxType(aType))
+        {
+            return offset;
+        }
+        if (boxSize < 8)
+        {
+            break;
+        }
+        offset += boxSize;
+    }
+    return 0;
+}
+
+// Walks the sample table of the only track and checks each sample at the
+// offset its chunk offset and the sizes before it in the chunk give.
+static bool CheckSampleTable(const uint8* aData, uint32 aSize, uint32 aMoovOffset)
+{
+    uint32 box = aMoovOffset;
+    const char* path[] = {"trak", "mdia", "minf", "stbl"};
+    for (uint32 i = 0; i < sizeof(path) / sizeof(path[0]) && box != 0; i++)
+    {
+        box = FindBox(aData, box + 8, box + ReadUint32(aData + box), path[i]);
+    }
+    if (box == 0)
+    {
+        printf("  no sample table\n");
+        return false;
+    }
+    uint32 stblEnd = box + ReadUint32(aData + box);
+    uint32 stsz = FindBox(aData, box + 8, stblEnd, "stsz");
+    uint32 stsc = FindBox(aData, box + 8, stblEnd, "stsc");
+    uint32 stco = FindBox(aData, box + 8, stblEnd, "stco");
+    if (stsz == 0 || stsc == 0 || stco == 0)
+    {
+        printf("  incomplete sample table\n");
+        return false;
+    }
+
+    uint32 numSamples = ReadUint32(aData + stsz + 16);
+    uint32 numStscEntries = ReadUint32(aData + stsc + 12);
+    uint32 numChunks = ReadUint32(aData + stco + 12);
+    if (numSamples != TEST_NUM_SAMPLES || ReadUint32(aData + stsz + 12) != 0)
+    {
+        printf("  %d samples in stsz\n", numSamples);
+        return false;
+    }
+
+    uint32 sample = 0;
+    uint32 stscEntry = 0;
+    for (uint32 chunk = 1; chunk <= numChunks; chunk++)
+    {
+        // stsc entries: first chunk, samples per chunk, sample description index
+        while (stscEntry + 1 < numStscEntries &&
+                ReadUint32(aData + stsc + 16 + (stscEntry + 1) * 12) <= chunk)
+        {
+            stscEntry++;
+        }
+        uint32 samplesPerChunk = ReadUint32(aData + stsc + 16 + stscEntry * 12 + 4);
+        uint32 offset = ReadUint32(aData + stco + 16 + (chunk - 1) * 4);
+        for (uint32 i = 0; i < samplesPerChunk && sample < numSamples; i++)
+        {
+            uint32 size = ReadUint32(aData + stsz + 20 + sample * 4);
+            if (offset + size > aSize || !CheckSample(sample, aData + offset, size))
+            {
+                return false;
+            }
+            offset += size;
+            sample++;
+        }
+    }
+    if (sample != numSamples)
+    {
+        printf("  chunks cover %d of %d samples\n", sample, numSamples);
+        return false;
+    }
+    return true;
+}
+
+// Authors the clip and checks that its top level boxes come in aOrder.
+static bool TestLayout(Oscl_FileServer& aFs, uint32 aExpectedSampleCount, const char* const* aOrder, uint32 aNumBoxes)
+{
+    if (!AuthorFile(aFs, aExpectedSampleCount))
+    {
+        return false;
+    }
+    uint32 size = 0;
+    uint8* data = ReadFile(aFs, size);
+    if (data == NULL)
+    {
+        return false;
+    }
+
+    bool ok = true;
+    uint32 offset = 0;
+    uint32 moovOffset = 0;
+    uint32 numBoxes = 0;
+    while (ok && offset + 8 <= size)
+    {
+        uint32 boxSize = ReadUint32(data + offset);
+        uint32 type = ReadUint32(data + offset + 4);
+        if (numBoxes >= aNumBoxes || type != BoxType(aOrder[numBoxes]))
+        {
+            printf("  unexpected box %d at %d\n", numBoxes, offset);
+            ok = false;
+            break;
+        }
+        if (type == BoxType("moov"))
+        {
+            moovOffset = offset;
+        }
+        numBoxes++;
+        if (boxSize < 8)
+        {
+            break;
+        }
+        offset += boxSize;
+    }
+    ok = ok && (offset == size) && (numBoxes == aNumBoxes);
+    ok = ok && CheckSampleTable(data, size, moovOffset);
+
+    oscl_free(data);
+    aFs.Oscl_DeleteFile(TEST_FILE);
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    OSCL_UNUSED_ARG(argc);
+    OSCL_UNUSED_ARG(argv);
+
+    OsclBase::Init();
+    OsclErrorTrap::Init();
+    OsclMem::Init();
+
+    uint32 failures = 0;
+
+    Oscl_FileServer fs;
+    fs.Connect();
+
+    const char* const upfront[] = {"ftyp", "moov", "skip", "mdat"};
+    bool ok = TestLayout(fs, TEST_NUM_SAMPLES, upfront, sizeof(upfront) / sizeof(upfront[0]));
+    printf("moov in the reserved space: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    const char* const fallback[] = {"ftyp", "skip", "mdat", "moov"};
+    ok = TestLayout(fs, 0, fallback, sizeof(fallback) / sizeof(fallback[0]));
+    printf("moov after mdat when the reserved space is too small: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    fs.Close();
+
+    OsclMem::Cleanup();
+    OsclErrorTrap::Cleanup();
+    OsclBase::Cleanup();
+    return (failures == 0) ? 0 : 1;
+}
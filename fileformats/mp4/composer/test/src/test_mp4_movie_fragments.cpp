@@ -0,0 +1,446 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+// Checks the movie fragment layout written by the composer: each moof is
+// followed by its mdat, the track fragment base data offset is the moof
+// offset and the track runs point at the samples in that mdat, both in one
+// output file and with a segment file per fragment.
+
+#include "stdio.h"
+#include "oscl_base.h"
+#include "oscl_mem.h"
+#include "oscl_error.h"
+#include "oscl_file_io.h"
+#include "oscl_vector.h"
+#include "a_impeg4file.h"
+
+#define TEST_FILE           _STRLIT_WCHAR("test_mp4_movie_fragments.mp4")
+#define TEST_SEGMENT_BASE   _STRLIT_WCHAR("test_mp4_movie_fragments_")
+#define TEST_NUM_SAMPLES    200
+#define TEST_SAMPLE_MS      64
+#define TEST_FRAGMENT_MS    1000
+#define TEST_MAX_SEGMENTS   64
+
+static uint32 ReadUint32(const uint8* aPtr)
+{
+    return ((uint32)aPtr[0] << 24) | ((uint32)aPtr[1] << 16) | ((uint32)aPtr[2] << 8) | aPtr[3];
+}
+
+static uint32 BoxType(const char* aType)
+{
+    return ReadUint32((const uint8*)aType);
+}
+
+// Sample i starts with its index, followed by a pattern, so the data a
+// track run points at can be matched to the sample it describes.
+static uint32 SampleSize(uint32 aIndex)
+{
+    return 100 + (aIndex % 50);
+}
+
+static void MakeSample(uint32 aIndex, uint8* aBuf)
+{
+    aBuf[0] = (uint8)(aIndex >> 24);
+    aBuf[1] = (uint8)(aIndex >> 16);
+    aBuf[2] = (uint8)(aIndex >> 8);
+    aBuf[3] = (uint8)aIndex;
+    for (uint32 i = 4; i < SampleSize(aIndex); i++)
+    {
+        aBuf[i] = (uint8)(aIndex + i);
+    }
+}
+
+static bool CheckSample(uint32 aIndex, const uint8* aData, uint32 aSize)
+{
+    if (aSize != SampleSize(aIndex))
+    {
+        printf("  sample %d has size %d\n", aIndex, aSize);
+        return false;
+    }
+    uint8 expected[256];
+    MakeSample(aIndex, expected);
+    if (oscl_memcmp(expected, aData, aSize) != 0)
+    {
+        printf("  sample %d data differs\n", aIndex);
+        return false;
+    }
+    return true;
+}
+
+class TestSegmentObserver : public PVA_FF_MovieFragmentSegmentObserver
+{
+    public:
+        TestSegmentObserver(): iNumSegments(0) {}
+
+        void MovieFragmentSegmentReady(uint32 aSequenceNumber,
+                                       PVA_FF_UNICODE_STRING_PARAM aFileName,
+                                       uint32 aOffset,
+                                       uint32 aSize)
+        {
+            if (iNumSegments < TEST_MAX_SEGMENTS)
+            {
+                iSequenceNumber[iNumSegments] = aSequenceNumber;
+                iFileName[iNumSegments] = aFileName;
+                iOffset[iNumSegments] = aOffset;
+                iSize[iNumSegments] = aSize;
+            }
+            iNumSegments++;
+        }
+
+        uint32 iNumSegments;
+        uint32 iSequenceNumber[TEST_MAX_SEGMENTS];
+        PVA_FF_UNICODE_HEAP_STRING iFileName[TEST_MAX_SEGMENTS];
+        uint32 iOffset[TEST_MAX_SEGMENTS];
+        uint32 iSize[TEST_MAX_SEGMENTS];
+};
+
+static bool AuthorFile(Oscl_FileServer& aFs, TestSegmentObserver* aObserver)
+{
+    PVA_FF_UNICODE_HEAP_STRING fileName(TEST_FILE);
+    PVA_FF_IMpeg4File* mp4 = PVA_FF_IMpeg4File::createMP4File(FILE_TYPE_AUDIO,
+                             PVA_FF_UNICODE_HEAP_STRING(_STRLIT_WCHAR("")),
+                             PVA_FF_UNICODE_HEAP_STRING(_STRLIT_WCHAR("test")), (void*)&aFs,
+                             PVMP4FF_MOVIE_FRAGMENT_MODE, fileName);
+    if (mp4 == NULL)
+    {
+        printf("  can't create the composer\n");
+        return false;
+    }
+    mp4->setMovieFragmentDuration(TEST_FRAGMENT_MS);
+    if (aObserver)
+    {
+        mp4->setMovieFragmentSegmentObserver(aObserver);
+        if (!mp4->setMovieFragmentSegmentFileName(PVA_FF_UNICODE_HEAP_STRING(TEST_SEGMENT_BASE)))
+        {
+            printf("  can't set the segment file name\n");
+            PVA_FF_IMpeg4File::DestroyMP4FileObject(mp4);
+            return false;
+        }
+    }
+
+    uint32 trackId = mp4->addTrack(MEDIA_TYPE_AUDIO, CODEC_TYPE_AAC_AUDIO);
+    mp4->setTargetBitrate(trackId, 32000);
+    mp4->setTimeScale(trackId, 1000);
+    PVMP4FFComposerAudioEncodeParams audioParams;
+    audioParams.numberOfChannels = 1;
+    audioParams.samplingRate = 16000;
+    audioParams.bitsPerSample = 16;
+    mp4->setAudioEncodeParams(trackId, audioParams);
+    uint8 config[2] = {0x14, 0x08};
+    mp4->setDecoderSpecificInfo(config, sizeof(config), trackId);
+
+    bool ok = mp4->prepareToEncode();
+    uint8 sample[256];
+    for (uint32 i = 0; i < TEST_NUM_SAMPLES && ok; i++)
+    {
+        MakeSample(i, sample);
+        Oscl_Vector<OsclMemoryFragment, OsclMemAllocator> fragments;
+        OsclMemoryFragment fragment;
+        fragment.ptr = sample;
+        fragment.len = SampleSize(i);
+        fragments.push_back(fragment);
+        ok = mp4->addSampleToTrack(trackId, fragments, i * TEST_SAMPLE_MS, 0);
+    }
+    if (ok)
+    {
+        ok = mp4->renderToFile(fileName);
+    }
+    if (!ok)
+    {
+        printf("  authoring failed\n");
+    }
+    PVA_FF_IMpeg4File::DestroyMP4FileObject(mp4);
+    return ok;
+}
+
+static uint8* ReadFile(Oscl_FileServer& aFs, PVA_FF_UNICODE_STRING_PARAM aName, uint32& aSize)
+{
+    Oscl_File file;
+    if (file.Open(aName.get_cstr(), Oscl_File::MODE_READ | Oscl_File::MODE_BINARY, aFs) != 0)
+    {
+        printf("  can't open an output file\n");
+        return NULL;
+    }
+    aSize = (uint32)file.Size();
+    uint8* data = (uint8*)oscl_malloc(aSize);
+    if (data != NULL && file.Read(data, 1, aSize) != aSize)
+    {
+        oscl_free(data);
+        data = NULL;
+    }
+    file.Close();
+    return data;
+}
+
+// Checks the moof at aMoofOffset and the mdat after it.  aBaseOffset is what
+// the tfhd base data offset must be.  aNextSample is the index of the first
+// sample expected in the fragment and is moved past its samples.  Returns
+// the size of the moof and mdat, 0 on error.
+static uint32 CheckFragment(const uint8* aData, uint32 aSize, uint32 aMoofOffset,
+                            uint32 aBaseOffset, uint32& aNextSample)
+{
+    const uint8* moof = aData + aMoofOffset;
+    uint32 moofSize = ReadUint32(moof);
+    if (aMoofOffset + moofSize + 8 > aSize || ReadUint32(moof + 4) != BoxType("moof"))
+    {
+        printf("  no moof at %d\n", aMoofOffset);
+        return 0;
+    }
+    uint32 mdatOffset = aMoofOffset + moofSize;
+    uint32 mdatSize = ReadUint32(aData + mdatOffset);
+    if (ReadUint32(aData + mdatOffset + 4) != BoxType("mdat") || mdatOffset + mdatSize > aSize)
+    {
+        printf("  moof at %d not followed by its mdat\n", aMoofOffset);
+        return 0;
+    }
+
+    uint32 dataEnd = mdatOffset + 8;
+    for (uint32 box = 8; box < moofSize; box += ReadUint32(moof + box))
+    {
+        if (ReadUint32(moof + box + 4) != BoxType("traf"))
+        {
+            continue;
+        }
+        const uint8* traf = moof + box;
+        uint32 trafSize = ReadUint32(traf);
+        uint64 base = 0;
+        for (uint32 child = 8; child < trafSize; child += ReadUint32(traf + child))
+        {
+            const uint8* atom = traf + child;
+            if (ReadUint32(atom + 4) == BoxType("tfhd"))
+            {
+                // flags 0x1: base data offset after the track id
+                base = ((uint64)ReadUint32(atom + 16) << 32) | ReadUint32(atom + 20);
+                if (!(ReadUint32(atom + 8) & 0x1) || base != aBaseOffset)
+                {
+                    printf("  moof at %d has base data offset %d\n", aMoofOffset, (uint32)base);
+                    return 0;
+                }
+            }
+            else if (ReadUint32(atom + 4) == BoxType("trun"))
+            {
+                // flags 0x701: data offset, then duration, size and flags per sample
+                uint32 count = ReadUint32(atom + 12);
+                uint32 sampleOffset = aMoofOffset + ReadUint32(atom + 16);
+                if (sampleOffset != dataEnd)
+                {
+                    printf("  trun data at %d, expected %d\n", sampleOffset, dataEnd);
+                    return 0;
+                }
+                for (uint32 i = 0; i < count; i++)
+                {
+                    uint32 size = ReadUint32(atom + 20 + i * 12 + 4);
+                    if (sampleOffset + size > mdatOffset + mdatSize ||
+                            !CheckSample(aNextSample, aData + sampleOffset, size))
+                    {
+                        return 0;
+                    }
+                    sampleOffset += size;
+                    aNextSample++;
+                }
+                dataEnd = sampleOffset;
+            }
+        }
+    }
+    if (dataEnd != mdatOffset + mdatSize)
+    {
+        printf("  mdat at %d has %d bytes no trun points at\n", mdatOffset, mdatOffset + mdatSize - dataEnd);
+        return 0;
+    }
+    return moofSize + mdatSize;
+}
+
+// Counts the samples in the mdat before the first moof, described by the moov.
+static uint32 CountMoovSamples(const uint8* aData, uint32 aMdatOffset)
+{
+    uint32 mdatSize = ReadUint32(aData + aMdatOffset);
+    uint32 offset = aMdatOffset + 8;
+    uint32 index = 0;
+    while (offset < aMdatOffset + mdatSize)
+    {
+        offset += SampleSize(index++);
+    }
+    return index;
+}
+
+// One output file: ftyp, moov, mdat, then moof and mdat pairs, then mfra
+// pointing at each moof.
+static bool TestSingleFile(Oscl_FileServer& aFs)
+{
+    if (!AuthorFile(aFs, NULL))
+    {
+        return false;
+    }
+    uint32 size = 0;
+    uint8* data = ReadFile(aFs, PVA_FF_UNICODE_HEAP_STRING(TEST_FILE), size);
+    if (data == NULL)
+    {
+        return false;
+    }
+
+    bool ok = true;
+    uint32 offset = 0;
+    uint32 nextSample = 0;
+    uint32 numFragments = 0;
+    uint32 moofOffsets[TEST_MAX_SEGMENTS];
+    while (ok && offset + 8 <= size)
+    {
+        uint32 boxSize = ReadUint32(data + offset);
+        uint32 type = ReadUint32(data + offset + 4);
+        if (type == BoxType("moof"))
+        {
+            if (numFragments < TEST_MAX_SEGMENTS)
+            {
+                moofOffsets[numFragments] = offset;
+            }
+            numFragments++;
+            boxSize = CheckFragment(data, size, offset, offset, nextSample);
+            ok = (boxSize > 0);
+        }
+        else if (type == BoxType("mdat"))
+        {
+            // only the media described by the moov precedes the fragments
+            if (numFragments > 0 || nextSample > 0)
+            {
+                printf("  mdat at %d without a moof\n", offset);
+                ok = false;
+            }
+            nextSample = CountMoovSamples(data, offset);
+        }
+        else if (type == BoxType("mfra"))
+        {
+            // tfra entries: time, moof offset, traf, trun and sample numbers
+            const uint8* tfra = data + offset + 8;
+            uint32 entries = ReadUint32(tfra + 20);
+            for (uint32 i = 0; i < entries && ok; i++)
+            {
+                uint32 moofOffset = ReadUint32(tfra + 24 + i * 14 + 4);
+                if (moofOffset + 8 > size || ReadUint32(data + moofOffset + 4) != BoxType("moof"))
+                {
+                    printf("  mfra entry %d points at %d, not a moof\n", i, moofOffset);
+                    ok = false;
+                }
+            }
+        }
+        if (boxSize < 8)
+        {
+            break;
+        }
+        offset += boxSize;
+    }
+    ok = ok && (offset == size);
+    if (ok && (numFragments < 2 || nextSample != TEST_NUM_SAMPLES))
+    {
+        printf("  %d fragments, %d samples\n", numFragments, nextSample);
+        ok = false;
+    }
+    oscl_free(data);
+    aFs.Oscl_DeleteFile(TEST_FILE);
+    return ok;
+}
+
+// A segment file per fragment: each one is a moof at offset 0 with its
+// data offsets relative to that file, followed by its mdat.
+static bool TestSegmentFiles(Oscl_FileServer& aFs)
+{
+    TestSegmentObserver observer;
+    if (!AuthorFile(aFs, &observer))
+    {
+        return false;
+    }
+    bool ok = (observer.iNumSegments >= 3 && observer.iNumSegments <= TEST_MAX_SEGMENTS);
+    if (!ok)
+    {
+        printf("  %d segments\n", observer.iNumSegments);
+    }
+
+    uint32 nextSample = 0;
+    for (uint32 i = 0; i < observer.iNumSegments && ok; i++)
+    {
+        uint32 size = 0;
+        uint8* data = ReadFile(aFs, observer.iFileName[i], size);
+        if (data == NULL)
+        {
+            ok = false;
+            break;
+        }
+        if (observer.iSequenceNumber[i] == 0)
+        {
+            // initialization segment: ftyp, moov and the media before the first fragment
+            ok = (observer.iOffset[i] == 0) && (ReadUint32(data + 4) == BoxType("ftyp"));
+            uint32 offset = 0;
+            while (ok && offset + 8 <= observer.iSize[i])
+            {
+                if (ReadUint32(data + offset + 4) == BoxType("mdat"))
+                {
+                    nextSample = CountMoovSamples(data, offset);
+                }
+                offset += ReadUint32(data + offset);
+            }
+        }
+        else
+        {
+            ok = (observer.iSequenceNumber[i] == observer.iSequenceNumber[i - 1] + 1) &&
+                 (observer.iOffset[i] == 0) &&
+                 (CheckFragment(data, size, 0, 0, nextSample) == observer.iSize[i]) &&
+                 (observer.iSize[i] == size);
+            aFs.Oscl_DeleteFile(observer.iFileName[i].get_cstr());
+        }
+        if (!ok)
+        {
+            printf("  segment %d is wrong\n", observer.iSequenceNumber[i]);
+        }
+        oscl_free(data);
+    }
+    if (ok && nextSample != TEST_NUM_SAMPLES)
+    {
+        printf("  %d samples in the segments\n", nextSample);
+        ok = false;
+    }
+    aFs.Oscl_DeleteFile(TEST_FILE);
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    OSCL_UNUSED_ARG(argc);
+    OSCL_UNUSED_ARG(argv);
+
+    OsclBase::Init();
+    OsclErrorTrap::Init();
+    OsclMem::Init();
+
+    uint32 failures = 0;
+
+    Oscl_FileServer fs;
+    fs.Connect();
+
+    bool ok = TestSingleFile(fs);
+    printf("moof before mdat in one file: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    ok = TestSegmentFiles(fs);
+    printf("moof before mdat in segment files: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    fs.Close();
+
+    OsclMem::Cleanup();
+    OsclErrorTrap::Cleanup();
+    OsclBase::Cleanup();
+    return (failures == 0) ? 0 : 1;
+}
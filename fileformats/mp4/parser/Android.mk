@@ -65,6 +65,7 @@ LOCAL_SRC_FILES := \
  	src/movieextendsatom.cpp \
  	src/mfraoffsetatom.cpp \
  	src/moviefragmentrandomaccess.cpp \
+ 	src/moviefragmentindex.cpp \
  	src/objectdescriptor.cpp \
  	src/objectdescriptoratom.cpp \
  	src/oma2boxes.cpp \
@@ -81,6 +81,7 @@ SRCS := 3gpp_amrdecoderspecificinfo.cpp \
 	movieextendsatom.cpp \
 	mfraoffsetatom.cpp \
 	moviefragmentrandomaccess.cpp \
+	moviefragmentindex.cpp \
 	objectdescriptor.cpp \
 	objectdescriptoratom.cpp \
 	oma2boxes.cpp \
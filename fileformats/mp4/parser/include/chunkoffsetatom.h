@@ -55,6 +55,7 @@ class ChunkOffsetAtom : public FullAtom
 
     private:
         bool ParseEntryUnit(uint32 sample_cnt);
+        bool AreOffsetsSorted();
         uint32 _entryCount;
         uint32 *_pchunkOffsets;
 
@@ -71,6 +72,10 @@ class ChunkOffsetAtom : public FullAtom
         uint32 _next_buff_number;
         uint32 _parsingMode;
 
+        // Fully parsed tables whose offsets never decrease (the usual layout)
+        // are searched with a binary search. Checked once, on first use.
+        bool _offsetsOrderChecked;
+        bool _offsetsSorted;
 };
 
 #endif // CHUNKOFFSETATOM_H_INCLUDED
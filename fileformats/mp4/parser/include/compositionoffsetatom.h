@@ -92,6 +92,9 @@ class CompositionOffsetAtom : public FullAtom,
     private:
         bool ParseEntryUnit(uint32 entry_cnt);
         void CheckAndParseEntry(uint32 i);
+        bool BuildCumulativeIndex();
+        void DeleteCumulativeIndex();
+        uint32 FindEntryForSampleNumber(uint32 num);
         // from OsclTimerObject
         void Run();
         uint32 _entryCount;
@@ -112,6 +115,13 @@ class CompositionOffsetAtom : public FullAtom,
         uint32 refSample;
         uint32 MT_j;
 
+        // Cumulative index, built on first random access of a fully parsed
+        // table. Entry i holds the first sample number of ctts entry i; entry
+        // _entryCount holds the total. Large partially parsed tables use the
+        // marker table instead.
+        uint32 *_pcumSampleVec;
+        bool _cum_index_disabled;
+
         uint32 _mediaType;
 
         // For visual samples
@@ -71,6 +71,7 @@
 #include "pv_id3_parcom_types.h"
 
 class OsclFileHandle;
+class OsclRefCounter;
 class PvmiDataStreamObserver;
 class AVCSampleEntry;
 /*------------- Interface of Class Mpeg4 File ----------------*/
@@ -191,7 +192,8 @@ class IMpeg4File : public ISucceedFail
                 PVMFCPMPluginAccessInterfaceFactory* aCPMAccessFactory,
                 OsclFileHandle* aHandle = NULL,
                 uint32 aParsingMode = 0,
-                Oscl_FileServer* aFileServSession = NULL);
+                Oscl_FileServer* aFileServSession = NULL,
+                bool aMapFile = false);
 
         OSCL_IMPORT_REF static void DestroyMP4FileObject(IMpeg4File* aMP4FileObject);
 
@@ -216,6 +218,24 @@ class IMpeg4File : public ISucceedFail
                                                 uint32 *n,
                                                 GAU    *pgau) = 0;
 
+        /**
+         * Switches a track to zero-copy sample retrieval.  After a
+         * successful call, getNextBundledAccessUnits ignores the buffers
+         * passed in the GAU and instead sets buf.fragments to point at
+         * the sample data inside a read-only mapping of the file; samples
+         * of one call are spread over at most MAX_NUM_FRAGMENTS fragments.
+         *
+         * Only available if the file was opened with aMapFile set in
+         * readMP4File, the platform supports mapping, the source is a
+         * plain local file and no movie fragments are present.
+         *
+         * @param id track ID
+         * @return reference counter of the mapping, to be addRef'ed by
+         * every holder of a fragment that outlives the parser, or NULL
+         * if mapped access is not available.
+         */
+        virtual OsclRefCounter* enableMappedSampleAccess(const uint32 id) = 0;
+
         virtual int32 peekNextBundledAccessUnits(const uint32 id,
                 uint32 *n,
                 MediaMetaInfo *mInfo) = 0;
@@ -321,12 +341,18 @@ class IMpeg4File : public ISucceedFail
          * downloadable then this API also returns the meta data size. Player
          * needs to wait for the file to grow past the metaDataSize before
          * starting playback.This param is valid only if oIsProgressiveDownloadable
-         * is set to TRUE.
+         * is set to TRUE. Otherwise it is the file offset right after the media
+         * data atom, where a movie atom at the end of the clip starts.
          *
          * @return MP4_ERROR_CODE - EVERYTHING_FINE, if a conclusion is reached
          * either way on whether a clip is progressive downloadable or not.
          * INSUFFICIENT_DATA, if more calls to this API are needed to reach a
          * decision
+         * MOVIE_ATOM_AFTER_MEDIA_DATA, if the datastream is progressive streaming
+         * and a complete media data atom was parsed before any movie atom;
+         * metaDataSize is then the offset right after the media data atom.
+         * NOT_PROGRESSIVE_STREAMABLE, if the datastream is progressive streaming
+         * and no movie atom has been found otherwise.
          * Any other return value indicates error.
          */
         OSCL_IMPORT_REF static MP4_ERROR_CODE GetMetaDataSize(PVMFCPMPluginAccessInterfaceFactory* aCPMAccessFactory,
@@ -195,7 +195,8 @@ typedef enum {  READ_FAILED = -1,
                 READ_PIXELASPECTRATIO_BOX_FAILED = 151,
 
                 EXCEED_MAX_LIMIT_SUPPORTED_FOR_TOTAL_TRACKS = 157,
-                READ_3GPP2_SPEECH_SAMPLE_ENTRY_FAILED = 158
+                READ_3GPP2_SPEECH_SAMPLE_ENTRY_FAILED = 158,
+                MOVIE_ATOM_AFTER_MEDIA_DATA = 159
 
              } MP4_ERROR_CODE;
 
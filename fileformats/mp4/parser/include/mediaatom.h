@@ -562,6 +562,15 @@ class MediaAtom : public Atom
             }
         }
 
+        bool setMappedFileBuffer(const uint8* aBase, uint32 aSize)
+        {
+            if (_pmediaInformation != NULL)
+            {
+                return _pmediaInformation->setMappedFileBuffer(aBase, aSize);
+            }
+            return false;
+        }
+
         int32 getNextBundledAccessUnits(uint32 *n,
                                         GAU    *pgau)
         {
@@ -529,6 +529,16 @@ class MediaInformationAtom : public Atom
             }
         }
 
+        bool setMappedFileBuffer(const uint8* aBase, uint32 aSize)
+        {
+            if (_psampleTableAtom != NULL)
+            {
+                _psampleTableAtom->setMappedFileBuffer(aBase, aSize);
+                return true;
+            }
+            return false;
+        }
+
         int32 getNextBundledAccessUnits(uint32 *n,
                                         GAU    *pgau)
         {
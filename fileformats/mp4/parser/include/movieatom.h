@@ -260,6 +260,10 @@ class MovieAtom : public Atom
                                         uint32 *n,
                                         GAU    *pgau);
 
+        bool setMappedFileBuffer(const uint32 trackID,
+                                 const uint8* aBase,
+                                 uint32 aSize);
+
         int32 peekNextBundledAccessUnits(const uint32 trackID,
                                          uint32 *n,
                                          MediaMetaInfo *mInfo);
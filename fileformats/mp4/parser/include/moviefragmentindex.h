@@ -0,0 +1,131 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/*********************************************************************************/
+/*     -------------------------------------------------------------------       */
+/*                            MPEG-4 Movie Fragment Index Class                  */
+/*     -------------------------------------------------------------------       */
+/*********************************************************************************/
+/*
+    The MovieFragmentIndex keeps, per track, one random access entry per movie
+    fragment: the timestamp of the first sync sample of the track in that moof,
+    the moof offset, the traf/trun/sample numbers locating that sample and the
+    number of samples of the track in the moof. Entries are kept sorted by time
+    so repositioning is a binary search instead of a walk over all fragments.
+
+    The index is built from the TFRA atoms when the clip carries an MFRA, or
+    otherwise from a single scan of the moof headers following the movie atom.
+*/
+
+#ifndef MOVIEFRAGMENTINDEX_H_INCLUDED
+#define MOVIEFRAGMENTINDEX_H_INCLUDED
+
+#ifndef ATOMUTILS_H_INCLUDED
+#include "atomutils.h"
+#endif
+
+#ifndef OSCL_VECTOR_H_INCLUDED
+#include "oscl_vector.h"
+#endif
+
+#ifndef PVLOGGER_H_INCLUDED
+#include "pvlogger.h"
+#endif
+
+class MovieFragmentRandomAccessAtom;
+class TrackExtendsAtom;
+
+class MovieFragmentIndexEntry
+{
+    public:
+        uint32 _time;
+        uint32 _moof_offset;
+        uint32 _traf_number;
+        uint32 _trun_number;
+        uint32 _sample_number;
+        // 0 when the entry comes from a TFRA, which does not carry it.
+        uint32 _sample_count;
+};
+
+class MovieFragmentIndexTrack
+{
+    public:
+        MovieFragmentIndexTrack(uint32 trackID, uint32 startTime)
+                : _trackId(trackID), _scanTime(startTime), _scanEntryIdx(-1), _scanSampleCount(0)
+        {
+        }
+
+        uint32 _trackId;
+        Oscl_Vector<MovieFragmentIndexEntry, OsclMemAllocator> _entries;
+
+        // Scan state: decode time of the next sample, plus the entry (if any)
+        // and sample count of the track in the moof currently being scanned.
+        uint32 _scanTime;
+        int32 _scanEntryIdx;
+        uint32 _scanSampleCount;
+};
+
+class MovieFragmentIndex
+{
+    public:
+        MovieFragmentIndex();
+        ~MovieFragmentIndex();
+
+        // Registers a track to be indexed by buildFromMoofScan, whose first
+        // fragment sample starts at aStartTime (the duration in the moov).
+        void addTrack(uint32 aTrackID, uint32 aStartTime);
+
+        bool buildFromTFRA(MovieFragmentRandomAccessAtom *aMfraAtom);
+
+        // Walks the top level atoms from aStartOffset to the end of the file
+        // and indexes every moof. Fails, leaving the index unbuilt, if the
+        // file ends inside an atom (e.g. during progressive download).
+        bool buildFromMoofScan(MP4_FF_FILE *aFilePtr, uint32 aStartOffset,
+                               Oscl_Vector<TrackExtendsAtom*, OsclMemAllocator> *aTrackExtendsAtomVec);
+
+        bool isBuilt() const
+        {
+            return _built;
+        }
+
+        bool hasEntriesForTrack(uint32 aTrackID);
+
+        // Same contract as MovieFragmentRandomAccessAtom::getSyncSampleInfoClosestToTime.
+        int32 getSyncSampleInfoClosestToTime(uint32 trackID, uint32 &time, uint32 &moof_offset,
+                                             uint32 &traf_number, uint32 &trun_number,
+                                             uint32 &sample_num);
+
+        // Same contract as MovieFragmentRandomAccessAtom::queryRepositionTime.
+        int32 queryRepositionTime(uint32 trackID, int32 time, bool bBeforeRequestedTime);
+
+    private:
+        MovieFragmentIndexTrack* getTrack(uint32 aTrackID);
+        void addEntry(MovieFragmentIndexTrack *aTrack, const MovieFragmentIndexEntry &aEntry);
+        uint32 upperBound(MovieFragmentIndexTrack *aTrack, uint32 aTime);
+
+        bool scanMoof(uint8 *aBuf, uint32 aSize, uint32 aMoofOffset,
+                      Oscl_Vector<TrackExtendsAtom*, OsclMemAllocator> *aTrackExtendsAtomVec);
+        bool scanTraf(uint8 *aBuf, uint32 aSize, uint32 aMoofOffset, uint32 aTrafNumber,
+                      Oscl_Vector<TrackExtendsAtom*, OsclMemAllocator> *aTrackExtendsAtomVec);
+
+        Oscl_Vector<MovieFragmentIndexTrack*, OsclMemAllocator> _tracks;
+        bool _built;
+
+        PVLogger *iLogger, *iStateVarLogger, *iParsedDataLogger;
+};
+
+#endif
@@ -65,6 +65,11 @@ class MovieFragmentRandomAccessAtom : public Atom
         *  tracks are equal.
         */
         bool IsTFRAPresentForTrack(uint32 trackID, bool  oVideoAudioTextTrack);
+
+        Oscl_Vector<TrackFragmentRandomAccessAtom*, OsclMemAllocator>* getTrackFragmentRandomAccessAtomVec()
+        {
+            return _pTrackFragmentRandomAccessAtomVec;
+        }
 #if (DISABLE_REPOS_ON_CLIPS_HAVING_UNEQUAL_TFRA_ENTRY_COUNT)
         int32 oVideoAudioTextTrackTfraCount;
 #endif // DISABLE_REPOS_ON_CLIPS_HAVING_UNEQUAL_TFRA_ENTRY_COUNT
@@ -84,6 +84,10 @@
 #include "moviefragmentrandomaccess.h"
 #endif
 
+#ifndef MOVIEFRAGMENTINDEX_H_INCLUDED
+#include "moviefragmentindex.h"
+#endif
+
 #ifndef MEDIA_CLOCK_CONVERTOR_H_INCLUDED
 #include "media_clock_converter.h"
 #endif
@@ -1281,6 +1285,17 @@ class Mpeg4File : public IMpeg4File, public Parentable
                 Oscl_FileServer* aFileServSession);
         void DestroyDataStreamForExternalDownload();
 
+        // takes over the caller's reference to the mapping
+        void setFileMapping(PVFileMapping* aMapping)
+        {
+            if (_pFileMapping != NULL)
+            {
+                _pFileMapping->removeRef();
+            }
+            _pFileMapping = aMapping;
+        }
+
+        OsclRefCounter* enableMappedSampleAccess(const uint32 trackID);
 
     private:
         void ReserveMemoryForLangCodeVector(Oscl_Vector<uint16, OsclMemAllocator> &iLangCode, int32 capacity, int32 &leavecode);
@@ -1304,6 +1319,7 @@ class Mpeg4File : public IMpeg4File, public Parentable
         bool _oPVContentDownloadable;
 
         MP4_FF_FILE *_commonFilePtr;
+        PVFileMapping *_pFileMapping;
 
         bool _isMovieFragmentsPresent;
         uint32 _pointerMovieAtomEnd;
@@ -1311,6 +1327,9 @@ class Mpeg4File : public IMpeg4File, public Parentable
         Oscl_Vector<MovieFragmentAtom*, OsclMemAllocator> *_pMovieFragmentAtomVec;
         Oscl_Vector<MovieFragmentRandomAccessAtom*, OsclMemAllocator> *_pMovieFragmentRandomAccessAtomVec;
         MfraOffsetAtom *_pMfraOffsetAtom;
+        MovieFragmentIndex *_pMovieFragmentIndex;
+        bool _movieFragmentIndexAttempted;
+        MovieFragmentIndex* getMovieFragmentIndex();
         uint32 _ptrMoofEnds;
         uint32 _parsing_mode;
         uint32 _movieFragmentIdx[256];
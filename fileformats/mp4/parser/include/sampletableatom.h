@@ -401,6 +401,16 @@ class SampleTableAtom : public Atom
 
         int32 updateFileSize(uint32 filesize);
 
+        // Once set, getNextBundledAccessUnits no longer reads sample data
+        // into the caller's fragments: it returns fragments that point
+        // into this read-only mapping of the whole file instead.  The
+        // caller keeps the mapping alive.  Pass NULL to go back to reads.
+        void setMappedFileBuffer(const uint8* aBase, uint32 aSize)
+        {
+            _pMappedFileBase = aBase;
+            _mappedFileSize = (aBase != NULL) ? aSize : 0;
+        }
+
         uint32 getSampleDescriptionIndex()
         {
             return _SDIndex;
@@ -414,7 +424,8 @@ class SampleTableAtom : public Atom
 
         int32 getNextNSamples(uint32 startSampleNum,
                               uint32 *n,
-                              GAU *pgau);
+                              GAU *pgau,
+                              bool aMapped = false);
 
 
         int32 peekNextNSamples(uint32 startSampleNum,
@@ -571,6 +582,9 @@ class SampleTableAtom : public Atom
         uint32  _fileSize;
         uint32  _IsUpdateFileSize;
 
+        const uint8* _pMappedFileBase;
+        uint32  _mappedFileSize;
+
         int32 _numAMRFramesPerSample;
 
         uint8 *_pAMRTempBuffer;
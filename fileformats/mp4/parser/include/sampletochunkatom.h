@@ -106,6 +106,10 @@ class SampleToChunkAtom : public FullAtom
 
         bool ParseEntryUnit(uint32 sample_cnt);
         void CheckAndParseEntry(uint32 i);
+        bool BuildCumulativeIndex();
+        void DeleteCumulativeIndex();
+        uint32 FindEntryForSampleNumber(uint32 sampleNum);
+        uint32 FindEntryForChunk(uint32 chunkNum);
         uint32 _entryCount;
         uint32 *_pfirstChunkVec;
         uint32 *_psamplesPerChunkVec;
@@ -150,8 +154,10 @@ class SampleToChunkAtom : public FullAtom
         uint32 _curr_buff_number;
         uint32 _next_buff_number;
 
-
-
+        // Cumulative index, built on first random access of a fully parsed
+        // table. Entry i holds the number of the first sample in run i.
+        uint32 *_pcumSampleVec;
+        bool _cum_index_disabled;
 };
 
 
@@ -81,6 +81,12 @@ class TimeToSampleAtom : public FullAtom
     private:
         bool ParseEntryUnit(uint32 entry_cnt);
         void CheckAndParseEntry(uint32 i);
+        bool BuildCumulativeIndex();
+        void DeleteCumulativeIndex();
+        uint32 FindEntryForTimestamp(uint32 ts);
+        uint32 FindEntryForSampleNumber(uint32 num);
+        uint32 GetCheckpointEntry(uint32 value, bool byTimestamp,
+                                  uint32& sampleCount, uint32& timestamp);
         uint32 _entryCount;
 
         uint32 *_psampleCountVec;
@@ -109,6 +115,22 @@ class TimeToSampleAtom : public FullAtom
         int32 _currPeekIndex;
         int32 _currPeekTimeDelta;
         uint32 _parsing_mode;
+
+        // Cumulative index, built on first random access of a fully parsed
+        // table. Entry i holds the sample number and timestamp at which stts
+        // entry i starts; entry _entryCount holds the track totals.
+        uint32 *_pcumSampleVec;
+        uint32 *_pcumTimeVec;
+        bool _cum_index_disabled;
+
+        // In partial parsing mode only one checkpoint per cached block of
+        // _stbl_buff_size entries is kept, recorded when the block is first read.
+        uint32 *_pblockSampleVec;
+        uint32 *_pblockTimeVec;
+        uint32 _cum_entry_cnt;
+        uint32 _cum_sample_count;
+        uint32 _cum_timestamp;
+
         PVLogger *iLogger, *iStateVarLogger, *iParsedDataLogger;
 
 };
@@ -543,6 +543,15 @@ class TrackAtom : public Atom
             }
         }
 
+        bool setMappedFileBuffer(const uint8* aBase, uint32 aSize)
+        {
+            if (_pmediaAtom != NULL)
+            {
+                return _pmediaAtom->setMappedFileBuffer(aBase, aSize);
+            }
+            return false;
+        }
+
         int32 getNextBundledAccessUnits(uint32 *n,
                                         GAU    *pgau)
         {
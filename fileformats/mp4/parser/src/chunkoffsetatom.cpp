@@ -47,6 +47,8 @@ ChunkOffsetAtom::ChunkOffsetAtom(MP4_FF_FILE *fp, uint32 size, uint32 type,
     _parsed_entry_cnt = 0;
     _parsingMode = parsingMode;
     _fileptr = NULL;
+    _offsetsOrderChecked = false;
+    _offsetsSorted = false;
 
     if (_success)
     {
@@ -281,6 +283,32 @@ ChunkOffsetAtom::getChunkClosestToOffset(uint32 offSet, int32& index)
         return PV_ERROR;
     }
 
+    if ((_parsingMode == 0) && AreOffsetsSorted())
+    {
+        // First chunk starting at or after offSet
+        uint32 low = 0;
+        uint32 high = _entryCount;
+        while (low < high)
+        {
+            uint32 mid = low + ((high - low) >> 1);
+            if (_pchunkOffsets[mid] < offSet)
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+
+        if (low == _entryCount)
+        {
+            return (INSUFFICIENT_DATA);
+        }
+        index = (low > 0) ? (low - 1) : 0;
+        return (EVERYTHING_FINE);
+    }
+
     uint32 prevIndex = 0;
     for (uint32 i = 0; i < _entryCount; i++)
     {
@@ -315,5 +343,20 @@ ChunkOffsetAtom::getChunkClosestToOffset(uint32 offSet, int32& index)
     return (INSUFFICIENT_DATA);
 }
 
-
-
+bool ChunkOffsetAtom::AreOffsetsSorted()
+{
+    if (!_offsetsOrderChecked)
+    {
+        _offsetsOrderChecked = true;
+        _offsetsSorted = true;
+        for (uint32 i = 1; i < _entryCount; i++)
+        {
+            if (_pchunkOffsets[i] < _pchunkOffsets[i-1])
+            {
+                _offsetsSorted = false;
+                break;
+            }
+        }
+    }
+    return _offsetsSorted;
+}
@@ -57,6 +57,8 @@ CompositionOffsetAtom::CompositionOffsetAtom(MP4_FF_FILE *fp,
     MT_EntryCount  = NULL;
     iMarkerTableCreation = false;
     MT_Table_Size = 0;
+    _pcumSampleVec = NULL;
+    _cum_index_disabled = false;
 
     _currGetSampleCount = 0;
     _currGetIndex = -1;
@@ -263,7 +265,9 @@ void CompositionOffsetAtom::setSamplesCount(uint32 SamplesCount)
 {
     _iTotalNumSamplesInTrack = SamplesCount;
 
-    if (_entryCount > ENABLE_MT_LOGIC_ON_CTTS_ENTRY_COUNT_VALUE)
+    // Fully parsed tables are searched through the cumulative index, so the
+    // marker table is only needed in partial parsing mode
+    if ((_parsing_mode == 1) && (_entryCount > ENABLE_MT_LOGIC_ON_CTTS_ENTRY_COUNT_VALUE))
     {
         //Make this AO active so Run() will be called when scheduler is started
         if (OsclExecScheduler::Current() != NULL)
@@ -333,6 +337,8 @@ CompositionOffsetAtom::~CompositionOffsetAtom()
 
     deleteMarkerTable();
 
+    DeleteCumulativeIndex();
+
     if (_fileptr != NULL)
     {
         if (_fileptr->IsOpen())
@@ -540,7 +546,19 @@ int32 CompositionOffsetAtom::getTimeOffsetForSampleNumber(uint32 num)
     uint32 currSample = 0;
     uint32 currEC = 0;
 
-    if (iMarkerTableCreation == true)
+    if (BuildCumulativeIndex())
+    {
+        uint32 i = FindEntryForSampleNumber(num);
+        if (i < _entryCount)
+        { // Sample num within entry i
+            PVMF_MP4FFPARSER_LOGMEDIASAMPELSTATEVARIABLES((0, "CompositionOffsetAtom::getTimestampForSampleNumber- Time StampOffset = %d", _psampleOffsetVec[i]));
+            return _psampleOffsetVec[i];
+        }
+
+        // Went past end of list - not a valid sample number
+        return PV_ERROR;
+    }
+    else if (iMarkerTableCreation == true)
     {
         uint32 MT_EC = num / (MT_SAMPLECOUNT_INCREMENT - 1); //where MT_SAMPLECOUNT_INCREMENT is the granuality of sample separation in Marker Table
 
@@ -628,6 +646,28 @@ CompositionOffsetAtom::resetStateVariables(uint32 sampleNum)
         return PV_ERROR;
     }
 
+    if (BuildCumulativeIndex())
+    {
+        // First entry whose run ends at or after sampleNum
+        uint32 i = (sampleNum > 0) ? FindEntryForSampleNumber(sampleNum - 1) : 0;
+        int32 status = EVERYTHING_FINE;
+        if (i == _entryCount)
+        {
+            // Went past end of list - leave the state on the last entry
+            i = _entryCount - 1;
+            status = PV_ERROR;
+        }
+
+        _currPeekIndex = i;
+        _currPeekSampleCount = _pcumSampleVec[i+1];
+        _currPeekTimeOffset = _psampleOffsetVec[i];
+
+        _currGetIndex = i;
+        _currGetSampleCount = _pcumSampleVec[i+1];
+        _currGetTimeOffset = _psampleOffsetVec[i];
+        return status;
+    }
+
     if (_parsing_mode)
     {
         if (_parsed_entry_cnt == 0)
@@ -824,4 +864,74 @@ PVMFStatus CompositionOffsetAtom::createMarkerTable()
     return PVMFSuccess;
 }
 
+// Builds the cumulative index used to find the entry holding a sample with a
+// binary search instead of walking the table. Only done for fully parsed tables.
+bool CompositionOffsetAtom::BuildCumulativeIndex()
+{
+    if (_pcumSampleVec != NULL)
+    {
+        return true;
+    }
+
+    if ((_parsing_mode != 0) || (_parsed_entry_cnt != _entryCount) ||
+            (_psampleCountVec == NULL) || _cum_index_disabled)
+    {
+        return false;
+    }
+
+    PV_MP4_FF_ARRAY_NEW(NULL, uint32, (_entryCount + 1), _pcumSampleVec);
+    if (_pcumSampleVec == NULL)
+    {
+        // Not fatal, lookups fall back to the linear walk
+        _cum_index_disabled = true;
+        return false;
+    }
 
+    uint64 sampleCount = 0;
+    for (uint32 i = 0; i <= _entryCount; i++)
+    {
+        if (sampleCount > 0xFFFFFFFF)
+        {
+            // The total wraps around 32 bits, keep the linear walk
+            DeleteCumulativeIndex();
+            return false;
+        }
+        _pcumSampleVec[i] = (uint32)sampleCount;
+        if (i < _entryCount)
+        {
+            sampleCount += _psampleCountVec[i];
+        }
+    }
+
+    return true;
+}
+
+void CompositionOffsetAtom::DeleteCumulativeIndex()
+{
+    if (_pcumSampleVec != NULL)
+        PV_MP4_ARRAY_DELETE(NULL, _pcumSampleVec);
+
+    _pcumSampleVec = NULL;
+    _cum_index_disabled = true;
+}
+
+// Returns the entry whose run contains sample num, or _entryCount if the
+// sample is past the end of the table
+uint32 CompositionOffsetAtom::FindEntryForSampleNumber(uint32 num)
+{
+    uint32 low = 0;
+    uint32 high = _entryCount;
+    while (low < high)
+    {
+        uint32 mid = low + ((high - low) >> 1);
+        if (_pcumSampleVec[mid+1] <= num)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
@@ -57,7 +57,8 @@ OSCL_EXPORT_REF  IMpeg4File *IMpeg4File::readMP4File(OSCL_wString& aFilename,
         PVMFCPMPluginAccessInterfaceFactory* aCPMAccessFactory,
         OsclFileHandle* aHandle,
         uint32 aParsingMode,
-        Oscl_FileServer* aFileServSession)
+        Oscl_FileServer* aFileServSession,
+        bool aMapFile)
 {
     //optimized mode is not supported if multiple file ptrs are not allowed
     if (aParsingMode == 1)
@@ -88,6 +89,12 @@ OSCL_EXPORT_REF  IMpeg4File *IMpeg4File::readMP4File(OSCL_wString& aFilename,
     Mpeg4File *mp4 = NULL;
     PV_MP4_FF_NEW(fp->auditCB, Mpeg4File, (fp, aFilename, aParsingMode), mp4);
 
+    if ((mp4 != NULL) && aMapFile && !mp4->IsMovieFragmentsPresent())
+    {
+        // The mapping outlives the file handle closed below
+        mp4->setFileMapping(fp->_pvfile.CreateMapping());
+    }
+
 #ifdef OPEN_FILE_ONCE_PER_TRACK
     if (mp4 != NULL)
     {
@@ -659,8 +666,9 @@ IMpeg4File::GetMetaDataSize(PVMFCPMPluginAccessInterfaceFactory* aCPMAccessFacto
 
     if (!oMovieAtomFound && (0 != AtomUtils::getFileBufferingCapacity(fp)))
     {
-        // can't support progressive playback if no movie atom found
-        mp4ErrorCode = NOT_PROGRESSIVE_STREAMABLE;
+        // can't support progressive playback if no movie atom found, unless
+        // the media data atom was parsed and the movie atom follows it
+        mp4ErrorCode = oMediaDataAtomFound ? MOVIE_ATOM_AFTER_MEDIA_DATA : NOT_PROGRESSIVE_STREAMABLE;
     }
 
     AtomUtils::CloseMP4File(fp);
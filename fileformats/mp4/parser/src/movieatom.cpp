@@ -472,6 +472,20 @@ MovieAtom::getNextBundledAccessUnits(uint32 id,
     return (nReturn);
 }
 
+bool
+MovieAtom::setMappedFileBuffer(const uint32 trackID,
+                               const uint8* aBase,
+                               uint32 aSize)
+{
+    TrackAtom *track = getTrackForID(trackID);
+
+    if (track != NULL)
+    {
+        return track->setMappedFileBuffer(aBase, aSize);
+    }
+    return false;
+}
+
 int32
 MovieAtom::peekNextBundledAccessUnits(uint32 id,
                                       uint32 *n,
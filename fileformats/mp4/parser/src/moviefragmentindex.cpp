@@ -0,0 +1,505 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/*********************************************************************************/
+/*     -------------------------------------------------------------------       */
+/*                            MPEG-4 Movie Fragment Index Class                  */
+/*     -------------------------------------------------------------------       */
+/*********************************************************************************/
+/*
+*/
+
+#define IMPLEMENT_MovieFragmentIndex
+
+#include "atomdefs.h"
+#include "atomutils.h"
+#include "moviefragmentindex.h"
+#include "moviefragmentrandomaccess.h"
+#include "trackextendsatom.h"
+
+#define TFHD_BASE_DATA_OFFSET_PRESENT           0x000001
+#define TFHD_SAMPLE_DESCRIPTION_INDEX_PRESENT   0x000002
+#define TFHD_DEFAULT_SAMPLE_DURATION_PRESENT    0x000008
+#define TFHD_DEFAULT_SAMPLE_SIZE_PRESENT        0x000010
+#define TFHD_DEFAULT_SAMPLE_FLAGS_PRESENT       0x000020
+
+#define TRUN_DATA_OFFSET_PRESENT                0x000001
+#define TRUN_FIRST_SAMPLE_FLAGS_PRESENT         0x000004
+#define TRUN_SAMPLE_DURATION_PRESENT            0x000100
+#define TRUN_SAMPLE_SIZE_PRESENT                0x000200
+#define TRUN_SAMPLE_FLAGS_PRESENT               0x000400
+#define TRUN_SAMPLE_CTO_PRESENT                 0x000800
+
+#define SAMPLE_IS_NON_SYNC_SAMPLE               0x00010000
+
+typedef Oscl_Vector<TrackFragmentRandomAccessAtom*, OsclMemAllocator> trackFragmentRandomAccessAtomVecType;
+
+MovieFragmentIndex::MovieFragmentIndex()
+{
+    _built = false;
+
+    iLogger = PVLogger::GetLoggerObject("mp4ffparser");
+    iStateVarLogger = PVLogger::GetLoggerObject("mp4ffparser_mediasamplestats");
+    iParsedDataLogger = PVLogger::GetLoggerObject("mp4ffparser_parseddata");
+}
+
+MovieFragmentIndex::~MovieFragmentIndex()
+{
+    for (uint32 i = 0; i < _tracks.size(); i++)
+    {
+        PV_MP4_FF_DELETE(NULL, MovieFragmentIndexTrack, _tracks[i]);
+    }
+}
+
+void MovieFragmentIndex::addTrack(uint32 aTrackID, uint32 aStartTime)
+{
+    if (getTrack(aTrackID) != NULL)
+    {
+        return;
+    }
+    MovieFragmentIndexTrack *track = NULL;
+    PV_MP4_FF_NEW(NULL, MovieFragmentIndexTrack, (aTrackID, aStartTime), track);
+    if (track != NULL)
+    {
+        _tracks.push_back(track);
+    }
+}
+
+MovieFragmentIndexTrack* MovieFragmentIndex::getTrack(uint32 aTrackID)
+{
+    for (uint32 i = 0; i < _tracks.size(); i++)
+    {
+        if (_tracks[i]->_trackId == aTrackID)
+        {
+            return _tracks[i];
+        }
+    }
+    return NULL;
+}
+
+void MovieFragmentIndex::addEntry(MovieFragmentIndexTrack *aTrack, const MovieFragmentIndexEntry &aEntry)
+{
+    // Entries normally arrive in time order; keep the vector sorted if not.
+    aTrack->_entries.push_back(aEntry);
+    uint32 idx = aTrack->_entries.size() - 1;
+    while ((idx > 0) && (aTrack->_entries[idx - 1]._time > aEntry._time))
+    {
+        aTrack->_entries[idx] = aTrack->_entries[idx - 1];
+        idx--;
+    }
+    aTrack->_entries[idx] = aEntry;
+}
+
+// Returns the index of the first entry whose time is greater than aTime.
+uint32 MovieFragmentIndex::upperBound(MovieFragmentIndexTrack *aTrack, uint32 aTime)
+{
+    uint32 lo = 0;
+    uint32 hi = aTrack->_entries.size();
+    while (lo < hi)
+    {
+        uint32 mid = lo + ((hi - lo) >> 1);
+        if (aTrack->_entries[mid]._time <= aTime)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+bool MovieFragmentIndex::hasEntriesForTrack(uint32 aTrackID)
+{
+    MovieFragmentIndexTrack *track = getTrack(aTrackID);
+    return ((track != NULL) && (track->_entries.size() > 0));
+}
+
+bool MovieFragmentIndex::buildFromTFRA(MovieFragmentRandomAccessAtom *aMfraAtom)
+{
+    trackFragmentRandomAccessAtomVecType *tfraVec = aMfraAtom->getTrackFragmentRandomAccessAtomVec();
+    if (tfraVec == NULL)
+    {
+        return false;
+    }
+
+    for (uint32 idx = 0; idx < tfraVec->size(); idx++)
+    {
+        TrackFragmentRandomAccessAtom *tfraAtom = (*tfraVec)[idx];
+        if (tfraAtom == NULL)
+        {
+            continue;
+        }
+        Oscl_Vector<TFRAEntries*, OsclMemAllocator>* tfraEntries = tfraAtom->getTrackFragmentRandomAccessEntries();
+        if (tfraEntries == NULL)
+        {
+            continue;
+        }
+
+        addTrack(tfraAtom->getTrackID(), 0);
+        MovieFragmentIndexTrack *track = getTrack(tfraAtom->getTrackID());
+        if (track == NULL)
+        {
+            return false;
+        }
+        track->_entries.reserve(track->_entries.size() + tfraEntries->size());
+        for (uint32 idy = 0; idy < tfraEntries->size(); idy++)
+        {
+            TFRAEntries *tfraEntry = (*tfraEntries)[idy];
+            MovieFragmentIndexEntry entry;
+            entry._time = tfraEntry->getTimeStamp();
+            entry._moof_offset = tfraEntry->getTimeMoofOffset();
+            entry._traf_number = tfraEntry->_traf_number;
+            entry._trun_number = tfraEntry->_trun_number;
+            entry._sample_number = tfraEntry->_sample_number;
+            entry._sample_count = 0;
+            addEntry(track, entry);
+        }
+        PVMF_MP4FFPARSER_LOGPARSEDINFO((0, "MovieFragmentIndex::buildFromTFRA TrackID %d Entries %d", track->_trackId, track->_entries.size()));
+    }
+    _built = true;
+    return true;
+}
+
+bool MovieFragmentIndex::buildFromMoofScan(MP4_FF_FILE *aFilePtr, uint32 aStartOffset,
+        Oscl_Vector<TrackExtendsAtom*, OsclMemAllocator> *aTrackExtendsAtomVec)
+{
+    uint32 fileSize = 0;
+    if (!AtomUtils::getCurrentFileSize(aFilePtr, fileSize))
+    {
+        return false;
+    }
+
+    uint32 savedFilePos = AtomUtils::getCurrentFilePosition(aFilePtr);
+    uint8 *moofBuf = NULL;
+    uint32 moofBufSize = 0;
+    uint32 numMoofs = 0;
+    bool ok = true;
+
+    uint32 offset = aStartOffset;
+    while (ok && (offset < fileSize))
+    {
+        uint32 atomSize = 0;
+        uint32 atomType = UNKNOWN_ATOM;
+        AtomUtils::seekFromStart(aFilePtr, offset);
+        if (((fileSize - offset) < DEFAULT_ATOM_SIZE) ||
+                !AtomUtils::read32read32(aFilePtr, atomSize, atomType) ||
+                (atomSize < DEFAULT_ATOM_SIZE) ||
+                (atomSize > (fileSize - offset)))
+        {
+            // Truncated file or 64 bit atom size, neither of which the rest
+            // of the fragment parsing supports either.
+            ok = false;
+            break;
+        }
+
+        if (atomType == MOVIE_FRAGMENT_ATOM)
+        {
+            uint32 payloadSize = atomSize - DEFAULT_ATOM_SIZE;
+            if (payloadSize > moofBufSize)
+            {
+                if (moofBuf != NULL)
+                {
+                    oscl_free(moofBuf);
+                }
+                moofBuf = (uint8*)oscl_malloc(payloadSize);
+                moofBufSize = (moofBuf != NULL) ? payloadSize : 0;
+            }
+            if ((moofBuf == NULL) ||
+                    !AtomUtils::readByteData(aFilePtr, payloadSize, moofBuf) ||
+                    !scanMoof(moofBuf, payloadSize, offset, aTrackExtendsAtomVec))
+            {
+                ok = false;
+                break;
+            }
+            numMoofs++;
+        }
+        offset += atomSize;
+    }
+
+    if (moofBuf != NULL)
+    {
+        oscl_free(moofBuf);
+    }
+    AtomUtils::seekFromStart(aFilePtr, savedFilePos);
+
+    if (!ok)
+    {
+        PVMF_MP4FFPARSER_LOGERROR((0, "MovieFragmentIndex::buildFromMoofScan Failed at offset %d", offset));
+        for (uint32 i = 0; i < _tracks.size(); i++)
+        {
+            _tracks[i]->_entries.clear();
+        }
+        return false;
+    }
+
+    PVMF_MP4FFPARSER_LOGPARSEDINFO((0, "MovieFragmentIndex::buildFromMoofScan Indexed %d moofs", numMoofs));
+    _built = true;
+    return true;
+}
+
+bool MovieFragmentIndex::scanMoof(uint8 *aBuf, uint32 aSize, uint32 aMoofOffset,
+                                  Oscl_Vector<TrackExtendsAtom*, OsclMemAllocator> *aTrackExtendsAtomVec)
+{
+    uint32 i;
+    for (i = 0; i < _tracks.size(); i++)
+    {
+        _tracks[i]->_scanEntryIdx = -1;
+        _tracks[i]->_scanSampleCount = 0;
+    }
+
+    uint32 trafNumber = 0;
+    while (aSize >= DEFAULT_ATOM_SIZE)
+    {
+        uint8 *atom = aBuf;
+        uint32 atomSize = 0;
+        uint32 atomType = UNKNOWN_ATOM;
+        AtomUtils::read32read32(atom, atomSize, atomType);
+        if ((atomSize < DEFAULT_ATOM_SIZE) || (atomSize > aSize))
+        {
+            return false;
+        }
+        if (atomType == TRACK_FRAGMENT_ATOM)
+        {
+            trafNumber++;
+            if (!scanTraf(atom, atomSize - DEFAULT_ATOM_SIZE, aMoofOffset, trafNumber, aTrackExtendsAtomVec))
+            {
+                return false;
+            }
+        }
+        aBuf += atomSize;
+        aSize -= atomSize;
+    }
+
+    for (i = 0; i < _tracks.size(); i++)
+    {
+        MovieFragmentIndexTrack *track = _tracks[i];
+        if (track->_scanEntryIdx >= 0)
+        {
+            track->_entries[track->_scanEntryIdx]._sample_count = track->_scanSampleCount;
+        }
+    }
+    return true;
+}
+
+bool MovieFragmentIndex::scanTraf(uint8 *aBuf, uint32 aSize, uint32 aMoofOffset, uint32 aTrafNumber,
+                                  Oscl_Vector<TrackExtendsAtom*, OsclMemAllocator> *aTrackExtendsAtomVec)
+{
+    MovieFragmentIndexTrack *track = NULL;
+    uint32 defaultDuration = 0;
+    uint32 defaultFlags = 0;
+    uint32 trunNumber = 0;
+
+    while (aSize >= DEFAULT_ATOM_SIZE)
+    {
+        uint8 *atom = aBuf;
+        uint32 atomSize = 0;
+        uint32 atomType = UNKNOWN_ATOM;
+        AtomUtils::read32read32(atom, atomSize, atomType);
+        if ((atomSize < DEFAULT_ATOM_SIZE) || (atomSize > aSize))
+        {
+            return false;
+        }
+        uint32 payloadSize = atomSize - DEFAULT_ATOM_SIZE;
+
+        if (atomType == TRACK_FRAGMENT_HEADER_ATOM)
+        {
+            uint32 tfFlags = 0;
+            uint32 trackID = 0;
+            if (payloadSize < 8)
+            {
+                return false;
+            }
+            AtomUtils::read32read32(atom, tfFlags, trackID);
+            track = getTrack(trackID);
+            if (track == NULL)
+            {
+                // not a track we index
+                return true;
+            }
+
+            if (aTrackExtendsAtomVec != NULL)
+            {
+                for (uint32 idx = 0; idx < aTrackExtendsAtomVec->size(); idx++)
+                {
+                    TrackExtendsAtom* pTrackExtendAtom = (*aTrackExtendsAtomVec)[idx];
+                    if (pTrackExtendAtom->getTrackId() == trackID)
+                    {
+                        defaultDuration = pTrackExtendAtom->getDefaultSampleDuration();
+                        defaultFlags = pTrackExtendAtom->getDefaultSampleFlag();
+                    }
+                }
+            }
+
+            uint32 needed = 8;
+            needed += (tfFlags & TFHD_BASE_DATA_OFFSET_PRESENT) ? 8 : 0;
+            needed += (tfFlags & TFHD_SAMPLE_DESCRIPTION_INDEX_PRESENT) ? 4 : 0;
+            needed += (tfFlags & TFHD_DEFAULT_SAMPLE_DURATION_PRESENT) ? 4 : 0;
+            needed += (tfFlags & TFHD_DEFAULT_SAMPLE_SIZE_PRESENT) ? 4 : 0;
+            needed += (tfFlags & TFHD_DEFAULT_SAMPLE_FLAGS_PRESENT) ? 4 : 0;
+            if (payloadSize < needed)
+            {
+                return false;
+            }
+            if (tfFlags & TFHD_BASE_DATA_OFFSET_PRESENT)
+                atom += 8;
+            if (tfFlags & TFHD_SAMPLE_DESCRIPTION_INDEX_PRESENT)
+                atom += 4;
+            if (tfFlags & TFHD_DEFAULT_SAMPLE_DURATION_PRESENT)
+                AtomUtils::read32(atom, defaultDuration);
+            if (tfFlags & TFHD_DEFAULT_SAMPLE_SIZE_PRESENT)
+                atom += 4;
+            if (tfFlags & TFHD_DEFAULT_SAMPLE_FLAGS_PRESENT)
+                AtomUtils::read32(atom, defaultFlags);
+        }
+        else if ((atomType == TRACK_FRAGMENT_RUN_ATOM) && (track != NULL))
+        {
+            uint32 trFlags = 0;
+            uint32 sampleCount = 0;
+            uint32 firstSampleFlags = defaultFlags;
+            trunNumber++;
+
+            if (payloadSize < 8)
+            {
+                return false;
+            }
+            AtomUtils::read32read32(atom, trFlags, sampleCount);
+            trFlags &= 0x00FFFFFF;
+
+            uint32 headerSize = 8;
+            headerSize += (trFlags & TRUN_DATA_OFFSET_PRESENT) ? 4 : 0;
+            headerSize += (trFlags & TRUN_FIRST_SAMPLE_FLAGS_PRESENT) ? 4 : 0;
+            uint32 perSampleSize = 0;
+            perSampleSize += (trFlags & TRUN_SAMPLE_DURATION_PRESENT) ? 4 : 0;
+            perSampleSize += (trFlags & TRUN_SAMPLE_SIZE_PRESENT) ? 4 : 0;
+            perSampleSize += (trFlags & TRUN_SAMPLE_FLAGS_PRESENT) ? 4 : 0;
+            perSampleSize += (trFlags & TRUN_SAMPLE_CTO_PRESENT) ? 4 : 0;
+            if ((payloadSize < headerSize) ||
+                    ((perSampleSize != 0) && (sampleCount > (payloadSize - headerSize) / perSampleSize)))
+            {
+                return false;
+            }
+            if (trFlags & TRUN_DATA_OFFSET_PRESENT)
+                atom += 4;
+            if (trFlags & TRUN_FIRST_SAMPLE_FLAGS_PRESENT)
+                AtomUtils::read32(atom, firstSampleFlags);
+
+            for (uint32 i = 0; i < sampleCount; i++)
+            {
+                uint32 duration = defaultDuration;
+                uint32 flags = (i == 0) ? firstSampleFlags : defaultFlags;
+                if (trFlags & TRUN_SAMPLE_DURATION_PRESENT)
+                    AtomUtils::read32(atom, duration);
+                if (trFlags & TRUN_SAMPLE_SIZE_PRESENT)
+                    atom += 4;
+                if (trFlags & TRUN_SAMPLE_FLAGS_PRESENT)
+                    AtomUtils::read32(atom, flags);
+                if (trFlags & TRUN_SAMPLE_CTO_PRESENT)
+                    atom += 4;
+
+                if ((track->_scanEntryIdx < 0) && !(flags & SAMPLE_IS_NON_SYNC_SAMPLE))
+                {
+                    MovieFragmentIndexEntry entry;
+                    entry._time = track->_scanTime;
+                    entry._moof_offset = aMoofOffset;
+                    entry._traf_number = aTrafNumber;
+                    entry._trun_number = trunNumber;
+                    entry._sample_number = i + 1;
+                    entry._sample_count = 0;
+                    addEntry(track, entry);
+                    track->_scanEntryIdx = track->_entries.size() - 1;
+                }
+                track->_scanTime += duration;
+            }
+            track->_scanSampleCount += sampleCount;
+        }
+        aBuf += atomSize;
+        aSize -= atomSize;
+    }
+    return true;
+}
+
+int32 MovieFragmentIndex::getSyncSampleInfoClosestToTime(uint32 trackID, uint32 &time, uint32 &moof_offset,
+        uint32 &traf_number, uint32 &trun_number,
+        uint32 &sample_num)
+{
+    PVMF_MP4FFPARSER_LOGMEDIASAMPELSTATEVARIABLES((0, "MovieFragmentIndex::getSyncSampleInfoClosestToTime Input Time =%d", time));
+    MovieFragmentIndexTrack *track = getTrack(trackID);
+    if ((track == NULL) || (track->_entries.size() == 0))
+    {
+        return -1;
+    }
+
+    // Pick the closer of the last entry at or before time and the first
+    // entry after it.
+    uint32 idx = upperBound(track, time);
+    if (idx == track->_entries.size())
+    {
+        idx--;
+    }
+    else if (idx > 0)
+    {
+        uint32 diffwithbeforeTS = time - track->_entries[idx - 1]._time;
+        uint32 diffwithafterTS = track->_entries[idx]._time - time;
+        if (diffwithbeforeTS <= diffwithafterTS)
+        {
+            idx--;
+        }
+    }
+
+    MovieFragmentIndexEntry &entry = track->_entries[idx];
+    time = entry._time;
+    moof_offset = entry._moof_offset;
+    traf_number = entry._traf_number;
+    trun_number = entry._trun_number;
+    sample_num = entry._sample_number;
+    PVMF_MP4FFPARSER_LOGMEDIASAMPELSTATEVARIABLES((0, "MovieFragmentIndex::getSyncSampleInfoClosestToTime Return Time =%d", time));
+    return 0;
+}
+
+int32 MovieFragmentIndex::queryRepositionTime(uint32 trackID, int32 time, bool bBeforeRequestedTime)
+{
+    MovieFragmentIndexTrack *track = getTrack(trackID);
+    if (track == NULL)
+    {
+        return 0;
+    }
+    uint32 entries = track->_entries.size();
+    if ((entries == 0) || (time < 0))
+    {
+        return time;
+    }
+
+    uint32 idx = upperBound(track, (uint32)time);
+    if (bBeforeRequestedTime)
+    {
+        // last entry at or before time
+        time = (idx > 0) ? track->_entries[idx - 1]._time : 0;
+    }
+    else
+    {
+        // first entry at or after time, else the last one
+        if ((idx > 0) && (track->_entries[idx - 1]._time == (uint32)time))
+        {
+            idx--;
+        }
+        time = track->_entries[(idx < entries) ? idx : (entries - 1)]._time;
+    }
+    PVMF_MP4FFPARSER_LOGMEDIASAMPELSTATEVARIABLES((0, "MovieFragmentIndex::queryRepositionTime Return Time =%d", time));
+    return time;
+}
@@ -69,6 +69,8 @@ Mpeg4File::Mpeg4File(MP4_FF_FILE *fp,
     _pMovieFragmentAtomVec = NULL;
     _pMfraOffsetAtom = NULL;
     _pMovieFragmentRandomAccessAtomVec = NULL;
+    _pMovieFragmentIndex = NULL;
+    _movieFragmentIndexAttempted = false;
     _pTrackExtendsAtomVec = NULL;
     _pMoofOffsetVec = NULL;
     _ptrMoofEnds = 0;
@@ -112,6 +114,7 @@ Mpeg4File::Mpeg4File(MP4_FF_FILE *fp,
     _oPVContent = false;
     _oPVContentDownloadable = false;
     _commonFilePtr = NULL;
+    _pFileMapping = NULL;
     _fileSize = fsize;
 
     int32 count = fileSize - filePointer;// -DEFAULT_ATOM_SIZE;
@@ -1598,6 +1601,13 @@ Mpeg4File::~Mpeg4File()
     // Delete the vectors themselves
     PV_MP4_FF_TEMPLATED_DELETE(NULL, trackAtomVecType, Oscl_Vector, _pTrackAtomVec);
 
+    // Fragments already sent downstream hold their own references
+    if (_pFileMapping != NULL)
+    {
+        _pFileMapping->removeRef();
+        _pFileMapping = NULL;
+    }
+
 
     titleValues.destroy();
     iTitleLangCode.destroy();
@@ -1660,6 +1670,12 @@ Mpeg4File::~Mpeg4File()
     // Delete the vectors themselves
     PV_MP4_FF_TEMPLATED_DELETE(NULL, movieFragmentRandomAccessAtomVecType, Oscl_Vector, _pMovieFragmentRandomAccessAtomVec);
 
+    if (_pMovieFragmentIndex != NULL)
+    {
+        PV_MP4_FF_DELETE(NULL, MovieFragmentIndex, _pMovieFragmentIndex);
+        _pMovieFragmentIndex = NULL;
+    }
+
     if (_pMoofOffsetVec != NULL)
         PV_MP4_FF_TEMPLATED_DELETE(NULL, movieFragmentOffsetVecType, Oscl_Vector, _pMoofOffsetVec);
 
@@ -3550,218 +3566,215 @@ uint32 Mpeg4File::resetPlayback(uint32 time, uint16 numTracks, uint32 *trackList
             MediaClockConverter mcc1(1000);
             mcc1.update_clock(modifiedTimeStamp);
             convertedTS = mcc1.get_converted_ts(getTrackMediaTimescale(trackID));
-            if (oMfraFound)
+            MovieFragmentIndex *fragmentIndex = getMovieFragmentIndex();
+            if (fragmentIndex != NULL)
             {
-                for (uint32 idx = 0; idx < _pMovieFragmentRandomAccessAtomVec->size(); idx++)
+                uint32 ret = fragmentIndex->getSyncSampleInfoClosestToTime(trackID, convertedTS, moof_offset, traf_number, trun_number, sample_num);
+                if (ret == 0)
                 {
-                    MovieFragmentRandomAccessAtom *pMovieFragmentRandomAccessAtom = (*_pMovieFragmentRandomAccessAtomVec)[idx];
-                    uint32 ret = pMovieFragmentRandomAccessAtom->getSyncSampleInfoClosestToTime(trackID, convertedTS, moof_offset, traf_number, trun_number, sample_num);
-                    if (ret == 0)
+                    if (moofParsingCompleted)
                     {
-                        if (moofParsingCompleted)
-                        {
-                            // do nothing
-                        }
-                        else
+                        // do nothing
+                    }
+                    else
+                    {
+                        uint32 i = _pMovieFragmentAtomVec->size();
+                        _pMoofOffsetVec->pop_back();
+                        _pMovieFragmentAtomVec->pop_back();
+                        PV_MP4_FF_DELETE(NULL, MovieFragmentAtom , (*_pMovieFragmentAtomVec)[i-1]);
+                        parseMoofCompletely = true;
+                        moofParsingCompleted = true;
+                        moofSize = 0;
+                        moofType = UNKNOWN_ATOM;
+                        moofCount = 0;
+                        moofPtrPos = 0;
+                    }
+
+                    for (uint32 idx = 0; idx < _pMoofOffsetVec->size(); idx++)
+                    {
+                        uint32 moof_start_offset = (*_pMoofOffsetVec)[idx];
+                        if (moof_start_offset == moof_offset)
                         {
-                            uint32 i = _pMovieFragmentAtomVec->size();
-                            _pMoofOffsetVec->pop_back();
-                            _pMovieFragmentAtomVec->pop_back();
-                            PV_MP4_FF_DELETE(NULL, MovieFragmentAtom , (*_pMovieFragmentAtomVec)[i-1]);
-                            parseMoofCompletely = true;
-                            moofParsingCompleted = true;
-                            moofSize = 0;
-                            moofType = UNKNOWN_ATOM;
-                            moofCount = 0;
-                            moofPtrPos = 0;
+                            _movieFragmentIdx[trackID] = idx;
+                            _peekMovieFragmentIdx[trackID] = idx;
+                            _movieFragmentSeqIdx[trackID] = (*_pMovieFragmentAtomVec)[idx]->getSequenceNumber();
+                            _peekMovieFragmentSeqIdx[trackID] = _movieFragmentSeqIdx[trackID];
+                            _pMovieFragmentAtom = (*_pMovieFragmentAtomVec)[idx];
+                            currMoofNum = _pMovieFragmentAtom->getSequenceNumber();
+                            oMoofFound = true;
+
+                            AtomUtils::seekFromStart(_movieFragmentFilePtr, moof_offset);
+                            uint32 atomType = UNKNOWN_ATOM;
+                            uint32 atomSize = 0;
+                            AtomUtils::getNextAtomType(_movieFragmentFilePtr, atomSize, atomType);
+                            if (atomType == MOVIE_FRAGMENT_ATOM)
+                            {
+                                atomSize -= DEFAULT_ATOM_SIZE;
+                                AtomUtils::seekFromCurrPos(_movieFragmentFilePtr, atomSize);
+                                _ptrMoofEnds = AtomUtils::getCurrentFilePosition(_movieFragmentFilePtr);
+                            }
+                            break;
                         }
+                    }
 
-                        for (uint32 idx = 0; idx < _pMoofOffsetVec->size(); idx++)
+                    if (_parsing_mode == 1)
+                    {
+                        if (!oMoofFound)
                         {
-                            uint32 moof_start_offset = (*_pMoofOffsetVec)[idx];
-                            if (moof_start_offset == moof_offset)
-                            {
-                                _movieFragmentIdx[trackID] = idx;
-                                _peekMovieFragmentIdx[trackID] = idx;
-                                _movieFragmentSeqIdx[trackID] = (*_pMovieFragmentAtomVec)[idx]->getSequenceNumber();
-                                _peekMovieFragmentSeqIdx[trackID] = _movieFragmentSeqIdx[trackID];
-                                _pMovieFragmentAtom = (*_pMovieFragmentAtomVec)[idx];
-                                currMoofNum = _pMovieFragmentAtom->getSequenceNumber();
-                                oMoofFound = true;
+                            uint32 fileSize = 0;
+                            _ptrMoofEnds = moof_offset;
+                            AtomUtils::getCurrentFileSize(_movieFragmentFilePtr, fileSize);
+                            AtomUtils::seekFromStart(_movieFragmentFilePtr, _ptrMoofEnds);
+                            uint32 filePointer = AtomUtils::getCurrentFilePosition(_movieFragmentFilePtr);
+                            int32 count = fileSize - filePointer;// -DEFAULT_ATOM_SIZE;
 
-                                AtomUtils::seekFromStart(_movieFragmentFilePtr, moof_offset);
+                            while (count > 0)
+                            {
                                 uint32 atomType = UNKNOWN_ATOM;
                                 uint32 atomSize = 0;
                                 AtomUtils::getNextAtomType(_movieFragmentFilePtr, atomSize, atomType);
                                 if (atomType == MOVIE_FRAGMENT_ATOM)
                                 {
-                                    atomSize -= DEFAULT_ATOM_SIZE;
-                                    AtomUtils::seekFromCurrPos(_movieFragmentFilePtr, atomSize);
-                                    _ptrMoofEnds = AtomUtils::getCurrentFilePosition(_movieFragmentFilePtr);
-                                }
-                                break;
-                            }
-                        }
+                                    parseMoofCompletely = true;
 
-                        if (_parsing_mode == 1)
-                        {
-                            if (!oMoofFound)
-                            {
-                                uint32 fileSize = 0;
-                                _ptrMoofEnds = moof_offset;
-                                AtomUtils::getCurrentFileSize(_movieFragmentFilePtr, fileSize);
-                                AtomUtils::seekFromStart(_movieFragmentFilePtr, _ptrMoofEnds);
-                                uint32 filePointer = AtomUtils::getCurrentFilePosition(_movieFragmentFilePtr);
-                                int32 count = fileSize - filePointer;// -DEFAULT_ATOM_SIZE;
+                                    uint32 moofStartOffset = AtomUtils::getCurrentFilePosition(_movieFragmentFilePtr);
+                                    moofStartOffset -= DEFAULT_ATOM_SIZE;
 
-                                while (count > 0)
-                                {
-                                    uint32 atomType = UNKNOWN_ATOM;
-                                    uint32 atomSize = 0;
-                                    AtomUtils::getNextAtomType(_movieFragmentFilePtr, atomSize, atomType);
-                                    if (atomType == MOVIE_FRAGMENT_ATOM)
+                                    if (moofParsingCompleted)
+                                    {
+                                        // do nothing
+                                    }
+                                    else
                                     {
+                                        uint32 i = _pMovieFragmentAtomVec->size();
+                                        _pMoofOffsetVec->pop_back();
+                                        _pMovieFragmentAtomVec->pop_back();
+                                        PV_MP4_FF_DELETE(NULL, MovieFragmentAtom , (*_pMovieFragmentAtomVec)[i-1]);
                                         parseMoofCompletely = true;
+                                        moofParsingCompleted = true;
+                                        moofSize = 0;
+                                        moofType = UNKNOWN_ATOM;
+                                        moofCount = 0;
+                                        moofPtrPos = 0;
+                                    }
 
-                                        uint32 moofStartOffset = AtomUtils::getCurrentFilePosition(_movieFragmentFilePtr);
-                                        moofStartOffset -= DEFAULT_ATOM_SIZE;
-
-                                        if (moofParsingCompleted)
-                                        {
-                                            // do nothing
-                                        }
-                                        else
-                                        {
-                                            uint32 i = _pMovieFragmentAtomVec->size();
-                                            _pMoofOffsetVec->pop_back();
-                                            _pMovieFragmentAtomVec->pop_back();
-                                            PV_MP4_FF_DELETE(NULL, MovieFragmentAtom , (*_pMovieFragmentAtomVec)[i-1]);
-                                            parseMoofCompletely = true;
-                                            moofParsingCompleted = true;
-                                            moofSize = 0;
-                                            moofType = UNKNOWN_ATOM;
-                                            moofCount = 0;
-                                            moofPtrPos = 0;
-                                        }
-
-                                        PV_MP4_FF_NEW(_movieFragmentFilePtr->auditCB, MovieFragmentAtom, (_movieFragmentFilePtr, atomSize, atomType, _pTrackDurationContainer, _pTrackExtendsAtomVec, parseMoofCompletely, moofParsingCompleted, countOfTrunsParsed), _pMovieFragmentAtom);
+                                    PV_MP4_FF_NEW(_movieFragmentFilePtr->auditCB, MovieFragmentAtom, (_movieFragmentFilePtr, atomSize, atomType, _pTrackDurationContainer, _pTrackExtendsAtomVec, parseMoofCompletely, moofParsingCompleted, countOfTrunsParsed), _pMovieFragmentAtom);
 
-                                        if (!_pMovieFragmentAtom->MP4Success())
-                                        {
-                                            _success = false;
-                                            _mp4ErrorCode = _pMovieFragmentAtom->GetMP4Error();
-                                            break;
-                                        }
+                                    if (!_pMovieFragmentAtom->MP4Success())
+                                    {
+                                        _success = false;
+                                        _mp4ErrorCode = _pMovieFragmentAtom->GetMP4Error();
+                                        break;
+                                    }
 
-                                        _pMovieFragmentAtom->setParent(this);
-                                        count -= _pMovieFragmentAtom->getSize();
+                                    _pMovieFragmentAtom->setParent(this);
+                                    count -= _pMovieFragmentAtom->getSize();
 
-                                        uint32 i = _pMovieFragmentAtomVec->size();
+                                    uint32 i = _pMovieFragmentAtomVec->size();
 
-                                        MovieFragmentAtom *pMovieFragmentAtom = NULL;
-                                        uint32 prevMoofSeqNum = 0;
+                                    MovieFragmentAtom *pMovieFragmentAtom = NULL;
+                                    uint32 prevMoofSeqNum = 0;
 
-                                        if (i > 0)
-                                        {
-                                            pMovieFragmentAtom = (*_pMovieFragmentAtomVec)[i-1];
+                                    if (i > 0)
+                                    {
+                                        pMovieFragmentAtom = (*_pMovieFragmentAtomVec)[i-1];
 
-                                            if (pMovieFragmentAtom != NULL)
-                                                prevMoofSeqNum = (*_pMovieFragmentAtomVec)[i-1]->getSequenceNumber();
-                                        }
+                                        if (pMovieFragmentAtom != NULL)
+                                            prevMoofSeqNum = (*_pMovieFragmentAtomVec)[i-1]->getSequenceNumber();
+                                    }
 
-                                        currMoofNum = _pMovieFragmentAtom->getSequenceNumber();
+                                    currMoofNum = _pMovieFragmentAtom->getSequenceNumber();
 
-                                        for (uint32 idx = prevMoofSeqNum; idx < currMoofNum - 1; idx++)
-                                        {
-                                            _pMovieFragmentAtomVec->push_back(NULL);
-                                            _pMoofOffsetVec->push_back(0);
-                                        }
-                                        if (currMoofNum > i)
-                                        {
-                                            _pMoofOffsetVec->push_back(moofStartOffset);
-                                            _pMovieFragmentAtomVec->push_back(_pMovieFragmentAtom);
-                                        }
-                                        else if ((*_pMovieFragmentAtomVec)[currMoofNum-1] == NULL)
-                                        {
-                                            (*_pMovieFragmentAtomVec)[currMoofNum-1] = _pMovieFragmentAtom;
-                                            (*_pMoofOffsetVec)[currMoofNum-1] = moofStartOffset;
-                                        }
-                                        else
-                                        {
-                                            PV_MP4_FF_DELETE(_movieFragmentFilePtr->auditCB, MovieFragmentAtom, _pMovieFragmentAtom);
-                                            _pMovieFragmentAtom = NULL;
-                                            break;
+                                    for (uint32 idx = prevMoofSeqNum; idx < currMoofNum - 1; idx++)
+                                    {
+                                        _pMovieFragmentAtomVec->push_back(NULL);
+                                        _pMoofOffsetVec->push_back(0);
+                                    }
+                                    if (currMoofNum > i)
+                                    {
+                                        _pMoofOffsetVec->push_back(moofStartOffset);
+                                        _pMovieFragmentAtomVec->push_back(_pMovieFragmentAtom);
+                                    }
+                                    else if ((*_pMovieFragmentAtomVec)[currMoofNum-1] == NULL)
+                                    {
+                                        (*_pMovieFragmentAtomVec)[currMoofNum-1] = _pMovieFragmentAtom;
+                                        (*_pMoofOffsetVec)[currMoofNum-1] = moofStartOffset;
+                                    }
+                                    else
+                                    {
+                                        PV_MP4_FF_DELETE(_movieFragmentFilePtr->auditCB, MovieFragmentAtom, _pMovieFragmentAtom);
+                                        _pMovieFragmentAtom = NULL;
+                                        break;
 
-                                        }
-                                        _movieFragmentSeqIdx[trackID] = currMoofNum;
-                                        _movieFragmentIdx[trackID] = currMoofNum - 1;
-                                        _peekMovieFragmentIdx[trackID] = currMoofNum - 1;
-                                        _peekMovieFragmentSeqIdx[trackID] = currMoofNum;
+                                    }
+                                    _movieFragmentSeqIdx[trackID] = currMoofNum;
+                                    _movieFragmentIdx[trackID] = currMoofNum - 1;
+                                    _peekMovieFragmentIdx[trackID] = currMoofNum - 1;
+                                    _peekMovieFragmentSeqIdx[trackID] = currMoofNum;
 
-                                        oMoofFound = true;
+                                    oMoofFound = true;
 
-                                        _ptrMoofEnds = AtomUtils::getCurrentFilePosition(_movieFragmentFilePtr);
-                                        break;
+                                    _ptrMoofEnds = AtomUtils::getCurrentFilePosition(_movieFragmentFilePtr);
+                                    break;
+                                }
+                                else if (atomType == MEDIA_DATA_ATOM)
+                                {
+                                    if (atomSize == 1)
+                                    {
+                                        uint64 largeSize = 0;
+                                        AtomUtils::read64(_movieFragmentFilePtr, largeSize);
+                                        uint32 size =
+                                            Oscl_Int64_Utils::get_uint64_lower32(largeSize);
+                                        count -= size;
+                                        size -= 8; //for large size
+                                        size -= DEFAULT_ATOM_SIZE;
+                                        AtomUtils::seekFromCurrPos(_movieFragmentFilePtr, size);
                                     }
-                                    else if (atomType == MEDIA_DATA_ATOM)
+                                    else
                                     {
-                                        if (atomSize == 1)
+                                        if (atomSize < DEFAULT_ATOM_SIZE)
                                         {
-                                            uint64 largeSize = 0;
-                                            AtomUtils::read64(_movieFragmentFilePtr, largeSize);
-                                            uint32 size =
-                                                Oscl_Int64_Utils::get_uint64_lower32(largeSize);
-                                            count -= size;
-                                            size -= 8; //for large size
-                                            size -= DEFAULT_ATOM_SIZE;
-                                            AtomUtils::seekFromCurrPos(_movieFragmentFilePtr, size);
+                                            _success = false;
+                                            _mp4ErrorCode = ZERO_OR_NEGATIVE_ATOM_SIZE;
+                                            break;
                                         }
-                                        else
+                                        if (count < (int32)atomSize)
                                         {
-                                            if (atomSize < DEFAULT_ATOM_SIZE)
-                                            {
-                                                _success = false;
-                                                _mp4ErrorCode = ZERO_OR_NEGATIVE_ATOM_SIZE;
-                                                break;
-                                            }
-                                            if (count < (int32)atomSize)
-                                            {
-                                                _success = false;
-                                                _mp4ErrorCode = READ_FAILED;
-                                                break;
-                                            }
-                                            count -= atomSize;
-                                            atomSize -= DEFAULT_ATOM_SIZE;
-                                            AtomUtils::seekFromCurrPos(_movieFragmentFilePtr, atomSize);
+                                            _success = false;
+                                            _mp4ErrorCode = READ_FAILED;
+                                            break;
                                         }
+                                        count -= atomSize;
+                                        atomSize -= DEFAULT_ATOM_SIZE;
+                                        AtomUtils::seekFromCurrPos(_movieFragmentFilePtr, atomSize);
                                     }
+                                }
 
-                                    else
+                                else
+                                {
+                                    if (count > 0)
                                     {
-                                        if (count > 0)
-                                        {
-                                            count -= atomSize;
-                                            atomSize -= DEFAULT_ATOM_SIZE;
-                                            AtomUtils::seekFromCurrPos(_movieFragmentFilePtr, atomSize);
-                                        }
-
+                                        count -= atomSize;
+                                        atomSize -= DEFAULT_ATOM_SIZE;
+                                        AtomUtils::seekFromCurrPos(_movieFragmentFilePtr, atomSize);
                                     }
+
                                 }
                             }
-
                         }
 
-                        if (_pmovieAtom != NULL)
-                            _pmovieAtom->resetTrackToEOT();
-
-                        if (_pMovieFragmentAtom != NULL)
-                            returnedTS = _pMovieFragmentAtom->resetPlayback(trackID, convertedTS, traf_number, trun_number, sample_num);
-                    }
-                    else
-                    {
-                        // Not a valid tfra entries, cannot reposition.
-                        return 0;
                     }
+
+                    if (_pmovieAtom != NULL)
+                        _pmovieAtom->resetTrackToEOT();
+
+                    if (_pMovieFragmentAtom != NULL)
+                        returnedTS = _pMovieFragmentAtom->resetPlayback(trackID, convertedTS, traf_number, trun_number, sample_num);
+                }
+                else
+                {
+                    // Not a valid tfra entries, cannot reposition.
+                    return 0;
                 }
 
             }
@@ -3828,65 +3841,62 @@ uint32 Mpeg4File::resetPlayback(uint32 time, uint16 numTracks, uint32 *trackList
             MediaClockConverter mcc1(1000);
             mcc1.update_clock(modifiedTimeStamp);
             convertedTS = mcc1.get_converted_ts(getTrackMediaTimescale(trackID));
-            if (oMfraFound)
+            MovieFragmentIndex *fragmentIndex = getMovieFragmentIndex();
+            if (fragmentIndex != NULL)
             {
-                for (uint32 idx = 0; idx < _pMovieFragmentRandomAccessAtomVec->size(); idx++)
+                uint32 ret = fragmentIndex->getSyncSampleInfoClosestToTime(trackID, convertedTS, moof_offset, traf_number, trun_number, sample_num);
+                if (ret == 0)
                 {
-                    MovieFragmentRandomAccessAtom *pMovieFragmentRandomAccessAtom = (*_pMovieFragmentRandomAccessAtomVec)[idx];
-                    uint32 ret = pMovieFragmentRandomAccessAtom->getSyncSampleInfoClosestToTime(trackID, convertedTS, moof_offset, traf_number, trun_number, sample_num);
-                    if (ret == 0)
+                    if (moofParsingCompleted)
                     {
-                        if (moofParsingCompleted)
-                        {
-                            // do nothing
-                        }
-                        else
-                        {
-                            uint32 i = _pMovieFragmentAtomVec->size();
-                            _pMoofOffsetVec->pop_back();
-                            _pMovieFragmentAtomVec->pop_back();
-                            PV_MP4_FF_DELETE(NULL, MovieFragmentAtom , (*_pMovieFragmentAtomVec)[i-1]);
-                            parseMoofCompletely = true;
-                            moofParsingCompleted = true;
-                            moofSize = 0;
-                            moofType = UNKNOWN_ATOM;
-                            moofCount = 0;
-                            moofPtrPos = 0;
-                        }
-                        //
-                        for (idx = 0; idx < _pMoofOffsetVec->size(); idx++)
+                        // do nothing
+                    }
+                    else
+                    {
+                        uint32 i = _pMovieFragmentAtomVec->size();
+                        _pMoofOffsetVec->pop_back();
+                        _pMovieFragmentAtomVec->pop_back();
+                        PV_MP4_FF_DELETE(NULL, MovieFragmentAtom , (*_pMovieFragmentAtomVec)[i-1]);
+                        parseMoofCompletely = true;
+                        moofParsingCompleted = true;
+                        moofSize = 0;
+                        moofType = UNKNOWN_ATOM;
+                        moofCount = 0;
+                        moofPtrPos = 0;
+                    }
+                    //
+                    for (uint32 idx = 0; idx < _pMoofOffsetVec->size(); idx++)
+                    {
+                        uint32 moof_start_offset = (*_pMoofOffsetVec)[idx];
+                        if (moof_start_offset == moof_offset)
                         {
-                            uint32 moof_start_offset = (*_pMoofOffsetVec)[idx];
-                            if (moof_start_offset == moof_offset)
+                            _movieFragmentIdx[trackID] = idx;
+                            _peekMovieFragmentIdx[trackID] = idx;
+                            _movieFragmentSeqIdx[trackID] = (*_pMovieFragmentAtomVec)[idx]->getSequenceNumber();
+                            _peekMovieFragmentSeqIdx[trackID] = _movieFragmentSeqIdx[trackID];
+                            _pMovieFragmentAtom = (*_pMovieFragmentAtomVec)[idx];
+                            currMoofNum = _pMovieFragmentAtom->getSequenceNumber();
+                            oMoofFound = true;
+
+                            AtomUtils::seekFromStart(_movieFragmentFilePtr, moof_offset);
+                            uint32 atomType = UNKNOWN_ATOM;
+                            uint32 atomSize = 0;
+                            AtomUtils::getNextAtomType(_movieFragmentFilePtr, atomSize, atomType);
+                            if (atomType == MOVIE_FRAGMENT_ATOM)
                             {
-                                _movieFragmentIdx[trackID] = idx;
-                                _peekMovieFragmentIdx[trackID] = idx;
-                                _movieFragmentSeqIdx[trackID] = (*_pMovieFragmentAtomVec)[idx]->getSequenceNumber();
-                                _peekMovieFragmentSeqIdx[trackID] = _movieFragmentSeqIdx[trackID];
-                                _pMovieFragmentAtom = (*_pMovieFragmentAtomVec)[idx];
-                                currMoofNum = _pMovieFragmentAtom->getSequenceNumber();
-                                oMoofFound = true;
-
-                                AtomUtils::seekFromStart(_movieFragmentFilePtr, moof_offset);
-                                uint32 atomType = UNKNOWN_ATOM;
-                                uint32 atomSize = 0;
-                                AtomUtils::getNextAtomType(_movieFragmentFilePtr, atomSize, atomType);
-                                if (atomType == MOVIE_FRAGMENT_ATOM)
-                                {
-                                    atomSize -= DEFAULT_ATOM_SIZE;
-                                    AtomUtils::seekFromCurrPos(_movieFragmentFilePtr, atomSize);
-                                    _ptrMoofEnds = AtomUtils::getCurrentFilePosition(_movieFragmentFilePtr);
-                                }
-                                break;
+                                atomSize -= DEFAULT_ATOM_SIZE;
+                                AtomUtils::seekFromCurrPos(_movieFragmentFilePtr, atomSize);
+                                _ptrMoofEnds = AtomUtils::getCurrentFilePosition(_movieFragmentFilePtr);
                             }
+                            break;
                         }
-                        //
-                    }
-                    else
-                    {
-                        // Not a valid tfra entries, cannot reposition.
-                        return 0;
                     }
+                    //
+                }
+                else
+                {
+                    // Not a valid tfra entries, cannot reposition.
+                    return 0;
                 }
                 if (_parsing_mode == 1 && !oMoofFound)
                 {
@@ -3977,7 +3987,7 @@ uint32 Mpeg4File::resetPlayback(uint32 time, uint16 numTracks, uint32 *trackList
                                     break;
 
                                 }
-                                if (oMfraFound)
+                                if (fragmentIndex != NULL)
                                 {
                                     currMoofNum = _pMovieFragmentAtom->getSequenceNumber();
                                     _movieFragmentIdx[trackID] = currMoofNum - 1 ;
@@ -4173,24 +4183,13 @@ int32 Mpeg4File::queryRepositionTime(uint32 time,
                 MediaClockConverter mcc1(1000);
                 mcc1.update_clock(modifiedTimeStamp);
                 convertedTS = mcc1.get_converted_ts(getTrackMediaTimescale(trackID));
-                if (oMfraFound)
+                MovieFragmentIndex *fragmentIndex = getMovieFragmentIndex();
+                if (fragmentIndex != NULL)
                 {
-                    oMfraFound = true;
-                    for (uint32 idx = 0; idx < _pMovieFragmentRandomAccessAtomVec->size(); idx++)
-                    {
-
-                        MovieFragmentRandomAccessAtom *pMovieFragmentRandomAccessAtom = (*_pMovieFragmentRandomAccessAtomVec)[idx];
-                        returnedTS = pMovieFragmentRandomAccessAtom->queryRepositionTime(trackID, convertedTS, bResetToIFrame,
-                                     bBeforeRequestedTime);
-                        if (returnedTS != 0)
-                        {
-                            break;
-                        }
-                    }
+                    returnedTS = fragmentIndex->queryRepositionTime(trackID, convertedTS, bBeforeRequestedTime);
                 }
                 else
                 {
-                    oMfraFound = false;
                     if (_parsing_mode == 1)
                         return -1;
                 }
@@ -4230,16 +4229,10 @@ int32 Mpeg4File::queryRepositionTime(uint32 time,
                 mcc1.update_clock(modifiedTimeStamp);
                 convertedTS = mcc1.get_converted_ts(getTrackMediaTimescale(trackID));
 
-                for (uint32 idx = 0; idx < _pMovieFragmentRandomAccessAtomVec->size(); idx++)
+                MovieFragmentIndex *fragmentIndex = getMovieFragmentIndex();
+                if (fragmentIndex != NULL)
                 {
-
-                    MovieFragmentRandomAccessAtom *pMovieFragmentRandomAccessAtom = (*_pMovieFragmentRandomAccessAtomVec)[idx];
-                    returnedTS = pMovieFragmentRandomAccessAtom->queryRepositionTime(trackID, convertedTS, bResetToIFrame,
-                                 bBeforeRequestedTime);
-                    if (returnedTS != 0)
-                    {
-                        break;
-                    }
+                    returnedTS = fragmentIndex->queryRepositionTime(trackID, convertedTS, bBeforeRequestedTime);
                 }
                 // convert returnedTS (which is in media time scale) to the ms
                 MediaClockConverter mcc(getTrackMediaTimescale(trackID));
@@ -4659,9 +4652,69 @@ bool Mpeg4File::IsTFRAPresentForTrack(uint32 TrackId, bool oVideoAudioTextTrack)
             return pMovieFragmentRandomAccessAtom->IsTFRAPresentForTrack(TrackId, oVideoAudioTextTrack);
         }
     }
+
+    // No mfra, fall back to the index built by scanning the moofs
+    MovieFragmentIndex *fragmentIndex = getMovieFragmentIndex();
+    if (fragmentIndex != NULL)
+    {
+        return fragmentIndex->hasEntriesForTrack(TrackId);
+    }
     return false;
 }
 
+MovieFragmentIndex* Mpeg4File::getMovieFragmentIndex()
+{
+    if (!_isMovieFragmentsPresent || (_pmovieAtom == NULL))
+    {
+        return NULL;
+    }
+
+    // Built once, on first use: from the tfra entries when an mfra is
+    // present, otherwise with a single scan of the moofs after the moov.
+    if (!_movieFragmentIndexAttempted)
+    {
+        _movieFragmentIndexAttempted = true;
+
+        PV_MP4_FF_NEW(fp->auditCB, MovieFragmentIndex, (), _pMovieFragmentIndex);
+        if (_pMovieFragmentIndex == NULL)
+        {
+            return NULL;
+        }
+
+        bool built = false;
+        if (oMfraFound)
+        {
+            for (uint32 idx = 0; idx < _pMovieFragmentRandomAccessAtomVec->size(); idx++)
+            {
+                built = _pMovieFragmentIndex->buildFromTFRA((*_pMovieFragmentRandomAccessAtomVec)[idx]);
+            }
+        }
+        else if (_movieFragmentFilePtr != NULL)
+        {
+            uint32 numTracks = _pmovieAtom->getNumTracks();
+            uint32 *trackList = (uint32 *) oscl_malloc(sizeof(uint32) * numTracks);
+            if (trackList != NULL)
+            {
+                _pmovieAtom->getTrackWholeIDList(trackList);
+                for (uint32 i = 0; i < numTracks; i++)
+                {
+                    uint32 trackDuration = Oscl_Int64_Utils::get_uint64_lower32(_pmovieAtom->getTrackMediaDuration(trackList[i]));
+                    _pMovieFragmentIndex->addTrack(trackList[i], trackDuration);
+                }
+                oscl_free(trackList);
+                built = _pMovieFragmentIndex->buildFromMoofScan(_movieFragmentFilePtr, _pointerMovieAtomEnd, _pTrackExtendsAtomVec);
+            }
+        }
+
+        if (!built)
+        {
+            PV_MP4_FF_DELETE(NULL, MovieFragmentIndex, _pMovieFragmentIndex);
+            _pMovieFragmentIndex = NULL;
+        }
+    }
+    return _pMovieFragmentIndex;
+}
+
 
 /*
 This function has been modified to check the entry count in TFRA for all tracks are equal.
@@ -4816,6 +4869,24 @@ MP4_ERROR_CODE Mpeg4File::CancelNotificationSync()
     }
 }
 
+OsclRefCounter* Mpeg4File::enableMappedSampleAccess(const uint32 trackID)
+{
+    if ((_pFileMapping == NULL) ||
+            (_pmovieAtom == NULL) ||
+            _isMovieFragmentsPresent)
+    {
+        return NULL;
+    }
+
+    if (!_pmovieAtom->setMappedFileBuffer(trackID,
+                                          _pFileMapping->Base(),
+                                          _pFileMapping->Size()))
+    {
+        return NULL;
+    }
+    return _pFileMapping;
+}
+
 bool Mpeg4File::CreateDataStreamSessionForExternalDownload(OSCL_wString& aFilename,
         PVMFCPMPluginAccessInterfaceFactory* aCPMAccessFactory,
         OsclFileHandle* aHandle,
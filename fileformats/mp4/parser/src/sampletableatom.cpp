@@ -55,7 +55,9 @@ SampleTableAtom::SampleTableAtom(MP4_FF_FILE *fp,
         _currentPlaybackSampleNumber(0),
         _trackStartTSOffset(0),
         _fileSize(0),
-        _IsUpdateFileSize(0)
+        _IsUpdateFileSize(0),
+        _pMappedFileBase(NULL),
+        _mappedFileSize(0)
 {
     _ptimeToSampleAtom      = NULL;
     _pcompositionOffsetAtom = NULL;
@@ -2275,7 +2277,7 @@ SampleTableAtom::getNextBundledAccessUnits(uint32 *n,
         return nReturn;
     }
 
-    nReturn = getNextNSamples(_currentPlaybackSampleNumber, n, pgau);
+    nReturn = getNextNSamples(_currentPlaybackSampleNumber, n, pgau, (_pMappedFileBase != NULL));
 
     if (nReturn == INSUFFICIENT_BUFFER_SIZE)
     {
@@ -2340,7 +2342,8 @@ SampleTableAtom::peekNextBundledAccessUnits(uint32 *n,
 int32
 SampleTableAtom::getNextNSamples(uint32 startSampleNum,
                                  uint32 *n,
-                                 GAU    *pgau)
+                                 GAU    *pgau,
+                                 bool   aMapped)
 {
     uint32 chunk = 0;
     int32  numSamplesPerChunk = 0, currTSBase = 0;
@@ -2381,6 +2384,12 @@ SampleTableAtom::getNextNSamples(uint32 startSampleNum,
     tempGau = *pgau;
     GAU* tempgauPtr = &tempGau;
 
+    if (aMapped)
+    {
+        // fragments are produced below, pointing into the file mapping
+        pgau->buf.num_fragments = 0;
+    }
+
     k = 0;
 
     uint32 totalnumSamples = getSampleSizeAtom().getSampleCount();
@@ -2406,6 +2415,13 @@ SampleTableAtom::getNextNSamples(uint32 startSampleNum,
     uint32 totalBytesRead = 0;
     while (samplesYetToBeRead)
     {
+        if (aMapped && (pgau->buf.num_fragments >= MAX_NUM_FRAGMENTS))
+        {
+            // every chunk that is not contiguous with the previous one
+            // needs its own fragment; return what fits, the rest is
+            // picked up by the next call.
+            break;
+        }
 #if (PVLOGGER_INST_LEVEL > PVLOGMSG_INST_LLDBG)
         currticks = OsclTickCount::TickCount();
         StartTime = OsclTickCount::TicksToMsec(currticks);
@@ -2737,7 +2753,7 @@ SampleTableAtom::getNextNSamples(uint32 startSampleNum,
             totalFragmentLength += tempgauPtr->buf.fragments[k].len;
         }
 
-        if (totalFragmentLength < sigmaSampleSize)
+        if (!aMapped && (totalFragmentLength < sigmaSampleSize))
         {
             //INSUFFICIENT BUFFER SIZE
             _currentPlaybackSampleNumber = startSampleNum;
@@ -2776,71 +2792,101 @@ SampleTableAtom::getNextNSamples(uint32 startSampleNum,
             _currChunkOffset += sigmaSampleSize;
         else
             _currChunkOffset  = 0;
-#if (PVLOGGER_INST_LEVEL > PVLOGMSG_INST_LLDBG)
-        currticks = OsclTickCount::TickCount();
-        StartTime = OsclTickCount::TicksToMsec(currticks);
-#endif
-#ifdef OPEN_FILE_ONCE_PER_TRACK
-        if (_oPVContentDownloadable)
+        if (aMapped)
         {
-            if (_currentPlaybackSampleNumber == 0)
+            if ((sigmaSampleSize + (uint32)sampleFileOffset) > _mappedFileSize)
             {
-                AtomUtils::seekFromStart(_pinput, sampleFileOffset);
+                *n = 0;
+                _mp4ErrorCode =  READ_FAILED;
+                return (_mp4ErrorCode);
+            }
+
+            uint8* samplePtr = (uint8*)(_pMappedFileBase + sampleFileOffset);
+            int32 last = pgau->buf.num_fragments - 1;
+            if ((last >= 0) &&
+                    (((uint8*)pgau->buf.fragments[last].ptr + pgau->buf.fragments[last].len) == samplePtr))
+            {
+                // consecutive chunks are usually back to back in the file
+                pgau->buf.fragments[last].len += sigmaSampleSize;
+            }
+            else
+            {
+                pgau->buf.fragments[last + 1].ptr = samplePtr;
+                pgau->buf.fragments[last + 1].len = sigmaSampleSize;
+                pgau->buf.buf_states[last + 1] = NULL;
+                pgau->buf.num_fragments++;
             }
+            totalBytesRead += sigmaSampleSize;
+            sigmaSampleSize = 0;
         }
         else
         {
-            AtomUtils::seekFromStart(_pinput, sampleFileOffset);
-        }
+#if (PVLOGGER_INST_LEVEL > PVLOGMSG_INST_LLDBG)
+            currticks = OsclTickCount::TickCount();
+            StartTime = OsclTickCount::TicksToMsec(currticks);
+#endif
+#ifdef OPEN_FILE_ONCE_PER_TRACK
+            if (_oPVContentDownloadable)
+            {
+                if (_currentPlaybackSampleNumber == 0)
+                {
+                    AtomUtils::seekFromStart(_pinput, sampleFileOffset);
+                }
+            }
+            else
+            {
+                AtomUtils::seekFromStart(_pinput, sampleFileOffset);
+            }
 #else
-        AtomUtils::seekFromStart(_pinput, sampleFileOffset);
+            AtomUtils::seekFromStart(_pinput, sampleFileOffset);
 #endif
 #if (PVLOGGER_INST_LEVEL > PVLOGMSG_INST_LLDBG)
-        currticks = OsclTickCount::TickCount();
-        EndTime = OsclTickCount::TicksToMsec(currticks);
-        totalTimeFileSeek += (EndTime - StartTime);
+            currticks = OsclTickCount::TickCount();
+            EndTime = OsclTickCount::TicksToMsec(currticks);
+            totalTimeFileSeek += (EndTime - StartTime);
 
-        currticks = OsclTickCount::TickCount();
-        StartTime = OsclTickCount::TicksToMsec(currticks);
+            currticks = OsclTickCount::TickCount();
+            StartTime = OsclTickCount::TicksToMsec(currticks);
 #endif
-        start = 0;
-        rewindPos = 0;
-        for (k = start; k < end; k++)
-        {
-            uint32 tmpSize =
-                (tempgauPtr->buf.fragments[k].len > sigmaSampleSize) ? sigmaSampleSize : tempgauPtr->buf.fragments[k].len;
-            if (tmpSize)
+            start = 0;
+            rewindPos = 0;
+            for (k = start; k < end; k++)
             {
-                if (!AtomUtils::readByteData(_pinput, tmpSize,
-                                             (uint8 *)(tempgauPtr->buf.fragments[k].ptr)))
+                uint32 tmpSize =
+                    (tempgauPtr->buf.fragments[k].len > sigmaSampleSize) ? sigmaSampleSize : tempgauPtr->buf.fragments[k].len;
+                if (tmpSize)
                 {
-                    *n = 0;
-                    _mp4ErrorCode =  READ_FAILED;
-                    return (_mp4ErrorCode);
-                }
-                tempgauPtr->buf.fragments[k].len -= tmpSize;
+                    if (!AtomUtils::readByteData(_pinput, tmpSize,
+                                                 (uint8 *)(tempgauPtr->buf.fragments[k].ptr)))
+                    {
+                        *n = 0;
+                        _mp4ErrorCode =  READ_FAILED;
+                        return (_mp4ErrorCode);
+                    }
+                    tempgauPtr->buf.fragments[k].len -= tmpSize;
 
-                uint8* fragment_ptr = NULL;
-                fragment_ptr = (uint8 *)(tempgauPtr->buf.fragments[k].ptr);
-                fragment_ptr += tmpSize;
-                tempgauPtr->buf.fragments[k].ptr = fragment_ptr;
+                    uint8* fragment_ptr = NULL;
+                    fragment_ptr = (uint8 *)(tempgauPtr->buf.fragments[k].ptr);
+                    fragment_ptr += tmpSize;
+                    tempgauPtr->buf.fragments[k].ptr = fragment_ptr;
 
-                sigmaSampleSize -= tmpSize;
-                totalBytesRead += tmpSize;
+                    sigmaSampleSize -= tmpSize;
+                    totalBytesRead += tmpSize;
 
-            }
-            rewindPos += tmpSize;
+                }
+                rewindPos += tmpSize;
 
-            if (sigmaSampleSize == 0)
-            {
-                break;
+                if (sigmaSampleSize == 0)
+                {
+                    break;
+                }
             }
-        }
 #if (PVLOGGER_INST_LEVEL > PVLOGMSG_INST_LLDBG)
-        currticks = OsclTickCount::TickCount();
-        EndTime = OsclTickCount::TicksToMsec(currticks);
-        totalTimeFileRead += (EndTime - StartTime);
+            currticks = OsclTickCount::TickCount();
+            EndTime = OsclTickCount::TicksToMsec(currticks);
+            totalTimeFileRead += (EndTime - StartTime);
 #endif
+        }
 
         sampleNum = sampleNum + numSamples;
 
@@ -72,6 +72,9 @@ SampleToChunkAtom::SampleToChunkAtom(MP4_FF_FILE *fp, uint32 size, uint32 type,
     _stbl_fptr_vec = NULL;
     _parsing_mode = parsingMode;
 
+    _pcumSampleVec = NULL;
+    _cum_index_disabled = false;
+
     iLogger = PVLogger::GetLoggerObject("mp4ffparser");
     iStateVarLogger = PVLogger::GetLoggerObject("mp4ffparser_mediasamplestats");
     iParsedDataLogger = PVLogger::GetLoggerObject("mp4ffparser_parseddata");
@@ -337,6 +340,7 @@ SampleToChunkAtom::~SampleToChunkAtom()
     if (_stbl_fptr_vec != NULL)
         PV_MP4_ARRAY_DELETE(NULL, _stbl_fptr_vec);
 
+    DeleteCumulativeIndex();
 }
 
 // Returns the chunk number of the first chunk in run[index]
@@ -542,6 +546,13 @@ SampleToChunkAtom::getChunkNumberForSample(uint32 sampleNum)
         return (uint32)PV_ERROR;
     }
 
+    if (BuildCumulativeIndex())
+    {
+        uint32 i = FindEntryForSampleNumber(sampleNum);
+        _Index = i;
+        return _pfirstChunkVec[i] + (sampleNum - _pcumSampleVec[i]) / _psamplesPerChunkVec[i];
+    }
+
     uint32 sampleCount = 0;
 
     for (uint32 i = 0; i < _entryCount; i++)
@@ -631,6 +642,12 @@ SampleToChunkAtom::getFirstSampleNumInChunk(uint32 chunkNum)
     // sample in chunk 'chunkNum'
     uint32 samplesInRun = 0;    // Number of samples in the entire run of chunks (not just in each chunk)
 
+    if (BuildCumulativeIndex() && (chunkNum >= _pfirstChunkVec[0]))
+    {
+        uint32 i = FindEntryForChunk(chunkNum);
+        return _pcumSampleVec[i] + (chunkNum - _pfirstChunkVec[i]) * _psamplesPerChunkVec[i];
+    }
+
     for (uint32 i = 0; i < _entryCount; i++)
     {
         // Go through vector of first chunks in runs
@@ -761,6 +778,11 @@ SampleToChunkAtom::getSamplesPerChunkCorrespondingToSample(uint32 sampleNum)
         return (uint32)PV_ERROR;
     }
 
+    if (BuildCumulativeIndex())
+    {
+        return _psamplesPerChunkVec[FindEntryForSampleNumber(sampleNum)];
+    }
+
     for (uint32 i = 0; i < _entryCount; i++)
     {
         if (_parsing_mode == 1)
@@ -1095,6 +1117,36 @@ SampleToChunkAtom::resetStateVariables(uint32 sampleNum)
 
     uint32 sampleCount = 0;
 
+    if ((_entryCount > 0) && BuildCumulativeIndex())
+    {
+        uint32 i = FindEntryForSampleNumber(sampleNum);
+        uint32 samplesPerChunkInRun = _psamplesPerChunkVec[i];
+        uint32 j = (sampleNum - _pcumSampleVec[i]) / samplesPerChunkInRun;
+
+        // The number of chunks in the last run is not known, it is treated as a
+        // run of one chunk
+        uint32 numChunksInRun = 1;
+        if ((i + 1) < _entryCount)
+        {
+            numChunksInRun = _pfirstChunkVec[i+1] - _pfirstChunkVec[i];
+            _numGetChunksInRun = numChunksInRun - j;
+        }
+        else
+        {
+            _numGetChunksInRun = 1;
+        }
+
+        _majorGetIndex = i;
+        _numChunksInRun = numChunksInRun;
+        _firstGetSampleInCurrChunk = _pcumSampleVec[i] + j * samplesPerChunkInRun;
+        _numGetSamplesPerChunk = samplesPerChunkInRun;
+        _currGetSampleCount = _firstGetSampleInCurrChunk + samplesPerChunkInRun;
+        _currGetChunk = _pfirstChunkVec[i] + j;
+        _currGetSDI = _psampleDescriptionIndexVec[i];
+
+        goto END_OF_RESET;
+    }
+
     for (uint32 i = 0; i < _entryCount; i++)
     {
         uint32 chunkNum = 0;
@@ -1238,3 +1290,98 @@ void SampleToChunkAtom::CheckAndParseEntry(uint32 i)
         }
     }
 }
+
+// Builds the cumulative index used to resolve samples and chunks with a binary
+// search instead of walking the table. Only done for fully parsed tables, where
+// the runs are already known to start on strictly increasing chunk numbers.
+bool SampleToChunkAtom::BuildCumulativeIndex()
+{
+    if (_pcumSampleVec != NULL)
+    {
+        return true;
+    }
+
+    if ((_parsing_mode != 0) || (_entryCount == 0) || _cum_index_disabled)
+    {
+        return false;
+    }
+
+    PV_MP4_FF_ARRAY_NEW(NULL, uint32, (_entryCount), _pcumSampleVec);
+    if (_pcumSampleVec == NULL)
+    {
+        // Not fatal, lookups fall back to the linear walk
+        _cum_index_disabled = true;
+        return false;
+    }
+
+    uint64 sampleCount = 0;
+    for (uint32 i = 0; i < _entryCount; i++)
+    {
+        // Runs of empty chunks never match a sample, and totals past 31 bits
+        // do not survive the signed chunk loops - keep the linear walk for those
+        if ((_psamplesPerChunkVec[i] == 0) || (sampleCount > 0x7FFFFFFF))
+        {
+            DeleteCumulativeIndex();
+            return false;
+        }
+        _pcumSampleVec[i] = (uint32)sampleCount;
+        if ((i + 1) < _entryCount)
+        {
+            sampleCount += (uint64)_psamplesPerChunkVec[i] *
+                           (_pfirstChunkVec[i+1] - _pfirstChunkVec[i]);
+        }
+    }
+
+    return true;
+}
+
+void SampleToChunkAtom::DeleteCumulativeIndex()
+{
+    if (_pcumSampleVec != NULL)
+        PV_MP4_ARRAY_DELETE(NULL, _pcumSampleVec);
+
+    _pcumSampleVec = NULL;
+    _cum_index_disabled = true;
+}
+
+// Returns the run holding sample sampleNum, i.e. the last run starting at or
+// before it. The last run is open ended.
+uint32 SampleToChunkAtom::FindEntryForSampleNumber(uint32 sampleNum)
+{
+    uint32 low = 1;
+    uint32 high = _entryCount;
+    while (low < high)
+    {
+        uint32 mid = low + ((high - low) >> 1);
+        if (_pcumSampleVec[mid] <= sampleNum)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low - 1;
+}
+
+// Returns the run holding chunk chunkNum, i.e. the last run starting at or
+// before it. chunkNum must not precede the first run.
+uint32 SampleToChunkAtom::FindEntryForChunk(uint32 chunkNum)
+{
+    uint32 low = 1;
+    uint32 high = _entryCount;
+    while (low < high)
+    {
+        uint32 mid = low + ((high - low) >> 1);
+        if (_pfirstChunkVec[mid] <= chunkNum)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low - 1;
+}
@@ -64,6 +64,15 @@ TimeToSampleAtom::TimeToSampleAtom(MP4_FF_FILE *fp,
     _curr_entry_point = 0;
     _stbl_fptr_vec = NULL;
 
+    _pcumSampleVec = NULL;
+    _pcumTimeVec = NULL;
+    _cum_index_disabled = false;
+    _pblockSampleVec = NULL;
+    _pblockTimeVec = NULL;
+    _cum_entry_cnt = 0;
+    _cum_sample_count = 0;
+    _cum_timestamp = 0;
+
     iLogger = PVLogger::GetLoggerObject("mp4ffparser");
     iStateVarLogger = PVLogger::GetLoggerObject("mp4ffparser_mediasamplestats");
     iParsedDataLogger = PVLogger::GetLoggerObject("mp4ffparser_parseddata");
@@ -104,6 +113,14 @@ TimeToSampleAtom::TimeToSampleAtom(MP4_FF_FILE *fp,
                             _mp4ErrorCode = MEMORY_ALLOCATION_FAILED;
                             return;
                         }
+                        PV_MP4_FF_ARRAY_NEW(NULL, uint32, (fptrBuffSize), _pblockSampleVec);
+                        PV_MP4_FF_ARRAY_NEW(NULL, uint32, (fptrBuffSize), _pblockTimeVec);
+                        if ((_pblockSampleVec == NULL) || (_pblockTimeVec == NULL))
+                        {
+                            _success = false;
+                            _mp4ErrorCode = MEMORY_ALLOCATION_FAILED;
+                            return;
+                        }
 
                         PV_MP4_FF_ARRAY_NEW(NULL, uint32, (_stbl_buff_size), _psampleCountVec);
                         if (_psampleCountVec == NULL)
@@ -236,6 +253,10 @@ bool TimeToSampleAtom::ParseEntryUnit(uint32 entry_cnt)
         {
             uint32 currFilePointer = AtomUtils::getCurrentFilePosition(_fileptr);
             _stbl_fptr_vec[_curr_buff_number] = currFilePointer;
+            // Blocks are first read in order, so the running totals describe
+            // exactly the entries preceding this block
+            _pblockSampleVec[_curr_buff_number] = _cum_sample_count;
+            _pblockTimeVec[_curr_buff_number] = _cum_timestamp;
             _next_buff_number++;
         }
 
@@ -255,6 +276,12 @@ bool TimeToSampleAtom::ParseEntryUnit(uint32 entry_cnt)
         }
         _psampleCountVec[_curr_entry_point] = (number);
         _psampleDeltaVec[_curr_entry_point] = (delta);
+        if (_parsed_entry_cnt == _cum_entry_cnt)
+        {
+            _cum_sample_count += number;
+            _cum_timestamp += number * delta;
+            _cum_entry_cnt++;
+        }
         _parsed_entry_cnt++;
     }
     return true;
@@ -272,6 +299,14 @@ TimeToSampleAtom::~TimeToSampleAtom()
     if (_stbl_fptr_vec != NULL)
         PV_MP4_ARRAY_DELETE(NULL, _stbl_fptr_vec);
 
+    DeleteCumulativeIndex();
+
+    if (_pblockSampleVec != NULL)
+        PV_MP4_ARRAY_DELETE(NULL, _pblockSampleVec);
+
+    if (_pblockTimeVec != NULL)
+        PV_MP4_ARRAY_DELETE(NULL, _pblockTimeVec);
+
     if (_fileptr != NULL)
     {
         if (_fileptr->IsOpen())
@@ -348,43 +383,66 @@ TimeToSampleAtom::getSampleNumberFromTimestamp(uint32 ts, bool oAlwaysRetSampleC
         return PV_ERROR;
     }
 
-    for (uint32 i = 0; i < _entryCount; i++)
+    if (BuildCumulativeIndex())
+    {
+        uint32 i = FindEntryForTimestamp(ts);
+        if (i < _entryCount)
+        {
+            if (ts == _pcumTimeVec[i])
+            { // Found sample at ts
+                return _pcumSampleVec[i];
+            }
+            // ts lies inside the run of entry i-1. Entry 0 starts at ts=0, so i > 0,
+            // and the run spans a non-zero duration, so its delta is non-zero.
+            return _pcumSampleVec[i-1] + (ts - _pcumTimeVec[i-1]) / _psampleDeltaVec[i-1];
+        }
+        sampleCount = _pcumSampleVec[_entryCount];
+        timeCount = _pcumTimeVec[_entryCount];
+    }
+    else
     {
+        uint32 i = 0;
         if (_parsing_mode == 1)
-            CheckAndParseEntry(i);
+            i = GetCheckpointEntry(ts, true, sampleCount, timeCount);
 
-        if (ts < timeCount)
-        { // found range that the sample is in - need to backtrack
+        for (; i < _entryCount; i++)
+        {
             if (_parsing_mode == 1)
-                CheckAndParseEntry(i - 1);
+                CheckAndParseEntry(i);
 
-            uint32 samples = _psampleCountVec[(i-1)%_stbl_buff_size];
-            sampleCount -= samples;
-            timeCount -= _psampleDeltaVec[(i-1)%_stbl_buff_size] * samples;
-            while (timeCount <= ts)
-            {
-                timeCount += _psampleDeltaVec[(i-1)%_stbl_buff_size];
-                sampleCount += 1;
-            }
+            if (ts < timeCount)
+            { // found range that the sample is in - need to backtrack
+                if (_parsing_mode == 1)
+                    CheckAndParseEntry(i - 1);
 
-            if (timeCount > ts)
-            {
-                if (sampleCount > 0)
+                uint32 samples = _psampleCountVec[(i-1)%_stbl_buff_size];
+                sampleCount -= samples;
+                timeCount -= _psampleDeltaVec[(i-1)%_stbl_buff_size] * samples;
+                while (timeCount <= ts)
+                {
+                    timeCount += _psampleDeltaVec[(i-1)%_stbl_buff_size];
+                    sampleCount += 1;
+                }
+
+                if (timeCount > ts)
                 {
-                    sampleCount--;
+                    if (sampleCount > 0)
+                    {
+                        sampleCount--;
+                    }
+                    return sampleCount;
                 }
+            }
+            else if (ts == timeCount)
+            { // Found sample at ts
                 return sampleCount;
             }
-        }
-        else if (ts == timeCount)
-        { // Found sample at ts
-            return sampleCount;
-        }
-        else
-        { // Sample not yet found - advance
-            uint32 samples = _psampleCountVec[i%_stbl_buff_size]; //number of samples at this index
-            sampleCount += samples;
-            timeCount += _psampleDeltaVec[i%_stbl_buff_size] * samples;
+            else
+            { // Sample not yet found - advance
+                uint32 samples = _psampleCountVec[i%_stbl_buff_size]; //number of samples at this index
+                sampleCount += samples;
+                timeCount += _psampleDeltaVec[i%_stbl_buff_size] * samples;
+            }
         }
     }
 
@@ -395,26 +453,19 @@ TimeToSampleAtom::getSampleNumberFromTimestamp(uint32 ts, bool oAlwaysRetSampleC
     sampleCount -= samples;
     timeCount -= delta * samples;
 
-    for (uint32 count = 0; count < (samples - 1); count++)
+    if (samples > 0)
     {
-        timeCount += delta;
-        sampleCount += 1;
-
-        if (timeCount > ts)
+        // ts is past the start of the last run, so the sample (if any) is
+        // found directly rather than by stepping through the run one by one
+        uint32 lastTimeCount = timeCount + delta * (samples - 1);
+        if ((delta > 0) && (ts <= lastTimeCount))
         {
-            if (sampleCount > 0)
-            {
-                sampleCount--;
-            }
-            return sampleCount;
-        }
-        else if (timeCount == ts)
-        {
-            return sampleCount;
+            return sampleCount + (ts - timeCount) / delta;
         }
+        sampleCount += samples - 1;
+        timeCount = lastTimeCount;
     }
 
-
     sampleCount += 1;
     if (ts >= timeCount)
     {
@@ -451,9 +502,26 @@ int32 TimeToSampleAtom::getTimestampForSampleNumber(uint32 num)
     if (num == 0)
         return 0;
 
+    if (BuildCumulativeIndex())
+    {
+        uint32 i = FindEntryForSampleNumber(num);
+        if (i < _entryCount)
+        { // Sample num within entry i
+            int32 ts = _pcumTimeVec[i] + _psampleDeltaVec[i] * (num - _pcumSampleVec[i]);
+            PVMF_MP4FFPARSER_LOGMEDIASAMPELSTATEVARIABLES((0, "TimeToSampleAtom::getTimestampForSampleNumber- Time Stamp =%d", ts));
+            return ts;
+        }
+        return PV_ERROR;
+    }
+
     uint32 sampleCount = 0;
-    int32 ts = 0; // Timestamp value to return
-    for (uint32 i = 0; i < _entryCount; i++)
+    uint32 timeCount = 0;
+    uint32 i = 0;
+    if (_parsing_mode == 1)
+        i = GetCheckpointEntry(num, false, sampleCount, timeCount);
+
+    int32 ts = timeCount; // Timestamp value to return
+    for (; i < _entryCount; i++)
     {
         if (_parsing_mode == 1)
             CheckAndParseEntry(i);
@@ -494,8 +562,23 @@ TimeToSampleAtom::getTimeDeltaForSampleNumber(uint32 num)
     if (num == 0)
         return 0;
 
+    if (BuildCumulativeIndex())
+    {
+        uint32 i = FindEntryForSampleNumber(num);
+        if (i < _entryCount)
+        { // Sample num within entry i
+            return (_psampleDeltaVec[i]);
+        }
+        return PV_ERROR;
+    }
+
     uint32 sampleCount = 0;
-    for (uint32 i = 0; i < _entryCount; i++)
+    uint32 timeCount = 0;
+    uint32 i = 0;
+    if (_parsing_mode == 1)
+        i = GetCheckpointEntry(num, false, sampleCount, timeCount);
+
+    for (; i < _entryCount; i++)
     {
         if (_parsing_mode == 1)
             CheckAndParseEntry(i);
@@ -645,8 +728,38 @@ TimeToSampleAtom::resetStateVariables(uint32 sampleNum)
         return PV_ERROR;
     }
 
+    if (BuildCumulativeIndex())
+    {
+        uint32 i = FindEntryForSampleNumber(sampleNum);
+        int32 status = EVERYTHING_FINE;
+        if (i == _entryCount)
+        {
+            // Went past end of list - leave the state on the last entry
+            i = _entryCount - 1;
+            status = PV_ERROR;
+        }
+
+        _currPeekIndex = i;
+        _currPeekSampleCount = _pcumSampleVec[i+1];
+        _currPeekTimeDelta = _psampleDeltaVec[i];
+
+        _currGetIndex = i;
+        _currGetSampleCount = _pcumSampleVec[i+1];
+        _currGetTimeDelta = _psampleDeltaVec[i];
+        return status;
+    }
+
+    uint32 i = 0;
+    if (_parsing_mode)
+    {
+        uint32 timeCount = 0;
+        i = GetCheckpointEntry(sampleNum, false, _currPeekSampleCount, timeCount);
+        _currPeekIndex = i - 1;
+        _currGetIndex = i - 1;
+        _currGetSampleCount = _currPeekSampleCount;
+    }
 
-    for (uint32 i = 0; i < _entryCount; i++)
+    for (; i < _entryCount; i++)
     {
         if (_parsing_mode)
             CheckAndParseEntry(i);
@@ -696,3 +809,145 @@ void TimeToSampleAtom::CheckAndParseEntry(uint32 i)
     }
 }
 
+// Builds the cumulative index used to resolve samples and timestamps with a
+// binary search instead of walking the table. Only done for fully parsed
+// tables; in partial parsing mode the per-block checkpoints are used instead.
+bool TimeToSampleAtom::BuildCumulativeIndex()
+{
+    if (_pcumSampleVec != NULL)
+    {
+        return true;
+    }
+
+    if ((_parsing_mode != 0) || (_parsed_entry_cnt != _entryCount) ||
+            _cum_index_disabled)
+    {
+        return false;
+    }
+
+    PV_MP4_FF_ARRAY_NEW(NULL, uint32, (_entryCount + 1), _pcumSampleVec);
+    PV_MP4_FF_ARRAY_NEW(NULL, uint32, (_entryCount + 1), _pcumTimeVec);
+    if ((_pcumSampleVec == NULL) || (_pcumTimeVec == NULL))
+    {
+        // Not fatal, lookups fall back to the linear walk
+        DeleteCumulativeIndex();
+        return false;
+    }
+
+    uint64 sampleCount = 0;
+    uint64 timeCount = 0;
+    for (uint32 i = 0; i <= _entryCount; i++)
+    {
+        if ((sampleCount > 0xFFFFFFFF) || (timeCount > 0xFFFFFFFF))
+        {
+            // The totals wrap around 32 bits, so the starts are no longer sorted.
+            // Keep the linear walk, which wraps the same way as before.
+            DeleteCumulativeIndex();
+            return false;
+        }
+        _pcumSampleVec[i] = (uint32)sampleCount;
+        _pcumTimeVec[i] = (uint32)timeCount;
+        if (i < _entryCount)
+        {
+            sampleCount += _psampleCountVec[i];
+            timeCount += (uint64)_psampleDeltaVec[i] * _psampleCountVec[i];
+        }
+    }
+
+    return true;
+}
+
+void TimeToSampleAtom::DeleteCumulativeIndex()
+{
+    if (_pcumSampleVec != NULL)
+        PV_MP4_ARRAY_DELETE(NULL, _pcumSampleVec);
+
+    if (_pcumTimeVec != NULL)
+        PV_MP4_ARRAY_DELETE(NULL, _pcumTimeVec);
+
+    _pcumSampleVec = NULL;
+    _pcumTimeVec = NULL;
+    _cum_index_disabled = true;
+}
+
+// Returns the first entry starting at or after ts, or _entryCount if none does
+uint32 TimeToSampleAtom::FindEntryForTimestamp(uint32 ts)
+{
+    uint32 low = 0;
+    uint32 high = _entryCount;
+    while (low < high)
+    {
+        uint32 mid = low + ((high - low) >> 1);
+        if (_pcumTimeVec[mid] < ts)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// Returns the first entry whose run ends at or after sample num, or
+// _entryCount if the sample is past the end of the table
+uint32 TimeToSampleAtom::FindEntryForSampleNumber(uint32 num)
+{
+    uint32 low = 0;
+    uint32 high = _entryCount;
+    while (low < high)
+    {
+        uint32 mid = low + ((high - low) >> 1);
+        if (_pcumSampleVec[mid+1] < num)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// Partial parsing mode: returns the first entry of the last block read so far
+// that starts strictly before value (a timestamp or a sample number), along with
+// the sample number and timestamp at which that block starts. A linear walk
+// from there gives the same result as one from entry 0.
+uint32 TimeToSampleAtom::GetCheckpointEntry(uint32 value, bool byTimestamp,
+        uint32& sampleCount, uint32& timestamp)
+{
+    sampleCount = 0;
+    timestamp = 0;
+
+    if (_pblockSampleVec == NULL)
+    {
+        return 0;
+    }
+
+    uint32 low = 0;
+    uint32 high = _next_buff_number;
+    while (low < high)
+    {
+        uint32 mid = low + ((high - low) >> 1);
+        uint32 start = byTimestamp ? _pblockTimeVec[mid] : _pblockSampleVec[mid];
+        if (start < value)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    if (low == 0)
+    {
+        return 0;
+    }
+
+    sampleCount = _pblockSampleVec[low-1];
+    timestamp = _pblockTimeVec[low-1];
+    return (low - 1) * _stbl_buff_size;
+}
@@ -1611,6 +1611,7 @@ OSCL_EXPORT_REF bool CAACFileParser::InitAACFile(OSCL_wString& aClip,  bool aIni
     //use native cache (if supported by the platform) size 32KB.
     PVFileCacheParams cacheParams;
     cacheParams.iCacheSize = 32768; //32K
+    cacheParams.iCacheReadAheadSize = PVFILE_PLAYBACK_CACHE_READ_AHEAD_SIZE;
     cacheParams.iNativeAccessMode = 1;
 
     iAACFile.SetFileCacheParams(cacheParams);
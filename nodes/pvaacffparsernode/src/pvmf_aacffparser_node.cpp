@@ -43,6 +43,7 @@
 PVMFAACFFParserNode::PVMFAACFFParserNode(int32 aPriority)
         : OsclTimerObject(aPriority, "PVMFAACFFParserNode")
 {
+    SetTelemetryActiveObject(this);
     iOutPort = NULL;
     iCurrentCmdId = 0;
     iAACParser = NULL;
@@ -278,6 +279,13 @@ PVMFPortIter* PVMFAACFFParserNode::GetPorts(const PVMFPortFilter* aFilter)
     return NULL;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+PVMFStatus PVMFAACFFParserNode::GetNodeTelemetry(PVMFNodeTelemetry& aTelemetry)
+{
+    PVMFPortInterface* ports[] = {iOutPort};
+    return GetNodeTelemetryForPorts(aTelemetry, ports, 1);
+}
+
 
 PVMFCommandId PVMFAACFFParserNode::QueryUUID(PVMFSessionId s, const PvmfMimeString& aMimeType,
         Oscl_Vector<PVUuid, OsclMemAllocator>& aUuids,
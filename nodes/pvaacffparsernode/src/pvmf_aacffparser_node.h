@@ -705,6 +705,7 @@ class PVMFAACFFParserNode :  public OsclTimerObject
         PVMFStatus ThreadLogoff();
         PVMFStatus GetCapability(PVMFNodeCapability& aNodeCapability);
         PVMFPortIter* GetPorts(const PVMFPortFilter* aFilter = NULL);
+        PVMFStatus GetNodeTelemetry(PVMFNodeTelemetry& aTelemetry);
         PVMFCommandId QueryUUID(PVMFSessionId, const PvmfMimeString& aMimeType,
                                 Oscl_Vector<PVUuid, PVMFAACFFParserNodeAllocator>& aUuids,
                                 bool aExactUuidsOnly = false,
@@ -59,6 +59,7 @@ PVMFAMRFFParserNode::PVMFAMRFFParserNode(int32 aPriority) :
         iAMRParser(NULL),
         iExtensionRefCount(0)
 {
+    SetTelemetryActiveObject(this);
     iFileHandle                = NULL;
     iLogger                    = NULL;
     iDataPathLogger            = NULL;
@@ -243,6 +244,13 @@ PVMFPortIter* PVMFAMRFFParserNode::GetPorts(const PVMFPortFilter* aFilter)
     return NULL;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+PVMFStatus PVMFAMRFFParserNode::GetNodeTelemetry(PVMFNodeTelemetry& aTelemetry)
+{
+    PVMFPortInterface* ports[] = {iOutPort};
+    return GetNodeTelemetryForPorts(aTelemetry, ports, 1);
+}
+
 PVMFCommandId PVMFAMRFFParserNode::QueryUUID(PVMFSessionId s, const PvmfMimeString& aMimeType,
         Oscl_Vector<PVUuid, OsclMemAllocator>& aUuids,
         bool aExactUuidsOnly, const OsclAny* aContext)
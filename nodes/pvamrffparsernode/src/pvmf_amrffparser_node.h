@@ -394,6 +394,7 @@ class PVMFAMRFFParserNode :  public OsclTimerObject
         PVMFStatus ThreadLogoff();
         PVMFStatus GetCapability(PVMFNodeCapability& aNodeCapability);
         PVMFPortIter* GetPorts(const PVMFPortFilter* aFilter = NULL);
+        PVMFStatus GetNodeTelemetry(PVMFNodeTelemetry& aTelemetry);
         PVMFCommandId QueryUUID(PVMFSessionId, const PvmfMimeString& aMimeType,
                                 Oscl_Vector<PVUuid, PVMFAMRFFNodeAllocator>& aUuids,
                                 bool aExactUuidsOnly = false,
@@ -146,6 +146,10 @@ class PVMFMemoryBufferDataStreamTempCache
 
     private:
 
+        // binary search for the entry holding the file offset, returns index into iEntries
+        // caller makes sure the offset is in the cache
+        uint32 FindEntry(uint32 aFileOffset);
+
         struct MBDSTempCacheEntry
         {
             // mem frag was allocated by protocol engine
@@ -164,8 +168,11 @@ class PVMFMemoryBufferDataStreamTempCache
         uint32 iFirstByteFileOffset;
         // file offset of last byte in cache, use iLock
         uint32 iLastByteFileOffset;
-        // list of temp cache entries
+        // list of temp cache entries, sorted by file offset
         Oscl_Vector<MBDSTempCacheEntry*, OsclMemAllocator> iEntries;
+        // index of the first/oldest entry in iEntries, the removed entries before it
+        // are compacted out in batches instead of shifting the list on every removal
+        uint32 iFirstEntry;
 
         PVLogger* iLogger;
 };
@@ -199,6 +206,10 @@ class PVMFMemoryBufferDataStreamPermCache
 
     private:
 
+        // binary search for the entry holding the file offset, returns index into iEntries
+        // caller makes sure the offset is in the cache
+        uint32 FindEntry(uint32 aFileOffset);
+
         struct MBDSPermCacheEntry
         {
             // mem ptr from malloc, saved for freeing later
@@ -229,7 +240,7 @@ class PVMFMemoryBufferDataStreamPermCache
         uint32 iFirstPermByteOffset;
         // file offset of last byte to be made persistent
         uint32 iLastPermByteOffset;
-        // list of perm cache entries
+        // list of perm cache entries, sorted by file offset
         Oscl_Vector<MBDSPermCacheEntry*, OsclMemAllocator> iEntries;
 
         PVLogger* iLogger;
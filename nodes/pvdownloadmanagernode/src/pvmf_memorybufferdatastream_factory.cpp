@@ -725,7 +725,18 @@ PVMFMemoryBufferReadDataStreamImpl::Seek(PvmiDataStreamSession aSessionID, int32
                 uint32 lastTempByteOffset = 0;
                 iTempCache->GetFileOffsets(firstTempByteOffset, lastTempByteOffset);
 
-                if ((skipTo >= firstTempByteOffset) &&
+                uint32 firstPermByteOffset = 0;
+                uint32 lastPermByteOffset = 0;
+                iPermCache->GetFileOffsets(firstPermByteOffset, lastPermByteOffset);
+
+                if ((0 != iPermCache->GetNumEntries()) &&
+                        (skipTo >= firstPermByteOffset) && (skipTo < lastPermByteOffset))
+                {
+                    // data is already in the perm cache, e.g. a prefetched movie atom
+                    LOGDEBUG((0, "PVMFMemoryBufferReadDataStreamImpl::Seek/Skip data is in perm cache session %d offset %d", iSessionID, skipTo));
+                    skip = false;
+                }
+                else if ((skipTo >= firstTempByteOffset) &&
                         (lastTempByteOffset + PV_MBDS_FWD_SEEKING_NO_GET_REQUEST_THRESHOLD >= skipTo))
                 {
                     // Seeking forward,, eed to see if the data may be coming shortly before sending request
@@ -1039,6 +1050,27 @@ PVMFMemoryBufferReadDataStreamImpl::MakePersistent(int32 aOffset, uint32 aSize)
         LOGDEBUG((0, "PVMFMemoryBufferReadDataStreamImpl::MakePersistent data not in temp cache yet"));
 
         status = iPermCache->AddEntry(memBuf, bufSize, memBuf, copyFirstByteOffset, copyLastByteOffset, copyFirstByteOffset, 0);
+
+        if ((PVDS_SUCCESS == status) && (copyFirstByteOffset > lastTempByteOffset) && (NULL != iWriteDataStream))
+        {
+            // the range is ahead of the download, e.g. a movie atom at the end of the clip
+            // if the data on its way will not reach it, fetch it now with a request starting at the range
+            uint32 writeCapacity = 0;
+            iWriteDataStream->QueryWriteCapacity(0, writeCapacity);
+            uint32 writeFilePtr = iWriteDataStream->GetCurrentPointerPosition(0);
+            if (copyFirstByteOffset > (writeFilePtr + writeCapacity + PV_MBDS_BYTES_TO_WAIT))
+            {
+                LOGDEBUG((0, "PVMFMemoryBufferReadDataStreamImpl::MakePersistent prefetch offset %d write ptr %d",
+                          copyFirstByteOffset, writeFilePtr));
+
+                iWriteDataStream->MakePersistent(aOffset, aSize);
+                if (PVDS_SUCCESS != iWriteDataStream->Reposition(iSessionID, copyFirstByteOffset, MBDS_REPOSITION_EXACT))
+                {
+                    // the range will be filled when the download gets there
+                    LOGERROR((0, "PVMFMemoryBufferReadDataStreamImpl::MakePersistent prefetch reposition failed"));
+                }
+            }
+        }
     }
     else if ((copyFirstByteOffset >= firstTempByteOffset) && (copyLastByteOffset <= lastTempByteOffset))
     {
@@ -1812,6 +1844,22 @@ PVMFMemoryBufferWriteDataStreamImpl::Write(PvmiDataStreamSession aSessionID, Osc
                 // notify the writer that the buffer should not be freed
                 // as it has become a part of the cache
                 status = PVDS_PENDING;
+
+                if (permEntries && (iFilePtrPos < firstPermOffset) && ((iFilePtrPos + fragSize) > firstPermOffset))
+                {
+                    // the end of this frag is the start of a range made persistent ahead of the download,
+                    // copy that part to the perm cache as well
+                    uint32 permFragOffset = firstPermOffset - iFilePtrPos;
+                    uint32 permFragSize = fragSize - permFragOffset;
+                    if (permFragSize > (lastPermOffset - firstPermOffset + 1))
+                    {
+                        permFragSize = lastPermOffset - firstPermOffset + 1;
+                    }
+                    if (PVDS_SUCCESS != iPermCache->WriteBytes(fragPtr + permFragOffset, permFragSize, firstPermOffset))
+                    {
+                        LOGERROR((0, "PVMFMemoryBufferWriteDataStreamImpl::Write WriteBytes FAILED"));
+                    }
+                }
             }
             // Check if there are frags that are not being read from
             // at the beginning of the cache that can be returned to the writer (protocol engine)
@@ -2001,12 +2049,14 @@ PVMFMemoryBufferWriteDataStreamImpl::Reposition(PvmiDataStreamSession aSessionID
                 bool hasPerm = false;
                 if (iMadePersistent)
                 {
-                    if (0 != iPermCache->GetNumEntries())
+                    uint32 firstPermByteOffset = 0;
+                    uint32 lastPermByteOffset = 0;
+                    iPermCache->GetFileOffsets(firstPermByteOffset, lastPermByteOffset);
+
+                    // a perm cache further into the clip (prefetched range) does not limit the margin
+                    if ((0 != iPermCache->GetNumEntries()) && (aOffset >= firstPermByteOffset))
                     {
                         hasPerm = true;
-                        uint32 firstPermByteOffset = 0;
-                        uint32 lastPermByteOffset = 0;
-                        iPermCache->GetFileOffsets(firstPermByteOffset, lastPermByteOffset);
 
                         // should never reposition outside of the temp cache
                         if (aOffset >= lastPermByteOffset + PV_MBDS_TEMP_CACHE_TRIM_MARGIN_PS)
@@ -2885,6 +2935,7 @@ PVMFMemoryBufferDataStreamTempCache::PVMFMemoryBufferDataStreamTempCache()
     iTotalBytes = 0;
     iFirstByteFileOffset = 0;
     iLastByteFileOffset = 0;
+    iFirstEntry = 0;
 
     iLogger = PVLogger::GetLoggerObject("PVMFMemoryBufferDataStream");
     LOGTRACE((0, "PVMFMemoryBufferDataStreamTempCache::PVMFMemoryBufferDataStreamTempCache %x", this));
@@ -2900,6 +2951,7 @@ PVMFMemoryBufferDataStreamTempCache::~PVMFMemoryBufferDataStreamTempCache()
     {
         iEntries.clear();
     }
+    iFirstEntry = 0;
 
     iLogger = NULL;
 }
@@ -2934,7 +2986,7 @@ PVMFMemoryBufferDataStreamTempCache::AddEntry(OsclRefCounterMemFrag* aFrag, uint
     // Caller is write data stream,
     // it has checked for contiguous write
     // May want to double check, just in case
-    if (!iEntries.empty() && (aFileOffset != (iLastByteFileOffset + 1)))
+    if ((0 != GetNumEntries()) && (aFileOffset != (iLastByteFileOffset + 1)))
     {
         status = PVDS_INVALID_REQUEST;
     }
@@ -2950,7 +3002,7 @@ PVMFMemoryBufferDataStreamTempCache::AddEntry(OsclRefCounterMemFrag* aFrag, uint
 
             iEntries.push_back(entry);
 
-            if (1 == iEntries.size())
+            if (1 == GetNumEntries())
             {
                 // If there is only one entry,
                 // set the first byte offset
@@ -2998,10 +3050,10 @@ PVMFMemoryBufferDataStreamTempCache::RemoveFirstEntry(OsclRefCounterMemFrag*& aF
 
     bool found = false;
 
-    if (!iEntries.empty())
+    if (0 != GetNumEntries())
     {
         // Remove and return the first/oldest entry in the cache and free the memory
-        MBDSTempCacheEntry* entry = iEntries.front();
+        MBDSTempCacheEntry* entry = iEntries[iFirstEntry];
 
         found = true;
 
@@ -3013,21 +3065,31 @@ PVMFMemoryBufferDataStreamTempCache::RemoveFirstEntry(OsclRefCounterMemFrag*& aF
         aFrag = entry->frag;
         aFragPtr = entry->fragPtr;
 
-        iEntries.erase(iEntries.begin());
+        iFirstEntry++;
 
         OSCL_FREE(entry);
 
-        if (!iEntries.empty())
+        if (0 != GetNumEntries())
         {
             iTotalBytes -= size;
 
             // Next entry becomes first entry
-            entry = iEntries.front();
+            entry = iEntries[iFirstEntry];
             iFirstByteFileOffset = entry->fileOffset;
+
+            // Drop the removed entries from the list once they make up half of it,
+            // so trimming many entries does not shift the whole list each time
+            if ((iFirstEntry << 1) >= iEntries.size())
+            {
+                iEntries.erase(iEntries.begin(), iEntries.begin() + iFirstEntry);
+                iFirstEntry = 0;
+            }
         }
         else
         {
             // no more entries
+            iEntries.clear();
+            iFirstEntry = 0;
             iFirstByteFileOffset = 0;
             iLastByteFileOffset = 0;
             iTotalBytes = 0;
@@ -3052,7 +3114,7 @@ PVMFMemoryBufferDataStreamTempCache::RemoveLastEntry(OsclRefCounterMemFrag*& aFr
 
     bool found = false;
 
-    if (!iEntries.empty())
+    if (0 != GetNumEntries())
     {
         // Remove and return the last/newest entry in the cache
         // Free the memory
@@ -3070,7 +3132,7 @@ PVMFMemoryBufferDataStreamTempCache::RemoveLastEntry(OsclRefCounterMemFrag*& aFr
 
         OSCL_FREE(entry);
 
-        if (!iEntries.empty())
+        if (0 != GetNumEntries())
         {
             // Second last entry becomes last entry
             iTotalBytes -= size;
@@ -3079,6 +3141,8 @@ PVMFMemoryBufferDataStreamTempCache::RemoveLastEntry(OsclRefCounterMemFrag*& aFr
         else
         {
             // no more entries
+            iEntries.clear();
+            iFirstEntry = 0;
             iFirstByteFileOffset = 0;
             iLastByteFileOffset = 0;
             iTotalBytes = 0;
@@ -3093,14 +3157,36 @@ PVMFMemoryBufferDataStreamTempCache::RemoveLastEntry(OsclRefCounterMemFrag*& aFr
 }
 
 
+uint32
+PVMFMemoryBufferDataStreamTempCache::FindEntry(uint32 aFileOffset)
+{
+    // entries are contiguous and sorted by file offset,
+    // find the last entry starting at or before the offset
+    uint32 low = iFirstEntry;
+    uint32 high = iEntries.size() - 1;
+    while (low < high)
+    {
+        uint32 mid = low + ((high - low + 1) >> 1);
+        if (iEntries[mid]->fileOffset <= aFileOffset)
+        {
+            low = mid;
+        }
+        else
+        {
+            high = mid - 1;
+        }
+    }
+    return low;
+}
+
+
 uint32
 PVMFMemoryBufferDataStreamTempCache::ReadBytes(uint8* aBuffer, uint32 aFirstByte, uint32 aLastByte, uint32& firstEntry)
 {
     LOGTRACE((0, "PVMFMemoryBufferDataStreamTempCache::ReadBytes buf %x first %d last %d", aBuffer, aFirstByte, aLastByte));
 
     // Caller is the read data stream, it limits the read to what is in the cache
-    // the first byte should be in the cache, need to go through the cache entries for the file offset
-    bool found = false;
+    // the first byte should be in the cache, look up the cache entry for the file offset
     uint32 count = iEntries.size();
     uint32 bytesRead = 0;
     uint32 bytesToRead = 0;
@@ -3109,69 +3195,47 @@ PVMFMemoryBufferDataStreamTempCache::ReadBytes(uint8* aBuffer, uint32 aFirstByte
 
     firstEntry = 0;
 
-    for (uint32 i = 0; i < count; i++)
+    if ((0 == GetNumEntries()) || (aFirstByte < iFirstByteFileOffset) || (aFirstByte > iLastByteFileOffset))
     {
-        if (!found)
+        LOGTRACE((0, "PVMFMemoryBufferDataStreamTempCache::ReadBytes returning 0, first byte not in cache"));
+        return 0;
+    }
+
+    uint32 i = FindEntry(aFirstByte);
+    firstEntry = i - iFirstEntry;
+
+    // the first byte to be read is in this frag
+    dataPtr = iEntries[i]->fragPtr + (aFirstByte - iEntries[i]->fileOffset);
+    if (aLastByte < (iEntries[i]->fileOffset + iEntries[i]->fragSize))
+    {
+        // every byte to be read is in this one frag
+        bytesToRead = aLastByte - aFirstByte + 1;
+    }
+    else
+    {
+        // only a portion is in this frag, the rest of the data should be in the next frag or frags
+        bytesToRead = iEntries[i]->fragSize - (aFirstByte - iEntries[i]->fileOffset);
+    }
+    oscl_memcpy(bufferPtr, dataPtr, bytesToRead);
+    bytesRead += bytesToRead;
+    bufferPtr += bytesToRead;
+
+    for (++i; (i < count) && (aLastByte >= iEntries[i]->fileOffset); i++)
+    {
+        dataPtr = iEntries[i]->fragPtr;
+        if (aLastByte < (iEntries[i]->fileOffset + iEntries[i]->fragSize))
         {
-            // haven't found the first offset yet
-            if ((aFirstByte >= iEntries[i]->fileOffset) && (aFirstByte < (iEntries[i]->fileOffset + iEntries[i]->fragSize)))
-            {
-                // the first byte to be read is in this frag
-                found = true;
-                if (aLastByte < (iEntries[i]->fileOffset + iEntries[i]->fragSize))
-                {
-                    //LOGDEBUG((0, "TC1 entry %d offset %d size %d", i, iEntries[i]->fileOffset, iEntries[i]->fragSize));
-                    // every byte to be read is in this one frag
-                    dataPtr = iEntries[i]->fragPtr + (aFirstByte - iEntries[i]->fileOffset);
-                    bytesToRead = aLastByte - aFirstByte + 1;
-                    // copy the data to the buffer
-                    oscl_memcpy(bufferPtr, dataPtr, bytesToRead);
-                    bytesRead += bytesToRead;
-                    firstEntry = i;
-                    // done
-                    break;
-                }
-                else
-                {
-                    //LOGDEBUG((0, "TC2 entry %d offset %d size %d", i, iEntries[i]->fileOffset, iEntries[i]->fragSize));
-                    // only a portion is in this frag
-                    dataPtr = iEntries[i]->fragPtr + (aFirstByte - iEntries[i]->fileOffset);
-                    bytesToRead = iEntries[i]->fragSize - (aFirstByte - iEntries[i]->fileOffset);
-                    // copy the data, the rest of the data should be in the next frag or frags
-                    oscl_memcpy(bufferPtr, dataPtr, bytesToRead);
-                    bytesRead += bytesToRead;
-                    bufferPtr += bytesToRead;
-                    firstEntry = i;
-                }
-            }
+            // what is left to be read is in this one frag
+            bytesToRead = aLastByte - iEntries[i]->fileOffset + 1;
         }
         else
         {
-            // the first byte was in the previous frag, more data to copy from this frag
-            if (aLastByte < (iEntries[i]->fileOffset + iEntries[i]->fragSize))
-            {
-                //LOGDEBUG((0, "TC3 entry %d offset %d size %d", i, iEntries[i]->fileOffset, iEntries[i]->fragSize));
-                // what is left to be read is in this one frag
-                dataPtr = iEntries[i]->fragPtr;
-                bytesToRead = aLastByte - iEntries[i]->fileOffset + 1;
-                // copy the data to the buffer
-                oscl_memcpy(bufferPtr, dataPtr, bytesToRead);
-                bytesRead += bytesToRead;
-                // done
-                break;
-            }
-            else
-            {
-                //LOGDEBUG((0, "TC4 entry %d offset %d size %d", i, iEntries[i]->fileOffset, iEntries[i]->fragSize));
-                // all of this frag is needed
-                dataPtr = iEntries[i]->fragPtr;
-                bytesToRead = iEntries[i]->fragSize;
-                // copy the data, the rest of the data should be in the next frag or frags
-                oscl_memcpy(bufferPtr, dataPtr, bytesToRead);
-                bytesRead += bytesToRead;
-                bufferPtr += bytesToRead;
-            }
+            // all of this frag is needed
+            bytesToRead = iEntries[i]->fragSize;
         }
+        oscl_memcpy(bufferPtr, dataPtr, bytesToRead);
+        bytesRead += bytesToRead;
+        bufferPtr += bytesToRead;
     }
 
     LOGTRACE((0, "PVMFMemoryBufferDataStreamTempCache::ReadBytes returning %d firstEntry %d", bytesRead, firstEntry));
@@ -3185,9 +3249,9 @@ PVMFMemoryBufferDataStreamTempCache::GetFirstEntryInfo(uint32& entryOffset, uint
     LOGTRACE((0, "PVMFMemoryBufferDataStreamTempCache::GetFirstEntryInfo"));
 
     // Return the frag size of the first/oldest entry in cache
-    if (!iEntries.empty())
+    if (0 != GetNumEntries())
     {
-        MBDSTempCacheEntry* entry = iEntries.front();
+        MBDSTempCacheEntry* entry = iEntries[iFirstEntry];
 
         entrySize = entry->fragSize;
         entryOffset = entry->fileOffset;
@@ -3203,7 +3267,7 @@ PVMFMemoryBufferDataStreamTempCache::GetLastEntryInfo(uint32& entryOffset, uint3
     LOGTRACE((0, "PVMFMemoryBufferDataStreamCache::GetLastEntryInfo"));
 
     // Return the frag size of the last/newest entry in cache
-    if (!iEntries.empty())
+    if (0 != GetNumEntries())
     {
         MBDSTempCacheEntry* entry = iEntries.back();
 
@@ -3218,9 +3282,9 @@ PVMFMemoryBufferDataStreamTempCache::GetLastEntryInfo(uint32& entryOffset, uint3
 uint32
 PVMFMemoryBufferDataStreamTempCache::GetNumEntries()
 {
-    LOGTRACE((0, "PVMFMemoryBufferDataStreamTempCache::GetNumEntries returning %d", iEntries.size()));
+    LOGTRACE((0, "PVMFMemoryBufferDataStreamTempCache::GetNumEntries returning %d", iEntries.size() - iFirstEntry));
     // return number of entries in cache
-    return iEntries.size();
+    return iEntries.size() - iFirstEntry;
 }
 
 
@@ -3334,6 +3398,12 @@ PVMFMemoryBufferDataStreamPermCache::AddEntry(uint8* aBufPtr, uint32 aBufSize, u
             }
             else
             {
+                if (iEntries.empty())
+                {
+                    // first entry, the persistent range does not have to start at the beginning of the clip
+                    iFirstPermByteOffset = aFirstOffset;
+                    iFirstByteFileOffset = aFirstOffset;
+                }
                 // adding to the end
                 iEntries.push_back(entry);
                 // last byte to be made persistent
@@ -3395,28 +3465,20 @@ PVMFMemoryBufferDataStreamPermCache::WriteBytes(uint8* aFragPtr, uint32 aFragSiz
     // find the cache entry that matches the file offset
     // copy the data into the cache and update the data structure
     // caller is responsible to make sure that the cache entries are in the cache
-    bool found = false;
-    uint32 entry = 0;
-    for (uint32 i = 0; i < iEntries.size(); i++)
+    // find the cache entry in which the file offset resides
+    uint32 entry = FindEntry(aFileOffset);
+    if ((aFileOffset >= iEntries[entry]->firstFileOffset) && (aFileOffset <= iEntries[entry]->lastFileOffset))
     {
-        // find the first cache entry in which the file offset resides
-        if ((aFileOffset >= iEntries[i]->firstFileOffset) && (aFileOffset <= iEntries[i]->lastFileOffset))
+        // allow writing over existing data,
+        // but do not allow a gap in the cache entry
+        if (aFileOffset > iEntries[entry]->fillFileOffset)
         {
-            // allow writing over existing data,
-            // but do not allow a gap in the cache entry
-            if (aFileOffset > iEntries[i]->fillFileOffset)
-            {
-                // gap
-                LOGERROR((0, "PVMFMemoryBufferDataStreamPermCache::WriteBytes Failed gap found fillFileOffset %d aFileOffset %d", iEntries[i]->fillFileOffset, aFileOffset));
-                return PVDS_INVALID_REQUEST;
-            }
-
-            found = true;
-            entry = i;
-            break;
+            // gap
+            LOGERROR((0, "PVMFMemoryBufferDataStreamPermCache::WriteBytes Failed gap found fillFileOffset %d aFileOffset %d", iEntries[entry]->fillFileOffset, aFileOffset));
+            return PVDS_INVALID_REQUEST;
         }
     }
-    if (!found)
+    else
     {
         LOGERROR((0, "PVMFMemoryBufferDataStreamPermCache::WriteBytes Failed cache entry not found"));
         return PVDS_INVALID_REQUEST;
@@ -3427,6 +3489,8 @@ PVMFMemoryBufferDataStreamPermCache::WriteBytes(uint8* aFragPtr, uint32 aFragSiz
     uint32 bytesToCopy = aFragSize;
     uint32 bufAvail = iEntries[entry]->bufSize - (aFileOffset - iEntries[entry]->firstFileOffset);
     uint32 copySize = bytesToCopy;
+    uint32 copyFileOffset = aFileOffset;
+    uint32 bytesAdded = 0;
     while (bytesToCopy)
     {
         copySize = bytesToCopy;
@@ -3436,8 +3500,16 @@ PVMFMemoryBufferDataStreamPermCache::WriteBytes(uint8* aFragPtr, uint32 aFragSiz
         }
         oscl_memcpy(dstPtr, srcPtr, copySize);
 
-        iEntries[entry]->fillFileOffset += copySize;
-        iEntries[entry]->fillSize += copySize;
+        // only the bytes past the fill point are new,
+        // e.g. the sequential download writing over a range that has been prefetched
+        copyFileOffset += copySize;
+        if (copyFileOffset > iEntries[entry]->fillFileOffset)
+        {
+            uint32 newBytes = copyFileOffset - iEntries[entry]->fillFileOffset;
+            iEntries[entry]->fillFileOffset += newBytes;
+            iEntries[entry]->fillSize += newBytes;
+            bytesAdded += newBytes;
+        }
 
         bytesToCopy -= copySize;
         if (++entry >= iEntries.size())
@@ -3453,94 +3525,97 @@ PVMFMemoryBufferDataStreamPermCache::WriteBytes(uint8* aFragPtr, uint32 aFragSiz
     {
         iLastByteFileOffset = aFileOffset + aFragSize - 1;
     }
-    iTotalBytes += aFragSize;
+    iTotalBytes += bytesAdded;
 
     LOGTRACE((0, "PVMFMemoryBufferDataStreamPermCache::WriteBytes success iLastByteFileOffset % d", iLastByteFileOffset));
     return PVDS_SUCCESS;
 }
 
 
+uint32
+PVMFMemoryBufferDataStreamPermCache::FindEntry(uint32 aFileOffset)
+{
+    // entries are contiguous and sorted by file offset,
+    // find the last entry starting at or before the offset
+    uint32 low = 0;
+    uint32 high = iEntries.size() - 1;
+    while (low < high)
+    {
+        uint32 mid = low + ((high - low + 1) >> 1);
+        if (iEntries[mid]->firstFileOffset <= aFileOffset)
+        {
+            low = mid;
+        }
+        else
+        {
+            high = mid - 1;
+        }
+    }
+    return low;
+}
+
+
 uint32
 PVMFMemoryBufferDataStreamPermCache::ReadBytes(uint8* aBuffer, uint32 aFirstByte, uint32 aLastByte)
 {
     LOGTRACE((0, "PVMFMemoryBufferDataStreamPermCache::ReadBytes buf %x first %d last %d", aBuffer, aFirstByte, aLastByte));
 
     // Caller is the read data stream, it limits the read to what is in the cache
-    // the first byte should be in the cache, go through the cache entires looking for the file offset
-    bool found = false;
+    // the first byte should be in the cache, look up the cache entry for the file offset
     uint32 count = iEntries.size();
     uint32 bytesRead = 0;
     uint32 bytesToRead = 0;
     uint8* dataPtr = NULL;
     uint8* bufferPtr = aBuffer;
 
-    for (uint32 i = 0; i < count; i++)
+    if (iEntries.empty())
     {
-        // there should not be holes in the cache right now
-        // once an empty cache entry is found, break out
-        if (0 == iEntries[i]->fillSize)
+        LOGTRACE((0, "PVMFMemoryBufferDataStreamPermCache::ReadBytes returning 0, cache is empty"));
+        return 0;
+    }
+
+    uint32 i = FindEntry(aFirstByte);
+    // there should not be holes in the cache right now
+    // the first byte has to be in the filled part of the entry
+    if ((aFirstByte < iEntries[i]->firstFileOffset) || (aFirstByte >= iEntries[i]->fillFileOffset) || (0 == iEntries[i]->fillSize))
+    {
+        LOGTRACE((0, "PVMFMemoryBufferDataStreamPermCache::ReadBytes returning 0, first byte not in cache"));
+        return 0;
+    }
+
+    // the first byte to be read is in this entry
+    dataPtr = iEntries[i]->bufPtr + (aFirstByte - iEntries[i]->firstFileOffset);
+    if (aLastByte < iEntries[i]->fillFileOffset)
+    {
+        // every byte to be read is in this entry
+        bytesToRead = aLastByte - aFirstByte + 1;
+    }
+    else
+    {
+        // only a portion is in this entry, the rest of the data should be in the next entry/entries
+        bytesToRead = iEntries[i]->fillSize - (aFirstByte - iEntries[i]->firstFileOffset);
+    }
+    oscl_memcpy(bufferPtr, dataPtr, bytesToRead);
+    bytesRead += bytesToRead;
+    bufferPtr += bytesToRead;
+
+    // once an empty cache entry is found, stop
+    for (++i; (i < count) && (0 != iEntries[i]->fillSize) && (aLastByte >= iEntries[i]->firstFileOffset); i++)
+    {
+        dataPtr = iEntries[i]->bufPtr;
+        if (aLastByte < (iEntries[i]->firstFileOffset + iEntries[i]->fillSize))
         {
-            break;
-        }
-        if (!found)
-        {
-            // haven't found the first offset yet
-            if ((aFirstByte >= iEntries[i]->firstFileOffset) && (aFirstByte < iEntries[i]->fillFileOffset))
-            {
-                // the first byte to be read is in this entry
-                found = true;
-                if (aLastByte < iEntries[i]->fillFileOffset)
-                {
-                    //LOGDEBUG((0, "PC1 entry %d offset %d size %d", i, iEntries[i]->firstFileOffset, iEntries[i]->fillSize));
-                    // every byte to be read is in this entry
-                    dataPtr = iEntries[i]->bufPtr + (aFirstByte - iEntries[i]->firstFileOffset);
-                    bytesToRead = aLastByte - aFirstByte + 1;
-                    // copy the data to the buffer
-                    oscl_memcpy(bufferPtr, dataPtr, bytesToRead);
-                    bytesRead += bytesToRead;
-                    // done
-                    break;
-                }
-                else
-                {
-                    //LOGDEBUG((0, "PC2 entry %d offset %d size %d", i, iEntries[i]->firstFileOffset, iEntries[i]->fillSize));
-                    // only a portion is in this entry
-                    dataPtr = iEntries[i]->bufPtr + (aFirstByte - iEntries[i]->firstFileOffset);
-                    bytesToRead = iEntries[i]->fillSize - (aFirstByte - iEntries[i]->firstFileOffset);
-                    // copy the data, the rest of the data should be in the next entry/entries
-                    oscl_memcpy(bufferPtr, dataPtr, bytesToRead);
-                    bytesRead += bytesToRead;
-                    bufferPtr += bytesToRead;
-                }
-            }
+            // what is left to be read is in this entry
+            bytesToRead = aLastByte - iEntries[i]->firstFileOffset + 1;
         }
         else
         {
-            // the first byte was in the previous entry, more data to copy from this entry
-            if (aLastByte < (iEntries[i]->firstFileOffset + iEntries[i]->fillSize))
-            {
-                //LOGDEBUG((0, "PC3 entry %d offset %d size %d", i, iEntries[i]->firstFileOffset, iEntries[i]->fillSize));
-                // what is left to be read is in this entry
-                dataPtr = iEntries[i]->bufPtr;
-                bytesToRead = aLastByte - iEntries[i]->firstFileOffset + 1;
-                // copy the data to the buffer
-                oscl_memcpy(bufferPtr, dataPtr, bytesToRead);
-                bytesRead += bytesToRead;
-                // done
-                break;
-            }
-            else
-            {
-                //LOGDEBUG((0, "PC4 entry %d offset %d size %d", i, iEntries[i]->firstFileOffset, iEntries[i]->fillSize));
-                // all of this entry is needed
-                dataPtr = iEntries[i]->bufPtr;
-                bytesToRead = iEntries[i]->fillSize;
-                // copy the data, the rest of the data should be in the next entry/entries
-                oscl_memcpy(bufferPtr, dataPtr, bytesToRead);
-                bytesRead += bytesToRead;
-                bufferPtr += bytesToRead;
-            }
+            // all of this entry is needed
+            bytesToRead = iEntries[i]->fillSize;
         }
+        oscl_memcpy(bufferPtr, dataPtr, bytesToRead);
+        bytesRead += bytesToRead;
+        bufferPtr += bytesToRead;
     }
     LOGTRACE((0, "PVMFMemoryBufferDataStreamPermCache::ReadBytes returning %d", bytesRead));
     return bytesRead;
@@ -0,0 +1,33 @@
+LOCAL_PATH := $(call my-dir)
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES := \
+ 	src/pvmf_memorybufferdatastream_test.cpp
+
+
+LOCAL_MODULE := pv_mbds_test
+
+LOCAL_CFLAGS :=  $(PV_CFLAGS)
+
+
+
+LOCAL_STATIC_LIBRARIES :=    
+
+LOCAL_SHARED_LIBRARIES := libopencore_download libopencore_player libopencore_net_support libopencore_common
+
+LOCAL_C_INCLUDES := \
+	$(PV_TOP)/nodes/pvdownloadmanagernode/test/src \
+ 	$(PV_TOP)/nodes/pvdownloadmanagernode/test/src \
+ 	$(PV_TOP)/nodes/pvdownloadmanagernode/include \
+ 	$(PV_TOP)/nodes/pvdownloadmanagernode/config/opencore \
+ 	$(PV_TOP)/pvmi/pvmf/include \
+ 	$(PV_INCLUDES)
+
+LOCAL_COPY_HEADERS_TO := $(PV_COPY_HEADERS_TO)
+
+LOCAL_COPY_HEADERS := \
+ 	
+
+-include $(PV_TOP)/Android_system_extras.mk
+
+include $(BUILD_EXECUTABLE)
@@ -0,0 +1,26 @@
+# Get the current local path as the first operation
+LOCAL_PATH := $(call get_makefile_dir)
+
+# Clear out the variables used in the local makefiles
+include $(MK)/clear.mk
+
+TARGET := pv_mbds_test
+
+
+XCXXFLAGS += $(FLAG_COMPILE_WARNINGS_AS_ERRORS)
+
+XINCDIRS += \
+  ../../../include \
+  ../../../config/opencore \
+  ../../../../../pvmi/pvmf/include
+
+SRCDIR := ../../src
+INCSRCDIR := ../../src
+
+SRCS := pvmf_memorybufferdatastream_test.cpp
+
+LIBS := opencore_download opencore_player opencore_net_support opencore_common
+
+SYSLIBS += $(SYS_THREAD_LIB)
+
+include $(MK)/prog.mk
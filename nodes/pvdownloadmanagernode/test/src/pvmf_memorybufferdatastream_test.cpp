@@ -0,0 +1,401 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+
+// Drives the memory buffer data stream the way the protocol engine and a
+// parser do: the protocol engine writes mem frags and serves reposition
+// requests, the parser reads and makes a range persistent.  Checks the
+// prefetch of a persistent range at the end of the clip (movie atom after
+// the media data).
+//
+// With -benchmark it also replays a seek-heavy read pattern on temp caches
+// of several sizes and reports the read rate and the head trim time.
+
+#include "stdio.h"
+#include "oscl_base.h"
+#include "oscl_mem.h"
+#include "oscl_error.h"
+#include "oscl_rand.h"
+#include "oscl_stdstring.h"
+#include "oscl_tickcount.h"
+#include "oscl_refcounter.h"
+#include "oscl_refcounter_memfrag.h"
+#include "pvmf_event_handling.h"
+#include "pvmf_memorybufferdatastream_factory.h"
+
+#define TEST_CLIP_SIZE          (2 * 1024 * 1024)
+#define TEST_FRAG_SIZE          1460
+#define TEST_CACHE_CAPACITY     (256 * 1024)
+#define TEST_HEADER_SIZE        20000
+#define TEST_MOOV_SIZE          30000
+#define TEST_MAX_FRAGS          ((TEST_CLIP_SIZE / TEST_FRAG_SIZE) + 1)
+
+static uint8 TestClip[TEST_CLIP_SIZE];
+
+class TestFragRefCounter : public OsclRefCounter
+{
+    public:
+        TestFragRefCounter(): iCount(1) {}
+        void addRef()
+        {
+            iCount++;
+        }
+        void removeRef()
+        {
+            --iCount;
+        }
+        uint32 getCount()
+        {
+            return iCount;
+        }
+
+    private:
+        uint32 iCount;
+};
+
+// Plays the protocol engine: records the reposition requests and
+// takes back the released mem frags
+class TestStreamWriter : public PvmiDataStreamRequestObserver
+{
+    public:
+        TestStreamWriter(): iNumRepositions(0), iRepositionOffset(0), iRepositionContext(NULL), iNumReleased(0) {}
+
+        PvmiDataStreamCommandId DataStreamRequest(PvmiDataStreamSession aSessionID,
+                PvmiDataStreamRequest aRequestID,
+                OsclAny* aRequestData,
+                OsclAny* aContext)
+        {
+            OSCL_UNUSED_ARG(aSessionID);
+            if (aRequestID == PVDS_REQUEST_REPOSITION)
+            {
+                iNumRepositions++;
+                iRepositionOffset = (uint32)aRequestData;
+                iRepositionContext = aContext;
+            }
+            return iNumRepositions;
+        }
+
+        PvmiDataStreamStatus DataStreamRequestSync(PvmiDataStreamSession aSessionID,
+                PvmiDataStreamRequest aRequestID,
+                OsclAny* aRequestData)
+        {
+            OSCL_UNUSED_ARG(aSessionID);
+            OSCL_UNUSED_ARG(aRequestData);
+            if (aRequestID == PVDS_REQUEST_MEM_FRAG_RELEASED)
+            {
+                iNumReleased++;
+            }
+            return PVDS_SUCCESS;
+        }
+
+        uint32 iNumRepositions;
+        uint32 iRepositionOffset;
+        OsclAny* iRepositionContext;
+        uint32 iNumReleased;
+};
+
+static TestFragRefCounter TestRefCounters[TEST_MAX_FRAGS];
+static OsclRefCounterMemFrag TestFrags[TEST_MAX_FRAGS];
+static uint32 TestNumFrags = 0;
+
+// writes the clip bytes [aFirst, aLast) in protocol engine sized frags
+static bool WriteRange(PVMIDataStreamSyncInterface* aWriter, uint32 aFirst, uint32 aLast)
+{
+    for (uint32 offset = aFirst; offset < aLast; offset += TEST_FRAG_SIZE)
+    {
+        uint32 size = aLast - offset;
+        if (size > TEST_FRAG_SIZE)
+        {
+            size = TEST_FRAG_SIZE;
+        }
+        OsclMemoryFragment memFrag;
+        memFrag.ptr = TestClip + offset;
+        memFrag.len = size;
+        OsclRefCounterMemFrag& frag = TestFrags[TestNumFrags % TEST_MAX_FRAGS];
+        frag = OsclRefCounterMemFrag(memFrag, &TestRefCounters[TestNumFrags % TEST_MAX_FRAGS], size);
+        TestNumFrags++;
+
+        uint32 written = 0;
+        PvmiDataStreamStatus status = aWriter->Write(0, &frag, written);
+        if ((status != PVDS_SUCCESS) && (status != PVDS_PENDING))
+        {
+            printf("  write failed at offset %d status %d\n", offset, status);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool ReadAndCompare(PVMIDataStreamSyncInterface* aReader, PvmiDataStreamSession aSession,
+                           uint32 aOffset, uint32 aSize)
+{
+    static uint8 buffer[TEST_MOOV_SIZE + TEST_HEADER_SIZE];
+    if (aReader->Seek(aSession, aOffset, PVDS_SEEK_SET) != PVDS_SUCCESS)
+    {
+        printf("  seek to %d failed\n", aOffset);
+        return false;
+    }
+    uint32 numElements = aSize;
+    if ((aReader->Read(aSession, buffer, 1, numElements) != PVDS_SUCCESS) || (numElements != aSize))
+    {
+        printf("  read of %d bytes at %d returned %d\n", aSize, aOffset, numElements);
+        return false;
+    }
+    if (oscl_memcmp(buffer, TestClip + aOffset, aSize) != 0)
+    {
+        printf("  data mismatch at %d\n", aOffset);
+        return false;
+    }
+    return true;
+}
+
+static void CompleteReposition(PVMIDataStreamSyncInterface* aWriter, TestStreamWriter& aObserver)
+{
+    PVMFCmdResp resp(aObserver.iNumRepositions, aObserver.iRepositionContext, PVMFSuccess);
+    OSCL_STATIC_CAST(PVMFMemoryBufferWriteDataStreamImpl*, aWriter)->SourceRequestCompleted(resp);
+}
+
+// The movie atom is at the end of the clip, far beyond the data on its way.
+// Making it persistent has to start a reposition to the exact offset,
+// the data written from there goes to the perm cache and the head of the clip
+// stays in the temp cache.
+static bool TestPrefetchTrailingRange()
+{
+    PVMFFormatType format = PVMF_MIME_DATA_SOURCE_HTTP_URL;
+    PVMFMemoryBufferDataStream* mbds = OSCL_NEW(PVMFMemoryBufferDataStream, (format, TEST_CACHE_CAPACITY));
+    PVUuid uuid = PVMIDataStreamSyncInterfaceUuid;
+    PVMIDataStreamSyncInterface* writer =
+        OSCL_STATIC_CAST(PVMIDataStreamSyncInterface*, mbds->GetWriteDataStreamFactoryPtr()->CreatePVMFCPMPluginAccessInterface(uuid));
+    PVMIDataStreamSyncInterface* reader =
+        OSCL_STATIC_CAST(PVMIDataStreamSyncInterface*, mbds->GetReadDataStreamFactoryPtr()->CreatePVMFCPMPluginAccessInterface(uuid));
+
+    TestStreamWriter observer;
+    PvmiDataStreamSession writeSession = 0;
+    PvmiDataStreamSession readSession = 0;
+    writer->OpenSession(writeSession, PVDS_WRITE_ONLY);
+    writer->SetSourceRequestObserver(observer);
+    writer->SetContentLength(TEST_CLIP_SIZE);
+    reader->OpenSession(readSession, PVDS_READ_ONLY);
+
+    bool ok = WriteRange(writer, 0, TEST_HEADER_SIZE);
+
+    const uint32 moovOffset = TEST_CLIP_SIZE - TEST_MOOV_SIZE;
+    ok = ok && (reader->MakePersistent(moovOffset, TEST_MOOV_SIZE) == PVDS_SUCCESS);
+    if (ok && ((observer.iNumRepositions != 1) || (observer.iRepositionOffset != moovOffset)))
+    {
+        printf("  expected one reposition to %d, got %d to %d\n", moovOffset, observer.iNumRepositions, observer.iRepositionOffset);
+        ok = false;
+    }
+
+    // writes before the reposition completes are thrown away
+    ok = ok && WriteRange(writer, TEST_HEADER_SIZE, TEST_HEADER_SIZE + TEST_FRAG_SIZE);
+    if (ok)
+    {
+        CompleteReposition(writer, observer);
+    }
+    ok = ok && WriteRange(writer, moovOffset, TEST_CLIP_SIZE);
+
+    // head from the temp cache, movie atom from the perm cache
+    ok = ok && ReadAndCompare(reader, readSession, 0, TEST_HEADER_SIZE);
+    ok = ok && ReadAndCompare(reader, readSession, moovOffset, TEST_MOOV_SIZE);
+
+    // skipping to the prefetched range does not start another request
+    ok = ok && (reader->Seek(readSession, moovOffset + 100, PVDS_SKIP_SET) == PVDS_SUCCESS);
+    if (ok && (observer.iNumRepositions != 1))
+    {
+        printf("  skip into the perm cache started a reposition\n");
+        ok = false;
+    }
+
+    // reading the media data after the head repositions below the requested offset,
+    // not to the end of the perm cache
+    if (ok)
+    {
+        const uint32 mediaOffset = TEST_CLIP_SIZE / 2;
+        uint8 byte = 0;
+        uint32 numElements = 1;
+        reader->Seek(readSession, mediaOffset, PVDS_SEEK_SET);
+        reader->Read(readSession, &byte, 1, numElements);
+        if ((observer.iNumRepositions != 2) || (observer.iRepositionOffset > mediaOffset))
+        {
+            printf("  media data reposition %d to %d\n", observer.iNumRepositions, observer.iRepositionOffset);
+            ok = false;
+        }
+    }
+
+    reader->CloseSession(readSession);
+    writer->CloseSession(writeSession);
+    mbds->GetReadDataStreamFactoryPtr()->DestroyPVMFCPMPluginAccessInterface(uuid, reader);
+    OSCL_DELETE(mbds);
+    return ok;
+}
+
+// The persistent range is close enough to be reached by the current download.
+// No reposition, the frag that crosses into the range fills its first bytes.
+static bool TestSequentialFillOfTrailingRange()
+{
+    PVMFFormatType format = PVMF_MIME_DATA_SOURCE_HTTP_URL;
+    PVMFMemoryBufferDataStream* mbds = OSCL_NEW(PVMFMemoryBufferDataStream, (format, TEST_CACHE_CAPACITY));
+    PVUuid uuid = PVMIDataStreamSyncInterfaceUuid;
+    PVMIDataStreamSyncInterface* writer =
+        OSCL_STATIC_CAST(PVMIDataStreamSyncInterface*, mbds->GetWriteDataStreamFactoryPtr()->CreatePVMFCPMPluginAccessInterface(uuid));
+    PVMIDataStreamSyncInterface* reader =
+        OSCL_STATIC_CAST(PVMIDataStreamSyncInterface*, mbds->GetReadDataStreamFactoryPtr()->CreatePVMFCPMPluginAccessInterface(uuid));
+
+    TestStreamWriter observer;
+    PvmiDataStreamSession writeSession = 0;
+    PvmiDataStreamSession readSession = 0;
+    writer->OpenSession(writeSession, PVDS_WRITE_ONLY);
+    writer->SetSourceRequestObserver(observer);
+    const uint32 clipSize = 100000;
+    writer->SetContentLength(clipSize);
+    reader->OpenSession(readSession, PVDS_READ_ONLY);
+
+    bool ok = WriteRange(writer, 0, TEST_HEADER_SIZE);
+
+    // not frag aligned
+    const uint32 moovOffset = clipSize - TEST_MOOV_SIZE + 7;
+    ok = ok && (reader->MakePersistent(moovOffset, clipSize - moovOffset) == PVDS_SUCCESS);
+    if (ok && (observer.iNumRepositions != 0))
+    {
+        printf("  range within reach started a reposition\n");
+        ok = false;
+    }
+    ok = ok && WriteRange(writer, TEST_HEADER_SIZE, clipSize);
+    ok = ok && ReadAndCompare(reader, readSession, moovOffset, clipSize - moovOffset);
+
+    reader->CloseSession(readSession);
+    writer->CloseSession(writeSession);
+    mbds->GetReadDataStreamFactoryPtr()->DestroyPVMFCPMPluginAccessInterface(uuid, reader);
+    OSCL_DELETE(mbds);
+    return ok;
+}
+
+// Random seek, then up to 4 sequential reads of 1-8000 bytes. Every 16 seeks
+// the oldest entry is trimmed and a new one appended, like a long session.
+static bool BenchmarkTempCache(uint32 aNumEntries)
+{
+    PVMFMemoryBufferDataStreamTempCache* cache = OSCL_NEW(PVMFMemoryBufferDataStreamTempCache, ());
+    static uint8 buffer[8000];
+    OsclRand rand;
+    rand.Seed(1);
+
+    uint32 offset = 0;
+    uint32 i;
+    for (i = 0; i < aNumEntries; i++)
+    {
+        uint32 size = TEST_FRAG_SIZE - (i % 7) * 100;
+        cache->AddEntry(NULL, TestClip + (offset % (TEST_CLIP_SIZE / 2)), size, offset);
+        offset += size;
+    }
+
+    // the clip is reused for offsets past its first half
+    uint32 numReads = 0;
+    uint32 numBad = 0;
+    uint32 start = OsclTickCount::TickCount();
+    for (uint32 seek = 0; seek < 400000; seek++)
+    {
+        uint32 first = 0;
+        uint32 last = 0;
+        cache->GetFileOffsets(first, last);
+        uint32 pos = first + ((uint32)rand.Rand() % (last - first + 1));
+        for (uint32 k = 0; (k < 4) && (pos <= last); k++)
+        {
+            uint32 end = pos + ((uint32)rand.Rand() % sizeof(buffer));
+            if (end > last)
+            {
+                end = last;
+            }
+            uint32 firstEntry = 0;
+            uint32 bytesRead = cache->ReadBytes(buffer, pos, end, firstEntry);
+            if (bytesRead != (end - pos + 1))
+            {
+                numBad++;
+            }
+            pos = end + 1;
+            numReads++;
+        }
+        if ((seek & 15) == 0)
+        {
+            OsclRefCounterMemFrag* frag = NULL;
+            uint8* fragPtr = NULL;
+            cache->RemoveFirstEntry(frag, fragPtr);
+            uint32 size = TEST_FRAG_SIZE - (seek % 7) * 100;
+            cache->AddEntry(NULL, TestClip + (offset % (TEST_CLIP_SIZE / 2)), size, offset);
+            offset += size;
+        }
+    }
+    uint32 readMsec = OsclTickCount::TicksToMsec(OsclTickCount::TickCount() - start);
+
+    // trim two thirds of the cache from the head and refill, 20 times
+    start = OsclTickCount::TickCount();
+    for (uint32 rep = 0; rep < 20; rep++)
+    {
+        uint32 count = cache->GetNumEntries() * 2 / 3;
+        for (i = 0; i < count; i++)
+        {
+            OsclRefCounterMemFrag* frag = NULL;
+            uint8* fragPtr = NULL;
+            cache->RemoveFirstEntry(frag, fragPtr);
+        }
+        for (i = 0; i < count; i++)
+        {
+            cache->AddEntry(NULL, TestClip + (offset % (TEST_CLIP_SIZE / 2)), TEST_FRAG_SIZE, offset);
+            offset += TEST_FRAG_SIZE;
+        }
+    }
+    uint32 trimMsec = OsclTickCount::TicksToMsec(OsclTickCount::TickCount() - start);
+
+    printf("%6d entries: %d reads in %d ms, head trim x20 in %d ms\n",
+           aNumEntries, numReads, readMsec, trimMsec);
+
+    OSCL_DELETE(cache);
+    return (numBad == 0);
+}
+
+int main(int argc, char** argv)
+{
+    OsclBase::Init();
+    OsclErrorTrap::Init();
+    OsclMem::Init();
+
+    for (uint32 i = 0; i < TEST_CLIP_SIZE; i++)
+    {
+        TestClip[i] = (uint8)((i * 31) ^ (i >> 11));
+    }
+
+    uint32 failures = 0;
+    bool ok = TestPrefetchTrailingRange();
+    printf("prefetch of a range at the end of the clip: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    ok = TestSequentialFillOfTrailingRange();
+    printf("sequential fill of a range at the end of the clip: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    if ((argc > 1) && (oscl_strcmp(argv[1], "-benchmark") == 0))
+    {
+        ok = BenchmarkTempCache(300) && BenchmarkTempCache(3000) && BenchmarkTempCache(30000);
+        printf("temp cache seek benchmark: %s\n", ok ? "pass" : "FAIL");
+        failures += ok ? 0 : 1;
+    }
+
+    OsclMem::Cleanup();
+    OsclErrorTrap::Cleanup();
+    OsclBase::Cleanup();
+    return (failures == 0) ? 0 : 1;
+}
@@ -62,6 +62,7 @@ PVMFFileOutputNode::PVMFFileOutputNode(int32 aPriority)
         , iLateMargin(DEFAULT_LATE_MARGIN)
         , iTotalFrames(0)
 {
+    SetTelemetryActiveObject(this);
     ConstructL();
     int32 err;
     OSCL_TRY(err,
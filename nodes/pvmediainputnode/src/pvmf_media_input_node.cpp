@@ -580,6 +580,7 @@ PvmfMediaInputNode::PvmfMediaInputNode()
         , iExtensionRefCount(0)
         , iLogger(NULL)
 {
+    SetTelemetryActiveObject(this);
 #ifdef _TEST_AE_ERROR_HANDLING
     iChunkCount = 0;
     iErrorTrackID = -1;
@@ -591,6 +591,29 @@ OSCL_EXPORT_REF void PVMediaOutputNode::RequestCompleted(const PVMFCmdResp& aRes
                     SetClock(iClock);
                 }
                 //To continue the Node Init, query for the
+                //optional batched write interface
+                {
+                    PVMFStatus status = SendMioRequest(iCurrentCommand[0], EQueryBatchExtension);
+                    if (status == PVMFPending)
+                        return;//wait on response
+                    iMediaIORequest = ENone;
+                    status = SendMioRequest(iCurrentCommand[0], EQueryCapability);
+                    if (status == PVMFPending)
+                        return;//wait on response
+                    else
+                        CommandComplete(iCurrentCommand, iCurrentCommand.front(), status);
+                }
+                break;
+
+            case EQueryBatchExtension:
+                //ignore any error from this query since the interface is optional.
+                iMediaIORequest = ENone;
+                if (aResponse.GetCmdStatus() == PVMFSuccess)
+                {
+                    iMIOBatchExtension = OSCL_STATIC_CAST(PvmiMediaTransferBatchExtensionInterface*, iMIOBatchExtensionPVI);
+                }
+                iMIOBatchExtensionPVI = NULL;
+                //To continue the Node Init, query for the
                 //capability & config interface
                 {
                     PVMFStatus status = SendMioRequest(iCurrentCommand[0], EQueryCapability);
@@ -720,6 +743,7 @@ PVMediaOutputNode::PVMediaOutputNode()
         , iReposLogger(NULL)
         , iRecentBOSStreamID(0)
 {
+    SetTelemetryActiveObject(this);
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -735,6 +759,8 @@ void PVMediaOutputNode::ConstructL(PvmiMIOControl* aIOInterfacePtr)
     iMediaIOCancelPending = false;
     iMIOClockExtension = NULL;
     iMIOClockExtensionPVI = NULL;
+    iMIOBatchExtension = NULL;
+    iMIOBatchExtensionPVI = NULL;
     iClockRate = 100000;
 }
 
@@ -1654,6 +1680,30 @@ PVMFStatus PVMediaOutputNode::SendMioRequest(PVMediaOutputNodeCmd& aCmd, EMioReq
         }
         break;
 
+        case EQueryBatchExtension:
+        {
+            int32 err ;
+            iMIOBatchExtension = NULL;
+            iMIOBatchExtensionPVI = NULL;
+            OSCL_TRY(err,
+                     iMediaIOCmdId = iMIOControl->QueryInterface(PvmiMediaTransferBatchExtensionInterfaceUuid,
+                                     iMIOBatchExtensionPVI, NULL);
+                    );
+
+            if (err != OsclErrNone)
+            {
+                PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_ERR,
+                                (0, "PVMediaOutputNode::SendMioRequest: Error iMIOControl->QueryInterface(batch ext) failed"));
+                //this interface is optional so ignore the error
+                status = PVMFSuccess;
+            }
+            else
+            {
+                status = PVMFPending;
+            }
+        }
+        break;
+
         case EInit:
         {
             int32 err = OsclErrNone;
@@ -68,6 +68,9 @@
 #ifndef PVMI_MEDIA_IO_CLOCK_EXTENSION_H_INCLUDED
 #include "pvmi_media_io_clock_extension.h"
 #endif
+#ifndef PVMI_MEDIA_TRANSFER_BATCH_EXTENSION_H_INCLUDED
+#include "pvmi_media_transfer_batch_extension.h"
+#endif
 
 /** Port tags.  For now engine must use these directly since
 * port tag query is not yet implemented
@@ -353,6 +356,7 @@ class PVMediaOutputNode : public OsclActiveObject,
             ENone
             , EQueryCapability
             , EQueryClockExtension
+            , EQueryBatchExtension
             , EInit
             , EStart
             , EPause
@@ -388,6 +392,10 @@ class PVMediaOutputNode : public OsclActiveObject,
         PvmiClockExtensionInterface* iMIOClockExtension;
         PVInterface* iMIOClockExtensionPVI;
 
+        // Optional batched write interface, used by the input ports when present
+        PvmiMediaTransferBatchExtensionInterface* iMIOBatchExtension;
+        PVInterface* iMIOBatchExtensionPVI;
+
         /* Diagnostic log related */
         PVLogger* iDiagnosticsLogger;
         bool iDiagnosticsLogged;
@@ -128,6 +128,7 @@ PVMediaOutputNodePort::PVMediaOutputNodePort(PVMediaOutputNode* aNode)
     iMediaType = PVMF_MEDIA_UNKNOWN;
     iWriteState = EWriteOK;
     iCleanupQueue.reserve(1);
+    iBatchMsgs.reserve(PVMF_MOPORT_MAX_BATCH_ENTRIES);
     iWriteAsyncContext = 0;
     iWriteAsyncEOSContext = 0;
     iWriteAsyncReConfigContext = 0;
@@ -360,6 +361,7 @@ void PVMediaOutputNodePort::CleanupMediaTransfer()
     {
         iCurrentMediaMsg.Unbind();
     }
+    iBatchMsgs.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -391,6 +393,7 @@ OSCL_EXPORT_REF PVMFStatus PVMediaOutputNodePort::ClearMsgQueues()
     {
         iCurrentMediaMsg.Unbind();
     }
+    iBatchMsgs.clear();
 
     PvmfPortBaseImpl::ClearMsgQueues();
     //cancel any pending write operations
@@ -795,6 +798,11 @@ void PVMediaOutputNodePort::writeComplete(PVMFStatus status, PVMFCommandId aCmdI
             {
                 PVMFSharedMediaDataPtr mediaData = iCleanupQueue[i].iData;
                 iCleanupQueue.erase(&iCleanupQueue[i]);
+                //a batched write leaves one element per media msg, all together
+                while ((i < iCleanupQueue.size()) && (iCleanupQueue[i].iCmdId == aCmdId))
+                {
+                    iCleanupQueue.erase(&iCleanupQueue[i]);
+                }
                 PVMF_MOPORT_LOGDATAPATH((0, "PVMediaOutputNodePort::writeComplete - Fmt=%s, Seq=%d, TS=%d, FIdx=%d, ClnUpQSize=%d",
                                          iSinkFormatString.get_str(),
                                          mediaData->getSeqNum(),
@@ -1161,6 +1169,12 @@ void PVMediaOutputNodePort::SendMediaData()
         OSCL_ASSERT(false);
     }
 
+    if (iNode->iMIOBatchExtension)
+    {
+        SendMediaDataBatch();
+        return;
+    }
+
     PVMFSharedMediaDataPtr mediaData;
     convertToPVMFMediaData(mediaData, iCurrentMediaMsg);
 
@@ -1283,6 +1297,279 @@ void PVMediaOutputNodePort::SendMediaData()
     return;
 }
 
+////////////////////////////////////////////////////////////////////////////
+void PVMediaOutputNodePort::SendMediaDataBatch()
+//send media data to a MIO component that supports batched writes.  For active
+//MIO components the media msgs queued behind the current one go out in the
+//same write.
+{
+    uint32 maxEntries = iNode->iMIOBatchExtension->getMaxBatchEntries();
+    if (maxEntries > PVMF_MOPORT_MAX_BATCH_ENTRIES)
+    {
+        maxEntries = PVMF_MOPORT_MAX_BATCH_ENTRIES;
+    }
+    else if (maxEntries == 0)
+    {
+        maxEntries = 1;
+    }
+
+    while (iCurrentMediaMsg.GetRep() != NULL)
+    {
+        PVMFSharedMediaDataPtr mediaData;
+        convertToPVMFMediaData(mediaData, iCurrentMediaMsg);
+
+        uint32 numEntries = AddBatchEntries(mediaData, iFragIndex, 0, maxEntries);
+        uint32 fragindex = iFragIndex + numEntries;
+        bool lastFrag = (fragindex >= mediaData->getNumFragments());
+        uint32 numMsgs = 0;
+        if (lastFrag)
+        {
+            //media msgs held from an earlier attempt come first
+            while ((numMsgs < iBatchMsgs.size()) && (numEntries < maxEntries))
+            {
+                PVMFSharedMediaDataPtr batchData;
+                convertToPVMFMediaData(batchData, iBatchMsgs[numMsgs]);
+                if (batchData->getNumFragments() > (maxEntries - numEntries))
+                {
+                    break;
+                }
+                numEntries = AddBatchEntries(batchData, 0, numEntries, maxEntries);
+                numMsgs++;
+            }
+            while ((numMsgs == iBatchMsgs.size()) &&
+                    (numEntries < maxEntries) &&
+                    BatchNextMediaMsg(maxEntries - numEntries))
+            {
+                PVMFSharedMediaDataPtr batchData;
+                convertToPVMFMediaData(batchData, iBatchMsgs.back());
+                numEntries = AddBatchEntries(batchData, 0, numEntries, maxEntries);
+                numMsgs++;
+            }
+        }
+
+        int32 err = OsclErrNone;
+        int32 cmdId = 0;
+        if (numEntries > 0)
+        {
+            iWriteState = EWriteBusy;
+            err = WriteBatchToMIO(cmdId, numEntries);
+        }
+
+        if (err != OsclErrNone)
+        {
+            //as in SendMediaData, suspend data transfer until the MIO component
+            //is ready again.  The media msgs dequeued for this batch stay in
+            //iBatchMsgs and are sent again with the current media msg.
+            iWriteState = EWriteWait;
+
+            //stop processing input, since we are not done with the current media msg
+            oProcessIncomingMessage = false;
+
+            PVMF_MOPORT_LOGDATAPATH((0, "PVMediaOutputNodePort::SendMediaDataBatch - WriteAsyncLeave - Fmt=%s, LeaveCode=%d, Entries=%d",
+                                     iSinkFormatString.get_str(),
+                                     err,
+                                     numEntries));
+
+            return ;//wait on statusUpdate call or start complete from the MIO component.
+        }
+
+        if (!lastFrag)
+        {
+            //more fragments of the current media msg than fit in one batch
+            iFragIndex = fragindex;
+            iWriteState = EWriteOK;
+            continue;
+        }
+
+        if (iWriteState == EWriteBusy)
+        {
+            //asynchronous completion.
+            //keep all the media data of the batch until the component consumes it,
+            //the single writeComplete for cmdId releases them together.
+            iCleanupQueue.push_back(CleanupQueueElement(mediaData, cmdId));
+            for (uint32 i = 0; i < numMsgs; i++)
+            {
+                PVMFSharedMediaDataPtr batchData;
+                convertToPVMFMediaData(batchData, iBatchMsgs[i]);
+                iCleanupQueue.push_back(CleanupQueueElement(batchData, cmdId));
+            }
+            PVMF_MOPORT_LOGDATAPATH((0, "PVMediaOutputNodePort::SendMediaDataBatch - AsyncWrite - Fmt=%s, Seq=%d, TS=%d, Msgs=%d, Entries=%d, ClnUpQSize=%d",
+                                     iSinkFormatString.get_str(),
+                                     mediaData->getSeqNum(),
+                                     mediaData->getTimestamp(),
+                                     numMsgs + 1,
+                                     numEntries,
+                                     iCleanupQueue.size()));
+        }
+        else
+        {
+            PVMF_MOPORT_LOGDATAPATH((0, "PVMediaOutputNodePort::SendMediaDataBatch - SyncWrite - Fmt=%s, Seq=%d, TS=%d, Msgs=%d, Entries=%d, ClnUpQSize=%d",
+                                     iSinkFormatString.get_str(),
+                                     mediaData->getSeqNum(),
+                                     mediaData->getTimestamp(),
+                                     numMsgs + 1,
+                                     numEntries,
+                                     iCleanupQueue.size()));
+        }
+        iWriteState = EWriteOK;
+
+        //we are done with the media msgs of this batch.  Any held media msg
+        //that did not fit becomes the current one and goes in the next batch.
+        iCurrentMediaMsg.Unbind();
+        iFragIndex = 0;
+        for (uint32 i = 0; i < numMsgs; i++)
+        {
+            iBatchMsgs.erase(iBatchMsgs.begin());
+        }
+        if (!iBatchMsgs.empty())
+        {
+            iCurrentMediaMsg = iBatchMsgs.front();
+            iBatchMsgs.erase(iBatchMsgs.begin());
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////
+uint32 PVMediaOutputNodePort::AddBatchEntries(PVMFSharedMediaDataPtr& aMediaData, uint32 aFragIndex,
+        uint32 aNumEntries, uint32 aMaxEntries)
+//fill in iBatchEntries for the fragments of a media msg from aFragIndex on,
+//starting at entry aNumEntries.  Returns the new number of entries.
+{
+    uint32 duration = 0;
+    if (aMediaData->getMarkerInfo() & PVMF_MEDIA_DATA_MARKER_INFO_DURATION_AVAILABLE_BIT)
+    {
+        duration = aMediaData->getDuration();
+    }
+
+    // extract private data (if it is in fsi)
+    OsclAny *privatedataptr = NULL;
+    uint32 privatedatalength = 0;
+
+    OsclRefCounterMemFrag fsifrag;
+    aMediaData->getFormatSpecificInfo(fsifrag);
+
+    uint32 *data = (uint32 *)fsifrag.getMemFragPtr();
+    uint32 data_len = fsifrag.getMemFragSize();
+    if (data && data_len > 0)
+    {
+        //data to extract
+        privatedataptr = (OsclAny*)(*data);
+        privatedatalength = data_len;
+    }
+
+    uint32 numFragments = aMediaData->getNumFragments();
+    for (uint32 fragindex = aFragIndex; (fragindex < numFragments) && (aNumEntries < aMaxEntries); fragindex++)
+    {
+        OsclRefCounterMemFrag frag;
+        aMediaData->getMediaFragment(fragindex, frag);
+
+        uint32 flags = PVMI_MEDIAXFER_MEDIA_DATA_FLAG_NONE;
+
+        // The marker bit should only be set for the final frag to allow MIO to reassemble data properly
+        if ((aMediaData->getMarkerInfo() & PVMF_MEDIA_DATA_MARKER_INFO_M_BIT) &&
+                (fragindex == (numFragments - 1)))
+        {
+            flags |= PVMI_MEDIAXFER_MEDIA_DATA_FLAG_MARKER_BIT;
+        }
+        if (aMediaData->getMarkerInfo() & PVMF_MEDIA_DATA_MARKER_INFO_NO_RENDER_BIT)
+        {
+            flags |= PVMI_MEDIAXFER_MEDIA_DATA_FLAG_NO_RENDER_BIT;
+        }
+
+        PvmiMediaXferBatchEntry& entry = iBatchEntries[aNumEntries++];
+        entry.data = (uint8*)frag.getMemFragPtr();
+        entry.data_len = frag.getMemFragSize();
+        entry.data_header_info.seq_num = aMediaData->getSeqNum();
+        entry.data_header_info.timestamp = aMediaData->getTimestamp();
+        entry.data_header_info.duration = duration;
+        entry.data_header_info.flags = flags;
+        entry.data_header_info.stream_id = aMediaData->getStreamID();
+        entry.data_header_info.private_data_length = privatedatalength;
+        entry.data_header_info.private_data_ptr = privatedataptr;
+    }
+    return aNumEntries;
+}
+
+////////////////////////////////////////////////////////////////////////////
+bool PVMediaOutputNodePort::BatchNextMediaMsg(uint32 aMaxFrags)
+//dequeue the msg at the head of the incoming queue into iBatchMsgs if it can
+//go in the same batched write as the current media msg.  Only active MIO
+//components get more than one media msg at a time, since they pace the data
+//themselves.
+{
+    if ((oActiveMediaOutputComp == false) ||
+            (iFrameStepMode == true) ||
+            (oProcessIncomingMessage == false) ||
+            (iSendStartOfDataEvent == true) ||
+            iIncomingQueue.iQ.empty())
+    {
+        return false;
+    }
+
+    PVMFSharedMediaMsgPtr msg = iIncomingQueue.iQ.front();
+    if ((msg->getFormatID() >= PVMF_MEDIA_CMD_FORMAT_IDS_START) ||
+            (msg->getStreamID() != iCurrentMediaMsg->getStreamID()) ||
+            (DataToSkip(msg) == true))
+    {
+        return false;
+    }
+
+    PVMFSharedMediaDataPtr mediaData;
+    convertToPVMFMediaData(mediaData, msg);
+    if ((mediaData->getNumFragments() == 0) ||
+            (mediaData->getNumFragments() > aMaxFrags))
+    {
+        return false;
+    }
+
+    if (DequeueIncomingMsg(msg) != PVMFSuccess)
+    {
+        PVMF_MOPORT_LOGERROR((0, "PVMediaOutputNodePort::BatchNextMediaMsg: DequeueIncomingMsg Failed - Fmt=%s",
+                              iSinkFormatString.get_str()));
+        OSCL_ASSERT(false);
+        return false;
+    }
+    iTotalFrames++;
+    PVMF_MOPORT_LOGDATAPATH((0, "PVMediaOutputNodePort::BatchNextMediaMsg - MediaMsg Recvd - Seq=%d, TS=%d, Fmt=%s, Qs=%d",
+                             msg->getSeqNum(),
+                             msg->getTimestamp(),
+                             iSinkFormatString.get_str(),
+                             IncomingMsgQueueSize()));
+    iBatchMsgs.push_back(msg);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////
+void PVMediaOutputNodePort::DropSkippedBatchMsgs()
+//drop the media msgs held for the next batched write that a skip has made
+//obsolete.  If the current media msg was dropped, the first remaining held
+//one takes its place so the msgs still go out in order.
+{
+    Oscl_Vector<PVMFSharedMediaMsgPtr, OsclMemAllocator>::iterator it = iBatchMsgs.begin();
+    while (it != iBatchMsgs.end())
+    {
+        if (DataToSkip(*it) == true)
+        {
+            PVMF_MOPORT_LOGDATAPATH((0, "PVMediaOutputNodePort::DropSkippedBatchMsgs: MsgSkip - StreamId=%d, Seq=%d, TS=%d, Fmt=%s",
+                                     (*it)->getStreamID(),
+                                     (*it)->getSeqNum(),
+                                     (*it)->getTimestamp(),
+                                     iSinkFormatString.get_str()));
+            it = iBatchMsgs.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+    if ((iCurrentMediaMsg.GetRep() == NULL) && !iBatchMsgs.empty())
+    {
+        iCurrentMediaMsg = iBatchMsgs.front();
+        iBatchMsgs.erase(iBatchMsgs.begin());
+        iFragIndex = 0;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////
 void PVMediaOutputNodePort::SendEndOfData()
 //send end of data notice to the MIO componenent.
@@ -2655,6 +2942,10 @@ void PVMediaOutputNodePort::SetSkipTimeStamp(uint32 aSkipTS,
             iFragIndex = 0;
         }
     }
+    if (!iBatchMsgs.empty())
+    {
+        DropSkippedBatchMsgs();
+    }
     //wake up the AO to start processing messages
     RunIfNotReady();
 }
@@ -2911,3 +3202,15 @@ int32 PVMediaOutputNodePort::WriteDataToMIO(int32 &aCmdId, PvmiMediaXferHeader &
                                                         (OsclAny*) & iWriteAsyncContext););
     return leavecode;
 }
+
+int32 PVMediaOutputNodePort::WriteBatchToMIO(int32 &aCmdId, uint32 aNumEntries)
+{
+    int32 leavecode = OsclErrNone;
+    OSCL_TRY_NO_TLS(iOsclErrorTrapImp, leavecode,
+                    aCmdId = iNode->iMIOBatchExtension->writeBatchAsync(PVMI_MEDIAXFER_FMT_TYPE_DATA,  /*format_type*/
+                             PVMI_MEDIAXFER_FMT_INDEX_DATA, /*format_index*/
+                             iBatchEntries,
+                             aNumEntries,
+                             (OsclAny*) & iWriteAsyncContext););
+    return leavecode;
+}
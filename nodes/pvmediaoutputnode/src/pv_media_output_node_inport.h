@@ -64,6 +64,9 @@
 #ifndef OSCL_STRING_CONTAINERS_H_INCLUDED
 #include "oscl_string_containers.h"
 #endif
+#ifndef PVMI_MEDIA_TRANSFER_BATCH_EXTENSION_H_INCLUDED
+#include "pvmi_media_transfer_batch_extension.h"
+#endif
 
 // Forward declaration
 class PVMediaOutputNode;
@@ -78,6 +81,9 @@ enum PVMFMediaOutputNodePortMediaTimeStatus
 
 #define THRESHOLD_FOR_DROPPED_VIDEO_FRAMES 120
 
+//most buffers handed to a MIO component in one batched write
+#define PVMF_MOPORT_MAX_BATCH_ENTRIES 16
+
 class PVMediaOutputNodePort : public OsclTimerObject
         , public PvmfPortBaseImpl
         , public PvmfNodesSyncControlInterface
@@ -226,6 +232,7 @@ class PVMediaOutputNodePort : public OsclTimerObject
         void ClearPreviousBOSStreamIDs(uint32 aID);
 
         int32 WriteDataToMIO(int32 &aCmdId, PvmiMediaXferHeader &aMediaxferhdr, OsclRefCounterMemFrag &aFrag);
+        int32 WriteBatchToMIO(int32 &aCmdId, uint32 aNumEntries);
         PvmiMediaTransfer* getMediaTransfer()
         {
             return iMediaTransfer;
@@ -291,6 +298,14 @@ class PVMediaOutputNodePort : public OsclTimerObject
         void SendData();
         //for sending media data to the Mout.
         void SendMediaData();
+        //for sending media data to a Mout that supports batched writes.
+        void SendMediaDataBatch();
+        uint32 AddBatchEntries(PVMFSharedMediaDataPtr& aMediaData, uint32 aFragIndex, uint32 aNumEntries, uint32 aMaxEntries);
+        bool BatchNextMediaMsg(uint32 aMaxFrags);
+        void DropSkippedBatchMsgs();
+        //media msgs dequeued behind iCurrentMediaMsg for the next batched write
+        Oscl_Vector<PVMFSharedMediaMsgPtr, OsclMemAllocator> iBatchMsgs;
+        PvmiMediaXferBatchEntry iBatchEntries[PVMF_MOPORT_MAX_BATCH_ENTRIES];
         //for sending the end-of-data notice to the Mout.
         void SendEndOfData();
         //for sending reconfig notice to the Mout
@@ -57,5 +57,10 @@ enum TPVMFMP3FFNodeInfo
 
 static const char PVMF_MP3_PARSER_NODE_ALL_METADATA_KEY[] = "all";
 
+// Config key for the directory the frame index of a scanned local clip is
+// stored in, e.g. an application cache directory. The value is a wchar*
+// path ending in a path separator. No index is stored while it is not set.
+#define PVMF_MP3FFPARSER_FRAME_INDEX_DIR_KEY "x-pvmf/parser/mp3-frame-index-dir"
+
 #endif // end PVMF_MP3FFPARSER_DEFS_H_INCLUDED
 
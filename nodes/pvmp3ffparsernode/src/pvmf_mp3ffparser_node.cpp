@@ -48,6 +48,12 @@
 #ifndef PVMF_RETURN_CODES_H_INCLUDED
 #include "pvmf_return_codes.h"
 #endif
+#ifndef OSCL_TICKCOUNT_H_INCLUDED
+#include "oscl_tickcount.h"
+#endif
+#ifndef PVMI_KVP_UTIL_H_INCLUDED
+#include "pvmi_kvp_util.h"
+#endif
 
 #include "pvfile.h"
 // Playback clock timescale
@@ -60,6 +66,12 @@
 #define PVMP3FF_DEFAULT_MAX_FRAMESIZE       4096
 #define PVMF3FF_DEFAULT_NUM_OF_FRAMES       5
 #define PVMF3FF_DURATION_SCAN_AO_DELAY      1000
+// the scan walks frames in steps until the time budget of the run is used up
+#define PVMF3FF_DURATION_SCAN_FRAMES_PER_STEP 100
+#define PVMF3FF_DURATION_SCAN_MSEC_PER_RUN  5
+// the frame index of a scanned local clip is kept in the configured index dir
+#define PVMF3FF_FRAME_INDEX_FILE_EXT        _STRLIT_WCHAR(".pvfidx")
+#define PVMF3FF_FRAME_INDEX_MAX_SIZE        (1024 * 1024)
 
 #ifdef PV_HAS_SHOUTCAST_SUPPORT_ENABLED
 #define PVMF_MP3FFPARSER_NODE_METADATA_RESERVE 2
@@ -95,6 +107,7 @@ PVMFMP3FFParserNode::PVMFMP3FFParserNode(int32 aPriority)
         iSendDecodeFormatSpecificInfo(true),
 	iA2DPMode(false)
 {
+    SetTelemetryActiveObject(this);
 #if PV_HAS_SHOUTCAST_SUPPORT_ENABLED
     iMetadataBuf = NULL;
     iMetadataBufSize = 0;
@@ -2463,9 +2476,115 @@ PVMFStatus PVMFMP3FFParserNode::ParseFile()
     {
         iMP3FormatBitrate = mp3format.Bitrate;
     }
+
+    if (iDurationCalcAO)
+    {
+        LoadFrameIndex();
+    }
     return PVMFSuccess;
 }
 
+/**
+ * The frame index built by the duration scan is only kept when the caller
+ * configured an index dir, and only for local clips opened by name. Clips
+ * opened through a file handle, a data stream or a CPM plug-in have no name
+ * the index could be stored under. The file is named after the full clip
+ * path, with the path separators replaced, so clips with the same name in
+ * different directories do not share an index.
+ */
+bool PVMFMP3FFParserNode::GetFrameIndexFileName(OSCL_wHeapString<OsclMemAllocator>& aFileName)
+{
+    if ((iFrameIndexDir.get_size() == 0) ||
+            !iSourceURLSet || iFileHandle || iDataStreamFactory ||
+            iCPMContainer.iCPMContentAccessFactory || (iSourceURL.get_size() == 0))
+    {
+        return false;
+    }
+    OSCL_wHeapString<OsclMemAllocator> clipName(iSourceURL);
+    oscl_wchar* ptr = clipName.get_str();
+    for (uint32 i = 0; i < clipName.get_size(); i++)
+    {
+        if ((ptr[i] == '/') || (ptr[i] == '\\') || (ptr[i] == ':'))
+        {
+            ptr[i] = '_';
+        }
+    }
+    aFileName = iFrameIndexDir;
+    aFileName += clipName;
+    aFileName += PVMF3FF_FRAME_INDEX_FILE_EXT;
+    return true;
+}
+
+void PVMFMP3FFParserNode::LoadFrameIndex()
+{
+    OSCL_wHeapString<OsclMemAllocator> fileName;
+    if (!GetFrameIndexFileName(fileName))
+    {
+        return;
+    }
+
+    Oscl_File indexFile;
+    if (indexFile.Open(fileName.get_cstr(), Oscl_File::MODE_READ | Oscl_File::MODE_BINARY, iFileServer) != 0)
+    {
+        // no index stored for this clip yet
+        return;
+    }
+
+    uint32 size = (uint32)indexFile.Size();
+    uint8* buffer = NULL;
+    if ((size > 0) && (size <= PVMF3FF_FRAME_INDEX_MAX_SIZE))
+    {
+        buffer = OSCL_ARRAY_NEW(uint8, size);
+    }
+    if (buffer && (indexFile.Read(buffer, 1, size) == size))
+    {
+        // the parser checks the index against the clip before taking it
+        MP3ErrorType err = iMP3File->DeserializeFrameIndex(buffer, size);
+        PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_INFO,
+                        (0, "PVMFMP3FFParserNode::LoadFrameIndex() size %d, status %d", size, err));
+    }
+    if (buffer)
+    {
+        OSCL_ARRAY_DELETE(buffer);
+    }
+    indexFile.Close();
+}
+
+void PVMFMP3FFParserNode::SaveFrameIndex()
+{
+    OSCL_wHeapString<OsclMemAllocator> fileName;
+    if (!iMP3File || !GetFrameIndexFileName(fileName))
+    {
+        return;
+    }
+
+    uint32 size = iMP3File->GetFrameIndexSize();
+    if ((size == 0) || (size > PVMF3FF_FRAME_INDEX_MAX_SIZE))
+    {
+        return;
+    }
+
+    uint8* buffer = OSCL_ARRAY_NEW(uint8, size);
+    if (buffer && iMP3File->SerializeFrameIndex(buffer, size))
+    {
+        Oscl_File indexFile;
+        // a read-only media location just means the next open scans again
+        if (indexFile.Open(fileName.get_cstr(), Oscl_File::MODE_READWRITE | Oscl_File::MODE_BINARY, iFileServer) == 0)
+        {
+            if (indexFile.Write(buffer, 1, size) != size)
+            {
+                PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_ERR,
+                                (0, "PVMFMP3FFParserNode::SaveFrameIndex() write failed"));
+            }
+            indexFile.Close();
+        }
+    }
+    if (buffer)
+    {
+        OSCL_ARRAY_DELETE(buffer);
+    }
+}
+
 /**
  * Reset the trackinfo
  */
@@ -2698,6 +2817,11 @@ bool PVMFMP3FFParserNode::queryInterface(const PVUuid& uuid, PVInterface*& iface
         PVMIDatastreamuserInterface* myInterface = OSCL_STATIC_CAST(PVMIDatastreamuserInterface*, this);
         iface = OSCL_STATIC_CAST(PVInterface*, myInterface);
     }
+    else if (PVMI_CAPABILITY_AND_CONFIG_PVUUID == uuid)
+    {
+        PvmiCapabilityAndConfig* myInterface = OSCL_STATIC_CAST(PvmiCapabilityAndConfig*, this);
+        iface = OSCL_STATIC_CAST(PVInterface*, myInterface);
+    }
     else
     {
         return false;
@@ -2705,6 +2829,70 @@ bool PVMFMP3FFParserNode::queryInterface(const PVUuid& uuid, PVInterface*& iface
     return true;
 }
 
+/**
+ * From PvmiCapabilityAndConfig
+ */
+void PVMFMP3FFParserNode::setParametersSync(PvmiMIOSession aSession, PvmiKvp* aParameters,
+        int num_elements, PvmiKvp*& aRet_kvp)
+{
+    OSCL_UNUSED_ARG(aSession);
+    aRet_kvp = NULL;
+    for (int32 i = 0; i < num_elements; i++)
+    {
+        if (VerifyAndSetConfigParameter(aParameters[i], true) != PVMFSuccess)
+        {
+            aRet_kvp = &aParameters[i];
+            return;
+        }
+    }
+}
+
+PVMFStatus PVMFMP3FFParserNode::verifyParametersSync(PvmiMIOSession aSession, PvmiKvp* aParameters, int num_elements)
+{
+    OSCL_UNUSED_ARG(aSession);
+    if ((aParameters == NULL) || (num_elements < 1))
+    {
+        return PVMFErrArgument;
+    }
+    for (int32 i = 0; i < num_elements; i++)
+    {
+        PVMFStatus status = VerifyAndSetConfigParameter(aParameters[i], false);
+        if (status != PVMFSuccess)
+        {
+            return status;
+        }
+    }
+    return PVMFSuccess;
+}
+
+PVMFStatus PVMFMP3FFParserNode::VerifyAndSetConfigParameter(PvmiKvp& aParameter, bool aSet)
+{
+    if ((aParameter.key == NULL) ||
+            (pv_mime_strcmp(aParameter.key, PVMF_MP3FFPARSER_FRAME_INDEX_DIR_KEY) < 0))
+    {
+        return PVMFErrNotSupported;
+    }
+    if (GetValTypeFromKeyString(aParameter.key) != PVMI_KVPVALTYPE_WCHARPTR)
+    {
+        return PVMFErrArgument;
+    }
+    if (aSet)
+    {
+        // a NULL or empty path turns persistence off again
+        if (aParameter.value.pWChar_value)
+        {
+            iFrameIndexDir = aParameter.value.pWChar_value;
+        }
+        else
+        {
+            iFrameIndexDir = _STRLIT_WCHAR("");
+        }
+        PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_INFO,
+                        (0, "PVMFMP3FFParserNode::VerifyAndSetConfigParameter() frame index dir length %d", iFrameIndexDir.get_size()));
+    }
+    return PVMFSuccess;
+}
+
 
 /**
  * From PVMFDataSourceInitializationExtensionInterface
@@ -4332,6 +4520,7 @@ void PVMp3DurationCalculator::Run()
     if (iErrorCode != MP3_SUCCESS)
     {
         iScanComplete = true;
+        ((PVMFMP3FFParserNode*)iNode)->SaveFrameIndex();
         int32 durationInMsec = iMP3File->GetDuration();
         int32 leavecode = 0;
         PVMFDurationInfoMessage* eventmsg = NULL;
@@ -4355,7 +4544,13 @@ void PVMp3DurationCalculator::Run()
     if (!(((PVMFMP3FFParserNode*)iNode)->iTrack.iSendBOS))
     {
         // Start the scan only when we have send first audio sample
-        iErrorCode = iMP3File->ScanMP3File(PVMF3FF_DEFAULT_NUM_OF_FRAMES * 5);
+        uint32 startTicks = OsclTickCount::TickCount();
+        do
+        {
+            iErrorCode = iMP3File->ScanMP3File(PVMF3FF_DURATION_SCAN_FRAMES_PER_STEP);
+        }
+        while ((iErrorCode == MP3_SUCCESS) &&
+                (OsclTickCount::TicksToMsec(OsclTickCount::TickCount() - startTicks) < PVMF3FF_DURATION_SCAN_MSEC_PER_RUN));
     }
 }
 
@@ -110,6 +110,10 @@
 #include "pvfile.h"
 #endif
 
+#ifndef PVMI_CONFIG_AND_CAPABILITY_H_INCLUDED
+#include "pvmi_config_and_capability.h"
+#endif
+
 #ifndef IMP3FF_H_INCLUDED
 #include "imp3ff.h"  // Includes for the core file format mp3 parser library
 #endif
@@ -385,7 +389,8 @@ class PVMFMP3FFParserNode : public OsclTimerObject,
         public PVMIDatastreamuserInterface,
         public OsclMemPoolResizableAllocatorObserver,
         public PvmfDataSourcePlaybackControlInterface,
-        public PVMFCPMPluginLicenseInterface
+        public PVMFCPMPluginLicenseInterface,
+        public PvmiCapabilityAndConfig
 #if PV_HAS_SHOUTCAST_SUPPORT_ENABLED
         , public PVMFMetadataUpdatesObserver
 #endif
@@ -429,6 +434,66 @@ class PVMFMP3FFParserNode : public OsclTimerObject,
         PVMFStatus SetClientPlayBackClock(PVMFMediaClock* aClientClock);
         PVMFStatus SetEstimatedServerClock(PVMFMediaClock* aClientClock);
 
+        // From PvmiCapabilityAndConfig, only the frame index dir can be set
+        void setObserver(PvmiConfigAndCapabilityCmdObserver* aObserver)
+        {
+            OSCL_UNUSED_ARG(aObserver);
+        }
+        PVMFStatus getParametersSync(PvmiMIOSession aSession, PvmiKeyType aIdentifier,
+                                     PvmiKvp*& aParameters, int& aNumParamElements,
+                                     PvmiCapabilityContext aContext)
+        {
+            OSCL_UNUSED_ARG(aSession);
+            OSCL_UNUSED_ARG(aIdentifier);
+            OSCL_UNUSED_ARG(aContext);
+            aParameters = NULL;
+            aNumParamElements = 0;
+            return PVMFErrNotSupported;
+        }
+        PVMFStatus releaseParameters(PvmiMIOSession aSession, PvmiKvp* aParameters, int num_elements)
+        {
+            OSCL_UNUSED_ARG(aSession);
+            OSCL_UNUSED_ARG(aParameters);
+            OSCL_UNUSED_ARG(num_elements);
+            return PVMFErrNotSupported;
+        }
+        void createContext(PvmiMIOSession aSession, PvmiCapabilityContext& aContext)
+        {
+            OSCL_UNUSED_ARG(aSession);
+            OSCL_UNUSED_ARG(aContext);
+        }
+        void setContextParameters(PvmiMIOSession aSession, PvmiCapabilityContext& aContext,
+                                  PvmiKvp* aParameters, int num_parameter_elements)
+        {
+            OSCL_UNUSED_ARG(aSession);
+            OSCL_UNUSED_ARG(aContext);
+            OSCL_UNUSED_ARG(aParameters);
+            OSCL_UNUSED_ARG(num_parameter_elements);
+        }
+        void DeleteContext(PvmiMIOSession aSession, PvmiCapabilityContext& aContext)
+        {
+            OSCL_UNUSED_ARG(aSession);
+            OSCL_UNUSED_ARG(aContext);
+        }
+        void setParametersSync(PvmiMIOSession aSession, PvmiKvp* aParameters,
+                               int num_elements, PvmiKvp*& aRet_kvp);
+        PVMFCommandId setParametersAsync(PvmiMIOSession aSession, PvmiKvp* aParameters,
+                                         int num_elements, PvmiKvp*& aRet_kvp, OsclAny* context = NULL)
+        {
+            OSCL_UNUSED_ARG(aSession);
+            OSCL_UNUSED_ARG(aParameters);
+            OSCL_UNUSED_ARG(num_elements);
+            OSCL_UNUSED_ARG(aRet_kvp);
+            OSCL_UNUSED_ARG(context);
+            return -1;
+        }
+        uint32 getCapabilityMetric(PvmiMIOSession aSession)
+        {
+            OSCL_UNUSED_ARG(aSession);
+            return 0;
+        }
+        PVMFStatus verifyParametersSync(PvmiMIOSession aSession, PvmiKvp* aParameters, int num_elements);
+
         //From PVMFTrackSelectionExtensionInterface
         PVMFStatus GetMediaPresentationInfo(PVMFMediaPresentationInfo& aInfo);
         PVMFStatus SelectTracks(PVMFMediaPresentationInfo& aInfo);
@@ -711,6 +776,13 @@ class PVMFMP3FFParserNode : public OsclTimerObject,
         void GetCPMMetaDataKeys();
 
         PVMp3DurationCalculator* iDurationCalcAO;
+        // persisted frame index, so that a clip is scanned only once
+        bool GetFrameIndexFileName(OSCL_wHeapString<OsclMemAllocator>& aFileName);
+        void LoadFrameIndex();
+        void SaveFrameIndex();
+        PVMFStatus VerifyAndSetConfigParameter(PvmiKvp& aParameter, bool aSet);
+        // set through PVMF_MP3FFPARSER_FRAME_INDEX_DIR_KEY, empty if not configured
+        OSCL_wHeapString<OsclMemAllocator> iFrameIndexDir;
         friend class PVMFSubNodeContainerBaseMp3;
         friend class PVMFCPMContainerMp3;
         friend class PVMFMP3FFParserPort;
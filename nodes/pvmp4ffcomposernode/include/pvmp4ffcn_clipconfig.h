@@ -70,6 +70,15 @@ typedef enum
      */
     PVMP4FFCN_3GPP_DOWNLOAD_MODE = 0x00000009,
 
+    /**
+     * This mode authors 3GPP Progressive Downloadable output files:
+     * Meta Data is upfront, in space reserved ahead of the media data.
+     * Media Data is interleaved.
+     * No temp files are used.
+     * The reserved space is sized from SetExpectedSampleCount(). If the
+     * Meta Data does not fit, it is written towards the end of the clip.
+     */
+    PVMP4FFCN_3GPP_FAST_START_MODE = 0x0000000B,
 
     /**
      * This mode authors I-Motion compliant output files:
@@ -100,6 +109,33 @@ typedef enum
 
 } PVMp4FFCN_AuthoringMode;
 
+/**
+ * PVMp4FFCNSegmentObserver receives the segments authored in
+ * PVMP4FFCN_MOVIE_FRAGMENT_MODE as soon as each one is complete.
+ */
+class PVMp4FFCNSegmentObserver
+{
+    public:
+        virtual ~PVMp4FFCNSegmentObserver() {}
+
+        /**
+         * Called, from the thread adding samples to the file, once a segment
+         * has been completely written and flushed.
+         *
+         * @param aSequenceNumber 0 for the initialization segment (ftyp, moov and
+         *                        the media preceding the first fragment), otherwise
+         *                        the sequence number of the movie fragment.
+         * @param aFileName File holding the segment. Empty when it is the output
+         *                  file and that was set with SetOutputFileDescriptor().
+         * @param aOffset Offset of the segment in that file.
+         * @param aSize Size of the segment.
+         */
+        virtual void MovieFragmentSegmentReady(uint32 aSequenceNumber,
+                                               const OSCL_wString& aFileName,
+                                               uint32 aOffset,
+                                               uint32 aSize) = 0;
+};
+
 /**
  * PVMp4FFCNClipConfigInterface allows a client to control properties of PVMp4FFComposerNode
  */
@@ -267,6 +303,38 @@ class PVMp4FFCNClipConfigInterface : public PVInterface
          * @return Completion status of this method.
          */
         virtual PVMFStatus SetRealTimeAuthoring(const bool aRealTime) = 0;
+
+        /**
+         * This method configures the segmented output of PVMP4FFCN_MOVIE_FRAGMENT_MODE.
+         * Each movie fragment is closed after aSegmentDuration and reported to
+         * aObserver right away. When aSegmentFileName is not empty, every fragment
+         * is written to its own self-contained file <aSegmentFileName><sequence number>.m4s
+         * and the output file only holds the initialization segment.
+         *
+         * This is an optional configuration API that should be called before Start() is called.
+         *
+         * @param aSegmentDuration Segment duration in milliseconds.
+         * @param aSegmentFileName Base name of the segment files, or empty.
+         * @param aObserver Observer of the completed segments, or NULL.
+         * @return Completion status of this method.
+         */
+        virtual PVMFStatus SetMovieFragmentSegmentOutput(uint32 aSegmentDuration,
+                const OSCL_wString& aSegmentFileName,
+                PVMp4FFCNSegmentObserver* aObserver) = 0;
+
+        /**
+         * This method sets the number of samples expected over all tracks in
+         * PVMP4FFCN_3GPP_FAST_START_MODE. The space reserved for the Meta Data
+         * ahead of the media data is sized from it. It is ignored in the other
+         * authoring modes.
+         *
+         * This is an optional configuration API that should be called before Start() is called.
+         *
+         * @param aSampleCount Expected number of samples.
+         * @return Completion status of this method.
+         */
+        virtual PVMFStatus SetExpectedSampleCount(uint32 aSampleCount) = 0;
+
         /* This is an optional configuration API that should be called before Start() is called.
          *
          * @param aAlbum_Title   Album string.
@@ -307,6 +307,8 @@ PVMp4FFComposerNode::PVMp4FFComposerNode(int32 aPriority)
         , iAuthoringMode(PVMP4FF_3GPP_DOWNLOAD_MODE)
         , iPresentationTimescale(1000)
         , iMovieFragmentDuration(2000)
+        , iSegmentObserver(NULL)
+        , iExpectedSampleCount(0)
         , iRecordingYear(0)
         , iClockConverter(8000)
         , iExtensionRefCount(0)
@@ -335,6 +337,7 @@ PVMp4FFComposerNode::PVMp4FFComposerNode(int32 aPriority)
         , iSampleInTrack(false)
         , iFileRendered(false)
 {
+    SetTelemetryActiveObject(this);
     iInterfaceState = EPVMFNodeCreated;
     iNum_PPS_Set = 0;
     iNum_SPS_Set = 0;
@@ -899,6 +902,45 @@ PVMFStatus PVMp4FFComposerNode::SetRealTimeAuthoring(const bool aRealTime)
     return PVMFSuccess;
 }
 
+////////////////////////////////////////////////////////////////////////////
+OSCL_EXPORT_REF PVMFStatus PVMp4FFComposerNode::SetMovieFragmentSegmentOutput(uint32 aSegmentDuration,
+        const OSCL_wString& aSegmentFileName,
+        PVMp4FFCNSegmentObserver* aObserver)
+{
+    if (iInterfaceState != EPVMFNodeIdle && iInterfaceState != EPVMFNodeInitialized)
+        return PVMFErrInvalidState;
+
+    if (aSegmentDuration == 0)
+        return PVMFErrArgument;
+
+    iMovieFragmentDuration = aSegmentDuration;
+    iSegmentFileName = aSegmentFileName;
+    iSegmentObserver = aObserver;
+    return PVMFSuccess;
+}
+
+////////////////////////////////////////////////////////////////////////////
+OSCL_EXPORT_REF PVMFStatus PVMp4FFComposerNode::SetExpectedSampleCount(uint32 aSampleCount)
+{
+    if (iInterfaceState != EPVMFNodeIdle && iInterfaceState != EPVMFNodeInitialized)
+        return PVMFErrInvalidState;
+
+    iExpectedSampleCount = aSampleCount;
+    return PVMFSuccess;
+}
+
+////////////////////////////////////////////////////////////////////////////
+void PVMp4FFComposerNode::MovieFragmentSegmentReady(uint32 aSequenceNumber,
+        const OSCL_wString& aFileName,
+        uint32 aOffset, uint32 aSize)
+{
+    LOG_DEBUG((0, "PVMp4FFComposerNode::MovieFragmentSegmentReady: seq=%d offset=%d size=%d",
+               aSequenceNumber, aOffset, aSize));
+
+    if (iSegmentObserver)
+        iSegmentObserver->MovieFragmentSegmentReady(aSequenceNumber, aFileName, aOffset, aSize);
+}
+
 ////////////////////////////////////////////////////////////////////////////
 OSCL_EXPORT_REF PVMFStatus PVMp4FFComposerNode::SetAlbumInfo(const OSCL_wString& aAlbumTitle, const OSCL_String& aLangCode)
 {
@@ -1634,6 +1676,17 @@ void PVMp4FFComposerNode::DoStart(PVMp4FFCNCmd& aCmd)
                 iMpeg4File->setCreationDate(iCreationDate);
             }
             iMpeg4File->setMovieFragmentDuration(iMovieFragmentDuration);
+            if (iAuthoringMode == PVMP4FF_MOVIE_FRAGMENT_MODE)
+            {
+                iMpeg4File->setMovieFragmentSegmentObserver(this);
+                if ((iSegmentFileName.get_size() > 0) &&
+                        !iMpeg4File->setMovieFragmentSegmentFileName(iSegmentFileName))
+                {
+                    LOG_ERR((0, "PVMp4FFComposerNode::DoStart: Error - setMovieFragmentSegmentFileName failed"));
+                    CommandComplete(iCmdQueue, aCmd, PVMFFailure);
+                    return;
+                }
+            }
             iMpeg4File->setAlbumInfo(iAlbumTitle.iDataString, iAlbumTitle.iLangCode);
             iMpeg4File->setRecordingYear(iRecordingYear);
 
@@ -1671,6 +1724,10 @@ void PVMp4FFComposerNode::DoStart(PVMp4FFCNCmd& aCmd)
                 }
             }
 
+            if (iAuthoringMode == PVMP4FF_3GPP_FAST_START_MODE)
+            {
+                iMpeg4File->setExpectedSampleCount(iExpectedSampleCount);
+            }
             iMpeg4File->prepareToEncode();
 
             iInitTSOffset = true;
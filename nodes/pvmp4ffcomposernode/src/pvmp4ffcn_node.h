@@ -126,7 +126,8 @@ class PVMp4FFComposerNode : public PVMFNodeInterface,
         public PVMp4FFCNTrackConfigInterface,
         public PVMp4FFCNClipConfigInterface,
         public PvmfComposerSizeAndDurationInterface,
-        public PvmiCapabilityAndConfig
+        public PvmiCapabilityAndConfig,
+        public PVA_FF_MovieFragmentSegmentObserver
 {
     public:
         PVMp4FFComposerNode(int32 aPriority);
@@ -178,6 +179,10 @@ class PVMp4FFComposerNode : public PVMFNodeInterface,
         OSCL_IMPORT_REF PVMFStatus SetRating(const OSCL_wString& aRating, const OSCL_String& aLangCode);
         OSCL_IMPORT_REF PVMFStatus SetCreationDate(const OSCL_wString& aCreationDate);
         OSCL_IMPORT_REF PVMFStatus SetRealTimeAuthoring(const bool aRealTime);
+        OSCL_IMPORT_REF PVMFStatus SetMovieFragmentSegmentOutput(uint32 aSegmentDuration,
+                const OSCL_wString& aSegmentFileName,
+                PVMp4FFCNSegmentObserver* aObserver);
+        OSCL_IMPORT_REF PVMFStatus SetExpectedSampleCount(uint32 aSampleCount);
         OSCL_IMPORT_REF PVMFStatus SetAlbumInfo(const OSCL_wString& aAlbum_Title, const OSCL_String& aLangCode);
         OSCL_IMPORT_REF PVMFStatus SetRecordingYear(uint16 aRecordingYear);
         OSCL_IMPORT_REF PVMFStatus SetPerformer(const OSCL_wString& aPerformer, const OSCL_String& aLangCode);
@@ -198,6 +203,10 @@ class PVMp4FFComposerNode : public PVMFNodeInterface,
         OSCL_IMPORT_REF PVMFStatus SetMaxDuration(bool aEnable, uint32 aMaxDurationMilliseconds);
         OSCL_IMPORT_REF void GetMaxDurationConfig(bool& aEnable, uint32& aMaxDurationMilliseconds);
         OSCL_IMPORT_REF PVMFStatus SetFileSizeProgressReport(bool aEnable, uint32 aReportFrequency);
+
+        // Pure virtual from PVA_FF_MovieFragmentSegmentObserver
+        void MovieFragmentSegmentReady(uint32 aSequenceNumber, const OSCL_wString& aFileName,
+                                       uint32 aOffset, uint32 aSize);
         OSCL_IMPORT_REF void GetFileSizeProgressReportConfig(bool& aEnable, uint32& aReportFrequency);
         OSCL_IMPORT_REF PVMFStatus SetDurationProgressReport(bool aEnable, uint32 aReportFrequency);
         OSCL_IMPORT_REF void GetDurationProgressReportConfig(bool& aEnable, uint32& aReportFrequency);
@@ -363,6 +372,9 @@ class PVMp4FFComposerNode : public PVMFNodeInterface,
         uint32 iAuthoringMode;
         uint32 iPresentationTimescale;
         uint32 iMovieFragmentDuration;
+        OSCL_wHeapString<OsclMemAllocator> iSegmentFileName;
+        PVMp4FFCNSegmentObserver* iSegmentObserver;
+        uint32 iExpectedSampleCount;
         Oscl_File* iFileObject;
 
 #ifdef ANDROID
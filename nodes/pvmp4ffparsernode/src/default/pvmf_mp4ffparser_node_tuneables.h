@@ -77,6 +77,10 @@
 //flag, enable(1) or disable(0) functionality to break up aac frames into multiple media messages
 #define PVMFMP4FF_BREAKUP_AAC_FRAMES_INTO_MULTIPLE_MEDIA_FRAGS 1
 
+//flag, enable(1) or disable(0) sending samples of local files straight out of a
+//read-only file mapping instead of copying them into the track data pool
+#define PVMFMP4FF_USE_MAPPED_SAMPLE_ACCESS 1
+
 #endif // PVMF_MP4FFPARSER_NODE_TUNEABLES_H_INCLUDED
 
 
@@ -102,6 +102,7 @@ PVMFMP4FFParserNode::PVMFMP4FFParserNode(int32 aPriority) :
         iDataRate(NORMAL_PLAYRATE),
         minFileOffsetTrackID(0)
 {
+    SetTelemetryActiveObject(this);
     iClientPlayBackClock = NULL;
     iClockNotificationsInf = NULL;
     autopaused = false;
@@ -136,6 +137,7 @@ PVMFMP4FFParserNode::PVMFMP4FFParserNode(int32 aPriority) :
     iInterfaceState = EPVMFNodeCreated;
     iParsingMode = PVMF_MP4FF_PARSER_NODE_ENABLE_PARSER_OPTIMIZATION;
     oIsAACFramesFragmented = PVMFMP4FF_BREAKUP_AAC_FRAMES_INTO_MULTIPLE_MEDIA_FRAGS;
+    iUseMappedSampleAccess = PVMFMP4FF_USE_MAPPED_SAMPLE_ACCESS;
 
     iUseCPMPluginRegistry = false;
     iFileHandle = NULL;
@@ -146,6 +148,8 @@ PVMFMP4FFParserNode::PVMFMP4FFParserNode(int32 aPriority) :
     iDataStreamReadCapacityObserver = NULL;
     iDownloadComplete          = false;
     iProgressivelyDownlodable  = false;
+    iMoovPrefetchOffset        = 0;
+    iMoovPrefetchComplete      = false;
     iFastTrackSession          = false;
 
     iLastNPTCalcInConvertSizeToTime = 0;
@@ -2092,6 +2096,17 @@ PVMFStatus PVMFMP4FFParserNode::DoRequestPort(PVMFMP4FFParserNodeCommand& aCmd,
     trackportinfo.iMediaDataMemPool = mediadatamempool;
     trackportinfo.iMediaDataGroupImplMemPool = mediadatagroupimplmempool;
     trackportinfo.iMediaDataGroupAlloc = mediadatagroupalloc;
+    // Tracks whose samples go downstream unchanged in a single fragment
+    // can be served straight out of the file mapping, if there is one.
+    if ((trackportinfo.iFormatTypeInteger == PVMF_MP4_PARSER_NODE_FORMAT_UNKNOWN) ||
+            ((trackportinfo.iFormatTypeInteger == PVMF_MP4_PARSER_NODE_MPEG4_AUDIO) &&
+             !oIsAACFramesFragmented))
+    {
+        if (iUseMappedSampleAccess && !iThumbNailMode)
+        {
+            trackportinfo.iMappedSampleRefCounter = iMP4FileHandle->enableMappedSampleAccess(trackid);
+        }
+    }
     trackportinfo.iNode = OSCL_STATIC_CAST(OsclTimerObject* , this);
     trackportinfo.iTimestamp = tsStartOffset;
     trackportinfo.iSeqNum = 0;
@@ -2508,7 +2523,8 @@ bool PVMFMP4FFParserNode::ParseMP4File(PVMFMP4FFParserNodeCmdQueue& aCmdQ,
                      dsFactory,
                      iFileHandle,
                      iParsingMode,
-                     &iFileServer);
+                     &iFileServer,
+                     (iUseMappedSampleAccess && !iThumbNailMode));
 
     currticks = OsclTickCount::TickCount();
     uint32 EndTime = OsclTickCount::TicksToMsec(currticks);
@@ -4313,29 +4329,54 @@ bool PVMFMP4FFParserNode::RetrieveTrackData(PVMP4FFNodeTrackPortInfo& aTrackPort
     // Get the track ID
     uint32 trackid = aTrackPortInfo.iTrackId;
 
+    // Samples of a mapped track are sent as fragments pointing into the
+    // file mapping, so no track data buffer is needed.  Reverse playback
+    // of video goes through the key frame APIs, which still copy.
+    bool useMappedSamples = (aTrackPortInfo.iMappedSampleRefCounter != NULL);
+    if (useMappedSamples &&
+            (PVMF_DATA_SOURCE_DIRECTION_REVERSE == iPlayBackDirection) &&
+            (iMP4FileHandle->getTrackMediaType(trackid) == MEDIA_TYPE_VISUAL))
+    {
+        useMappedSamples = false;
+    }
+
     // Create a data buffer from pool
     int errcode = OsclErrNoResources;
 
     OsclSharedPtr<PVMFMediaDataImpl> mediaDataImplOut;
-    if (aTrackPortInfo.iFormatTypeInteger == PVMF_MP4_PARSER_NODE_3GPP_TIMED_TEXT)
+    if (useMappedSamples)
     {
-        mediaDataImplOut = aTrackPortInfo.iTextMediaDataImplAlloc->allocate(aTrackPortInfo.iTrackMaxDataSize);
+        mediaDataImplOut = aTrackPortInfo.iMediaDataGroupAlloc->allocate();
+        if (mediaDataImplOut.GetRep() == NULL)
+        {
+            PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_STACK_TRACE, (0, "PVMFMP4FFParserNode::RetrieveTrackData() Allocating from media data group alloc failed"));
+            aTrackPortInfo.iState = PVMP4FFNodeTrackPortInfo::TRACKSTATE_MEDIADATAFRAGGROUPPOOLEMPTY;
+            aTrackPortInfo.iMediaDataGroupAlloc->notifyfreechunkavailable(aTrackPortInfo);
+            return false;
+        }
     }
     else
     {
-        mediaDataImplOut = aTrackPortInfo.iMediaDataImplAlloc->allocate(aTrackPortInfo.iTrackMaxDataSize);
-    }
+        if (aTrackPortInfo.iFormatTypeInteger == PVMF_MP4_PARSER_NODE_3GPP_TIMED_TEXT)
+        {
+            mediaDataImplOut = aTrackPortInfo.iTextMediaDataImplAlloc->allocate(aTrackPortInfo.iTrackMaxDataSize);
+        }
+        else
+        {
+            mediaDataImplOut = aTrackPortInfo.iMediaDataImplAlloc->allocate(aTrackPortInfo.iTrackMaxDataSize);
+        }
 
-    if (mediaDataImplOut.GetRep() != NULL)
-    {
-        errcode = OsclErrNone;
-    }
-    else
-    {
-        PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_INFO, (0, "PVMFMP4FFParserNode::RetrieveTrackData() No Resource Found"));
-        aTrackPortInfo.iState = PVMP4FFNodeTrackPortInfo::TRACKSTATE_TRACKDATAPOOLEMPTY;
-        aTrackPortInfo.iTrackDataMemoryPool->notifyfreeblockavailable(aTrackPortInfo, aTrackPortInfo.iTrackMaxDataSize);    // Enable flag to receive event when next deallocate() is called on pool
-        return false;
+        if (mediaDataImplOut.GetRep() != NULL)
+        {
+            errcode = OsclErrNone;
+        }
+        else
+        {
+            PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_INFO, (0, "PVMFMP4FFParserNode::RetrieveTrackData() No Resource Found"));
+            aTrackPortInfo.iState = PVMP4FFNodeTrackPortInfo::TRACKSTATE_TRACKDATAPOOLEMPTY;
+            aTrackPortInfo.iTrackDataMemoryPool->notifyfreeblockavailable(aTrackPortInfo, aTrackPortInfo.iTrackMaxDataSize);    // Enable flag to receive event when next deallocate() is called on pool
+            return false;
+        }
     }
 
     // Now create a PVMF media data from pool
@@ -4392,7 +4433,10 @@ bool PVMFMP4FFParserNode::RetrieveTrackData(PVMP4FFNodeTrackPortInfo& aTrackPort
 
     // Retrieve memory fragment to write to
     OsclRefCounterMemFrag refCtrMemFragOut;
-    mediadataout->getMediaFragment(0, refCtrMemFragOut);
+    if (!useMappedSamples)
+    {
+        mediadataout->getMediaFragment(0, refCtrMemFragOut);
+    }
 
     // Resets GAU structure.
     oscl_memset(&iGau.buf, 0, sizeof(iGau.buf));
@@ -4403,7 +4447,12 @@ bool PVMFMP4FFParserNode::RetrieveTrackData(PVMP4FFNodeTrackPortInfo& aTrackPort
     iGau.buf.num_fragments = 1;
     iGau.buf.buf_states[0] = NULL;
 
-    if (iCPMContentType == PVMF_CPM_FORMAT_OMA2)
+    if (useMappedSamples)
+    {
+        // the parser fills in the fragments
+        iGau.buf.num_fragments = 0;
+    }
+    else if (iCPMContentType == PVMF_CPM_FORMAT_OMA2)
     {
         iGau.buf.fragments[0].ptr = iOMA2DecryptionBuffer;
         iGau.buf.fragments[0].len = PVMP4FF_OMA2_DECRYPTION_BUFFER_SIZE;
@@ -4838,6 +4887,20 @@ bool PVMFMP4FFParserNode::RetrieveTrackData(PVMP4FFNodeTrackPortInfo& aTrackPort
 
             textmediadata->iTextStringLengthInBytes = textSampleLengthFromSample;
         }
+        else if (useMappedSamples)
+        {
+            // Hand out the sample data in place; every fragment keeps
+            // the file mapping alive until it is released downstream.
+            for (int32 k = 0; k < iGau.buf.num_fragments; k++)
+            {
+                OsclMemoryFragment memFrag;
+                memFrag.ptr = iGau.buf.fragments[k].ptr;
+                memFrag.len = iGau.buf.fragments[k].len;
+                aTrackPortInfo.iMappedSampleRefCounter->addRef();
+                OsclRefCounterMemFrag refCountMemFragOut(memFrag, aTrackPortInfo.iMappedSampleRefCounter, 0);
+                media_data_impl->appendMediaFragment(refCountMemFragOut);
+            }
+        }
         else
         {
             // Set buffer size
@@ -5970,6 +6033,8 @@ void PVMFMP4FFParserNode::CleanupFileSource()
     iDownloadComplete = false;
     iMP4HeaderSize = 0;
     iProgressivelyDownlodable = false;
+    iMoovPrefetchOffset = 0;
+    iMoovPrefetchComplete = false;
     iCPMSequenceInProgress = false;
     iFastTrackSession = false;
     iProtectedFile = false;
@@ -7692,10 +7757,22 @@ void PVMFMP4FFParserNode::DataStreamCommandCompleted(const PVMFCmdResp& aRespons
                     }
                 }
             }
-            if (PVMFSuccess == CheckForMP4HeaderAvailability())
+            if (iMoovPrefetchOffset != 0)
+            {
+                // waiting on the movie atom from the end of the clip, reaching the
+                // end of the clip there does not mean the media data has been downloaded
+                iMoovPrefetchComplete = (aResponse.GetCmdStatus() == PVMFSuccess);
+                iDownloadComplete = false;
+            }
+            PVMFStatus status = CheckForMP4HeaderAvailability();
+            if (PVMFSuccess == status)
             {
                 CompleteInit(iCurrentCommand, iCurrentCommand.front());
             }
+            else if (PVMFErrContentInvalidForProgressivePlayback == status)
+            {
+                CommandComplete(iCurrentCommand, iCurrentCommand.front(), status);
+            }
         }
         else
         {
@@ -7900,6 +7977,18 @@ PVMFStatus PVMFMP4FFParserNode::CheckForMP4HeaderAvailability()
             iDataStreamRequestPending = true;
             return PVMFPending;
         }
+        else if (retCode == MOVIE_ATOM_AFTER_MEDIA_DATA)
+        {
+            // progressive playback and the movie atom follows the media data,
+            // try to fetch it from the end of the clip
+            PVMFStatus status = PrefetchTrailingMovieAtom();
+            if (status != PVMFFailure)
+            {
+                return status;
+            }
+            PVMF_MP4FFPARSERNODE_LOGERROR((0, "PVMFMP4FFParserNode::CheckForMP4HeaderAvailability() - Moov atom after media data could not be fetched"));
+            return PVMFErrContentInvalidForProgressivePlayback;
+        }
         else if (retCode == NOT_PROGRESSIVE_STREAMABLE)
         {
             // progressive playback and no movie atom found
@@ -7916,6 +8005,44 @@ PVMFStatus PVMFMP4FFParserNode::CheckForMP4HeaderAvailability()
     return PVMFSuccess;
 }
 
+PVMFStatus PVMFMP4FFParserNode::PrefetchTrailingMovieAtom()
+{
+    if (iMoovPrefetchOffset != 0)
+    {
+        // called again once the prefetch has finished
+        return (iMoovPrefetchComplete ? PVMFSuccess : PVMFFailure);
+    }
+
+    /*
+     * iMP4HeaderSize is the offset right after the media data atom.
+     * Make the rest of the clip persistent, the datastream then fetches
+     * it with a request starting at that offset instead of waiting for
+     * the download to get there.
+     */
+    uint32 contentLength = iDataStreamInterface->GetContentLength();
+    if ((iMP4HeaderSize == 0) || (contentLength <= iMP4HeaderSize))
+    {
+        return PVMFFailure;
+    }
+
+    if (iDataStreamInterface->MakePersistent(iMP4HeaderSize, contentLength - iMP4HeaderSize) != PVDS_SUCCESS)
+    {
+        PVMF_MP4FFPARSERNODE_LOGERROR((0, "PVMFMP4FFParserNode::PrefetchTrailingMovieAtom() - MakePersistent Failed offset %d", iMP4HeaderSize));
+        return PVMFFailure;
+    }
+
+    PVMF_MP4FFPARSERNODE_LOGDATATRAFFIC((0, "PVMFMP4FFParserNode::PrefetchTrailingMovieAtom() - Moov atom expected at file offset %d, content length %d", iMP4HeaderSize, contentLength));
+    iMoovPrefetchOffset = iMP4HeaderSize;
+    iProgressivelyDownlodable = true;
+
+    iRequestReadCapacityNotificationID =
+        iDataStreamInterface->RequestReadCapacityNotification(iDataStreamSessionID,
+                *this,
+                contentLength - 1);
+    iDataStreamRequestPending = true;
+    return PVMFPending;
+}
+
 PVMFStatus PVMFMP4FFParserNode::CheckForUnderFlow(PVMP4FFNodeTrackPortInfo* aInfo)
 {
     uint32 timebase32 = 0;
@@ -966,6 +966,7 @@ class PVMFMP4FFParserNode : public OsclTimerObject,
         void getBrand(uint32 langcode, char *LangCode);
 
         PVMFStatus CheckForMP4HeaderAvailability();
+        PVMFStatus PrefetchTrailingMovieAtom();
         int32 CreateErrorInfoMsg(PVMFBasicErrorInfoMessage** aErrorMsg, PVUuid aEventUUID, int32 aEventCode);
         void CreateDurationInfoMsg(uint32 adurationms);
         PVMFStatus PushKVPToMetadataValueList(Oscl_Vector<PvmiKvp, OsclMemAllocator>* aVecPtr, PvmiKvp& aKvpVal);
@@ -981,6 +982,9 @@ class PVMFMP4FFParserNode : public OsclTimerObject,
         uint32 iMP4HeaderSize;
         bool iDownloadComplete;
         bool iProgressivelyDownlodable;
+        // offset of a movie atom that follows the media data, fetched ahead of the download
+        uint32 iMoovPrefetchOffset;
+        bool iMoovPrefetchComplete;
         uint32 iLastNPTCalcInConvertSizeToTime;
         uint32 iFileSizeLastConvertedToTime;
         bool iFastTrackSession;
@@ -1029,6 +1033,7 @@ class PVMFMP4FFParserNode : public OsclTimerObject,
         bool iDataStreamRequestPending;
         bool iCPMSequenceInProgress;
         bool oIsAACFramesFragmented;
+        bool iUseMappedSampleAccess;
 
         int32 iPlayBackDirection;
         int32 iStartForNextTSSearch;
@@ -142,6 +142,7 @@ class PVMP4FFNodeTrackPortInfo : public OsclMemPoolFixedChunkAllocatorObserver,
             iMediaDataMemPool = NULL;
             iMediaDataGroupImplMemPool = NULL;
             iMediaDataGroupAlloc = NULL;
+            iMappedSampleRefCounter = NULL;
             iNode = NULL;
             iTimestamp = 0;
             iFirstFrameAfterRepositioning = false;
@@ -191,6 +192,7 @@ class PVMP4FFNodeTrackPortInfo : public OsclMemPoolFixedChunkAllocatorObserver,
             iMediaDataMemPool = aSrc.iMediaDataMemPool;
             iMediaDataGroupImplMemPool = aSrc.iMediaDataGroupImplMemPool;
             iMediaDataGroupAlloc = aSrc.iMediaDataGroupAlloc;
+            iMappedSampleRefCounter = aSrc.iMappedSampleRefCounter;
             iNode = aSrc.iNode;
             iTimestamp = aSrc.iTimestamp;
             iFirstFrameAfterRepositioning = aSrc.iFirstFrameAfterRepositioning;
@@ -304,6 +306,9 @@ class PVMP4FFNodeTrackPortInfo : public OsclMemPoolFixedChunkAllocatorObserver,
         OsclMemPoolFixedChunkAllocator* iMediaDataGroupImplMemPool;
         // Allocator for media frag group
         PVMFMediaFragGroupCombinedAlloc<OsclMemAllocator>* iMediaDataGroupAlloc;
+        // File mapping the parser returns samples from, NULL if samples are copied.
+        // Owned by the parser; addRef'ed for every fragment sent downstream.
+        OsclRefCounter* iMappedSampleRefCounter;
 
         // MP4 FF parser node handle as AO class
         OsclTimerObject* iNode;
@@ -26,6 +26,10 @@
 #include "threadsafe_mempool.h"
 #endif
 
+#ifndef THREADSAFE_LOCKFREE_MEMPOOL_H_INCLUDED
+#include "threadsafe_lockfree_mempool.h"
+#endif
+
 #ifndef OMX_Types_h
 #include "OMX_Types.h"
 #endif
@@ -123,7 +127,9 @@ class EmptyBufferDoneThreadSafeCallbackAO : public ThreadSafeCallbackAO
         virtual OsclAny* DeQueue(OsclReturnCode &stat);
 
         virtual ~EmptyBufferDoneThreadSafeCallbackAO();
-        ThreadSafeMemPoolFixedChunkAllocator *iMemoryPool;
+        // allocated from in the component thread (after the dummy allocation in
+        // the constructor) and freed in the node thread
+        ThreadSafeLockFreeMemPoolFixedChunkAllocator *iMemoryPool;
 };
 
 
@@ -146,7 +152,9 @@ class FillBufferDoneThreadSafeCallbackAO : public ThreadSafeCallbackAO
         virtual OsclAny* DeQueue(OsclReturnCode &stat);
 
         virtual ~FillBufferDoneThreadSafeCallbackAO();
-        ThreadSafeMemPoolFixedChunkAllocator *iMemoryPool;
+        // allocated from in the component thread (after the dummy allocation in
+        // the constructor) and freed in the node thread
+        ThreadSafeLockFreeMemPoolFixedChunkAllocator *iMemoryPool;
 };
 
 #endif  //#ifndef PVMF_OMX_BASEDEC_CALLBACKS_H_INLCUDED
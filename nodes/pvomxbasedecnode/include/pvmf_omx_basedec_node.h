@@ -371,6 +371,7 @@ class PVMFOMXBaseDecNode
         OSCL_IMPORT_REF PVMFStatus ThreadLogoff();
         OSCL_IMPORT_REF PVMFStatus GetCapability(PVMFNodeCapability& aNodeCapability);
         OSCL_IMPORT_REF PVMFPortIter* GetPorts(const PVMFPortFilter* aFilter = NULL);
+        OSCL_IMPORT_REF PVMFStatus GetNodeTelemetry(PVMFNodeTelemetry& aTelemetry);
         OSCL_IMPORT_REF PVMFCommandId QueryUUID(PVMFSessionId, const PvmfMimeString& aMimeType,
                                                 Oscl_Vector<PVUuid, PVMFOMXBaseDecNodeAllocator>& aUuids,
                                                 bool aExactUuidsOnly = false,
@@ -537,6 +538,10 @@ class PVMFOMXBaseDecNode
 
         bool SetDefaultCapabilityFlags();
         OSCL_IMPORT_REF bool CreateOutMemPool(uint32 num);
+        // Picks up the downstream fixed size buffer allocator, if any, so that the component
+        // can decode directly into sink memory. Returns false (node allocated buffers) if
+        // there is none or it cannot back the output port.
+        OSCL_IMPORT_REF bool NegotiateExternalOutputBufferAllocator(uint32 aMinBuffers);
         OSCL_IMPORT_REF bool CreateInputMemPool(uint32 num);
         OSCL_IMPORT_REF bool ProvideBuffersToComponent(OsclMemPoolFixedChunkAllocator *aMemPool, // allocator
                 uint32 aAllocSize,   // size to allocate from pool (hdr only or hdr+ buffer)
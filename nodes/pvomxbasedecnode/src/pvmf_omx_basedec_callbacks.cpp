@@ -172,7 +172,8 @@ EmptyBufferDoneThreadSafeCallbackAO::EmptyBufferDoneThreadSafeCallbackAO(void* a
         : ThreadSafeCallbackAO(aObserver, aDepth, aAOname, aPriority)
 {
 
-    iMemoryPool = ThreadSafeMemPoolFixedChunkAllocator::Create(aDepth + 2);
+    // single freeing thread (the node), so no atomic operations are needed to free
+    iMemoryPool = ThreadSafeLockFreeMemPoolFixedChunkAllocator::Create(aDepth + 2, 0, NULL, false);
     if (iMemoryPool == NULL)
     {
         PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger,
@@ -314,7 +315,8 @@ FillBufferDoneThreadSafeCallbackAO::FillBufferDoneThreadSafeCallbackAO(void* aOb
         : ThreadSafeCallbackAO(aObserver, aDepth, aAOname, aPriority)
 {
 
-    iMemoryPool = ThreadSafeMemPoolFixedChunkAllocator::Create(aDepth + 2);
+    // single freeing thread (the node), so no atomic operations are needed to free
+    iMemoryPool = ThreadSafeLockFreeMemPoolFixedChunkAllocator::Create(aDepth + 2, 0, NULL, false);
     if (iMemoryPool == NULL)
     {
         PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger,
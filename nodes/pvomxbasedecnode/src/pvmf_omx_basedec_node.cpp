@@ -300,6 +300,12 @@ OSCL_EXPORT_REF PVMFOMXBaseDecNode::~PVMFOMXBaseDecNode()
         iInBufMemoryPool->removeRef();
         iInBufMemoryPool = NULL;
     }
+    if (ipExternalOutputBufferAllocatorInterface)
+    {
+        ipExternalOutputBufferAllocatorInterface->removeRef();
+        ipExternalOutputBufferAllocatorInterface = NULL;
+        ipFixedSizeBufferAlloc = NULL;
+    }
     if (iTrackUnderVerificationConfig)
     {
         oscl_free(iTrackUnderVerificationConfig);
@@ -379,6 +385,13 @@ OSCL_EXPORT_REF PVMFPortIter* PVMFOMXBaseDecNode::GetPorts(const PVMFPortFilter*
     return NULL;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+OSCL_EXPORT_REF PVMFStatus PVMFOMXBaseDecNode::GetNodeTelemetry(PVMFNodeTelemetry& aTelemetry)
+{
+    PVMFPortInterface* ports[] = {iInPort, iOutPort};
+    return GetNodeTelemetryForPorts(aTelemetry, ports, 2);
+}
+
 /////////////////////////////////////////////////////////////////////////////
 OSCL_EXPORT_REF PVMFCommandId PVMFOMXBaseDecNode::QueueCommandL(PVMFOMXBaseDecNodeCommand& aCmd)
 {
@@ -562,6 +575,7 @@ OSCL_EXPORT_REF PVMFOMXBaseDecNode::PVMFOMXBaseDecNode(int32 aPriority, const ch
         iCompactFSISettingSucceeded(false),
         bHWAccelerated(accelerated? OMX_TRUE: OMX_FALSE)
 {
+    SetTelemetryActiveObject(this);
     iThreadSafeHandlerEventHandler = NULL;
     iThreadSafeHandlerEmptyBufferDone = NULL;
     iThreadSafeHandlerFillBufferDone = NULL;
@@ -569,6 +583,10 @@ OSCL_EXPORT_REF PVMFOMXBaseDecNode::PVMFOMXBaseDecNode(int32 aPriority, const ch
     iInBufMemoryPool = NULL;
     iOutBufMemoryPool = NULL;
 
+    // no external output buffer allocator until one is negotiated
+    ipExternalOutputBufferAllocatorInterface = NULL;
+    ipFixedSizeBufferAlloc = NULL;
+
     // init to some value
     iOMXComponentOutputBufferSize = 0;
     iNumOutputBuffers = 0;
@@ -3086,6 +3104,104 @@ OSCL_EXPORT_REF bool PVMFOMXBaseDecNode::CreateOutMemPool(uint32 num_buffers)
     PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_STACK_TRACE, (0, "%s::CreateOutMemPool() done", iName.Str()));
     return true;
 }
+
+/////////////////////////////////////////////////////////////////////////////
+// Query the downstream port for a fixed size buffer allocator. If the component can
+// use OMX_UseBuffer on its output port and the sink offers enough buffers of the
+// negotiated size, output buffers are taken from the sink and decoded frames reach it
+// without a copy. Otherwise the node falls back to its own (or the component's) buffers.
+// On success iNumOutputBuffers and iOMXComponentOutputBufferSize are updated.
+/////////////////////////////////////////////////////////////////////////////
+OSCL_EXPORT_REF bool PVMFOMXBaseDecNode::NegotiateExternalOutputBufferAllocator(uint32 aMinBuffers)
+{
+    if (ipExternalOutputBufferAllocatorInterface)
+    {
+        ipExternalOutputBufferAllocatorInterface->removeRef();
+        ipExternalOutputBufferAllocatorInterface = NULL;
+    }
+    ipFixedSizeBufferAlloc = NULL;
+
+    if (!iOMXComponentSupportsExternalOutputBufferAlloc)
+    {
+        // the component allocates its own output buffers, so sink memory cannot be used
+        PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_INFO,
+                        (0, "%s::NegotiateExternalOutputBufferAllocator() Component does not support OMX_UseBuffer on output, using component buffers", iName.Str()));
+        return false;
+    }
+
+    PvmiKvp* kvp = NULL;
+    int numKvp = 0;
+    PvmiKeyType aIdentifier = (PvmiKeyType)PVMF_BUFFER_ALLOCATOR_KEY;
+    int32 err = OsclErrNone;
+    int32 err1 = OsclErrNone;
+
+    OSCL_TRY(err, ((PVMFOMXDecPort*)iOutPort)->pvmiGetBufferAllocatorSpecificInfoSync(aIdentifier, kvp, numKvp););
+    if ((err != OsclErrNone) || (NULL == kvp))
+    {
+        PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_INFO,
+                        (0, "%s::NegotiateExternalOutputBufferAllocator() No external allocator downstream, using node buffers", iName.Str()));
+        return false;
+    }
+
+    ipExternalOutputBufferAllocatorInterface = (PVInterface*) kvp->value.key_specific_value;
+
+    PVInterface* pTempPVInterfacePtr = NULL;
+    if (ipExternalOutputBufferAllocatorInterface)
+    {
+        OSCL_TRY(err, ipExternalOutputBufferAllocatorInterface->queryInterface(PVMFFixedSizeBufferAllocUUID, pTempPVInterfacePtr););
+    }
+
+    OSCL_TRY(err1, ((PVMFOMXDecPort*)iOutPort)->releaseParametersSync(kvp, numKvp););
+    if (err1 != OsclErrNone)
+    {
+        PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_DEBUG,
+                        (0, "%s::NegotiateExternalOutputBufferAllocator() Unable to Release Parameters", iName.Str()));
+    }
+
+    if (NULL == ipExternalOutputBufferAllocatorInterface)
+    {
+        return false;
+    }
+
+    if ((err != OsclErrNone) || (NULL == pTempPVInterfacePtr))
+    {
+        PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_INFO,
+                        (0, "%s::NegotiateExternalOutputBufferAllocator() External allocator is not fixed size, using node buffers", iName.Str()));
+        ipExternalOutputBufferAllocatorInterface->removeRef();
+        ipExternalOutputBufferAllocatorInterface = NULL;
+        return false;
+    }
+
+    ipFixedSizeBufferAlloc = OSCL_STATIC_CAST(PVMFFixedSizeBufferAlloc*, pTempPVInterfacePtr);
+
+    uint32 numBuffers = ipFixedSizeBufferAlloc->getNumBuffers();
+    uint32 bufferSize = ipFixedSizeBufferAlloc->getBufferSize();
+
+    if ((numBuffers < aMinBuffers) || (bufferSize < iOMXComponentOutputBufferSize))
+    {
+        PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_INFO,
+                        (0, "%s::NegotiateExternalOutputBufferAllocator() External allocator has %d buffers of size %d, need %d of size %d, using node buffers",
+                         iName.Str(), numBuffers, bufferSize, aMinBuffers, iOMXComponentOutputBufferSize));
+        ipExternalOutputBufferAllocatorInterface->removeRef();
+        ipExternalOutputBufferAllocatorInterface = NULL;
+        ipFixedSizeBufferAlloc = NULL;
+        return false;
+    }
+
+    // Use as many sink buffers as the output port queue can hold, but never fewer
+    // than the component needs
+    iNumOutputBuffers = numBuffers;
+    if (iNumOutputBuffers > NUMBER_OUTPUT_BUFFER)
+    {
+        iNumOutputBuffers = (aMinBuffers > NUMBER_OUTPUT_BUFFER) ? aMinBuffers : NUMBER_OUTPUT_BUFFER;
+    }
+    iOMXComponentOutputBufferSize = bufferSize;
+
+    PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_INFO,
+                    (0, "%s::NegotiateExternalOutputBufferAllocator() Using %d external output buffers of size %d",
+                     iName.Str(), iNumOutputBuffers, iOMXComponentOutputBufferSize));
+    return true;
+}
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////// Creates memory pool for input buffer management ///////////////////////
 /////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -3201,6 +3317,57 @@ OSCL_EXPORT_REF bool PVMFOMXBaseDecNode::ProvideBuffersToComponent(OsclMemPoolFi
         return false;
     }
 
+    // Output buffers from an external allocator are all taken up front. If the sink
+    // cannot hand out every buffer it advertised, they are returned and the node
+    // falls back to its own output buffers instead of failing.
+    OsclAny **ext_buf_ptr = NULL;
+    if (aUseBufferOK && !aIsThisInputBuffer && ipExternalOutputBufferAllocatorInterface)
+    {
+        ext_buf_ptr = (OsclAny **) oscl_malloc(aNumBuffers * sizeof(OsclAny *));
+        if (ext_buf_ptr == NULL)
+        {
+            oscl_free(ctrl_struct_ptr);
+            return false;
+        }
+
+        uint32 num_ext = 0;
+        while (num_ext < aNumBuffers)
+        {
+            ext_buf_ptr[num_ext] = ipFixedSizeBufferAlloc->allocate();
+            if (NULL == ext_buf_ptr[num_ext])
+            {
+                break;
+            }
+            num_ext++;
+        }
+
+        if (num_ext < aNumBuffers)
+        {
+            PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_INFO,
+                            (0, "%s::ProvideBuffersToComponent External allocator gave %d of %d buffers, falling back to node buffers", iName.Str(), num_ext, aNumBuffers));
+
+            while (num_ext > 0)
+            {
+                ipFixedSizeBufferAlloc->deallocate(ext_buf_ptr[--num_ext]);
+            }
+            oscl_free(ext_buf_ptr);
+            ext_buf_ptr = NULL;
+
+            ipExternalOutputBufferAllocatorInterface->removeRef();
+            ipExternalOutputBufferAllocatorInterface = NULL;
+            ipFixedSizeBufferAlloc = NULL;
+
+            // re-create the pool so that each chunk carries its own buffer
+            if (!CreateOutMemPool(aNumBuffers))
+            {
+                oscl_free(ctrl_struct_ptr);
+                return false;
+            }
+            aMemPool = iOutBufMemoryPool;
+            aAllocSize = iOutputAllocSize;
+        }
+    }
+
 
 
     // Now, go through all buffers and tell component to
@@ -3228,6 +3395,10 @@ OSCL_EXPORT_REF bool PVMFOMXBaseDecNode::ProvideBuffersToComponent(OsclMemPoolFi
                 ChangeNodeState(EPVMFNodeError);
             }
 
+            if (ext_buf_ptr)
+            {
+                oscl_free(ext_buf_ptr);
+            }
             return false;
         }
 
@@ -3272,21 +3443,12 @@ OSCL_EXPORT_REF bool PVMFOMXBaseDecNode::ProvideBuffersToComponent(OsclMemPoolFi
             }
             else
             {
-                if (ipExternalOutputBufferAllocatorInterface)
+                if (ext_buf_ptr)
                 {
-                    // Actual buffer memory will be allocated outside the node from
+                    // Actual buffer memory was allocated outside the node from
                     // an external output buffer allocator interface
 
-                    uint8 *pB = (uint8*) ipFixedSizeBufferAlloc->allocate();
-                    if (NULL == pB)
-                    {
-                        //  error
-                        PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_ERR,
-                                        (0, "%s::ProvideBuffersToComponent ->allocate() failed due to some general error", iName.Str()));
-                        ReportErrorEvent(PVMFFailure);
-                        ChangeNodeState(EPVMFNodeError);
-                        return false;
-                    }
+                    uint8 *pB = (uint8*) ext_buf_ptr[ii];
 
                     OutputBufCtrlStruct *temp = (OutputBufCtrlStruct *)ctrl_struct_ptr[ii];
 
@@ -3366,12 +3528,20 @@ OSCL_EXPORT_REF bool PVMFOMXBaseDecNode::ProvideBuffersToComponent(OsclMemPoolFi
             PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_ERR,
                             (0, "%s::ProvideBuffersToComponent() Problem using/allocating a buffer", iName.Str()));
 
-
+            if (ext_buf_ptr)
+            {
+                oscl_free(ext_buf_ptr);
+            }
             return false;
         }
 
     }
 
+    if (ext_buf_ptr)
+    {
+        oscl_free(ext_buf_ptr);
+    }
+
     for (ii = 0; ii < aNumBuffers; ii++)
     {
         // after initializing the buffer hdr ptrs, return them
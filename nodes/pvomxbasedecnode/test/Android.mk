@@ -0,0 +1,37 @@
+LOCAL_PATH := $(call my-dir)
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES := \
+ 	src/pvmf_omx_basedec_buffer_alloc_test.cpp
+
+
+LOCAL_MODULE := pv_omx_basedec_buffer_alloc_test
+
+LOCAL_CFLAGS :=  $(PV_CFLAGS)
+
+
+
+LOCAL_STATIC_LIBRARIES := 
+
+LOCAL_SHARED_LIBRARIES := libopencore_common
+
+LOCAL_C_INCLUDES := \
+	$(PV_TOP)/nodes/pvomxbasedecnode/test/src \
+ 	$(PV_TOP)/nodes/pvomxbasedecnode/test/src \
+ 	$(PV_TOP)/nodes/pvomxbasedecnode/include \
+ 	$(PV_TOP)/nodes/pvomxbasedecnode/src \
+ 	$(PV_TOP)/nodes/pvomxvideodecnode/include \
+ 	$(PV_TOP)/nodes/pvomxvideodecnode/src \
+ 	$(PV_TOP)/extern_libs_v2/khronos/openmax/include \
+ 	$(PV_TOP)/codecs_v2/video/wmv_vc1/dec/src \
+ 	$(PV_TOP)/baselibs/threadsafe_callback_ao/src \
+ 	$(PV_INCLUDES)
+
+LOCAL_COPY_HEADERS_TO := $(PV_COPY_HEADERS_TO)
+
+LOCAL_COPY_HEADERS := \
+ 	
+
+-include $(PV_TOP)/Android_system_extras.mk
+
+include $(BUILD_EXECUTABLE)
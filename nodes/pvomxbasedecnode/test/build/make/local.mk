@@ -0,0 +1,30 @@
+# Get the current local path as the first operation
+LOCAL_PATH := $(call get_makefile_dir)
+
+# Clear out the variables used in the local makefiles
+include $(MK)/clear.mk
+
+TARGET := pv_omx_basedec_buffer_alloc_test
+
+
+XCXXFLAGS += $(FLAG_COMPILE_WARNINGS_AS_ERRORS)
+
+XINCDIRS += \
+  ../../../include \
+  ../../../src \
+  ../../../../pvomxvideodecnode/include \
+  ../../../../pvomxvideodecnode/src \
+  ../../../../../extern_libs_v2/khronos/openmax/include \
+  ../../../../../codecs_v2/video/wmv_vc1/dec/src \
+  ../../../../../baselibs/threadsafe_callback_ao/src
+
+SRCDIR := ../../src
+INCSRCDIR := ../../src
+
+SRCS := pvmf_omx_basedec_buffer_alloc_test.cpp
+
+LIBS := opencore_common
+
+SYSLIBS += $(SYS_THREAD_LIB)
+
+include $(MK)/prog.mk
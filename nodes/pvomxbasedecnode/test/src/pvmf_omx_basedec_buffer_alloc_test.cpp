@@ -0,0 +1,525 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+
+// Negotiates the output buffers of the OMX video decoder node with a sink that
+// offers a fixed size buffer allocator (PVMF_BUFFER_ALLOCATOR_KEY), the way the
+// video MIOs do, and hands them to a stand-in OMX component through
+// OMX_UseBuffer.  Checks that the sink buffers are used when the allocator
+// delivers them, that the node falls back to its own buffers when the allocator
+// comes up short part-way through, and that allocators which are too small are
+// refused.  In every case the allocator reference taken by the node must be
+// released again.
+
+#include "stdio.h"
+#include "oscl_base.h"
+#include "oscl_mem.h"
+#include "oscl_error.h"
+#include "oscl_scheduler.h"
+#include "pvlogger.h"
+#include "pv_interface.h"
+#include "pvmi_kvp.h"
+#include "pvmi_config_and_capability.h"
+#include "pvmf_port_base_impl.h"
+#include "pvmf_fixedsize_buffer_alloc.h"
+#include "pvmf_omx_basedec_port.h"
+#include "pvmf_omx_videodec_node.h"
+
+#define TEST_OUTPUT_PORT_INDEX      1
+#define TEST_MIN_BUFFERS            4
+#define TEST_COMPONENT_BUFFER_SIZE  3000
+#define TEST_SINK_BUFFER_SIZE       4096
+#define TEST_MAX_BUFFERS            16
+
+// Sink side allocator: advertises iNumBuffers, but only hands out iNumAvailable.
+class TestBufferAlloc : public PVInterface, public PVMFFixedSizeBufferAlloc
+{
+    public:
+        TestBufferAlloc(uint32 aBufferSize, uint32 aNumBuffers, uint32 aNumAvailable)
+                : iRefCount(0), iBufferSize(aBufferSize), iNumBuffers(aNumBuffers),
+                iNumAvailable(aNumAvailable), iNumOutstanding(0), iNumBadFrees(0)
+        {
+            iBlock = (uint8*)oscl_malloc(aBufferSize * aNumBuffers);
+            for (uint32 i = 0; i < TEST_MAX_BUFFERS; i++)
+            {
+                iInUse[i] = false;
+            }
+        }
+        ~TestBufferAlloc()
+        {
+            oscl_free(iBlock);
+        }
+
+        // From PVInterface
+        void addRef()
+        {
+            iRefCount++;
+        }
+        void removeRef()
+        {
+            iRefCount--;
+        }
+        bool queryInterface(const PVUuid& uuid, PVInterface*& aInterface)
+        {
+            aInterface = NULL;
+            if (uuid == PVMFFixedSizeBufferAllocUUID)
+            {
+                addRef();
+                aInterface = OSCL_STATIC_CAST(PVInterface*, OSCL_STATIC_CAST(PVMFFixedSizeBufferAlloc*, this));
+                return true;
+            }
+            return false;
+        }
+
+        // From PVMFFixedSizeBufferAlloc
+        OsclAny* allocate()
+        {
+            if (iNumOutstanding >= iNumAvailable)
+            {
+                return NULL;
+            }
+            for (uint32 i = 0; i < iNumBuffers; i++)
+            {
+                if (!iInUse[i])
+                {
+                    iInUse[i] = true;
+                    iNumOutstanding++;
+                    return iBlock + i * iBufferSize;
+                }
+            }
+            return NULL;
+        }
+        void deallocate(OsclAny* ptr)
+        {
+            uint32 i = (uint32)((uint8*)ptr - iBlock) / iBufferSize;
+            if (!Owns(ptr) || !iInUse[i])
+            {
+                iNumBadFrees++;
+                return;
+            }
+            iInUse[i] = false;
+            iNumOutstanding--;
+        }
+        uint32 getBufferSize()
+        {
+            return iBufferSize;
+        }
+        uint32 getNumBuffers()
+        {
+            return iNumBuffers;
+        }
+
+        bool Owns(OsclAny* ptr)
+        {
+            return ((uint8*)ptr >= iBlock) && ((uint8*)ptr < iBlock + iBufferSize * iNumBuffers);
+        }
+
+        int32 iRefCount;
+        uint32 iBufferSize;
+        uint32 iNumBuffers;
+        uint32 iNumAvailable;
+        uint32 iNumOutstanding;
+        uint32 iNumBadFrees;
+        uint8* iBlock;
+        bool iInUse[TEST_MAX_BUFFERS];
+};
+
+class TestPortActivityHandler : public PVMFPortActivityHandler
+{
+    public:
+        void HandlePortActivity(const PVMFPortActivity&) {}
+};
+
+// Sink input port; serves the allocator the way the media output node passes
+// PVMF_BUFFER_ALLOCATOR_KEY on to its MIO.
+class TestSinkPort : public PvmfPortBaseImpl, public PvmiCapabilityAndConfig
+{
+    public:
+        TestSinkPort(PVMFPortActivityHandler* aHandler, TestBufferAlloc* aAlloc)
+                : PvmfPortBaseImpl(0, aHandler, "TestSinkIn"), iAlloc(aAlloc),
+                iNumAllocatorQueries(0), iNumReleases(0)
+        {
+        }
+
+        void QueryInterface(const PVUuid& aUuid, OsclAny*& aPtr)
+        {
+            aPtr = NULL;
+            if (aUuid == PVMI_CAPABILITY_AND_CONFIG_PVUUID)
+            {
+                aPtr = (PvmiCapabilityAndConfig*)this;
+            }
+        }
+
+        // From PvmiCapabilityAndConfig
+        void setObserver(PvmiConfigAndCapabilityCmdObserver*) {}
+        PVMFStatus getParametersSync(PvmiMIOSession, PvmiKeyType aIdentifier, PvmiKvp*& aParameters,
+                                     int& num_parameter_elements, PvmiCapabilityContext)
+        {
+            num_parameter_elements = 0;
+            if ((oscl_strcmp(aIdentifier, PVMF_BUFFER_ALLOCATOR_KEY) != 0) || (iAlloc == NULL))
+            {
+                return PVMFFailure;
+            }
+            iNumAllocatorQueries++;
+            aParameters = (PvmiKvp*)oscl_malloc(sizeof(PvmiKvp));
+            aParameters[0].value.key_specific_value = (PVInterface*)iAlloc;
+            num_parameter_elements = 1;
+            return PVMFSuccess;
+        }
+        PVMFStatus releaseParameters(PvmiMIOSession, PvmiKvp* aParameters, int)
+        {
+            iNumReleases++;
+            oscl_free(aParameters);
+            return PVMFSuccess;
+        }
+        void createContext(PvmiMIOSession, PvmiCapabilityContext&) {}
+        void setContextParameters(PvmiMIOSession, PvmiCapabilityContext&, PvmiKvp*, int) {}
+        void DeleteContext(PvmiMIOSession, PvmiCapabilityContext&) {}
+        void setParametersSync(PvmiMIOSession, PvmiKvp* aParameters, int, PvmiKvp*& aRet_kvp)
+        {
+            aRet_kvp = aParameters;
+        }
+        PVMFCommandId setParametersAsync(PvmiMIOSession, PvmiKvp*, int, PvmiKvp*&, OsclAny*)
+        {
+            return -1;
+        }
+        uint32 getCapabilityMetric(PvmiMIOSession)
+        {
+            return 0;
+        }
+        PVMFStatus verifyParametersSync(PvmiMIOSession, PvmiKvp*, int)
+        {
+            return PVMFSuccess;
+        }
+
+        TestBufferAlloc* iAlloc;
+        uint32 iNumAllocatorQueries;
+        uint32 iNumReleases;
+};
+
+// Stand-in for the OMX component: only OMX_UseBuffer and OMX_FreeBuffer are
+// called while the output buffers are provided and freed.
+static OMX_U8* TestUsedBuffers[TEST_MAX_BUFFERS];
+static uint32 TestNumUsedBuffers = 0;
+static uint32 TestNumHeaders = 0;
+
+static OMX_ERRORTYPE TestUseBuffer(OMX_HANDLETYPE, OMX_BUFFERHEADERTYPE** ppBufferHdr, OMX_U32 nPortIndex,
+                                   OMX_PTR pAppPrivate, OMX_U32 nSizeBytes, OMX_U8* pBuffer)
+{
+    if ((nPortIndex != TEST_OUTPUT_PORT_INDEX) || (TestNumUsedBuffers >= TEST_MAX_BUFFERS))
+    {
+        return OMX_ErrorBadParameter;
+    }
+    OMX_BUFFERHEADERTYPE* hdr = (OMX_BUFFERHEADERTYPE*)oscl_malloc(sizeof(OMX_BUFFERHEADERTYPE));
+    oscl_memset(hdr, 0, sizeof(OMX_BUFFERHEADERTYPE));
+    hdr->pBuffer = pBuffer;
+    hdr->nAllocLen = nSizeBytes;
+    hdr->pAppPrivate = pAppPrivate;
+    *ppBufferHdr = hdr;
+    TestUsedBuffers[TestNumUsedBuffers++] = pBuffer;
+    TestNumHeaders++;
+    return OMX_ErrorNone;
+}
+
+static OMX_ERRORTYPE TestFreeBuffer(OMX_HANDLETYPE, OMX_U32, OMX_BUFFERHEADERTYPE* pBuffer)
+{
+    oscl_free(pBuffer);
+    TestNumHeaders--;
+    return OMX_ErrorNone;
+}
+
+// Gives the test access to the buffer negotiation of the node.
+class TestVideoDecNode : public PVMFOMXVideoDecNode
+{
+    public:
+        TestVideoDecNode(PVMFPortInterface* aSinkPort, OMX_COMPONENTTYPE* aComponent, bool aUseBufferOK)
+                : PVMFOMXVideoDecNode(OsclActiveObject::EPriorityNominal, false)
+        {
+            iOutPort = OSCL_NEW(PVMFOMXDecPort, ((int32)PVMF_OMX_DEC_NODE_PORT_TYPE_OUTPUT, this, PVMF_OMX_VIDEO_DEC_OUTPUT_PORT_NAME));
+            aSinkPort->Connect(iOutPort);
+            iOMXDecoder = (OMX_HANDLETYPE)aComponent;
+            iOutputPortIndex = TEST_OUTPUT_PORT_INDEX;
+            iOMXComponentSupportsExternalOutputBufferAlloc = aUseBufferOK;
+            iOMXComponentOutputBufferSize = TEST_COMPONENT_BUFFER_SIZE;
+            iNumOutputBuffers = TEST_MIN_BUFFERS;
+        }
+        ~TestVideoDecNode()
+        {
+            // not a real component handle
+            iOMXDecoder = NULL;
+        }
+
+        bool Negotiate()
+        {
+            return NegotiateExternalOutputBufferAllocator(TEST_MIN_BUFFERS);
+        }
+
+        // same steps as the node takes when the output port is (re-)enabled
+        bool Provide()
+        {
+            if (!CreateOutMemPool(iNumOutputBuffers))
+            {
+                return false;
+            }
+            out_ctrl_struct_ptr = (OsclAny **) oscl_malloc(iNumOutputBuffers * sizeof(OsclAny *));
+            out_buff_hdr_ptr = (OsclAny **) oscl_malloc(iNumOutputBuffers * sizeof(OsclAny *));
+            return ProvideBuffersToComponent(iOutBufMemoryPool, iOutputAllocSize, iNumOutputBuffers,
+                                             iOMXComponentOutputBufferSize, iOutputPortIndex,
+                                             iOMXComponentSupportsExternalOutputBufferAlloc, false);
+        }
+
+        bool Free()
+        {
+            return FreeBuffersFromComponent(iOutBufMemoryPool, iOutputAllocSize, iNumOutputBuffers,
+                                            iOutputPortIndex, false);
+        }
+
+        bool UsesExternalAllocator()
+        {
+            return (ipExternalOutputBufferAllocatorInterface != NULL);
+        }
+        uint32 NumOutputBuffers()
+        {
+            return iNumOutputBuffers;
+        }
+        uint32 OutputBufferSize()
+        {
+            return iOMXComponentOutputBufferSize;
+        }
+};
+
+static void InitComponent(OMX_COMPONENTTYPE& aComponent)
+{
+    oscl_memset(&aComponent, 0, sizeof(OMX_COMPONENTTYPE));
+    aComponent.nSize = sizeof(OMX_COMPONENTTYPE);
+    aComponent.UseBuffer = TestUseBuffer;
+    aComponent.FreeBuffer = TestFreeBuffer;
+    TestNumUsedBuffers = 0;
+    TestNumHeaders = 0;
+}
+
+// The sink delivers every buffer it advertises; the component gets only sink buffers.
+static bool TestSinkBuffersUsed()
+{
+    TestBufferAlloc alloc(TEST_SINK_BUFFER_SIZE, 6, 6);
+    TestPortActivityHandler handler;
+    TestSinkPort sinkPort(&handler, &alloc);
+    OMX_COMPONENTTYPE component;
+    InitComponent(component);
+
+    bool ok = true;
+    {
+        TestVideoDecNode node(&sinkPort, &component, true);
+        if (!node.Negotiate() || !node.UsesExternalAllocator())
+        {
+            printf("  allocator with 6 buffers of %d bytes was not used\n", TEST_SINK_BUFFER_SIZE);
+            ok = false;
+        }
+        else if ((node.NumOutputBuffers() != 6) || (node.OutputBufferSize() != TEST_SINK_BUFFER_SIZE))
+        {
+            printf("  negotiated %d buffers of %d bytes\n", node.NumOutputBuffers(), node.OutputBufferSize());
+            ok = false;
+        }
+        else if (!node.Provide())
+        {
+            printf("  providing the buffers failed\n");
+            ok = false;
+        }
+        else
+        {
+            for (uint32 i = 0; i < TestNumUsedBuffers; i++)
+            {
+                if (!alloc.Owns(TestUsedBuffers[i]))
+                {
+                    printf("  buffer %d is not a sink buffer\n", i);
+                    ok = false;
+                }
+            }
+            if ((TestNumUsedBuffers != 6) || (alloc.iNumOutstanding != 6))
+            {
+                printf("  component got %d buffers, %d taken from the sink\n", TestNumUsedBuffers, alloc.iNumOutstanding);
+                ok = false;
+            }
+            if (!node.Free())
+            {
+                printf("  freeing the buffers failed\n");
+                ok = false;
+            }
+        }
+    }
+
+    if ((alloc.iNumOutstanding != 0) || (alloc.iNumBadFrees != 0) || (alloc.iRefCount != 0) ||
+            (TestNumHeaders != 0) || (sinkPort.iNumReleases != sinkPort.iNumAllocatorQueries))
+    {
+        printf("  left %d sink buffers, %d bad frees, %d allocator refs, %d headers\n",
+               alloc.iNumOutstanding, alloc.iNumBadFrees, alloc.iRefCount, TestNumHeaders);
+        ok = false;
+    }
+    return ok;
+}
+
+// The sink advertises 6 buffers but hands out only 3: the node must give them
+// back, drop the allocator and provide its own buffers instead.
+static bool TestShortAllocatorFallback()
+{
+    TestBufferAlloc alloc(TEST_SINK_BUFFER_SIZE, 6, 3);
+    TestPortActivityHandler handler;
+    TestSinkPort sinkPort(&handler, &alloc);
+    OMX_COMPONENTTYPE component;
+    InitComponent(component);
+
+    bool ok = true;
+    {
+        TestVideoDecNode node(&sinkPort, &component, true);
+        if (!node.Negotiate())
+        {
+            printf("  allocator was refused before any buffer was taken\n");
+            ok = false;
+        }
+        else if (!node.Provide())
+        {
+            printf("  providing the buffers failed after the allocator came up short\n");
+            ok = false;
+        }
+        else
+        {
+            if (node.UsesExternalAllocator() || (alloc.iRefCount != 0))
+            {
+                printf("  allocator was kept, %d refs\n", alloc.iRefCount);
+                ok = false;
+            }
+            if (alloc.iNumOutstanding != 0)
+            {
+                printf("  %d sink buffers were not returned\n", alloc.iNumOutstanding);
+                ok = false;
+            }
+            if (TestNumUsedBuffers != node.NumOutputBuffers())
+            {
+                printf("  component got %d of %d buffers\n", TestNumUsedBuffers, node.NumOutputBuffers());
+                ok = false;
+            }
+            for (uint32 i = 0; i < TestNumUsedBuffers; i++)
+            {
+                if (alloc.Owns(TestUsedBuffers[i]))
+                {
+                    printf("  buffer %d is a sink buffer\n", i);
+                    ok = false;
+                }
+                // node buffers must not overlap
+                for (uint32 j = 0; j < i; j++)
+                {
+                    int32 d = (int32)(TestUsedBuffers[i] - TestUsedBuffers[j]);
+                    if ((d < (int32)node.OutputBufferSize()) && (d > -(int32)node.OutputBufferSize()))
+                    {
+                        printf("  buffers %d and %d overlap\n", j, i);
+                        ok = false;
+                    }
+                }
+            }
+            if (!node.Free())
+            {
+                printf("  freeing the buffers failed\n");
+                ok = false;
+            }
+        }
+    }
+
+    if ((alloc.iNumOutstanding != 0) || (alloc.iNumBadFrees != 0) || (alloc.iRefCount != 0) ||
+            (TestNumHeaders != 0) || (sinkPort.iNumReleases != sinkPort.iNumAllocatorQueries))
+    {
+        printf("  left %d sink buffers, %d bad frees, %d allocator refs, %d headers\n",
+               alloc.iNumOutstanding, alloc.iNumBadFrees, alloc.iRefCount, TestNumHeaders);
+        ok = false;
+    }
+    return ok;
+}
+
+// Allocators the node cannot use are released at once, and a component that
+// allocates its own output buffers never asks the sink.
+static bool TestAllocatorRefused(uint32 aBufferSize, uint32 aNumBuffers, bool aUseBufferOK)
+{
+    TestBufferAlloc alloc(aBufferSize, aNumBuffers, aNumBuffers);
+    TestPortActivityHandler handler;
+    TestSinkPort sinkPort(&handler, &alloc);
+    OMX_COMPONENTTYPE component;
+    InitComponent(component);
+
+    bool ok = true;
+    {
+        TestVideoDecNode node(&sinkPort, &component, aUseBufferOK);
+        if (node.Negotiate() || node.UsesExternalAllocator())
+        {
+            printf("  allocator with %d buffers of %d bytes was accepted\n", aNumBuffers, aBufferSize);
+            ok = false;
+        }
+        if ((node.NumOutputBuffers() != TEST_MIN_BUFFERS) || (node.OutputBufferSize() != TEST_COMPONENT_BUFFER_SIZE))
+        {
+            printf("  negotiated %d buffers of %d bytes\n", node.NumOutputBuffers(), node.OutputBufferSize());
+            ok = false;
+        }
+    }
+
+    if (!aUseBufferOK && (sinkPort.iNumAllocatorQueries != 0))
+    {
+        printf("  sink was asked for an allocator\n");
+        ok = false;
+    }
+    if ((alloc.iRefCount != 0) || (sinkPort.iNumReleases != sinkPort.iNumAllocatorQueries))
+    {
+        printf("  %d allocator refs, %d of %d queries released\n",
+               alloc.iRefCount, sinkPort.iNumReleases, sinkPort.iNumAllocatorQueries);
+        ok = false;
+    }
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    OsclBase::Init();
+    OsclErrorTrap::Init();
+    OsclMem::Init();
+    PVLogger::Init();
+    OsclScheduler::Init("PVOMXBaseDecBufferAllocTest");
+
+    uint32 failures = 0;
+    bool ok = TestSinkBuffersUsed();
+    printf("sink buffers used: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    ok = TestShortAllocatorFallback();
+    printf("short allocator falls back to node buffers: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    ok = TestAllocatorRefused(TEST_SINK_BUFFER_SIZE, TEST_MIN_BUFFERS - 1, true);
+    printf("allocator with too few buffers refused: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    ok = TestAllocatorRefused(TEST_COMPONENT_BUFFER_SIZE - 1, 6, true);
+    printf("allocator with small buffers refused: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    ok = TestAllocatorRefused(TEST_SINK_BUFFER_SIZE, 6, false);
+    printf("component without OMX_UseBuffer on output: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    OsclScheduler::Cleanup();
+    PVLogger::Cleanup();
+    OsclMem::Cleanup();
+    OsclErrorTrap::Cleanup();
+    OsclBase::Cleanup();
+    return (failures == 0) ? 0 : 1;
+}
@@ -479,6 +479,13 @@ PVMFPortIter* PVMFOMXEncNode::GetPorts(const PVMFPortFilter* aFilter)
     return NULL;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+PVMFStatus PVMFOMXEncNode::GetNodeTelemetry(PVMFNodeTelemetry& aTelemetry)
+{
+    PVMFPortInterface* ports[] = {iInPort, iOutPort};
+    return GetNodeTelemetryForPorts(aTelemetry, ports, 2);
+}
+
 /////////////////////////////////////////////////////////////////////////////
 PVMFCommandId PVMFOMXEncNode::QueueCommandL(PVMFOMXEncNodeCommand& aCmd)
 {
@@ -663,6 +670,7 @@ PVMFOMXEncNode::PVMFOMXEncNode(int32 aPriority) :
         ipExternalInputBufferAllocatorInterface(NULL),
         ipFixedSizeBufferAlloc(NULL)
 {
+    SetTelemetryActiveObject(this);
     iInterfaceState = EPVMFNodeCreated;
 
 
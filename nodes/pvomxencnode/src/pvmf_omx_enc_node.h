@@ -892,6 +892,7 @@ class PVMFOMXEncNode
         PVMFStatus ThreadLogoff();
         PVMFStatus GetCapability(PVMFNodeCapability& aNodeCapability);
         PVMFPortIter* GetPorts(const PVMFPortFilter* aFilter = NULL);
+        PVMFStatus GetNodeTelemetry(PVMFNodeTelemetry& aTelemetry);
         PVMFCommandId QueryUUID(PVMFSessionId, const PvmfMimeString& aMimeType,
                                 Oscl_Vector<PVUuid, PVMFOMXEncNodeAllocator>& aUuids,
                                 bool aExactUuidsOnly = false,
@@ -347,59 +347,7 @@ PVMFStatus PVMFOMXVideoDecNode::HandlePortReEnable()
         }
 
         //Buffer allocation has to be done again in case we landed to port reconfiguration
-        PvmiKvp* kvp = NULL;
-        int numKvp = 0;
-        PvmiKeyType aIdentifier = (PvmiKeyType)PVMF_BUFFER_ALLOCATOR_KEY;
-        int32 err, err1;
-        ipExternalOutputBufferAllocatorInterface = NULL;
-
-        OSCL_TRY(err, ((PVMFOMXDecPort*)iOutPort)->pvmiGetBufferAllocatorSpecificInfoSync(aIdentifier, kvp, numKvp););
-
-        if ((err == OsclErrNone) && (NULL != kvp))
-        {
-            ipExternalOutputBufferAllocatorInterface = (PVInterface*) kvp->value.key_specific_value;
-
-            if (ipExternalOutputBufferAllocatorInterface)
-            {
-                PVInterface* pTempPVInterfacePtr = NULL;
-
-                OSCL_TRY(err, ipExternalOutputBufferAllocatorInterface->queryInterface(PVMFFixedSizeBufferAllocUUID, pTempPVInterfacePtr););
-
-                OSCL_TRY(err1, ((PVMFOMXDecPort*)iOutPort)->releaseParametersSync(kvp, numKvp););
-
-                if (err1 != OsclErrNone)
-                {
-                    PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_DEBUG,
-                                    (0, "PVMFOMXVideoDecNode::HandlePortReEnable - Unable to Release Parameters"));
-                }
-
-                if ((err == OsclErrNone) && (NULL != pTempPVInterfacePtr))
-                {
-                    ipFixedSizeBufferAlloc = OSCL_STATIC_CAST(PVMFFixedSizeBufferAlloc*, pTempPVInterfacePtr);
-
-                    uint32 iNumBuffers, iBufferSize;
-
-                    iNumBuffers = ipFixedSizeBufferAlloc->getNumBuffers();
-                    iBufferSize = ipFixedSizeBufferAlloc->getBufferSize();
-
-                    if ((iNumBuffers < iParamPort.nBufferCountMin) || (iBufferSize < iOMXComponentOutputBufferSize))
-                    {
-                        ipExternalOutputBufferAllocatorInterface->removeRef();
-                        ipExternalOutputBufferAllocatorInterface = NULL;
-                    }
-                    else
-                    {
-                        iNumOutputBuffers = iNumBuffers;
-                        iOMXComponentOutputBufferSize = iBufferSize;
-                    }
-                }
-                else
-                {
-                    ipExternalOutputBufferAllocatorInterface->removeRef();
-                    ipExternalOutputBufferAllocatorInterface = NULL;
-                }
-            }
-        }
+        NegotiateExternalOutputBufferAllocator(iParamPort.nBufferCountMin);
 
 
         /* Allocate output buffers */
@@ -996,61 +944,7 @@ bool PVMFOMXVideoDecNode::NegotiateComponentParameters(OMX_PTR aOutputParameters
 
     //Try querying the buffer allocator KVP for output buffer allocation outside the node
 
-    PvmiKvp* kvp = NULL;
-    int numKvp = 0;
-    PvmiKeyType aIdentifier = (PvmiKeyType)PVMF_BUFFER_ALLOCATOR_KEY;
-    int32 err, err1;
-    ipExternalOutputBufferAllocatorInterface = NULL;
-
-    OSCL_TRY(err, ((PVMFOMXDecPort*)iOutPort)->pvmiGetBufferAllocatorSpecificInfoSync(aIdentifier, kvp, numKvp););
-
-    if ((err == OsclErrNone) && (NULL != kvp))
-    {
-        ipExternalOutputBufferAllocatorInterface = (PVInterface*) kvp->value.key_specific_value;
-
-        if (ipExternalOutputBufferAllocatorInterface)
-        {
-            PVInterface* pTempPVInterfacePtr = NULL;
-
-            OSCL_TRY(err, ipExternalOutputBufferAllocatorInterface->queryInterface(PVMFFixedSizeBufferAllocUUID, pTempPVInterfacePtr););
-
-            OSCL_TRY(err1, ((PVMFOMXDecPort*)iOutPort)->releaseParametersSync(kvp, numKvp););
-
-            if (err1 != OsclErrNone)
-            {
-                PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_DEBUG,
-                                (0, "PVMFOMXVideoDecNode::NegotiateComponentParameters - Unable to Release Parameters"));
-            }
-
-
-            if ((err == OsclErrNone) && (NULL != pTempPVInterfacePtr))
-            {
-                ipFixedSizeBufferAlloc = OSCL_STATIC_CAST(PVMFFixedSizeBufferAlloc*, pTempPVInterfacePtr);
-
-                uint32 iNumBuffers, iBufferSize;
-
-                iNumBuffers = ipFixedSizeBufferAlloc->getNumBuffers();
-                iBufferSize = ipFixedSizeBufferAlloc->getBufferSize();
-
-                if ((iNumBuffers < iParamPort.nBufferCountMin) || (iBufferSize < iOMXComponentOutputBufferSize))
-                {
-                    ipExternalOutputBufferAllocatorInterface->removeRef();
-                    ipExternalOutputBufferAllocatorInterface = NULL;
-                }
-                else
-                {
-                    iNumOutputBuffers = iNumBuffers;
-                    iOMXComponentOutputBufferSize = iBufferSize;
-                }
-            }
-            else
-            {
-                ipExternalOutputBufferAllocatorInterface->removeRef();
-                ipExternalOutputBufferAllocatorInterface = NULL;
-
-            }
-        }
-    }
+    NegotiateExternalOutputBufferAllocator(iParamPort.nBufferCountMin);
 
 
     iParamPort.nBufferCountActual = iNumOutputBuffers;
@@ -383,6 +383,8 @@ bool HttpParsingBasicObject::construct()
     resetForBadConnectionDetection();
     iServerVersionNumber = 0;
     if ((iParser = HTTPParser::create()) == NULL) return false;
+    // send out chunked entity body as it arrives, rather than holding the input buffers until the whole chunk is received
+    iParser->setStreamingEntityBody();
     return true;
 }
 
@@ -59,6 +59,7 @@ PVMFWAVFFParserNode::PVMFWAVFFParserNode(int32 aPriority) :
         iWAVParser(NULL),
         iExtensionRefCount(0)
 {
+    SetTelemetryActiveObject(this);
     int32 err;
     OSCL_TRY(err,
 
@@ -189,6 +190,13 @@ PVMFPortIter* PVMFWAVFFParserNode::GetPorts(const PVMFPortFilter* aFilter)
     return NULL;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+PVMFStatus PVMFWAVFFParserNode::GetNodeTelemetry(PVMFNodeTelemetry& aTelemetry)
+{
+    PVMFPortInterface* ports[] = {iOutPort};
+    return GetNodeTelemetryForPorts(aTelemetry, ports, 1);
+}
+
 /**
  //Queue an asynchronous node command
  */
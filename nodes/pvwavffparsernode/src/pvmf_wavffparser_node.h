@@ -359,6 +359,7 @@ class PVMFWAVFFParserNode : public OsclTimerObject,
         PVMFStatus ThreadLogoff();
         PVMFStatus GetCapability(PVMFNodeCapability& aNodeCapability);
         PVMFPortIter* GetPorts(const PVMFPortFilter* aFilter = NULL);
+        PVMFStatus GetNodeTelemetry(PVMFNodeTelemetry& aTelemetry);
         PVMFCommandId QueryUUID(PVMFSessionId, const PvmfMimeString& aMimeType,
                                 Oscl_Vector<PVUuid, PVMFWAVFFNodeAllocator>& aUuids,
                                 bool aExactUuidsOnly = false,
@@ -122,6 +122,21 @@
 #define MIN_JITTER_BUFFER_DURATION_IN_MS     1000
 
 #define DEFAULT_JITTER_BUFFER_UNDERFLOW_THRESHOLD_IN_MS 500
+
+/* Adaptive jitter buffer duration related */
+#define PVMF_JITTER_BUFFER_ADAPTIVE_DEFAULT_MIN_DURATION_IN_MS  MIN_JITTER_BUFFER_DURATION_IN_MS
+#define PVMF_JITTER_BUFFER_ADAPTIVE_DEFAULT_MAX_DURATION_IN_MS  10000
+/* Target delay = min + (jitter * multiplier) + (loss% * loss penalty) + underflow penalty */
+#define PVMF_JITTER_BUFFER_ADAPTIVE_JITTER_MULTIPLIER           8
+#define PVMF_JITTER_BUFFER_ADAPTIVE_LOSS_PENALTY_PER_PERCENT_IN_MS 100
+#define PVMF_JITTER_BUFFER_ADAPTIVE_UNDERFLOW_PENALTY_IN_MS     1000
+/* Underflow penalty decays once this many loss windows pass without an underflow */
+#define PVMF_JITTER_BUFFER_ADAPTIVE_UNDERFLOW_STABLE_WINDOWS    8
+#define PVMF_JITTER_BUFFER_ADAPTIVE_UNDERFLOW_DECAY_STEP_IN_MS  250
+/* Number of received packets over which loss is measured */
+#define PVMF_JITTER_BUFFER_ADAPTIVE_LOSS_WINDOW_IN_PKTS         64
+/* Target grows immediately but shrinks by at most this much per loss window */
+#define PVMF_JITTER_BUFFER_ADAPTIVE_DECREASE_STEP_IN_MS         100
 #define DEFAULT_PLAY_BACK_THRESHOLD_IN_MS    250
 #define DEFAULT_ESTIMATED_SERVER_KEEPAHEAD_FOR_OOO_SYNC_IN_MS   500
 
@@ -68,6 +68,14 @@ class PVMFJitterBufferExtensionInterface : public PVInterface
         OSCL_IMPORT_REF virtual void setJitterBufferDurationInMilliSeconds(uint32 duration) = 0;
         OSCL_IMPORT_REF virtual void getJitterBufferDurationInMilliSeconds(uint32& duration) = 0;
 
+        //Adaptive mode: the buffering duration of each stream follows its observed interarrival jitter, loss and
+        //underflows, within [aMinDurationInMS, aMaxDurationInMS]. setJitterBufferDurationInMilliSeconds is used again once disabled.
+        OSCL_IMPORT_REF virtual void setAdaptiveJitterBufferDuration(bool aEnable,
+                uint32 aMinDurationInMS = PVMF_JITTER_BUFFER_ADAPTIVE_DEFAULT_MIN_DURATION_IN_MS,
+                uint32 aMaxDurationInMS = PVMF_JITTER_BUFFER_ADAPTIVE_DEFAULT_MAX_DURATION_IN_MS) = 0;
+        OSCL_IMPORT_REF virtual bool getJitterBufferNetworkEstimates(PVMFPortInterface* aPort,
+                PVMFJitterBufferNetworkEstimates& aEstimates) = 0;
+
         OSCL_IMPORT_REF virtual void setEarlyDecodingTimeInMilliSeconds(uint32 duration) = 0;
         OSCL_IMPORT_REF virtual void setBurstThreshold(float burstThreshold) = 0;
 
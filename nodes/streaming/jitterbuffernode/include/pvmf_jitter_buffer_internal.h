@@ -149,6 +149,11 @@ class PVMFJitterBufferExtensionInterfaceImpl :
         OSCL_IMPORT_REF void getJitterBufferRebufferingThresholdInMilliSeconds(uint32& aThreshold);
         OSCL_IMPORT_REF void setJitterBufferDurationInMilliSeconds(uint32 duration);
         OSCL_IMPORT_REF void getJitterBufferDurationInMilliSeconds(uint32& duration);
+        OSCL_IMPORT_REF void setAdaptiveJitterBufferDuration(bool aEnable,
+                uint32 aMinDurationInMS = PVMF_JITTER_BUFFER_ADAPTIVE_DEFAULT_MIN_DURATION_IN_MS,
+                uint32 aMaxDurationInMS = PVMF_JITTER_BUFFER_ADAPTIVE_DEFAULT_MAX_DURATION_IN_MS);
+        OSCL_IMPORT_REF bool getJitterBufferNetworkEstimates(PVMFPortInterface* aPort,
+                PVMFJitterBufferNetworkEstimates& aEstimates);
 
         OSCL_IMPORT_REF void setEarlyDecodingTimeInMilliSeconds(uint32 duration);
         OSCL_IMPORT_REF void setBurstThreshold(float burstThreshold);
@@ -202,6 +202,8 @@ class PVMFJitterBufferNode : public PVInterface,
         virtual void GetJitterBufferRebufferingThresholdInMilliSeconds(uint32& aThreshold);
         virtual void SetJitterBufferDurationInMilliSeconds(uint32 duration);
         virtual void GetJitterBufferDurationInMilliSeconds(uint32& duration);
+        virtual void SetAdaptiveJitterBufferDuration(bool aEnable, uint32 aMinDurationInMS, uint32 aMaxDurationInMS);
+        virtual bool GetJitterBufferNetworkEstimates(PVMFPortInterface* aPort, PVMFJitterBufferNetworkEstimates& aEstimates);
         virtual void SetEarlyDecodingTimeInMilliSeconds(uint32 duration);
         virtual void SetBurstThreshold(float burstThreshold);
         //While in buffering/start state, Jitter Buffer node expects its upstream peer node to send media msg at its input port in duration < inactivity duration
@@ -494,6 +496,9 @@ class PVMFJitterBufferNode : public PVInterface,
         //Variables to persist info passed on by the extension interface
         uint32 iRebufferingThreshold;
         uint32 iJitterBufferDurationInMilliSeconds;
+        bool   iAdaptiveJitterBufferDuration;
+        uint32 iAdaptiveMinDurationInMilliSeconds;
+        uint32 iAdaptiveMaxDurationInMilliSeconds;
         uint32 iMaxInactivityDurationForMediaInMs;
         uint32 iEstimatedServerKeepAheadInMilliSeconds;
         /* resizable reallocator configuration */
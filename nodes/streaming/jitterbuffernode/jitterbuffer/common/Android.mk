@@ -6,6 +6,7 @@ LOCAL_SRC_FILES := \
         src/pvmf_jb_firewall_pkts_impl.cpp \
         src/pvmf_jb_jitterbuffermisc.cpp \
         src/pvmf_jb_session_duration_timer.cpp \
+        src/pvmf_jitter_buffer_adaptive_duration.cpp \
         src/pvmf_jitter_buffer_impl.cpp \
         src/pvmf_rtcp_proto_impl.cpp \
         src/pvmf_rtcp_timer.cpp
@@ -37,6 +38,7 @@ LOCAL_COPY_HEADERS := \
         include/pvmf_jb_event_notifier.h \
         include/pvmf_jb_jitterbuffermisc.h \
         include/pvmf_jitter_buffer.h \
+        include/pvmf_jitter_buffer_adaptive_duration.h \
         include/pvmf_jitter_buffer_common_types.h \
         include/pvmf_jitter_buffer_factory.h
 
@@ -20,6 +20,7 @@ SRCS = pvmf_jb_event_notifier.cpp \
 	 pvmf_jb_firewall_pkts_impl.cpp \
 	 pvmf_jb_jitterbuffermisc.cpp \
 	 pvmf_jb_session_duration_timer.cpp \
+	 pvmf_jitter_buffer_adaptive_duration.cpp \
 	 pvmf_jitter_buffer_impl.cpp \
 	 pvmf_rtcp_proto_impl.cpp \
 	 pvmf_rtcp_timer.cpp
@@ -27,6 +28,7 @@ SRCS = pvmf_jb_event_notifier.cpp \
 HDRS = pvmf_jb_event_notifier.h \
 	pvmf_jb_jitterbuffermisc.h \
 	pvmf_jitter_buffer.h \
+	pvmf_jitter_buffer_adaptive_duration.h \
 	pvmf_jitter_buffer_common_types.h \
 	pvmf_jitter_buffer_factory.h 
 
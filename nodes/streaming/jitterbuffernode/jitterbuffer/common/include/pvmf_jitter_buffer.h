@@ -59,6 +59,9 @@
 #ifndef PVMF_JITTER_BUFFER_COMMON_TYPES_H_INCLUDED
 #include "pvmf_jitter_buffer_common_types.h"
 #endif
+#ifndef PVMF_JITTER_BUFFER_ADAPTIVE_DURATION_H_INCLUDED
+#include "pvmf_jitter_buffer_adaptive_duration.h"
+#endif
 
 #ifndef PVMF_MEDIA_CLOCK_H_INCLUDED
 #include "pvmf_media_clock.h"
@@ -1096,6 +1099,20 @@ class PVMFJitterBuffer
         virtual uint32 GetTimeScale() const = 0;
         virtual void SetEarlyDecodingTimeInMilliSeconds(uint32 duration) = 0;
         virtual void SetBurstThreshold(float burstThreshold) = 0;
+
+        /**
+            Enables/disables adaptive sizing of the buffering duration.
+            When enabled the duration set with SetDurationInMilliSeconds is
+            replaced by a target derived from the observed interarrival jitter,
+            packet loss and underflows, bounded by [aMinDurationInMS, aMaxDurationInMS].
+            When disabled the last configured duration is restored.
+        */
+        virtual void SetAdaptiveDurationMode(bool aEnable, uint32 aMinDurationInMS, uint32 aMaxDurationInMS) = 0;
+
+        /**
+            Returns the current network estimates for the stream.
+        */
+        virtual void GetNetworkEstimates(PVMFJitterBufferNetworkEstimates& aEstimates) = 0;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1179,6 +1196,8 @@ class PVMFJitterBufferImpl : public PVMFJitterBuffer
         OSCL_IMPORT_REF void CancelEventCallBack(JB_NOTIFY_CALLBACK aEventType, OsclAny* aContext = NULL);
         OSCL_IMPORT_REF bool IsCallbackPending(JB_NOTIFY_CALLBACK aEventType, OsclAny* aContext);
         OSCL_IMPORT_REF void ProcessCallback(CLOCK_NOTIFICATION_INTF_TYPE aClockNotificationInterfaceType, uint32 aCallBkId, const OsclAny* aContext, PVMFStatus aStatus);
+        OSCL_IMPORT_REF virtual void SetAdaptiveDurationMode(bool aEnable, uint32 aMinDurationInMS, uint32 aMaxDurationInMS);
+        OSCL_IMPORT_REF virtual void GetNetworkEstimates(PVMFJitterBufferNetworkEstimates& aEstimates);
 
         OSCL_IMPORT_REF PVMFJitterBufferImpl(const PVMFJitterBufferConstructParams& aJBCreationData);
 
@@ -1214,6 +1233,8 @@ class PVMFJitterBufferImpl : public PVMFJitterBuffer
         virtual bool CanRetrievePacket() = 0;
         virtual void DeterminePrevTimeStamp(uint32 aSeqNum) = 0;
         OSCL_IMPORT_REF virtual PVMFStatus PerformFlowControl(bool aIncomingMedia);
+        OSCL_IMPORT_REF void UpdateAdaptiveDuration(uint32 aInterArrivalJitterInMS);
+        OSCL_IMPORT_REF void AdaptiveDurationUnderflow();
         uint32 iSeqNum;
         class JitterBufferMemPoolInfo
         {
@@ -1264,6 +1285,11 @@ class PVMFJitterBufferImpl : public PVMFJitterBuffer
         uint32  iDurationInMilliSeconds;
         uint32  iRebufferingThresholdInMilliSeconds;
 
+        //Adaptive duration related
+        bool    iAdaptiveDuration;
+        uint32  iConfiguredDurationInMilliSeconds;
+        PVMFJitterBufferAdaptiveDuration iAdaptiveDurationEstimator;
+
         uint64 iMonotonicTimeStamp;
         uint32 iFirstSeqNum;
         typedef PVMFDynamicCircularArray<OsclMemAllocator> PVMFDynamicCircularArrayType;
@@ -0,0 +1,113 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#ifndef PVMF_JITTER_BUFFER_ADAPTIVE_DURATION_H_INCLUDED
+#define PVMF_JITTER_BUFFER_ADAPTIVE_DURATION_H_INCLUDED
+
+#ifndef OSCL_BASE_H_INCLUDED
+#include "oscl_base.h"
+#endif
+#ifndef PVMF_JITTER_BUFFER_COMMON_TYPES_H_INCLUDED
+#include "pvmf_jitter_buffer_common_types.h"
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+//PVMFJitterBufferAdaptiveDuration
+//Network estimates of one stream and the buffering duration derived from
+//them when adaptive sizing is enabled:
+//
+//  target = min + (jitter * multiplier) + (loss% * loss penalty) + underflow penalty
+//
+//Each underflow adds PVMF_JITTER_BUFFER_ADAPTIVE_UNDERFLOW_PENALTY_IN_MS to the
+//underflow penalty.  Once no underflow has been seen for
+//PVMF_JITTER_BUFFER_ADAPTIVE_UNDERFLOW_STABLE_WINDOWS loss windows the penalty
+//decays by PVMF_JITTER_BUFFER_ADAPTIVE_UNDERFLOW_DECAY_STEP_IN_MS per window,
+//so a burst of rebuffering early in a session does not pin the buffer at
+//its maximum for the rest of it.
+//
+//The jitter and loss are the receiver side values that also go into the RTCP
+//receiver reports (RFC 3550 A.8 interarrival jitter, and the fraction lost
+//over a window of packets).  The server's RTCP sender reports carry no
+//information about the path to this client, so they are not used here.
+///////////////////////////////////////////////////////////////////////////////
+class PVMFJitterBufferAdaptiveDuration
+{
+    public:
+        OSCL_IMPORT_REF PVMFJitterBufferAdaptiveDuration();
+
+        /**
+            Clears all estimates and restores the default duration range.
+        */
+        OSCL_IMPORT_REF void Reset();
+
+        /**
+            Sets the bounds of the target duration.
+        */
+        OSCL_IMPORT_REF void SetDurationRange(uint32 aMinDurationInMS, uint32 aMaxDurationInMS);
+
+        uint32 GetMinDuration() const
+        {
+            return iMinDurationInMS;
+        }
+        uint32 GetMaxDuration() const
+        {
+            return iMaxDurationInMS;
+        }
+
+        /**
+            Starts a new loss window at the current receive statistics.
+        */
+        OSCL_IMPORT_REF void StartLossWindow(uint32 aMaxSeqNum, uint32 aNumPktsRecvd);
+
+        /**
+            Records the arrival of a packet with the current smoothed
+            interarrival jitter.  Returns true at the end of a loss window,
+            when the loss estimate and the underflow penalty have been
+            updated and the target should be recomputed.
+        */
+        OSCL_IMPORT_REF bool PacketArrived(uint32 aInterArrivalJitterInMS, uint32 aMaxSeqNum, uint32 aNumPktsRecvd);
+
+        /**
+            Records a rebuffering event.
+        */
+        OSCL_IMPORT_REF void Underflow();
+
+        /**
+            Returns the duration to use given the current one.  The result
+            grows to the target at once but shrinks by at most
+            PVMF_JITTER_BUFFER_ADAPTIVE_DECREASE_STEP_IN_MS per call, and
+            stays above aRebufferingThresholdInMS.
+        */
+        OSCL_IMPORT_REF uint32 GetTargetDuration(uint32 aCurrentDurationInMS, uint32 aRebufferingThresholdInMS) const;
+
+        PVMFJitterBufferNetworkEstimates& GetEstimates()
+        {
+            return iEstimates;
+        }
+
+    private:
+        uint32 iMinDurationInMS;
+        uint32 iMaxDurationInMS;
+        uint32 iWindowPktCount;
+        uint32 iWindowStartSeqNum;
+        uint32 iWindowStartNumPktsRecvd;
+        uint32 iWindowsSinceUnderflow;
+        int32  iPacketLossPercentQ8;
+        PVMFJitterBufferNetworkEstimates iEstimates;
+};
+
+#endif // PVMF_JITTER_BUFFER_ADAPTIVE_DURATION_H_INCLUDED
@@ -62,6 +62,39 @@ typedef struct tagPVMFRTPInfoParams
     bool   isPlayAfterPause;
 } PVMFRTPInfoParams;
 
+///////////////////////////////////////////////////////////////////////////////
+//PVMFJitterBufferNetworkEstimates
+//Per stream network conditions as observed by the jitter buffer, and the
+//buffering duration derived from them when adaptive sizing is enabled.
+///////////////////////////////////////////////////////////////////////////////
+class PVMFJitterBufferNetworkEstimates
+{
+    public:
+        PVMFJitterBufferNetworkEstimates()
+        {
+            Reset();
+        }
+
+        void Reset()
+        {
+            iAdaptive = false;
+            iInterArrivalJitterInMS = 0;
+            iPacketLossPercent = 0;
+            iCumulativePacketsLost = 0;
+            iNumUnderflows = 0;
+            iUnderflowPenaltyInMS = 0;
+            iTargetDurationInMS = 0;
+        }
+
+        bool   iAdaptive;               //true if iTargetDurationInMS is being adapted
+        uint32 iInterArrivalJitterInMS; //smoothed interarrival jitter (RFC 3550 A.8) in ms
+        uint32 iPacketLossPercent;      //smoothed loss over recent loss windows
+        uint32 iCumulativePacketsLost;
+        uint32 iNumUnderflows;          //rebuffering events since session start
+        uint32 iUnderflowPenaltyInMS;   //part of the target due to recent underflows
+        uint32 iTargetDurationInMS;     //current buffering duration
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 //RTSP based streaming specific data structures
 ///////////////////////////////////////////////////////////////////////////////
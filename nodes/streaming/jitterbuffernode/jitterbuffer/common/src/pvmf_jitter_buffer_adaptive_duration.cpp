@@ -0,0 +1,137 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#ifndef PVMF_JITTER_BUFFER_ADAPTIVE_DURATION_H_INCLUDED
+#include "pvmf_jitter_buffer_adaptive_duration.h"
+#endif
+
+OSCL_EXPORT_REF PVMFJitterBufferAdaptiveDuration::PVMFJitterBufferAdaptiveDuration()
+{
+    Reset();
+}
+
+OSCL_EXPORT_REF void PVMFJitterBufferAdaptiveDuration::Reset()
+{
+    iMinDurationInMS = PVMF_JITTER_BUFFER_ADAPTIVE_DEFAULT_MIN_DURATION_IN_MS;
+    iMaxDurationInMS = PVMF_JITTER_BUFFER_ADAPTIVE_DEFAULT_MAX_DURATION_IN_MS;
+    iWindowPktCount = 0;
+    iWindowStartSeqNum = 0;
+    iWindowStartNumPktsRecvd = 0;
+    iWindowsSinceUnderflow = 0;
+    iPacketLossPercentQ8 = 0;
+    iEstimates.Reset();
+}
+
+OSCL_EXPORT_REF void PVMFJitterBufferAdaptiveDuration::SetDurationRange(uint32 aMinDurationInMS, uint32 aMaxDurationInMS)
+{
+    if (aMaxDurationInMS < aMinDurationInMS)
+    {
+        aMaxDurationInMS = aMinDurationInMS;
+    }
+    iMinDurationInMS = aMinDurationInMS;
+    iMaxDurationInMS = aMaxDurationInMS;
+}
+
+OSCL_EXPORT_REF void PVMFJitterBufferAdaptiveDuration::StartLossWindow(uint32 aMaxSeqNum, uint32 aNumPktsRecvd)
+{
+    iWindowPktCount = 0;
+    iWindowStartSeqNum = aMaxSeqNum;
+    iWindowStartNumPktsRecvd = aNumPktsRecvd;
+}
+
+OSCL_EXPORT_REF bool PVMFJitterBufferAdaptiveDuration::PacketArrived(uint32 aInterArrivalJitterInMS, uint32 aMaxSeqNum, uint32 aNumPktsRecvd)
+{
+    iEstimates.iInterArrivalJitterInMS = aInterArrivalJitterInMS;
+
+    if (++iWindowPktCount < PVMF_JITTER_BUFFER_ADAPTIVE_LOSS_WINDOW_IN_PKTS)
+    {
+        return false;
+    }
+
+    /*
+     * Loss over the window, same as the fraction lost of a RTCP RR:
+     * expected = extended highest seq num delta, received = packets seen.
+     * Seq nums in the JB stats are 16 bit (reset on rollover).
+     */
+    uint32 expected = (uint16)(aMaxSeqNum - iWindowStartSeqNum);
+    uint32 received = aNumPktsRecvd - iWindowStartNumPktsRecvd;
+    uint32 lossPercent = 0;
+    if (expected > received)
+    {
+        uint32 lost = expected - received;
+        iEstimates.iCumulativePacketsLost += lost;
+        lossPercent = (lost * 100) / expected;
+    }
+    /* L(i) = L(i-1) + (loss(i) - L(i-1))/4, in Q8 */
+    iPacketLossPercentQ8 += (((int32)(lossPercent << 8)) - iPacketLossPercentQ8) / 4;
+    iEstimates.iPacketLossPercent = (uint32)((iPacketLossPercentQ8 + 128) >> 8);
+
+    /* Give back the underflow penalty once playback has been stable for a while */
+    if (iEstimates.iUnderflowPenaltyInMS > 0 &&
+            ++iWindowsSinceUnderflow >= PVMF_JITTER_BUFFER_ADAPTIVE_UNDERFLOW_STABLE_WINDOWS)
+    {
+        if (iEstimates.iUnderflowPenaltyInMS > PVMF_JITTER_BUFFER_ADAPTIVE_UNDERFLOW_DECAY_STEP_IN_MS)
+        {
+            iEstimates.iUnderflowPenaltyInMS -= PVMF_JITTER_BUFFER_ADAPTIVE_UNDERFLOW_DECAY_STEP_IN_MS;
+        }
+        else
+        {
+            iEstimates.iUnderflowPenaltyInMS = 0;
+        }
+    }
+
+    StartLossWindow(aMaxSeqNum, aNumPktsRecvd);
+    return true;
+}
+
+OSCL_EXPORT_REF void PVMFJitterBufferAdaptiveDuration::Underflow()
+{
+    iEstimates.iNumUnderflows++;
+    iWindowsSinceUnderflow = 0;
+
+    /* Penalty is never worth more than the whole adaptive range */
+    uint32 maxPenalty = iMaxDurationInMS - iMinDurationInMS;
+    iEstimates.iUnderflowPenaltyInMS += PVMF_JITTER_BUFFER_ADAPTIVE_UNDERFLOW_PENALTY_IN_MS;
+    if (iEstimates.iUnderflowPenaltyInMS > maxPenalty)
+    {
+        iEstimates.iUnderflowPenaltyInMS = maxPenalty;
+    }
+}
+
+OSCL_EXPORT_REF uint32 PVMFJitterBufferAdaptiveDuration::GetTargetDuration(uint32 aCurrentDurationInMS, uint32 aRebufferingThresholdInMS) const
+{
+    uint32 target = iMinDurationInMS;
+    target += (iEstimates.iInterArrivalJitterInMS * PVMF_JITTER_BUFFER_ADAPTIVE_JITTER_MULTIPLIER);
+    target += (iEstimates.iPacketLossPercent * PVMF_JITTER_BUFFER_ADAPTIVE_LOSS_PENALTY_PER_PERCENT_IN_MS);
+    target += iEstimates.iUnderflowPenaltyInMS;
+    if (target > iMaxDurationInMS)
+    {
+        target = iMaxDurationInMS;
+    }
+
+    /* Grow at once, shrink gradually to avoid oscillating around the threshold */
+    if ((target < aCurrentDurationInMS) &&
+            ((aCurrentDurationInMS - target) > PVMF_JITTER_BUFFER_ADAPTIVE_DECREASE_STEP_IN_MS))
+    {
+        target = aCurrentDurationInMS - PVMF_JITTER_BUFFER_ADAPTIVE_DECREASE_STEP_IN_MS;
+    }
+    if (target <= aRebufferingThresholdInMS)
+    {
+        target = aRebufferingThresholdInMS + PVMF_JITTER_BUFFER_ADAPTIVE_DECREASE_STEP_IN_MS;
+    }
+    return target;
+}
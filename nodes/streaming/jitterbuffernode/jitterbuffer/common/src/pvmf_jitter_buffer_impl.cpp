@@ -62,6 +62,10 @@ void PVMFJitterBufferImpl::ResetParams(bool aReleaseMemory)
     iDurationInMilliSeconds = 0;
     iRebufferingThresholdInMilliSeconds = 0;
 
+    iAdaptiveDuration = false;
+    iConfiguredDurationInMilliSeconds = 0;
+    iAdaptiveDurationEstimator.Reset();
+
     iMonotonicTimeStamp = 0;
     iFirstSeqNum = 0;
     iJitterBuffer = NULL;
@@ -160,7 +164,11 @@ OSCL_EXPORT_REF void PVMFJitterBufferImpl::SetRebufferingThresholdInMilliSeconds
 
 OSCL_EXPORT_REF void PVMFJitterBufferImpl::SetDurationInMilliSeconds(uint32 aDuration)
 {
-    iDurationInMilliSeconds = aDuration;
+    iConfiguredDurationInMilliSeconds = aDuration;
+    if (!iAdaptiveDuration)
+    {
+        iDurationInMilliSeconds = aDuration;
+    }
 }
 
 OSCL_EXPORT_REF void PVMFJitterBufferImpl::PrepareForRepositioning()
@@ -487,6 +495,10 @@ OSCL_EXPORT_REF void PVMFJitterBufferImpl::ResetJitterBuffer()
     iMonotonicTimeStamp = 0;
     iPrevTSOut = 0;
     iMaxAdjustedRTPTS = 0;
+
+    //Keep the adapted target across the reset, the network has not changed
+    iAdaptiveDurationEstimator.StartLossWindow(0, 0);
+    iAdaptiveDurationEstimator.GetEstimates().iCumulativePacketsLost = 0;
 }
 
 OSCL_EXPORT_REF PVMFTimestamp PVMFJitterBufferImpl::peekNextElementTimeStamp()
@@ -1618,6 +1630,85 @@ OSCL_EXPORT_REF PVMFStatus PVMFJitterBufferImpl::PerformFlowControl(bool aIncomi
     return PVMFSuccess;
 }
 
+OSCL_EXPORT_REF void PVMFJitterBufferImpl::SetAdaptiveDurationMode(bool aEnable, uint32 aMinDurationInMS, uint32 aMaxDurationInMS)
+{
+    PVMF_JB_LOGINFO((0, "PVMFJitterBufferImpl::SetAdaptiveDurationMode - MimeType=%s, Enable=%d, Min=%d, Max=%d", irMimeType.get_cstr(), aEnable, aMinDurationInMS, aMaxDurationInMS));
+    iAdaptiveDurationEstimator.SetDurationRange(aMinDurationInMS, aMaxDurationInMS);
+
+    if (aEnable && !iAdaptiveDuration)
+    {
+        /*
+         * Start optimistic - the buffering target only grows once the
+         * network shows jitter, loss or underflows.
+         */
+        iDurationInMilliSeconds = iAdaptiveDurationEstimator.GetMinDuration();
+        if (iDurationInMilliSeconds <= iRebufferingThresholdInMilliSeconds)
+        {
+            iDurationInMilliSeconds = iRebufferingThresholdInMilliSeconds + PVMF_JITTER_BUFFER_ADAPTIVE_DECREASE_STEP_IN_MS;
+        }
+        if (iJitterBuffer)
+        {
+            iAdaptiveDurationEstimator.StartLossWindow(iJitterBuffer->getStats().maxSeqNumRegistered,
+                    iJitterBuffer->getStats().totalNumPacketsReceived);
+        }
+        else
+        {
+            iAdaptiveDurationEstimator.StartLossWindow(0, 0);
+        }
+    }
+    else if (!aEnable && iAdaptiveDuration)
+    {
+        iDurationInMilliSeconds = iConfiguredDurationInMilliSeconds;
+    }
+    iAdaptiveDuration = aEnable;
+}
+
+OSCL_EXPORT_REF void PVMFJitterBufferImpl::GetNetworkEstimates(PVMFJitterBufferNetworkEstimates& aEstimates)
+{
+    aEstimates = iAdaptiveDurationEstimator.GetEstimates();
+    aEstimates.iAdaptive = iAdaptiveDuration;
+    aEstimates.iTargetDurationInMS = iDurationInMilliSeconds;
+}
+
+OSCL_EXPORT_REF void PVMFJitterBufferImpl::UpdateAdaptiveDuration(uint32 aInterArrivalJitterInMS)
+{
+    PVMFJitterBufferStats& jbStats = iJitterBuffer->getStats();
+    if (!iAdaptiveDurationEstimator.PacketArrived(aInterArrivalJitterInMS, jbStats.maxSeqNumRegistered, jbStats.totalNumPacketsReceived))
+    {
+        return;
+    }
+    if (!iAdaptiveDuration)
+    {
+        return;
+    }
+
+    uint32 target = iAdaptiveDurationEstimator.GetTargetDuration(iDurationInMilliSeconds, iRebufferingThresholdInMilliSeconds);
+    if (target != iDurationInMilliSeconds)
+    {
+        PVMFJitterBufferNetworkEstimates& estimates = iAdaptiveDurationEstimator.GetEstimates();
+        PVMF_JB_LOGCLOCK((0, "PVMFJitterBufferImpl::UpdateAdaptiveDuration - MimeType=%s, Jitter=%d, Loss=%d, UnderflowPenalty=%d, Duration %d -> %d",
+                          irMimeType.get_cstr(), estimates.iInterArrivalJitterInMS, estimates.iPacketLossPercent,
+                          estimates.iUnderflowPenaltyInMS, iDurationInMilliSeconds, target));
+        iDurationInMilliSeconds = target;
+    }
+}
+
+OSCL_EXPORT_REF void PVMFJitterBufferImpl::AdaptiveDurationUnderflow()
+{
+    iAdaptiveDurationEstimator.Underflow();
+    if (!iAdaptiveDuration)
+    {
+        return;
+    }
+    /* Rebuffering is the costliest outcome, take the new penalty into account right away */
+    uint32 target = iAdaptiveDurationEstimator.GetTargetDuration(iDurationInMilliSeconds, iRebufferingThresholdInMilliSeconds);
+    if (target > iDurationInMilliSeconds)
+    {
+        PVMF_JB_LOGCLOCK_REBUFF((0, "PVMFJitterBufferImpl::AdaptiveDurationUnderflow - MimeType=%s, Underflows=%d, Duration %d -> %d",
+                                 irMimeType.get_cstr(), iAdaptiveDurationEstimator.GetEstimates().iNumUnderflows, iDurationInMilliSeconds, target));
+        iDurationInMilliSeconds = target;
+    }
+}
 
 OSCL_EXPORT_REF void PVMFJitterBufferImpl::LogClientAndEstimatedServerClock(PVLogger*& aLogger)
 {
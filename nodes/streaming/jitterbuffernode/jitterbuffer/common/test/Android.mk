@@ -0,0 +1,32 @@
+LOCAL_PATH := $(call my-dir)
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES := \
+ 	src/test_pvmf_jitter_buffer_adaptive_duration.cpp
+
+
+LOCAL_MODULE := test_pvmf_jitter_buffer_adaptive_duration
+
+LOCAL_CFLAGS :=  $(PV_CFLAGS)
+
+
+
+LOCAL_STATIC_LIBRARIES :=    
+
+LOCAL_SHARED_LIBRARIES := libopencore_rtsp libopencore_player libopencore_net_support libopencore_common
+
+LOCAL_C_INCLUDES := \
+	$(PV_TOP)/nodes/streaming/jitterbuffernode/jitterbuffer/common/test/src \
+ 	$(PV_TOP)/nodes/streaming/jitterbuffernode/jitterbuffer/common/test/src \
+ 	$(PV_TOP)/nodes/streaming/jitterbuffernode/jitterbuffer/common/include \
+ 	$(PV_TOP)/nodes/streaming/common/include \
+ 	$(PV_INCLUDES)
+
+LOCAL_COPY_HEADERS_TO := $(PV_COPY_HEADERS_TO)
+
+LOCAL_COPY_HEADERS := \
+ 	
+
+-include $(PV_TOP)/Android_system_extras.mk
+
+include $(BUILD_EXECUTABLE)
@@ -0,0 +1,25 @@
+# Get the current local path as the first operation
+LOCAL_PATH := $(call get_makefile_dir)
+
+# Clear out the variables used in the local makefiles
+include $(MK)/clear.mk
+
+TARGET := test_pvmf_jitter_buffer_adaptive_duration
+
+
+XCXXFLAGS += $(FLAG_COMPILE_WARNINGS_AS_ERRORS)
+
+XINCDIRS += \
+  ../../../include \
+  ../../../../../../common/include
+
+SRCDIR := ../../src
+INCSRCDIR := ../../src
+
+SRCS := test_pvmf_jitter_buffer_adaptive_duration.cpp
+
+LIBS := opencore_rtsp opencore_player opencore_net_support opencore_common
+
+SYSLIBS += $(SYS_THREAD_LIB)
+
+include $(MK)/prog.mk
@@ -0,0 +1,182 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+// Checks the adaptive jitter buffer duration estimator: loss windows,
+// the underflow penalty being applied once per underflow, and the penalty
+// decaying after a stable period.
+
+#include "stdio.h"
+#include "oscl_base.h"
+#include "pvmf_jitter_buffer_adaptive_duration.h"
+
+#define TEST_MIN_MS         1000
+#define TEST_MAX_MS         6000
+#define TEST_REBUFF_MS      500
+#define TEST_WINDOW         PVMF_JITTER_BUFFER_ADAPTIVE_LOSS_WINDOW_IN_PKTS
+
+// Feeds one loss window of packets with no jitter.  aLost packets of the
+// window are missing from the sequence.
+static bool RunWindow(PVMFJitterBufferAdaptiveDuration& aEstimator, uint32& aSeqNum, uint32& aNumRecvd, uint32 aLost)
+{
+    bool windowDone = false;
+    for (uint32 i = 0; i < TEST_WINDOW; i++)
+    {
+        aSeqNum++;
+        if (i == 0)
+        {
+            aSeqNum += aLost;
+        }
+        aNumRecvd++;
+        windowDone = aEstimator.PacketArrived(0, aSeqNum, aNumRecvd);
+    }
+    return windowDone;
+}
+
+static bool Check(bool aCondition, const char* aWhat, uint32 aValue)
+{
+    if (!aCondition)
+    {
+        printf("  %s: got %d\n", aWhat, aValue);
+    }
+    return aCondition;
+}
+
+// Targets follow the jitter and loss estimates and stay within range.
+static bool TestTargetFromEstimates()
+{
+    PVMFJitterBufferAdaptiveDuration estimator;
+    estimator.SetDurationRange(TEST_MIN_MS, TEST_MAX_MS);
+    estimator.StartLossWindow(0, 0);
+    bool ok = true;
+
+    uint32 seqNum = 0, numRecvd = 0;
+    ok = Check(RunWindow(estimator, seqNum, numRecvd, 0), "window end", 0) && ok;
+    uint32 target = estimator.GetTargetDuration(TEST_MIN_MS, TEST_REBUFF_MS);
+    ok = Check(target == TEST_MIN_MS, "clean network target", target) && ok;
+
+    // 16 of 80 lost is 20%, smoothed over 4 windows to 5%
+    ok = Check(RunWindow(estimator, seqNum, numRecvd, 16), "window end", 0) && ok;
+    uint32 loss = estimator.GetEstimates().iPacketLossPercent;
+    ok = Check(loss == 5, "smoothed loss", loss) && ok;
+    target = estimator.GetTargetDuration(TEST_MIN_MS, TEST_REBUFF_MS);
+    ok = Check(target == TEST_MIN_MS + 5 * PVMF_JITTER_BUFFER_ADAPTIVE_LOSS_PENALTY_PER_PERCENT_IN_MS,
+               "lossy network target", target) && ok;
+
+    estimator.PacketArrived(1000, seqNum, numRecvd);
+    target = estimator.GetTargetDuration(TEST_MIN_MS, TEST_REBUFF_MS);
+    ok = Check(target == TEST_MAX_MS, "target capped at max", target) && ok;
+
+    // large drops are spread over several windows
+    estimator.PacketArrived(0, seqNum, numRecvd);
+    target = estimator.GetTargetDuration(TEST_MAX_MS, TEST_REBUFF_MS);
+    ok = Check(target == TEST_MAX_MS - PVMF_JITTER_BUFFER_ADAPTIVE_DECREASE_STEP_IN_MS,
+               "gradual shrink", target) && ok;
+    return ok;
+}
+
+// One underflow raises the target by one penalty, not two.
+static bool TestUnderflowPenaltyOnce()
+{
+    PVMFJitterBufferAdaptiveDuration estimator;
+    estimator.SetDurationRange(TEST_MIN_MS, TEST_MAX_MS);
+    estimator.StartLossWindow(0, 0);
+    bool ok = true;
+
+    estimator.Underflow();
+    uint32 target = estimator.GetTargetDuration(TEST_MIN_MS, TEST_REBUFF_MS);
+    ok = Check(target == TEST_MIN_MS + PVMF_JITTER_BUFFER_ADAPTIVE_UNDERFLOW_PENALTY_IN_MS,
+               "target after underflow", target) && ok;
+
+    // the end of the next window must not add the penalty again
+    uint32 seqNum = 0, numRecvd = 0;
+    RunWindow(estimator, seqNum, numRecvd, 0);
+    uint32 next = estimator.GetTargetDuration(target, TEST_REBUFF_MS);
+    ok = Check(next == target, "target one window later", next) && ok;
+
+    for (uint32 i = 0; i < 10; i++)
+    {
+        estimator.Underflow();
+    }
+    uint32 penalty = estimator.GetEstimates().iUnderflowPenaltyInMS;
+    ok = Check(penalty == TEST_MAX_MS - TEST_MIN_MS, "penalty capped", penalty) && ok;
+    uint32 count = estimator.GetEstimates().iNumUnderflows;
+    ok = Check(count == 11, "underflow count", count) && ok;
+    return ok;
+}
+
+// The penalty is given back after a stable period, and an underflow on
+// the way restarts the stable period.
+static bool TestUnderflowPenaltyDecay()
+{
+    PVMFJitterBufferAdaptiveDuration estimator;
+    estimator.SetDurationRange(TEST_MIN_MS, TEST_MAX_MS);
+    estimator.StartLossWindow(0, 0);
+    bool ok = true;
+
+    uint32 seqNum = 0, numRecvd = 0;
+    estimator.Underflow();
+    for (uint32 i = 1; i < PVMF_JITTER_BUFFER_ADAPTIVE_UNDERFLOW_STABLE_WINDOWS; i++)
+    {
+        RunWindow(estimator, seqNum, numRecvd, 0);
+    }
+    uint32 penalty = estimator.GetEstimates().iUnderflowPenaltyInMS;
+    ok = Check(penalty == PVMF_JITTER_BUFFER_ADAPTIVE_UNDERFLOW_PENALTY_IN_MS, "penalty before stable period", penalty) && ok;
+
+    RunWindow(estimator, seqNum, numRecvd, 0);
+    penalty = estimator.GetEstimates().iUnderflowPenaltyInMS;
+    ok = Check(penalty == PVMF_JITTER_BUFFER_ADAPTIVE_UNDERFLOW_PENALTY_IN_MS - PVMF_JITTER_BUFFER_ADAPTIVE_UNDERFLOW_DECAY_STEP_IN_MS,
+               "penalty after stable period", penalty) && ok;
+
+    estimator.Underflow();
+    RunWindow(estimator, seqNum, numRecvd, 0);
+    penalty = estimator.GetEstimates().iUnderflowPenaltyInMS;
+    ok = Check(penalty == 2 * PVMF_JITTER_BUFFER_ADAPTIVE_UNDERFLOW_PENALTY_IN_MS - PVMF_JITTER_BUFFER_ADAPTIVE_UNDERFLOW_DECAY_STEP_IN_MS,
+               "penalty right after another underflow", penalty) && ok;
+
+    uint32 duration = estimator.GetTargetDuration(TEST_MIN_MS, TEST_REBUFF_MS);
+    for (uint32 j = 0; j < 64; j++)
+    {
+        RunWindow(estimator, seqNum, numRecvd, 0);
+        duration = estimator.GetTargetDuration(duration, TEST_REBUFF_MS);
+    }
+    penalty = estimator.GetEstimates().iUnderflowPenaltyInMS;
+    ok = Check(penalty == 0, "penalty fully decayed", penalty) && ok;
+    ok = Check(duration == TEST_MIN_MS, "duration back at min", duration) && ok;
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    OSCL_UNUSED_ARG(argc);
+    OSCL_UNUSED_ARG(argv);
+
+    uint32 failures = 0;
+
+    bool ok = TestTargetFromEstimates();
+    printf("target follows jitter and loss: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    ok = TestUnderflowPenaltyOnce();
+    printf("underflow penalty is applied once: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    ok = TestUnderflowPenaltyDecay();
+    printf("underflow penalty decays after a stable period: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -110,6 +110,8 @@ PVMFRTPJitterBufferImpl::PVMFRTPJitterBufferImpl(const PVMFJitterBufferConstruct
     isPrevNptTimeSet = false;
     iPrevNptTimeInRTPTimeScale = 0;
     iInterArrivalJitterD = 0;
+    iInterArrivalJitterInMSD = 0;
+    iPrevPacketArrivalSet = false;
     iPrevPacketRecvTime = 0;
     isPrevRtpTimeSet = false;
     iPrevRtpTimeBase = 0;
@@ -166,6 +168,8 @@ OSCL_EXPORT_REF void PVMFRTPJitterBufferImpl::ResetJitterBuffer()
     isPrevNptTimeSet = false;
     iPrevNptTimeInRTPTimeScale = 0;
     iInterArrivalJitterD = 0;
+    iInterArrivalJitterInMSD = 0;
+    iPrevPacketArrivalSet = false;
     iPrevPacketRecvTime = 0;
     isPrevRtpTimeSet = false;
     iPrevRtpTimeBase = 0;
@@ -656,6 +660,7 @@ bool PVMFRTPJitterBufferImpl::IsDelayEstablished(uint32& aClockDiff)
                         if (!iEOSSignalled)
                         {
                             irDelayEstablished = false;
+                            AdaptiveDurationUnderflow();
                             PVMFAsyncEvent jbEvent(PVMFInfoEvent, PVMFInfoUnderflow, NULL, NULL);
                             ReportJBInfoEvent(jbEvent);
                             LOGCLIENTANDESTIMATEDSERVCLK_REBUFF;
@@ -1002,9 +1007,21 @@ void PVMFRTPJitterBufferImpl::UpdatePacketArrivalStats(PVMFSharedMediaDataPtr& a
     /* Round up */
     iInterArrivalJitter = (uint32)(iInterArrivalJitterD + 0.5);
 
+    /* Same estimate with the RTP ts delta in ms, drives the adaptive duration */
+    if (iPrevPacketArrivalSet && (iRTPTimeScale > 0))
+    {
+        int32 ts_diff_ms = (int32)(((int64)ts_diff * 1000) / (int64)iRTPTimeScale);
+        int32 arrivalJitterInMS = ts_diff_ms - arrival_diff;
+        if (arrivalJitterInMS < 0)
+            arrivalJitterInMS = -arrivalJitterInMS;
+        iInterArrivalJitterInMSD += OSCL_STATIC_CAST(double, ((arrivalJitterInMS - iInterArrivalJitterInMSD) / 16.0));
+        UpdateAdaptiveDuration((uint32)(iInterArrivalJitterInMSD + 0.5));
+    }
+
     /* Update variables */
     iPrevPacketTS = rtpTimeStamp;
     iPrevPacketRecvTime = currPacketRecvTime32;
+    iPrevPacketArrivalSet = true;
 }
 
 bool PVMFRTPJitterBufferImpl::CanRetrievePacket()
@@ -132,6 +132,8 @@ class PVMFRTPJitterBufferImpl: public PVMFJitterBufferImpl
         PVMFTimebase_Tickcount iPacketArrivalTimeBase;
         PVMFTimestamp iPrevPacketTS;
         double iInterArrivalJitterD;
+        double iInterArrivalJitterInMSD;
+        bool iPrevPacketArrivalSet;
         uint32 iPrevPacketRecvTime;
 
         //Burst detection variables:
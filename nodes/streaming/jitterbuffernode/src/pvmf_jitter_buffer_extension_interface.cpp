@@ -79,6 +79,21 @@ void PVMFJitterBufferExtensionInterfaceImpl::getJitterBufferDurationInMilliSecon
     iContainer->GetJitterBufferDurationInMilliSeconds(duration);
 }
 
+OSCL_EXPORT_REF
+void PVMFJitterBufferExtensionInterfaceImpl::setAdaptiveJitterBufferDuration(bool aEnable,
+        uint32 aMinDurationInMS,
+        uint32 aMaxDurationInMS)
+{
+    iContainer->SetAdaptiveJitterBufferDuration(aEnable, aMinDurationInMS, aMaxDurationInMS);
+}
+
+OSCL_EXPORT_REF
+bool PVMFJitterBufferExtensionInterfaceImpl::getJitterBufferNetworkEstimates(PVMFPortInterface* aPort,
+        PVMFJitterBufferNetworkEstimates& aEstimates)
+{
+    return iContainer->GetJitterBufferNetworkEstimates(aPort, aEstimates);
+}
+
 OSCL_EXPORT_REF
 void PVMFJitterBufferExtensionInterfaceImpl::setEarlyDecodingTimeInMilliSeconds(uint32 duration)
 {
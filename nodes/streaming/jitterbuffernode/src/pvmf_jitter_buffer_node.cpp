@@ -157,6 +157,9 @@ void PVMFJitterBufferNode::ResetNodeParams(bool aReleaseMemory)
     //Variables to persist info passed on by the extension interface
     iRebufferingThreshold = DEFAULT_JITTER_BUFFER_UNDERFLOW_THRESHOLD_IN_MS;
     iJitterBufferDurationInMilliSeconds = DEFAULT_JITTER_BUFFER_DURATION_IN_MS;
+    iAdaptiveJitterBufferDuration = false;
+    iAdaptiveMinDurationInMilliSeconds = PVMF_JITTER_BUFFER_ADAPTIVE_DEFAULT_MIN_DURATION_IN_MS;
+    iAdaptiveMaxDurationInMilliSeconds = PVMF_JITTER_BUFFER_ADAPTIVE_DEFAULT_MAX_DURATION_IN_MS;
     iMaxInactivityDurationForMediaInMs = DEFAULT_MAX_INACTIVITY_DURATION_IN_MS;
     iEstimatedServerKeepAheadInMilliSeconds = DEFAULT_ESTIMATED_SERVER_KEEPAHEAD_FOR_OOO_SYNC_IN_MS;
 
@@ -973,6 +976,43 @@ void PVMFJitterBufferNode::GetJitterBufferDurationInMilliSeconds(uint32& duratio
     duration = iJitterBufferDurationInMilliSeconds;
 }
 
+void PVMFJitterBufferNode::SetAdaptiveJitterBufferDuration(bool aEnable, uint32 aMinDurationInMS, uint32 aMaxDurationInMS)
+{
+    PVMF_JBNODE_LOGINFO((0, "PVMFJitterBufferNode::SetAdaptiveJitterBufferDuration Enable[%d] Min[%d] Max[%d]", aEnable, aMinDurationInMS, aMaxDurationInMS));
+    iAdaptiveJitterBufferDuration = aEnable;
+    iAdaptiveMinDurationInMilliSeconds = aMinDurationInMS;
+    iAdaptiveMaxDurationInMilliSeconds = (aMaxDurationInMS > aMinDurationInMS) ? aMaxDurationInMS : aMinDurationInMS;
+
+    Oscl_Vector<PVMFJitterBufferPortParams*, OsclMemAllocator>::iterator it;
+    for (it = iPortParamsQueue.begin(); it != iPortParamsQueue.end(); it++)
+    {
+        PVMFJitterBufferPortParams* pPortParams  = *it;
+        if ((pPortParams->iTag == PVMF_JITTER_BUFFER_PORT_TYPE_INPUT) && pPortParams->ipJitterBuffer)
+        {
+            pPortParams->ipJitterBuffer->SetAdaptiveDurationMode(iAdaptiveJitterBufferDuration,
+                    iAdaptiveMinDurationInMilliSeconds,
+                    iAdaptiveMaxDurationInMilliSeconds);
+        }
+    }
+}
+
+bool PVMFJitterBufferNode::GetJitterBufferNetworkEstimates(PVMFPortInterface* aPort, PVMFJitterBufferNetworkEstimates& aEstimates)
+{
+    Oscl_Vector<PVMFJitterBufferPortParams*, OsclMemAllocator>::iterator it;
+    for (it = iPortParamsQueue.begin(); it != iPortParamsQueue.end(); it++)
+    {
+        PVMFJitterBufferPortParams* pPortParams  = *it;
+        if ((&pPortParams->irPort == aPort) &&
+                (pPortParams->iTag == PVMF_JITTER_BUFFER_PORT_TYPE_INPUT) &&
+                pPortParams->ipJitterBuffer)
+        {
+            pPortParams->ipJitterBuffer->GetNetworkEstimates(aEstimates);
+            return true;
+        }
+    }
+    return false;
+}
+
 void PVMFJitterBufferNode::SetEarlyDecodingTimeInMilliSeconds(uint32 duration)
 {
     PVMF_JBNODE_LOGINFO((0, "PVMFJitterBufferNode::SetEarlyDecodingTimeInMilliSeconds - Early Decoding Time [%d]", duration));
@@ -1448,13 +1488,19 @@ PVMFJitterBufferNode::SetPortParams(PVMFPortInterface* aPort,
 
 
             /* Compute buffer size based on bitrate and jitter duration*/
+            /* In adaptive mode the duration may grow up to the max, size for that */
+            uint32 bufferDurationInMS = iJitterBufferDurationInMilliSeconds;
+            if (iAdaptiveJitterBufferDuration && (iAdaptiveMaxDurationInMilliSeconds > bufferDurationInMS))
+            {
+                bufferDurationInMS = iAdaptiveMaxDurationInMilliSeconds;
+            }
             uint32 sizeInBytes = 0;
-            if (((int32)iJitterBufferDurationInMilliSeconds > 0) &&
+            if (((int32)bufferDurationInMS > 0) &&
                     ((int32)aBitRate > 0))
             {
                 uint32 byteRate = aBitRate / 8;
                 uint32 overhead = (byteRate * PVMF_JITTER_BUFFER_NODE_MEM_POOL_OVERHEAD) / 100;
-                uint32 durationInSec = iJitterBufferDurationInMilliSeconds / 1000;
+                uint32 durationInSec = bufferDurationInMS / 1000;
                 sizeInBytes = ((byteRate + overhead) * durationInSec);
                 if (sizeInBytes < MIN_RTP_SOCKET_MEM_POOL_SIZE_IN_BYTES)
                 {
@@ -2507,7 +2553,13 @@ void PVMFJitterBufferNode::DoRequestPort(PVMFJitterBufferNodeCommand& aCmd)
         PVMFJitterBufferConstructParams jbConstructParams(ipJitterBufferMisc->GetEstimatedServerClock(), *ipClientPlayBackClock, pPortParams->iMimeType, *ipJitterBufferMisc->GetEventNotifier(), iDelayEstablished, iJitterDelayPercent, iJitterBufferState, this, port);
         jbPtr = ipJitterBufferFactory->Create(jbConstructParams);
         if (jbPtr)
+        {
             jbPtr->SetDurationInMilliSeconds(iJitterBufferDurationInMilliSeconds);
+            if (iAdaptiveJitterBufferDuration)
+            {
+                jbPtr->SetAdaptiveDurationMode(true, iAdaptiveMinDurationInMilliSeconds, iAdaptiveMaxDurationInMilliSeconds);
+            }
+        }
         jitterBufferAutoPtr.set(jbPtr);
         pPortParams->ipJitterBuffer = jbPtr;
         if (iBroadCastSession == true)
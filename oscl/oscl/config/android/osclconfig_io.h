@@ -71,6 +71,7 @@
 #define OSCL_FILE_BUFFER_MAX_SIZE   32768
 #define OSCL_HAS_PV_FILE_CACHE  0
 #define OSCL_HAS_LARGE_FILE_SUPPORT 1
+#define OSCL_HAS_FILE_MAPPING_SUPPORT 1
 
 //For Sockets
 #define OSCL_HAS_SYMBIAN_SOCKET_SERVER 0
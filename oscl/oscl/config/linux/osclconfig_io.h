@@ -48,6 +48,8 @@
 #include <signal.h>
 #include <netdb.h>
 #include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/vfs.h>
 #include <glob.h>
 
@@ -60,6 +62,7 @@
 #define OSCL_FILE_BUFFER_MAX_SIZE   32768
 #define OSCL_HAS_PV_FILE_CACHE  1
 #define OSCL_HAS_LARGE_FILE_SUPPORT 1
+#define OSCL_HAS_FILE_MAPPING_SUPPORT 1
 
 //For Sockets
 #define OSCL_HAS_SYMBIAN_SOCKET_SERVER 0
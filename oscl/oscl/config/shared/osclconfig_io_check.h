@@ -77,6 +77,15 @@ Otherwise it should be set to 0.
 #error "ERROR: OSCL_HAS_LARGE_FILE_SUPPORT has to be defined to either 1 or 0"
 #endif
 
+/**
+OSCL_HAS_FILE_MAPPING_SUPPORT macro should be set to 1 if
+the target platform can map an open file read-only into memory
+(e.g. POSIX mmap).  Otherwise it should be set to 0.
+*/
+#ifndef OSCL_HAS_FILE_MAPPING_SUPPORT
+#error "ERROR: OSCL_HAS_FILE_MAPPING_SUPPORT has to be defined to either 1 or 0"
+#endif
+
 /**
 type TOsclFileOffset should be defined as the type used for file size
 and offsets on the target platform.
@@ -21,6 +21,8 @@
 #include "oscl_mem.h"
 #include "oscl_file_io.h"
 #include "oscl_file_native.h"
+#include "oscl_file_stats.h"
+#include "oscl_tickcount.h"
 #include "pvlogger.h"
 
 OsclFileCache::OsclFileCache(Oscl_File& aContainer):
@@ -34,6 +36,20 @@ OsclFileCache::OsclFileCache(Oscl_File& aContainer):
         , _cacheUpdateEnd(0)
         , _fileSize(0)
         , _nativePosition(0)
+        , _readAheadEnabled(false)
+        , _maxCacheSize(0)
+        , _pPrefetchBuffer(NULL)
+        , _prefetchPending(false)
+        , _prefetchSeek(false)
+        , _prefetchFilePosition(0)
+        , _prefetchRequestSize(0)
+        , _prefetchLength(0)
+        , _prefetchNativePosition(0)
+        , _lastFillEnd(0)
+        , _sequentialFills(0)
+        , _lastFillTick(0)
+        , _prefetchThreadActive(false)
+        , _prefetchThreadExitFlag(false)
         , iLogger(NULL)
 {
 }
@@ -43,7 +59,7 @@ OsclFileCache::~OsclFileCache()
     Close();
 }
 
-int32 OsclFileCache::Open(uint32 mode, uint32 size)
+int32 OsclFileCache::Open(uint32 mode, uint32 size, uint32 maxsize)
 //Called to open the cache for a newly opened file.
 //The NativeOpen was just called prior to this and was successful.
 {
@@ -62,7 +78,17 @@ int32 OsclFileCache::Open(uint32 mode, uint32 size)
         iLogger = NULL;
 
     PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_DEBUG,
-                    (0, "OsclFileCache(0x%x)::Open mode %d size %d", this, mode, size));
+                    (0, "OsclFileCache(0x%x)::Open mode %d size %d maxsize %d", this, mode, size, maxsize));
+
+    //read-ahead is only used for read-only files, since the prefetch
+    //thread reads the native file behind any cached writes.
+    _readAheadEnabled = (maxsize > 0)
+                        && !(mode & (Oscl_File::MODE_READWRITE | Oscl_File::MODE_APPEND | Oscl_File::MODE_READ_PLUS));
+    _maxCacheSize = (maxsize > size) ? maxsize : size;
+    _prefetchPending = false;
+    _lastFillEnd = 0;
+    _sequentialFills = 0;
+    _lastFillTick = 0;
 
     // allocate memory for cache
     // free any old buffer since its size may be different
@@ -78,6 +104,19 @@ int32 OsclFileCache::Open(uint32 mode, uint32 size)
                         (0, "OsclFileCache(0x%x)::Open ERROR no memory %d", this));
         return (-1);//error
     }
+    if (_pPrefetchBuffer)
+    {
+        OSCL_FREE(_pPrefetchBuffer);
+        _pPrefetchBuffer = NULL;
+    }
+    if (_readAheadEnabled)
+    {
+        //without a prefetch buffer the cache still works, it just
+        //won't read ahead.
+        _pPrefetchBuffer = (uint8*)OSCL_MALLOC(_cacheSize);
+        if (!_pPrefetchBuffer)
+            _readAheadEnabled = false;
+    }
 
     //initialise the cache variables
     SetCachePosition(0);
@@ -92,6 +131,10 @@ int32 OsclFileCache::Open(uint32 mode, uint32 size)
 
 void OsclFileCache::Close()
 {
+    //the native file is about to be closed, so finish with it here.
+    WaitForPrefetch();
+    StopPrefetchThread();
+
     //flush any cache updates
     SetCachePosition(0);
 
@@ -101,6 +144,11 @@ void OsclFileCache::Close()
         OSCL_FREE(_pCacheBufferStart);
         _pCacheBufferStart = NULL;
     }
+    if (_pPrefetchBuffer)
+    {
+        OSCL_FREE(_pPrefetchBuffer);
+        _pPrefetchBuffer = NULL;
+    }
 }
 
 /**
@@ -144,6 +192,7 @@ uint32 OsclFileCache::Read(void* outputBuffer, uint32 size, uint32 numelements)
     uint8* destBuf = (uint8*)(outputBuffer);
 
     uint32 bytesToRead = numelements * size;
+    bool filled = false;
 
     //pull data out of the cache until we run out, then re-fill the cache
     //as needed until we get the desired amount.
@@ -174,6 +223,7 @@ uint32 OsclFileCache::Read(void* outputBuffer, uint32 size, uint32 numelements)
         else
         {
             //Re-fill cache from current virtual position
+            filled = true;
             int32 retval = FillCacheFromFile();
             if (retval != 0)
             {
@@ -189,6 +239,9 @@ uint32 OsclFileCache::Read(void* outputBuffer, uint32 size, uint32 numelements)
         }
     }
 
+    if (!filled && iContainer.iFileStats)
+        iContainer.iFileStats->Count(EOsclFileOp_CacheHit);
+
     //return number of whole elements read.
     return (size) ? ((size*numelements - bytesToRead) / size) : 0;
 
@@ -365,6 +418,12 @@ int32 OsclFileCache::Seek(TOsclFileOffset offset, Oscl_File::seek_type origin)
 
     //else seeking outside cache
 
+    //While a prefetch is pending the native file belongs to the
+    //prefetch thread.  The next fill will either use the prefetched
+    //data or seek, so just relocate the cache.
+    if (_prefetchPending)
+        return SetCachePosition(pos);
+
     //Seek to the real target location.
     //Always use SEEKSET because the actual file end or current
     //position may not be accurate at this point.
@@ -495,6 +554,8 @@ int32 OsclFileCache::SetCachePosition(TOsclFileOffset aNewPos)
  * Flush any updated data first.
  * This will return a full cache, or
  *  if at EOF, a partial or empty cache.
+ * With read-ahead, the fill is served from the prefetched
+ *  window when it covers the current position.
  *
  * @param void
  *
@@ -520,6 +581,44 @@ int32 OsclFileCache::FillCacheFromFile()
         }
     }
 
+    if (_readAheadEnabled)
+    {
+        //a fill at or shortly after the end of the last one continues
+        //a sequential read.
+        if (newpos >= _lastFillEnd
+                && newpos < (TOsclFileOffset)(_lastFillEnd + _cacheSize))
+            _sequentialFills++;
+        else
+            _sequentialFills = 0;
+
+        if (_prefetchPending)
+        {
+            WaitForPrefetch();
+
+            if (newpos >= _prefetchFilePosition
+                    && newpos < (TOsclFileOffset)(_prefetchFilePosition + _prefetchLength))
+            {
+                //swap the prefetched window in as the cache.
+                uint8* buf = _pCacheBufferStart;
+                _pCacheBufferStart = _pPrefetchBuffer;
+                _pPrefetchBuffer = buf;
+
+                _cacheFilePosition = _prefetchFilePosition;
+                _currentCachePos = (uint32)(newpos - _prefetchFilePosition);
+                _endCachePos = _prefetchLength;
+
+                PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_DEBUG,
+                                (0, "OsclFileCache(0x%x)::FillCacheFromFile read-ahead hit %d bytes", this, _endCachePos));
+
+                if (iContainer.iFileStats)
+                    iContainer.iFileStats->Count(EOsclFileOp_ReadAheadHit);
+
+                ReadAheadAfterFill();
+                return 0;//success
+            }
+        }
+    }
+
     //Now seek to the read position if needed.
     if (_nativePosition != newpos)
     {
@@ -536,17 +635,236 @@ int32 OsclFileCache::FillCacheFromFile()
     }
 
     //try to fill the cache.  If we hit EOF we won't get a full cache.
+    uint32 ticks = 0;
+    if (iContainer.iFileStats)
+        iContainer.iFileStats->Start(ticks);
+
     _endCachePos = iContainer.CallNativeRead((void*)_pCacheBufferStart, 1, _cacheSize);
 
+    if (iContainer.iFileStats)
+        iContainer.iFileStats->End(EOsclFileOp_CacheMiss, ticks, _endCachePos, newpos);
+
     PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_DEBUG,
                     (0, "OsclFileCache(0x%x)::FillCacheFromFile got %d bytes", this, _endCachePos));
 
     //update native position
     _nativePosition += _endCachePos;
 
+    if (_readAheadEnabled)
+        ReadAheadAfterFill();
+
     return 0;//success
 }
 
+/**
+ * ReadAheadAfterFill
+ *
+ * Called after each fill in read-ahead mode.  Once access is
+ * sequential, grows the cache when the reader is consuming it
+ * faster than OSCL_FILE_CACHE_READ_AHEAD_REFILL_MSEC per window,
+ * then starts a prefetch of the window following the cache.
+ */
+void OsclFileCache::ReadAheadAfterFill()
+{
+    _lastFillEnd = _cacheFilePosition + _endCachePos;
+
+    uint32 now = OsclTickCount::TickCount();
+    uint32 elapsed = OsclTickCount::TicksToMsec(now - _lastFillTick);
+    _lastFillTick = now;
+
+    if (_sequentialFills < OSCL_FILE_CACHE_READ_AHEAD_MIN_SEQUENTIAL_FILLS)
+        return;
+
+    if (_cacheSize < _maxCacheSize
+            && elapsed < OSCL_FILE_CACHE_READ_AHEAD_REFILL_MSEC)
+    {
+        uint32 newsize = 2 * _cacheSize;
+        if (newsize > _maxCacheSize)
+            newsize = _maxCacheSize;
+        GrowCache(newsize);
+    }
+
+    if (_lastFillEnd < _fileSize)
+        StartPrefetch(_lastFillEnd);
+}
+
+/**
+ * GrowCache
+ *
+ * Reallocates the cache and prefetch buffers at the new size,
+ * keeping the data currently in the cache.  No prefetch may be
+ * pending.  On allocation failure the current size is kept.
+ */
+void OsclFileCache::GrowCache(uint32 aNewSize)
+{
+    OSCL_ASSERT(!_prefetchPending);
+
+    uint8* cache = (uint8*)OSCL_MALLOC(aNewSize);
+    if (!cache)
+        return;
+    uint8* prefetch = (uint8*)OSCL_MALLOC(aNewSize);
+    if (!prefetch)
+    {
+        OSCL_FREE(cache);
+        return;
+    }
+
+    PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_DEBUG,
+                    (0, "OsclFileCache(0x%x)::GrowCache size %d newsize %d", this, _cacheSize, aNewSize));
+
+    oscl_memcpy(cache, _pCacheBufferStart, _endCachePos);
+    OSCL_FREE(_pCacheBufferStart);
+    _pCacheBufferStart = cache;
+    OSCL_FREE(_pPrefetchBuffer);
+    _pPrefetchBuffer = prefetch;
+    _cacheSize = aNewSize;
+}
+
+/**
+ * StartPrefetch
+ *
+ * Starts a background read of one cache window at aPos into the
+ * prefetch buffer.  Until WaitForPrefetch is called the native file
+ * must not be accessed.
+ */
+void OsclFileCache::StartPrefetch(TOsclFileOffset aPos)
+{
+    OSCL_ASSERT(!_prefetchPending);
+
+    LaunchPrefetchThread();
+    if (!_prefetchThreadActive)
+        return;
+
+    _prefetchFilePosition = aPos;
+    _prefetchSeek = (_nativePosition != aPos);
+    _prefetchRequestSize = _cacheSize;
+    _prefetchLength = 0;
+    _prefetchPending = true;
+
+    //wake up the thread
+    _prefetchStartSem.Signal();
+}
+
+/**
+ * WaitForPrefetch
+ *
+ * Completes any pending prefetch, blocking if the background read
+ * has not finished yet.  Such a wait is a stall of the reader and is
+ * recorded in the file stats.
+ */
+void OsclFileCache::WaitForPrefetch()
+{
+    if (!_prefetchPending)
+        return;
+
+    if (_prefetchDoneSem.TryWait() != OsclProcStatus::SUCCESS_ERROR)
+    {
+        uint32 ticks = 0;
+        if (iContainer.iFileStats)
+            iContainer.iFileStats->Start(ticks);
+
+        _prefetchDoneSem.Wait();
+
+        if (iContainer.iFileStats)
+            iContainer.iFileStats->End(EOsclFileOp_CacheStall, ticks, _prefetchRequestSize, _prefetchFilePosition);
+    }
+
+    _prefetchPending = false;
+    _nativePosition = _prefetchNativePosition;
+}
+
+void OsclFileCache::LaunchPrefetchThread()
+{
+    if (!_prefetchThreadActive)
+    {
+        PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_DEBUG,
+                        (0, "OsclFileCache(0x%x)::LaunchPrefetchThread starting thread ", this));
+
+        _prefetchStartSem.Create(0);
+        _prefetchDoneSem.Create(0);
+        _prefetchExitSem.Create(0);
+        _prefetchThreadExitFlag = false;
+        OsclThread thread;
+        OsclProcStatus::eOsclProcError status = thread.Create(PrefetchThreadFunc, 4096, (TOsclThreadFuncArg)this);
+        if (status == OsclProcStatus::SUCCESS_ERROR)
+        {
+            _prefetchThreadActive = true;
+        }
+        else
+        {
+            //carry on without read-ahead.
+            _prefetchStartSem.Close();
+            _prefetchDoneSem.Close();
+            _prefetchExitSem.Close();
+            _readAheadEnabled = false;
+        }
+    }
+}
+
+void OsclFileCache::StopPrefetchThread()
+{
+    if (_prefetchThreadActive)
+    {
+        PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_DEBUG,
+                        (0, "OsclFileCache(0x%x)::StopPrefetchThread stopping thread ", this));
+
+        //signal the thread to exit & wake it up.
+        _prefetchThreadExitFlag = true;
+        _prefetchStartSem.Signal();
+
+        //wait on thread to exit so we can reset the sems safely
+        _prefetchExitSem.Wait();
+        _prefetchThreadActive = false;
+
+        _prefetchStartSem.Close();
+        _prefetchDoneSem.Close();
+        _prefetchExitSem.Close();
+    }
+}
+
+void OsclFileCache::InThread()
+{
+    OsclNativeFile* file = iContainer.iNativeFile;
+
+    while (!_prefetchThreadExitFlag)
+    {
+        //wait for a prefetch request
+        _prefetchStartSem.Wait();
+
+        //see if it's a close request
+        if (_prefetchThreadExitFlag)
+            break;
+
+        if (_prefetchSeek
+                && file->Seek(_prefetchFilePosition, Oscl_File::SEEKSET) != 0)
+        {
+            _prefetchLength = 0;
+            _prefetchNativePosition = file->Tell();
+        }
+        else
+        {
+            _prefetchLength = file->Read(_pPrefetchBuffer, 1, _prefetchRequestSize);
+            _prefetchNativePosition = _prefetchFilePosition + _prefetchLength;
+        }
+
+        //complete the request.
+        _prefetchDoneSem.Signal();
+    }
+
+    //signal that thread is exiting.
+    _prefetchExitSem.Signal();
+}
+
+//static thread routine.
+TOsclThreadFuncRet OSCL_THREAD_DECL OsclFileCache::PrefetchThreadFunc(TOsclThreadFuncArg aArg)
+{
+    OsclFileCache* This = (OsclFileCache*)aArg;
+
+    This->InThread();
+
+    return 0;
+}
+
 
 /**
  * WriteCacheToFile
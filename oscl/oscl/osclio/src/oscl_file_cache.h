@@ -46,6 +46,22 @@
 
 #include "oscl_file_io.h"
 
+#ifndef OSCL_SEMAPHORE_H_INCLUDED
+#include "oscl_semaphore.h"
+#endif
+
+#ifndef OSCL_THREAD_H_INCLUDED
+#include "oscl_thread.h"
+#endif
+
+//Number of consecutive forward fills before the cache starts reading ahead.
+#define OSCL_FILE_CACHE_READ_AHEAD_MIN_SEQUENTIAL_FILLS 2
+
+//When the reader drains a whole cache window in less than this time, the
+//window is too small for the stream bitrate and is doubled (up to the
+//read-ahead size given to Open).
+#define OSCL_FILE_CACHE_READ_AHEAD_REFILL_MSEC 1000
+
 class Oscl_File;
 
 class OsclFileCache : public HeapBase
@@ -54,7 +70,12 @@ class OsclFileCache : public HeapBase
         OsclFileCache(Oscl_File& aContainer);
         ~OsclFileCache();
 
-        int32 Open(uint32 mode, uint32 cache_size);
+        //A non-zero max_cache_size enables read-ahead for read-only files.
+        //The cache then grows from cache_size up to max_cache_size as the
+        //observed read rate requires, and once access is sequential the next
+        //window is read on a background thread while the current one is
+        //consumed.
+        int32 Open(uint32 mode, uint32 cache_size, uint32 max_cache_size = 0);
 
         void Close();
 
@@ -124,6 +145,41 @@ class OsclFileCache : public HeapBase
         int32 FillCacheFromFile();
         int32 WriteCacheToFile();
 
+        //Read-ahead state.  The prefetch buffer is the same size as the
+        //cache buffer and the two are swapped when a fill lands in the
+        //prefetched window.  While a prefetch is pending the native file
+        //belongs to the prefetch thread.
+        bool _readAheadEnabled;
+        uint32 _maxCacheSize;
+        uint8* _pPrefetchBuffer;
+        bool _prefetchPending;
+        bool _prefetchSeek;
+        TOsclFileOffset _prefetchFilePosition;
+        uint32 _prefetchRequestSize;
+        uint32 _prefetchLength;
+        TOsclFileOffset _prefetchNativePosition;
+
+        //End of the data from the last fill, to detect sequential access
+        TOsclFileOffset _lastFillEnd;
+        uint32 _sequentialFills;
+        uint32 _lastFillTick;
+
+        void ReadAheadAfterFill();
+        void GrowCache(uint32 aNewSize);
+        void StartPrefetch(TOsclFileOffset aPos);
+        void WaitForPrefetch();
+
+        //Prefetch thread
+        OsclSemaphore _prefetchStartSem;
+        OsclSemaphore _prefetchDoneSem;
+        OsclSemaphore _prefetchExitSem;
+        bool _prefetchThreadActive;
+        bool _prefetchThreadExitFlag;
+        void LaunchPrefetchThread();
+        void StopPrefetchThread();
+        void InThread();
+        static TOsclThreadFuncRet OSCL_THREAD_DECL PrefetchThreadFunc(TOsclThreadFuncArg);
+
         PVLogger* iLogger;
 };
 
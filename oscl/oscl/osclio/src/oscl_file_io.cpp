@@ -57,6 +57,7 @@ void Oscl_File::Construct()
     iNativeBufferSize = 0;
     iNativeAccessMode = 0;
     iPVCacheSize = 0;
+    iPVCacheReadAheadSize = 0;
     iAsyncReadBufferSize = 0;
     iAsyncFile = NULL;
 
@@ -160,6 +161,12 @@ OSCL_EXPORT_REF void Oscl_File::SetPVCacheSize(uint32 aSize)
     iPVCacheSize = aSize;
 }
 
+OSCL_EXPORT_REF void Oscl_File::SetPVCacheReadAheadSize(uint32 aSize)
+{
+    //just save the value now-- it will take effect on the next open.
+    iPVCacheReadAheadSize = aSize;
+}
+
 OSCL_EXPORT_REF void Oscl_File::SetAsyncReadBufferSize(uint32 aSize)
 {
     //just save the value now-- it will take effect on the next open.
@@ -302,7 +309,7 @@ int32 Oscl_File::OpenFileCacheOrAsyncBuffer(const char *filename
 
     if (iFileCache)
     {
-        return iFileCache->Open(mode, iPVCacheSize);
+        return iFileCache->Open(mode, iPVCacheSize, iPVCacheReadAheadSize);
     }
     else if (iAsyncFile)
     {
@@ -742,6 +749,32 @@ OSCL_EXPORT_REF int32 Oscl_File::GetError()
     return CallNativeGetError();
 }
 
+OSCL_EXPORT_REF OsclAny* Oscl_File::MapReadOnly(TOsclFileOffset& aSize)
+{
+    aSize = 0;
+    if (!iIsOpen || !iNativeFile)
+        return NULL;
+
+    //writes still sitting in the PV cache would not be visible
+    //through the mapping.
+    if (iFileCache && iFileCache->Flush() != 0)
+        return NULL;
+
+    OsclAny* base = iNativeFile->MapReadOnly(aSize);
+
+    if (iLogger)
+    {
+        PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_DEBUG,
+                        (0, "Oscl_File(0x%x)::MapReadOnly base 0x%x size %d", this, base, (int32)aSize));
+    }
+    return base;
+}
+
+OSCL_EXPORT_REF void Oscl_File::Unmap(OsclAny* aBase, TOsclFileOffset aSize)
+{
+    OsclNativeFile::Unmap(aBase, aSize);
+}
+
 int32  Oscl_File::CallNativeOpen(const OsclFileHandle& handle, uint32 mode
                                  , const OsclNativeFileParams& params
                                  , Oscl_FileServer& fileserv)
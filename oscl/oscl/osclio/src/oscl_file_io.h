@@ -157,6 +157,21 @@ class Oscl_File : public HeapBase
          */
         OSCL_IMPORT_REF void SetPVCacheSize(uint32 aSize);
 
+        /**
+         * SetPVCacheReadAheadSize enables read-ahead in the PV cache for
+         *   files opened read-only.  Once reads are sequential, the cache
+         *   reads the next window on a background thread, and grows from
+         *   the SetPVCacheSize value up to aSize when the reader consumes
+         *   data faster than it can be refilled.  Cache hits, misses and
+         *   read-ahead stalls are reported by the summary stats.
+         *
+         *   This should be called before opening the file.  It has no
+         *   effect unless the PV cache is enabled.
+         *
+         * @param aSize: maximum cache size in bytes.  Zero disables read-ahead.
+         */
+        OSCL_IMPORT_REF void SetPVCacheReadAheadSize(uint32 aSize);
+
         /**
          * SetNativeAccessMode allows switching between different native file access
          *  modes, when available.
@@ -376,6 +391,27 @@ class Oscl_File : public HeapBase
          */
         OSCL_IMPORT_REF TOsclFileOffset Size();
 
+        /**
+         * Map the whole file read-only into memory, so that callers can
+         * access its content without copying through Read.  Only
+         * available for files opened for reading on platforms with
+         * OSCL_HAS_FILE_MAPPING_SUPPORT.  The mapping stays valid after
+         * the file is closed and must be released with Unmap.
+         *
+         * @param aSize: receives the mapped length in bytes.
+         * @return - Base address of the mapping, or NULL if the file
+         *           cannot be mapped.
+         */
+        OSCL_IMPORT_REF OsclAny* MapReadOnly(TOsclFileOffset& aSize);
+
+        /**
+         * Release a mapping returned by MapReadOnly.
+         *
+         * @param aBase: base address returned by MapReadOnly.
+         * @param aSize: mapped length returned by MapReadOnly.
+         */
+        OSCL_IMPORT_REF static void Unmap(OsclAny* aBase, TOsclFileOffset aSize);
+
         /**
          * SetLoggingEnable configures the PVLogger output for this file.
          *   This will enable full logging of each API entry and
@@ -422,6 +458,7 @@ class Oscl_File : public HeapBase
 
         //For PV File Cache
         uint32 iPVCacheSize;
+        uint32 iPVCacheReadAheadSize;
         OsclFileCache* iFileCache;
 
         int32 OpenFileCacheOrAsyncBuffer(const char *filename
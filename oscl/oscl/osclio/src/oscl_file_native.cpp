@@ -553,6 +553,48 @@ uint32 OsclNativeFile::GetReadAsyncNumElements()
     return 0;//not supported
 }
 
+OsclAny* OsclNativeFile::MapReadOnly(TOsclFileOffset& aSize)
+{
+    aSize = 0;
+#if (OSCL_HAS_FILE_MAPPING_SUPPORT)
+    //only plain read-only files opened through fopen or an external
+    //FILE handle can be mapped.  Shared-fd sources carry an offset
+    //that is not page aligned in general, so they stay on the read path.
+    if (iFile == NULL
+            || (iMode & (Oscl_File::MODE_READWRITE | Oscl_File::MODE_APPEND | Oscl_File::MODE_READ_PLUS)))
+    {
+        return NULL;
+    }
+    TOsclFileOffset size = Size();
+    if (size <= 0 || (uint64)size > (uint64)((size_t) - 1))
+    {
+        return NULL;
+    }
+    void* base = mmap(NULL, (size_t)size, PROT_READ, MAP_SHARED, fileno(iFile), 0);
+    if (base == MAP_FAILED)
+    {
+        return NULL;
+    }
+    aSize = size;
+    return base;
+#else
+    return NULL;//not supported
+#endif
+}
+
+void OsclNativeFile::Unmap(OsclAny* aBase, TOsclFileOffset aSize)
+{
+#if (OSCL_HAS_FILE_MAPPING_SUPPORT)
+    if (aBase)
+    {
+        munmap(aBase, (size_t)aSize);
+    }
+#else
+    OSCL_UNUSED_ARG(aBase);
+    OSCL_UNUSED_ARG(aSize);
+#endif
+}
+
 
 
 uint32 OsclNativeFile::Write(const OsclAny *buffer, uint32 size, uint32 numelements)
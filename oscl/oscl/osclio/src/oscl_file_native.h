@@ -125,6 +125,17 @@ class OsclNativeFile : public HeapBase
         **/
         void ReadAsyncCancel();
 
+        /*!
+        ** Map the whole file read-only into memory.
+        ** @param aSize: receives the mapped length in bytes.
+        ** @returns: base of the mapping, or NULL if the file cannot be mapped.
+        **/
+        OsclAny* MapReadOnly(TOsclFileOffset& aSize);
+        /*!
+        ** Release a mapping returned by MapReadOnly.
+        **/
+        static void Unmap(OsclAny* aBase, TOsclFileOffset aSize);
+
     private:
         int32 OpenFileOrSharedFd(const char *filename, const char *openmode);
 
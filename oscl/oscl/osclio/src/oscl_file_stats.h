@@ -71,6 +71,10 @@ enum TOsclFileOp
     , EOsclFileOp_NativeSize
     , EOsclFileOp_NativeFlush
     , EOsclFileOp_NativeEndOfFile
+    , EOsclFileOp_CacheHit
+    , EOsclFileOp_CacheMiss
+    , EOsclFileOp_CacheStall
+    , EOsclFileOp_ReadAheadHit
     , EOsclFileOp_Last
 };
 static const char* const TOsclFileOpStr[] =
@@ -93,6 +97,10 @@ static const char* const TOsclFileOpStr[] =
     , "NativeSize"
     , "NativeFlush"
     , "NativeEndOfFile"
+    , "CacheHit"
+    , "CacheMiss"
+    , "CacheStall"
+    , "ReadAheadHit"
     , "???"
 };
 
@@ -105,6 +113,15 @@ class OsclFileStats
         OsclFileStats(Oscl_File* c);
         void Start(uint32& aTicks);
         void End(TOsclFileOp aOp, uint32 aStart, uint32 aParam = 0, TOsclFileOffset aParam2 = 0);
+        //count an untimed event, such as a cache hit.
+        void Count(TOsclFileOp aOp)
+        {
+            iStats[aOp].iOpCount++;
+        }
+        uint32 OpCount(TOsclFileOp aOp) const
+        {
+            return iStats[aOp].iOpCount;
+        }
         void Log(TOsclFileOp, PVLogger*, uint32);
         void LogAll(PVLogger*, uint32);
 
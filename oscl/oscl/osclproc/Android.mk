@@ -43,6 +43,7 @@ LOCAL_COPY_HEADERS := \
  	src/oscl_scheduler_threadcontext.h \
  	src/oscl_scheduler_types.h \
  	src/oscl_scheduler_tuneables.h \
+ 	src/oscl_scheduler_profiler.h \
  	src/oscl_double_list.h \
  	src/oscl_double_list.inl \
  	src/oscl_timer.h \
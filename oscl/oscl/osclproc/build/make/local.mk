@@ -33,6 +33,7 @@ HDRS := oscl_aostatus.h \
         oscl_scheduler_threadcontext.h \
         oscl_scheduler_types.h \
         oscl_scheduler_tuneables.h \
+        oscl_scheduler_profiler.h \
         oscl_double_list.h \
         oscl_double_list.inl \
         oscl_timer.h \
@@ -27,6 +27,10 @@
 #include "pvlogger.h"
 #include "oscl_tls.h"
 #include "oscl_int64_utils.h"
+#include "oscl_time.h"
+#include "oscl_snprintf.h"
+#include "oscl_stdstring.h"
+#include "oscl_string_json.h"
 
 #define OSCL_DISABLE_WARNING_CONDITIONAL_IS_CONSTANT
 #include "osclconfig_compiler_warnings.h"
@@ -209,6 +213,13 @@ OSCL_EXPORT_REF void OsclScheduler::Cleanup()
 
 OsclMemAllocator OsclExecSchedulerCommonBase::iDefAlloc;
 
+//Microsecond time for the run counters and profiler.
+//Only differences are meaningful, the value wraps every 71 minutes.
+static inline uint32 SchedTimeUsec(const TimeValue& aTime)
+{
+    return (uint32)(aTime.get_sec() * 1000000 + aTime.get_usec());
+}
+
 #if(PV_SCHED_ENABLE_PERF_LOGGING)
 void OsclExecSchedulerCommonBase::ResetLogPerf()
 {
@@ -297,6 +308,11 @@ OsclExecSchedulerCommonBase::~OsclExecSchedulerCommonBase()
         iStopper->~PVSchedulerStopper();
         iAlloc->deallocate(iStopper);
     }
+    if (iProfiler)
+    {
+        iProfiler->~OsclSchedulerProfiler();
+        iAlloc->deallocate(iProfiler);
+    }
 #if(PV_SCHED_ENABLE_PERF_LOGGING)
     if (iLogPerfIndentStr)
         _oscl_free(iLogPerfIndentStr);
@@ -310,6 +326,8 @@ OsclExecScheduler::~OsclExecScheduler()
 OsclExecSchedulerCommonBase::OsclExecSchedulerCommonBase(Oscl_DefAlloc *alloc)
 {
     iAlloc = (alloc) ? alloc : &iDefAlloc;
+    iProfiler = NULL;
+    iProfileEnabled = false;
 #if(PV_SCHED_ENABLE_PERF_LOGGING)
     iLogPerfIndentStr = NULL;
     iLogPerfTotal = 0;
@@ -367,6 +385,7 @@ void OsclExecSchedulerCommonBase::InstallScheduler()
     iThreadContext.EnterThreadContext();
 
     iErrorTrapImp = OsclErrorTrap::GetErrorTrapImp();
+    iRunningAO = NULL;
     if (!iErrorTrapImp)
         OsclError::Leave(OsclErrNotInstalled);//error trap not installed.
 
@@ -1149,6 +1168,15 @@ void OsclExecSchedulerCommonBase::PendComplete(PVActiveBase *pvbase, int32 aReas
             iExecTimerQ.Remove(pvbase);
     }
 
+    //Note the completion time for the profiler's scheduling latency.
+    //The ReadyQ lock orders this with the read in CallRunExec.
+    if (iProfileEnabled)
+    {
+        TimeValue now;
+        pvbase->iPVReadyQLink.iTimeQueuedUsec = SchedTimeUsec(now);
+        pvbase->iPVReadyQLink.iTimeQueuedUsecValid = true;
+    }
+
     //Pass this to the ReadyQ so it can do appropriate queue locks
     int32 err = iReadyQ.PendComplete(pvbase, aReason);
 
@@ -1206,6 +1234,245 @@ void OsclExecSchedulerCommonBase::RequestCanceled(PVActiveBase* pvbase)
 
 
 
+////////////////////////////////////////
+// Runtime Profiler
+////////////////////////////////////////
+
+OSCL_EXPORT_REF uint32 OsclSchedulerHistogram::Percentile(uint32 aPercent) const
+{
+    if (iCount == 0)
+        return 0;
+
+    //rank of the requested sample, rounded up.
+    uint32 rank = (uint32)(((uint64)iCount * aPercent + 99) / 100);
+    if (rank == 0)
+        rank = 1;
+
+    uint32 seen = 0;
+    for (uint32 i = 0; i < OSCL_SCHED_PROFILE_BUCKETS; i++)
+    {
+        seen += iBucket[i];
+        if (seen >= rank)
+        {
+            if (i == 0)
+                return 0;
+            if (i == OSCL_SCHED_PROFILE_BUCKETS - 1)
+                return iMax;
+            uint32 upper = (1 << i) - 1;
+            return (upper < iMax) ? upper : iMax;
+        }
+    }
+    return iMax;
+}
+
+OsclSchedulerProfiler::OsclSchedulerProfiler()
+{
+    iOutlierNext = 0;
+    iTraceNext = 0;
+    iTraceCountdown = 0;
+}
+
+void OsclSchedulerProfiler::Configure(const OsclSchedulerProfileConfig& aConfig)
+//reserve the ring buffers up front so that Record never allocates.
+{
+    iOutliers.clear();
+    iOutliers.reserve(aConfig.iMaxOutliers);
+    iOutlierNext = 0;
+
+    iTrace.clear();
+    if (aConfig.iTraceSampleInterval)
+        iTrace.reserve(aConfig.iTraceSize);
+    iTraceNext = 0;
+    iTraceCountdown = aConfig.iTraceSampleInterval;
+
+    iConfig = aConfig;
+}
+
+void OsclSchedulerProfiler::Reset()
+//clear the data but keep the AO entries, so indices held by
+//a Run call in progress stay valid.
+{
+    for (uint32 i = 0; i < iProfile.size(); i++)
+        iProfile[i].Reset();
+    iOutliers.clear();
+    iOutlierNext = 0;
+    iTrace.clear();
+    iTraceNext = 0;
+    iTraceCountdown = iConfig.iTraceSampleInterval;
+    iStartTime = TimeValue();
+}
+
+uint32 OsclSchedulerProfiler::Lookup(PVActiveBase* aActive)
+{
+    Oscl_Map<PVActiveBase*, uint32, OsclMemAllocator>::iterator it = iAOMap.find(aActive);
+    if (it != iAOMap.end())
+        return it->second;
+
+    //first Run for this AO.  AOs with the same name share one entry.
+    const char* name = (const char*)aActive->iName.Str();
+    uint32 index;
+    for (index = 0; index < iProfile.size(); index++)
+    {
+        if (oscl_strncmp(iProfile[index].iName, name, OSCL_SCHED_PROFILE_NAMELEN) == 0)
+            break;
+    }
+    if (index == iProfile.size())
+    {
+        OsclSchedulerAOProfile entry;
+        oscl_strncpy(entry.iName, name, OSCL_SCHED_PROFILE_NAMELEN);
+        entry.iName[OSCL_SCHED_PROFILE_NAMELEN] = '\0';
+        iProfile.push_back(entry);
+    }
+    iAOMap[aActive] = index;
+    return index;
+}
+
+void OsclSchedulerProfiler::Record(uint32 aIndex, const TimeValue& aStart, uint32 aRunUsec, uint32 aLatencyUsec, bool aLeave)
+{
+    OsclSchedulerAOProfile& entry = iProfile[aIndex];
+    entry.iRunCount++;
+    if (aLeave)
+        entry.iRunErrorCount++;
+    entry.iRunTimeUsec += aRunUsec;
+    entry.iRunTime.Add(aRunUsec);
+    if (aLatencyUsec)
+        entry.iLatency.Add(aLatencyUsec);
+
+    bool outlier = (aRunUsec >= iConfig.iOutlierThresholdUsec);
+    if (outlier)
+        entry.iOutlierCount++;
+
+    bool sample = false;
+    if (iConfig.iTraceSampleInterval && --iTraceCountdown == 0)
+    {
+        iTraceCountdown = iConfig.iTraceSampleInterval;
+        sample = true;
+    }
+
+    if (!outlier && !sample)
+        return;
+
+    OsclSchedulerRunRecord record;
+    record.iProfileIndex = aIndex;
+    record.iStartUsec = SchedTimeUsec(aStart) - SchedTimeUsec(iStartTime);
+    record.iRunUsec = aRunUsec;
+    record.iLatencyUsec = aLatencyUsec;
+
+    //the ring buffers were reserved in Configure, so these don't allocate.
+    if (outlier && iConfig.iMaxOutliers)
+    {
+        if (iOutliers.size() < iConfig.iMaxOutliers)
+            iOutliers.push_back(record);
+        else
+            iOutliers[iOutlierNext] = record;
+        iOutlierNext = (iOutlierNext + 1) % iConfig.iMaxOutliers;
+    }
+    if (sample && iConfig.iTraceSize)
+    {
+        if (iTrace.size() < iConfig.iTraceSize)
+            iTrace.push_back(record);
+        else
+            iTrace[iTraceNext] = record;
+        iTraceNext = (iTraceNext + 1) % iConfig.iTraceSize;
+    }
+}
+
+void OsclSchedulerProfiler::CopyRing(const Oscl_Vector<OsclSchedulerRunRecord, OsclMemAllocator>& aRing, uint32 aNext,
+                                     Oscl_Vector<OsclSchedulerRunRecord, OsclMemAllocator>& aOut)
+{
+    //until the ring wraps, aNext is the size and the oldest record is at 0.
+    uint32 size = aRing.size();
+    uint32 first = (aNext < size) ? aNext : 0;
+    for (uint32 i = 0; i < size; i++)
+        aOut.push_back(aRing[(first + i) % size]);
+}
+
+OSCL_EXPORT_REF void OsclExecSchedulerCommonBase::EnableProfiling(const OsclSchedulerProfileConfig& aConfig)
+{
+    if (!iProfiler)
+    {
+        OsclAny* ptr = iAlloc->ALLOCATE(sizeof(OsclSchedulerProfiler));
+        OsclError::LeaveIfNull(ptr);
+        iProfiler = OSCL_PLACEMENT_NEW(ptr, OsclSchedulerProfiler());
+    }
+    iProfiler->Configure(aConfig);
+    iProfileEnabled = true;
+
+    LOGNOTICE((0, "PVSCHED:Scheduler '%s', Thread 0x%x: Profiling enabled"
+               , iName.Str(), PVThreadContext::Id()));
+}
+
+OSCL_EXPORT_REF void OsclExecSchedulerCommonBase::DisableProfiling()
+{
+    iProfileEnabled = false;
+
+    LOGNOTICE((0, "PVSCHED:Scheduler '%s', Thread 0x%x: Profiling disabled"
+               , iName.Str(), PVThreadContext::Id()));
+}
+
+OSCL_EXPORT_REF void OsclExecSchedulerCommonBase::ResetProfile()
+{
+    if (iProfiler)
+        iProfiler->Reset();
+}
+
+OSCL_EXPORT_REF void OsclExecSchedulerCommonBase::GetProfile(Oscl_Vector<OsclSchedulerAOProfile, OsclMemAllocator>& aProfile)
+{
+    if (!iProfiler)
+        return;
+    for (uint32 i = 0; i < iProfiler->iProfile.size(); i++)
+        aProfile.push_back(iProfiler->iProfile[i]);
+}
+
+OSCL_EXPORT_REF void OsclExecSchedulerCommonBase::GetOutliers(Oscl_Vector<OsclSchedulerRunRecord, OsclMemAllocator>& aOutliers)
+{
+    if (!iProfiler)
+        return;
+    OsclSchedulerProfiler::CopyRing(iProfiler->iOutliers, iProfiler->iOutlierNext, aOutliers);
+}
+
+OSCL_EXPORT_REF void OsclExecSchedulerCommonBase::ExportTrace(OSCL_String& aJSON)
+//Write the trace as complete ("X") events, with the scheduling latency
+//in the event args.
+{
+    char buf[160];
+    uint32 tid = PVThreadContext::Id();
+
+    oscl_snprintf(buf, sizeof(buf),
+                  "{\"traceEvents\":[{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":"
+                  , tid);
+    aJSON += buf;
+    oscl_str_append_json(aJSON, (const char*)iName.Str());
+    aJSON += "}}";
+
+    if (iProfiler)
+    {
+        Oscl_Vector<OsclSchedulerRunRecord, OsclMemAllocator> trace;
+        trace.reserve(iProfiler->iTrace.size());
+        OsclSchedulerProfiler::CopyRing(iProfiler->iTrace, iProfiler->iTraceNext, trace);
+        for (uint32 i = 0; i < trace.size(); i++)
+        {
+            aJSON += ",{\"name\":";
+            oscl_str_append_json(aJSON, iProfiler->iProfile[trace[i].iProfileIndex].iName);
+            oscl_snprintf(buf, sizeof(buf),
+                          ",\"ph\":\"X\",\"ts\":%u,\"dur\":%u,\"pid\":0,\"tid\":%u,\"args\":{\"latencyUs\":%u}}"
+                          , trace[i].iStartUsec, trace[i].iRunUsec, tid, trace[i].iLatencyUsec);
+            aJSON += buf;
+        }
+    }
+
+    aJSON += "]}";
+}
+
+void OsclExecSchedulerCommonBase::ProfileRemove(PVActiveBase* aActive)
+//called when an AO leaves the scheduler, so the profiler does not
+//keep a stale pointer to it.
+{
+    if (iProfiler)
+        iProfiler->iAOMap.erase(aActive);
+}
+
+
 ////////////////////////////////////////
 // PV Scheduling Loop Implementation
 ////////////////////////////////////////
@@ -1226,14 +1493,51 @@ void OsclExecSchedulerCommonBase::CallRunExec(PVActiveBase *pvactive)
     INIT_TICK(iTime);
 #endif
 
+    int32 err;
+    TimeValue runStart;
+    PVActiveBase* prevRunningAO = iRunningAO;
+    iRunningAO = pvactive;
+
+    //look up the profile entry and scheduling latency now, since the AO
+    //may be deleted in the Run call.
+    bool profile = iProfileEnabled;
+    uint32 profileIndex = 0;
+    uint32 latencyUsec = 0;
+    if (profile)
+    {
+        OSCL_TRY_NO_TLS(iErrorTrapImp, err, profileIndex = iProfiler->Lookup(pvactive););
+        profile = (err == OsclErrNone);
+        if (pvactive->iPVReadyQLink.iTimeQueuedUsecValid)
+        {
+            latencyUsec = SchedTimeUsec(runStart) - pvactive->iPVReadyQLink.iTimeQueuedUsec;
+            pvactive->iPVReadyQLink.iTimeQueuedUsecValid = false;
+        }
+    }
+
     SET_TICK(iTime);
 
     //Call the Run under a trap harness.
     //Pass the ErrorTrapImp pointer to reduce overhead of the Try call.
     //We already did a null ptr check on iErrorTrapImp so it's safe to de-ref here.
-    int32 err;
     OSCL_TRY_NO_TLS(iErrorTrapImp, err, pvactive->Run(););
 
+    //update the always-on run counters, unless the AO was removed
+    //(and possibly deleted) in its Run.
+    TimeValue runEnd;
+    uint32 runUsec = SchedTimeUsec(runEnd) - SchedTimeUsec(runStart);
+    bool stillAdded = (iRunningAO == pvactive);
+    iRunningAO = prevRunningAO;
+    if (stillAdded)
+    {
+        pvactive->iRunCount++;
+        pvactive->iRunTimeUsec += runUsec;
+        if (runUsec > pvactive->iMaxRunUsec)
+            pvactive->iMaxRunUsec = runUsec;
+    }
+
+    if (profile)
+        iProfiler->Record(profileIndex, runStart, runUsec, latencyUsec, err != OsclErrNone);
+
     //end stats
     DIFF_TICK(iTime, iDelta);
     UPDATE_RUNL_TIME(iPVStats, iDelta);
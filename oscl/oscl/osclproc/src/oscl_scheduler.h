@@ -62,6 +62,10 @@
 #include "oscl_mem.h"
 #endif
 
+#ifndef OSCL_SCHEDULER_PROFILER_H_INCLUDED
+#include "oscl_scheduler_profiler.h"
+#endif
+
 class Oscl_DefAlloc;
 class OsclCoeActiveScheduler;
 
@@ -191,6 +195,61 @@ class OsclExecSchedulerCommonBase
          */
         OSCL_IMPORT_REF static uint32 GetId();
 
+        /**
+         * Runtime profiling APIs.  The profiler records per-AO Run counts,
+         * Run time histograms, the latency from request completion to Run,
+         * and Run calls that exceed an outlier threshold.  Unlike the
+         * PV_SCHED_ENABLE_AO_STATS statistics it is available in all builds.
+         *
+         * Calling context for all profiling APIs must be in-thread.
+         */
+
+        /**
+         * Start profiling, or change the settings if already running.
+         * Data gathered so far is kept.  May leave on memory failure.
+         * @param aConfig: (input param) profiler settings.
+         */
+        OSCL_IMPORT_REF void EnableProfiling(const OsclSchedulerProfileConfig& aConfig);
+
+        /**
+         * Stop profiling.  Data gathered so far is kept and can still be
+         * queried.
+         */
+        OSCL_IMPORT_REF void DisableProfiling();
+
+        /**
+         * Return true if the profiler is running.
+         */
+        bool IsProfilingEnabled() const
+        {
+            return iProfileEnabled;
+        }
+
+        /**
+         * Clear all data gathered so far.
+         */
+        OSCL_IMPORT_REF void ResetProfile();
+
+        /**
+         * Get the per-AO profile.  AOs with the same name are combined.
+         * @param aProfile: (output param) the profile entries are appended here.
+         */
+        OSCL_IMPORT_REF void GetProfile(Oscl_Vector<OsclSchedulerAOProfile, OsclMemAllocator>& aProfile);
+
+        /**
+         * Get the most recent Run calls that exceeded the outlier threshold,
+         * oldest first.
+         * @param aOutliers: (output param) the records are appended here.
+         */
+        OSCL_IMPORT_REF void GetOutliers(Oscl_Vector<OsclSchedulerRunRecord, OsclMemAllocator>& aOutliers);
+
+        /**
+         * Export the sampling trace in Chrome trace event JSON format,
+         * so it can be loaded into a trace viewer.
+         * @param aJSON: (output param) the JSON is appended here.
+         */
+        OSCL_IMPORT_REF void ExportTrace(OSCL_String& aJSON);
+
 
     protected:
         /*
@@ -244,6 +303,11 @@ class OsclExecSchedulerCommonBase
 
         OsclErrorTrapImp* iErrorTrapImp;
 
+        //The AO whose Run is in progress.  Cleared if the AO removes itself
+        //from the scheduler during the Run, so the run counters are not
+        //updated on a deleted object.
+        PVActiveBase* iRunningAO;
+
         //Ready AO queue.  The AOs in this queue are ready to run.
         OsclReadyQ iReadyQ;
 
@@ -261,6 +325,12 @@ class OsclExecSchedulerCommonBase
         PVActiveBase* WaitForReadyAO();
         void CallRunExec(PVActiveBase*);
 
+        //Runtime profiler, created on first use.
+        OsclSchedulerProfiler* iProfiler;
+        //Profiling flag, also read by PendComplete from any thread.
+        volatile bool iProfileEnabled;
+        void ProfileRemove(PVActiveBase*);
+
         static const uint32 iTimeCompareThreshold;
         friend class OsclTimerCompare;
         friend class OsclReadyQ;
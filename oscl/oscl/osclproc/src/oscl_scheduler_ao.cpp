@@ -40,6 +40,9 @@ PVActiveBase::PVActiveBase(const char name[],
 #if(PV_SCHED_ENABLE_AO_STATS)
     iPVActiveStats = NULL;
 #endif
+    iRunCount = 0;
+    iRunTimeUsec = 0;
+    iMaxRunUsec = 0;
     iPVReadyQLink.iAOPriority = pri;
     iBusy = false;
     iStatus = OSCL_REQUEST_ERR_NONE;
@@ -125,8 +128,16 @@ void PVActiveBase::RemoveFromScheduler()
             Cancel();
         //no additional de-queueing is needed-- once AOs are
         //canceled they're not in any queues.
+
+        iThreadContext.iScheduler->ProfileRemove(this);
     }
 
+    //if this AO is removed from inside its own Run, the scheduler
+    //must not touch it again once the Run returns.
+    if (iThreadContext.iScheduler
+            && iThreadContext.iScheduler->iRunningAO == this)
+        iThreadContext.iScheduler->iRunningAO = NULL;
+
     iThreadContext.ExitThreadContext();
 
 #if(PV_SCHED_ENABLE_AO_STATS)
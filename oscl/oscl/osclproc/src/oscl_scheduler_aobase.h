@@ -155,6 +155,15 @@ class PVActiveBase
         friend class PVActiveStats;
 #endif
 
+        /*
+        ** Run counters kept in all builds, unlike PVActiveStats.
+        ** These are cheap enough to leave on and are reported
+        ** through the PVMF node telemetry.
+        */
+        uint32 iRunCount;
+        uint64 iRunTimeUsec;
+        uint32 iMaxRunUsec;
+
 
         /*
         ** Non-Symbian AO implementation.
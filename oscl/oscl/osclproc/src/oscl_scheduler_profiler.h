@@ -0,0 +1,213 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/*! \addtogroup osclproc OSCL Proc
+ *
+ * @{
+ */
+
+
+/** \file oscl_scheduler_profiler.h
+    \brief Runtime profiling data for Oscl Scheduler
+*/
+
+/** This file defines the data returned by the runtime scheduler
+  profiler.  Unlike the PV_SCHED_ENABLE_AO_STATS statistics, the profiler
+  is present in all builds and is switched on and off at runtime with
+  OsclExecSchedulerCommonBase::EnableProfiling.
+ */
+
+#ifndef OSCL_SCHEDULER_PROFILER_H_INCLUDED
+#define OSCL_SCHEDULER_PROFILER_H_INCLUDED
+
+#ifndef OSCL_BASE_H_INCLUDED
+#include "oscl_base.h"
+#endif
+
+#ifndef OSCL_MEM_H_INCLUDED
+#include "oscl_mem.h"
+#endif
+
+#ifndef OSCL_VECTOR_H_INCLUDED
+#include "oscl_vector.h"
+#endif
+
+#ifndef OSCL_MAP_H_INCLUDED
+#include "oscl_map.h"
+#endif
+
+#ifndef OSCL_TIME_H_INCLUDED
+#include "oscl_time.h"
+#endif
+
+/*
+** Number of histogram buckets.  Bucket 0 holds zero, bucket i holds
+** samples in [2^(i-1), 2^i) microseconds and the last bucket holds
+** everything from about 0.5 seconds up.
+*/
+#define OSCL_SCHED_PROFILE_BUCKETS 20
+
+/*
+** Max length for AO names in the profile, same as PVEXECNAMELEN.
+*/
+#define OSCL_SCHED_PROFILE_NAMELEN 30
+
+class PVActiveBase;
+
+/**
+ * Log2-bucketed histogram of microsecond samples.
+ */
+class OsclSchedulerHistogram
+{
+    public:
+        OsclSchedulerHistogram()
+        {
+            Reset();
+        }
+
+        void Reset()
+        {
+            oscl_memset(iBucket, 0, sizeof(iBucket));
+            iCount = 0;
+            iMax = 0;
+        }
+
+        void Add(uint32 aUsec)
+        {
+            uint32 bucket = 0;
+            for (uint32 v = aUsec; v && bucket < OSCL_SCHED_PROFILE_BUCKETS - 1; v >>= 1)
+                bucket++;
+            iBucket[bucket]++;
+            iCount++;
+            if (aUsec > iMax)
+                iMax = aUsec;
+        }
+
+        /**
+         * Returns the upper bound of the bucket holding the given
+         * percentile, which is accurate to within a factor of two.
+         * @param aPercent: percentile between 0 and 100.
+         */
+        OSCL_IMPORT_REF uint32 Percentile(uint32 aPercent) const;
+
+        uint32 iBucket[OSCL_SCHED_PROFILE_BUCKETS];
+        uint32 iCount;
+        uint32 iMax;
+};
+
+/**
+ * Profiler settings, see OsclExecSchedulerCommonBase::EnableProfiling.
+ */
+class OsclSchedulerProfileConfig
+{
+    public:
+        OsclSchedulerProfileConfig()
+                : iOutlierThresholdUsec(10000)
+                , iMaxOutliers(32)
+                , iTraceSampleInterval(0)
+                , iTraceSize(4096)
+        {}
+
+        uint32 iOutlierThresholdUsec;//Run calls at least this long are kept as outliers.
+        uint32 iMaxOutliers;//number of most recent outliers kept.
+        uint32 iTraceSampleInterval;//every Nth Run call goes in the trace, 0 disables the trace.
+        uint32 iTraceSize;//number of most recent trace samples kept.
+};
+
+/**
+ * Profile for all AOs with the same name in one scheduler.
+ */
+class OsclSchedulerAOProfile
+{
+    public:
+        OsclSchedulerAOProfile()
+        {
+            iName[0] = '\0';
+            Reset();
+        }
+
+        void Reset()
+        {
+            iRunCount = 0;
+            iRunErrorCount = 0;
+            iRunTimeUsec = 0;
+            iOutlierCount = 0;
+            iRunTime.Reset();
+            iLatency.Reset();
+        }
+
+        char iName[OSCL_SCHED_PROFILE_NAMELEN + 1];
+        uint32 iRunCount;//number of Run calls
+        uint32 iRunErrorCount;//number of Run calls that left
+        uint64 iRunTimeUsec;//total time in Run
+        uint32 iOutlierCount;//number of Run calls over the outlier threshold
+        OsclSchedulerHistogram iRunTime;//time in each Run call
+        OsclSchedulerHistogram iLatency;//time from request completion to Run
+};
+
+/**
+ * A single Run call, as kept in the outlier list and sampling trace.
+ */
+class OsclSchedulerRunRecord
+{
+    public:
+        uint32 iProfileIndex;//index of the AO in the GetProfile output.
+        uint32 iStartUsec;//start of Run, relative to when profiling was enabled.
+        uint32 iRunUsec;//time in Run.
+        uint32 iLatencyUsec;//time from request completion to Run, 0 if unknown.
+};
+
+/**
+ * Profiler state for one scheduler.  This is internal to the scheduler;
+ * use the OsclExecSchedulerCommonBase profiling APIs to access it.
+ */
+class OsclSchedulerProfiler
+{
+    private:
+        OsclSchedulerProfiler();
+
+        void Configure(const OsclSchedulerProfileConfig& aConfig);
+        void Reset();
+
+        //Find or create the profile entry for an AO.
+        uint32 Lookup(PVActiveBase* aActive);
+        //Record one Run call.
+        void Record(uint32 aIndex, const TimeValue& aStart, uint32 aRunUsec, uint32 aLatencyUsec, bool aLeave);
+        //Append the records in a ring buffer to aOut, oldest first.
+        static void CopyRing(const Oscl_Vector<OsclSchedulerRunRecord, OsclMemAllocator>& aRing, uint32 aNext,
+                             Oscl_Vector<OsclSchedulerRunRecord, OsclMemAllocator>& aOut);
+
+        OsclSchedulerProfileConfig iConfig;
+        TimeValue iStartTime;
+
+        Oscl_Vector<OsclSchedulerAOProfile, OsclMemAllocator> iProfile;
+        Oscl_Map<PVActiveBase*, uint32, OsclMemAllocator> iAOMap;
+
+        //outlier and trace ring buffers.
+        Oscl_Vector<OsclSchedulerRunRecord, OsclMemAllocator> iOutliers;
+        uint32 iOutlierNext;
+        Oscl_Vector<OsclSchedulerRunRecord, OsclMemAllocator> iTrace;
+        uint32 iTraceNext;
+        uint32 iTraceCountdown;
+
+        friend class OsclExecSchedulerCommonBase;
+};
+
+#endif
+
+
+/*! @} */
@@ -172,6 +172,8 @@ class TReadyQueLink
             iTimeToRunTicks = 0;
             iSeqNum = 0;
             iIsIn = NULL;
+            iTimeQueuedUsec = 0;
+            iTimeQueuedUsecValid = false;
         }
 
         int32 iAOPriority;//scheduling priority
@@ -179,6 +181,8 @@ class TReadyQueLink
         uint32 iTimeQueuedTicks;//the time when the AO was queued, in ticks.
         uint32 iSeqNum;//sequence number for oscl pri queue.
         OsclAny* iIsIn;//pointer to the queue we're in, cast as a void*
+        uint32 iTimeQueuedUsec;//request completion time in usec, set only when profiling.
+        bool iTimeQueuedUsecValid;
 
 };
 
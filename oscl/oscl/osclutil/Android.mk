@@ -14,6 +14,7 @@ LOCAL_SRC_FILES := \
         src/oscl_rand.cpp \
         src/oscl_string_uri.cpp \
         src/oscl_string_xml.cpp \
+        src/oscl_string_json.cpp \
         src/oscl_priqueue.cpp
 
 
@@ -54,6 +55,7 @@ LOCAL_COPY_HEADERS := \
         src/oscl_math.h \
         src/oscl_math.inl \
         src/oscl_string_uri.h \
-        src/oscl_string_xml.h
+        src/oscl_string_xml.h \
+        src/oscl_string_json.h
 
 include $(BUILD_STATIC_LIBRARY)
@@ -25,6 +25,7 @@ SRCS :=  oscl_bin_stream.cpp \
 	oscl_rand.cpp \
 	oscl_string_uri.cpp \
 	oscl_string_xml.cpp \
+	oscl_string_json.cpp \
 	oscl_priqueue.cpp
 
 
@@ -47,7 +48,8 @@ HDRS :=  oscl_bin_stream.h \
 	oscl_math.h \
 	oscl_math.inl \
 	oscl_string_uri.h \
-	oscl_string_xml.h
+	oscl_string_xml.h \
+	oscl_string_json.h
 
 include $(MK)/library.mk
 
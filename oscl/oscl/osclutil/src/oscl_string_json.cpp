@@ -0,0 +1,55 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+// -*- c++ -*-
+// = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+
+//               O S C L  JSON S T R I N G  FUNCTIONS
+
+// = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+
+// - - Inclusion - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#include "oscl_string_json.h"
+#include "oscl_snprintf.h"
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+OSCL_EXPORT_REF void oscl_str_append_json(OSCL_String& aOut, const char* aStr)
+{
+    char buf[8];
+    aOut += "\"";
+    for (const char* p = aStr; p && *p; p++)
+    {
+        if (*p == '"' || *p == '\\')
+        {
+            buf[0] = '\\';
+            buf[1] = *p;
+            buf[2] = '\0';
+        }
+        else if ((uint8)*p < 0x20)
+        {
+            oscl_snprintf(buf, sizeof(buf), "\\u%04x", (uint8)*p);
+        }
+        else
+        {
+            buf[0] = *p;
+            buf[1] = '\0';
+        }
+        aOut += buf;
+    }
+    aOut += "\"";
+}
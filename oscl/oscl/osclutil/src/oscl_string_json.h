@@ -0,0 +1,62 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+// -*- c++ -*-
+// = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+
+//               O S C L _ S T R I N G _ J S O N
+
+// = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+
+/*! \addtogroup osclutil OSCL Util
+ *
+ * @{
+ */
+
+
+/** \file oscl_string_json.h
+    \brief Utilities to write strings as JSON string values
+*/
+
+
+#ifndef OSCL_STRING_JSON_H
+#define OSCL_STRING_JSON_H
+
+// - - Inclusion - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+#ifndef OSCL_BASE_H_INCLUDED
+#include "oscl_base.h"
+#endif
+
+#ifndef OSCL_STRING_H_INCLUDED
+#include "oscl_string.h"
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Function prototypes
+/*!
+    \brief Append a string to JSON output as a quoted string value.
+           Quotes and backslashes are escaped with a backslash, other
+           control characters are written as \\u00XX.
+
+    \param aOut  String to append to.
+    \param aStr  Null-terminated input string (NULL appends an empty string).
+*/
+OSCL_IMPORT_REF void oscl_str_append_json(OSCL_String& aOut, const char* aStr);
+#endif
+
+
+/*! @} */
@@ -24,6 +24,7 @@ LOCAL_COPY_HEADERS_TO := $(PV_COPY_HEADERS_TO)
 
 LOCAL_COPY_HEADERS := \
 	src/pvlogger_stderr_appender.h \
+ 	src/pvlogger_async_appender.h \
  	src/pvlogger_file_appender.h \
  	src/pvlogger_mem_appender.h \
  	src/pvlogger_time_and_id_layout.h
@@ -15,6 +15,7 @@ INCSRCDIR := ../../src
 SRCS :=	
 
 HDRS := pvlogger_stderr_appender.h \
+	pvlogger_async_appender.h \
 	pvlogger_file_appender.h \
 	pvlogger_mem_appender.h \
 	pvlogger_time_and_id_layout.h
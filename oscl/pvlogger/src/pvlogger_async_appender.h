@@ -0,0 +1,1079 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#ifndef PVLOGGER_ASYNC_APPENDER_H_INCLUDED
+#define PVLOGGER_ASYNC_APPENDER_H_INCLUDED
+
+#ifndef OSCL_MEM_AUTO_PTR_H_INCLUDED
+#include "oscl_mem_auto_ptr.h"
+#endif
+#ifndef OSCL_FILE_IO_H_INCLUDED
+#include "oscl_file_io.h"
+#endif
+#ifndef OSCL_VECTOR_H_INCLUDED
+#include "oscl_vector.h"
+#endif
+#ifndef OSCL_MAP_H_INCLUDED
+#include "oscl_map.h"
+#endif
+#ifndef OSCL_THREAD_H_INCLUDED
+#include "oscl_thread.h"
+#endif
+#ifndef OSCL_SEMAPHORE_H_INCLUDED
+#include "oscl_semaphore.h"
+#endif
+#ifndef OSCL_MUTEX_H_INCLUDED
+#include "oscl_mutex.h"
+#endif
+#ifndef OSCL_TICKCOUNT_H_INCLUDED
+#include "oscl_tickcount.h"
+#endif
+#ifndef OSCL_STDSTRING_H_INCLUDED
+#include "oscl_stdstring.h"
+#endif
+#ifndef OSCL_SNPRINTF_H_INCLUDED
+#include "oscl_snprintf.h"
+#endif
+#ifndef PVLOGGERACCESSORIES_H_INCLUDED
+#include "pvlogger_accessories.h"
+#endif
+
+/**
+ * Binary log file layout written by AsyncBinaryFileAppender.
+ *
+ * The file starts with PVLOGGER_ASYNC_FILE_MAGIC and PVLOGGER_ASYNC_FILE_VERSION
+ * (native byte order, which also lets the decoder detect a byte-order mismatch).
+ * Every record after that starts with a 4-byte header: uint8 type, uint8 reserved,
+ * uint16 total record length.  Record bodies:
+ *
+ *  'F' format string:  uint32 format id, NUL-terminated format string
+ *  'M' message:        uint32 format id, int32 msgID, uint32 msec, uint32 thread id, args
+ *  'B' buffer:         int32 msgID, uint32 msec, uint32 thread id, raw bytes
+ *  'D' dropped:        uint32 thread id, uint32 number of records dropped
+ *                      (thread id 0 for records dropped because no ring was free)
+ *
+ * Each message argument is a one-byte tag followed by its value:
+ * 'i' int32, 'l' int64, 'p' pointer as uint64, 'd' double,
+ * 's' uint16 length followed by the (unterminated) string bytes.
+ * A '*' width or precision is captured as an 'i' argument in format order.
+ *
+ * A format string is written once, the first time it is seen, so messages only
+ * carry the 4-byte id.  PVLoggerAsyncDecoder turns the file back into the text
+ * that TextFileAppender with TimeAndIdLayout would have produced.
+ */
+#define PVLOGGER_ASYNC_FILE_MAGIC           0x4C415650 // "PVAL"
+#define PVLOGGER_ASYNC_FILE_VERSION         1
+#define PVLOGGER_ASYNC_RECORD_HEADER_SIZE   4
+#define PVLOGGER_ASYNC_MAX_RECORD_SIZE      512
+#define PVLOGGER_ASYNC_MAX_STRING_ARG       128
+#define PVLOGGER_ASYNC_DEFAULT_DRAIN_MSEC   50
+#define PVLOGGER_ASYNC_WRITE_BUFFER_SIZE    16384
+
+#define PVLOGGER_ASYNC_RECORD_FORMAT    'F'
+#define PVLOGGER_ASYNC_RECORD_MESSAGE   'M'
+#define PVLOGGER_ASYNC_RECORD_BUFFER    'B'
+#define PVLOGGER_ASYNC_RECORD_DROPPED   'D'
+
+#define PVLOGGER_ASYNC_ARG_INT32    'i'
+#define PVLOGGER_ASYNC_ARG_INT64    'l'
+#define PVLOGGER_ASYNC_ARG_POINTER  'p'
+#define PVLOGGER_ASYNC_ARG_DOUBLE   'd'
+#define PVLOGGER_ASYNC_ARG_STRING   's'
+
+// ring states, see AsyncBinaryFileAppender::ThreadLogoff
+#define PVLOGGER_ASYNC_RING_FREE        0
+#define PVLOGGER_ASYNC_RING_OWNED       1
+#define PVLOGGER_ASYNC_RING_RELEASED    2
+
+/**
+ * Full memory barrier used to publish ring positions between the logging
+ * threads and the drain thread.  OSCL has no atomic primitives, so builds
+ * without a GCC-compatible compiler must provide their own definition.
+ */
+#ifndef PVLOGGER_ASYNC_BARRIER
+#if defined(__GNUC__)
+#define PVLOGGER_ASYNC_BARRIER() __sync_synchronize()
+#else
+#define PVLOGGER_ASYNC_BARRIER()
+#endif
+#endif
+
+/**
+ * Class: AsyncBinaryFileAppender
+ *
+ * Appender that keeps formatting and file I/O off the logging threads.
+ * AppendString only scans the format string to learn the argument types and
+ * copies the format pointer plus the raw argument values into a ring buffer
+ * owned by the calling thread.  Each ring has a single producer (its thread)
+ * and a single consumer (the drain thread), so no lock is taken on the
+ * logging path; a mutex is only used the first time a thread logs, to claim
+ * its ring.  The drain thread wakes every drain period and writes the records
+ * to the log file in the binary layout described above.
+ *
+ * A thread that stops logging, typically right before it exits, calls
+ * ThreadLogoff.  The drain thread writes out what is left in that thread's
+ * ring and then frees the ring for the next thread that logs.  Without it a
+ * ring stays with its thread for the lifetime of the appender.
+ *
+ * When a ring is full, or more than MaxThreads threads hold a ring, records
+ * are dropped and counted rather than blocking the caller.  The counts are
+ * written to the log and returned by GetDroppedCount.  Format strings must
+ * stay valid for the lifetime of the appender, which holds for the string
+ * literals used with PVLOGGER_LOGMSG.  Floating point arguments are captured
+ * but, like oscl_snprintf, only rendered as integers by the decoder.
+ *
+ * RingSize must be a power of two.
+ */
+template < uint32 RingSize = 65536, uint32 MaxThreads = 16 >
+class AsyncBinaryFileAppender : public PVLoggerAppender
+{
+    public:
+        typedef PVLoggerAppender::message_id_type message_id_type;
+
+        static AsyncBinaryFileAppender<RingSize, MaxThreads>* CreateAppender(const OSCL_TCHAR * filename, uint32 drainPeriodMsec = PVLOGGER_ASYNC_DEFAULT_DRAIN_MSEC)
+        {
+            AsyncBinaryFileAppender<RingSize, MaxThreads> * appender = new AsyncBinaryFileAppender<RingSize, MaxThreads>();
+            if (NULL == appender) return NULL;
+
+#ifdef T_ARM
+// Seems like ADS 1.2 compiler crashes if template argument is used as part of another template argument so explicitly declare it.
+            OSCLMemAutoPtr<AsyncBinaryFileAppender<RingSize, MaxThreads>, Oscl_TAlloc<AsyncBinaryFileAppender<RingSize, MaxThreads>, OsclMemAllocator> > holdAppender(appender);
+#else
+            OSCLMemAutoPtr<AsyncBinaryFileAppender<RingSize, MaxThreads> > holdAppender(appender);
+#endif
+
+            if (0 != appender->_fs.Connect()) return NULL;
+
+            //set log file object options
+            //this has its own cache so there's no reason to use pv cache.
+            appender->_logFile.SetPVCacheSize(0);
+            //make sure there's no logging on this file or we get infinite loop!
+            appender->_logFile.SetLoggingEnable(false);
+            appender->_logFile.SetSummaryStatsLoggingEnable(false);
+            //end of log file object options.
+
+            if (0 != appender->_logFile.Open(filename,
+                                             Oscl_File::MODE_READWRITE | Oscl_File::MODE_BINARY,
+                                             appender->_fs))
+            {
+                return NULL;
+            }
+            appender->_fileOpen = true;
+
+            appender->_writeBuf = (uint8*)OSCL_DEFAULT_MALLOC(PVLOGGER_ASYNC_WRITE_BUFFER_SIZE);
+            if (NULL == appender->_writeBuf) return NULL;
+
+            uint32 fileHeader[2];
+            fileHeader[0] = PVLOGGER_ASYNC_FILE_MAGIC;
+            fileHeader[1] = PVLOGGER_ASYNC_FILE_VERSION;
+            appender->_logFile.Write(fileHeader, sizeof(uint8), sizeof(fileHeader));
+
+            appender->_drainPeriodMsec = drainPeriodMsec;
+            if (OsclProcStatus::SUCCESS_ERROR != appender->_slotLock.Create() ||
+                    OsclProcStatus::SUCCESS_ERROR != appender->_wakeSem.Create(0))
+            {
+                return NULL;
+            }
+            if (OsclProcStatus::SUCCESS_ERROR != appender->_drainThread.Create(DrainThreadFunc, 0, (TOsclThreadFuncArg)appender, Start_on_creation, true))
+            {
+                return NULL;
+            }
+            appender->_threadRunning = true;
+
+            return holdAppender.release();
+        }
+
+        virtual ~AsyncBinaryFileAppender()
+        {
+            if (_threadRunning)
+            {
+                _stopRequested = true;
+                PVLOGGER_ASYNC_BARRIER();
+                _wakeSem.Signal();
+                _drainThread.Terminate(NULL);
+            }
+
+            //pick up anything logged after the drain thread's last pass.
+            if (_fileOpen && _writeBuf)
+            {
+                Drain();
+            }
+            if (_threadRunning)
+            {
+                _slotLock.Close();
+                _wakeSem.Close();
+            }
+            if (_fileOpen)
+            {
+                _logFile.Close();
+            }
+            _fs.Close();
+
+            for (uint32 i = 0; i < MaxThreads; i++)
+            {
+                if (_rings[i].iBuffer)
+                    OSCL_DEFAULT_FREE(_rings[i].iBuffer);
+            }
+            if (_writeBuf)
+                OSCL_DEFAULT_FREE(_writeBuf);
+        }
+
+        void AppendString(message_id_type msgID, const char *fmt, va_list va)
+        {
+            Ring* ring = GetRing();
+            if (!ring)
+                return;
+
+            uint8 record[PVLOGGER_ASYNC_MAX_RECORD_SIZE];
+            uint32 len = PVLOGGER_ASYNC_RECORD_HEADER_SIZE;
+            oscl_memcpy(record + len, &fmt, sizeof(fmt));
+            len += sizeof(fmt);
+            len += PutMessageStamp(record + len, msgID);
+            len += CaptureArgs(record + len, PVLOGGER_ASYNC_MAX_RECORD_SIZE - len, fmt, va);
+
+            Publish(ring, PVLOGGER_ASYNC_RECORD_MESSAGE, record, len);
+        }
+
+        void AppendBuffers(message_id_type msgID, int32 numPairs, va_list va)
+        {
+            Ring* ring = GetRing();
+
+            for (int32 i = 0; i < numPairs; i++)
+            {
+                int32 length = va_arg(va, int32);
+                uint8* buffer = va_arg(va, uint8*);
+
+                //large buffers are split across several records.
+                while (ring && length > 0)
+                {
+                    uint8 record[PVLOGGER_ASYNC_MAX_RECORD_SIZE];
+                    uint32 len = PVLOGGER_ASYNC_RECORD_HEADER_SIZE;
+                    len += PutMessageStamp(record + len, msgID);
+
+                    uint32 chunk = PVLOGGER_ASYNC_MAX_RECORD_SIZE - len;
+                    if ((uint32)length < chunk)
+                        chunk = length;
+                    oscl_memcpy(record + len, buffer, chunk);
+                    len += chunk;
+                    buffer += chunk;
+                    length -= chunk;
+
+                    Publish(ring, PVLOGGER_ASYNC_RECORD_BUFFER, record, len);
+                }
+            }
+            va_end(va);
+        }
+
+        /**
+         * Hands the calling thread's ring back.  The drain thread frees the
+         * ring once it has written out the remaining records.  The thread
+         * gets a new ring if it logs again afterwards.
+         */
+        void ThreadLogoff()
+        {
+            TOsclThreadId threadId;
+            OsclThread::GetId(threadId);
+
+            _slotLock.Lock();
+            for (uint32 i = 0; i < _numRings; i++)
+            {
+                if (PVLOGGER_ASYNC_RING_OWNED == _rings[i].iState &&
+                        OsclThread::CompareId(_rings[i].iOwner, threadId))
+                {
+                    PVLOGGER_ASYNC_BARRIER();
+                    _rings[i].iState = PVLOGGER_ASYNC_RING_RELEASED;
+                }
+            }
+            _slotLock.Unlock();
+        }
+
+        /**
+         * Returns the number of records dropped so far because a ring was
+         * full or no ring was free.
+         */
+        uint32 GetDroppedCount()
+        {
+            uint32 dropped = _unownedDropped;
+            for (uint32 i = 0; i < _numRings; i++)
+            {
+                dropped += _rings[i].iDropped;
+            }
+            return dropped;
+        }
+
+        AsyncBinaryFileAppender()
+        {
+            for (uint32 i = 0; i < MaxThreads; i++)
+            {
+                _rings[i].iState = PVLOGGER_ASYNC_RING_FREE;
+                _rings[i].iThreadTag = 0;
+                _rings[i].iWritePos = 0;
+                _rings[i].iReadPos = 0;
+                _rings[i].iDropped = 0;
+                _rings[i].iDroppedReported = 0;
+                _rings[i].iBuffer = NULL;
+            }
+            _numRings = 0;
+            _unownedDropped = 0;
+            _unownedDroppedReported = 0;
+            _stopRequested = false;
+            _threadRunning = false;
+            _fileOpen = false;
+            _writeBuf = NULL;
+            _writeLen = 0;
+            _drainPeriodMsec = PVLOGGER_ASYNC_DEFAULT_DRAIN_MSEC;
+            _tickBase = OsclTickCount::TickCount();
+        }
+
+    private:
+        struct Ring
+        {
+            // changed under _slotLock; OWNED to RELEASED by the owner,
+            // RELEASED to FREE by the drain thread, FREE to OWNED by the
+            // next thread that logs
+            volatile uint32 iState;
+            TOsclThreadId iOwner;
+            uint32 iThreadTag;
+            // written by the owning thread only
+            volatile uint32 iWritePos;
+            volatile uint32 iDropped;
+            // written by the drain thread only
+            volatile uint32 iReadPos;
+            uint32 iDroppedReported;
+            uint8* iBuffer;
+        };
+
+        Ring* GetRing()
+        {
+            TOsclThreadId threadId;
+            OsclThread::GetId(threadId);
+
+            uint32 numRings = _numRings;
+            PVLOGGER_ASYNC_BARRIER();
+            for (uint32 i = 0; i < numRings; i++)
+            {
+                if (PVLOGGER_ASYNC_RING_OWNED == _rings[i].iState)
+                {
+                    PVLOGGER_ASYNC_BARRIER();
+                    if (OsclThread::CompareId(_rings[i].iOwner, threadId))
+                        return &_rings[i];
+                }
+            }
+
+            //first message from this thread: claim a ring, reusing a
+            //freed one if there is one.
+            Ring* ring = NULL;
+            _slotLock.Lock();
+            for (uint32 j = numRings; j < _numRings; j++)
+            {
+                if (PVLOGGER_ASYNC_RING_OWNED == _rings[j].iState &&
+                        OsclThread::CompareId(_rings[j].iOwner, threadId))
+                    ring = &_rings[j];
+            }
+            for (uint32 k = 0; !ring && k < _numRings; k++)
+            {
+                if (PVLOGGER_ASYNC_RING_FREE == _rings[k].iState)
+                {
+                    ring = &_rings[k];
+                    ring->iOwner = threadId;
+                    ring->iThreadTag = (uint32)threadId;
+                    PVLOGGER_ASYNC_BARRIER();
+                    ring->iState = PVLOGGER_ASYNC_RING_OWNED;
+                }
+            }
+            if (!ring && _numRings < MaxThreads)
+            {
+                Ring& newRing = _rings[_numRings];
+                newRing.iBuffer = (uint8*)OSCL_DEFAULT_MALLOC(RingSize);
+                if (newRing.iBuffer)
+                {
+                    newRing.iOwner = threadId;
+                    newRing.iThreadTag = (uint32)threadId;
+                    newRing.iState = PVLOGGER_ASYNC_RING_OWNED;
+                    ring = &newRing;
+                    PVLOGGER_ASYNC_BARRIER();
+                    _numRings++;
+                }
+            }
+            if (!ring)
+                _unownedDropped++;
+            _slotLock.Unlock();
+            return ring;
+        }
+
+        uint32 PutMessageStamp(uint8* dst, message_id_type msgID)
+        {
+            uint32 msec = OsclTickCount::TicksToMsec(OsclTickCount::TickCount() - _tickBase);
+            oscl_memcpy(dst, &msgID, sizeof(int32));
+            oscl_memcpy(dst + 4, &msec, sizeof(uint32));
+            // the thread id is filled in from the ring by the drain thread.
+            oscl_memset(dst + 8, 0, sizeof(uint32));
+            return 12;
+        }
+
+        // Walks the format string the same way oscl_snprintf does and copies
+        // the raw argument values.  Stops early when the record is full; the
+        // decoder prints the missing conversions as "<?>".
+        static uint32 CaptureArgs(uint8* dst, uint32 maxLen, const char* fmt, va_list va)
+        {
+            uint32 len = 0;
+            const char* p = fmt;
+            while (*p)
+            {
+                if (*p++ != '%')
+                    continue;
+                if (*p == '%')
+                {
+                    p++;
+                    continue;
+                }
+                while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0')
+                    p++;
+                for (int32 field = 0; field < 2; field++)
+                {
+                    if (*p == '*')
+                    {
+                        int32 star = va_arg(va, int32);
+                        if (!PutArg(dst, len, maxLen, PVLOGGER_ASYNC_ARG_INT32, &star, sizeof(star)))
+                            return len;
+                        p++;
+                    }
+                    else
+                    {
+                        while (*p >= '0' && *p <= '9')
+                            p++;
+                    }
+                    if (field == 0 && *p == '.')
+                        p++;
+                    else
+                        break;
+                }
+                int32 longs = 0;
+                while (*p == 'h' || *p == 'l' || *p == 'L' || *p == 'q' || *p == 'j' || *p == 'z' || *p == 't')
+                {
+                    longs += (*p == 'l') ? 1 : ((*p == 'h') ? 0 : 2);
+                    p++;
+                }
+
+                bool ok = true;
+                switch (*p)
+                {
+                    case 'D':
+                    case 'U':
+                    case 'O':
+                        if (longs == 0)
+                            longs = 1;
+                        // fall through
+                    case 'd':
+                    case 'i':
+                    case 'u':
+                    case 'o':
+                    case 'x':
+                    case 'X':
+                    case 'c':
+                        if (longs >= 2 || (longs == 1 && sizeof(long) == sizeof(int64)))
+                        {
+                            int64 value = (longs >= 2) ? va_arg(va, int64) : (int64)va_arg(va, long);
+                            ok = PutArg(dst, len, maxLen, PVLOGGER_ASYNC_ARG_INT64, &value, sizeof(value));
+                        }
+                        else
+                        {
+                            int32 value = (longs == 1) ? (int32)va_arg(va, long) : va_arg(va, int32);
+                            ok = PutArg(dst, len, maxLen, PVLOGGER_ASYNC_ARG_INT32, &value, sizeof(value));
+                        }
+                        break;
+                    case 'p':
+                    {
+                        OsclAny* ptr = va_arg(va, OsclAny*);
+                        uint64 value = 0;
+                        oscl_memcpy(&value, &ptr, sizeof(ptr));
+                        ok = PutArg(dst, len, maxLen, PVLOGGER_ASYNC_ARG_POINTER, &value, sizeof(value));
+                    }
+                    break;
+                    case 'e':
+                    case 'E':
+                    case 'f':
+                    case 'F':
+                    case 'g':
+                    case 'G':
+                    {
+                        double value = va_arg(va, double);
+                        ok = PutArg(dst, len, maxLen, PVLOGGER_ASYNC_ARG_DOUBLE, &value, sizeof(value));
+                    }
+                    break;
+                    case 's':
+                    {
+                        const char* str = va_arg(va, const char*);
+                        if (!str)
+                            str = "(null)";
+                        uint16 strLen = 0;
+                        while (strLen < PVLOGGER_ASYNC_MAX_STRING_ARG && str[strLen])
+                            strLen++;
+                        if (len + 1 + sizeof(uint16) > maxLen)
+                            return len;
+                        if (len + 1 + sizeof(uint16) + strLen > maxLen)
+                            strLen = (uint16)(maxLen - len - 1 - sizeof(uint16));
+                        dst[len++] = PVLOGGER_ASYNC_ARG_STRING;
+                        oscl_memcpy(dst + len, &strLen, sizeof(uint16));
+                        len += sizeof(uint16);
+                        oscl_memcpy(dst + len, str, strLen);
+                        len += strLen;
+                    }
+                    break;
+                    case 'n':
+                        (void)va_arg(va, OsclAny*);
+                        break;
+                    case '\0':
+                        return len;
+                    default:
+                        break;
+                }
+                if (!ok)
+                    return len;
+                p++;
+            }
+            return len;
+        }
+
+        static bool PutArg(uint8* dst, uint32& len, uint32 maxLen, uint8 tag, const OsclAny* value, uint32 size)
+        {
+            if (len + 1 + size > maxLen)
+                return false;
+            dst[len++] = tag;
+            oscl_memcpy(dst + len, value, size);
+            len += size;
+            return true;
+        }
+
+        // Producer side.  Only the owning thread calls this for a given ring.
+        void Publish(Ring* ring, uint8 type, uint8* record, uint32 len)
+        {
+            uint16 recordLen = (uint16)len;
+            record[0] = type;
+            record[1] = 0;
+            oscl_memcpy(record + 2, &recordLen, sizeof(uint16));
+
+            uint32 writePos = ring->iWritePos;
+            uint32 readPos = ring->iReadPos;
+            PVLOGGER_ASYNC_BARRIER();
+            if (RingSize - (writePos - readPos) < len)
+            {
+                ring->iDropped++;
+                return;
+            }
+            RingCopy(ring->iBuffer, writePos, record, len, true);
+            PVLOGGER_ASYNC_BARRIER();
+            ring->iWritePos = writePos + len;
+        }
+
+        static void RingCopy(uint8* ringBuf, uint32 pos, uint8* data, uint32 len, bool toRing)
+        {
+            uint32 offset = pos & (RingSize - 1);
+            uint32 first = RingSize - offset;
+            if (first > len)
+                first = len;
+            if (toRing)
+            {
+                oscl_memcpy(ringBuf + offset, data, first);
+                oscl_memcpy(ringBuf, data + first, len - first);
+            }
+            else
+            {
+                oscl_memcpy(data, ringBuf + offset, first);
+                oscl_memcpy(data + first, ringBuf, len - first);
+            }
+        }
+
+        // Consumer side.  Called from the drain thread, and once more from the
+        // destructor after the drain thread has exited.
+        void Drain()
+        {
+            uint32 numRings = _numRings;
+            PVLOGGER_ASYNC_BARRIER();
+            for (uint32 i = 0; i < numRings; i++)
+            {
+                Ring& ring = _rings[i];
+                // read the state first: once a released ring is seen, its
+                // write position no longer moves.
+                uint32 state = ring.iState;
+                PVLOGGER_ASYNC_BARRIER();
+                if (PVLOGGER_ASYNC_RING_FREE == state)
+                    continue;
+                uint32 readPos = ring.iReadPos;
+                uint32 writePos = ring.iWritePos;
+                PVLOGGER_ASYNC_BARRIER();
+
+                while (readPos != writePos)
+                {
+                    uint8 record[PVLOGGER_ASYNC_MAX_RECORD_SIZE];
+                    uint16 recordLen;
+                    RingCopy(ring.iBuffer, readPos, record, PVLOGGER_ASYNC_RECORD_HEADER_SIZE, false);
+                    oscl_memcpy(&recordLen, record + 2, sizeof(uint16));
+                    RingCopy(ring.iBuffer, readPos, record, recordLen, false);
+                    readPos += recordLen;
+
+                    WriteRecord(ring, record, recordLen);
+                }
+                PVLOGGER_ASYNC_BARRIER();
+                ring.iReadPos = readPos;
+
+                uint32 dropped = ring.iDropped;
+                if (dropped != ring.iDroppedReported)
+                {
+                    uint8 record[PVLOGGER_ASYNC_RECORD_HEADER_SIZE + 8];
+                    uint32 count = dropped - ring.iDroppedReported;
+                    oscl_memcpy(record + 4, &ring.iThreadTag, sizeof(uint32));
+                    oscl_memcpy(record + 8, &count, sizeof(uint32));
+                    WriteOut(PVLOGGER_ASYNC_RECORD_DROPPED, record, sizeof(record));
+                    ring.iDroppedReported = dropped;
+                }
+
+                if (PVLOGGER_ASYNC_RING_RELEASED == state)
+                {
+                    // the owner logged off and everything it wrote is out.
+                    _slotLock.Lock();
+                    ring.iState = PVLOGGER_ASYNC_RING_FREE;
+                    _slotLock.Unlock();
+                }
+            }
+
+            uint32 unownedDropped = _unownedDropped;
+            if (unownedDropped != _unownedDroppedReported)
+            {
+                uint8 record[PVLOGGER_ASYNC_RECORD_HEADER_SIZE + 8];
+                uint32 noThread = 0;
+                uint32 count = unownedDropped - _unownedDroppedReported;
+                oscl_memcpy(record + 4, &noThread, sizeof(uint32));
+                oscl_memcpy(record + 8, &count, sizeof(uint32));
+                WriteOut(PVLOGGER_ASYNC_RECORD_DROPPED, record, sizeof(record));
+                _unownedDroppedReported = unownedDropped;
+            }
+
+            if (_writeLen)
+            {
+                _logFile.Write(_writeBuf, sizeof(uint8), _writeLen);
+                _logFile.Flush();
+                _writeLen = 0;
+            }
+        }
+
+        // Translates a ring record into its file form: the format pointer is
+        // replaced by a format id and the owning thread id is filled in.
+        void WriteRecord(Ring& ring, uint8* record, uint32 recordLen)
+        {
+            if (PVLOGGER_ASYNC_RECORD_BUFFER == record[0])
+            {
+                oscl_memcpy(record + PVLOGGER_ASYNC_RECORD_HEADER_SIZE + 8, &ring.iThreadTag, sizeof(uint32));
+                WriteOut(PVLOGGER_ASYNC_RECORD_BUFFER, record, recordLen);
+                return;
+            }
+
+            const char* fmt;
+            oscl_memcpy(&fmt, record + PVLOGGER_ASYNC_RECORD_HEADER_SIZE, sizeof(fmt));
+
+            uint32 formatId;
+            Oscl_Map<const char*, uint32, OsclMemAllocator>::iterator it = _formatIds.find(fmt);
+            if (it != _formatIds.end())
+            {
+                formatId = it->second;
+            }
+            else
+            {
+                formatId = _formatIds.size();
+                _formatIds[fmt] = formatId;
+
+                uint8 formatRecord[PVLOGGER_ASYNC_MAX_RECORD_SIZE];
+                uint32 fmtLen = oscl_strlen(fmt);
+                if (fmtLen > PVLOGGER_ASYNC_MAX_RECORD_SIZE - PVLOGGER_ASYNC_RECORD_HEADER_SIZE - 5)
+                    fmtLen = PVLOGGER_ASYNC_MAX_RECORD_SIZE - PVLOGGER_ASYNC_RECORD_HEADER_SIZE - 5;
+                oscl_memcpy(formatRecord + 4, &formatId, sizeof(uint32));
+                oscl_memcpy(formatRecord + 8, fmt, fmtLen);
+                formatRecord[8 + fmtLen] = 0;
+                WriteOut(PVLOGGER_ASYNC_RECORD_FORMAT, formatRecord, 9 + fmtLen);
+            }
+
+            // drop the pointer down to a 4-byte id; on 32-bit targets this is a no-op.
+            uint32 shift = sizeof(fmt) - sizeof(uint32);
+            uint8* out = record + shift;
+            oscl_memcpy(out + 4, &formatId, sizeof(uint32));
+            oscl_memcpy(out + 16, &ring.iThreadTag, sizeof(uint32));
+            WriteOut(PVLOGGER_ASYNC_RECORD_MESSAGE, out, recordLen - shift);
+        }
+
+        void WriteOut(uint8 type, uint8* record, uint32 len)
+        {
+            uint16 recordLen = (uint16)len;
+            record[0] = type;
+            record[1] = 0;
+            oscl_memcpy(record + 2, &recordLen, sizeof(uint16));
+
+            if (_writeLen + len > PVLOGGER_ASYNC_WRITE_BUFFER_SIZE)
+            {
+                _logFile.Write(_writeBuf, sizeof(uint8), _writeLen);
+                _writeLen = 0;
+            }
+            oscl_memcpy(_writeBuf + _writeLen, record, len);
+            _writeLen += len;
+        }
+
+        static TOsclThreadFuncRet OSCL_THREAD_DECL DrainThreadFunc(TOsclThreadFuncArg arg)
+        {
+            AsyncBinaryFileAppender<RingSize, MaxThreads>* appender = (AsyncBinaryFileAppender<RingSize, MaxThreads>*)arg;
+            for (;;)
+            {
+                appender->_wakeSem.Wait(appender->_drainPeriodMsec);
+                PVLOGGER_ASYNC_BARRIER();
+                if (appender->_stopRequested)
+                    break;
+                appender->Drain();
+            }
+            return 0;
+        }
+
+#ifdef T_ARM
+//ADS 1.2 compiler doesn't interpret this correctly.
+    public:
+#else
+    private:
+#endif
+        Oscl_FileServer _fs;
+        Oscl_File _logFile;
+
+    private:
+        Ring _rings[MaxThreads];
+        volatile uint32 _numRings;
+        volatile uint32 _unownedDropped;
+        uint32 _unownedDroppedReported;
+        volatile bool _stopRequested;
+        bool _threadRunning;
+        bool _fileOpen;
+        uint32 _drainPeriodMsec;
+        uint32 _tickBase;
+
+        // drain thread state
+        uint8* _writeBuf;
+        uint32 _writeLen;
+        Oscl_Map<const char*, uint32, OsclMemAllocator> _formatIds;
+
+        OsclMutex _slotLock;
+        OsclSemaphore _wakeSem;
+        OsclThread _drainThread;
+};
+
+/**
+ * Class: PVLoggerAsyncDecoder
+ *
+ * Offline decoder for files written by AsyncBinaryFileAppender.  Produces the
+ * same "PVLOG:TID(0x..):Time=..:" text lines as TimeAndIdLayout, formatting
+ * each conversion with oscl_snprintf.  Meant to be called from a test app or
+ * a small host-side tool, not from the logging process itself.
+ */
+class PVLoggerAsyncDecoder
+{
+    public:
+        /**
+         * Decodes aBinaryFile into the text file aTextFile.
+         * @return number of records decoded, or -1 if a file can't be opened
+         *         or the input is not an async log file.
+         */
+        static int32 DecodeFile(const OSCL_TCHAR* aBinaryFile, const OSCL_TCHAR* aTextFile)
+        {
+            Oscl_FileServer fs;
+            if (0 != fs.Connect()) return -1;
+
+            Oscl_File inFile;
+            inFile.SetPVCacheSize(0);
+            inFile.SetLoggingEnable(false);
+            if (0 != inFile.Open(aBinaryFile, Oscl_File::MODE_READ | Oscl_File::MODE_BINARY, fs))
+            {
+                fs.Close();
+                return -1;
+            }
+            uint32 size = (uint32)inFile.Size();
+            uint8* data = (uint8*)OSCL_DEFAULT_MALLOC(size ? size : 1);
+            if (!data || inFile.Read(data, sizeof(uint8), size) != size)
+            {
+                if (data)
+                    OSCL_DEFAULT_FREE(data);
+                inFile.Close();
+                fs.Close();
+                return -1;
+            }
+            inFile.Close();
+
+            Oscl_File outFile;
+            outFile.SetPVCacheSize(0);
+            outFile.SetLoggingEnable(false);
+            if (0 != outFile.Open(aTextFile, Oscl_File::MODE_READWRITE | Oscl_File::MODE_TEXT, fs))
+            {
+                OSCL_DEFAULT_FREE(data);
+                fs.Close();
+                return -1;
+            }
+
+            int32 records = Decode(data, size, outFile);
+
+            outFile.Close();
+            fs.Close();
+            OSCL_DEFAULT_FREE(data);
+            return records;
+        }
+
+    private:
+        static int32 Decode(const uint8* data, uint32 size, Oscl_File& out)
+        {
+            uint32 fileHeader[2];
+            if (size < sizeof(fileHeader))
+                return -1;
+            oscl_memcpy(fileHeader, data, sizeof(fileHeader));
+            if (fileHeader[0] != PVLOGGER_ASYNC_FILE_MAGIC || fileHeader[1] != PVLOGGER_ASYNC_FILE_VERSION)
+                return -1;
+
+            Oscl_Vector<const char*, OsclMemAllocator> formats;
+            char line[1024];
+            int32 records = 0;
+            uint32 pos = sizeof(fileHeader);
+
+            while (pos + PVLOGGER_ASYNC_RECORD_HEADER_SIZE <= size)
+            {
+                const uint8* record = data + pos;
+                uint16 recordLen;
+                oscl_memcpy(&recordLen, record + 2, sizeof(uint16));
+                if (recordLen < PVLOGGER_ASYNC_RECORD_HEADER_SIZE || pos + recordLen > size)
+                    break;
+                pos += recordLen;
+                records++;
+
+                uint32 word[3];
+                int32 lineLen = 0;
+                switch (record[0])
+                {
+                    case PVLOGGER_ASYNC_RECORD_FORMAT:
+                        oscl_memcpy(word, record + 4, sizeof(uint32));
+                        while (formats.size() <= word[0])
+                            formats.push_back(NULL);
+                        formats[word[0]] = (const char*)(record + 8);
+                        continue;
+
+                    case PVLOGGER_ASYNC_RECORD_DROPPED:
+                        oscl_memcpy(word, record + 4, 2 * sizeof(uint32));
+                        lineLen = oscl_snprintf(line, sizeof(line), "PVLOG:TID(0x%x):%d messages dropped", word[0], word[1]);
+                        break;
+
+                    case PVLOGGER_ASYNC_RECORD_BUFFER:
+                    {
+                        oscl_memcpy(word, record + 4, 3 * sizeof(uint32));
+                        lineLen = oscl_snprintf(line, sizeof(line), "PVLOG:TID(0x%x):Time=%d:", word[2], word[1]);
+                        for (uint32 i = 16; i < recordLen && lineLen < (int32)sizeof(line) - 4; i++)
+                        {
+                            lineLen += oscl_snprintf(line + lineLen, sizeof(line) - lineLen, " %x", record[i]);
+                        }
+                    }
+                    break;
+
+                    case PVLOGGER_ASYNC_RECORD_MESSAGE:
+                    {
+                        uint32 formatId;
+                        oscl_memcpy(&formatId, record + 4, sizeof(uint32));
+                        oscl_memcpy(word, record + 8, 3 * sizeof(uint32));
+                        lineLen = oscl_snprintf(line, sizeof(line), "PVLOG:TID(0x%x):Time=%d:", word[2], word[1]);
+                        const char* fmt = (formatId < formats.size()) ? formats[formatId] : NULL;
+                        if (fmt)
+                        {
+                            lineLen += FormatMessage(line + lineLen, sizeof(line) - lineLen, fmt, record + 20, recordLen - 20);
+                        }
+                    }
+                    break;
+
+                    default:
+                        continue;
+                }
+
+                if (lineLen > (int32)sizeof(line) - 1)
+                    lineLen = sizeof(line) - 1;
+                char newline[2];
+                newline[0] = 0x0D;
+                newline[1] = 0x0A;
+                out.Write(line, sizeof(char), lineLen);
+                out.Write(newline, sizeof(char), 2);
+            }
+            return records;
+        }
+
+        // Re-runs the format string one conversion at a time, pulling the
+        // captured values in order.  Length modifiers are rebuilt from the
+        // captured type so the output doesn't depend on the host's long size.
+        static int32 FormatMessage(char* buf, int32 bufSize, const char* fmt, const uint8* args, uint32 argsLen)
+        {
+            int32 len = 0;
+            uint32 argPos = 0;
+            const char* p = fmt;
+
+            while (*p && len < bufSize - 1)
+            {
+                if (*p != '%')
+                {
+                    buf[len++] = *p++;
+                    continue;
+                }
+                if (p[1] == '%')
+                {
+                    buf[len++] = '%';
+                    p += 2;
+                    continue;
+                }
+
+                char spec[48];
+                int32 specLen = 0;
+                spec[specLen++] = *p++;
+                while ((*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0') && specLen < 8)
+                    spec[specLen++] = *p++;
+                for (int32 field = 0; field < 2; field++)
+                {
+                    if (*p == '*')
+                    {
+                        int32 star = 0;
+                        uint8 tag = NextArg(args, argsLen, argPos, &star, sizeof(star));
+                        if (tag != PVLOGGER_ASYNC_ARG_INT32)
+                            star = 0;
+                        specLen += oscl_snprintf(spec + specLen, 12, "%d", star);
+                        p++;
+                    }
+                    else
+                    {
+                        while (*p >= '0' && *p <= '9' && specLen < 32)
+                            spec[specLen++] = *p++;
+                    }
+                    if (field == 0 && *p == '.')
+                        spec[specLen++] = *p++;
+                    else
+                        break;
+                }
+                while (*p == 'h' || *p == 'l' || *p == 'L' || *p == 'q' || *p == 'j' || *p == 'z' || *p == 't')
+                    p++;
+                char conv = *p;
+                if (!conv)
+                    break;
+                p++;
+                if (conv == 'D' || conv == 'U' || conv == 'O')
+                    conv = conv - 'A' + 'a';
+                if (conv == 'n')
+                    continue;
+
+                int32 room = bufSize - len;
+                uint8 value[PVLOGGER_ASYNC_MAX_STRING_ARG + 1];
+                uint8 tag = NextArg(args, argsLen, argPos, value, sizeof(value));
+                switch (tag)
+                {
+                    case PVLOGGER_ASYNC_ARG_INT32:
+                    {
+                        int32 v;
+                        oscl_memcpy(&v, value, sizeof(v));
+                        spec[specLen++] = conv;
+                        spec[specLen] = 0;
+                        len += oscl_snprintf(buf + len, room, spec, v);
+                    }
+                    break;
+                    case PVLOGGER_ASYNC_ARG_INT64:
+                    {
+                        int64 v;
+                        oscl_memcpy(&v, value, sizeof(v));
+                        spec[specLen++] = 'l';
+                        spec[specLen++] = conv;
+                        spec[specLen] = 0;
+                        len += oscl_snprintf(buf + len, room, spec, (long)v);
+                    }
+                    break;
+                    case PVLOGGER_ASYNC_ARG_POINTER:
+                    {
+                        uint64 v;
+                        oscl_memcpy(&v, value, sizeof(v));
+                        len += oscl_snprintf(buf + len, room, "0x%lx", (unsigned long)v);
+                    }
+                    break;
+                    case PVLOGGER_ASYNC_ARG_DOUBLE:
+                    {
+                        double v;
+                        oscl_memcpy(&v, value, sizeof(v));
+                        len += oscl_snprintf(buf + len, room, "%d", (int32)v);
+                    }
+                    break;
+                    case PVLOGGER_ASYNC_ARG_STRING:
+                        spec[specLen++] = 's';
+                        spec[specLen] = 0;
+                        len += oscl_snprintf(buf + len, room, spec, (char*)value);
+                        break;
+                    default:
+                        len += oscl_snprintf(buf + len, room, "<?>");
+                        break;
+                }
+                if (len > bufSize - 1)
+                    len = bufSize - 1;
+            }
+            return len;
+        }
+
+        // Copies the next argument value into aValue and returns its tag, or
+        // 0 when the captured arguments are exhausted.  Strings come back
+        // NUL-terminated.
+        static uint8 NextArg(const uint8* args, uint32 argsLen, uint32& argPos, OsclAny* aValue, uint32 aValueSize)
+        {
+            if (argPos >= argsLen)
+                return 0;
+            uint8 tag = args[argPos++];
+            uint32 size;
+            switch (tag)
+            {
+                case PVLOGGER_ASYNC_ARG_INT32:
+                    size = 4;
+                    break;
+                case PVLOGGER_ASYNC_ARG_INT64:
+                case PVLOGGER_ASYNC_ARG_POINTER:
+                case PVLOGGER_ASYNC_ARG_DOUBLE:
+                    size = 8;
+                    break;
+                case PVLOGGER_ASYNC_ARG_STRING:
+                {
+                    uint16 strLen;
+                    if (argPos + sizeof(uint16) > argsLen)
+                        return 0;
+                    oscl_memcpy(&strLen, args + argPos, sizeof(uint16));
+                    argPos += sizeof(uint16);
+                    if (argPos + strLen > argsLen)
+                        return 0;
+                    uint32 copyLen = (strLen < aValueSize) ? strLen : aValueSize - 1;
+                    oscl_memcpy(aValue, args + argPos, copyLen);
+                    ((uint8*)aValue)[copyLen] = 0;
+                    argPos += strLen;
+                    return tag;
+                }
+                default:
+                    argPos = argsLen;
+                    return 0;
+            }
+            if (argPos + size > argsLen || size > aValueSize)
+            {
+                argPos = argsLen;
+                return 0;
+            }
+            oscl_memcpy(aValue, args + argPos, size);
+            argPos += size;
+            return tag;
+        }
+};
+
+#endif // PVLOGGER_ASYNC_APPENDER_H_INCLUDED
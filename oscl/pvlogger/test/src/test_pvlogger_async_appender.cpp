@@ -0,0 +1,266 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+// Checks AsyncBinaryFileAppender end to end: messages logged from several
+// threads come back from PVLoggerAsyncDecoder, a ring handed back with
+// ThreadLogoff is reused by the next thread, and records that can't be
+// stored are counted and reported in the log rather than lost silently.
+
+#include "stdio.h"
+#include "oscl_base.h"
+#include "oscl_mem.h"
+#include "oscl_error.h"
+#include "oscl_stdstring.h"
+#include "oscl_thread.h"
+#include "oscl_semaphore.h"
+#include "pvlogger.h"
+#include "pvlogger_async_appender.h"
+
+#define TEST_MSGS_PER_THREAD    20
+#define TEST_NUM_THREADS        6
+#define TEST_MAX_THREADS        2
+#define TEST_RING_SIZE          4096
+#define TEST_DRAIN_MSEC         5
+// long enough for several drain passes
+#define TEST_SETTLE_MSEC        100
+
+#define TEST_BINARY_FILE    _STRLIT_WCHAR("test_pvlogger_async.bin")
+#define TEST_TEXT_FILE      _STRLIT_WCHAR("test_pvlogger_async.txt")
+#define TEST_TEXT_FILE_NAME "test_pvlogger_async.txt"
+
+typedef AsyncBinaryFileAppender<TEST_RING_SIZE, TEST_MAX_THREADS> TestAppender;
+
+static void TestLog(TestAppender* aAppender, const char* aFmt, ...)
+{
+    va_list args;
+    va_start(args, aFmt);
+    aAppender->AppendString(0, aFmt, args);
+    va_end(args);
+}
+
+struct TestLoggerArg
+{
+    TestAppender* iAppender;
+    uint32 iIndex;
+    uint32 iNumMsgs;
+    bool iLogoff;
+    OsclSemaphore* iDoneSem;
+    OsclSemaphore* iExitSem;
+};
+
+static TOsclThreadFuncRet OSCL_THREAD_DECL TestLoggerThread(TOsclThreadFuncArg aArg)
+{
+    TestLoggerArg* arg = (TestLoggerArg*)aArg;
+    for (uint32 i = 0; i < arg->iNumMsgs; i++)
+    {
+        TestLog(arg->iAppender, "thread %d message %d of %s", arg->iIndex, i, "test");
+    }
+    if (arg->iLogoff)
+    {
+        arg->iAppender->ThreadLogoff();
+    }
+    arg->iDoneSem->Signal();
+    // stay alive until every thread has logged so that no two of them
+    // share a thread id
+    arg->iExitSem->Wait();
+    return 0;
+}
+
+// Runs aNumThreads logging threads one after the other, letting the drain
+// thread catch up in between.  All threads are kept alive until the last
+// one is done.  Returns false if a thread can't be started.
+static bool RunLoggerThreads(TestAppender* aAppender, uint32 aNumThreads, uint32 aNumMsgs, bool aLogoff)
+{
+    OsclSemaphore doneSem, exitSem;
+    doneSem.Create();
+    exitSem.Create();
+    TestLoggerArg args[TEST_NUM_THREADS];
+    uint32 numStarted = 0;
+    bool ok = true;
+    for (uint32 i = 0; i < aNumThreads && i < TEST_NUM_THREADS; i++)
+    {
+        TestLoggerArg& arg = args[i];
+        arg.iAppender = aAppender;
+        arg.iIndex = i;
+        arg.iNumMsgs = aNumMsgs;
+        arg.iLogoff = aLogoff;
+        arg.iDoneSem = &doneSem;
+        arg.iExitSem = &exitSem;
+        OsclThread thread;
+        if (thread.Create(TestLoggerThread, 0, &arg) != OsclProcStatus::SUCCESS_ERROR)
+        {
+            printf("  thread create failed\n");
+            ok = false;
+            break;
+        }
+        numStarted++;
+        doneSem.Wait();
+        OsclThread::SleepMillisec(TEST_SETTLE_MSEC);
+    }
+    for (uint32 j = 0; j < numStarted; j++)
+    {
+        exitSem.Signal();
+    }
+    // let the threads return before their arguments go away
+    OsclThread::SleepMillisec(TEST_SETTLE_MSEC);
+    doneSem.Close();
+    exitSem.Close();
+    return ok;
+}
+
+// Decodes the binary log and counts the message lines and the number of
+// dropped records reported in it
+static bool DecodeLog(uint32& aNumMessages, uint32& aNumReportedDropped)
+{
+    aNumMessages = 0;
+    aNumReportedDropped = 0;
+    if (PVLoggerAsyncDecoder::DecodeFile(TEST_BINARY_FILE, TEST_TEXT_FILE) < 0)
+    {
+        printf("  decode failed\n");
+        return false;
+    }
+    FILE* text = fopen(TEST_TEXT_FILE_NAME, "r");
+    if (!text)
+    {
+        printf("  decoded file missing\n");
+        return false;
+    }
+    char line[1024];
+    while (fgets(line, sizeof(line), text))
+    {
+        // "PVLOG:TID(0x..):<count> messages dropped"
+        const char* dropped = oscl_strstr(line, "):");
+        if (oscl_strstr(line, " of test"))
+        {
+            aNumMessages++;
+        }
+        else if (dropped && oscl_strstr(line, "messages dropped"))
+        {
+            int32 count = 0;
+            sscanf(dropped + 2, "%d", &count);
+            aNumReportedDropped += count;
+        }
+    }
+    fclose(text);
+    return true;
+}
+
+// More threads than rings, each handing its ring back: nothing is dropped.
+static bool TestRingReclaim()
+{
+    TestAppender* appender = TestAppender::CreateAppender(TEST_BINARY_FILE, TEST_DRAIN_MSEC);
+    if (!appender)
+    {
+        printf("  appender create failed\n");
+        return false;
+    }
+    bool ok = RunLoggerThreads(appender, TEST_NUM_THREADS, TEST_MSGS_PER_THREAD, true);
+    uint32 dropped = appender->GetDroppedCount();
+    delete appender;
+
+    uint32 numMessages, numReportedDropped;
+    ok = DecodeLog(numMessages, numReportedDropped) && ok;
+    if (dropped != 0 || numMessages != TEST_NUM_THREADS * TEST_MSGS_PER_THREAD)
+    {
+        printf("  %d of %d messages decoded, %d dropped\n",
+               numMessages, TEST_NUM_THREADS * TEST_MSGS_PER_THREAD, dropped);
+        ok = false;
+    }
+    return ok;
+}
+
+// More threads than rings without ThreadLogoff: the threads that find no
+// ring lose their messages, and the log says how many.
+static bool TestNoRingDropsReported()
+{
+    TestAppender* appender = TestAppender::CreateAppender(TEST_BINARY_FILE, TEST_DRAIN_MSEC);
+    if (!appender)
+    {
+        printf("  appender create failed\n");
+        return false;
+    }
+    uint32 numThreads = TEST_MAX_THREADS + 1;
+    bool ok = RunLoggerThreads(appender, numThreads, TEST_MSGS_PER_THREAD, false);
+    uint32 dropped = appender->GetDroppedCount();
+    delete appender;
+
+    uint32 numMessages, numReportedDropped;
+    ok = DecodeLog(numMessages, numReportedDropped) && ok;
+    if (dropped != TEST_MSGS_PER_THREAD || numReportedDropped != dropped ||
+            numMessages != TEST_MAX_THREADS * TEST_MSGS_PER_THREAD)
+    {
+        printf("  %d messages decoded, %d dropped, %d reported\n", numMessages, dropped, numReportedDropped);
+        ok = false;
+    }
+    return ok;
+}
+
+// One thread overruns its ring before the drain thread wakes: every
+// message is either in the log or counted as dropped.
+static bool TestFullRingDropsReported()
+{
+    TestAppender* appender = TestAppender::CreateAppender(TEST_BINARY_FILE, 10000);
+    if (!appender)
+    {
+        printf("  appender create failed\n");
+        return false;
+    }
+    uint32 numMsgs = TEST_RING_SIZE / 16;
+    bool ok = RunLoggerThreads(appender, 1, numMsgs, true);
+    uint32 dropped = appender->GetDroppedCount();
+    delete appender;
+
+    uint32 numMessages, numReportedDropped;
+    ok = DecodeLog(numMessages, numReportedDropped) && ok;
+    if (dropped == 0 || numReportedDropped != dropped || numMessages + dropped != numMsgs)
+    {
+        printf("  %d of %d messages decoded, %d dropped, %d reported\n", numMessages, numMsgs, dropped, numReportedDropped);
+        ok = false;
+    }
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    OSCL_UNUSED_ARG(argc);
+    OSCL_UNUSED_ARG(argv);
+
+    OsclBase::Init();
+    OsclErrorTrap::Init();
+    OsclMem::Init();
+    PVLogger::Init();
+
+    uint32 failures = 0;
+
+    bool ok = TestRingReclaim();
+    printf("ring handed back with ThreadLogoff is reused: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    ok = TestNoRingDropsReported();
+    printf("messages from threads without a ring are reported: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    ok = TestFullRingDropsReported();
+    printf("messages that don't fit the ring are reported: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    PVLogger::Cleanup();
+    OsclMem::Cleanup();
+    OsclErrorTrap::Cleanup();
+    OsclBase::Cleanup();
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,31 @@
+LOCAL_PATH := $(call my-dir)
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES := \
+ 	src/pvlogger_async_decode.cpp
+
+
+LOCAL_MODULE := pvlogger_async_decode
+
+LOCAL_CFLAGS :=  $(PV_CFLAGS)
+
+
+
+LOCAL_STATIC_LIBRARIES := 
+
+LOCAL_SHARED_LIBRARIES := libopencore_common
+
+LOCAL_C_INCLUDES := \
+	$(PV_TOP)/oscl/pvlogger/tools/src \
+ 	$(PV_TOP)/oscl/pvlogger/tools/src \
+ 	$(PV_TOP)/oscl/pvlogger/src \
+ 	$(PV_INCLUDES)
+
+LOCAL_COPY_HEADERS_TO := $(PV_COPY_HEADERS_TO)
+
+LOCAL_COPY_HEADERS := \
+ 	
+
+-include $(PV_TOP)/Android_system_extras.mk
+
+include $(BUILD_EXECUTABLE)
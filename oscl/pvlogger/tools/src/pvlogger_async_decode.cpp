@@ -0,0 +1,73 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+// Offline decoder for logs written by AsyncBinaryFileAppender.
+//
+//   pvlogger_async_decode <binary log> <text log>
+//
+// Writes the same text lines TextFileAppender with TimeAndIdLayout would
+// have produced.  The binary log must come from a build with the same byte
+// order as the host running the decoder.
+
+#include "stdio.h"
+#include "oscl_base.h"
+#include "oscl_mem.h"
+#include "oscl_error.h"
+#include "oscl_utf8conv.h"
+#include "pvlogger.h"
+#include "pvlogger_async_appender.h"
+
+#define DECODE_MAX_PATH 512
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        printf("usage: %s <binary log> <text log>\n", argv[0]);
+        return 2;
+    }
+
+    OsclBase::Init();
+    OsclErrorTrap::Init();
+    OsclMem::Init();
+    PVLogger::Init();
+
+    int32 records = -1;
+    {
+        oscl_wchar inName[DECODE_MAX_PATH];
+        oscl_wchar outName[DECODE_MAX_PATH];
+        if (oscl_UTF8ToUnicode(argv[1], oscl_strlen(argv[1]), inName, DECODE_MAX_PATH) > 0 &&
+                oscl_UTF8ToUnicode(argv[2], oscl_strlen(argv[2]), outName, DECODE_MAX_PATH) > 0)
+        {
+            records = PVLoggerAsyncDecoder::DecodeFile(inName, outName);
+        }
+    }
+    if (records < 0)
+    {
+        printf("%s: can't decode %s into %s\n", argv[0], argv[1], argv[2]);
+    }
+    else
+    {
+        printf("%d records decoded\n", records);
+    }
+
+    PVLogger::Cleanup();
+    OsclMem::Cleanup();
+    OsclErrorTrap::Cleanup();
+    OsclBase::Cleanup();
+    return (records < 0) ? 1 : 0;
+}
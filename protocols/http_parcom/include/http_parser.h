@@ -71,6 +71,17 @@ class HTTPParser
          **/
         OSCL_IMPORT_REF int32 doSanityCheckForResponseHeader();
 
+        /**
+         * Enable or disable streaming output for chunked transfer encoding. By default, the de-chunked data of a CTE chunk is only sent
+         * out once the whole chunk has been received, so the input data fragments covering a large chunk are all held until its last byte
+         * arrives. In streaming mode, the chunk data available in the current input is sent out right away (return code
+         * PARSE_SUCCESS_END_OF_INPUT), still as memory fragments pointing into the input data streams, i.e. no copy. The remaining data
+         * of the chunk is sent out with the following inputs. Multipart content is not affected since its chunks carry their own headers.
+         * This needs to be set before parsing entity body, and it is kept across reset().
+         * @param aStreaming, true to enable streaming mode
+         **/
+        OSCL_IMPORT_REF void setStreamingEntityBody(const bool aStreaming = true);
+
 
         // return codes for parse function
         enum PARSE_RETURN_CODES
@@ -144,6 +155,7 @@ class HTTPParser
         HTTPContentInfoInternal *iContentInfo;
         HTTPParserHeaderObject  *iHeader;
         HTTPParserEntityBodyObject *iEntityBody;
+        bool iStreamingEntityBody;
 };
 
 #endif // HTTP_PARSER_H_
@@ -66,6 +66,12 @@ OSCL_EXPORT_REF int32 HTTPParser::doSanityCheckForResponseHeader()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////
+OSCL_EXPORT_REF void HTTPParser::setStreamingEntityBody(const bool aStreaming)
+{
+    iStreamingEntityBody = aStreaming;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 // assume aFieldKeyList has enough space to hold all parsed key list, if it is small, it will cause crash
 // since we have no way to check the space
@@ -183,7 +189,10 @@ int32 HTTPParser::parseEntityBody(RefCountHTTPEntityUnit &aEntityUnit)
         else if (iContentInfo->getContentType() == HTTP_CONTENT_NULTIPART)
             iEntityBody = OSCL_NEW(HTTPParserMultipartContentObject, (iHeader->getKeyValuesStore(), iHeader->getAllocator(), iContentInfo));
         else if (iContentInfo->getContentType() == HTTP_CONTENT_CHUNKED_TRANSFER_ENCODING)
+        {
             iEntityBody = OSCL_NEW(HTTPParserCTEContentObject, (iHeader->getKeyValuesStore(), iHeader->getAllocator(), iContentInfo));
+            if (iEntityBody) iEntityBody->setStreamingMode(iStreamingEntityBody);
+        }
 
         if (!iEntityBody) return PARSE_MEMORY_ALLOCATION_FAILURE;
     }
@@ -636,6 +645,16 @@ void HTTPParserInput::skipCRLF()
     }
 }
 
+// pass a single LF, return false if there is no input data to check
+bool HTTPParserInput::skipLF()
+{
+    if (iDataInQueue.empty()) return false;
+    if (iDataInQueueMemFragOffset >= iDataInQueue[0].getMemFragSize()) return false;
+    uint8* fragStartPtr = (uint8*)iDataInQueue[0].getMemFragPtr() + iDataInQueueMemFragOffset;
+    if (*fragStartPtr == HTTP_CHAR_LF) iDataInQueueMemFragOffset++;
+    return true;
+}
+
 // return value: 0 => not available ; >0 means the offset of the next complete line from the current point
 // -1 error
 int32 HTTPParserInput::isNextLineAvailable(bool aHeaderParsed)
@@ -1320,7 +1339,14 @@ int32 HTTPParserEntityBodyObject::parseEnityBodyChunkData(HTTPParserInput &aPars
         requestSize -= actualSize;
     }
     if (actualSize < 0) return HTTPParser::PARSE_MEMORY_ALLOCATION_FAILURE;
-    if (actualSize == 0 && requestSize > 0) return HTTPParser::PARSE_NEED_MORE_DATA;
+    if (actualSize == 0 && requestSize > 0)
+    {
+        if (!iStreamingMode || !aParserInput.hasOutputData()) return HTTPParser::PARSE_NEED_MORE_DATA;
+
+        // streaming mode: send out the partial chunk data got so far, and the rest of the chunk comes with the next input
+        if (!constructEntityUnit(aParserInput, aEntityUnit)) return HTTPParser::PARSE_MEMORY_ALLOCATION_FAILURE;
+        return HTTPParser::PARSE_SUCCESS_END_OF_INPUT;
+    }
 
     // get complete chunk, and then construct output entity unit
     if (!constructEntityUnit(aParserInput, aEntityUnit)) return HTTPParser::PARSE_MEMORY_ALLOCATION_FAILURE;
@@ -1392,13 +1418,22 @@ int32 HTTPParserCTEContentObject::parse(HTTPParserInput &aParserInput, RefCountH
         iContentInfo->iContentRangeRight = chunkLength - 1;
         iContentInfo->iContentLength += chunkLength;
         aParserInput.clearOutputQueue();
+
+        // the chunk length line already includes its CRLF, unless the line is cut between CR and LF
+        char *lineEnd = (char *)aInputLineData.getPtr() + aInputLineData.getCapacity() - 1;
+        iPendingLF = (*lineEnd == HTTP_CHAR_CR);
     }
 
     // get CTE chunk data
-    aParserInput.skipCRLF();
+    // Note that the chunk data could start with CR or LF, so only the LF split from the chunk length line can be skipped
+    if (iPendingLF && aParserInput.skipLF()) iPendingLF = false;
     int32 status = parseEnityBodyChunkData(aParserInput, aEntityUnit);
-    if (status == HTTPParser::PARSE_SUCCESS) reset(); // for next chunk parsing
-    return status;
+    if (status != HTTPParser::PARSE_SUCCESS) return status;
+
+    reset(); // for next chunk parsing
+    // the chunk ends right at the end of the current input, so the user shouldn't send the current input again
+    if (aParserInput.empty()) return HTTPParser::PARSE_SUCCESS_END_OF_INPUT;
+    return HTTPParser::PARSE_SUCCESS;
 }
 
 bool HTTPParserCTEContentObject::getCTEChunkLength(HTTPMemoryFragment &aInputLineData, int32 &aChunkSize)
@@ -159,6 +159,11 @@ class HTTPParserInput
             iDataOutQueue.clear();
         }
 
+        bool hasOutputData()
+        {
+            return !iDataOutQueue.empty();
+        }
+
         // add data
         bool push_back(OsclRefCounterMemFrag &aFrag);
         bool getNextCompleteLine(HTTPMemoryFragment &aHttpFrag, bool aHeaderParsed = false);
@@ -180,6 +185,7 @@ class HTTPParserInput
 
         // pass ending CRLF
         void skipCRLF();
+        bool skipLF();
 
     private:
 
@@ -384,7 +390,8 @@ class HTTPParserEntityBodyObject : public HTTPParserBaseObject
                 iContentInfo(aContentInfo),
                 iCurrentChunkDataLength(0),
                 iNumChunks(0),
-                iCounter(0)
+                iCounter(0),
+                iStreamingMode(false)
         {
             ;
         }
@@ -394,6 +401,12 @@ class HTTPParserEntityBodyObject : public HTTPParserBaseObject
             ;
         }
 
+        // streaming mode: send out partial chunk data instead of waiting for the complete chunk
+        void setStreamingMode(const bool aStreaming)
+        {
+            iStreamingMode = aStreaming;
+        }
+
     protected:
         // used in HTTPParserCTEContentObject and HTTPParserMultipartContentObject
         int32 parseEnityBodyChunkData(HTTPParserInput &aParserInput, RefCountHTTPEntityUnit &aEntityUnit);
@@ -403,6 +416,7 @@ class HTTPParserEntityBodyObject : public HTTPParserBaseObject
         uint32 iCurrentChunkDataLength;
         uint32 iNumChunks;
         uint32 iCounter; // for debugging purpose
+        bool iStreamingMode;
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -440,7 +454,8 @@ class HTTPParserCTEContentObject : public HTTPParserEntityBodyObject
         HTTPParserCTEContentObject(StringKeyValueStore *aKeyValueStore,
                                    PVMFBufferPoolAllocator *aEntityUnitAlloc,
                                    HTTPContentInfoInternal *aContentInfo) :
-                HTTPParserEntityBodyObject(aKeyValueStore, aEntityUnitAlloc, aContentInfo)
+                HTTPParserEntityBodyObject(aKeyValueStore, aEntityUnitAlloc, aContentInfo),
+                iPendingLF(false)
         {
             ;
         }
@@ -461,6 +476,10 @@ class HTTPParserCTEContentObject : public HTTPParserEntityBodyObject
                 iContentInfo->iContentRangeRight = 0;
             }
         }
+
+    private:
+        // the chunk length line ends with CR at the end of an input fragment, and its LF comes with the next input
+        bool iPendingLF;
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////
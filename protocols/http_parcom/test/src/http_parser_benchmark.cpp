@@ -0,0 +1,278 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+
+// Parses a 300 KB response body sent with chunked transfer encoding and
+// with Content-Length, in input fragments of several sizes, with and
+// without streaming entity body mode.  Checks that the de-chunked body is
+// byte exact, then reports the header parse rate and body throughput.
+
+#include "stdio.h"
+#include "oscl_base.h"
+#include "oscl_mem.h"
+#include "oscl_error.h"
+#include "oscl_tickcount.h"
+#include "oscl_refcounter.h"
+#include "oscl_refcounter_memfrag.h"
+#include "http_parser.h"
+
+#define BENCH_BODY_SIZE         300000
+#define BENCH_MAX_MESSAGE_SIZE  (BENCH_BODY_SIZE + 4096)
+#define BENCH_HEADER_REPEAT     200000
+#define BENCH_BODY_REPEAT       200
+
+static const char BenchHeader[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Server: Apache/2.2\r\n"
+    "Content-Type: audio/mp4\r\n"
+    "Date: Mon, 19 Oct 2026 00:00:00 GMT\r\n"
+    "Connection: keep-alive\r\n"
+    "Cache-Control: no-cache\r\n";
+
+static uint8 BenchBody[BENCH_BODY_SIZE];
+static uint8 BenchChunked[BENCH_MAX_MESSAGE_SIZE];
+static uint8 BenchPlain[BENCH_MAX_MESSAGE_SIZE];
+static uint8 BenchHeaderOnly[512];
+static uint8 BenchOutput[BENCH_BODY_SIZE];
+
+// Owns one input fragment, like the protocol engine's media data buffers
+class BenchFragRefCounter : public OsclRefCounter
+{
+    public:
+        BenchFragRefCounter(uint8* aBuf): iCount(1), iBuf(aBuf) {}
+        void addRef()
+        {
+            iCount++;
+        }
+        void removeRef()
+        {
+            if (--iCount == 0)
+            {
+                oscl_free(iBuf);
+                OSCL_DELETE(this);
+            }
+        }
+        uint32 getCount()
+        {
+            return iCount;
+        }
+
+    private:
+        uint32 iCount;
+        uint8* iBuf;
+};
+
+static OsclRefCounterMemFrag MakeInputFrag(const uint8* aData, uint32 aLen)
+{
+    uint8* buf = (uint8*)oscl_malloc(aLen);
+    oscl_memcpy(buf, aData, aLen);
+    OsclMemoryFragment frag;
+    frag.ptr = buf;
+    frag.len = aLen;
+    return OsclRefCounterMemFrag(frag, OSCL_NEW(BenchFragRefCounter, (buf)), aLen);
+}
+
+// Feeds aMsg in aFragSize pieces and returns the entity body length, or -1 on a parse error
+static int32 ParseMessage(HTTPParser* aParser, const uint8* aMsg, uint32 aMsgLen, uint32 aFragSize)
+{
+    uint32 outLen = 0;
+    uint32 pos = 0;
+    while (pos < aMsgLen)
+    {
+        uint32 len = aMsgLen - pos;
+        if (len > aFragSize)
+        {
+            len = aFragSize;
+        }
+        OsclRefCounterMemFrag input = MakeInputFrag(aMsg + pos, len);
+        pos += len;
+
+        int32 status;
+        do
+        {
+            RefCountHTTPEntityUnit entityUnit;
+            status = aParser->parse(input, entityUnit);
+            if (status < 0)
+            {
+                return -1;
+            }
+            if ((HTTPParser::PARSE_HEADER_AVAILABLE != status) && !entityUnit.empty())
+            {
+                for (uint32 i = 0; i < entityUnit.getEntityUnit().getNumFragments(); i++)
+                {
+                    OsclRefCounterMemFrag frag;
+                    entityUnit.getEntityUnit().getMemFrag(i, frag);
+                    if (outLen + frag.getMemFragSize() > BENCH_BODY_SIZE)
+                    {
+                        return -1;
+                    }
+                    oscl_memcpy(BenchOutput + outLen, frag.getMemFragPtr(), frag.getMemFragSize());
+                    outLen += frag.getMemFragSize();
+                }
+            }
+        }
+        while ((HTTPParser::PARSE_SUCCESS == status) || (HTTPParser::PARSE_HEADER_AVAILABLE == status));
+
+        if (HTTPParser::PARSE_SUCCESS_END_OF_MESSAGE == status)
+        {
+            break;
+        }
+    }
+    return (int32)outLen;
+}
+
+static uint32 BuildMessages(uint32& aChunkedLen, uint32& aPlainLen, uint32& aHeaderOnlyLen)
+{
+    uint32 i;
+    for (i = 0; i < BENCH_BODY_SIZE; i++)
+    {
+        BenchBody[i] = (uint8)(i * 7 + (i >> 3));
+    }
+    // start the body with CRLF, which the old chunk parser mistook for a line end
+    BenchBody[0] = '\r';
+    BenchBody[1] = '\n';
+
+    const uint32 hdrLen = sizeof(BenchHeader) - 1;
+    char line[64];
+
+    // chunked: alternate large and small chunks so chunks straddle fragments
+    aChunkedLen = 0;
+    oscl_memcpy(BenchChunked, BenchHeader, hdrLen);
+    aChunkedLen += hdrLen;
+    aChunkedLen += sprintf((char*)BenchChunked + aChunkedLen, "Transfer-Encoding: chunked\r\n\r\n");
+    uint32 offset = 0;
+    uint32 chunkSize = 65536;
+    while (offset < BENCH_BODY_SIZE)
+    {
+        uint32 len = BENCH_BODY_SIZE - offset;
+        if (len > chunkSize)
+        {
+            len = chunkSize;
+        }
+        uint32 lineLen = sprintf(line, "%x\r\n", len);
+        oscl_memcpy(BenchChunked + aChunkedLen, line, lineLen);
+        aChunkedLen += lineLen;
+        oscl_memcpy(BenchChunked + aChunkedLen, BenchBody + offset, len);
+        aChunkedLen += len;
+        oscl_memcpy(BenchChunked + aChunkedLen, "\r\n", 2);
+        aChunkedLen += 2;
+        offset += len;
+        chunkSize = (chunkSize == 65536) ? 1000 : 65536;
+    }
+    oscl_memcpy(BenchChunked + aChunkedLen, "0\r\n\r\n", 5);
+    aChunkedLen += 5;
+
+    aPlainLen = 0;
+    oscl_memcpy(BenchPlain, BenchHeader, hdrLen);
+    aPlainLen += hdrLen;
+    aPlainLen += sprintf((char*)BenchPlain + aPlainLen, "Content-Length: %d\r\n\r\n", BENCH_BODY_SIZE);
+    oscl_memcpy(BenchPlain + aPlainLen, BenchBody, BENCH_BODY_SIZE);
+    aPlainLen += BENCH_BODY_SIZE;
+
+    aHeaderOnlyLen = 0;
+    oscl_memcpy(BenchHeaderOnly, BenchHeader, hdrLen);
+    aHeaderOnlyLen += hdrLen;
+    aHeaderOnlyLen += sprintf((char*)BenchHeaderOnly + aHeaderOnlyLen, "Content-Length: 0\r\n\r\n");
+    return 0;
+}
+
+static uint32 ElapsedMsec(uint32 aStart)
+{
+    uint32 msec = OsclTickCount::TicksToMsec(OsclTickCount::TickCount() - aStart);
+    return (msec == 0) ? 1 : msec;
+}
+
+static int RunBenchmark(HTTPParser* aParser)
+{
+    uint32 chunkedLen, plainLen, headerOnlyLen;
+    BuildMessages(chunkedLen, plainLen, headerOnlyLen);
+
+    int result = 0;
+    const uint32 fragSizes[] = {7, 100, 1460, 16384};
+    for (uint32 streaming = 0; streaming < 2; streaming++)
+    {
+        aParser->setStreamingEntityBody(streaming != 0);
+        for (uint32 i = 0; i < sizeof(fragSizes) / sizeof(fragSizes[0]); i++)
+        {
+            aParser->reset();
+            int32 chunkedOut = ParseMessage(aParser, BenchChunked, chunkedLen, fragSizes[i]);
+            bool chunkedOk = (chunkedOut == BENCH_BODY_SIZE) && (oscl_memcmp(BenchOutput, BenchBody, BENCH_BODY_SIZE) == 0);
+
+            aParser->reset();
+            int32 plainOut = ParseMessage(aParser, BenchPlain, plainLen, fragSizes[i]);
+            bool plainOk = (plainOut == BENCH_BODY_SIZE) && (oscl_memcmp(BenchOutput, BenchBody, BENCH_BODY_SIZE) == 0);
+
+            printf("streaming %d, fragment %5d: chunked %s, content-length %s\n", streaming, fragSizes[i],
+                   chunkedOk ? "ok" : "FAILED", plainOk ? "ok" : "FAILED");
+            if (!chunkedOk || !plainOk)
+            {
+                result = 1;
+            }
+        }
+    }
+
+    aParser->setStreamingEntityBody(true);
+
+    uint32 start = OsclTickCount::TickCount();
+    for (uint32 i = 0; i < BENCH_HEADER_REPEAT; i++)
+    {
+        aParser->reset();
+        ParseMessage(aParser, BenchHeaderOnly, headerOnlyLen, 1460);
+    }
+    uint32 msec = ElapsedMsec(start);
+    printf("header parse: %d headers/s\n", (uint32)((BENCH_HEADER_REPEAT * 1000.0) / msec));
+
+    start = OsclTickCount::TickCount();
+    for (uint32 i = 0; i < BENCH_BODY_REPEAT; i++)
+    {
+        aParser->reset();
+        ParseMessage(aParser, BenchChunked, chunkedLen, 1460);
+    }
+    msec = ElapsedMsec(start);
+    printf("chunked body, 1460 byte fragments: %d KB/s\n", (uint32)(((double)BENCH_BODY_REPEAT * BENCH_BODY_SIZE) / msec));
+
+    start = OsclTickCount::TickCount();
+    for (uint32 i = 0; i < BENCH_BODY_REPEAT; i++)
+    {
+        aParser->reset();
+        ParseMessage(aParser, BenchPlain, plainLen, 1460);
+    }
+    msec = ElapsedMsec(start);
+    printf("content-length body, 1460 byte fragments: %d KB/s\n", (uint32)(((double)BENCH_BODY_REPEAT * BENCH_BODY_SIZE) / msec));
+
+    return result;
+}
+
+int main()
+{
+    OsclBase::Init();
+    OsclErrorTrap::Init();
+    OsclMem::Init();
+
+    int result = 1;
+    HTTPParser* parser = HTTPParser::create();
+    if (parser)
+    {
+        result = RunBenchmark(parser);
+        OSCL_DELETE(parser);
+    }
+
+    OsclMem::Cleanup();
+    OsclErrorTrap::Cleanup();
+    OsclBase::Cleanup();
+    return result;
+}
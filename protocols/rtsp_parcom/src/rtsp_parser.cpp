@@ -21,60 +21,6 @@
 // Define entry point for this DLL
 OSCL_DLL_ENTRY_POINT_DEFAULT()
 
-// This function searches for a substring in a string, just like strstr(), but
-// with a couple of specific features:
-//  1. It is case-insensitive, so "Ces" can be found in the word "success";
-//  2. It is looking for substrings left-to-right, and if the string starts
-//  matching, the state of search gets increased; if the whole string does not
-//  match, this function does NOT step back; therefore, the string "KoKoMo"
-//  will not be found correctly in the string "KoKoKoMo"; however, it will
-//  work for substrings that have unique beginnings that don't repeat
-//  themselves, such as "Content-length" ('c' is never repeated). Therefore,
-//  such a search works for "Content-length", which is all that RtspParser
-//  needs.
-//
-// This function is not part of OSCL precisely because of its limitations;
-// however, these limitations are ok here because they contribute to the
-// overall performance by not doing extra steps.
-//
-// added the size argument to deal with Real cloaking "H\02\00\00" 02/22/06
-static inline char *
-ci_local_strstr(char * bigString, int32 bigStringSize,
-                const StrPtrLen & subString
-               )
-{
-    uint32 state = 0;
-    uint32 targetState = subString.length();
-    char * pp;
-    //char * eos = bigString + oscl_strlen(bigString);
-    char * eos = bigString + bigStringSize;
-
-    for (pp = bigString;
-            pp != eos;
-            ++pp
-        )
-    {
-        if (OSCL_ASCII_CASE_MAGIC_BIT
-                == (((*pp) ^(subString.c_str()[state])) | OSCL_ASCII_CASE_MAGIC_BIT)
-           )
-        {
-            ++state;
-            if (state == targetState)
-            {
-                return pp - targetState + 1;
-            }
-        }
-        else
-        {
-            state = 0;
-        }
-
-    }
-
-    return NULL;
-}
-
-
 static inline bool
 isspaceNotNL(char ch)
 {
@@ -237,6 +183,8 @@ RTSPParser::registerNewRequestStruct(RTSPIncomingMessage * newRequestStruct)
 
     internalState = IS_LOOKING_FOR_END_OF_REQUEST;
 
+    resetEndOfRequestScan();
+
     continueProcessing();
 
     return true;
@@ -302,6 +250,109 @@ RTSPParser::getDataBufferSpec()
     return & dataBufferSpec;
 }
 
+void
+RTSPParser::resetEndOfRequestScan()
+{
+    eorptr = mainBufferEntry;
+    eorTrailingNewlines = 0;
+    clScanState = CL_LINE_START;
+    clScanMatched = 0;
+    clScanValue = 0;
+    clScanFound = false;
+}
+
+// Advances eorptr over the newly arrived bytes. The end of the request is
+// CR-CR, LF-LF or CR-LF-CR-LF; Content-Length is picked up on the way, so
+// that the header does not have to be searched again once it is complete.
+//
+// returns true with eorptr just past the end of the request if found
+//
+bool
+RTSPParser::scanForEndOfRequest()
+{
+    static const uint32 CR_LF_CR = (((uint32)CHAR_CR) << 16) | (((uint32)CHAR_LF) << 8) | (uint32)CHAR_CR;
+    const char * clName = RtspRecognizedFieldContentLength;
+    const uint32 clNameLen = oscl_strlen(RtspRecognizedFieldContentLength);
+
+    for (; eorptr < mainBufferSpace; ++eorptr)
+    {
+        char ch = *eorptr;
+
+        if (CHAR_CR == ch || CHAR_LF == ch)
+        {
+            if (CL_READING_DIGITS == clScanState)
+            {
+                clScanFound = true;
+            }
+            clScanState = CL_LINE_START;
+            clScanMatched = 0;
+
+            if (((eorTrailingNewlines & 0xFF) == (uint32)ch)
+                    || ((CHAR_LF == ch) && ((eorTrailingNewlines & 0xFFFFFF) == CR_LF_CR))
+               )
+            {
+                ++eorptr;
+                return true;
+            }
+            eorTrailingNewlines = (eorTrailingNewlines << 8) | (uint32)ch;
+            continue;
+        }
+
+        eorTrailingNewlines = 0;
+
+        if (clScanFound)
+        {   // first Content-Length wins
+            continue;
+        }
+
+        switch (clScanState)
+        {
+            case CL_LINE_START:
+            case CL_MATCHING_NAME:
+                if (OSCL_ASCII_CASE_MAGIC_BIT
+                        == ((ch ^ clName[clScanMatched]) | OSCL_ASCII_CASE_MAGIC_BIT))
+                {
+                    clScanState = (++clScanMatched == clNameLen) ?
+                                  CL_SKIPPING_SEPARATOR : CL_MATCHING_NAME;
+                }
+                else
+                {
+                    clScanState = CL_SKIPPING_LINE;
+                }
+                break;
+
+            case CL_SKIPPING_SEPARATOR:
+                if (ch >= '0' && ch <= '9')
+                {
+                    clScanValue = ch - '0';
+                    clScanState = CL_READING_DIGITS;
+                }
+                else if (!isspaceNotNL(ch) && (CHAR_COLON != ch))
+                {
+                    clScanState = CL_SKIPPING_LINE;
+                }
+                break;
+
+            case CL_READING_DIGITS:
+                if (ch >= '0' && ch <= '9')
+                {
+                    clScanValue = clScanValue * 10 + (ch - '0');
+                }
+                else
+                {
+                    clScanFound = true;
+                    clScanState = CL_SKIPPING_LINE;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return false;
+}
+
 void
 RTSPParser::lookForEndOfRequest()
 {
@@ -355,64 +406,14 @@ RTSPParser::lookForEndOfRequest()
 
     else
     { // it's a normal message
-        bool found = false;
-
-        for (/*eorptr = mainBufferEntry*/; eorptr < mainBufferSpace - 1; ++eorptr)
-        {
-            if (CHAR_LF == *eorptr || CHAR_CR == *eorptr)
-            {   // it's a possible
-
-                // is it two newlines?
-                if (*eorptr == *(eorptr + 1))
-                {   // yes, CR-CR or LF-LF format
-
-                    found = true;
-                    eorptr += 2;
-                    break;
-                }
-                else if ((eorptr <= mainBufferSpace - 4)
-                         && (CHAR_CR == *(eorptr)) && (CHAR_LF == *(eorptr + 1))
-                         && (CHAR_CR == *(eorptr + 2)) && (CHAR_LF == *(eorptr + 3))
-                        )
-                {   // yes, MS-WINDOWS format
-
-                    found = true;
-                    eorptr += 4;
-                    break;
-                }
-                // else, continue on
-            }
-        }
 
-        if (found)
+        if (scanForEndOfRequest())
         {
             // transfer the buffer, if necessary
 
             newMessageSize = eorptr - mainBufferEntry;
 
-            // quickly take a peek at content-length
-            char * cl = ci_local_strstr(mainBufferEntry, newMessageSize,
-                                        RtspRecognizedFieldContentLength);
-            if (NULL == cl)
-            { // nothing visible
-                ebFullSizeExpected = 0;
-            }
-            else if (cl >= mainBufferEntry + newMessageSize)
-            { // it's not part of this particular message
-                ebFullSizeExpected = 0;
-            }
-            else
-            {
-                cl += oscl_strlen(RtspRecognizedFieldContentLength);
-                while (cl < eorptr && (isspaceNotNL(*cl) || (CHAR_COLON == *cl)))
-                {
-                    ++cl;
-                }
-
-                uint32 atoi_tmp;
-                PV_atoi(cl, 'd', atoi_tmp);
-                ebFullSizeExpected = atoi_tmp;
-            }
+            ebFullSizeExpected = clScanFound ? clScanValue : 0;
 
             // now, on with the moving around ...
 
@@ -478,18 +479,14 @@ RTSPParser::lookForEndOfRequest()
 
         if (mainBufferEntry != mainBuffer)
         {
+            // the scan state stays valid, only the position moves
+            int sizeScannedSoFar = eorptr - mainBufferEntry;
+
             oscl_memmove(mainBuffer, mainBufferEntry, sizeUsedSoFar);
             mainBufferEntry = mainBuffer;
-            eorptr = mainBufferEntry;
+            eorptr = mainBufferEntry + sizeScannedSoFar;
             mainBufferSpace = mainBufferEntry + sizeUsedSoFar;
         }
-        else
-        { // rewind eorptr
-
-            eorptr -= 4;
-
-            eorptr = (eorptr < mainBufferEntry) ? mainBufferEntry : eorptr;
-        }
     }
 }
 
@@ -799,7 +796,7 @@ RTSPParser::flush(void)
     mainBufferEntry = mainBuffer;
     mainBufferSpace = mainBuffer;
     mainBufferSizeUsed = 0;
-    eorptr = mainBuffer;
+    resetEndOfRequestScan();
     mainBuffer[ RTSP_PARSER_BUFFER_SIZE ] = CHAR_NULL;
     mainBuffer[ RTSP_PARSER_BUFFER_SIZE+1 ] = CHAR_NULL;
 }
@@ -92,6 +92,28 @@ class RTSPParser
 
         char            * eorptr;
 
+        // incremental end-of-request scan; the state is kept across
+        // registerDataBufferWritten() calls so that every header byte is
+        // examined exactly once, however the data is chunked
+        //
+        typedef enum
+        {
+            CL_LINE_START,
+            CL_MATCHING_NAME,
+            CL_SKIPPING_SEPARATOR,
+            CL_READING_DIGITS,
+            CL_SKIPPING_LINE
+        } ContentLengthScanState;
+
+        uint32            eorTrailingNewlines; // last newline chars seen, packed
+        ContentLengthScanState clScanState;
+        uint32            clScanMatched;
+        uint32            clScanValue;
+        bool              clScanFound;
+
+        void    resetEndOfRequestScan();
+        bool    scanForEndOfRequest();
+
 
         // for field repetitions
         //
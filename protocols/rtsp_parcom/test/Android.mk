@@ -0,0 +1,31 @@
+LOCAL_PATH := $(call my-dir)
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES := \
+ 	src/rtsp_parser_benchmark.cpp
+
+
+LOCAL_MODULE := pv_rtsp_parser_benchmark
+
+LOCAL_CFLAGS :=  $(PV_CFLAGS)
+
+
+
+LOCAL_STATIC_LIBRARIES :=    
+
+LOCAL_SHARED_LIBRARIES := libopencore_rtsp libopencore_player libopencore_net_support libopencore_common
+
+LOCAL_C_INCLUDES := \
+	$(PV_TOP)/protocols/rtsp_parcom/test/src \
+ 	$(PV_TOP)/protocols/rtsp_parcom/test/src \
+ 	$(PV_TOP)/protocols/rtsp_parcom/src \
+ 	$(PV_INCLUDES)
+
+LOCAL_COPY_HEADERS_TO := $(PV_COPY_HEADERS_TO)
+
+LOCAL_COPY_HEADERS := \
+ 	
+
+-include $(PV_TOP)/Android_system_extras.mk
+
+include $(BUILD_EXECUTABLE)
@@ -0,0 +1,23 @@
+# Get the current local path as the first operation
+LOCAL_PATH := $(call get_makefile_dir)
+
+# Clear out the variables used in the local makefiles
+include $(MK)/clear.mk
+
+TARGET := pv_rtsp_parser_benchmark
+
+
+XCXXFLAGS += $(FLAG_COMPILE_WARNINGS_AS_ERRORS)
+
+XINCDIRS +=  ../../../src
+
+SRCDIR := ../../src
+INCSRCDIR := ../../src
+
+SRCS := rtsp_parser_benchmark.cpp
+
+LIBS := opencore_rtsp opencore_player opencore_net_support opencore_common
+
+SYSLIBS += $(SYS_THREAD_LIB)
+
+include $(MK)/prog.mk
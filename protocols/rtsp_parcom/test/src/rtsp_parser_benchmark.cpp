@@ -0,0 +1,167 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+
+// Feeds a stream of back to back RTSP responses through RTSPParser in
+// fixed size reads and reports the parsing rate.  Large reads model a
+// full TCP segment, small reads exercise the resumable end-of-request scan.
+// Every other response carries an entity body to exercise the
+// Content-Length match.
+
+#include "stdio.h"
+#include "oscl_base.h"
+#include "oscl_mem.h"
+#include "oscl_error.h"
+#include "oscl_tickcount.h"
+#include "rtsp_parser.h"
+
+#define BENCH_STREAM_SIZE   (1 << 20)
+#define BENCH_REPEAT        20
+
+static const char BenchResponse[] =
+    "RTSP/1.0 200 OK\r\n"
+    "CSeq: 3\r\n"
+    "Session: 12345678;timeout=60\r\n"
+    "Server: PVSS\r\n"
+    "Date: Mon, 19 Oct 2026 10:00:00 GMT\r\n"
+    "Cache-Control: no-cache\r\n"
+    "\r\n";
+
+static const char BenchResponseWithBody[] =
+    "RTSP/1.0 200 OK\r\n"
+    "CSeq: 2\r\n"
+    "Content-Type: application/sdp\r\n"
+    "Content-Length: 29\r\n"
+    "Date: Mon, 19 Oct 2026 10:00:00 GMT\r\n"
+    "\r\n"
+    "v=0\r\no=- 0 0 IN IP4 0.0.0.0\r\n";
+
+static char BenchStream[BENCH_STREAM_SIZE];
+static RTSPIncomingMessage BenchMessage;
+static char BenchBody[64];
+static RTSPEntityBody BenchEntityBody;
+// the parser carries its receive buffer, so keep it off the stack.  Each
+// pass ends on a message boundary, so the parser can be reused.
+static RTSPParser BenchParser;
+
+// returns the number of complete messages parsed
+static uint32 ParseStream(RTSPParser& aParser, const char* aData, int32 aLen, int32 aReadSize)
+{
+    uint32 numMessages = 0;
+    int32 offset = 0;
+
+    for (;;)
+    {
+        RTSPParser::ParserState state = aParser.getState();
+        if (RTSPParser::WAITING_FOR_REQUEST_MEMORY == state)
+        {
+            BenchMessage.reset();
+            aParser.registerNewRequestStruct(&BenchMessage);
+            continue;
+        }
+        if (RTSPParser::REQUEST_IS_READY == state)
+        {
+            numMessages++;
+            continue;
+        }
+        if (RTSPParser::WAITING_FOR_ENTITY_BODY_MEMORY == state)
+        {
+            BenchEntityBody.ptr = BenchBody;
+            BenchEntityBody.len = BenchMessage.contentLength;
+            aParser.registerEntityBody(&BenchEntityBody);
+            continue;
+        }
+        if (RTSPParser::ENTITY_BODY_IS_READY == state)
+        {
+            continue;
+        }
+        if ((RTSPParser::WAITING_FOR_DATA != state) || (offset >= aLen))
+        {
+            break;
+        }
+
+        const StrPtrLen* buf = aParser.getDataBufferSpec();
+        int32 len = aLen - offset;
+        if (len > aReadSize)
+        {
+            len = aReadSize;
+        }
+        if (len > buf->length())
+        {
+            len = buf->length();
+        }
+        oscl_memcpy((char*)buf->c_str(), aData + offset, len);
+        offset += len;
+        aParser.registerDataBufferWritten(len);
+    }
+    return numMessages;
+}
+
+static int RunBenchmark()
+{
+    const int32 msgLen = sizeof(BenchResponse) - 1;
+    const int32 bodyMsgLen = sizeof(BenchResponseWithBody) - 1;
+    int32 streamLen = 0;
+    uint32 expected = 0;
+    while (streamLen + msgLen + bodyMsgLen <= BENCH_STREAM_SIZE)
+    {
+        oscl_memcpy(BenchStream + streamLen, BenchResponse, msgLen);
+        streamLen += msgLen;
+        oscl_memcpy(BenchStream + streamLen, BenchResponseWithBody, bodyMsgLen);
+        streamLen += bodyMsgLen;
+        expected += 2;
+    }
+
+    const int32 readSizes[] = {1460, 64, 16};
+    for (uint32 i = 0; i < sizeof(readSizes) / sizeof(readSizes[0]); i++)
+    {
+        uint32 total = 0;
+        uint32 start = OsclTickCount::TickCount();
+        for (uint32 rep = 0; rep < BENCH_REPEAT; rep++)
+        {
+            uint32 parsed = ParseStream(BenchParser, BenchStream, streamLen, readSizes[i]);
+            if (parsed != expected)
+            {
+                printf("read size %d: parsed %d of %d messages\n", readSizes[i], parsed, expected);
+                return 1;
+            }
+            total += parsed;
+        }
+        uint32 msec = OsclTickCount::TicksToMsec(OsclTickCount::TickCount() - start);
+        if (msec == 0)
+        {
+            msec = 1;
+        }
+        printf("read size %4d: %d messages in %d ms, %d msgs/s\n",
+               readSizes[i], total, msec, (uint32)((total * 1000.0) / msec));
+    }
+    return 0;
+}
+
+int main()
+{
+    OsclBase::Init();
+    OsclErrorTrap::Init();
+    OsclMem::Init();
+
+    int result = RunBenchmark();
+
+    OsclMem::Cleanup();
+    OsclErrorTrap::Cleanup();
+    OsclBase::Cleanup();
+    return result;
+}
@@ -37,6 +37,7 @@ LOCAL_SRC_FILES := \
  	./h324/srp/src/srp.cpp \
  	./h245/per/src/per.cpp \
  	./h245/per/src/genericper.cpp \
+ 	./h245/per/src/per_arena.cpp \
  	./h245/per/src/analyzeper.cpp \
  	./h245/per/src/h245_analysis.cpp \
  	./h245/per/src/h245_encoder.cpp \
@@ -95,6 +96,11 @@ LOCAL_COPY_HEADERS := \
  	./h245/cmn/include/h245def.h \
  	./h245/per/include/per_common.h \
  	./h245/per/include/analyzeper.h \
- 	./h245/per/include/genericper.h
+ 	./h245/per/include/genericper.h \
+ 	./h245/per/include/per_arena.h \
+ 	./h245/per/include/h245_decoder.h \
+ 	./h245/per/include/h245_encoder.h \
+ 	./h245/per/include/h245_deleter.h \
+ 	./h245/per/include/h245_copier.h
 
 include $(BUILD_STATIC_LIBRARY)
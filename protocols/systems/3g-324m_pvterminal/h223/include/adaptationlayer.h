@@ -61,6 +61,15 @@ class AdaptationLayer
         virtual PVMFStatus StartPacket(OsclSharedPtr<PVMFMediaDataImpl>& pkt) = 0;
         virtual PVMFStatus CompletePacket(OsclSharedPtr<PVMFMediaDataImpl>& pkt) = 0;
         virtual void ParsePacket(OsclSharedPtr<PVMFMediaDataImpl>& pkt, IncomingALPduInfo& info) = 0;
+        /* Running CRC over an incoming pdu, including its CRC field.  The
+           incoming channel feeds the data as it is copied in, and
+           ParsePacket uses the result when it covers the whole pdu. */
+        virtual void StartRxCrc() {}
+        virtual void UpdateRxCrc(const uint8* data, uint32 len)
+        {
+            OSCL_UNUSED_ARG(data);
+            OSCL_UNUSED_ARG(len);
+        }
         unsigned GetSduSize()
         {
             return iSduSize;
@@ -113,6 +122,7 @@ class AdaptationLayer2 : public AdaptationLayer
         {
             SetSeqnum(seqno);
             iSeqNum = 0;
+            StartRxCrc();
         }
         void Construct();
 
@@ -131,6 +141,16 @@ class AdaptationLayer2 : public AdaptationLayer
         PVMFStatus CompletePacket(OsclSharedPtr<PVMFMediaDataImpl>& pkt);
 
         void ParsePacket(OsclSharedPtr<PVMFMediaDataImpl>& pkt, IncomingALPduInfo& info);
+        void StartRxCrc()
+        {
+            iRxCrc = CRC8_INIT;
+            iRxCrcLen = 0;
+        }
+        void UpdateRxCrc(const uint8* data, uint32 len)
+        {
+            iRxCrc = crc.Crc8Update(iRxCrc, data, len);
+            iRxCrcLen += len;
+        }
 
         void SetSeqnum(bool on_off);
     private:
@@ -140,6 +160,8 @@ class AdaptationLayer2 : public AdaptationLayer
         unsigned iSeqNum;
         PVMFBufferPoolAllocator iMemFragmentAlloc;
         CRC crc;
+        uint8 iRxCrc;
+        uint32 iRxCrcLen;
 
 };
 
@@ -153,6 +175,7 @@ class AdaptationLayer3 : public AdaptationLayer
                 iTrlrSz(2)
         {
             iSeqNum = 0;
+            StartRxCrc();
         }
 
         ~AdaptationLayer3()
@@ -174,6 +197,16 @@ class AdaptationLayer3 : public AdaptationLayer
         PVMFStatus CompletePacket(OsclSharedPtr<PVMFMediaDataImpl>& pkt);
 
         void ParsePacket(OsclSharedPtr<PVMFMediaDataImpl>& pkt, IncomingALPduInfo& info);
+        void StartRxCrc()
+        {
+            iRxCrc = CRC16_INIT;
+            iRxCrcLen = 0;
+        }
+        void UpdateRxCrc(const uint8* data, uint32 len)
+        {
+            iRxCrc = crc.Crc16Update(iRxCrc, data, len);
+            iRxCrcLen += len;
+        }
     private:
         void DRTXSend(int , uint16)
         {
@@ -190,6 +223,8 @@ class AdaptationLayer3 : public AdaptationLayer
         PVMFBufferPoolAllocator iMemFragmentAlloc;
 
         CRC crc;
+        uint16 iRxCrc;
+        uint32 iRxCrcLen;
 };
 
 
@@ -47,13 +47,18 @@ class Level0PduParcom : public H223PduParcomBase
         void GetHdrFragment(OsclRefCounterMemFrag& frag);
         uint16 Insert0(uint8* pPdu, int pdu_size, uint8* pRetPdu);
         uint16 Insert0Octet(uint8 cur_byte, uint16 num_bits_from_octet, uint8* out_buffer);
+        // zero bit insertion for up to 16 bits at a time
+        uint16 Insert0Bits(uint32 bits, int num_bits, uint8* out_buffer);
         uint16 AppendTxBits0(unsigned num_bits, int bits, uint8* pos);
         // appends an octet to the output stream without checking for 0 bit.  Flushes the current check bits
         uint16 AppendTxOctet(uint8 octet, uint8* pos);
 
         void SearchForHdlcFlag(uint8* bsbuf, int bsbsz);
+        void SearchForHdlcFlagOctet(uint8 cur_byte);
         unsigned Remove0();
         void Remove0Octet(uint8 cur_byte, int num_bits_from_octet);
+        // zero bit removal for up to 16 bits at a time
+        void Remove0Bits(uint32 bits, int num_bits);
         void AppendBit(int c);
         void AppendBits0(unsigned num_bits, int bits);
 
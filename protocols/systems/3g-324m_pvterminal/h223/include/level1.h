@@ -71,6 +71,7 @@ class Level1PduParcom : public H223PduParcomBase
             return (bsbuf[0] == 0xe1 && bsbuf[1] == 0x4d);
         }
         inline void IndicatePdu();
+        uint32 CopyPduData(uint8* bsbuf, uint32 bsbsz);
 
         PVMFBufferPoolAllocator iHdrFragmentAlloc;
 
@@ -136,12 +136,15 @@ class Level2PduParcom : public H223PduParcomBase
         }
 
         uint8* FindSync(uint8* data, int len, int* closing);
+        int SkipNonFlags(uint8* bsbuf, int bsbsz);
         bool RecoverPduData(uint8*& bsbuf, int* bsbsz);
 
         int GolayDec(int received, int* num_errors)
         {
             received = ((received >> 1) & 0xfffff800) + (received & 0x7ff);
-            int syndrome = get_syndrome(received);
+            // the syndrome is linear in the received word, so it is the xor of the syndromes of its octets
+            int syndrome = iSyndromeTab[0][received & 0xFF] ^ iSyndromeTab[1][(received >> 8) & 0xFF] ^
+                           iSyndromeTab[2][(received >> 16) & 0x7F];
             received ^= iDecTab[syndrome];
             *num_errors = iNumOnes[syndrome&0xFF] + iNumOnes[(syndrome >> 8)&0xFF] +
                           iNumOnes[(syndrome >> 16)&0xFF] + iNumOnes[(syndrome >> 24)&0xFF];
@@ -168,6 +171,7 @@ class Level2PduParcom : public H223PduParcomBase
         uint8 iLastHdr[8];
         int* iEncTab;
         int* iDecTab;
+        int iSyndromeTab[3][256];
         uint8 iNumOnes[256];
         // Outgoing
         uint32 iNumClosingFlagsTx;
@@ -137,6 +137,9 @@ void AdaptationLayer2::ParsePacket(OsclSharedPtr<PVMFMediaDataImpl>& pkt, Incomi
     info.seq_num_error = 0; // No sequence number error.
     uint8 SeqNum = 0;
     PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_STACK_TRACE, (0, "AdaptationLayer2::ParsePacket pdu size(%d)", pkt->getFilledSize()));
+    // Use the running CRC if it was fed the whole pdu
+    bool rxCrcValid = (iRxCrcLen == pkt->getFilledSize());
+    iRxCrcLen = 0;
     info.sdu_size = (uint16)(pkt->getFilledSize() - iSNPos - PV2WAY_H223_AL2_CRC_SIZE);
     if (info.sdu_size  <= 0)
     {
@@ -151,8 +154,8 @@ void AdaptationLayer2::ParsePacket(OsclSharedPtr<PVMFMediaDataImpl>& pkt, Incomi
     OsclRefCounterMemFrag first_frag;
     pkt->getMediaFragment(0, first_frag);
 
-    uint16 CrcCheck = crc.Crc8Check(pkt, false);
-    if (Crc != CrcCheck)
+    bool CrcError = rxCrcValid ? (iRxCrc != CRC8_RESIDUE) : (Crc != crc.Crc8Check(pkt, false));
+    if (CrcError)
     {
         PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_WARNING, (0, "AdaptationLayer2::ParsePacket CRC error sn(%d)", iSeqNum));
         info.crc_error = true;
@@ -309,6 +312,9 @@ PVMFStatus AdaptationLayer3::CompletePacket(OsclSharedPtr<PVMFMediaDataImpl>& pk
 void AdaptationLayer3::ParsePacket(OsclSharedPtr<PVMFMediaDataImpl>& pkt, IncomingALPduInfo& info)
 {
     PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_STACK_TRACE, (0, "AdaptationLayer3::ParsePacket pdu_size(%d)", pkt->getFilledSize()));
+    // Use the running CRC if it was fed the whole pdu
+    bool rxCrcValid = (iRxCrcLen == pkt->getFilledSize());
+    iRxCrcLen = 0;
     OsclRefCounterMemFrag frag;
     uint16 SeqNum = 0;
     uint16 Crc = 0, VrMax = 0;
@@ -356,7 +362,8 @@ void AdaptationLayer3::ParsePacket(OsclSharedPtr<PVMFMediaDataImpl>& pkt, Incomi
         pkt->setMediaFragFilledLen(pkt->getNumFragments() - 1, last_frag.getMemFrag().len - 1);
         pkt->setMediaFragFilledLen(pkt->getNumFragments() - 2, second_last_frag.getMemFrag().len - 1);
     }
-    if (Crc != crc.Crc16Check(pkt, false))
+    bool CrcError = rxCrcValid ? (iRxCrc != CRC16_RESIDUE) : (Crc != crc.Crc16Check(pkt, false));
+    if (CrcError)
     {
         PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_WARNING, (0, "AdaptationLayer3::ParsePacket CRC error, sn(%d)", iSeqNum));
 
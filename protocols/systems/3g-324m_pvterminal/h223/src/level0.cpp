@@ -22,6 +22,23 @@
 #define HDLC    0x7e
 #define NUM_ZERO_BIT_INSERTION_BUFFERS 32
 
+/* Returns the position of the lowest set bit, x must not be 0 */
+static inline int LowestBitSet(uint32 x)
+{
+    int pos = 0;
+    if ((x & 0xFF) == 0)
+    {
+        x >>= 8;
+        pos += 8;
+    }
+    while ((x & 1) == 0)
+    {
+        x >>= 1;
+        pos++;
+    }
+    return pos;
+}
+
 Level0PduParcom::Level0PduParcom()
 {
     iLogger = PVLogger::GetLoggerObject("3g324m.h223.Level0");
@@ -169,31 +186,41 @@ uint16 Level0PduParcom::AppendTxBits0(unsigned num_bits, int bits, uint8* pos)
 
 /* Inserts the octet while checking for 5 1's.  */
 uint16 Level0PduParcom::Insert0Octet(uint8 octet, uint16 num_bits_from_octet, uint8* out_buffer)
+{
+    return Insert0Bits(octet, num_bits_from_octet, out_buffer);
+}
+
+/* Inserts up to 16 bits while checking for 5 1's.  Instead of testing one bit at a time, the
+   positions of all runs of 5 1's are found with a few shifts and the bits between them are
+   written out in one go. */
+uint16 Level0PduParcom::Insert0Bits(uint32 bits, int num_bits, uint8* out_buffer)
 {
     uint8* write_pos = out_buffer;
 
-    iTxCheck0 = iTxCheck0 | (octet << iTxCheck0Pos);
-    iTxCheck0Pos += num_bits_from_octet;
-    int bits_consumed = 0;
-    while (iTxCheck0Pos >= 5)
+    uint32 check = (uint32)iTxCheck0 | (bits << iTxCheck0Pos);
+    int num_check = iTxCheck0Pos + num_bits;
+    // bit i of ones5 is set if bits i to i+4 of check are all 1's
+    uint32 ones5 = check & (check >> 1) & (check >> 2) & (check >> 3) & (check >> 4);
+    int pos = 0;
+    while (num_check - pos >= 5)
     {
-        if ((iTxCheck0 & 0x1F) == 0x1F)
+        uint32 runs = (ones5 >> pos) & ((1 << (num_check - 4 - pos)) - 1);
+        if (runs == 0)
         {
-            // 5 1's detected.  Insert 0 after them
-            //PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_STACK_TRACE, (0,"Level0PduParcom::Insert0Octet - inserting 0\n"));
-            write_pos += AppendTxBits0(5, iTxCheck0 & 0x1F, write_pos);
-            write_pos += AppendTxBits0(1, 0, write_pos);
-            bits_consumed = 5;
+            // no 1's to stuff, leave the last 4 bits for the next check
+            int num_out = num_check - 4 - pos;
+            write_pos += AppendTxBits0(num_out, (check >> pos) & ((1 << num_out) - 1), write_pos);
+            pos = num_check - 4;
+            break;
         }
-        else
-        {
-            // just insert the lsb
-            write_pos += AppendTxBits0(1, iTxCheck0 & 1, write_pos);
-            bits_consumed = 1;
-        }
-        iTxCheck0 >>= bits_consumed;
-        iTxCheck0Pos -= bits_consumed;
+        // 5 1's detected.  Write them out with everything before them and insert 0 after them
+        int num_out = LowestBitSet(runs) + 5;
+        write_pos += AppendTxBits0(num_out, (check >> pos) & ((1 << num_out) - 1), write_pos);
+        write_pos += AppendTxBits0(1, 0, write_pos);
+        pos += num_out;
     }
+    iTxCheck0Pos = num_check - pos;
+    iTxCheck0 = (check >> pos) & ((1 << iTxCheck0Pos) - 1);
     return (uint16)(write_pos - out_buffer);
 }
 
@@ -202,9 +229,14 @@ uint16
 Level0PduParcom::Insert0(uint8* chunk, int chunk_size, uint8* out_buffer)
 {
     uint8* pos = out_buffer;
-    for (int bytenum = 0; bytenum < chunk_size; bytenum++)
+    int bytenum = 0;
+    for (; bytenum + 1 < chunk_size; bytenum += 2)
     {
-        pos += Insert0Octet(chunk[bytenum], 8, pos);
+        pos += Insert0Bits(chunk[bytenum] | (chunk[bytenum + 1] << 8), 16, pos);
+    }
+    if (bytenum < chunk_size)
+    {
+        pos += Insert0Bits(chunk[bytenum], 8, pos);
     }
     return (uint16)(pos - out_buffer);
 }
@@ -215,34 +247,56 @@ void Level0PduParcom::SearchForHdlcFlag(uint8* bsbuf, int bsbsz)
 {
     for (int bytenum = 0; bytenum < bsbsz; bytenum++)
     {
-        uint8 cur_byte = bsbuf[bytenum];
-        uint8 cur_bit = 0;
-        for (int bitnum = 0; bitnum < 8; bitnum++)
+        // Once 7 bits are pending, each octet shifts one whole octet out of the flag window.  If there is no
+        // flag in any of the 8 windows and the pdu has room, it can be appended in one go.
+        if (iNumRecvBits == 7 && iPduPos != iPduEndPos)
         {
-            cur_bit = (uint8)(cur_byte & 0x1);
-            cur_byte >>= 1;
-            iRecvBits = (uint8)(iRecvBits | (cur_bit << iNumRecvBits++));
-            if (iNumRecvBits == 8)
+            uint32 window = iRecvBits | (bsbuf[bytenum] << 7);
+            // bit i of ones6 is set if bits i to i+5 of window are all 1's.  A window starting at bit j is
+            // a flag if bits j+1 to j+6 are 1's
+            uint32 ones6 = window & (window >> 1) & (window >> 2) & (window >> 3) & (window >> 4) & (window >> 5);
+            if (((ones6 >> 1) & 0xFF) == 0)
             {
-                if ((iRecvBits&HDLC) == HDLC)
-                {
-                    // found flag
-                    unsigned size = iPduPos - iPdu;
-                    if (size)
-                    {
-                        // perform 0 bit removal within the same buffer
-                        Remove0();
-                    }
-                    iNumRecvBits = 0;
-                    iRecvBits = 0;
-                }
-                else
+                iRecvByte |= (window & 0xFF) << iRecvBytePos;
+                *iPduPos++ = (uint8)iRecvByte;
+                iRecvByte >>= 8;
+                iRecvBits = window >> 8;
+                continue;
+            }
+        }
+        SearchForHdlcFlagOctet(bsbuf[bytenum]);
+    }
+}
+
+/* Bit by bit flag search for one octet */
+void Level0PduParcom::SearchForHdlcFlagOctet(uint8 cur_byte)
+{
+    uint8 cur_bit = 0;
+    for (int bitnum = 0; bitnum < 8; bitnum++)
+    {
+        cur_bit = (uint8)(cur_byte & 0x1);
+        cur_byte >>= 1;
+        iRecvBits = (uint8)(iRecvBits | (cur_bit << iNumRecvBits++));
+        if (iNumRecvBits == 8)
+        {
+            if ((iRecvBits&HDLC) == HDLC)
+            {
+                // found flag
+                unsigned size = iPduPos - iPdu;
+                if (size)
                 {
-                    // copy current bit to pdu
-                    AppendBit(iRecvBits&0x1);
-                    iRecvBits >>= 1;
-                    iNumRecvBits--;
+                    // perform 0 bit removal within the same buffer
+                    Remove0();
                 }
+                iNumRecvBits = 0;
+                iRecvBits = 0;
+            }
+            else
+            {
+                // copy current bit to pdu
+                AppendBit(iRecvBits&0x1);
+                iRecvBits >>= 1;
+                iNumRecvBits--;
             }
         }
     }
@@ -285,9 +339,14 @@ unsigned Level0PduParcom::Remove0()
     OSCL_ASSERT(size >= 0);
     iPduPosZeroRemoved = iPdu;
     //PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_STACK_TRACE, (0,"Level0PduParcom::Remove0 size(%d)", size));
-    for (int bytenum = 0; bytenum < size; bytenum++)
+    int bytenum = 0;
+    for (; bytenum + 1 < size; bytenum += 2)
     {
-        Remove0Octet(iPdu[bytenum], 8);
+        Remove0Bits(iPdu[bytenum] | (iPdu[bytenum + 1] << 8), 16);
+    }
+    if (bytenum < size)
+    {
+        Remove0Bits(iPdu[bytenum], 8);
     }
     if (iRecvBytePos)
     {
@@ -327,35 +386,37 @@ unsigned Level0PduParcom::Remove0()
 
 void Level0PduParcom::Remove0Octet(uint8 cur_byte, int num_bits_from_octet)
 {
-    uint8 cur_bit = 0;
-    for (int bitnum = 0; bitnum < num_bits_from_octet; bitnum++)
+    Remove0Bits(cur_byte & ((1 << num_bits_from_octet) - 1), num_bits_from_octet);
+}
+
+/* Removes the 0 following each run of 5 1's, using the same run detection as Insert0Bits */
+void Level0PduParcom::Remove0Bits(uint32 bits, int num_bits)
+{
+    uint32 check = iRecvByte0 | (bits << iRecvByte0Pos);
+    int num_check = iRecvByte0Pos + num_bits;
+    // bit i of ones5 is set if bits i to i+4 of check are all 1's
+    uint32 ones5 = check & (check >> 1) & (check >> 2) & (check >> 3) & (check >> 4);
+    int pos = 0;
+    while (num_check - pos >= 6)
     {
-        cur_bit = (uint8)(cur_byte & 0x1);
-        cur_byte >>= 1;
-        iRecvByte0 = (uint8)(iRecvByte0 | (cur_bit << iRecvByte0Pos++));
-        if (iRecvByte0Pos == 6)
+        uint32 runs = (ones5 >> pos) & ((1 << (num_check - 5 - pos)) - 1);
+        if (runs == 0)
         {
-            if ((iRecvByte0 & 0x1F) == 0x1F)
-            {
-                //PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_STACK_TRACE, (0,"Level0PduParcom::Remove0Octet - skipping 0\n"));
-//              OSCL_ASSERT( (iRecvByte0 & 0x20) == 0);
-                if ((iRecvByte0&0x20) != 0)
-                {
-                    PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_STACK_TRACE, (0, "Level0PduParcom::Remove0Octet - Bitstream error.\n"));
-                }
-                // write out 5 1's and skip the following 0 bit
-                AppendBits0(5, 0x1F);
-                iRecvByte0Pos = 0;
-                iRecvByte0 = 0;
-            }
-            else
-            {
-                // write out the lsb
-                AppendBits0(1, iRecvByte0&01);
-                iRecvByte0Pos--;
-                iRecvByte0 >>= 1;
-            }
-
+            // no stuffed 0's, leave the last 5 bits for the next check
+            int num_out = num_check - 5 - pos;
+            AppendBits0(num_out, (check >> pos) & ((1 << num_out) - 1));
+            pos = num_check - 5;
+            break;
+        }
+        int num_out = LowestBitSet(runs) + 5;
+        if ((check >> (pos + num_out)) & 1)
+        {
+            PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_STACK_TRACE, (0, "Level0PduParcom::Remove0Bits - Bitstream error.\n"));
         }
+        // write out everything up to and including the 5 1's and skip the following 0 bit
+        AppendBits0(num_out, (check >> pos) & ((1 << num_out) - 1));
+        pos += num_out + 1;
     }
+    iRecvByte0Pos = num_check - pos;
+    iRecvByte0 = (check >> pos) & ((1 << iRecvByte0Pos) - 1);
 }
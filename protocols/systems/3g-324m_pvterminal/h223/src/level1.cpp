@@ -22,6 +22,32 @@
 #include "level1.h"
 #include "h223.h"
 
+#define LEVEL1_FLAG_LAST_OCTET 0x4d
+
+/* Returns the index of the first occurrence of c in buf, or len if there is none.  Four octets
+   are checked at a time: (v - 0x01010101) & ~v & 0x80808080 is non zero iff v has a zero octet. */
+static uint32 FindOctet(const uint8* buf, uint32 len, uint8 c)
+{
+    const uint32 pattern = c * 0x01010101U;
+    uint32 pos = 0;
+    while (pos + 4 <= len)
+    {
+        uint32 word;
+        oscl_memcpy(&word, buf + pos, 4);
+        word ^= pattern;
+        if ((word - 0x01010101U) & ~word & 0x80808080U)
+        {
+            break;
+        }
+        pos += 4;
+    }
+    while (pos < len && buf[pos] != c)
+    {
+        pos++;
+    }
+    return pos;
+}
+
 Level1PduParcom::Level1PduParcom(bool df):
         iDf(df)
 {
@@ -171,6 +197,14 @@ uint32 Level1PduParcom::Parse(uint8* bsbuf, uint32 bsbsz)
 
     for (unsigned num = 0; num < bsbsz; num++)
     {
+        if (iCurrentOp == ELookForEndFlag)
+        {
+            num += CopyPduData(bsbuf + num, bsbsz - num);
+            if (num == bsbsz)
+            {
+                break;
+            }
+        }
         iCurrentInt32 <<= 8;
         iCurrentInt32  |= bsbuf[num];
         switch (iCurrentOp)
@@ -227,3 +261,30 @@ uint32 Level1PduParcom::Parse(uint8* bsbuf, uint32 bsbsz)
     }
     return 1;
 }
+
+/* Copies pdu data up to the next octet that could end a flag.  Returns the number of octets consumed */
+uint32 Level1PduParcom::CopyPduData(uint8* bsbuf, uint32 bsbsz)
+{
+    uint32 space = H223_MAX_MUX_PDU_SIZE - (iPduPos - iPdu);
+    uint32 len = FindOctet(bsbuf, (bsbsz < space) ? bsbsz : space, LEVEL1_FLAG_LAST_OCTET);
+    if (len == 0)
+    {
+        return 0;
+    }
+    oscl_memcpy(iPduPos, bsbuf, len);
+    iPduPos += len;
+    // keep the last octets for the flag check
+    for (uint32 num = (len > 4) ? len - 4 : 0; num < len; num++)
+    {
+        iCurrentInt32 <<= 8;
+        iCurrentInt32 |= bsbuf[num];
+    }
+    // check for pdu size
+    if ((iPduPos - iPdu) == H223_MAX_MUX_PDU_SIZE)
+    {
+        iObserver->MuxPduErrIndicate(ESizeErr);
+        iPduPos = NULL;
+        iCurrentOp = ELookForStartFlag;
+    }
+    return len;
+}
@@ -461,6 +461,13 @@ Level2PduParcom::Level2PduParcom(bool oh, int closing_cur):
         }
         iNumOnes[n] = (uint8)cnt;
     }
+    // syndromes of each octet of a 23 bit golay code word, see GolayDec
+    for (int n = 0; n <= 0xFF; n++)
+    {
+        iSyndromeTab[0][n] = get_syndrome(n);
+        iSyndromeTab[1][n] = get_syndrome(n << 8);
+        iSyndromeTab[2][n] = (n <= 0x7F) ? get_syndrome(n << 16) : 0;
+    }
     uint8 HecCrc[18] =
     {
         0x00, 0x05, 0x07, 0x02, 0x03, 0x06, 0x04, 0x01,
@@ -674,6 +681,16 @@ uint32 Level2PduParcom::Parse(uint8* buf, uint32 bufsz)
         switch (iCurrentOp)
         {
             case ECopyHdr:
+                if (iThreshold == LEVEL2_THRESHOLD_SYNC && (iPduHdrPos - iPduHdr) == 1 && !iCopyPduWithSync)
+                {
+                    sz = SkipNonFlags(bsbuf, bsbsz);
+                    bsbuf += sz;
+                    bsbsz -= sz;
+                    if (bsbsz == 0)
+                    {
+                        break;
+                    }
+                }
                 *iPduHdrPos++ = *bsbuf++;
                 bsbsz--;
                 if (iCopyPduWithSync)
@@ -793,6 +810,38 @@ void Level2PduParcom::IndicatePdu(uint8 optional_header)
     iUseOh = false;
 }
 
+/* Fast path for the sync search.  While out of sync with one octet in the header, skips the octets that do
+   not complete a flag with the previous one.  This has the same effect as running them through ECopyHdr, as long
+   as there is no pdu to indicate.  Returns the number of octets skipped. */
+int Level2PduParcom::SkipNonFlags(uint8* bsbuf, int bsbsz)
+{
+    if (iMpl || (iMuxCode > 0) || iClosingCur)
+    {
+        return 0;
+    }
+    int num = 0;
+    uint8 prev = iPduHdr[0];
+    while (num < bsbsz)
+    {
+        uint16 match_cnt = (uint16)(iNumOnes[(prev ^ 0xE1)]  + iNumOnes[(bsbuf[num] ^ 0x4D)]);
+        if (match_cnt >= LEVEL2_THRESHOLD_SYNC || match_cnt <= (16 - LEVEL2_THRESHOLD_SYNC))
+        {
+            break;
+        }
+        PV_STAT_INCR_COND(iNumFlagErrorsRx, 1, (match_cnt % 16))
+        PV_STAT_INCR(iCumFlagErrorsRx, ((match_cnt > 8) ? (16 - match_cnt) : match_cnt))
+        PV_STAT_INCR_COND(iNumSyncLossRx, 1, iNumFlagsRx)
+        prev = bsbuf[num++];
+    }
+    if (num)
+    {
+        iPduHdr[0] = prev;
+        iClosingNextRx = 0;
+        IndicatePdu(0);
+    }
+    return num;
+}
+
 uint8* Level2PduParcom::FindSync(uint8* data, int len, int* closing)
 {
     uint8* ptr = data;
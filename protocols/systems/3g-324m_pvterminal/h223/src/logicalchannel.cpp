@@ -1436,6 +1436,7 @@ OsclAny H223IncomingChannel::AllocateAlPdu()
     {
         return;
     }
+    iAl->StartRxCrc();
     AppendAlPduFrag();
 }
 
@@ -1484,6 +1485,8 @@ uint32 H223IncomingChannel::CopyToCurrentFrag(uint8* buf, uint16 len)
     OSCL_ASSERT(space_in_current_frag > 0);
     uint32 num_bytes_copied = (len > space_in_current_frag) ? space_in_current_frag : len;
     oscl_memcpy(iAlPduFragPos, buf, num_bytes_copied);
+    // Run the AL CRC while the data is hot so that ParsePacket does not walk the pdu again
+    iAl->UpdateRxCrc(iAlPduFragPos, num_bytes_copied);
     iAlPduFrag.getMemFrag().len += num_bytes_copied;
     iAlPduFragPos += num_bytes_copied;
     space_in_current_frag -= num_bytes_copied;
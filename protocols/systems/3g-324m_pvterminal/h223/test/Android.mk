@@ -0,0 +1,33 @@
+LOCAL_PATH := $(call my-dir)
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES := \
+ 	src/h223_level_benchmark.cpp
+
+
+LOCAL_MODULE := pv_h223_level_benchmark
+
+LOCAL_CFLAGS :=  $(PV_CFLAGS)
+
+
+
+LOCAL_STATIC_LIBRARIES :=  
+
+LOCAL_SHARED_LIBRARIES := libopencore_2way libopencore_common
+
+LOCAL_C_INCLUDES := \
+	$(PV_TOP)/protocols/systems/3g-324m_pvterminal/h223/test/src \
+ 	$(PV_TOP)/protocols/systems/3g-324m_pvterminal/h223/test/src \
+ 	$(PV_TOP)/protocols/systems/3g-324m_pvterminal/h223/include \
+ 	$(PV_TOP)/protocols/systems/3g-324m_pvterminal/common/include \
+ 	$(PV_TOP)/protocols/systems/common/include \
+ 	$(PV_INCLUDES)
+
+LOCAL_COPY_HEADERS_TO := $(PV_COPY_HEADERS_TO)
+
+LOCAL_COPY_HEADERS := \
+ 	
+
+-include $(PV_TOP)/Android_system_extras.mk
+
+include $(BUILD_EXECUTABLE)
@@ -0,0 +1,23 @@
+# Get the current local path as the first operation
+LOCAL_PATH := $(call get_makefile_dir)
+
+# Clear out the variables used in the local makefiles
+include $(MK)/clear.mk
+
+TARGET := pv_h223_level_benchmark
+
+
+XCXXFLAGS += $(FLAG_COMPILE_WARNINGS_AS_ERRORS)
+
+XINCDIRS +=  ../../../include  ../../../../common/include  ../../../../../common/include
+
+SRCDIR := ../../src
+INCSRCDIR := ../../src
+
+SRCS := h223_level_benchmark.cpp
+
+LIBS := opencore_2way opencore_common
+
+SYSLIBS += $(SYS_THREAD_LIB)
+
+include $(MK)/prog.mk
@@ -0,0 +1,255 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+// Frames a stream of MUX-PDUs with each H.223 level parcom and parses it
+// back in fixed size reads, then reports the rates.  Level 0 is given as
+// 64 kbit/s calls per core since its bit stuffing is the costly part of
+// a call.  Levels 1 and 2 are also timed on random data, which keeps the
+// demultiplexer hunting for sync.  Every PDU must come back at its
+// original size or the run fails.
+
+#include "stdio.h"
+#include "oscl_base.h"
+#include "oscl_mem.h"
+#include "oscl_error.h"
+#include "oscl_tickcount.h"
+#include "pvlogger.h"
+#include "pvmf_media_frag_group.h"
+#include "level0.h"
+#include "level1.h"
+#include "level2.h"
+
+#define BENCH_NUM_PDUS          4096
+#define BENCH_PDU_SIZE          160
+#define BENCH_READ_SIZE         160
+#define BENCH_REPEAT            64
+#define BENCH_NOISE_SIZE        (1 << 20)
+#define BENCH_MAX_FRAGMENTS     4
+// generous for level 0, where stuffing can add a bit for every five
+#define BENCH_STREAM_SIZE       (BENCH_NUM_PDUS * (BENCH_PDU_SIZE * 2 + 16))
+#define BENCH_CALL_BITRATE      64000
+
+static uint8 BenchPayload[BENCH_PDU_SIZE];
+static uint8 BenchStream[BENCH_STREAM_SIZE];
+static uint8 BenchNoise[BENCH_NOISE_SIZE];
+static OsclMemAllocator BenchPacketAlloc;
+
+class BenchObserver : public H223PduParcomObserver
+{
+    public:
+        BenchObserver() : iNumPdus(0), iNumBadPdus(0) {}
+
+        uint32 MuxPduIndicate(uint8* aPdu, uint32 aPduSize, int32 aClosing, int32 aMuxCode)
+        {
+            OSCL_UNUSED_ARG(aPdu);
+            OSCL_UNUSED_ARG(aClosing);
+            OSCL_UNUSED_ARG(aMuxCode);
+            iNumPdus++;
+            if (aPduSize != BENCH_PDU_SIZE)
+            {
+                iNumBadPdus++;
+            }
+            return 0;
+        }
+        void MuxPduErrIndicate(EMuxPduError aErr)
+        {
+            OSCL_UNUSED_ARG(aErr);
+        }
+        void MuxSetupComplete(PVMFStatus aStatus, TPVH223Level aLevel)
+        {
+            OSCL_UNUSED_ARG(aStatus);
+            OSCL_UNUSED_ARG(aLevel);
+        }
+
+        uint32 iNumPdus;
+        uint32 iNumBadPdus;
+};
+
+static uint32 MbitPerSec(uint32 aBytes, uint32 aMsec)
+{
+    if (aMsec == 0)
+    {
+        aMsec = 1;
+    }
+    return (uint32)((aBytes * 8.0) / (aMsec * 1000.0));
+}
+
+static uint32 ElapsedMsec(uint32 aStartTicks)
+{
+    uint32 msec = OsclTickCount::TicksToMsec(OsclTickCount::TickCount() - aStartTicks);
+    return msec ? msec : 1;
+}
+
+// Completes BENCH_NUM_PDUS packets the way the multiplex does and
+// copies the framed bytes out.  Returns the stream size.
+static uint32 BuildStream(H223PduParcom* aParcom, PVMFMediaFragGroupCombinedAlloc<OsclMemAllocator>* aAlloc)
+{
+    OsclMemoryFragment payload;
+    payload.ptr = BenchPayload;
+    payload.len = BENCH_PDU_SIZE;
+    OsclRefCounterMemFrag payloadFrag(payload, NULL, BENCH_PDU_SIZE);
+
+    uint32 streamSize = 0;
+    for (uint32 i = 0; i < BENCH_NUM_PDUS; i++)
+    {
+        OsclSharedPtr<PVMFMediaDataImpl> pdu = aAlloc->allocate(BENCH_MAX_FRAGMENTS);
+        OsclRefCounterMemFrag frag;
+        aParcom->GetHdrFragment(frag);
+        pdu->appendMediaFragment(frag);
+        pdu->appendMediaFragment(payloadFrag);
+        aParcom->CompletePdu(pdu, (int8)(1 + (i % 15)), 0);
+
+        for (uint32 j = 0; j < pdu->getNumFragments(); j++)
+        {
+            pdu->getMediaFragment(j, frag);
+            oscl_memcpy(BenchStream + streamSize, frag.getMemFragPtr(), frag.getMemFragSize());
+            streamSize += frag.getMemFragSize();
+        }
+    }
+    // closes the last PDU
+    streamSize += aParcom->GetStuffing(BenchStream + streamSize, aParcom->GetStuffingSz());
+    return streamSize;
+}
+
+static void ParseStream(H223PduParcom* aParcom, uint8* aData, uint32 aSize)
+{
+    uint32 offset = 0;
+    while (offset < aSize)
+    {
+        uint32 len = aSize - offset;
+        if (len > BENCH_READ_SIZE)
+        {
+            len = BENCH_READ_SIZE;
+        }
+        aParcom->Parse(aData + offset, len);
+        offset += len;
+    }
+}
+
+static int RunLevel(const char* aName, H223PduParcom* aParcom, bool aNoise)
+{
+    BenchObserver observer;
+    aParcom->SetObserver(&observer);
+    aParcom->Construct(BENCH_MAX_FRAGMENTS);
+
+    PVMFMediaFragGroupCombinedAlloc<OsclMemAllocator>* alloc =
+        OSCL_NEW(PVMFMediaFragGroupCombinedAlloc<OsclMemAllocator>, (BENCH_MAX_FRAGMENTS, BENCH_MAX_FRAGMENTS, &BenchPacketAlloc));
+    alloc->create();
+
+    uint32 start = OsclTickCount::TickCount();
+    uint32 streamSize = 0;
+    for (uint32 rep = 0; rep < BENCH_REPEAT; rep++)
+    {
+        streamSize = BuildStream(aParcom, alloc);
+    }
+    uint32 txMsec = ElapsedMsec(start);
+    alloc->removeRef();
+
+    start = OsclTickCount::TickCount();
+    for (uint32 rep = 0; rep < BENCH_REPEAT; rep++)
+    {
+        ParseStream(aParcom, BenchStream, streamSize);
+    }
+    uint32 rxMsec = ElapsedMsec(start);
+
+    // level 2 may drop the first PDU while it gets in sync.
+    uint32 expected = BENCH_NUM_PDUS * BENCH_REPEAT;
+    if ((observer.iNumBadPdus != 0) || (observer.iNumPdus + 1 < expected) ||
+            (observer.iNumPdus > expected))
+    {
+        printf("%s: parsed %d PDUs, %d of the wrong size, expected %d\n", aName,
+               observer.iNumPdus, observer.iNumBadPdus, expected);
+        return 1;
+    }
+
+    uint32 payloadBytes = BENCH_NUM_PDUS * BENCH_PDU_SIZE * BENCH_REPEAT;
+    printf("%s: %d byte PDUs framed at %d Mbit/s, parsed at %d Mbit/s (%d stream bytes)\n",
+           aName, BENCH_PDU_SIZE, MbitPerSec(payloadBytes, txMsec),
+           MbitPerSec(payloadBytes, rxMsec), streamSize);
+    if (!aNoise)
+    {
+        // a call sends and receives BENCH_CALL_BITRATE each way
+        uint32 callMsec = (uint32)(((double)payloadBytes * 8 * 1000) / BENCH_CALL_BITRATE);
+        printf("%s: about %d calls per core\n", aName, callMsec / (txMsec + rxMsec));
+        return 0;
+    }
+
+    start = OsclTickCount::TickCount();
+    for (uint32 rep = 0; rep < BENCH_REPEAT; rep++)
+    {
+        ParseStream(aParcom, BenchNoise, BENCH_NOISE_SIZE);
+    }
+    printf("%s: random data scanned at %d Mbit/s\n", aName,
+           MbitPerSec(BENCH_NOISE_SIZE * BENCH_REPEAT, ElapsedMsec(start)));
+    return 0;
+}
+
+static int RunBenchmark()
+{
+    uint32 seed = 0x12345678;
+    for (uint32 i = 0; i < BENCH_PDU_SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        // levels 1 and 2 send no escapes, so the payload must not hold a flag
+        BenchPayload[i] = (uint8)(seed >> 16);
+        if (BenchPayload[i] == 0xe1 || BenchPayload[i] == 0x1e)
+        {
+            BenchPayload[i]++;
+        }
+    }
+    for (uint32 i = 0; i < BENCH_NOISE_SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        BenchNoise[i] = (uint8)(seed >> 16);
+    }
+
+    int result = 0;
+    H223PduParcom* parcom = OSCL_NEW(Level0PduParcom, ());
+    result |= RunLevel("level 0", parcom, false);
+    OSCL_DELETE(parcom);
+
+    parcom = OSCL_NEW(Level1PduParcom, (false));
+    result |= RunLevel("level 1", parcom, true);
+    OSCL_DELETE(parcom);
+
+    parcom = OSCL_NEW(Level2PduParcom, (false));
+    result |= RunLevel("level 2", parcom, true);
+    OSCL_DELETE(parcom);
+    return result;
+}
+
+int main()
+{
+    OsclBase::Init();
+    OsclErrorTrap::Init();
+    OsclMem::Init();
+    PVLogger::Init();
+
+    int result = 1;
+    int32 err = 0;
+    OSCL_TRY(err, result = RunBenchmark(););
+    if (err)
+    {
+        printf("leave %d\n", err);
+    }
+
+    PVLogger::Cleanup();
+    OsclMem::Cleanup();
+    OsclErrorTrap::Cleanup();
+    OsclBase::Cleanup();
+    return result;
+}
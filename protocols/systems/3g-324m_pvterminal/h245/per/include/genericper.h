@@ -21,6 +21,8 @@
 #include "oscl_base.h"
 #include "per_common.h"
 
+class PerArena;
+
 /*========================================*/
 /*========== MISCELLANEOUS DEFS ==========*/
 /*========================================*/
@@ -76,6 +78,7 @@ typedef struct _InStream    /* Input Stream */
 {
     uint8* data;           /* Current byte in stream */
     uint8 bitIndex;        /* Next bit within the byte */
+    PerArena* arena;       /* Holds decoded data, NULL for heap */
 } S_InStream;
 
 typedef S_InStream *PS_InStream;
@@ -114,6 +117,12 @@ void  GetCharString(const char *stringName,
                     PS_int8STRING x, PS_InStream stream);
 void  GetObjectID(PS_OBJECTIDENT x, PS_InStream stream);
 
+/* ------------- DECODED DATA ------------- */
+OsclAny* PerDecodeMalloc(PS_InStream stream, uint32 size);
+/* Allocates decoded data from stream->arena, or the heap if none */
+void PerDecodeFree(PS_InStream stream, OsclAny* ptr);
+/* Frees PerDecodeMalloc data; a no-op for arena data */
+
 /* ------------- OTHER CALLS ----------------*/
 uint32 GetLengthDet(PS_InStream stream);
 /* General length det, e.g. for extension wrapper */
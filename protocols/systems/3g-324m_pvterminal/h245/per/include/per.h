@@ -36,6 +36,7 @@
 class H245;
 class SE;
 class PVLogger;
+class PerArena;
 
 class PER
 {
@@ -57,13 +58,11 @@ class PER
         OSCL_IMPORT_REF void Encode(PS_H245Msg pmsg);
         OSCL_IMPORT_REF void Decode(uint8* pbuffer, uint32 size);
 
-        static void DeleteMessage(uint8, uint8, uint8*);
-
     private:
         bool Decode(int& nBytes, uint8* pBuffer, uint16& GetSize, uint8*& pData,
-                    uint8& MsgType1, uint8& MsgType2);
+                    uint8& MsgType1, uint8& MsgType2, PerArena* pArena);
         void MultiSysCtrlMessage_encode(uint16*, uint8* *, uint8*, uint8, uint8);
-        int MultiSysCtrlMessage_decode(uint8*, uint16*, uint8*  *, uint8*, uint8*);
+        int MultiSysCtrlMessage_decode(uint8*, uint16*, uint8*  *, uint8*, uint8*, PerArena*);
         void RequestMessage_encode(uint8*, uint8, PS_OutStream);
         void ResponseMessage_encode(uint8*, uint8, PS_OutStream);
         void CommandMessage_encode(uint8*, uint8, PS_OutStream);
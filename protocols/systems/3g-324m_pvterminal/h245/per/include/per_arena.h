@@ -0,0 +1,92 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#ifndef PER_ARENA_H_INCLUDED
+#define PER_ARENA_H_INCLUDED
+
+#ifndef OSCL_BASE_H_INCLUDED
+#include "oscl_base.h"
+#endif
+
+/* Alignment of every arena allocation. */
+#define PER_ARENA_ALIGN 8
+#define PER_ARENA_ROUND(x) (((x) + (PER_ARENA_ALIGN - 1)) & ~(uint32)(PER_ARENA_ALIGN - 1))
+
+/* Size of the first overflow block, doubled for each further one. */
+#define PER_ARENA_BLOCK_SIZE 2048
+#define PER_ARENA_MAX_BLOCK_SIZE 32768
+
+/**
+ * Bump allocator for the structures built by the PER decoder.
+ *
+ * A decoded H.245 message is a tree of many small allocations which
+ * are all released together.  The arena hands them out from a buffer
+ * supplied by the owner and chains further heap blocks when that runs
+ * out.  Individual allocations are never freed; everything goes when
+ * the arena is reset or destroyed.  Alloc leaves with OsclErrNoMemory
+ * if a block cannot be allocated.
+ *
+ * The owner's buffer must be PER_ARENA_ALIGN aligned; it may be NULL,
+ * in which case everything comes from heap blocks.
+ */
+class PerArena
+{
+    public:
+        PerArena(OsclAny* aBuffer, uint32 aSize);
+        ~PerArena();
+
+        OsclAny* Alloc(uint32 aSize)
+        {
+            aSize = PER_ARENA_ROUND(aSize);
+            if (aSize > (uint32)(iEnd - iCur))
+            {
+                return AllocBlock(aSize);
+            }
+            OsclAny* ptr = iCur;
+            iCur += aSize;
+            return ptr;
+        }
+
+        /* Releases the overflow blocks and starts again at the buffer. */
+        void Reset();
+
+        /* Bytes handed out since construction or the last Reset. */
+        uint32 BytesUsed() const
+        {
+            return iUsedInBlocks + (uint32)(iCur - iBlockStart);
+        }
+
+    private:
+        struct Block
+        {
+            Block* iNext;
+        };
+
+        OsclAny* AllocBlock(uint32 aSize);
+        void FreeBlocks();
+
+        uint8* iBuffer;
+        uint8* iBufferEnd;
+        uint8* iBlockStart;
+        uint8* iCur;
+        uint8* iEnd;
+        Block* iBlocks;
+        uint32 iNextBlockSize;
+        uint32 iUsedInBlocks;
+};
+
+#endif
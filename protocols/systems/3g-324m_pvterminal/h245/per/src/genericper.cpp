@@ -38,6 +38,7 @@
 #include "per_headers.h"
 #include "analyzeper.h"
 #include "genericper.h"
+#include "per_arena.h"
 #include "oscl_error_codes.h"
 #include "oscl_mem.h"
 #include "oscl_stdstring.h"
@@ -396,7 +397,7 @@ void GetOctetString(uint8 unbounded, uint32 min, uint32 max,
         x->size = (uint16) GetLengthDet(stream);
         if (x->size)
         {
-            x->data = (uint8*) OSCL_DEFAULT_MALLOC(x->size * sizeof(uint8));
+            x->data = (uint8*) PerDecodeMalloc(stream, x->size * sizeof(uint8));
             ReadOctets(x->size, x->data, 0, stream);
         }
         else
@@ -417,7 +418,7 @@ void GetOctetString(uint8 unbounded, uint32 min, uint32 max,
             x->size = (uint16) min;
             if (x->size)
             {
-                x->data = (uint8*) OSCL_DEFAULT_MALLOC(x->size * sizeof(uint8));
+                x->data = (uint8*) PerDecodeMalloc(stream, x->size * sizeof(uint8));
                 if (x->size > 2)
                 {
                     ReadOctets(x->size, x->data, 0, stream);
@@ -442,7 +443,7 @@ void GetOctetString(uint8 unbounded, uint32 min, uint32 max,
             x->size = (uint16) GetInteger(min, max, stream);
             if (x->size)
             {
-                x->data = (uint8*) OSCL_DEFAULT_MALLOC(x->size * sizeof(uint8));
+                x->data = (uint8*) PerDecodeMalloc(stream, x->size * sizeof(uint8));
                 ReadOctets(x->size, x->data, 0, stream);
             }
             else
@@ -470,7 +471,7 @@ void GetBitString(uint8 unbounded, uint32 min, uint32 max,
     {
         count = GetLengthDet(stream);
         x->size = (uint16) count;
-        temp = x->data = (uint8*) OSCL_DEFAULT_MALLOC((1 + x->size / 8) * sizeof(uint8));
+        temp = x->data = (uint8*) PerDecodeMalloc(stream, (1 + x->size / 8) * sizeof(uint8));
         while (count >= 8)
         {
             temp[0] = ReadBits(8, stream);
@@ -491,7 +492,7 @@ void GetBitString(uint8 unbounded, uint32 min, uint32 max,
         {
             count = min;
             x->size = (uint16) count;
-            temp = x->data = (uint8*) OSCL_DEFAULT_MALLOC((1 + x->size / 8) * sizeof(uint8));
+            temp = x->data = (uint8*) PerDecodeMalloc(stream, (1 + x->size / 8) * sizeof(uint8));
             if (x->size > 16)
             {
                 ReadRemainingBits(stream);  /* Octet align */
@@ -508,7 +509,7 @@ void GetBitString(uint8 unbounded, uint32 min, uint32 max,
         {
             count = GetInteger(min, max, stream);
             x->size = (uint16) count;
-            temp = x->data = (uint8*) OSCL_DEFAULT_MALLOC((1 + x->size / 8) * sizeof(uint8));
+            temp = x->data = (uint8*) PerDecodeMalloc(stream, (1 + x->size / 8) * sizeof(uint8));
             ReadRemainingBits(stream);
             while (count >= 8)
             {
@@ -547,7 +548,7 @@ void GetCharString(const char *stringName,
             oscl_strncmp(from, "0123456789#*ABCD!", oscl_strlen("0123456789#*ABCD!")) == 0)
     {
         x->size = 2;
-        x->data = (uint8*) OSCL_DEFAULT_MALLOC(x->size * sizeof(uint8));
+        x->data = (uint8*) PerDecodeMalloc(stream, x->size * sizeof(uint8));
         x->data[0] = ReadBits(8, stream);     // Read single character,
         // Normal ascii value, not octet aligned
         x->data[1] = 0;  // NULL terminate
@@ -555,7 +556,7 @@ void GetCharString(const char *stringName,
     else if (oscl_strncmp(stringName, "GeneralString", oscl_strlen("GeneralString")) == 0)   // Validate GeneralString case  (RAN-ALPHA)
     {
         x->size = (uint16)(1 + GetLengthDet(stream)); // (leave extra space for NULL)
-        x->data = (uint8*) OSCL_DEFAULT_MALLOC(x->size * sizeof(uint8));
+        x->data = (uint8*) PerDecodeMalloc(stream, x->size * sizeof(uint8));
         ReadOctets(x->size - 1, x->data, 1, stream);
         x->data[x->size-1] = 0;  // NULL terminate
     }
@@ -579,7 +580,7 @@ void GetObjectID(PS_OBJECTIDENT x, PS_InStream stream)
     x->size = (uint16) GetLengthDet(stream);
     if (x->size)
     {
-        x->data = (uint8*) OSCL_DEFAULT_MALLOC(x->size * sizeof(uint8));
+        x->data = (uint8*) PerDecodeMalloc(stream, x->size * sizeof(uint8));
         ReadOctets(x->size, x->data, 0, stream);
     }
     else
@@ -589,6 +590,43 @@ void GetObjectID(PS_OBJECTIDENT x, PS_InStream stream)
 }
 
 
+/* --------------------------------------------- */
+/* --------------- DECODED DATA -----------------*/
+/* --------------------------------------------- */
+
+// =========================================================
+// PerDecodeMalloc()
+//
+// Allocates space for decoded data.  Messages decoded by
+// PER::Decode() carry an arena in the stream and are
+// released as a whole with it.  Streams without an arena
+// (e.g. the Copy_*() routines) use the heap, and their
+// results are freed with the Delete_*() routines.
+// =========================================================
+OsclAny* PerDecodeMalloc(PS_InStream stream, uint32 size)
+{
+    if (stream->arena)
+    {
+        return stream->arena->Alloc(size);
+    }
+    return OSCL_DEFAULT_MALLOC(size);
+}
+
+// =========================================================
+// PerDecodeFree()
+//
+// Frees data from PerDecodeMalloc().  Arena data is left
+// for the arena to release.
+// =========================================================
+void PerDecodeFree(PS_InStream stream, OsclAny* ptr)
+{
+    if (stream->arena == NULL)
+    {
+        OSCL_DEFAULT_FREE(ptr);
+    }
+}
+
+
 /* --------------------------------------------- */
 /* --------------- OTHER CALLS ------------------*/
 /* --------------------------------------------- */
@@ -775,10 +813,10 @@ PS_UnknownSigMap GetUnknownSigMap(PS_InStream stream)
     int32 i;
     PS_UnknownSigMap x;
 
-    x = (PS_UnknownSigMap) OSCL_DEFAULT_MALLOC(sizeof(S_UnknownSigMap));
+    x = (PS_UnknownSigMap) PerDecodeMalloc(stream, sizeof(S_UnknownSigMap));
 
     x->size = (uint16) GetNormSmallLength(stream);
-    x->optionFlags = (uint8*) OSCL_DEFAULT_MALLOC(x->size * sizeof(uint8));
+    x->optionFlags = (uint8*) PerDecodeMalloc(stream, x->size * sizeof(uint8));
     for (i = 0; i < x->size; ++i)
     {
         x->optionFlags[i] = ReadBits(1, stream);
@@ -861,8 +899,8 @@ uint32 SkipUnreadExtensions(PS_UnknownSigMap map, PS_InStream stream)
     }
 
     /* Free map, return number skipped */
-    OSCL_DEFAULT_FREE(map->optionFlags);
-    OSCL_DEFAULT_FREE(map);
+    PerDecodeFree(stream, map->optionFlags);
+    PerDecodeFree(stream, map);
 
     return(numExtensions);
 }
@@ -1623,7 +1661,7 @@ void PutLengthDet(uint32 value, PS_OutStream stream)
     else if (value < 16384)   /* Two octets with leading '10' */
     {
         bytes = (uint16)(value | mask);
-        WriteOctets(2, (uint8*)&bytes, 0, stream);
+        WriteOctets(2, (uint8*)&bytes, 1, stream);  /* Most significant first */
     }
     else
     {
@@ -1687,6 +1725,7 @@ PS_InStream ConvertOutstreamToInstream(PS_OutStream outstream)
     instream = (PS_InStream) OSCL_DEFAULT_MALLOC(sizeof(S_InStream));
     instream->data = outstream->data;
     instream->bitIndex = 0;
+    instream->arena = NULL;
 
     OSCL_DEFAULT_FREE(outstream);
     return(instream);
@@ -39,19 +39,19 @@ void Decode_MultimediaSystemControlMessage(PS_MultimediaSystemControlMessage x,
     switch (x->index)
     {
         case 0:
-            x->request = (PS_RequestMessage) OSCL_DEFAULT_MALLOC(sizeof(S_RequestMessage));
+            x->request = (PS_RequestMessage) PerDecodeMalloc(stream, sizeof(S_RequestMessage));
             Decode_RequestMessage(x->request, stream);
             break;
         case 1:
-            x->response = (PS_ResponseMessage) OSCL_DEFAULT_MALLOC(sizeof(S_ResponseMessage));
+            x->response = (PS_ResponseMessage) PerDecodeMalloc(stream, sizeof(S_ResponseMessage));
             Decode_ResponseMessage(x->response, stream);
             break;
         case 2:
-            x->command = (PS_CommandMessage) OSCL_DEFAULT_MALLOC(sizeof(S_CommandMessage));
+            x->command = (PS_CommandMessage) PerDecodeMalloc(stream, sizeof(S_CommandMessage));
             Decode_CommandMessage(x->command, stream);
             break;
         case 3:
-            x->indication = (PS_IndicationMessage) OSCL_DEFAULT_MALLOC(sizeof(S_IndicationMessage));
+            x->indication = (PS_IndicationMessage) PerDecodeMalloc(stream, sizeof(S_IndicationMessage));
             Decode_IndicationMessage(x->indication, stream);
             break;
             /* ------------------------------- */
@@ -72,47 +72,47 @@ void Decode_RequestMessage(PS_RequestMessage x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardMessage) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardMessage));
+            x->nonStandard = (PS_NonStandardMessage) PerDecodeMalloc(stream, sizeof(S_NonStandardMessage));
             Decode_NonStandardMessage(x->nonStandard, stream);
             break;
         case 1:
-            x->masterSlaveDetermination = (PS_MasterSlaveDetermination) OSCL_DEFAULT_MALLOC(sizeof(S_MasterSlaveDetermination));
+            x->masterSlaveDetermination = (PS_MasterSlaveDetermination) PerDecodeMalloc(stream, sizeof(S_MasterSlaveDetermination));
             Decode_MasterSlaveDetermination(x->masterSlaveDetermination, stream);
             break;
         case 2:
-            x->terminalCapabilitySet = (PS_TerminalCapabilitySet) OSCL_DEFAULT_MALLOC(sizeof(S_TerminalCapabilitySet));
+            x->terminalCapabilitySet = (PS_TerminalCapabilitySet) PerDecodeMalloc(stream, sizeof(S_TerminalCapabilitySet));
             Decode_TerminalCapabilitySet(x->terminalCapabilitySet, stream);
             break;
         case 3:
-            x->openLogicalChannel = (PS_OpenLogicalChannel) OSCL_DEFAULT_MALLOC(sizeof(S_OpenLogicalChannel));
+            x->openLogicalChannel = (PS_OpenLogicalChannel) PerDecodeMalloc(stream, sizeof(S_OpenLogicalChannel));
             Decode_OpenLogicalChannel(x->openLogicalChannel, stream);
             break;
         case 4:
-            x->closeLogicalChannel = (PS_CloseLogicalChannel) OSCL_DEFAULT_MALLOC(sizeof(S_CloseLogicalChannel));
+            x->closeLogicalChannel = (PS_CloseLogicalChannel) PerDecodeMalloc(stream, sizeof(S_CloseLogicalChannel));
             Decode_CloseLogicalChannel(x->closeLogicalChannel, stream);
             break;
         case 5:
-            x->requestChannelClose = (PS_RequestChannelClose) OSCL_DEFAULT_MALLOC(sizeof(S_RequestChannelClose));
+            x->requestChannelClose = (PS_RequestChannelClose) PerDecodeMalloc(stream, sizeof(S_RequestChannelClose));
             Decode_RequestChannelClose(x->requestChannelClose, stream);
             break;
         case 6:
-            x->multiplexEntrySend = (PS_MultiplexEntrySend) OSCL_DEFAULT_MALLOC(sizeof(S_MultiplexEntrySend));
+            x->multiplexEntrySend = (PS_MultiplexEntrySend) PerDecodeMalloc(stream, sizeof(S_MultiplexEntrySend));
             Decode_MultiplexEntrySend(x->multiplexEntrySend, stream);
             break;
         case 7:
-            x->requestMultiplexEntry = (PS_RequestMultiplexEntry) OSCL_DEFAULT_MALLOC(sizeof(S_RequestMultiplexEntry));
+            x->requestMultiplexEntry = (PS_RequestMultiplexEntry) PerDecodeMalloc(stream, sizeof(S_RequestMultiplexEntry));
             Decode_RequestMultiplexEntry(x->requestMultiplexEntry, stream);
             break;
         case 8:
-            x->requestMode = (PS_RequestMode) OSCL_DEFAULT_MALLOC(sizeof(S_RequestMode));
+            x->requestMode = (PS_RequestMode) PerDecodeMalloc(stream, sizeof(S_RequestMode));
             Decode_RequestMode(x->requestMode, stream);
             break;
         case 9:
-            x->roundTripDelayRequest = (PS_RoundTripDelayRequest) OSCL_DEFAULT_MALLOC(sizeof(S_RoundTripDelayRequest));
+            x->roundTripDelayRequest = (PS_RoundTripDelayRequest) PerDecodeMalloc(stream, sizeof(S_RoundTripDelayRequest));
             Decode_RoundTripDelayRequest(x->roundTripDelayRequest, stream);
             break;
         case 10:
-            x->maintenanceLoopRequest = (PS_MaintenanceLoopRequest) OSCL_DEFAULT_MALLOC(sizeof(S_MaintenanceLoopRequest));
+            x->maintenanceLoopRequest = (PS_MaintenanceLoopRequest) PerDecodeMalloc(stream, sizeof(S_MaintenanceLoopRequest));
             Decode_MaintenanceLoopRequest(x->maintenanceLoopRequest, stream);
             break;
             /* ------------------------------- */
@@ -120,25 +120,25 @@ void Decode_RequestMessage(PS_RequestMessage x, PS_InStream stream)
             /* ------------------------------- */
         case 11:
             GetLengthDet(stream);
-            x->communicationModeRequest = (PS_CommunicationModeRequest) OSCL_DEFAULT_MALLOC(sizeof(S_CommunicationModeRequest));
+            x->communicationModeRequest = (PS_CommunicationModeRequest) PerDecodeMalloc(stream, sizeof(S_CommunicationModeRequest));
             Decode_CommunicationModeRequest(x->communicationModeRequest, stream);
             ReadRemainingBits(stream);
             break;
         case 12:
             GetLengthDet(stream);
-            x->conferenceRequest = (PS_ConferenceRequest) OSCL_DEFAULT_MALLOC(sizeof(S_ConferenceRequest));
+            x->conferenceRequest = (PS_ConferenceRequest) PerDecodeMalloc(stream, sizeof(S_ConferenceRequest));
             Decode_ConferenceRequest(x->conferenceRequest, stream);
             ReadRemainingBits(stream);
             break;
         case 13:
             GetLengthDet(stream);
-            x->multilinkRequest = (PS_MultilinkRequest) OSCL_DEFAULT_MALLOC(sizeof(S_MultilinkRequest));
+            x->multilinkRequest = (PS_MultilinkRequest) PerDecodeMalloc(stream, sizeof(S_MultilinkRequest));
             Decode_MultilinkRequest(x->multilinkRequest, stream);
             ReadRemainingBits(stream);
             break;
         case 14:
             GetLengthDet(stream);
-            x->logicalChannelRateRequest = (PS_LogicalChannelRateRequest) OSCL_DEFAULT_MALLOC(sizeof(S_LogicalChannelRateRequest));
+            x->logicalChannelRateRequest = (PS_LogicalChannelRateRequest) PerDecodeMalloc(stream, sizeof(S_LogicalChannelRateRequest));
             Decode_LogicalChannelRateRequest(x->logicalChannelRateRequest, stream);
             ReadRemainingBits(stream);
             break;
@@ -157,79 +157,79 @@ void Decode_ResponseMessage(PS_ResponseMessage x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardMessage) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardMessage));
+            x->nonStandard = (PS_NonStandardMessage) PerDecodeMalloc(stream, sizeof(S_NonStandardMessage));
             Decode_NonStandardMessage(x->nonStandard, stream);
             break;
         case 1:
-            x->masterSlaveDeterminationAck = (PS_MasterSlaveDeterminationAck) OSCL_DEFAULT_MALLOC(sizeof(S_MasterSlaveDeterminationAck));
+            x->masterSlaveDeterminationAck = (PS_MasterSlaveDeterminationAck) PerDecodeMalloc(stream, sizeof(S_MasterSlaveDeterminationAck));
             Decode_MasterSlaveDeterminationAck(x->masterSlaveDeterminationAck, stream);
             break;
         case 2:
-            x->masterSlaveDeterminationReject = (PS_MasterSlaveDeterminationReject) OSCL_DEFAULT_MALLOC(sizeof(S_MasterSlaveDeterminationReject));
+            x->masterSlaveDeterminationReject = (PS_MasterSlaveDeterminationReject) PerDecodeMalloc(stream, sizeof(S_MasterSlaveDeterminationReject));
             Decode_MasterSlaveDeterminationReject(x->masterSlaveDeterminationReject, stream);
             break;
         case 3:
-            x->terminalCapabilitySetAck = (PS_TerminalCapabilitySetAck) OSCL_DEFAULT_MALLOC(sizeof(S_TerminalCapabilitySetAck));
+            x->terminalCapabilitySetAck = (PS_TerminalCapabilitySetAck) PerDecodeMalloc(stream, sizeof(S_TerminalCapabilitySetAck));
             Decode_TerminalCapabilitySetAck(x->terminalCapabilitySetAck, stream);
             break;
         case 4:
-            x->terminalCapabilitySetReject = (PS_TerminalCapabilitySetReject) OSCL_DEFAULT_MALLOC(sizeof(S_TerminalCapabilitySetReject));
+            x->terminalCapabilitySetReject = (PS_TerminalCapabilitySetReject) PerDecodeMalloc(stream, sizeof(S_TerminalCapabilitySetReject));
             Decode_TerminalCapabilitySetReject(x->terminalCapabilitySetReject, stream);
             break;
         case 5:
-            x->openLogicalChannelAck = (PS_OpenLogicalChannelAck) OSCL_DEFAULT_MALLOC(sizeof(S_OpenLogicalChannelAck));
+            x->openLogicalChannelAck = (PS_OpenLogicalChannelAck) PerDecodeMalloc(stream, sizeof(S_OpenLogicalChannelAck));
             Decode_OpenLogicalChannelAck(x->openLogicalChannelAck, stream);
             break;
         case 6:
-            x->openLogicalChannelReject = (PS_OpenLogicalChannelReject) OSCL_DEFAULT_MALLOC(sizeof(S_OpenLogicalChannelReject));
+            x->openLogicalChannelReject = (PS_OpenLogicalChannelReject) PerDecodeMalloc(stream, sizeof(S_OpenLogicalChannelReject));
             Decode_OpenLogicalChannelReject(x->openLogicalChannelReject, stream);
             break;
         case 7:
-            x->closeLogicalChannelAck = (PS_CloseLogicalChannelAck) OSCL_DEFAULT_MALLOC(sizeof(S_CloseLogicalChannelAck));
+            x->closeLogicalChannelAck = (PS_CloseLogicalChannelAck) PerDecodeMalloc(stream, sizeof(S_CloseLogicalChannelAck));
             Decode_CloseLogicalChannelAck(x->closeLogicalChannelAck, stream);
             break;
         case 8:
-            x->requestChannelCloseAck = (PS_RequestChannelCloseAck) OSCL_DEFAULT_MALLOC(sizeof(S_RequestChannelCloseAck));
+            x->requestChannelCloseAck = (PS_RequestChannelCloseAck) PerDecodeMalloc(stream, sizeof(S_RequestChannelCloseAck));
             Decode_RequestChannelCloseAck(x->requestChannelCloseAck, stream);
             break;
         case 9:
-            x->requestChannelCloseReject = (PS_RequestChannelCloseReject) OSCL_DEFAULT_MALLOC(sizeof(S_RequestChannelCloseReject));
+            x->requestChannelCloseReject = (PS_RequestChannelCloseReject) PerDecodeMalloc(stream, sizeof(S_RequestChannelCloseReject));
             Decode_RequestChannelCloseReject(x->requestChannelCloseReject, stream);
             break;
         case 10:
-            x->multiplexEntrySendAck = (PS_MultiplexEntrySendAck) OSCL_DEFAULT_MALLOC(sizeof(S_MultiplexEntrySendAck));
+            x->multiplexEntrySendAck = (PS_MultiplexEntrySendAck) PerDecodeMalloc(stream, sizeof(S_MultiplexEntrySendAck));
             Decode_MultiplexEntrySendAck(x->multiplexEntrySendAck, stream);
             break;
         case 11:
-            x->multiplexEntrySendReject = (PS_MultiplexEntrySendReject) OSCL_DEFAULT_MALLOC(sizeof(S_MultiplexEntrySendReject));
+            x->multiplexEntrySendReject = (PS_MultiplexEntrySendReject) PerDecodeMalloc(stream, sizeof(S_MultiplexEntrySendReject));
             Decode_MultiplexEntrySendReject(x->multiplexEntrySendReject, stream);
             break;
         case 12:
-            x->requestMultiplexEntryAck = (PS_RequestMultiplexEntryAck) OSCL_DEFAULT_MALLOC(sizeof(S_RequestMultiplexEntryAck));
+            x->requestMultiplexEntryAck = (PS_RequestMultiplexEntryAck) PerDecodeMalloc(stream, sizeof(S_RequestMultiplexEntryAck));
             Decode_RequestMultiplexEntryAck(x->requestMultiplexEntryAck, stream);
             break;
         case 13:
-            x->requestMultiplexEntryReject = (PS_RequestMultiplexEntryReject) OSCL_DEFAULT_MALLOC(sizeof(S_RequestMultiplexEntryReject));
+            x->requestMultiplexEntryReject = (PS_RequestMultiplexEntryReject) PerDecodeMalloc(stream, sizeof(S_RequestMultiplexEntryReject));
             Decode_RequestMultiplexEntryReject(x->requestMultiplexEntryReject, stream);
             break;
         case 14:
-            x->requestModeAck = (PS_RequestModeAck) OSCL_DEFAULT_MALLOC(sizeof(S_RequestModeAck));
+            x->requestModeAck = (PS_RequestModeAck) PerDecodeMalloc(stream, sizeof(S_RequestModeAck));
             Decode_RequestModeAck(x->requestModeAck, stream);
             break;
         case 15:
-            x->requestModeReject = (PS_RequestModeReject) OSCL_DEFAULT_MALLOC(sizeof(S_RequestModeReject));
+            x->requestModeReject = (PS_RequestModeReject) PerDecodeMalloc(stream, sizeof(S_RequestModeReject));
             Decode_RequestModeReject(x->requestModeReject, stream);
             break;
         case 16:
-            x->roundTripDelayResponse = (PS_RoundTripDelayResponse) OSCL_DEFAULT_MALLOC(sizeof(S_RoundTripDelayResponse));
+            x->roundTripDelayResponse = (PS_RoundTripDelayResponse) PerDecodeMalloc(stream, sizeof(S_RoundTripDelayResponse));
             Decode_RoundTripDelayResponse(x->roundTripDelayResponse, stream);
             break;
         case 17:
-            x->maintenanceLoopAck = (PS_MaintenanceLoopAck) OSCL_DEFAULT_MALLOC(sizeof(S_MaintenanceLoopAck));
+            x->maintenanceLoopAck = (PS_MaintenanceLoopAck) PerDecodeMalloc(stream, sizeof(S_MaintenanceLoopAck));
             Decode_MaintenanceLoopAck(x->maintenanceLoopAck, stream);
             break;
         case 18:
-            x->maintenanceLoopReject = (PS_MaintenanceLoopReject) OSCL_DEFAULT_MALLOC(sizeof(S_MaintenanceLoopReject));
+            x->maintenanceLoopReject = (PS_MaintenanceLoopReject) PerDecodeMalloc(stream, sizeof(S_MaintenanceLoopReject));
             Decode_MaintenanceLoopReject(x->maintenanceLoopReject, stream);
             break;
             /* ------------------------------- */
@@ -237,31 +237,31 @@ void Decode_ResponseMessage(PS_ResponseMessage x, PS_InStream stream)
             /* ------------------------------- */
         case 19:
             GetLengthDet(stream);
-            x->communicationModeResponse = (PS_CommunicationModeResponse) OSCL_DEFAULT_MALLOC(sizeof(S_CommunicationModeResponse));
+            x->communicationModeResponse = (PS_CommunicationModeResponse) PerDecodeMalloc(stream, sizeof(S_CommunicationModeResponse));
             Decode_CommunicationModeResponse(x->communicationModeResponse, stream);
             ReadRemainingBits(stream);
             break;
         case 20:
             GetLengthDet(stream);
-            x->conferenceResponse = (PS_ConferenceResponse) OSCL_DEFAULT_MALLOC(sizeof(S_ConferenceResponse));
+            x->conferenceResponse = (PS_ConferenceResponse) PerDecodeMalloc(stream, sizeof(S_ConferenceResponse));
             Decode_ConferenceResponse(x->conferenceResponse, stream);
             ReadRemainingBits(stream);
             break;
         case 21:
             GetLengthDet(stream);
-            x->multilinkResponse = (PS_MultilinkResponse) OSCL_DEFAULT_MALLOC(sizeof(S_MultilinkResponse));
+            x->multilinkResponse = (PS_MultilinkResponse) PerDecodeMalloc(stream, sizeof(S_MultilinkResponse));
             Decode_MultilinkResponse(x->multilinkResponse, stream);
             ReadRemainingBits(stream);
             break;
         case 22:
             GetLengthDet(stream);
-            x->logicalChannelRateAcknowledge = (PS_LogicalChannelRateAcknowledge) OSCL_DEFAULT_MALLOC(sizeof(S_LogicalChannelRateAcknowledge));
+            x->logicalChannelRateAcknowledge = (PS_LogicalChannelRateAcknowledge) PerDecodeMalloc(stream, sizeof(S_LogicalChannelRateAcknowledge));
             Decode_LogicalChannelRateAcknowledge(x->logicalChannelRateAcknowledge, stream);
             ReadRemainingBits(stream);
             break;
         case 23:
             GetLengthDet(stream);
-            x->logicalChannelRateReject = (PS_LogicalChannelRateReject) OSCL_DEFAULT_MALLOC(sizeof(S_LogicalChannelRateReject));
+            x->logicalChannelRateReject = (PS_LogicalChannelRateReject) PerDecodeMalloc(stream, sizeof(S_LogicalChannelRateReject));
             Decode_LogicalChannelRateReject(x->logicalChannelRateReject, stream);
             ReadRemainingBits(stream);
             break;
@@ -280,31 +280,31 @@ void Decode_CommandMessage(PS_CommandMessage x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardMessage) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardMessage));
+            x->nonStandard = (PS_NonStandardMessage) PerDecodeMalloc(stream, sizeof(S_NonStandardMessage));
             Decode_NonStandardMessage(x->nonStandard, stream);
             break;
         case 1:
-            x->maintenanceLoopOffCommand = (PS_MaintenanceLoopOffCommand) OSCL_DEFAULT_MALLOC(sizeof(S_MaintenanceLoopOffCommand));
+            x->maintenanceLoopOffCommand = (PS_MaintenanceLoopOffCommand) PerDecodeMalloc(stream, sizeof(S_MaintenanceLoopOffCommand));
             Decode_MaintenanceLoopOffCommand(x->maintenanceLoopOffCommand, stream);
             break;
         case 2:
-            x->sendTerminalCapabilitySet = (PS_SendTerminalCapabilitySet) OSCL_DEFAULT_MALLOC(sizeof(S_SendTerminalCapabilitySet));
+            x->sendTerminalCapabilitySet = (PS_SendTerminalCapabilitySet) PerDecodeMalloc(stream, sizeof(S_SendTerminalCapabilitySet));
             Decode_SendTerminalCapabilitySet(x->sendTerminalCapabilitySet, stream);
             break;
         case 3:
-            x->encryptionCommand = (PS_EncryptionCommand) OSCL_DEFAULT_MALLOC(sizeof(S_EncryptionCommand));
+            x->encryptionCommand = (PS_EncryptionCommand) PerDecodeMalloc(stream, sizeof(S_EncryptionCommand));
             Decode_EncryptionCommand(x->encryptionCommand, stream);
             break;
         case 4:
-            x->flowControlCommand = (PS_FlowControlCommand) OSCL_DEFAULT_MALLOC(sizeof(S_FlowControlCommand));
+            x->flowControlCommand = (PS_FlowControlCommand) PerDecodeMalloc(stream, sizeof(S_FlowControlCommand));
             Decode_FlowControlCommand(x->flowControlCommand, stream);
             break;
         case 5:
-            x->endSessionCommand = (PS_EndSessionCommand) OSCL_DEFAULT_MALLOC(sizeof(S_EndSessionCommand));
+            x->endSessionCommand = (PS_EndSessionCommand) PerDecodeMalloc(stream, sizeof(S_EndSessionCommand));
             Decode_EndSessionCommand(x->endSessionCommand, stream);
             break;
         case 6:
-            x->miscellaneousCommand = (PS_MiscellaneousCommand) OSCL_DEFAULT_MALLOC(sizeof(S_MiscellaneousCommand));
+            x->miscellaneousCommand = (PS_MiscellaneousCommand) PerDecodeMalloc(stream, sizeof(S_MiscellaneousCommand));
             Decode_MiscellaneousCommand(x->miscellaneousCommand, stream);
             break;
             /* ------------------------------- */
@@ -312,25 +312,25 @@ void Decode_CommandMessage(PS_CommandMessage x, PS_InStream stream)
             /* ------------------------------- */
         case 7:
             GetLengthDet(stream);
-            x->communicationModeCommand = (PS_CommunicationModeCommand) OSCL_DEFAULT_MALLOC(sizeof(S_CommunicationModeCommand));
+            x->communicationModeCommand = (PS_CommunicationModeCommand) PerDecodeMalloc(stream, sizeof(S_CommunicationModeCommand));
             Decode_CommunicationModeCommand(x->communicationModeCommand, stream);
             ReadRemainingBits(stream);
             break;
         case 8:
             GetLengthDet(stream);
-            x->conferenceCommand = (PS_ConferenceCommand) OSCL_DEFAULT_MALLOC(sizeof(S_ConferenceCommand));
+            x->conferenceCommand = (PS_ConferenceCommand) PerDecodeMalloc(stream, sizeof(S_ConferenceCommand));
             Decode_ConferenceCommand(x->conferenceCommand, stream);
             ReadRemainingBits(stream);
             break;
         case 9:
             GetLengthDet(stream);
-            x->h223MultiplexReconfiguration = (PS_H223MultiplexReconfiguration) OSCL_DEFAULT_MALLOC(sizeof(S_H223MultiplexReconfiguration));
+            x->h223MultiplexReconfiguration = (PS_H223MultiplexReconfiguration) PerDecodeMalloc(stream, sizeof(S_H223MultiplexReconfiguration));
             Decode_H223MultiplexReconfiguration(x->h223MultiplexReconfiguration, stream);
             ReadRemainingBits(stream);
             break;
         case 10:
             GetLengthDet(stream);
-            x->newATMVCCommand = (PS_NewATMVCCommand) OSCL_DEFAULT_MALLOC(sizeof(S_NewATMVCCommand));
+            x->newATMVCCommand = (PS_NewATMVCCommand) PerDecodeMalloc(stream, sizeof(S_NewATMVCCommand));
             Decode_NewATMVCCommand(x->newATMVCCommand, stream);
             ReadRemainingBits(stream);
             break;
@@ -349,59 +349,59 @@ void Decode_IndicationMessage(PS_IndicationMessage x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardMessage) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardMessage));
+            x->nonStandard = (PS_NonStandardMessage) PerDecodeMalloc(stream, sizeof(S_NonStandardMessage));
             Decode_NonStandardMessage(x->nonStandard, stream);
             break;
         case 1:
-            x->functionNotUnderstood = (PS_FunctionNotUnderstood) OSCL_DEFAULT_MALLOC(sizeof(S_FunctionNotUnderstood));
+            x->functionNotUnderstood = (PS_FunctionNotUnderstood) PerDecodeMalloc(stream, sizeof(S_FunctionNotUnderstood));
             Decode_FunctionNotUnderstood(x->functionNotUnderstood, stream);
             break;
         case 2:
-            x->masterSlaveDeterminationRelease = (PS_MasterSlaveDeterminationRelease) OSCL_DEFAULT_MALLOC(sizeof(S_MasterSlaveDeterminationRelease));
+            x->masterSlaveDeterminationRelease = (PS_MasterSlaveDeterminationRelease) PerDecodeMalloc(stream, sizeof(S_MasterSlaveDeterminationRelease));
             Decode_MasterSlaveDeterminationRelease(x->masterSlaveDeterminationRelease, stream);
             break;
         case 3:
-            x->terminalCapabilitySetRelease = (PS_TerminalCapabilitySetRelease) OSCL_DEFAULT_MALLOC(sizeof(S_TerminalCapabilitySetRelease));
+            x->terminalCapabilitySetRelease = (PS_TerminalCapabilitySetRelease) PerDecodeMalloc(stream, sizeof(S_TerminalCapabilitySetRelease));
             Decode_TerminalCapabilitySetRelease(x->terminalCapabilitySetRelease, stream);
             break;
         case 4:
-            x->openLogicalChannelConfirm = (PS_OpenLogicalChannelConfirm) OSCL_DEFAULT_MALLOC(sizeof(S_OpenLogicalChannelConfirm));
+            x->openLogicalChannelConfirm = (PS_OpenLogicalChannelConfirm) PerDecodeMalloc(stream, sizeof(S_OpenLogicalChannelConfirm));
             Decode_OpenLogicalChannelConfirm(x->openLogicalChannelConfirm, stream);
             break;
         case 5:
-            x->requestChannelCloseRelease = (PS_RequestChannelCloseRelease) OSCL_DEFAULT_MALLOC(sizeof(S_RequestChannelCloseRelease));
+            x->requestChannelCloseRelease = (PS_RequestChannelCloseRelease) PerDecodeMalloc(stream, sizeof(S_RequestChannelCloseRelease));
             Decode_RequestChannelCloseRelease(x->requestChannelCloseRelease, stream);
             break;
         case 6:
-            x->multiplexEntrySendRelease = (PS_MultiplexEntrySendRelease) OSCL_DEFAULT_MALLOC(sizeof(S_MultiplexEntrySendRelease));
+            x->multiplexEntrySendRelease = (PS_MultiplexEntrySendRelease) PerDecodeMalloc(stream, sizeof(S_MultiplexEntrySendRelease));
             Decode_MultiplexEntrySendRelease(x->multiplexEntrySendRelease, stream);
             break;
         case 7:
-            x->requestMultiplexEntryRelease = (PS_RequestMultiplexEntryRelease) OSCL_DEFAULT_MALLOC(sizeof(S_RequestMultiplexEntryRelease));
+            x->requestMultiplexEntryRelease = (PS_RequestMultiplexEntryRelease) PerDecodeMalloc(stream, sizeof(S_RequestMultiplexEntryRelease));
             Decode_RequestMultiplexEntryRelease(x->requestMultiplexEntryRelease, stream);
             break;
         case 8:
-            x->requestModeRelease = (PS_RequestModeRelease) OSCL_DEFAULT_MALLOC(sizeof(S_RequestModeRelease));
+            x->requestModeRelease = (PS_RequestModeRelease) PerDecodeMalloc(stream, sizeof(S_RequestModeRelease));
             Decode_RequestModeRelease(x->requestModeRelease, stream);
             break;
         case 9:
-            x->miscellaneousIndication = (PS_MiscellaneousIndication) OSCL_DEFAULT_MALLOC(sizeof(S_MiscellaneousIndication));
+            x->miscellaneousIndication = (PS_MiscellaneousIndication) PerDecodeMalloc(stream, sizeof(S_MiscellaneousIndication));
             Decode_MiscellaneousIndication(x->miscellaneousIndication, stream);
             break;
         case 10:
-            x->jitterIndication = (PS_JitterIndication) OSCL_DEFAULT_MALLOC(sizeof(S_JitterIndication));
+            x->jitterIndication = (PS_JitterIndication) PerDecodeMalloc(stream, sizeof(S_JitterIndication));
             Decode_JitterIndication(x->jitterIndication, stream);
             break;
         case 11:
-            x->h223SkewIndication = (PS_H223SkewIndication) OSCL_DEFAULT_MALLOC(sizeof(S_H223SkewIndication));
+            x->h223SkewIndication = (PS_H223SkewIndication) PerDecodeMalloc(stream, sizeof(S_H223SkewIndication));
             Decode_H223SkewIndication(x->h223SkewIndication, stream);
             break;
         case 12:
-            x->newATMVCIndication = (PS_NewATMVCIndication) OSCL_DEFAULT_MALLOC(sizeof(S_NewATMVCIndication));
+            x->newATMVCIndication = (PS_NewATMVCIndication) PerDecodeMalloc(stream, sizeof(S_NewATMVCIndication));
             Decode_NewATMVCIndication(x->newATMVCIndication, stream);
             break;
         case 13:
-            x->userInput = (PS_UserInputIndication) OSCL_DEFAULT_MALLOC(sizeof(S_UserInputIndication));
+            x->userInput = (PS_UserInputIndication) PerDecodeMalloc(stream, sizeof(S_UserInputIndication));
             Decode_UserInputIndication(x->userInput, stream);
             break;
             /* ------------------------------- */
@@ -409,49 +409,49 @@ void Decode_IndicationMessage(PS_IndicationMessage x, PS_InStream stream)
             /* ------------------------------- */
         case 14:
             GetLengthDet(stream);
-            x->h2250MaximumSkewIndication = (PS_H2250MaximumSkewIndication) OSCL_DEFAULT_MALLOC(sizeof(S_H2250MaximumSkewIndication));
+            x->h2250MaximumSkewIndication = (PS_H2250MaximumSkewIndication) PerDecodeMalloc(stream, sizeof(S_H2250MaximumSkewIndication));
             Decode_H2250MaximumSkewIndication(x->h2250MaximumSkewIndication, stream);
             ReadRemainingBits(stream);
             break;
         case 15:
             GetLengthDet(stream);
-            x->mcLocationIndication = (PS_MCLocationIndication) OSCL_DEFAULT_MALLOC(sizeof(S_MCLocationIndication));
+            x->mcLocationIndication = (PS_MCLocationIndication) PerDecodeMalloc(stream, sizeof(S_MCLocationIndication));
             Decode_MCLocationIndication(x->mcLocationIndication, stream);
             ReadRemainingBits(stream);
             break;
         case 16:
             GetLengthDet(stream);
-            x->conferenceIndication = (PS_ConferenceIndication) OSCL_DEFAULT_MALLOC(sizeof(S_ConferenceIndication));
+            x->conferenceIndication = (PS_ConferenceIndication) PerDecodeMalloc(stream, sizeof(S_ConferenceIndication));
             Decode_ConferenceIndication(x->conferenceIndication, stream);
             ReadRemainingBits(stream);
             break;
         case 17:
             GetLengthDet(stream);
-            x->vendorIdentification = (PS_VendorIdentification) OSCL_DEFAULT_MALLOC(sizeof(S_VendorIdentification));
+            x->vendorIdentification = (PS_VendorIdentification) PerDecodeMalloc(stream, sizeof(S_VendorIdentification));
             Decode_VendorIdentification(x->vendorIdentification, stream);
             ReadRemainingBits(stream);
             break;
         case 18:
             GetLengthDet(stream);
-            x->functionNotSupported = (PS_FunctionNotSupported) OSCL_DEFAULT_MALLOC(sizeof(S_FunctionNotSupported));
+            x->functionNotSupported = (PS_FunctionNotSupported) PerDecodeMalloc(stream, sizeof(S_FunctionNotSupported));
             Decode_FunctionNotSupported(x->functionNotSupported, stream);
             ReadRemainingBits(stream);
             break;
         case 19:
             GetLengthDet(stream);
-            x->multilinkIndication = (PS_MultilinkIndication) OSCL_DEFAULT_MALLOC(sizeof(S_MultilinkIndication));
+            x->multilinkIndication = (PS_MultilinkIndication) PerDecodeMalloc(stream, sizeof(S_MultilinkIndication));
             Decode_MultilinkIndication(x->multilinkIndication, stream);
             ReadRemainingBits(stream);
             break;
         case 20:
             GetLengthDet(stream);
-            x->logicalChannelRateRelease = (PS_LogicalChannelRateRelease) OSCL_DEFAULT_MALLOC(sizeof(S_LogicalChannelRateRelease));
+            x->logicalChannelRateRelease = (PS_LogicalChannelRateRelease) PerDecodeMalloc(stream, sizeof(S_LogicalChannelRateRelease));
             Decode_LogicalChannelRateRelease(x->logicalChannelRateRelease, stream);
             ReadRemainingBits(stream);
             break;
         case 21:
             GetLengthDet(stream);
-            x->flowControlIndication = (PS_FlowControlIndication) OSCL_DEFAULT_MALLOC(sizeof(S_FlowControlIndication));
+            x->flowControlIndication = (PS_FlowControlIndication) PerDecodeMalloc(stream, sizeof(S_FlowControlIndication));
             Decode_FlowControlIndication(x->flowControlIndication, stream);
             ReadRemainingBits(stream);
             break;
@@ -482,7 +482,7 @@ void Decode_GenericInformation(PS_GenericInformation x, PS_InStream stream)
     {
         x->size_of_messageContent = (uint16)GetLengthDet(stream);
         x->messageContent = (PS_GenericParameter)
-                            OSCL_DEFAULT_MALLOC(x->size_of_messageContent * sizeof(S_GenericParameter));
+                            PerDecodeMalloc(stream, x->size_of_messageContent * sizeof(S_GenericParameter));
         for (i = 0; i < x->size_of_messageContent; ++i)
         {
             Decode_GenericParameter(x->messageContent + i, stream);
@@ -542,11 +542,11 @@ void Decode_NonStandardIdentifier(PS_NonStandardIdentifier x, PS_InStream stream
     switch (x->index)
     {
         case 0:
-            x->object = (PS_OBJECTIDENT) OSCL_DEFAULT_MALLOC(sizeof(S_OBJECTIDENT));
+            x->object = (PS_OBJECTIDENT) PerDecodeMalloc(stream, sizeof(S_OBJECTIDENT));
             GetObjectID(x->object, stream);
             break;
         case 1:
-            x->h221NonStandard = (PS_H221NonStandard) OSCL_DEFAULT_MALLOC(sizeof(S_H221NonStandard));
+            x->h221NonStandard = (PS_H221NonStandard) PerDecodeMalloc(stream, sizeof(S_H221NonStandard));
             Decode_H221NonStandard(x->h221NonStandard, stream);
             break;
         default:
@@ -720,7 +720,7 @@ void Decode_TerminalCapabilitySet(PS_TerminalCapabilitySet x, PS_InStream stream
     {
         x->size_of_capabilityTable = (uint16) GetInteger(1, 256, stream);
         x->capabilityTable = (PS_CapabilityTableEntry)
-                             OSCL_DEFAULT_MALLOC(x->size_of_capabilityTable * sizeof(S_CapabilityTableEntry));
+                             PerDecodeMalloc(stream, x->size_of_capabilityTable * sizeof(S_CapabilityTableEntry));
         for (i = 0; i < x->size_of_capabilityTable; ++i)
         {
             Decode_CapabilityTableEntry(x->capabilityTable + i, stream);
@@ -730,7 +730,7 @@ void Decode_TerminalCapabilitySet(PS_TerminalCapabilitySet x, PS_InStream stream
     {
         x->size_of_capabilityDescriptors = (uint16) GetInteger(1, 256, stream);
         x->capabilityDescriptors = (PS_CapabilityDescriptor)
-                                   OSCL_DEFAULT_MALLOC(x->size_of_capabilityDescriptors * sizeof(S_CapabilityDescriptor));
+                                   PerDecodeMalloc(stream, x->size_of_capabilityDescriptors * sizeof(S_CapabilityDescriptor));
         for (i = 0; i < x->size_of_capabilityDescriptors; ++i)
         {
             Decode_CapabilityDescriptor(x->capabilityDescriptors + i, stream);
@@ -749,7 +749,7 @@ void Decode_TerminalCapabilitySet(PS_TerminalCapabilitySet x, PS_InStream stream
             ExtensionPrep(map, stream);
             x->size_of_genericInformation = (uint16)GetLengthDet(stream);
             x->genericInformation = (PS_GenericInformation)
-                                    OSCL_DEFAULT_MALLOC(x->size_of_genericInformation * sizeof(S_GenericInformation));
+                                    PerDecodeMalloc(stream, x->size_of_genericInformation * sizeof(S_GenericInformation));
             for (i = 0; i < x->size_of_genericInformation; ++i)
             {
                 Decode_GenericInformation(x->genericInformation + i, stream);
@@ -788,7 +788,7 @@ void Decode_CapabilityDescriptor(PS_CapabilityDescriptor x, PS_InStream stream)
     {
         x->size_of_simultaneousCapabilities = (uint16) GetInteger(1, 256, stream);
         x->simultaneousCapabilities = (PS_AlternativeCapabilitySet)
-                                      OSCL_DEFAULT_MALLOC(x->size_of_simultaneousCapabilities * sizeof(S_AlternativeCapabilitySet));
+                                      PerDecodeMalloc(stream, x->size_of_simultaneousCapabilities * sizeof(S_AlternativeCapabilitySet));
         for (i = 0; i < x->size_of_simultaneousCapabilities; ++i)
         {
             Decode_AlternativeCapabilitySet(x->simultaneousCapabilities + i, stream);
@@ -803,7 +803,7 @@ void Decode_AlternativeCapabilitySet(PS_AlternativeCapabilitySet x, PS_InStream
 {
     uint16 i;
     x->size = (uint16) GetInteger(1, 256, stream);
-    x->item = (uint32*) OSCL_DEFAULT_MALLOC(x->size * sizeof(uint32));
+    x->item = (uint32*) PerDecodeMalloc(stream, x->size * sizeof(uint32));
     for (i = 0; i < x->size; ++i)
     {
         x->item[i] = GetInteger(1, 65535, stream);
@@ -875,7 +875,7 @@ void Decode_TcsRejectCause(PS_TcsRejectCause x, PS_InStream stream)
             /* (descriptorCapacityExceeded is NULL) */
             break;
         case 3:
-            x->tableEntryCapacityExceeded = (PS_TableEntryCapacityExceeded) OSCL_DEFAULT_MALLOC(sizeof(S_TableEntryCapacityExceeded));
+            x->tableEntryCapacityExceeded = (PS_TableEntryCapacityExceeded) PerDecodeMalloc(stream, sizeof(S_TableEntryCapacityExceeded));
             Decode_TableEntryCapacityExceeded(x->tableEntryCapacityExceeded, stream);
             break;
             /* ------------------------------- */
@@ -940,50 +940,50 @@ void Decode_Capability(PS_Capability x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
-            x->receiveVideoCapability = (PS_VideoCapability) OSCL_DEFAULT_MALLOC(sizeof(S_VideoCapability));
+            x->receiveVideoCapability = (PS_VideoCapability) PerDecodeMalloc(stream, sizeof(S_VideoCapability));
             Decode_VideoCapability(x->receiveVideoCapability, stream);
             break;
         case 2:
-            x->transmitVideoCapability = (PS_VideoCapability) OSCL_DEFAULT_MALLOC(sizeof(S_VideoCapability));
+            x->transmitVideoCapability = (PS_VideoCapability) PerDecodeMalloc(stream, sizeof(S_VideoCapability));
             Decode_VideoCapability(x->transmitVideoCapability, stream);
             break;
         case 3:
-            x->receiveAndTransmitVideoCapability = (PS_VideoCapability) OSCL_DEFAULT_MALLOC(sizeof(S_VideoCapability));
+            x->receiveAndTransmitVideoCapability = (PS_VideoCapability) PerDecodeMalloc(stream, sizeof(S_VideoCapability));
             Decode_VideoCapability(x->receiveAndTransmitVideoCapability, stream);
             break;
         case 4:
-            x->receiveAudioCapability = (PS_AudioCapability) OSCL_DEFAULT_MALLOC(sizeof(S_AudioCapability));
+            x->receiveAudioCapability = (PS_AudioCapability) PerDecodeMalloc(stream, sizeof(S_AudioCapability));
             Decode_AudioCapability(x->receiveAudioCapability, stream);
             break;
         case 5:
-            x->transmitAudioCapability = (PS_AudioCapability) OSCL_DEFAULT_MALLOC(sizeof(S_AudioCapability));
+            x->transmitAudioCapability = (PS_AudioCapability) PerDecodeMalloc(stream, sizeof(S_AudioCapability));
             Decode_AudioCapability(x->transmitAudioCapability, stream);
             break;
         case 6:
-            x->receiveAndTransmitAudioCapability = (PS_AudioCapability) OSCL_DEFAULT_MALLOC(sizeof(S_AudioCapability));
+            x->receiveAndTransmitAudioCapability = (PS_AudioCapability) PerDecodeMalloc(stream, sizeof(S_AudioCapability));
             Decode_AudioCapability(x->receiveAndTransmitAudioCapability, stream);
             break;
         case 7:
-            x->receiveDataApplicationCapability = (PS_DataApplicationCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataApplicationCapability));
+            x->receiveDataApplicationCapability = (PS_DataApplicationCapability) PerDecodeMalloc(stream, sizeof(S_DataApplicationCapability));
             Decode_DataApplicationCapability(x->receiveDataApplicationCapability, stream);
             break;
         case 8:
-            x->transmitDataApplicationCapability = (PS_DataApplicationCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataApplicationCapability));
+            x->transmitDataApplicationCapability = (PS_DataApplicationCapability) PerDecodeMalloc(stream, sizeof(S_DataApplicationCapability));
             Decode_DataApplicationCapability(x->transmitDataApplicationCapability, stream);
             break;
         case 9:
-            x->receiveAndTransmitDataApplicationCapability = (PS_DataApplicationCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataApplicationCapability));
+            x->receiveAndTransmitDataApplicationCapability = (PS_DataApplicationCapability) PerDecodeMalloc(stream, sizeof(S_DataApplicationCapability));
             Decode_DataApplicationCapability(x->receiveAndTransmitDataApplicationCapability, stream);
             break;
         case 10:
             x->h233EncryptionTransmitCapability = GetBoolean(stream);
             break;
         case 11:
-            x->h233EncryptionReceiveCapability = (PS_H233EncryptionReceiveCapability) OSCL_DEFAULT_MALLOC(sizeof(S_H233EncryptionReceiveCapability));
+            x->h233EncryptionReceiveCapability = (PS_H233EncryptionReceiveCapability) PerDecodeMalloc(stream, sizeof(S_H233EncryptionReceiveCapability));
             Decode_H233EncryptionReceiveCapability(x->h233EncryptionReceiveCapability, stream);
             break;
             /* ------------------------------- */
@@ -991,13 +991,13 @@ void Decode_Capability(PS_Capability x, PS_InStream stream)
             /* ------------------------------- */
         case 12:
             GetLengthDet(stream);
-            x->conferenceCapability = (PS_ConferenceCapability) OSCL_DEFAULT_MALLOC(sizeof(S_ConferenceCapability));
+            x->conferenceCapability = (PS_ConferenceCapability) PerDecodeMalloc(stream, sizeof(S_ConferenceCapability));
             Decode_ConferenceCapability(x->conferenceCapability, stream);
             ReadRemainingBits(stream);
             break;
         case 13:
             GetLengthDet(stream);
-            x->h235SecurityCapability = (PS_H235SecurityCapability) OSCL_DEFAULT_MALLOC(sizeof(S_H235SecurityCapability));
+            x->h235SecurityCapability = (PS_H235SecurityCapability) PerDecodeMalloc(stream, sizeof(S_H235SecurityCapability));
             Decode_H235SecurityCapability(x->h235SecurityCapability, stream);
             ReadRemainingBits(stream);
             break;
@@ -1008,25 +1008,25 @@ void Decode_Capability(PS_Capability x, PS_InStream stream)
             break;
         case 15:
             GetLengthDet(stream);
-            x->receiveUserInputCapability = (PS_UserInputCapability) OSCL_DEFAULT_MALLOC(sizeof(S_UserInputCapability));
+            x->receiveUserInputCapability = (PS_UserInputCapability) PerDecodeMalloc(stream, sizeof(S_UserInputCapability));
             Decode_UserInputCapability(x->receiveUserInputCapability, stream);
             ReadRemainingBits(stream);
             break;
         case 16:
             GetLengthDet(stream);
-            x->transmitUserInputCapability = (PS_UserInputCapability) OSCL_DEFAULT_MALLOC(sizeof(S_UserInputCapability));
+            x->transmitUserInputCapability = (PS_UserInputCapability) PerDecodeMalloc(stream, sizeof(S_UserInputCapability));
             Decode_UserInputCapability(x->transmitUserInputCapability, stream);
             ReadRemainingBits(stream);
             break;
         case 17:
             GetLengthDet(stream);
-            x->receiveAndTransmitUserInputCapability = (PS_UserInputCapability) OSCL_DEFAULT_MALLOC(sizeof(S_UserInputCapability));
+            x->receiveAndTransmitUserInputCapability = (PS_UserInputCapability) PerDecodeMalloc(stream, sizeof(S_UserInputCapability));
             Decode_UserInputCapability(x->receiveAndTransmitUserInputCapability, stream);
             ReadRemainingBits(stream);
             break;
         case 18:
             GetLengthDet(stream);
-            x->genericControlCapability = (PS_GenericCapability) OSCL_DEFAULT_MALLOC(sizeof(S_GenericCapability));
+            x->genericControlCapability = (PS_GenericCapability) PerDecodeMalloc(stream, sizeof(S_GenericCapability));
             Decode_GenericCapability(x->genericControlCapability, stream);
             ReadRemainingBits(stream);
             break;
@@ -1092,19 +1092,19 @@ void Decode_MultiplexCapability(PS_MultiplexCapability x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
-            x->h222Capability = (PS_H222Capability) OSCL_DEFAULT_MALLOC(sizeof(S_H222Capability));
+            x->h222Capability = (PS_H222Capability) PerDecodeMalloc(stream, sizeof(S_H222Capability));
             Decode_H222Capability(x->h222Capability, stream);
             break;
         case 2:
-            x->h223Capability = (PS_H223Capability) OSCL_DEFAULT_MALLOC(sizeof(S_H223Capability));
+            x->h223Capability = (PS_H223Capability) PerDecodeMalloc(stream, sizeof(S_H223Capability));
             Decode_H223Capability(x->h223Capability, stream);
             break;
         case 3:
-            x->v76Capability = (PS_V76Capability) OSCL_DEFAULT_MALLOC(sizeof(S_V76Capability));
+            x->v76Capability = (PS_V76Capability) PerDecodeMalloc(stream, sizeof(S_V76Capability));
             Decode_V76Capability(x->v76Capability, stream);
             break;
             /* ------------------------------- */
@@ -1112,13 +1112,13 @@ void Decode_MultiplexCapability(PS_MultiplexCapability x, PS_InStream stream)
             /* ------------------------------- */
         case 4:
             GetLengthDet(stream);
-            x->h2250Capability = (PS_H2250Capability) OSCL_DEFAULT_MALLOC(sizeof(S_H2250Capability));
+            x->h2250Capability = (PS_H2250Capability) PerDecodeMalloc(stream, sizeof(S_H2250Capability));
             Decode_H2250Capability(x->h2250Capability, stream);
             ReadRemainingBits(stream);
             break;
         case 5:
             GetLengthDet(stream);
-            x->genericMultiplexCapability = (PS_GenericCapability) OSCL_DEFAULT_MALLOC(sizeof(S_GenericCapability));
+            x->genericMultiplexCapability = (PS_GenericCapability) PerDecodeMalloc(stream, sizeof(S_GenericCapability));
             Decode_GenericCapability(x->genericMultiplexCapability, stream);
             ReadRemainingBits(stream);
             break;
@@ -1141,7 +1141,7 @@ void Decode_H222Capability(PS_H222Capability x, PS_InStream stream)
     x->numberOfVCs = (uint16) GetInteger(1, 256, stream);
     x->size_of_vcCapability = (uint16) GetLengthDet(stream);
     x->vcCapability = (PS_VCCapability)
-                      OSCL_DEFAULT_MALLOC(x->size_of_vcCapability * sizeof(S_VCCapability));
+                      PerDecodeMalloc(stream, x->size_of_vcCapability * sizeof(S_VCCapability));
     for (i = 0; i < x->size_of_vcCapability; ++i)
     {
         Decode_VCCapability(x->vcCapability + i, stream);
@@ -1214,7 +1214,7 @@ void Decode_Aal1ViaGateway(PS_Aal1ViaGateway x, PS_InStream stream)
     extension = GetBoolean(stream);
     x->size_of_gatewayAddress = (uint16) GetInteger(1, 256, stream);
     x->gatewayAddress = (PS_Q2931Address)
-                        OSCL_DEFAULT_MALLOC(x->size_of_gatewayAddress * sizeof(S_Q2931Address));
+                        PerDecodeMalloc(stream, x->size_of_gatewayAddress * sizeof(S_Q2931Address));
     for (i = 0; i < x->size_of_gatewayAddress; ++i)
     {
         Decode_Q2931Address(x->gatewayAddress + i, stream);
@@ -1276,7 +1276,7 @@ void Decode_VccAal5Type(PS_VccAal5Type x, PS_InStream stream)
             x->singleBitRate = (uint16) GetInteger(1, 65535, stream);
             break;
         case 1:
-            x->rangeOfBitRates = (PS_RangeOfBitRates) OSCL_DEFAULT_MALLOC(sizeof(S_RangeOfBitRates));
+            x->rangeOfBitRates = (PS_RangeOfBitRates) PerDecodeMalloc(stream, sizeof(S_RangeOfBitRates));
             Decode_RangeOfBitRates(x->rangeOfBitRates, stream);
             break;
         default:
@@ -1455,7 +1455,7 @@ void Decode_H223MultiplexTableCapability(PS_H223MultiplexTableCapability x, PS_I
             /* (basic is NULL) */
             break;
         case 1:
-            x->enhanced = (PS_Enhanced) OSCL_DEFAULT_MALLOC(sizeof(S_Enhanced));
+            x->enhanced = (PS_Enhanced) PerDecodeMalloc(stream, sizeof(S_Enhanced));
             Decode_Enhanced(x->enhanced, stream);
             break;
         default:
@@ -1631,7 +1631,7 @@ void Decode_H2250Capability(PS_H2250Capability x, PS_InStream stream)
             ExtensionPrep(map, stream);
             x->size_of_redundancyEncodingCapability = (uint16) GetInteger(1, 256, stream);
             x->redundancyEncodingCapability = (PS_RedundancyEncodingCapability)
-                                              OSCL_DEFAULT_MALLOC(x->size_of_redundancyEncodingCapability * sizeof(S_RedundancyEncodingCapability));
+                                              PerDecodeMalloc(stream, x->size_of_redundancyEncodingCapability * sizeof(S_RedundancyEncodingCapability));
             for (i = 0; i < x->size_of_redundancyEncodingCapability; ++i)
             {
                 Decode_RedundancyEncodingCapability(x->redundancyEncodingCapability + i, stream);
@@ -1707,7 +1707,7 @@ void Decode_MediaPacketizationCapability(PS_MediaPacketizationCapability x, PS_I
             ExtensionPrep(map, stream);
             x->size_of_rtpPayloadType = (uint16) GetInteger(1, 256, stream);
             x->rtpPayloadType = (PS_RTPPayloadType)
-                                OSCL_DEFAULT_MALLOC(x->size_of_rtpPayloadType * sizeof(S_RTPPayloadType));
+                                PerDecodeMalloc(stream, x->size_of_rtpPayloadType * sizeof(S_RTPPayloadType));
             for (i = 0; i < x->size_of_rtpPayloadType; ++i)
             {
                 Decode_RTPPayloadType(x->rtpPayloadType + i, stream);
@@ -1886,7 +1886,7 @@ void Decode_MediaTransportType(PS_MediaTransportType x, PS_InStream stream)
             /* ------------------------------- */
         case 4:
             GetLengthDet(stream);
-            x->atm_AAL5_compressed = (PS_Atm_AAL5_compressed) OSCL_DEFAULT_MALLOC(sizeof(S_Atm_AAL5_compressed));
+            x->atm_AAL5_compressed = (PS_Atm_AAL5_compressed) PerDecodeMalloc(stream, sizeof(S_Atm_AAL5_compressed));
             Decode_Atm_AAL5_compressed(x->atm_AAL5_compressed, stream);
             ReadRemainingBits(stream);
             break;
@@ -1967,7 +1967,7 @@ void Decode_TransportCapability(PS_TransportCapability x, PS_InStream stream)
     {
         x->size_of_qOSCapabilities = (uint16) GetInteger(1, 256, stream);
         x->qOSCapabilities = (PS_QOSCapability)
-                             OSCL_DEFAULT_MALLOC(x->size_of_qOSCapabilities * sizeof(S_QOSCapability));
+                             PerDecodeMalloc(stream, x->size_of_qOSCapabilities * sizeof(S_QOSCapability));
         for (i = 0; i < x->size_of_qOSCapabilities; ++i)
         {
             Decode_QOSCapability(x->qOSCapabilities + i, stream);
@@ -1977,7 +1977,7 @@ void Decode_TransportCapability(PS_TransportCapability x, PS_InStream stream)
     {
         x->size_of_mediaChannelCapabilities = (uint16) GetInteger(1, 256, stream);
         x->mediaChannelCapabilities = (PS_MediaChannelCapability)
-                                      OSCL_DEFAULT_MALLOC(x->size_of_mediaChannelCapabilities * sizeof(S_MediaChannelCapability));
+                                      PerDecodeMalloc(stream, x->size_of_mediaChannelCapabilities * sizeof(S_MediaChannelCapability));
         for (i = 0; i < x->size_of_mediaChannelCapabilities; ++i)
         {
             Decode_MediaChannelCapability(x->mediaChannelCapabilities + i, stream);
@@ -2012,7 +2012,7 @@ void Decode_RedundancyEncodingCapability(PS_RedundancyEncodingCapability x, PS_I
     if (x->option_of_secondaryEncoding)
     {
         x->size_of_secondaryEncoding = (uint16) GetInteger(1, 256, stream);
-        x->secondaryEncoding = (uint32*) OSCL_DEFAULT_MALLOC(x->size_of_secondaryEncoding * sizeof(uint32));
+        x->secondaryEncoding = (uint32*) PerDecodeMalloc(stream, x->size_of_secondaryEncoding * sizeof(uint32));
         for (i = 0; i < x->size_of_secondaryEncoding; ++i)
         {
             x->secondaryEncoding[i] = GetInteger(1, 65535, stream);
@@ -2040,7 +2040,7 @@ void Decode_RedundancyEncodingMethod(PS_RedundancyEncodingMethod x, PS_InStream
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
@@ -2051,7 +2051,7 @@ void Decode_RedundancyEncodingMethod(PS_RedundancyEncodingMethod x, PS_InStream
             /* ------------------------------- */
         case 2:
             GetLengthDet(stream);
-            x->rtpH263VideoRedundancyEncoding = (PS_RTPH263VideoRedundancyEncoding) OSCL_DEFAULT_MALLOC(sizeof(S_RTPH263VideoRedundancyEncoding));
+            x->rtpH263VideoRedundancyEncoding = (PS_RTPH263VideoRedundancyEncoding) PerDecodeMalloc(stream, sizeof(S_RTPH263VideoRedundancyEncoding));
             Decode_RTPH263VideoRedundancyEncoding(x->rtpH263VideoRedundancyEncoding, stream);
             ReadRemainingBits(stream);
             break;
@@ -2078,7 +2078,7 @@ void Decode_RTPH263VideoRedundancyEncoding(PS_RTPH263VideoRedundancyEncoding x,
     if (x->option_of_containedThreads)
     {
         x->size_of_containedThreads = (uint16) GetInteger(1, 256, stream);
-        x->containedThreads = (uint32*) OSCL_DEFAULT_MALLOC(x->size_of_containedThreads * sizeof(uint32));
+        x->containedThreads = (uint32*) PerDecodeMalloc(stream, x->size_of_containedThreads * sizeof(uint32));
         for (i = 0; i < x->size_of_containedThreads; ++i)
         {
             x->containedThreads[i] = GetInteger(0, 15, stream);
@@ -2112,7 +2112,7 @@ void Decode_FrameToThreadMapping(PS_FrameToThreadMapping x, PS_InStream stream)
         case 1:
             x->size = (uint16) GetInteger(1, 256, stream);
             x->custom = (PS_RTPH263VideoRedundancyFrameMapping)
-                        OSCL_DEFAULT_MALLOC(x->size * sizeof(S_RTPH263VideoRedundancyFrameMapping));
+                        PerDecodeMalloc(stream, x->size * sizeof(S_RTPH263VideoRedundancyFrameMapping));
             for (i = 0; i < x->size; ++i)
             {
                 Decode_RTPH263VideoRedundancyFrameMapping(x->custom + i, stream);
@@ -2139,7 +2139,7 @@ void Decode_RTPH263VideoRedundancyFrameMapping(PS_RTPH263VideoRedundancyFrameMap
     extension = GetBoolean(stream);
     x->threadNumber = (uint8) GetInteger(0, 15, stream);
     x->size_of_frameSequence = (uint16) GetInteger(1, 256, stream);
-    x->frameSequence = (uint32*) OSCL_DEFAULT_MALLOC(x->size_of_frameSequence * sizeof(uint32));
+    x->frameSequence = (uint32*) PerDecodeMalloc(stream, x->size_of_frameSequence * sizeof(uint32));
     for (i = 0; i < x->size_of_frameSequence; ++i)
     {
         x->frameSequence[i] = GetInteger(0, 255, stream);
@@ -2171,7 +2171,7 @@ void Decode_MultipointCapability(PS_MultipointCapability x, PS_InStream stream)
     x->multiUniCastConference = GetBoolean(stream);
     x->size_of_mediaDistributionCapability = (uint16) GetLengthDet(stream);
     x->mediaDistributionCapability = (PS_MediaDistributionCapability)
-                                     OSCL_DEFAULT_MALLOC(x->size_of_mediaDistributionCapability * sizeof(S_MediaDistributionCapability));
+                                     PerDecodeMalloc(stream, x->size_of_mediaDistributionCapability * sizeof(S_MediaDistributionCapability));
     for (i = 0; i < x->size_of_mediaDistributionCapability; ++i)
     {
         Decode_MediaDistributionCapability(x->mediaDistributionCapability + i, stream);
@@ -2211,7 +2211,7 @@ void Decode_MediaDistributionCapability(PS_MediaDistributionCapability x, PS_InS
     {
         x->size_of_centralizedData = (uint16) GetLengthDet(stream);
         x->centralizedData = (PS_DataApplicationCapability)
-                             OSCL_DEFAULT_MALLOC(x->size_of_centralizedData * sizeof(S_DataApplicationCapability));
+                             PerDecodeMalloc(stream, x->size_of_centralizedData * sizeof(S_DataApplicationCapability));
         for (i = 0; i < x->size_of_centralizedData; ++i)
         {
             Decode_DataApplicationCapability(x->centralizedData + i, stream);
@@ -2221,7 +2221,7 @@ void Decode_MediaDistributionCapability(PS_MediaDistributionCapability x, PS_InS
     {
         x->size_of_distributedData = (uint16) GetLengthDet(stream);
         x->distributedData = (PS_DataApplicationCapability)
-                             OSCL_DEFAULT_MALLOC(x->size_of_distributedData * sizeof(S_DataApplicationCapability));
+                             PerDecodeMalloc(stream, x->size_of_distributedData * sizeof(S_DataApplicationCapability));
         for (i = 0; i < x->size_of_distributedData; ++i)
         {
             Decode_DataApplicationCapability(x->distributedData + i, stream);
@@ -2249,23 +2249,23 @@ void Decode_VideoCapability(PS_VideoCapability x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
-            x->h261VideoCapability = (PS_H261VideoCapability) OSCL_DEFAULT_MALLOC(sizeof(S_H261VideoCapability));
+            x->h261VideoCapability = (PS_H261VideoCapability) PerDecodeMalloc(stream, sizeof(S_H261VideoCapability));
             Decode_H261VideoCapability(x->h261VideoCapability, stream);
             break;
         case 2:
-            x->h262VideoCapability = (PS_H262VideoCapability) OSCL_DEFAULT_MALLOC(sizeof(S_H262VideoCapability));
+            x->h262VideoCapability = (PS_H262VideoCapability) PerDecodeMalloc(stream, sizeof(S_H262VideoCapability));
             Decode_H262VideoCapability(x->h262VideoCapability, stream);
             break;
         case 3:
-            x->h263VideoCapability = (PS_H263VideoCapability) OSCL_DEFAULT_MALLOC(sizeof(S_H263VideoCapability));
+            x->h263VideoCapability = (PS_H263VideoCapability) PerDecodeMalloc(stream, sizeof(S_H263VideoCapability));
             Decode_H263VideoCapability(x->h263VideoCapability, stream);
             break;
         case 4:
-            x->is11172VideoCapability = (PS_IS11172VideoCapability) OSCL_DEFAULT_MALLOC(sizeof(S_IS11172VideoCapability));
+            x->is11172VideoCapability = (PS_IS11172VideoCapability) PerDecodeMalloc(stream, sizeof(S_IS11172VideoCapability));
             Decode_IS11172VideoCapability(x->is11172VideoCapability, stream);
             break;
             /* ------------------------------- */
@@ -2273,7 +2273,7 @@ void Decode_VideoCapability(PS_VideoCapability x, PS_InStream stream)
             /* ------------------------------- */
         case 5:
             GetLengthDet(stream);
-            x->genericVideoCapability = (PS_GenericCapability) OSCL_DEFAULT_MALLOC(sizeof(S_GenericCapability));
+            x->genericVideoCapability = (PS_GenericCapability) PerDecodeMalloc(stream, sizeof(S_GenericCapability));
             Decode_GenericCapability(x->genericVideoCapability, stream);
             ReadRemainingBits(stream);
             break;
@@ -2526,7 +2526,7 @@ void Decode_EnhancementLayerInfo(PS_EnhancementLayerInfo x, PS_InStream stream)
     {
         x->size_of_snrEnhancement = (uint8) GetInteger(1, 14, stream);
         x->snrEnhancement = (PS_EnhancementOptions)
-                            OSCL_DEFAULT_MALLOC(x->size_of_snrEnhancement * sizeof(S_EnhancementOptions));
+                            PerDecodeMalloc(stream, x->size_of_snrEnhancement * sizeof(S_EnhancementOptions));
         for (i = 0; i < x->size_of_snrEnhancement; ++i)
         {
             Decode_EnhancementOptions(x->snrEnhancement + i, stream);
@@ -2536,7 +2536,7 @@ void Decode_EnhancementLayerInfo(PS_EnhancementLayerInfo x, PS_InStream stream)
     {
         x->size_of_spatialEnhancement = (uint8) GetInteger(1, 14, stream);
         x->spatialEnhancement = (PS_EnhancementOptions)
-                                OSCL_DEFAULT_MALLOC(x->size_of_spatialEnhancement * sizeof(S_EnhancementOptions));
+                                PerDecodeMalloc(stream, x->size_of_spatialEnhancement * sizeof(S_EnhancementOptions));
         for (i = 0; i < x->size_of_spatialEnhancement; ++i)
         {
             Decode_EnhancementOptions(x->spatialEnhancement + i, stream);
@@ -2546,7 +2546,7 @@ void Decode_EnhancementLayerInfo(PS_EnhancementLayerInfo x, PS_InStream stream)
     {
         x->size_of_bPictureEnhancement = (uint8) GetInteger(1, 14, stream);
         x->bPictureEnhancement = (PS_BEnhancementParameters)
-                                 OSCL_DEFAULT_MALLOC(x->size_of_bPictureEnhancement * sizeof(S_BEnhancementParameters));
+                                 PerDecodeMalloc(stream, x->size_of_bPictureEnhancement * sizeof(S_BEnhancementParameters));
         for (i = 0; i < x->size_of_bPictureEnhancement; ++i)
         {
             Decode_BEnhancementParameters(x->bPictureEnhancement + i, stream);
@@ -2722,7 +2722,7 @@ void Decode_H263Options(PS_H263Options x, PS_InStream stream)
     {
         x->size_of_customPictureClockFrequency = (uint8) GetInteger(1, 16, stream);
         x->customPictureClockFrequency = (PS_CustomPictureClockFrequency)
-                                         OSCL_DEFAULT_MALLOC(x->size_of_customPictureClockFrequency * sizeof(S_CustomPictureClockFrequency));
+                                         PerDecodeMalloc(stream, x->size_of_customPictureClockFrequency * sizeof(S_CustomPictureClockFrequency));
         for (i = 0; i < x->size_of_customPictureClockFrequency; ++i)
         {
             Decode_CustomPictureClockFrequency(x->customPictureClockFrequency + i, stream);
@@ -2732,7 +2732,7 @@ void Decode_H263Options(PS_H263Options x, PS_InStream stream)
     {
         x->size_of_customPictureFormat = (uint8) GetInteger(1, 16, stream);
         x->customPictureFormat = (PS_CustomPictureFormat)
-                                 OSCL_DEFAULT_MALLOC(x->size_of_customPictureFormat * sizeof(S_CustomPictureFormat));
+                                 PerDecodeMalloc(stream, x->size_of_customPictureFormat * sizeof(S_CustomPictureFormat));
         for (i = 0; i < x->size_of_customPictureFormat; ++i)
         {
             Decode_CustomPictureFormat(x->customPictureFormat + i, stream);
@@ -2742,7 +2742,7 @@ void Decode_H263Options(PS_H263Options x, PS_InStream stream)
     {
         x->size_of_modeCombos = (uint8) GetInteger(1, 16, stream);
         x->modeCombos = (PS_H263VideoModeCombos)
-                        OSCL_DEFAULT_MALLOC(x->size_of_modeCombos * sizeof(S_H263VideoModeCombos));
+                        PerDecodeMalloc(stream, x->size_of_modeCombos * sizeof(S_H263VideoModeCombos));
         for (i = 0; i < x->size_of_modeCombos; ++i)
         {
             Decode_H263VideoModeCombos(x->modeCombos + i, stream);
@@ -2992,7 +2992,7 @@ void Decode_PixelAspectInformation(PS_PixelAspectInformation x, PS_InStream stre
             break;
         case 1:
             x->size = (uint8) GetInteger(1, 14, stream);
-            x->pixelAspectCode = (uint32*) OSCL_DEFAULT_MALLOC(x->size * sizeof(uint32));
+            x->pixelAspectCode = (uint32*) PerDecodeMalloc(stream, x->size * sizeof(uint32));
             for (i = 0; i < x->size; ++i)
             {
                 x->pixelAspectCode[i] = GetInteger(1, 14, stream);
@@ -3001,7 +3001,7 @@ void Decode_PixelAspectInformation(PS_PixelAspectInformation x, PS_InStream stre
         case 2:
             x->size = (uint16) GetInteger(1, 256, stream);
             x->extendedPAR = (PS_ExtendedPARItem)
-                             OSCL_DEFAULT_MALLOC(x->size * sizeof(S_ExtendedPARItem));
+                             PerDecodeMalloc(stream, x->size * sizeof(S_ExtendedPARItem));
             for (i = 0; i < x->size; ++i)
             {
                 Decode_ExtendedPARItem(x->extendedPAR + i, stream);
@@ -3060,7 +3060,7 @@ void Decode_MPI(PS_MPI x, PS_InStream stream)
     {
         x->size_of_customPCF = (uint8) GetInteger(1, 16, stream);
         x->customPCF = (PS_CustomPCFItem)
-                       OSCL_DEFAULT_MALLOC(x->size_of_customPCF * sizeof(S_CustomPCFItem));
+                       PerDecodeMalloc(stream, x->size_of_customPCF * sizeof(S_CustomPCFItem));
         for (i = 0; i < x->size_of_customPCF; ++i)
         {
             Decode_CustomPCFItem(x->customPCF + i, stream);
@@ -3117,7 +3117,7 @@ void Decode_H263VideoModeCombos(PS_H263VideoModeCombos x, PS_InStream stream)
     Decode_H263ModeComboFlags(&x->h263VideoUncoupledModes, stream);
     x->size_of_h263VideoCoupledModes = (uint8) GetInteger(1, 16, stream);
     x->h263VideoCoupledModes = (PS_H263ModeComboFlags)
-                               OSCL_DEFAULT_MALLOC(x->size_of_h263VideoCoupledModes * sizeof(S_H263ModeComboFlags));
+                               PerDecodeMalloc(stream, x->size_of_h263VideoCoupledModes * sizeof(S_H263ModeComboFlags));
     for (i = 0; i < x->size_of_h263VideoCoupledModes; ++i)
     {
         Decode_H263ModeComboFlags(x->h263VideoCoupledModes + i, stream);
@@ -3240,7 +3240,7 @@ void Decode_AudioCapability(PS_AudioCapability x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
@@ -3265,7 +3265,7 @@ void Decode_AudioCapability(PS_AudioCapability x, PS_InStream stream)
             x->g722_48k = (uint16) GetInteger(1, 256, stream);
             break;
         case 8:
-            x->g7231 = (PS_G7231) OSCL_DEFAULT_MALLOC(sizeof(S_G7231));
+            x->g7231 = (PS_G7231) PerDecodeMalloc(stream, sizeof(S_G7231));
             Decode_G7231(x->g7231, stream);
             break;
         case 9:
@@ -3278,11 +3278,11 @@ void Decode_AudioCapability(PS_AudioCapability x, PS_InStream stream)
             x->g729AnnexA = (uint16) GetInteger(1, 256, stream);
             break;
         case 12:
-            x->is11172AudioCapability = (PS_IS11172AudioCapability) OSCL_DEFAULT_MALLOC(sizeof(S_IS11172AudioCapability));
+            x->is11172AudioCapability = (PS_IS11172AudioCapability) PerDecodeMalloc(stream, sizeof(S_IS11172AudioCapability));
             Decode_IS11172AudioCapability(x->is11172AudioCapability, stream);
             break;
         case 13:
-            x->is13818AudioCapability = (PS_IS13818AudioCapability) OSCL_DEFAULT_MALLOC(sizeof(S_IS13818AudioCapability));
+            x->is13818AudioCapability = (PS_IS13818AudioCapability) PerDecodeMalloc(stream, sizeof(S_IS13818AudioCapability));
             Decode_IS13818AudioCapability(x->is13818AudioCapability, stream);
             break;
             /* ------------------------------- */
@@ -3300,37 +3300,37 @@ void Decode_AudioCapability(PS_AudioCapability x, PS_InStream stream)
             break;
         case 16:
             GetLengthDet(stream);
-            x->g7231AnnexCCapability = (PS_G7231AnnexCCapability) OSCL_DEFAULT_MALLOC(sizeof(S_G7231AnnexCCapability));
+            x->g7231AnnexCCapability = (PS_G7231AnnexCCapability) PerDecodeMalloc(stream, sizeof(S_G7231AnnexCCapability));
             Decode_G7231AnnexCCapability(x->g7231AnnexCCapability, stream);
             ReadRemainingBits(stream);
             break;
         case 17:
             GetLengthDet(stream);
-            x->gsmFullRate = (PS_GSMAudioCapability) OSCL_DEFAULT_MALLOC(sizeof(S_GSMAudioCapability));
+            x->gsmFullRate = (PS_GSMAudioCapability) PerDecodeMalloc(stream, sizeof(S_GSMAudioCapability));
             Decode_GSMAudioCapability(x->gsmFullRate, stream);
             ReadRemainingBits(stream);
             break;
         case 18:
             GetLengthDet(stream);
-            x->gsmHalfRate = (PS_GSMAudioCapability) OSCL_DEFAULT_MALLOC(sizeof(S_GSMAudioCapability));
+            x->gsmHalfRate = (PS_GSMAudioCapability) PerDecodeMalloc(stream, sizeof(S_GSMAudioCapability));
             Decode_GSMAudioCapability(x->gsmHalfRate, stream);
             ReadRemainingBits(stream);
             break;
         case 19:
             GetLengthDet(stream);
-            x->gsmEnhancedFullRate = (PS_GSMAudioCapability) OSCL_DEFAULT_MALLOC(sizeof(S_GSMAudioCapability));
+            x->gsmEnhancedFullRate = (PS_GSMAudioCapability) PerDecodeMalloc(stream, sizeof(S_GSMAudioCapability));
             Decode_GSMAudioCapability(x->gsmEnhancedFullRate, stream);
             ReadRemainingBits(stream);
             break;
         case 20:
             GetLengthDet(stream);
-            x->genericAudioCapability = (PS_GenericCapability) OSCL_DEFAULT_MALLOC(sizeof(S_GenericCapability));
+            x->genericAudioCapability = (PS_GenericCapability) PerDecodeMalloc(stream, sizeof(S_GenericCapability));
             Decode_GenericCapability(x->genericAudioCapability, stream);
             ReadRemainingBits(stream);
             break;
         case 21:
             GetLengthDet(stream);
-            x->g729Extensions = (PS_G729Extensions) OSCL_DEFAULT_MALLOC(sizeof(S_G729Extensions));
+            x->g729Extensions = (PS_G729Extensions) PerDecodeMalloc(stream, sizeof(S_G729Extensions));
             Decode_G729Extensions(x->g729Extensions, stream);
             ReadRemainingBits(stream);
             break;
@@ -3572,42 +3572,42 @@ void Decode_Application(PS_Application x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
-            x->t120 = (PS_DataProtocolCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataProtocolCapability));
+            x->t120 = (PS_DataProtocolCapability) PerDecodeMalloc(stream, sizeof(S_DataProtocolCapability));
             Decode_DataProtocolCapability(x->t120, stream);
             break;
         case 2:
-            x->dsm_cc = (PS_DataProtocolCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataProtocolCapability));
+            x->dsm_cc = (PS_DataProtocolCapability) PerDecodeMalloc(stream, sizeof(S_DataProtocolCapability));
             Decode_DataProtocolCapability(x->dsm_cc, stream);
             break;
         case 3:
-            x->userData = (PS_DataProtocolCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataProtocolCapability));
+            x->userData = (PS_DataProtocolCapability) PerDecodeMalloc(stream, sizeof(S_DataProtocolCapability));
             Decode_DataProtocolCapability(x->userData, stream);
             break;
         case 4:
-            x->t84 = (PS_T84) OSCL_DEFAULT_MALLOC(sizeof(S_T84));
+            x->t84 = (PS_T84) PerDecodeMalloc(stream, sizeof(S_T84));
             Decode_T84(x->t84, stream);
             break;
         case 5:
-            x->t434 = (PS_DataProtocolCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataProtocolCapability));
+            x->t434 = (PS_DataProtocolCapability) PerDecodeMalloc(stream, sizeof(S_DataProtocolCapability));
             Decode_DataProtocolCapability(x->t434, stream);
             break;
         case 6:
-            x->h224 = (PS_DataProtocolCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataProtocolCapability));
+            x->h224 = (PS_DataProtocolCapability) PerDecodeMalloc(stream, sizeof(S_DataProtocolCapability));
             Decode_DataProtocolCapability(x->h224, stream);
             break;
         case 7:
-            x->nlpid = (PS_Nlpid) OSCL_DEFAULT_MALLOC(sizeof(S_Nlpid));
+            x->nlpid = (PS_Nlpid) PerDecodeMalloc(stream, sizeof(S_Nlpid));
             Decode_Nlpid(x->nlpid, stream);
             break;
         case 8:
             /* (dsvdControl is NULL) */
             break;
         case 9:
-            x->h222DataPartitioning = (PS_DataProtocolCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataProtocolCapability));
+            x->h222DataPartitioning = (PS_DataProtocolCapability) PerDecodeMalloc(stream, sizeof(S_DataProtocolCapability));
             Decode_DataProtocolCapability(x->h222DataPartitioning, stream);
             break;
             /* ------------------------------- */
@@ -3615,25 +3615,25 @@ void Decode_Application(PS_Application x, PS_InStream stream)
             /* ------------------------------- */
         case 10:
             GetLengthDet(stream);
-            x->t30fax = (PS_DataProtocolCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataProtocolCapability));
+            x->t30fax = (PS_DataProtocolCapability) PerDecodeMalloc(stream, sizeof(S_DataProtocolCapability));
             Decode_DataProtocolCapability(x->t30fax, stream);
             ReadRemainingBits(stream);
             break;
         case 11:
             GetLengthDet(stream);
-            x->t140 = (PS_DataProtocolCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataProtocolCapability));
+            x->t140 = (PS_DataProtocolCapability) PerDecodeMalloc(stream, sizeof(S_DataProtocolCapability));
             Decode_DataProtocolCapability(x->t140, stream);
             ReadRemainingBits(stream);
             break;
         case 12:
             GetLengthDet(stream);
-            x->t38fax = (PS_T38fax) OSCL_DEFAULT_MALLOC(sizeof(S_T38fax));
+            x->t38fax = (PS_T38fax) PerDecodeMalloc(stream, sizeof(S_T38fax));
             Decode_T38fax(x->t38fax, stream);
             ReadRemainingBits(stream);
             break;
         case 13:
             GetLengthDet(stream);
-            x->genericDataCapability = (PS_GenericCapability) OSCL_DEFAULT_MALLOC(sizeof(S_GenericCapability));
+            x->genericDataCapability = (PS_GenericCapability) PerDecodeMalloc(stream, sizeof(S_GenericCapability));
             Decode_GenericCapability(x->genericDataCapability, stream);
             ReadRemainingBits(stream);
             break;
@@ -3679,7 +3679,7 @@ void Decode_DataProtocolCapability(PS_DataProtocolCapability x, PS_InStream stre
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
@@ -3725,7 +3725,7 @@ void Decode_DataProtocolCapability(PS_DataProtocolCapability x, PS_InStream stre
             break;
         case 11:
             GetLengthDet(stream);
-            x->v76wCompression = (PS_V76wCompression) OSCL_DEFAULT_MALLOC(sizeof(S_V76wCompression));
+            x->v76wCompression = (PS_V76wCompression) PerDecodeMalloc(stream, sizeof(S_V76wCompression));
             Decode_V76wCompression(x->v76wCompression, stream);
             ReadRemainingBits(stream);
             break;
@@ -3754,15 +3754,15 @@ void Decode_V76wCompression(PS_V76wCompression x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->transmitCompression = (PS_CompressionType) OSCL_DEFAULT_MALLOC(sizeof(S_CompressionType));
+            x->transmitCompression = (PS_CompressionType) PerDecodeMalloc(stream, sizeof(S_CompressionType));
             Decode_CompressionType(x->transmitCompression, stream);
             break;
         case 1:
-            x->receiveCompression = (PS_CompressionType) OSCL_DEFAULT_MALLOC(sizeof(S_CompressionType));
+            x->receiveCompression = (PS_CompressionType) PerDecodeMalloc(stream, sizeof(S_CompressionType));
             Decode_CompressionType(x->receiveCompression, stream);
             break;
         case 2:
-            x->transmitAndReceiveCompression = (PS_CompressionType) OSCL_DEFAULT_MALLOC(sizeof(S_CompressionType));
+            x->transmitAndReceiveCompression = (PS_CompressionType) PerDecodeMalloc(stream, sizeof(S_CompressionType));
             Decode_CompressionType(x->transmitAndReceiveCompression, stream);
             break;
             /* ------------------------------- */
@@ -3783,7 +3783,7 @@ void Decode_CompressionType(PS_CompressionType x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->v42bis = (PS_V42bis) OSCL_DEFAULT_MALLOC(sizeof(S_V42bis));
+            x->v42bis = (PS_V42bis) PerDecodeMalloc(stream, sizeof(S_V42bis));
             Decode_V42bis(x->v42bis, stream);
             break;
             /* ------------------------------- */
@@ -3831,7 +3831,7 @@ void Decode_T84Profile(PS_T84Profile x, PS_InStream stream)
             /* (t84Unrestricted is NULL) */
             break;
         case 1:
-            x->t84Restricted = (PS_T84Restricted) OSCL_DEFAULT_MALLOC(sizeof(S_T84Restricted));
+            x->t84Restricted = (PS_T84Restricted) PerDecodeMalloc(stream, sizeof(S_T84Restricted));
             Decode_T84Restricted(x->t84Restricted, stream);
             break;
         default:
@@ -4038,7 +4038,7 @@ void Decode_EncryptionCapability(PS_EncryptionCapability x, PS_InStream stream)
     uint16 i;
     x->size = (uint16) GetInteger(1, 256, stream);
     x->item = (PS_MediaEncryptionAlgorithm)
-              OSCL_DEFAULT_MALLOC(x->size * sizeof(S_MediaEncryptionAlgorithm));
+              PerDecodeMalloc(stream, x->size * sizeof(S_MediaEncryptionAlgorithm));
     for (i = 0; i < x->size; ++i)
     {
         Decode_MediaEncryptionAlgorithm(x->item + i, stream);
@@ -4054,11 +4054,11 @@ void Decode_MediaEncryptionAlgorithm(PS_MediaEncryptionAlgorithm x, PS_InStream
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
-            x->algorithm = (PS_OBJECTIDENT) OSCL_DEFAULT_MALLOC(sizeof(S_OBJECTIDENT));
+            x->algorithm = (PS_OBJECTIDENT) PerDecodeMalloc(stream, sizeof(S_OBJECTIDENT));
             GetObjectID(x->algorithm, stream);
             break;
             /* ------------------------------- */
@@ -4136,7 +4136,7 @@ void Decode_UserInputCapability(PS_UserInputCapability x, PS_InStream stream)
         case 0:
             x->size = (uint8) GetInteger(1, 16, stream);
             x->nonStandard = (PS_NonStandardParameter)
-                             OSCL_DEFAULT_MALLOC(x->size * sizeof(S_NonStandardParameter));
+                             PerDecodeMalloc(stream, x->size * sizeof(S_NonStandardParameter));
             for (i = 0; i < x->size; ++i)
             {
                 Decode_NonStandardParameter(x->nonStandard + i, stream);
@@ -4181,7 +4181,7 @@ void Decode_ConferenceCapability(PS_ConferenceCapability x, PS_InStream stream)
     {
         x->size_of_nonStandardData = (uint16) GetLengthDet(stream);
         x->nonStandardData = (PS_NonStandardParameter)
-                             OSCL_DEFAULT_MALLOC(x->size_of_nonStandardData * sizeof(S_NonStandardParameter));
+                             PerDecodeMalloc(stream, x->size_of_nonStandardData * sizeof(S_NonStandardParameter));
         for (i = 0; i < x->size_of_nonStandardData; ++i)
         {
             Decode_NonStandardParameter(x->nonStandardData + i, stream);
@@ -4241,7 +4241,7 @@ void Decode_GenericCapability(PS_GenericCapability x, PS_InStream stream)
     {
         x->size_of_collapsing = (uint16) GetLengthDet(stream);
         x->collapsing = (PS_GenericParameter)
-                        OSCL_DEFAULT_MALLOC(x->size_of_collapsing * sizeof(S_GenericParameter));
+                        PerDecodeMalloc(stream, x->size_of_collapsing * sizeof(S_GenericParameter));
         for (i = 0; i < x->size_of_collapsing; ++i)
         {
             Decode_GenericParameter(x->collapsing + i, stream);
@@ -4251,7 +4251,7 @@ void Decode_GenericCapability(PS_GenericCapability x, PS_InStream stream)
     {
         x->size_of_nonCollapsing = (uint16) GetLengthDet(stream);
         x->nonCollapsing = (PS_GenericParameter)
-                           OSCL_DEFAULT_MALLOC(x->size_of_nonCollapsing * sizeof(S_GenericParameter));
+                           PerDecodeMalloc(stream, x->size_of_nonCollapsing * sizeof(S_GenericParameter));
         for (i = 0; i < x->size_of_nonCollapsing; ++i)
         {
             Decode_GenericParameter(x->nonCollapsing + i, stream);
@@ -4287,19 +4287,19 @@ void Decode_CapabilityIdentifier(PS_CapabilityIdentifier x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->standard = (PS_OBJECTIDENT) OSCL_DEFAULT_MALLOC(sizeof(S_OBJECTIDENT));
+            x->standard = (PS_OBJECTIDENT) PerDecodeMalloc(stream, sizeof(S_OBJECTIDENT));
             GetObjectID(x->standard, stream);
             break;
         case 1:
-            x->h221NonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->h221NonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->h221NonStandard, stream);
             break;
         case 2:
-            x->uuid = (PS_OCTETSTRING) OSCL_DEFAULT_MALLOC(sizeof(S_OCTETSTRING));
+            x->uuid = (PS_OCTETSTRING) PerDecodeMalloc(stream, sizeof(S_OCTETSTRING));
             GetOctetString(0, 16, 16, x->uuid, stream);
             break;
         case 3:
-            x->domainBased = (PS_int8STRING) OSCL_DEFAULT_MALLOC(sizeof(S_int8STRING));
+            x->domainBased = (PS_int8STRING) PerDecodeMalloc(stream, sizeof(S_int8STRING));
             GetCharString("IA5String", 0, 1, 64, NULL, x->domainBased, stream);
             break;
             /* ------------------------------- */
@@ -4328,7 +4328,7 @@ void Decode_GenericParameter(PS_GenericParameter x, PS_InStream stream)
     {
         x->size_of_supersedes = (uint16) GetLengthDet(stream);
         x->supersedes = (PS_ParameterIdentifier)
-                        OSCL_DEFAULT_MALLOC(x->size_of_supersedes * sizeof(S_ParameterIdentifier));
+                        PerDecodeMalloc(stream, x->size_of_supersedes * sizeof(S_ParameterIdentifier));
         for (i = 0; i < x->size_of_supersedes; ++i)
         {
             Decode_ParameterIdentifier(x->supersedes + i, stream);
@@ -4359,15 +4359,15 @@ void Decode_ParameterIdentifier(PS_ParameterIdentifier x, PS_InStream stream)
             x->standard = (uint8) GetInteger(0, 127, stream);
             break;
         case 1:
-            x->h221NonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->h221NonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->h221NonStandard, stream);
             break;
         case 2:
-            x->uuid = (PS_OCTETSTRING) OSCL_DEFAULT_MALLOC(sizeof(S_OCTETSTRING));
+            x->uuid = (PS_OCTETSTRING) PerDecodeMalloc(stream, sizeof(S_OCTETSTRING));
             GetOctetString(0, 16, 16, x->uuid, stream);
             break;
         case 3:
-            x->domainBased = (PS_int8STRING) OSCL_DEFAULT_MALLOC(sizeof(S_int8STRING));
+            x->domainBased = (PS_int8STRING) PerDecodeMalloc(stream, sizeof(S_int8STRING));
             GetCharString("IA5String", 0, 1, 64, NULL, x->domainBased, stream);
             break;
             /* ------------------------------- */
@@ -4407,13 +4407,13 @@ void Decode_ParameterValue(PS_ParameterValue x, PS_InStream stream)
             x->unsigned32Max = GetInteger(0, 0xffffffff, stream);
             break;
         case 6:
-            x->octetString = (PS_OCTETSTRING) OSCL_DEFAULT_MALLOC(sizeof(S_OCTETSTRING));
+            x->octetString = (PS_OCTETSTRING) PerDecodeMalloc(stream, sizeof(S_OCTETSTRING));
             GetOctetString(1, 0, 0, x->octetString, stream);
             break;
         case 7:
             x->size = (uint16) GetLengthDet(stream);
             x->genericParameter = (PS_GenericParameter)
-                                  OSCL_DEFAULT_MALLOC(x->size * sizeof(S_GenericParameter));
+                                  PerDecodeMalloc(stream, x->size * sizeof(S_GenericParameter));
             for (i = 0; i < x->size; ++i)
             {
                 Decode_GenericParameter(x->genericParameter + i, stream);
@@ -4526,11 +4526,11 @@ void Decode_RlcMultiplexParameters(PS_RlcMultiplexParameters x, PS_InStream stre
     switch (x->index)
     {
         case 0:
-            x->h223LogicalChannelParameters = (PS_H223LogicalChannelParameters) OSCL_DEFAULT_MALLOC(sizeof(S_H223LogicalChannelParameters));
+            x->h223LogicalChannelParameters = (PS_H223LogicalChannelParameters) PerDecodeMalloc(stream, sizeof(S_H223LogicalChannelParameters));
             Decode_H223LogicalChannelParameters(x->h223LogicalChannelParameters, stream);
             break;
         case 1:
-            x->v76LogicalChannelParameters = (PS_V76LogicalChannelParameters) OSCL_DEFAULT_MALLOC(sizeof(S_V76LogicalChannelParameters));
+            x->v76LogicalChannelParameters = (PS_V76LogicalChannelParameters) PerDecodeMalloc(stream, sizeof(S_V76LogicalChannelParameters));
             Decode_V76LogicalChannelParameters(x->v76LogicalChannelParameters, stream);
             break;
             /* ------------------------------- */
@@ -4538,7 +4538,7 @@ void Decode_RlcMultiplexParameters(PS_RlcMultiplexParameters x, PS_InStream stre
             /* ------------------------------- */
         case 2:
             GetLengthDet(stream);
-            x->h2250LogicalChannelParameters = (PS_H2250LogicalChannelParameters) OSCL_DEFAULT_MALLOC(sizeof(S_H2250LogicalChannelParameters));
+            x->h2250LogicalChannelParameters = (PS_H2250LogicalChannelParameters) PerDecodeMalloc(stream, sizeof(S_H2250LogicalChannelParameters));
             Decode_H2250LogicalChannelParameters(x->h2250LogicalChannelParameters, stream);
             ReadRemainingBits(stream);
             break;
@@ -4602,15 +4602,15 @@ void Decode_MultiplexParameters(PS_MultiplexParameters x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->h222LogicalChannelParameters = (PS_H222LogicalChannelParameters) OSCL_DEFAULT_MALLOC(sizeof(S_H222LogicalChannelParameters));
+            x->h222LogicalChannelParameters = (PS_H222LogicalChannelParameters) PerDecodeMalloc(stream, sizeof(S_H222LogicalChannelParameters));
             Decode_H222LogicalChannelParameters(x->h222LogicalChannelParameters, stream);
             break;
         case 1:
-            x->h223LogicalChannelParameters = (PS_H223LogicalChannelParameters) OSCL_DEFAULT_MALLOC(sizeof(S_H223LogicalChannelParameters));
+            x->h223LogicalChannelParameters = (PS_H223LogicalChannelParameters) PerDecodeMalloc(stream, sizeof(S_H223LogicalChannelParameters));
             Decode_H223LogicalChannelParameters(x->h223LogicalChannelParameters, stream);
             break;
         case 2:
-            x->v76LogicalChannelParameters = (PS_V76LogicalChannelParameters) OSCL_DEFAULT_MALLOC(sizeof(S_V76LogicalChannelParameters));
+            x->v76LogicalChannelParameters = (PS_V76LogicalChannelParameters) PerDecodeMalloc(stream, sizeof(S_V76LogicalChannelParameters));
             Decode_V76LogicalChannelParameters(x->v76LogicalChannelParameters, stream);
             break;
             /* ------------------------------- */
@@ -4618,7 +4618,7 @@ void Decode_MultiplexParameters(PS_MultiplexParameters x, PS_InStream stream)
             /* ------------------------------- */
         case 3:
             GetLengthDet(stream);
-            x->h2250LogicalChannelParameters = (PS_H2250LogicalChannelParameters) OSCL_DEFAULT_MALLOC(sizeof(S_H2250LogicalChannelParameters));
+            x->h2250LogicalChannelParameters = (PS_H2250LogicalChannelParameters) PerDecodeMalloc(stream, sizeof(S_H2250LogicalChannelParameters));
             Decode_H2250LogicalChannelParameters(x->h2250LogicalChannelParameters, stream);
             ReadRemainingBits(stream);
             break;
@@ -4710,15 +4710,15 @@ void Decode_NetworkAddress(PS_NetworkAddress x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->q2931Address = (PS_Q2931Address) OSCL_DEFAULT_MALLOC(sizeof(S_Q2931Address));
+            x->q2931Address = (PS_Q2931Address) PerDecodeMalloc(stream, sizeof(S_Q2931Address));
             Decode_Q2931Address(x->q2931Address, stream);
             break;
         case 1:
-            x->e164Address = (PS_int8STRING) OSCL_DEFAULT_MALLOC(sizeof(S_int8STRING));
+            x->e164Address = (PS_int8STRING) PerDecodeMalloc(stream, sizeof(S_int8STRING));
             GetCharString("IA5String(SIZE(1..128))", 0, 1, 128, "0123456789#*,", x->e164Address, stream);
             break;
         case 2:
-            x->localAreaAddress = (PS_TransportAddress) OSCL_DEFAULT_MALLOC(sizeof(S_TransportAddress));
+            x->localAreaAddress = (PS_TransportAddress) PerDecodeMalloc(stream, sizeof(S_TransportAddress));
             Decode_TransportAddress(x->localAreaAddress, stream);
             break;
             /* ------------------------------- */
@@ -4790,11 +4790,11 @@ void Decode_Address(PS_Address x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->internationalNumber = (PS_int8STRING) OSCL_DEFAULT_MALLOC(sizeof(S_int8STRING));
+            x->internationalNumber = (PS_int8STRING) PerDecodeMalloc(stream, sizeof(S_int8STRING));
             GetCharString("NumericString(SIZE(1..16))", 0, 1, 16, NULL, x->internationalNumber, stream);
             break;
         case 1:
-            x->nsapAddress = (PS_OCTETSTRING) OSCL_DEFAULT_MALLOC(sizeof(S_OCTETSTRING));
+            x->nsapAddress = (PS_OCTETSTRING) PerDecodeMalloc(stream, sizeof(S_OCTETSTRING));
             GetOctetString(0, 1, 20, x->nsapAddress, stream);
             break;
             /* ------------------------------- */
@@ -4838,26 +4838,26 @@ void Decode_DataType(PS_DataType x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
             /* (nullData is NULL) */
             break;
         case 2:
-            x->videoData = (PS_VideoCapability) OSCL_DEFAULT_MALLOC(sizeof(S_VideoCapability));
+            x->videoData = (PS_VideoCapability) PerDecodeMalloc(stream, sizeof(S_VideoCapability));
             Decode_VideoCapability(x->videoData, stream);
             break;
         case 3:
-            x->audioData = (PS_AudioCapability) OSCL_DEFAULT_MALLOC(sizeof(S_AudioCapability));
+            x->audioData = (PS_AudioCapability) PerDecodeMalloc(stream, sizeof(S_AudioCapability));
             Decode_AudioCapability(x->audioData, stream);
             break;
         case 4:
-            x->data = (PS_DataApplicationCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataApplicationCapability));
+            x->data = (PS_DataApplicationCapability) PerDecodeMalloc(stream, sizeof(S_DataApplicationCapability));
             Decode_DataApplicationCapability(x->data, stream);
             break;
         case 5:
-            x->encryptionData = (PS_EncryptionMode) OSCL_DEFAULT_MALLOC(sizeof(S_EncryptionMode));
+            x->encryptionData = (PS_EncryptionMode) PerDecodeMalloc(stream, sizeof(S_EncryptionMode));
             Decode_EncryptionMode(x->encryptionData, stream);
             break;
             /* ------------------------------- */
@@ -4865,13 +4865,13 @@ void Decode_DataType(PS_DataType x, PS_InStream stream)
             /* ------------------------------- */
         case 6:
             GetLengthDet(stream);
-            x->h235Control = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->h235Control = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->h235Control, stream);
             ReadRemainingBits(stream);
             break;
         case 7:
             GetLengthDet(stream);
-            x->h235Media = (PS_H235Media) OSCL_DEFAULT_MALLOC(sizeof(S_H235Media));
+            x->h235Media = (PS_H235Media) PerDecodeMalloc(stream, sizeof(S_H235Media));
             Decode_H235Media(x->h235Media, stream);
             ReadRemainingBits(stream);
             break;
@@ -4914,19 +4914,19 @@ void Decode_MediaType(PS_MediaType x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
-            x->videoData = (PS_VideoCapability) OSCL_DEFAULT_MALLOC(sizeof(S_VideoCapability));
+            x->videoData = (PS_VideoCapability) PerDecodeMalloc(stream, sizeof(S_VideoCapability));
             Decode_VideoCapability(x->videoData, stream);
             break;
         case 2:
-            x->audioData = (PS_AudioCapability) OSCL_DEFAULT_MALLOC(sizeof(S_AudioCapability));
+            x->audioData = (PS_AudioCapability) PerDecodeMalloc(stream, sizeof(S_AudioCapability));
             Decode_AudioCapability(x->audioData, stream);
             break;
         case 3:
-            x->data = (PS_DataApplicationCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataApplicationCapability));
+            x->data = (PS_DataApplicationCapability) PerDecodeMalloc(stream, sizeof(S_DataApplicationCapability));
             Decode_DataApplicationCapability(x->data, stream);
             break;
             /* ------------------------------- */
@@ -5010,7 +5010,7 @@ void Decode_AdaptationLayerType(PS_AdaptationLayerType x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
@@ -5026,7 +5026,7 @@ void Decode_AdaptationLayerType(PS_AdaptationLayerType x, PS_InStream stream)
             /* (al2WithSequenceNumbers is NULL) */
             break;
         case 5:
-            x->al3 = (PS_Al3) OSCL_DEFAULT_MALLOC(sizeof(S_Al3));
+            x->al3 = (PS_Al3) PerDecodeMalloc(stream, sizeof(S_Al3));
             Decode_Al3(x->al3, stream);
             break;
             /* ------------------------------- */
@@ -5034,19 +5034,19 @@ void Decode_AdaptationLayerType(PS_AdaptationLayerType x, PS_InStream stream)
             /* ------------------------------- */
         case 6:
             GetLengthDet(stream);
-            x->al1M = (PS_H223AL1MParameters) OSCL_DEFAULT_MALLOC(sizeof(S_H223AL1MParameters));
+            x->al1M = (PS_H223AL1MParameters) PerDecodeMalloc(stream, sizeof(S_H223AL1MParameters));
             Decode_H223AL1MParameters(x->al1M, stream);
             ReadRemainingBits(stream);
             break;
         case 7:
             GetLengthDet(stream);
-            x->al2M = (PS_H223AL2MParameters) OSCL_DEFAULT_MALLOC(sizeof(S_H223AL2MParameters));
+            x->al2M = (PS_H223AL2MParameters) PerDecodeMalloc(stream, sizeof(S_H223AL2MParameters));
             Decode_H223AL2MParameters(x->al2M, stream);
             ReadRemainingBits(stream);
             break;
         case 8:
             GetLengthDet(stream);
-            x->al3M = (PS_H223AL3MParameters) OSCL_DEFAULT_MALLOC(sizeof(S_H223AL3MParameters));
+            x->al3M = (PS_H223AL3MParameters) PerDecodeMalloc(stream, sizeof(S_H223AL3MParameters));
             Decode_H223AL3MParameters(x->al3M, stream);
             ReadRemainingBits(stream);
             break;
@@ -5114,11 +5114,11 @@ void Decode_ArqType(PS_ArqType x, PS_InStream stream)
             /* (noArq is NULL) */
             break;
         case 1:
-            x->typeIArq = (PS_H223AnnexCArqParameters) OSCL_DEFAULT_MALLOC(sizeof(S_H223AnnexCArqParameters));
+            x->typeIArq = (PS_H223AnnexCArqParameters) PerDecodeMalloc(stream, sizeof(S_H223AnnexCArqParameters));
             Decode_H223AnnexCArqParameters(x->typeIArq, stream);
             break;
         case 2:
-            x->typeIIArq = (PS_H223AnnexCArqParameters) OSCL_DEFAULT_MALLOC(sizeof(S_H223AnnexCArqParameters));
+            x->typeIIArq = (PS_H223AnnexCArqParameters) PerDecodeMalloc(stream, sizeof(S_H223AnnexCArqParameters));
             Decode_H223AnnexCArqParameters(x->typeIIArq, stream);
             break;
             /* ------------------------------- */
@@ -5319,11 +5319,11 @@ void Decode_Al3ArqType(PS_Al3ArqType x, PS_InStream stream)
             /* (noArq is NULL) */
             break;
         case 1:
-            x->typeIArq = (PS_H223AnnexCArqParameters) OSCL_DEFAULT_MALLOC(sizeof(S_H223AnnexCArqParameters));
+            x->typeIArq = (PS_H223AnnexCArqParameters) PerDecodeMalloc(stream, sizeof(S_H223AnnexCArqParameters));
             Decode_H223AnnexCArqParameters(x->typeIArq, stream);
             break;
         case 2:
-            x->typeIIArq = (PS_H223AnnexCArqParameters) OSCL_DEFAULT_MALLOC(sizeof(S_H223AnnexCArqParameters));
+            x->typeIIArq = (PS_H223AnnexCArqParameters) PerDecodeMalloc(stream, sizeof(S_H223AnnexCArqParameters));
             Decode_H223AnnexCArqParameters(x->typeIIArq, stream);
             break;
             /* ------------------------------- */
@@ -5490,7 +5490,7 @@ void Decode_Mode(PS_Mode x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->eRM = (PS_ERM) OSCL_DEFAULT_MALLOC(sizeof(S_ERM));
+            x->eRM = (PS_ERM) PerDecodeMalloc(stream, sizeof(S_ERM));
             Decode_ERM(x->eRM, stream);
             break;
         case 1:
@@ -5656,7 +5656,7 @@ void Decode_H2250LogicalChannelParameters(PS_H2250LogicalChannelParameters x, PS
     {
         x->size_of_nonStandard = (uint16) GetLengthDet(stream);
         x->nonStandard = (PS_NonStandardParameter)
-                         OSCL_DEFAULT_MALLOC(x->size_of_nonStandard * sizeof(S_NonStandardParameter));
+                         PerDecodeMalloc(stream, x->size_of_nonStandard * sizeof(S_NonStandardParameter));
         for (i = 0; i < x->size_of_nonStandard; ++i)
         {
             Decode_NonStandardParameter(x->nonStandard + i, stream);
@@ -5760,7 +5760,7 @@ void Decode_MediaPacketization(PS_MediaPacketization x, PS_InStream stream)
             /* ------------------------------- */
         case 1:
             GetLengthDet(stream);
-            x->rtpPayloadType = (PS_RTPPayloadType) OSCL_DEFAULT_MALLOC(sizeof(S_RTPPayloadType));
+            x->rtpPayloadType = (PS_RTPPayloadType) PerDecodeMalloc(stream, sizeof(S_RTPPayloadType));
             Decode_RTPPayloadType(x->rtpPayloadType, stream);
             ReadRemainingBits(stream);
             break;
@@ -5807,14 +5807,14 @@ void Decode_PayloadDescriptor(PS_PayloadDescriptor x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandardIdentifier = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandardIdentifier = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandardIdentifier, stream);
             break;
         case 1:
             x->rfc_number = (uint16) GetExtendedInteger(1, 32768, stream);
             break;
         case 2:
-            x->oid = (PS_OBJECTIDENT) OSCL_DEFAULT_MALLOC(sizeof(S_OBJECTIDENT));
+            x->oid = (PS_OBJECTIDENT) PerDecodeMalloc(stream, sizeof(S_OBJECTIDENT));
             GetObjectID(x->oid, stream);
             break;
             /* ------------------------------- */
@@ -5863,11 +5863,11 @@ void Decode_TransportAddress(PS_TransportAddress x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->unicastAddress = (PS_UnicastAddress) OSCL_DEFAULT_MALLOC(sizeof(S_UnicastAddress));
+            x->unicastAddress = (PS_UnicastAddress) PerDecodeMalloc(stream, sizeof(S_UnicastAddress));
             Decode_UnicastAddress(x->unicastAddress, stream);
             break;
         case 1:
-            x->multicastAddress = (PS_MulticastAddress) OSCL_DEFAULT_MALLOC(sizeof(S_MulticastAddress));
+            x->multicastAddress = (PS_MulticastAddress) PerDecodeMalloc(stream, sizeof(S_MulticastAddress));
             Decode_MulticastAddress(x->multicastAddress, stream);
             break;
             /* ------------------------------- */
@@ -5888,23 +5888,23 @@ void Decode_UnicastAddress(PS_UnicastAddress x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->iPAddress = (PS_IPAddress) OSCL_DEFAULT_MALLOC(sizeof(S_IPAddress));
+            x->iPAddress = (PS_IPAddress) PerDecodeMalloc(stream, sizeof(S_IPAddress));
             Decode_IPAddress(x->iPAddress, stream);
             break;
         case 1:
-            x->iPXAddress = (PS_IPXAddress) OSCL_DEFAULT_MALLOC(sizeof(S_IPXAddress));
+            x->iPXAddress = (PS_IPXAddress) PerDecodeMalloc(stream, sizeof(S_IPXAddress));
             Decode_IPXAddress(x->iPXAddress, stream);
             break;
         case 2:
-            x->iP6Address = (PS_IP6Address) OSCL_DEFAULT_MALLOC(sizeof(S_IP6Address));
+            x->iP6Address = (PS_IP6Address) PerDecodeMalloc(stream, sizeof(S_IP6Address));
             Decode_IP6Address(x->iP6Address, stream);
             break;
         case 3:
-            x->netBios = (PS_OCTETSTRING) OSCL_DEFAULT_MALLOC(sizeof(S_OCTETSTRING));
+            x->netBios = (PS_OCTETSTRING) PerDecodeMalloc(stream, sizeof(S_OCTETSTRING));
             GetOctetString(0, 16, 16, x->netBios, stream);
             break;
         case 4:
-            x->iPSourceRouteAddress = (PS_IPSourceRouteAddress) OSCL_DEFAULT_MALLOC(sizeof(S_IPSourceRouteAddress));
+            x->iPSourceRouteAddress = (PS_IPSourceRouteAddress) PerDecodeMalloc(stream, sizeof(S_IPSourceRouteAddress));
             Decode_IPSourceRouteAddress(x->iPSourceRouteAddress, stream);
             break;
             /* ------------------------------- */
@@ -5912,13 +5912,13 @@ void Decode_UnicastAddress(PS_UnicastAddress x, PS_InStream stream)
             /* ------------------------------- */
         case 5:
             GetLengthDet(stream);
-            x->nsap = (PS_OCTETSTRING) OSCL_DEFAULT_MALLOC(sizeof(S_OCTETSTRING));
+            x->nsap = (PS_OCTETSTRING) PerDecodeMalloc(stream, sizeof(S_OCTETSTRING));
             GetOctetString(0, 1, 20, x->nsap, stream);
             ReadRemainingBits(stream);
             break;
         case 6:
             GetLengthDet(stream);
-            x->nonStandardAddress = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandardAddress = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandardAddress, stream);
             ReadRemainingBits(stream);
             break;
@@ -5943,7 +5943,7 @@ void Decode_IPSourceRouteAddress(PS_IPSourceRouteAddress x, PS_InStream stream)
     x->tsapIdentifier = (uint16) GetInteger(0, 65535, stream);
     x->size_of_route = (uint16) GetLengthDet(stream);
     x->route = (PS_OCTETSTRING)
-               OSCL_DEFAULT_MALLOC(x->size_of_route * sizeof(S_OCTETSTRING));
+               PerDecodeMalloc(stream, x->size_of_route * sizeof(S_OCTETSTRING));
     for (i = 0; i < x->size_of_route; ++i)
     {
         GetOctetString(0, 4, 4, x->route + i, stream);
@@ -6062,11 +6062,11 @@ void Decode_MulticastAddress(PS_MulticastAddress x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->maIpAddress = (PS_MaIpAddress) OSCL_DEFAULT_MALLOC(sizeof(S_MaIpAddress));
+            x->maIpAddress = (PS_MaIpAddress) PerDecodeMalloc(stream, sizeof(S_MaIpAddress));
             Decode_MaIpAddress(x->maIpAddress, stream);
             break;
         case 1:
-            x->maIp6Address = (PS_MaIp6Address) OSCL_DEFAULT_MALLOC(sizeof(S_MaIp6Address));
+            x->maIp6Address = (PS_MaIp6Address) PerDecodeMalloc(stream, sizeof(S_MaIp6Address));
             Decode_MaIp6Address(x->maIp6Address, stream);
             break;
             /* ------------------------------- */
@@ -6074,13 +6074,13 @@ void Decode_MulticastAddress(PS_MulticastAddress x, PS_InStream stream)
             /* ------------------------------- */
         case 2:
             GetLengthDet(stream);
-            x->nsap = (PS_OCTETSTRING) OSCL_DEFAULT_MALLOC(sizeof(S_OCTETSTRING));
+            x->nsap = (PS_OCTETSTRING) PerDecodeMalloc(stream, sizeof(S_OCTETSTRING));
             GetOctetString(0, 1, 20, x->nsap, stream);
             ReadRemainingBits(stream);
             break;
         case 3:
             GetLengthDet(stream);
-            x->nonStandardAddress = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandardAddress = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandardAddress, stream);
             ReadRemainingBits(stream);
             break;
@@ -6160,7 +6160,7 @@ void Decode_EncryptionSync(PS_EncryptionSync x, PS_InStream stream)
     {
         x->size_of_escrowentry = (uint16) GetInteger(1, 256, stream);
         x->escrowentry = (PS_EscrowData)
-                         OSCL_DEFAULT_MALLOC(x->size_of_escrowentry * sizeof(S_EscrowData));
+                         PerDecodeMalloc(stream, x->size_of_escrowentry * sizeof(S_EscrowData));
         for (i = 0; i < x->size_of_escrowentry; ++i)
         {
             Decode_EscrowData(x->escrowentry + i, stream);
@@ -6264,7 +6264,7 @@ void Decode_ForwardMultiplexAckParameters(PS_ForwardMultiplexAckParameters x, PS
     switch (x->index)
     {
         case 0:
-            x->h2250LogicalChannelAckParameters = (PS_H2250LogicalChannelAckParameters) OSCL_DEFAULT_MALLOC(sizeof(S_H2250LogicalChannelAckParameters));
+            x->h2250LogicalChannelAckParameters = (PS_H2250LogicalChannelAckParameters) PerDecodeMalloc(stream, sizeof(S_H2250LogicalChannelAckParameters));
             Decode_H2250LogicalChannelAckParameters(x->h2250LogicalChannelAckParameters, stream);
             break;
             /* ------------------------------- */
@@ -6326,7 +6326,7 @@ void Decode_AckMultiplexParameters(PS_AckMultiplexParameters x, PS_InStream stre
     switch (x->index)
     {
         case 0:
-            x->h222LogicalChannelParameters = (PS_H222LogicalChannelParameters) OSCL_DEFAULT_MALLOC(sizeof(S_H222LogicalChannelParameters));
+            x->h222LogicalChannelParameters = (PS_H222LogicalChannelParameters) PerDecodeMalloc(stream, sizeof(S_H222LogicalChannelParameters));
             Decode_H222LogicalChannelParameters(x->h222LogicalChannelParameters, stream);
             break;
             /* ------------------------------- */
@@ -6334,7 +6334,7 @@ void Decode_AckMultiplexParameters(PS_AckMultiplexParameters x, PS_InStream stre
             /* ------------------------------- */
         case 1:
             GetLengthDet(stream);
-            x->h2250LogicalChannelParameters = (PS_H2250LogicalChannelParameters) OSCL_DEFAULT_MALLOC(sizeof(S_H2250LogicalChannelParameters));
+            x->h2250LogicalChannelParameters = (PS_H2250LogicalChannelParameters) PerDecodeMalloc(stream, sizeof(S_H2250LogicalChannelParameters));
             Decode_H2250LogicalChannelParameters(x->h2250LogicalChannelParameters, stream);
             ReadRemainingBits(stream);
             break;
@@ -6485,7 +6485,7 @@ void Decode_H2250LogicalChannelAckParameters(PS_H2250LogicalChannelAckParameters
     {
         x->size_of_nonStandard = (uint16) GetLengthDet(stream);
         x->nonStandard = (PS_NonStandardParameter)
-                         OSCL_DEFAULT_MALLOC(x->size_of_nonStandard * sizeof(S_NonStandardParameter));
+                         PerDecodeMalloc(stream, x->size_of_nonStandard * sizeof(S_NonStandardParameter));
         for (i = 0; i < x->size_of_nonStandard; ++i)
         {
             Decode_NonStandardParameter(x->nonStandard + i, stream);
@@ -6807,7 +6807,7 @@ void Decode_MultiplexEntrySend(PS_MultiplexEntrySend x, PS_InStream stream)
     x->sequenceNumber = (uint8) GetInteger(0, 255, stream);
     x->size_of_multiplexEntryDescriptors = (uint8) GetInteger(1, 15, stream);
     x->multiplexEntryDescriptors = (PS_MultiplexEntryDescriptor)
-                                   OSCL_DEFAULT_MALLOC(x->size_of_multiplexEntryDescriptors * sizeof(S_MultiplexEntryDescriptor));
+                                   PerDecodeMalloc(stream, x->size_of_multiplexEntryDescriptors * sizeof(S_MultiplexEntryDescriptor));
     for (i = 0; i < x->size_of_multiplexEntryDescriptors; ++i)
     {
         Decode_MultiplexEntryDescriptor(x->multiplexEntryDescriptors + i, stream);
@@ -6837,7 +6837,7 @@ void Decode_MultiplexEntryDescriptor(PS_MultiplexEntryDescriptor x, PS_InStream
     {
         x->size_of_elementList = (uint16) GetInteger(1, 256, stream);
         x->elementList = (PS_MultiplexElement)
-                         OSCL_DEFAULT_MALLOC(x->size_of_elementList * sizeof(S_MultiplexElement));
+                         PerDecodeMalloc(stream, x->size_of_elementList * sizeof(S_MultiplexElement));
         for (i = 0; i < x->size_of_elementList; ++i)
         {
             Decode_MultiplexElement(x->elementList + i, stream);
@@ -6888,7 +6888,7 @@ void Decode_MuxType(PS_MuxType x, PS_InStream stream)
         case 1:
             x->size = (uint8) GetInteger(2, 255, stream);
             x->subElementList = (PS_MultiplexElement)
-                                OSCL_DEFAULT_MALLOC(x->size * sizeof(S_MultiplexElement));
+                                PerDecodeMalloc(stream, x->size * sizeof(S_MultiplexElement));
             for (i = 0; i < x->size; ++i)
             {
                 Decode_MultiplexElement(x->subElementList + i, stream);
@@ -6911,7 +6911,7 @@ void Decode_MultiplexEntrySendAck(PS_MultiplexEntrySendAck x, PS_InStream stream
     extension = GetBoolean(stream);
     x->sequenceNumber = (uint8) GetInteger(0, 255, stream);
     x->size_of_multiplexTableEntryNumber = (uint8) GetInteger(1, 15, stream);
-    x->multiplexTableEntryNumber = (uint32*) OSCL_DEFAULT_MALLOC(x->size_of_multiplexTableEntryNumber * sizeof(uint32));
+    x->multiplexTableEntryNumber = (uint32*) PerDecodeMalloc(stream, x->size_of_multiplexTableEntryNumber * sizeof(uint32));
     for (i = 0; i < x->size_of_multiplexTableEntryNumber; ++i)
     {
         x->multiplexTableEntryNumber[i] = GetInteger(1, 15, stream);
@@ -6942,7 +6942,7 @@ void Decode_MultiplexEntrySendReject(PS_MultiplexEntrySendReject x, PS_InStream
     x->sequenceNumber = (uint8) GetInteger(0, 255, stream);
     x->size_of_rejectionDescriptions = (uint8) GetInteger(1, 15, stream);
     x->rejectionDescriptions = (PS_MultiplexEntryRejectionDescriptions)
-                               OSCL_DEFAULT_MALLOC(x->size_of_rejectionDescriptions * sizeof(S_MultiplexEntryRejectionDescriptions));
+                               PerDecodeMalloc(stream, x->size_of_rejectionDescriptions * sizeof(S_MultiplexEntryRejectionDescriptions));
     for (i = 0; i < x->size_of_rejectionDescriptions; ++i)
     {
         Decode_MultiplexEntryRejectionDescriptions(x->rejectionDescriptions + i, stream);
@@ -7018,7 +7018,7 @@ void Decode_MultiplexEntrySendRelease(PS_MultiplexEntrySendRelease x, PS_InStrea
 
     extension = GetBoolean(stream);
     x->size_of_multiplexTableEntryNumber = (uint8) GetInteger(1, 15, stream);
-    x->multiplexTableEntryNumber = (uint32*) OSCL_DEFAULT_MALLOC(x->size_of_multiplexTableEntryNumber * sizeof(uint32));
+    x->multiplexTableEntryNumber = (uint32*) PerDecodeMalloc(stream, x->size_of_multiplexTableEntryNumber * sizeof(uint32));
     for (i = 0; i < x->size_of_multiplexTableEntryNumber; ++i)
     {
         x->multiplexTableEntryNumber[i] = GetInteger(1, 15, stream);
@@ -7047,7 +7047,7 @@ void Decode_RequestMultiplexEntry(PS_RequestMultiplexEntry x, PS_InStream stream
 
     extension = GetBoolean(stream);
     x->size_of_entryNumbers = (uint8) GetInteger(1, 15, stream);
-    x->entryNumbers = (uint32*) OSCL_DEFAULT_MALLOC(x->size_of_entryNumbers * sizeof(uint32));
+    x->entryNumbers = (uint32*) PerDecodeMalloc(stream, x->size_of_entryNumbers * sizeof(uint32));
     for (i = 0; i < x->size_of_entryNumbers; ++i)
     {
         x->entryNumbers[i] = GetInteger(1, 15, stream);
@@ -7076,7 +7076,7 @@ void Decode_RequestMultiplexEntryAck(PS_RequestMultiplexEntryAck x, PS_InStream
 
     extension = GetBoolean(stream);
     x->size_of_entryNumbers = (uint8) GetInteger(1, 15, stream);
-    x->entryNumbers = (uint32*) OSCL_DEFAULT_MALLOC(x->size_of_entryNumbers * sizeof(uint32));
+    x->entryNumbers = (uint32*) PerDecodeMalloc(stream, x->size_of_entryNumbers * sizeof(uint32));
     for (i = 0; i < x->size_of_entryNumbers; ++i)
     {
         x->entryNumbers[i] = GetInteger(1, 15, stream);
@@ -7105,14 +7105,14 @@ void Decode_RequestMultiplexEntryReject(PS_RequestMultiplexEntryReject x, PS_InS
 
     extension = GetBoolean(stream);
     x->size_of_entryNumbers = (uint8) GetInteger(1, 15, stream);
-    x->entryNumbers = (uint32*) OSCL_DEFAULT_MALLOC(x->size_of_entryNumbers * sizeof(uint32));
+    x->entryNumbers = (uint32*) PerDecodeMalloc(stream, x->size_of_entryNumbers * sizeof(uint32));
     for (i = 0; i < x->size_of_entryNumbers; ++i)
     {
         x->entryNumbers[i] = GetInteger(1, 15, stream);
     }
     x->size_of_rejectionDescriptions = (uint8) GetInteger(1, 15, stream);
     x->rejectionDescriptions = (PS_RequestMultiplexEntryRejectionDescriptions)
-                               OSCL_DEFAULT_MALLOC(x->size_of_rejectionDescriptions * sizeof(S_RequestMultiplexEntryRejectionDescriptions));
+                               PerDecodeMalloc(stream, x->size_of_rejectionDescriptions * sizeof(S_RequestMultiplexEntryRejectionDescriptions));
     for (i = 0; i < x->size_of_rejectionDescriptions; ++i)
     {
         Decode_RequestMultiplexEntryRejectionDescriptions(x->rejectionDescriptions + i, stream);
@@ -7185,7 +7185,7 @@ void Decode_RequestMultiplexEntryRelease(PS_RequestMultiplexEntryRelease x, PS_I
 
     extension = GetBoolean(stream);
     x->size_of_entryNumbers = (uint8) GetInteger(1, 15, stream);
-    x->entryNumbers = (uint32*) OSCL_DEFAULT_MALLOC(x->size_of_entryNumbers * sizeof(uint32));
+    x->entryNumbers = (uint32*) PerDecodeMalloc(stream, x->size_of_entryNumbers * sizeof(uint32));
     for (i = 0; i < x->size_of_entryNumbers; ++i)
     {
         x->entryNumbers[i] = GetInteger(1, 15, stream);
@@ -7216,7 +7216,7 @@ void Decode_RequestMode(PS_RequestMode x, PS_InStream stream)
     x->sequenceNumber = (uint8) GetInteger(0, 255, stream);
     x->size_of_requestedModes = (uint16) GetInteger(1, 256, stream);
     x->requestedModes = (PS_ModeDescription)
-                        OSCL_DEFAULT_MALLOC(x->size_of_requestedModes * sizeof(S_ModeDescription));
+                        PerDecodeMalloc(stream, x->size_of_requestedModes * sizeof(S_ModeDescription));
     for (i = 0; i < x->size_of_requestedModes; ++i)
     {
         Decode_ModeDescription(x->requestedModes + i, stream);
@@ -7363,7 +7363,7 @@ void Decode_ModeDescription(PS_ModeDescription x, PS_InStream stream)
     uint16 i;
     x->size = (uint16) GetInteger(1, 256, stream);
     x->item = (PS_ModeElement)
-              OSCL_DEFAULT_MALLOC(x->size * sizeof(S_ModeElement));
+              PerDecodeMalloc(stream, x->size * sizeof(S_ModeElement));
     for (i = 0; i < x->size; ++i)
     {
         Decode_ModeElement(x->item + i, stream);
@@ -7431,23 +7431,23 @@ void Decode_ModeType(PS_ModeType x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
-            x->videoMode = (PS_VideoMode) OSCL_DEFAULT_MALLOC(sizeof(S_VideoMode));
+            x->videoMode = (PS_VideoMode) PerDecodeMalloc(stream, sizeof(S_VideoMode));
             Decode_VideoMode(x->videoMode, stream);
             break;
         case 2:
-            x->audioMode = (PS_AudioMode) OSCL_DEFAULT_MALLOC(sizeof(S_AudioMode));
+            x->audioMode = (PS_AudioMode) PerDecodeMalloc(stream, sizeof(S_AudioMode));
             Decode_AudioMode(x->audioMode, stream);
             break;
         case 3:
-            x->dataMode = (PS_DataMode) OSCL_DEFAULT_MALLOC(sizeof(S_DataMode));
+            x->dataMode = (PS_DataMode) PerDecodeMalloc(stream, sizeof(S_DataMode));
             Decode_DataMode(x->dataMode, stream);
             break;
         case 4:
-            x->encryptionMode = (PS_EncryptionMode) OSCL_DEFAULT_MALLOC(sizeof(S_EncryptionMode));
+            x->encryptionMode = (PS_EncryptionMode) PerDecodeMalloc(stream, sizeof(S_EncryptionMode));
             Decode_EncryptionMode(x->encryptionMode, stream);
             break;
             /* ------------------------------- */
@@ -7455,7 +7455,7 @@ void Decode_ModeType(PS_ModeType x, PS_InStream stream)
             /* ------------------------------- */
         case 5:
             GetLengthDet(stream);
-            x->h235Mode = (PS_H235Mode) OSCL_DEFAULT_MALLOC(sizeof(S_H235Mode));
+            x->h235Mode = (PS_H235Mode) PerDecodeMalloc(stream, sizeof(S_H235Mode));
             Decode_H235Mode(x->h235Mode, stream);
             ReadRemainingBits(stream);
             break;
@@ -7498,19 +7498,19 @@ void Decode_MediaMode(PS_MediaMode x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
-            x->videoMode = (PS_VideoMode) OSCL_DEFAULT_MALLOC(sizeof(S_VideoMode));
+            x->videoMode = (PS_VideoMode) PerDecodeMalloc(stream, sizeof(S_VideoMode));
             Decode_VideoMode(x->videoMode, stream);
             break;
         case 2:
-            x->audioMode = (PS_AudioMode) OSCL_DEFAULT_MALLOC(sizeof(S_AudioMode));
+            x->audioMode = (PS_AudioMode) PerDecodeMalloc(stream, sizeof(S_AudioMode));
             Decode_AudioMode(x->audioMode, stream);
             break;
         case 3:
-            x->dataMode = (PS_DataMode) OSCL_DEFAULT_MALLOC(sizeof(S_DataMode));
+            x->dataMode = (PS_DataMode) PerDecodeMalloc(stream, sizeof(S_DataMode));
             Decode_DataMode(x->dataMode, stream);
             break;
             /* ------------------------------- */
@@ -7555,7 +7555,7 @@ void Decode_ModeAdaptationLayerType(PS_ModeAdaptationLayerType x, PS_InStream st
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
@@ -7571,7 +7571,7 @@ void Decode_ModeAdaptationLayerType(PS_ModeAdaptationLayerType x, PS_InStream st
             /* (al2WithSequenceNumbers is NULL) */
             break;
         case 5:
-            x->modeAl3 = (PS_ModeAl3) OSCL_DEFAULT_MALLOC(sizeof(S_ModeAl3));
+            x->modeAl3 = (PS_ModeAl3) PerDecodeMalloc(stream, sizeof(S_ModeAl3));
             Decode_ModeAl3(x->modeAl3, stream);
             break;
             /* ------------------------------- */
@@ -7579,19 +7579,19 @@ void Decode_ModeAdaptationLayerType(PS_ModeAdaptationLayerType x, PS_InStream st
             /* ------------------------------- */
         case 6:
             GetLengthDet(stream);
-            x->al1M = (PS_H223AL1MParameters) OSCL_DEFAULT_MALLOC(sizeof(S_H223AL1MParameters));
+            x->al1M = (PS_H223AL1MParameters) PerDecodeMalloc(stream, sizeof(S_H223AL1MParameters));
             Decode_H223AL1MParameters(x->al1M, stream);
             ReadRemainingBits(stream);
             break;
         case 7:
             GetLengthDet(stream);
-            x->al2M = (PS_H223AL2MParameters) OSCL_DEFAULT_MALLOC(sizeof(S_H223AL2MParameters));
+            x->al2M = (PS_H223AL2MParameters) PerDecodeMalloc(stream, sizeof(S_H223AL2MParameters));
             Decode_H223AL2MParameters(x->al2M, stream);
             ReadRemainingBits(stream);
             break;
         case 8:
             GetLengthDet(stream);
-            x->al3M = (PS_H223AL3MParameters) OSCL_DEFAULT_MALLOC(sizeof(S_H223AL3MParameters));
+            x->al3M = (PS_H223AL3MParameters) PerDecodeMalloc(stream, sizeof(S_H223AL3MParameters));
             Decode_H223AL3MParameters(x->al3M, stream);
             ReadRemainingBits(stream);
             break;
@@ -7697,11 +7697,11 @@ void Decode_SecondaryEncoding(PS_SecondaryEncoding x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
-            x->audioData = (PS_AudioMode) OSCL_DEFAULT_MALLOC(sizeof(S_AudioMode));
+            x->audioData = (PS_AudioMode) PerDecodeMalloc(stream, sizeof(S_AudioMode));
             Decode_AudioMode(x->audioData, stream);
             break;
             /* ------------------------------- */
@@ -7722,23 +7722,23 @@ void Decode_VideoMode(PS_VideoMode x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
-            x->h261VideoMode = (PS_H261VideoMode) OSCL_DEFAULT_MALLOC(sizeof(S_H261VideoMode));
+            x->h261VideoMode = (PS_H261VideoMode) PerDecodeMalloc(stream, sizeof(S_H261VideoMode));
             Decode_H261VideoMode(x->h261VideoMode, stream);
             break;
         case 2:
-            x->h262VideoMode = (PS_H262VideoMode) OSCL_DEFAULT_MALLOC(sizeof(S_H262VideoMode));
+            x->h262VideoMode = (PS_H262VideoMode) PerDecodeMalloc(stream, sizeof(S_H262VideoMode));
             Decode_H262VideoMode(x->h262VideoMode, stream);
             break;
         case 3:
-            x->h263VideoMode = (PS_H263VideoMode) OSCL_DEFAULT_MALLOC(sizeof(S_H263VideoMode));
+            x->h263VideoMode = (PS_H263VideoMode) PerDecodeMalloc(stream, sizeof(S_H263VideoMode));
             Decode_H263VideoMode(x->h263VideoMode, stream);
             break;
         case 4:
-            x->is11172VideoMode = (PS_IS11172VideoMode) OSCL_DEFAULT_MALLOC(sizeof(S_IS11172VideoMode));
+            x->is11172VideoMode = (PS_IS11172VideoMode) PerDecodeMalloc(stream, sizeof(S_IS11172VideoMode));
             Decode_IS11172VideoMode(x->is11172VideoMode, stream);
             break;
             /* ------------------------------- */
@@ -7746,7 +7746,7 @@ void Decode_VideoMode(PS_VideoMode x, PS_InStream stream)
             /* ------------------------------- */
         case 5:
             GetLengthDet(stream);
-            x->genericVideoMode = (PS_GenericCapability) OSCL_DEFAULT_MALLOC(sizeof(S_GenericCapability));
+            x->genericVideoMode = (PS_GenericCapability) PerDecodeMalloc(stream, sizeof(S_GenericCapability));
             Decode_GenericCapability(x->genericVideoMode, stream);
             ReadRemainingBits(stream);
             break;
@@ -8049,7 +8049,7 @@ void Decode_AudioMode(PS_AudioMode x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
@@ -8083,15 +8083,15 @@ void Decode_AudioMode(PS_AudioMode x, PS_InStream stream)
             /* (g729AnnexA is NULL) */
             break;
         case 11:
-            x->modeG7231 = (PS_ModeG7231) OSCL_DEFAULT_MALLOC(sizeof(S_ModeG7231));
+            x->modeG7231 = (PS_ModeG7231) PerDecodeMalloc(stream, sizeof(S_ModeG7231));
             Decode_ModeG7231(x->modeG7231, stream);
             break;
         case 12:
-            x->is11172AudioMode = (PS_IS11172AudioMode) OSCL_DEFAULT_MALLOC(sizeof(S_IS11172AudioMode));
+            x->is11172AudioMode = (PS_IS11172AudioMode) PerDecodeMalloc(stream, sizeof(S_IS11172AudioMode));
             Decode_IS11172AudioMode(x->is11172AudioMode, stream);
             break;
         case 13:
-            x->is13818AudioMode = (PS_IS13818AudioMode) OSCL_DEFAULT_MALLOC(sizeof(S_IS13818AudioMode));
+            x->is13818AudioMode = (PS_IS13818AudioMode) PerDecodeMalloc(stream, sizeof(S_IS13818AudioMode));
             Decode_IS13818AudioMode(x->is13818AudioMode, stream);
             break;
             /* ------------------------------- */
@@ -8109,37 +8109,37 @@ void Decode_AudioMode(PS_AudioMode x, PS_InStream stream)
             break;
         case 16:
             GetLengthDet(stream);
-            x->g7231AnnexCMode = (PS_G7231AnnexCMode) OSCL_DEFAULT_MALLOC(sizeof(S_G7231AnnexCMode));
+            x->g7231AnnexCMode = (PS_G7231AnnexCMode) PerDecodeMalloc(stream, sizeof(S_G7231AnnexCMode));
             Decode_G7231AnnexCMode(x->g7231AnnexCMode, stream);
             ReadRemainingBits(stream);
             break;
         case 17:
             GetLengthDet(stream);
-            x->gsmFullRate = (PS_GSMAudioCapability) OSCL_DEFAULT_MALLOC(sizeof(S_GSMAudioCapability));
+            x->gsmFullRate = (PS_GSMAudioCapability) PerDecodeMalloc(stream, sizeof(S_GSMAudioCapability));
             Decode_GSMAudioCapability(x->gsmFullRate, stream);
             ReadRemainingBits(stream);
             break;
         case 18:
             GetLengthDet(stream);
-            x->gsmHalfRate = (PS_GSMAudioCapability) OSCL_DEFAULT_MALLOC(sizeof(S_GSMAudioCapability));
+            x->gsmHalfRate = (PS_GSMAudioCapability) PerDecodeMalloc(stream, sizeof(S_GSMAudioCapability));
             Decode_GSMAudioCapability(x->gsmHalfRate, stream);
             ReadRemainingBits(stream);
             break;
         case 19:
             GetLengthDet(stream);
-            x->gsmEnhancedFullRate = (PS_GSMAudioCapability) OSCL_DEFAULT_MALLOC(sizeof(S_GSMAudioCapability));
+            x->gsmEnhancedFullRate = (PS_GSMAudioCapability) PerDecodeMalloc(stream, sizeof(S_GSMAudioCapability));
             Decode_GSMAudioCapability(x->gsmEnhancedFullRate, stream);
             ReadRemainingBits(stream);
             break;
         case 20:
             GetLengthDet(stream);
-            x->genericAudioMode = (PS_GenericCapability) OSCL_DEFAULT_MALLOC(sizeof(S_GenericCapability));
+            x->genericAudioMode = (PS_GenericCapability) PerDecodeMalloc(stream, sizeof(S_GenericCapability));
             Decode_GenericCapability(x->genericAudioMode, stream);
             ReadRemainingBits(stream);
             break;
         case 21:
             GetLengthDet(stream);
-            x->g729Extensions = (PS_G729Extensions) OSCL_DEFAULT_MALLOC(sizeof(S_G729Extensions));
+            x->g729Extensions = (PS_G729Extensions) PerDecodeMalloc(stream, sizeof(S_G729Extensions));
             Decode_G729Extensions(x->g729Extensions, stream);
             ReadRemainingBits(stream);
             break;
@@ -8476,42 +8476,42 @@ void Decode_DmApplication(PS_DmApplication x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
-            x->t120 = (PS_DataProtocolCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataProtocolCapability));
+            x->t120 = (PS_DataProtocolCapability) PerDecodeMalloc(stream, sizeof(S_DataProtocolCapability));
             Decode_DataProtocolCapability(x->t120, stream);
             break;
         case 2:
-            x->dsm_cc = (PS_DataProtocolCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataProtocolCapability));
+            x->dsm_cc = (PS_DataProtocolCapability) PerDecodeMalloc(stream, sizeof(S_DataProtocolCapability));
             Decode_DataProtocolCapability(x->dsm_cc, stream);
             break;
         case 3:
-            x->userData = (PS_DataProtocolCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataProtocolCapability));
+            x->userData = (PS_DataProtocolCapability) PerDecodeMalloc(stream, sizeof(S_DataProtocolCapability));
             Decode_DataProtocolCapability(x->userData, stream);
             break;
         case 4:
-            x->t84 = (PS_DataProtocolCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataProtocolCapability));
+            x->t84 = (PS_DataProtocolCapability) PerDecodeMalloc(stream, sizeof(S_DataProtocolCapability));
             Decode_DataProtocolCapability(x->t84, stream);
             break;
         case 5:
-            x->t434 = (PS_DataProtocolCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataProtocolCapability));
+            x->t434 = (PS_DataProtocolCapability) PerDecodeMalloc(stream, sizeof(S_DataProtocolCapability));
             Decode_DataProtocolCapability(x->t434, stream);
             break;
         case 6:
-            x->h224 = (PS_DataProtocolCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataProtocolCapability));
+            x->h224 = (PS_DataProtocolCapability) PerDecodeMalloc(stream, sizeof(S_DataProtocolCapability));
             Decode_DataProtocolCapability(x->h224, stream);
             break;
         case 7:
-            x->dmNlpid = (PS_DmNlpid) OSCL_DEFAULT_MALLOC(sizeof(S_DmNlpid));
+            x->dmNlpid = (PS_DmNlpid) PerDecodeMalloc(stream, sizeof(S_DmNlpid));
             Decode_DmNlpid(x->dmNlpid, stream);
             break;
         case 8:
             /* (dsvdControl is NULL) */
             break;
         case 9:
-            x->h222DataPartitioning = (PS_DataProtocolCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataProtocolCapability));
+            x->h222DataPartitioning = (PS_DataProtocolCapability) PerDecodeMalloc(stream, sizeof(S_DataProtocolCapability));
             Decode_DataProtocolCapability(x->h222DataPartitioning, stream);
             break;
             /* ------------------------------- */
@@ -8519,25 +8519,25 @@ void Decode_DmApplication(PS_DmApplication x, PS_InStream stream)
             /* ------------------------------- */
         case 10:
             GetLengthDet(stream);
-            x->t30fax = (PS_DataProtocolCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataProtocolCapability));
+            x->t30fax = (PS_DataProtocolCapability) PerDecodeMalloc(stream, sizeof(S_DataProtocolCapability));
             Decode_DataProtocolCapability(x->t30fax, stream);
             ReadRemainingBits(stream);
             break;
         case 11:
             GetLengthDet(stream);
-            x->t140 = (PS_DataProtocolCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataProtocolCapability));
+            x->t140 = (PS_DataProtocolCapability) PerDecodeMalloc(stream, sizeof(S_DataProtocolCapability));
             Decode_DataProtocolCapability(x->t140, stream);
             ReadRemainingBits(stream);
             break;
         case 12:
             GetLengthDet(stream);
-            x->dmT38fax = (PS_DmT38fax) OSCL_DEFAULT_MALLOC(sizeof(S_DmT38fax));
+            x->dmT38fax = (PS_DmT38fax) PerDecodeMalloc(stream, sizeof(S_DmT38fax));
             Decode_DmT38fax(x->dmT38fax, stream);
             ReadRemainingBits(stream);
             break;
         case 13:
             GetLengthDet(stream);
-            x->genericDataMode = (PS_GenericCapability) OSCL_DEFAULT_MALLOC(sizeof(S_GenericCapability));
+            x->genericDataMode = (PS_GenericCapability) PerDecodeMalloc(stream, sizeof(S_GenericCapability));
             Decode_GenericCapability(x->genericDataMode, stream);
             ReadRemainingBits(stream);
             break;
@@ -8574,7 +8574,7 @@ void Decode_EncryptionMode(PS_EncryptionMode x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
@@ -8839,7 +8839,7 @@ void Decode_CommunicationModeCommand(PS_CommunicationModeCommand x, PS_InStream
     extension = GetBoolean(stream);
     x->size_of_communicationModeTable = (uint16) GetInteger(1, 256, stream);
     x->communicationModeTable = (PS_CommunicationModeTableEntry)
-                                OSCL_DEFAULT_MALLOC(x->size_of_communicationModeTable * sizeof(S_CommunicationModeTableEntry));
+                                PerDecodeMalloc(stream, x->size_of_communicationModeTable * sizeof(S_CommunicationModeTableEntry));
     for (i = 0; i < x->size_of_communicationModeTable; ++i)
     {
         Decode_CommunicationModeTableEntry(x->communicationModeTable + i, stream);
@@ -8893,7 +8893,7 @@ void Decode_CommunicationModeResponse(PS_CommunicationModeResponse x, PS_InStrea
         case 0:
             x->size = (uint16) GetInteger(1, 256, stream);
             x->communicationModeTable = (PS_CommunicationModeTableEntry)
-                                        OSCL_DEFAULT_MALLOC(x->size * sizeof(S_CommunicationModeTableEntry));
+                                        PerDecodeMalloc(stream, x->size * sizeof(S_CommunicationModeTableEntry));
             for (i = 0; i < x->size; ++i)
             {
                 Decode_CommunicationModeTableEntry(x->communicationModeTable + i, stream);
@@ -8929,7 +8929,7 @@ void Decode_CommunicationModeTableEntry(PS_CommunicationModeTableEntry x, PS_InS
     {
         x->size_of_nonStandard = (uint16) GetLengthDet(stream);
         x->nonStandard = (PS_NonStandardParameter)
-                         OSCL_DEFAULT_MALLOC(x->size_of_nonStandard * sizeof(S_NonStandardParameter));
+                         PerDecodeMalloc(stream, x->size_of_nonStandard * sizeof(S_NonStandardParameter));
         for (i = 0; i < x->size_of_nonStandard; ++i)
         {
             Decode_NonStandardParameter(x->nonStandard + i, stream);
@@ -9008,15 +9008,15 @@ void Decode_CmtDataType(PS_CmtDataType x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->videoData = (PS_VideoCapability) OSCL_DEFAULT_MALLOC(sizeof(S_VideoCapability));
+            x->videoData = (PS_VideoCapability) PerDecodeMalloc(stream, sizeof(S_VideoCapability));
             Decode_VideoCapability(x->videoData, stream);
             break;
         case 1:
-            x->audioData = (PS_AudioCapability) OSCL_DEFAULT_MALLOC(sizeof(S_AudioCapability));
+            x->audioData = (PS_AudioCapability) PerDecodeMalloc(stream, sizeof(S_AudioCapability));
             Decode_AudioCapability(x->audioData, stream);
             break;
         case 2:
-            x->data = (PS_DataApplicationCapability) OSCL_DEFAULT_MALLOC(sizeof(S_DataApplicationCapability));
+            x->data = (PS_DataApplicationCapability) PerDecodeMalloc(stream, sizeof(S_DataApplicationCapability));
             Decode_DataApplicationCapability(x->data, stream);
             break;
             /* ------------------------------- */
@@ -9046,11 +9046,11 @@ void Decode_ConferenceRequest(PS_ConferenceRequest x, PS_InStream stream)
             /* (cancelMakeMeChair is NULL) */
             break;
         case 3:
-            x->dropTerminal = (PS_TerminalLabel) OSCL_DEFAULT_MALLOC(sizeof(S_TerminalLabel));
+            x->dropTerminal = (PS_TerminalLabel) PerDecodeMalloc(stream, sizeof(S_TerminalLabel));
             Decode_TerminalLabel(x->dropTerminal, stream);
             break;
         case 4:
-            x->requestTerminalID = (PS_TerminalLabel) OSCL_DEFAULT_MALLOC(sizeof(S_TerminalLabel));
+            x->requestTerminalID = (PS_TerminalLabel) PerDecodeMalloc(stream, sizeof(S_TerminalLabel));
             Decode_TerminalLabel(x->requestTerminalID, stream);
             break;
         case 5:
@@ -9077,7 +9077,7 @@ void Decode_ConferenceRequest(PS_ConferenceRequest x, PS_InStream stream)
             break;
         case 10:
             GetLengthDet(stream);
-            x->requestTerminalCertificate = (PS_RequestTerminalCertificate) OSCL_DEFAULT_MALLOC(sizeof(S_RequestTerminalCertificate));
+            x->requestTerminalCertificate = (PS_RequestTerminalCertificate) PerDecodeMalloc(stream, sizeof(S_RequestTerminalCertificate));
             Decode_RequestTerminalCertificate(x->requestTerminalCertificate, stream);
             ReadRemainingBits(stream);
             break;
@@ -9088,13 +9088,13 @@ void Decode_ConferenceRequest(PS_ConferenceRequest x, PS_InStream stream)
             break;
         case 12:
             GetLengthDet(stream);
-            x->makeTerminalBroadcaster = (PS_TerminalLabel) OSCL_DEFAULT_MALLOC(sizeof(S_TerminalLabel));
+            x->makeTerminalBroadcaster = (PS_TerminalLabel) PerDecodeMalloc(stream, sizeof(S_TerminalLabel));
             Decode_TerminalLabel(x->makeTerminalBroadcaster, stream);
             ReadRemainingBits(stream);
             break;
         case 13:
             GetLengthDet(stream);
-            x->sendThisSource = (PS_TerminalLabel) OSCL_DEFAULT_MALLOC(sizeof(S_TerminalLabel));
+            x->sendThisSource = (PS_TerminalLabel) PerDecodeMalloc(stream, sizeof(S_TerminalLabel));
             Decode_TerminalLabel(x->sendThisSource, stream);
             ReadRemainingBits(stream);
             break;
@@ -9105,7 +9105,7 @@ void Decode_ConferenceRequest(PS_ConferenceRequest x, PS_InStream stream)
             break;
         case 15:
             GetLengthDet(stream);
-            x->remoteMCRequest = (PS_RemoteMCRequest) OSCL_DEFAULT_MALLOC(sizeof(S_RemoteMCRequest));
+            x->remoteMCRequest = (PS_RemoteMCRequest) PerDecodeMalloc(stream, sizeof(S_RemoteMCRequest));
             Decode_RemoteMCRequest(x->remoteMCRequest, stream);
             ReadRemainingBits(stream);
             break;
@@ -9160,7 +9160,7 @@ void Decode_CertSelectionCriteria(PS_CertSelectionCriteria x, PS_InStream stream
     uint16 i;
     x->size = (uint8) GetInteger(1, 16, stream);
     x->item = (PS_Criteria)
-              OSCL_DEFAULT_MALLOC(x->size * sizeof(S_Criteria));
+              PerDecodeMalloc(stream, x->size * sizeof(S_Criteria));
     for (i = 0; i < x->size; ++i)
     {
         Decode_Criteria(x->item + i, stream);
@@ -9225,25 +9225,25 @@ void Decode_ConferenceResponse(PS_ConferenceResponse x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->mCTerminalIDResponse = (PS_MCTerminalIDResponse) OSCL_DEFAULT_MALLOC(sizeof(S_MCTerminalIDResponse));
+            x->mCTerminalIDResponse = (PS_MCTerminalIDResponse) PerDecodeMalloc(stream, sizeof(S_MCTerminalIDResponse));
             Decode_MCTerminalIDResponse(x->mCTerminalIDResponse, stream);
             break;
         case 1:
-            x->terminalIDResponse = (PS_TerminalIDResponse) OSCL_DEFAULT_MALLOC(sizeof(S_TerminalIDResponse));
+            x->terminalIDResponse = (PS_TerminalIDResponse) PerDecodeMalloc(stream, sizeof(S_TerminalIDResponse));
             Decode_TerminalIDResponse(x->terminalIDResponse, stream);
             break;
         case 2:
-            x->conferenceIDResponse = (PS_ConferenceIDResponse) OSCL_DEFAULT_MALLOC(sizeof(S_ConferenceIDResponse));
+            x->conferenceIDResponse = (PS_ConferenceIDResponse) PerDecodeMalloc(stream, sizeof(S_ConferenceIDResponse));
             Decode_ConferenceIDResponse(x->conferenceIDResponse, stream);
             break;
         case 3:
-            x->passwordResponse = (PS_PasswordResponse) OSCL_DEFAULT_MALLOC(sizeof(S_PasswordResponse));
+            x->passwordResponse = (PS_PasswordResponse) PerDecodeMalloc(stream, sizeof(S_PasswordResponse));
             Decode_PasswordResponse(x->passwordResponse, stream);
             break;
         case 4:
             x->size = (uint16) GetInteger(1, 256, stream);
             x->terminalListResponse = (PS_TerminalLabel)
-                                      OSCL_DEFAULT_MALLOC(x->size * sizeof(S_TerminalLabel));
+                                      PerDecodeMalloc(stream, x->size * sizeof(S_TerminalLabel));
             for (i = 0; i < x->size; ++i)
             {
                 Decode_TerminalLabel(x->terminalListResponse + i, stream);
@@ -9256,7 +9256,7 @@ void Decode_ConferenceResponse(PS_ConferenceResponse x, PS_InStream stream)
             /* (terminalDropReject is NULL) */
             break;
         case 7:
-            x->makeMeChairResponse = (PS_MakeMeChairResponse) OSCL_DEFAULT_MALLOC(sizeof(S_MakeMeChairResponse));
+            x->makeMeChairResponse = (PS_MakeMeChairResponse) PerDecodeMalloc(stream, sizeof(S_MakeMeChairResponse));
             Decode_MakeMeChairResponse(x->makeMeChairResponse, stream);
             break;
             /* ------------------------------- */
@@ -9264,49 +9264,49 @@ void Decode_ConferenceResponse(PS_ConferenceResponse x, PS_InStream stream)
             /* ------------------------------- */
         case 8:
             GetLengthDet(stream);
-            x->extensionAddressResponse = (PS_ExtensionAddressResponse) OSCL_DEFAULT_MALLOC(sizeof(S_ExtensionAddressResponse));
+            x->extensionAddressResponse = (PS_ExtensionAddressResponse) PerDecodeMalloc(stream, sizeof(S_ExtensionAddressResponse));
             Decode_ExtensionAddressResponse(x->extensionAddressResponse, stream);
             ReadRemainingBits(stream);
             break;
         case 9:
             GetLengthDet(stream);
-            x->chairTokenOwnerResponse = (PS_ChairTokenOwnerResponse) OSCL_DEFAULT_MALLOC(sizeof(S_ChairTokenOwnerResponse));
+            x->chairTokenOwnerResponse = (PS_ChairTokenOwnerResponse) PerDecodeMalloc(stream, sizeof(S_ChairTokenOwnerResponse));
             Decode_ChairTokenOwnerResponse(x->chairTokenOwnerResponse, stream);
             ReadRemainingBits(stream);
             break;
         case 10:
             GetLengthDet(stream);
-            x->terminalCertificateResponse = (PS_TerminalCertificateResponse) OSCL_DEFAULT_MALLOC(sizeof(S_TerminalCertificateResponse));
+            x->terminalCertificateResponse = (PS_TerminalCertificateResponse) PerDecodeMalloc(stream, sizeof(S_TerminalCertificateResponse));
             Decode_TerminalCertificateResponse(x->terminalCertificateResponse, stream);
             ReadRemainingBits(stream);
             break;
         case 11:
             GetLengthDet(stream);
-            x->broadcastMyLogicalChannelResponse = (PS_BroadcastMyLogicalChannelResponse) OSCL_DEFAULT_MALLOC(sizeof(S_BroadcastMyLogicalChannelResponse));
+            x->broadcastMyLogicalChannelResponse = (PS_BroadcastMyLogicalChannelResponse) PerDecodeMalloc(stream, sizeof(S_BroadcastMyLogicalChannelResponse));
             Decode_BroadcastMyLogicalChannelResponse(x->broadcastMyLogicalChannelResponse, stream);
             ReadRemainingBits(stream);
             break;
         case 12:
             GetLengthDet(stream);
-            x->makeTerminalBroadcasterResponse = (PS_MakeTerminalBroadcasterResponse) OSCL_DEFAULT_MALLOC(sizeof(S_MakeTerminalBroadcasterResponse));
+            x->makeTerminalBroadcasterResponse = (PS_MakeTerminalBroadcasterResponse) PerDecodeMalloc(stream, sizeof(S_MakeTerminalBroadcasterResponse));
             Decode_MakeTerminalBroadcasterResponse(x->makeTerminalBroadcasterResponse, stream);
             ReadRemainingBits(stream);
             break;
         case 13:
             GetLengthDet(stream);
-            x->sendThisSourceResponse = (PS_SendThisSourceResponse) OSCL_DEFAULT_MALLOC(sizeof(S_SendThisSourceResponse));
+            x->sendThisSourceResponse = (PS_SendThisSourceResponse) PerDecodeMalloc(stream, sizeof(S_SendThisSourceResponse));
             Decode_SendThisSourceResponse(x->sendThisSourceResponse, stream);
             ReadRemainingBits(stream);
             break;
         case 14:
             GetLengthDet(stream);
-            x->requestAllTerminalIDsResponse = (PS_RequestAllTerminalIDsResponse) OSCL_DEFAULT_MALLOC(sizeof(S_RequestAllTerminalIDsResponse));
+            x->requestAllTerminalIDsResponse = (PS_RequestAllTerminalIDsResponse) PerDecodeMalloc(stream, sizeof(S_RequestAllTerminalIDsResponse));
             Decode_RequestAllTerminalIDsResponse(x->requestAllTerminalIDsResponse, stream);
             ReadRemainingBits(stream);
             break;
         case 15:
             GetLengthDet(stream);
-            x->remoteMCResponse = (PS_RemoteMCResponse) OSCL_DEFAULT_MALLOC(sizeof(S_RemoteMCResponse));
+            x->remoteMCResponse = (PS_RemoteMCResponse) PerDecodeMalloc(stream, sizeof(S_RemoteMCResponse));
             Decode_RemoteMCResponse(x->remoteMCResponse, stream);
             ReadRemainingBits(stream);
             break;
@@ -9595,7 +9595,7 @@ void Decode_RequestAllTerminalIDsResponse(PS_RequestAllTerminalIDsResponse x, PS
     extension = GetBoolean(stream);
     x->size_of_terminalInformation = (uint16) GetLengthDet(stream);
     x->terminalInformation = (PS_TerminalInformation)
-                             OSCL_DEFAULT_MALLOC(x->size_of_terminalInformation * sizeof(S_TerminalInformation));
+                             PerDecodeMalloc(stream, x->size_of_terminalInformation * sizeof(S_TerminalInformation));
     for (i = 0; i < x->size_of_terminalInformation; ++i)
     {
         Decode_TerminalInformation(x->terminalInformation + i, stream);
@@ -9675,7 +9675,7 @@ void Decode_RemoteMCResponse(PS_RemoteMCResponse x, PS_InStream stream)
             /* (accept is NULL) */
             break;
         case 1:
-            x->reject = (PS_Reject) OSCL_DEFAULT_MALLOC(sizeof(S_Reject));
+            x->reject = (PS_Reject) PerDecodeMalloc(stream, sizeof(S_Reject));
             Decode_Reject(x->reject, stream);
             break;
             /* ------------------------------- */
@@ -9719,23 +9719,23 @@ void Decode_MultilinkRequest(PS_MultilinkRequest x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardMessage) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardMessage));
+            x->nonStandard = (PS_NonStandardMessage) PerDecodeMalloc(stream, sizeof(S_NonStandardMessage));
             Decode_NonStandardMessage(x->nonStandard, stream);
             break;
         case 1:
-            x->callInformation = (PS_CallInformation) OSCL_DEFAULT_MALLOC(sizeof(S_CallInformation));
+            x->callInformation = (PS_CallInformation) PerDecodeMalloc(stream, sizeof(S_CallInformation));
             Decode_CallInformation(x->callInformation, stream);
             break;
         case 2:
-            x->addConnection = (PS_AddConnection) OSCL_DEFAULT_MALLOC(sizeof(S_AddConnection));
+            x->addConnection = (PS_AddConnection) PerDecodeMalloc(stream, sizeof(S_AddConnection));
             Decode_AddConnection(x->addConnection, stream);
             break;
         case 3:
-            x->removeConnection = (PS_RemoveConnection) OSCL_DEFAULT_MALLOC(sizeof(S_RemoveConnection));
+            x->removeConnection = (PS_RemoveConnection) PerDecodeMalloc(stream, sizeof(S_RemoveConnection));
             Decode_RemoveConnection(x->removeConnection, stream);
             break;
         case 4:
-            x->maximumHeaderInterval = (PS_MaximumHeaderInterval) OSCL_DEFAULT_MALLOC(sizeof(S_MaximumHeaderInterval));
+            x->maximumHeaderInterval = (PS_MaximumHeaderInterval) PerDecodeMalloc(stream, sizeof(S_MaximumHeaderInterval));
             Decode_MaximumHeaderInterval(x->maximumHeaderInterval, stream);
             break;
             /* ------------------------------- */
@@ -9872,23 +9872,23 @@ void Decode_MultilinkResponse(PS_MultilinkResponse x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardMessage) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardMessage));
+            x->nonStandard = (PS_NonStandardMessage) PerDecodeMalloc(stream, sizeof(S_NonStandardMessage));
             Decode_NonStandardMessage(x->nonStandard, stream);
             break;
         case 1:
-            x->respCallInformation = (PS_RespCallInformation) OSCL_DEFAULT_MALLOC(sizeof(S_RespCallInformation));
+            x->respCallInformation = (PS_RespCallInformation) PerDecodeMalloc(stream, sizeof(S_RespCallInformation));
             Decode_RespCallInformation(x->respCallInformation, stream);
             break;
         case 2:
-            x->respAddConnection = (PS_RespAddConnection) OSCL_DEFAULT_MALLOC(sizeof(S_RespAddConnection));
+            x->respAddConnection = (PS_RespAddConnection) PerDecodeMalloc(stream, sizeof(S_RespAddConnection));
             Decode_RespAddConnection(x->respAddConnection, stream);
             break;
         case 3:
-            x->respRemoveConnection = (PS_RespRemoveConnection) OSCL_DEFAULT_MALLOC(sizeof(S_RespRemoveConnection));
+            x->respRemoveConnection = (PS_RespRemoveConnection) PerDecodeMalloc(stream, sizeof(S_RespRemoveConnection));
             Decode_RespRemoveConnection(x->respRemoveConnection, stream);
             break;
         case 4:
-            x->respMaximumHeaderInterval = (PS_RespMaximumHeaderInterval) OSCL_DEFAULT_MALLOC(sizeof(S_RespMaximumHeaderInterval));
+            x->respMaximumHeaderInterval = (PS_RespMaximumHeaderInterval) PerDecodeMalloc(stream, sizeof(S_RespMaximumHeaderInterval));
             Decode_RespMaximumHeaderInterval(x->respMaximumHeaderInterval, stream);
             break;
             /* ------------------------------- */
@@ -9982,7 +9982,7 @@ void Decode_ResponseCode(PS_ResponseCode x, PS_InStream stream)
             /* (accepted is NULL) */
             break;
         case 1:
-            x->rejected = (PS_Rejected) OSCL_DEFAULT_MALLOC(sizeof(S_Rejected));
+            x->rejected = (PS_Rejected) PerDecodeMalloc(stream, sizeof(S_Rejected));
             Decode_Rejected(x->rejected, stream);
             break;
             /* ------------------------------- */
@@ -10050,15 +10050,15 @@ void Decode_MultilinkIndication(PS_MultilinkIndication x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardMessage) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardMessage));
+            x->nonStandard = (PS_NonStandardMessage) PerDecodeMalloc(stream, sizeof(S_NonStandardMessage));
             Decode_NonStandardMessage(x->nonStandard, stream);
             break;
         case 1:
-            x->crcDesired = (PS_CrcDesired) OSCL_DEFAULT_MALLOC(sizeof(S_CrcDesired));
+            x->crcDesired = (PS_CrcDesired) PerDecodeMalloc(stream, sizeof(S_CrcDesired));
             Decode_CrcDesired(x->crcDesired, stream);
             break;
         case 2:
-            x->excessiveError = (PS_ExcessiveError) OSCL_DEFAULT_MALLOC(sizeof(S_ExcessiveError));
+            x->excessiveError = (PS_ExcessiveError) PerDecodeMalloc(stream, sizeof(S_ExcessiveError));
             Decode_ExcessiveError(x->excessiveError, stream);
             break;
             /* ------------------------------- */
@@ -10127,13 +10127,13 @@ void Decode_DialingInformation(PS_DialingInformation x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardMessage) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardMessage));
+            x->nonStandard = (PS_NonStandardMessage) PerDecodeMalloc(stream, sizeof(S_NonStandardMessage));
             Decode_NonStandardMessage(x->nonStandard, stream);
             break;
         case 1:
             x->size = (uint16) GetInteger(1, 65535, stream);
             x->differential = (PS_DialingInformationNumber)
-                              OSCL_DEFAULT_MALLOC(x->size * sizeof(S_DialingInformationNumber));
+                              PerDecodeMalloc(stream, x->size * sizeof(S_DialingInformationNumber));
             for (i = 0; i < x->size; ++i)
             {
                 Decode_DialingInformationNumber(x->differential + i, stream);
@@ -10169,7 +10169,7 @@ void Decode_DialingInformationNumber(PS_DialingInformationNumber x, PS_InStream
     }
     x->size_of_networkType = (uint8) GetInteger(1, 255, stream);
     x->networkType = (PS_DialingInformationNetworkType)
-                     OSCL_DEFAULT_MALLOC(x->size_of_networkType * sizeof(S_DialingInformationNetworkType));
+                     PerDecodeMalloc(stream, x->size_of_networkType * sizeof(S_DialingInformationNetworkType));
     for (i = 0; i < x->size_of_networkType; ++i)
     {
         Decode_DialingInformationNetworkType(x->networkType + i, stream);
@@ -10196,7 +10196,7 @@ void Decode_DialingInformationNetworkType(PS_DialingInformationNetworkType x, PS
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardMessage) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardMessage));
+            x->nonStandard = (PS_NonStandardMessage) PerDecodeMalloc(stream, sizeof(S_NonStandardMessage));
             Decode_NonStandardMessage(x->nonStandard, stream);
             break;
         case 1:
@@ -10374,7 +10374,7 @@ void Decode_SendTerminalCapabilitySet(PS_SendTerminalCapabilitySet x, PS_InStrea
     switch (x->index)
     {
         case 0:
-            x->specificRequest = (PS_SpecificRequest) OSCL_DEFAULT_MALLOC(sizeof(S_SpecificRequest));
+            x->specificRequest = (PS_SpecificRequest) PerDecodeMalloc(stream, sizeof(S_SpecificRequest));
             Decode_SpecificRequest(x->specificRequest, stream);
             break;
         case 1:
@@ -10405,7 +10405,7 @@ void Decode_SpecificRequest(PS_SpecificRequest x, PS_InStream stream)
     if (x->option_of_capabilityTableEntryNumbers)
     {
         x->size_of_capabilityTableEntryNumbers = (uint16) GetInteger(1, 65535, stream);
-        x->capabilityTableEntryNumbers = (uint32*) OSCL_DEFAULT_MALLOC(x->size_of_capabilityTableEntryNumbers * sizeof(uint32));
+        x->capabilityTableEntryNumbers = (uint32*) PerDecodeMalloc(stream, x->size_of_capabilityTableEntryNumbers * sizeof(uint32));
         for (i = 0; i < x->size_of_capabilityTableEntryNumbers; ++i)
         {
             x->capabilityTableEntryNumbers[i] = GetInteger(1, 65535, stream);
@@ -10414,7 +10414,7 @@ void Decode_SpecificRequest(PS_SpecificRequest x, PS_InStream stream)
     if (x->option_of_capabilityDescriptorNumbers)
     {
         x->size_of_capabilityDescriptorNumbers = (uint16) GetInteger(1, 256, stream);
-        x->capabilityDescriptorNumbers = (uint32*) OSCL_DEFAULT_MALLOC(x->size_of_capabilityDescriptorNumbers * sizeof(uint32));
+        x->capabilityDescriptorNumbers = (uint32*) PerDecodeMalloc(stream, x->size_of_capabilityDescriptorNumbers * sizeof(uint32));
         for (i = 0; i < x->size_of_capabilityDescriptorNumbers; ++i)
         {
             x->capabilityDescriptorNumbers[i] = GetInteger(0, 255, stream);
@@ -10442,14 +10442,14 @@ void Decode_EncryptionCommand(PS_EncryptionCommand x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->encryptionSE = (PS_OCTETSTRING) OSCL_DEFAULT_MALLOC(sizeof(S_OCTETSTRING));
+            x->encryptionSE = (PS_OCTETSTRING) PerDecodeMalloc(stream, sizeof(S_OCTETSTRING));
             GetOctetString(1, 0, 0, x->encryptionSE, stream);
             break;
         case 1:
             /* (encryptionIVRequest is NULL) */
             break;
         case 2:
-            x->encryptionAlgorithmID = (PS_EncryptionAlgorithmID) OSCL_DEFAULT_MALLOC(sizeof(S_EncryptionAlgorithmID));
+            x->encryptionAlgorithmID = (PS_EncryptionAlgorithmID) PerDecodeMalloc(stream, sizeof(S_EncryptionAlgorithmID));
             Decode_EncryptionAlgorithmID(x->encryptionAlgorithmID, stream);
             break;
             /* ------------------------------- */
@@ -10544,14 +10544,14 @@ void Decode_EndSessionCommand(PS_EndSessionCommand x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
             /* (disconnect is NULL) */
             break;
         case 2:
-            x->gstnOptions = (PS_GstnOptions) OSCL_DEFAULT_MALLOC(sizeof(S_GstnOptions));
+            x->gstnOptions = (PS_GstnOptions) PerDecodeMalloc(stream, sizeof(S_GstnOptions));
             Decode_GstnOptions(x->gstnOptions, stream);
             break;
             /* ------------------------------- */
@@ -10559,7 +10559,7 @@ void Decode_EndSessionCommand(PS_EndSessionCommand x, PS_InStream stream)
             /* ------------------------------- */
         case 3:
             GetLengthDet(stream);
-            x->isdnOptions = (PS_IsdnOptions) OSCL_DEFAULT_MALLOC(sizeof(S_IsdnOptions));
+            x->isdnOptions = (PS_IsdnOptions) PerDecodeMalloc(stream, sizeof(S_IsdnOptions));
             Decode_IsdnOptions(x->isdnOptions, stream);
             ReadRemainingBits(stream);
             break;
@@ -10642,14 +10642,14 @@ void Decode_ConferenceCommand(PS_ConferenceCommand x, PS_InStream stream)
             x->cancelBroadcastMyLogicalChannel = (uint16) GetInteger(1, 65535, stream);
             break;
         case 2:
-            x->makeTerminalBroadcaster = (PS_TerminalLabel) OSCL_DEFAULT_MALLOC(sizeof(S_TerminalLabel));
+            x->makeTerminalBroadcaster = (PS_TerminalLabel) PerDecodeMalloc(stream, sizeof(S_TerminalLabel));
             Decode_TerminalLabel(x->makeTerminalBroadcaster, stream);
             break;
         case 3:
             /* (cancelMakeTerminalBroadcaster is NULL) */
             break;
         case 4:
-            x->sendThisSource = (PS_TerminalLabel) OSCL_DEFAULT_MALLOC(sizeof(S_TerminalLabel));
+            x->sendThisSource = (PS_TerminalLabel) PerDecodeMalloc(stream, sizeof(S_TerminalLabel));
             Decode_TerminalLabel(x->sendThisSource, stream);
             break;
         case 5:
@@ -10663,7 +10663,7 @@ void Decode_ConferenceCommand(PS_ConferenceCommand x, PS_InStream stream)
             /* ------------------------------- */
         case 7:
             GetLengthDet(stream);
-            x->substituteConferenceIDCommand = (PS_SubstituteConferenceIDCommand) OSCL_DEFAULT_MALLOC(sizeof(S_SubstituteConferenceIDCommand));
+            x->substituteConferenceIDCommand = (PS_SubstituteConferenceIDCommand) PerDecodeMalloc(stream, sizeof(S_SubstituteConferenceIDCommand));
             Decode_SubstituteConferenceIDCommand(x->substituteConferenceIDCommand, stream);
             ReadRemainingBits(stream);
             break;
@@ -10747,7 +10747,7 @@ void Decode_McType(PS_McType x, PS_InStream stream)
             /* (videoFastUpdatePicture is NULL) */
             break;
         case 6:
-            x->videoFastUpdateGOB = (PS_VideoFastUpdateGOB) OSCL_DEFAULT_MALLOC(sizeof(S_VideoFastUpdateGOB));
+            x->videoFastUpdateGOB = (PS_VideoFastUpdateGOB) PerDecodeMalloc(stream, sizeof(S_VideoFastUpdateGOB));
             Decode_VideoFastUpdateGOB(x->videoFastUpdateGOB, stream);
             break;
         case 7:
@@ -10764,7 +10764,7 @@ void Decode_McType(PS_McType x, PS_InStream stream)
             /* ------------------------------- */
         case 10:
             GetLengthDet(stream);
-            x->videoFastUpdateMB = (PS_VideoFastUpdateMB) OSCL_DEFAULT_MALLOC(sizeof(S_VideoFastUpdateMB));
+            x->videoFastUpdateMB = (PS_VideoFastUpdateMB) PerDecodeMalloc(stream, sizeof(S_VideoFastUpdateMB));
             Decode_VideoFastUpdateMB(x->videoFastUpdateMB, stream);
             ReadRemainingBits(stream);
             break;
@@ -10775,13 +10775,13 @@ void Decode_McType(PS_McType x, PS_InStream stream)
             break;
         case 12:
             GetLengthDet(stream);
-            x->encryptionUpdate = (PS_EncryptionSync) OSCL_DEFAULT_MALLOC(sizeof(S_EncryptionSync));
+            x->encryptionUpdate = (PS_EncryptionSync) PerDecodeMalloc(stream, sizeof(S_EncryptionSync));
             Decode_EncryptionSync(x->encryptionUpdate, stream);
             ReadRemainingBits(stream);
             break;
         case 13:
             GetLengthDet(stream);
-            x->encryptionUpdateRequest = (PS_EncryptionUpdateRequest) OSCL_DEFAULT_MALLOC(sizeof(S_EncryptionUpdateRequest));
+            x->encryptionUpdateRequest = (PS_EncryptionUpdateRequest) PerDecodeMalloc(stream, sizeof(S_EncryptionUpdateRequest));
             Decode_EncryptionUpdateRequest(x->encryptionUpdateRequest, stream);
             ReadRemainingBits(stream);
             break;
@@ -10797,7 +10797,7 @@ void Decode_McType(PS_McType x, PS_InStream stream)
             break;
         case 16:
             GetLengthDet(stream);
-            x->progressiveRefinementStart = (PS_ProgressiveRefinementStart) OSCL_DEFAULT_MALLOC(sizeof(S_ProgressiveRefinementStart));
+            x->progressiveRefinementStart = (PS_ProgressiveRefinementStart) PerDecodeMalloc(stream, sizeof(S_ProgressiveRefinementStart));
             Decode_ProgressiveRefinementStart(x->progressiveRefinementStart, stream);
             ReadRemainingBits(stream);
             break;
@@ -10972,11 +10972,11 @@ void Decode_H223MultiplexReconfiguration(PS_H223MultiplexReconfiguration x, PS_I
     switch (x->index)
     {
         case 0:
-            x->h223ModeChange = (PS_H223ModeChange) OSCL_DEFAULT_MALLOC(sizeof(S_H223ModeChange));
+            x->h223ModeChange = (PS_H223ModeChange) PerDecodeMalloc(stream, sizeof(S_H223ModeChange));
             Decode_H223ModeChange(x->h223ModeChange, stream);
             break;
         case 1:
-            x->h223AnnexADoubleFlag = (PS_H223AnnexADoubleFlag) OSCL_DEFAULT_MALLOC(sizeof(S_H223AnnexADoubleFlag));
+            x->h223AnnexADoubleFlag = (PS_H223AnnexADoubleFlag) PerDecodeMalloc(stream, sizeof(S_H223AnnexADoubleFlag));
             Decode_H223AnnexADoubleFlag(x->h223AnnexADoubleFlag, stream);
             break;
             /* ------------------------------- */
@@ -11156,11 +11156,11 @@ void Decode_CmdAal(PS_CmdAal x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->cmdAal1 = (PS_CmdAal1) OSCL_DEFAULT_MALLOC(sizeof(S_CmdAal1));
+            x->cmdAal1 = (PS_CmdAal1) PerDecodeMalloc(stream, sizeof(S_CmdAal1));
             Decode_CmdAal1(x->cmdAal1, stream);
             break;
         case 1:
-            x->cmdAal5 = (PS_CmdAal5) OSCL_DEFAULT_MALLOC(sizeof(S_CmdAal5));
+            x->cmdAal5 = (PS_CmdAal5) PerDecodeMalloc(stream, sizeof(S_CmdAal5));
             Decode_CmdAal5(x->cmdAal5, stream);
             break;
             /* ------------------------------- */
@@ -11286,15 +11286,15 @@ void Decode_FunctionNotUnderstood(PS_FunctionNotUnderstood x, PS_InStream stream
     switch (x->index)
     {
         case 0:
-            x->request = (PS_RequestMessage) OSCL_DEFAULT_MALLOC(sizeof(S_RequestMessage));
+            x->request = (PS_RequestMessage) PerDecodeMalloc(stream, sizeof(S_RequestMessage));
             Decode_RequestMessage(x->request, stream);
             break;
         case 1:
-            x->response = (PS_ResponseMessage) OSCL_DEFAULT_MALLOC(sizeof(S_ResponseMessage));
+            x->response = (PS_ResponseMessage) PerDecodeMalloc(stream, sizeof(S_ResponseMessage));
             Decode_ResponseMessage(x->response, stream);
             break;
         case 2:
-            x->command = (PS_CommandMessage) OSCL_DEFAULT_MALLOC(sizeof(S_CommandMessage));
+            x->command = (PS_CommandMessage) PerDecodeMalloc(stream, sizeof(S_CommandMessage));
             Decode_CommandMessage(x->command, stream);
             break;
         default:
@@ -11368,15 +11368,15 @@ void Decode_ConferenceIndication(PS_ConferenceIndication x, PS_InStream stream)
             x->sbeNumber = (uint8) GetInteger(0, 9, stream);
             break;
         case 1:
-            x->terminalNumberAssign = (PS_TerminalLabel) OSCL_DEFAULT_MALLOC(sizeof(S_TerminalLabel));
+            x->terminalNumberAssign = (PS_TerminalLabel) PerDecodeMalloc(stream, sizeof(S_TerminalLabel));
             Decode_TerminalLabel(x->terminalNumberAssign, stream);
             break;
         case 2:
-            x->terminalJoinedConference = (PS_TerminalLabel) OSCL_DEFAULT_MALLOC(sizeof(S_TerminalLabel));
+            x->terminalJoinedConference = (PS_TerminalLabel) PerDecodeMalloc(stream, sizeof(S_TerminalLabel));
             Decode_TerminalLabel(x->terminalJoinedConference, stream);
             break;
         case 3:
-            x->terminalLeftConference = (PS_TerminalLabel) OSCL_DEFAULT_MALLOC(sizeof(S_TerminalLabel));
+            x->terminalLeftConference = (PS_TerminalLabel) PerDecodeMalloc(stream, sizeof(S_TerminalLabel));
             Decode_TerminalLabel(x->terminalLeftConference, stream);
             break;
         case 4:
@@ -11392,7 +11392,7 @@ void Decode_ConferenceIndication(PS_ConferenceIndication x, PS_InStream stream)
             /* (cancelSeenByAll is NULL) */
             break;
         case 8:
-            x->terminalYouAreSeeing = (PS_TerminalLabel) OSCL_DEFAULT_MALLOC(sizeof(S_TerminalLabel));
+            x->terminalYouAreSeeing = (PS_TerminalLabel) PerDecodeMalloc(stream, sizeof(S_TerminalLabel));
             Decode_TerminalLabel(x->terminalYouAreSeeing, stream);
             break;
         case 9:
@@ -11408,19 +11408,19 @@ void Decode_ConferenceIndication(PS_ConferenceIndication x, PS_InStream stream)
             break;
         case 11:
             GetLengthDet(stream);
-            x->floorRequested = (PS_TerminalLabel) OSCL_DEFAULT_MALLOC(sizeof(S_TerminalLabel));
+            x->floorRequested = (PS_TerminalLabel) PerDecodeMalloc(stream, sizeof(S_TerminalLabel));
             Decode_TerminalLabel(x->floorRequested, stream);
             ReadRemainingBits(stream);
             break;
         case 12:
             GetLengthDet(stream);
-            x->terminalYouAreSeeingInSubPictureNumber = (PS_TerminalYouAreSeeingInSubPictureNumber) OSCL_DEFAULT_MALLOC(sizeof(S_TerminalYouAreSeeingInSubPictureNumber));
+            x->terminalYouAreSeeingInSubPictureNumber = (PS_TerminalYouAreSeeingInSubPictureNumber) PerDecodeMalloc(stream, sizeof(S_TerminalYouAreSeeingInSubPictureNumber));
             Decode_TerminalYouAreSeeingInSubPictureNumber(x->terminalYouAreSeeingInSubPictureNumber, stream);
             ReadRemainingBits(stream);
             break;
         case 13:
             GetLengthDet(stream);
-            x->videoIndicateCompose = (PS_VideoIndicateCompose) OSCL_DEFAULT_MALLOC(sizeof(S_VideoIndicateCompose));
+            x->videoIndicateCompose = (PS_VideoIndicateCompose) PerDecodeMalloc(stream, sizeof(S_VideoIndicateCompose));
             Decode_VideoIndicateCompose(x->videoIndicateCompose, stream);
             ReadRemainingBits(stream);
             break;
@@ -11544,13 +11544,13 @@ void Decode_MiType(PS_MiType x, PS_InStream stream)
             /* ------------------------------- */
         case 10:
             GetLengthDet(stream);
-            x->videoNotDecodedMBs = (PS_VideoNotDecodedMBs) OSCL_DEFAULT_MALLOC(sizeof(S_VideoNotDecodedMBs));
+            x->videoNotDecodedMBs = (PS_VideoNotDecodedMBs) PerDecodeMalloc(stream, sizeof(S_VideoNotDecodedMBs));
             Decode_VideoNotDecodedMBs(x->videoNotDecodedMBs, stream);
             ReadRemainingBits(stream);
             break;
         case 11:
             GetLengthDet(stream);
-            x->transportCapability = (PS_TransportCapability) OSCL_DEFAULT_MALLOC(sizeof(S_TransportCapability));
+            x->transportCapability = (PS_TransportCapability) PerDecodeMalloc(stream, sizeof(S_TransportCapability));
             Decode_TransportCapability(x->transportCapability, stream);
             ReadRemainingBits(stream);
             break;
@@ -11871,11 +11871,11 @@ void Decode_IndAal(PS_IndAal x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->indAal1 = (PS_IndAal1) OSCL_DEFAULT_MALLOC(sizeof(S_IndAal1));
+            x->indAal1 = (PS_IndAal1) PerDecodeMalloc(stream, sizeof(S_IndAal1));
             Decode_IndAal1(x->indAal1, stream);
             break;
         case 1:
-            x->indAal5 = (PS_IndAal5) OSCL_DEFAULT_MALLOC(sizeof(S_IndAal5));
+            x->indAal5 = (PS_IndAal5) PerDecodeMalloc(stream, sizeof(S_IndAal5));
             Decode_IndAal5(x->indAal5, stream);
             break;
             /* ------------------------------- */
@@ -12001,11 +12001,11 @@ void Decode_UserInputIndication(PS_UserInputIndication x, PS_InStream stream)
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
-            x->alphanumeric = (PS_int8STRING) OSCL_DEFAULT_MALLOC(sizeof(S_int8STRING));
+            x->alphanumeric = (PS_int8STRING) PerDecodeMalloc(stream, sizeof(S_int8STRING));
             GetCharString("GeneralString", 1, 0, 0, NULL, x->alphanumeric, stream);
             break;
             /* ------------------------------- */
@@ -12013,19 +12013,19 @@ void Decode_UserInputIndication(PS_UserInputIndication x, PS_InStream stream)
             /* ------------------------------- */
         case 2:
             GetLengthDet(stream);
-            x->userInputSupportIndication = (PS_UserInputSupportIndication) OSCL_DEFAULT_MALLOC(sizeof(S_UserInputSupportIndication));
+            x->userInputSupportIndication = (PS_UserInputSupportIndication) PerDecodeMalloc(stream, sizeof(S_UserInputSupportIndication));
             Decode_UserInputSupportIndication(x->userInputSupportIndication, stream);
             ReadRemainingBits(stream);
             break;
         case 3:
             GetLengthDet(stream);
-            x->signal = (PS_Signal) OSCL_DEFAULT_MALLOC(sizeof(S_Signal));
+            x->signal = (PS_Signal) PerDecodeMalloc(stream, sizeof(S_Signal));
             Decode_Signal(x->signal, stream);
             ReadRemainingBits(stream);
             break;
         case 4:
             GetLengthDet(stream);
-            x->signalUpdate = (PS_SignalUpdate) OSCL_DEFAULT_MALLOC(sizeof(S_SignalUpdate));
+            x->signalUpdate = (PS_SignalUpdate) PerDecodeMalloc(stream, sizeof(S_SignalUpdate));
             Decode_SignalUpdate(x->signalUpdate, stream);
             ReadRemainingBits(stream);
             break;
@@ -12161,7 +12161,7 @@ void Decode_UserInputSupportIndication(PS_UserInputSupportIndication x, PS_InStr
     switch (x->index)
     {
         case 0:
-            x->nonStandard = (PS_NonStandardParameter) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardParameter));
+            x->nonStandard = (PS_NonStandardParameter) PerDecodeMalloc(stream, sizeof(S_NonStandardParameter));
             Decode_NonStandardParameter(x->nonStandard, stream);
             break;
         case 1:
@@ -42,6 +42,7 @@
 #include "h245_encoder.h"
 #include "h245_deleter.h"
 #include "h245_analysis.h"
+#include "per_arena.h"
 #include "oscl_mem.h"
 #include "pvlogger.h"
 #include "oscl_file_io.h"
@@ -135,17 +136,27 @@ OSCL_EXPORT_REF void PER::Reset()
     decodeSizeLeft = 0;
 }
 
+// Each decoded message lives in one block laid out as
+//   [OsclRefCounterDA][DecodedMsgDestructDealloc][PerArena][arena space]
+// so that passing it up costs a single allocation in the common case.
+// A TerminalCapabilitySet with a typical codec list needs under 2K;
+// larger messages continue in blocks chained by the arena.
+#define PER_DECODE_ARENA_SIZE 2048
+
+#define PER_DECODE_DESTRUCTOR_OFFSET oscl_mem_aligned_size(sizeof(OsclRefCounterDA))
+#define PER_DECODE_ARENA_OFFSET (PER_DECODE_DESTRUCTOR_OFFSET + oscl_mem_aligned_size(sizeof(DecodedMsgDestructDealloc)))
+#define PER_DECODE_SPACE_OFFSET (PER_DECODE_ARENA_OFFSET + oscl_mem_aligned_size(sizeof(PerArena)))
+
 class DecodedMsgDestructDealloc : public OsclDestructDealloc
 {
     public:
-        DecodedMsgDestructDealloc(uint8 amsgtype1, uint8 amsgtype2, uint8* apdata) :
-                msgtype1(amsgtype1), msgtype2(amsgtype2), pdata(apdata)
+        DecodedMsgDestructDealloc(PerArena* aarena) : arena(aarena)
         {}
 
         virtual void destruct_and_dealloc(OsclAny *ptr)
         {
-            // delete message
-            PER::DeleteMessage(msgtype1, msgtype2, pdata);
+            // release the message
+            arena->~PerArena();
             // destruct ref counter
             ((OsclRefCounterDA*)ptr)->~OsclRefCounterDA();
             // destruct this
@@ -155,9 +166,7 @@ class DecodedMsgDestructDealloc : public OsclDestructDealloc
         }
 
     private:
-        uint8 msgtype1;
-        uint8 msgtype2;
-        uint8 *pdata;
+        PerArena *arena;
 };
 
 // ========================================================
@@ -186,15 +195,26 @@ OSCL_EXPORT_REF void PER::Decode(uint8* pBuffer, uint32 size)
     {
         PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, MyLogger, PVLOGMSG_DEBUG, (0, "PER::Decode - decodeSizeLeft(%d)", decodeSizeLeft));
 
+        uint8 *space = (uint8*)OSCL_DEFAULT_MALLOC(PER_DECODE_SPACE_OFFSET + PER_DECODE_ARENA_SIZE);
+        if (space == NULL)
+        {
+            PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, MyLogger, PVLOGMSG_ERR, (0, "PER::Decode - unable to allocate message space"));
+            break;
+        }
+        PerArena *arena = new(space + PER_DECODE_ARENA_OFFSET) PerArena(space + PER_DECODE_SPACE_OFFSET, PER_DECODE_ARENA_SIZE);
+
         // ------------------------------------
         // Decode the current message to pData
         // ------------------------------------
-        if (!Decode(nBytes, pBuffer, GetSize, pData, MsgType1, MsgType2))
+        pData = NULL;
+        if (!Decode(nBytes, pBuffer, GetSize, pData, MsgType1, MsgType2, arena))
         {
-            return;
+            arena->~PerArena();
+            OSCL_DEFAULT_FREE(space);
+            break;
         }
 
-        PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, MyLogger, PVLOGMSG_DEBUG, (0, "PER::Decode - num bytes decoded(%d), bytes:", nBytes));
+        PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, MyLogger, PVLOGMSG_DEBUG, (0, "PER::Decode - num bytes decoded(%d), arena bytes(%d), bytes:", nBytes, arena->BytesUsed()));
         PVLOGGER_LOGBIN(PVLOGMSG_INST_LLDBG, MyLogger, PVLOGMSG_DEBUG, (0, 1, nBytes, pBuffer));
 
 #ifdef PVANALYZER
@@ -210,13 +230,17 @@ OSCL_EXPORT_REF void PER::Decode(uint8* pBuffer, uint32 size)
         if (GetSize)
         {
             // pass message up via smart pointer.  Some messages are held by user.
-            uint8 *space = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(OsclRefCounterDA) + sizeof(DecodedMsgDestructDealloc));
-            DecodedMsgDestructDealloc *destructor = new(space + sizeof(OsclRefCounterDA)) DecodedMsgDestructDealloc(MsgType1, MsgType2, pData);
-            OsclRefCounter *decodedMsgRefCnter    = new(space)                          OsclRefCounterDA(space, destructor);
+            DecodedMsgDestructDealloc *destructor = new(space + PER_DECODE_DESTRUCTOR_OFFSET) DecodedMsgDestructDealloc(arena);
+            OsclRefCounter *decodedMsgRefCnter    = new(space)                                OsclRefCounterDA(space, destructor);
             OsclSharedPtr<uint8> decodedMsgPtr(pData, decodedMsgRefCnter);
 
             MySe->MessageRecv(MsgType1, MsgType2, decodedMsgPtr, pBuffer, nBytes);
         }
+        else
+        {
+            arena->~PerArena();
+            OSCL_DEFAULT_FREE(space);
+        }
 
         // Skip to the next message in pBuffer
         decodeSizeLeft -= nBytes;
@@ -234,51 +258,17 @@ OSCL_EXPORT_REF void PER::Decode(uint8* pBuffer, uint32 size)
 
 
 bool PER::Decode(int& nBytes, uint8* pBuffer, uint16& GetSize, uint8*& pData,
-                 uint8& MsgType1, uint8& MsgType2)
+                 uint8& MsgType1, uint8& MsgType2, PerArena* pArena)
 {
     int32 leave_status = 0;
     OSCL_TRY(leave_status, nBytes = MultiSysCtrlMessage_decode(pBuffer, &GetSize,
-                                    &pData, &MsgType1, &MsgType2));
+                                    &pData, &MsgType1, &MsgType2, pArena));
     OSCL_FIRST_CATCH_ANY(leave_status,
                          PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, MyLogger, PVLOGMSG_ERR, (0, "PER::Decode - caught LEAVE during decode"));
                          return false;
                         );
     return true;
 }
-// ========================================================
-// DeleteMessage()
-// Deep delete the message structure
-// ========================================================
-void PER::DeleteMessage(uint8 MsgType1, uint8 MsgType2, uint8* pData)
-{
-    switch (MsgType1)
-    {
-        case 0:
-            S_RequestMessage request;
-            request.index = MsgType2;
-            request.nonStandard = (PS_NonStandardMessage)pData;
-            Delete_RequestMessage(&request);
-            break;
-        case 1:
-            S_ResponseMessage response;
-            response.index = MsgType2;
-            response.nonStandard = (PS_NonStandardMessage)pData;
-            Delete_ResponseMessage(&response);
-            break;
-        case 2:
-            S_CommandMessage command;
-            command.index = MsgType2;
-            command.nonStandard = (PS_NonStandardMessage)pData;
-            Delete_CommandMessage(&command);
-            break;
-        case 3:
-            S_IndicationMessage indication;
-            indication.index = MsgType2;
-            indication.nonStandard = (PS_NonStandardMessage)pData;
-            Delete_IndicationMessage(&indication);
-            break;
-    }
-}
 
 // ========================================================
 // MultiSysCtrlMessage_encode()
@@ -765,13 +755,15 @@ int PER::MultiSysCtrlMessage_decode(uint8*  pDataIn,
                                     uint16* pGetSize,
                                     uint8*  *ppDataOut,
                                     uint8*  pType1,
-                                    uint8*  pType2)
+                                    uint8*  pType2,
+                                    PerArena* pArena)
 {
-    PS_InStream stream;
+    S_InStream instream;
+    PS_InStream stream = &instream;
 
-    stream = (PS_InStream) OSCL_DEFAULT_MALLOC(sizeof(S_InStream));
     stream->bitIndex = 0;
     stream->data = pDataIn;
+    stream->arena = pArena;
     *pType1 = (uint8)GetChoiceIndex(4, 1, stream);
     switch (*pType1)
     {
@@ -796,7 +788,6 @@ int PER::MultiSysCtrlMessage_decode(uint8*  pDataIn,
     }
     ReadRemainingBits(stream);
     *pGetSize = (uint16)(stream->data - pDataIn);
-    OSCL_DEFAULT_FREE(stream);
     return *pGetSize;
 }
 
@@ -810,47 +801,47 @@ void PER::RequestMessage_decode(uint8* *ppDataOut, uint8* pType2, PS_InStream st
     switch (*pType2)
     {
         case 0:
-            *ppDataOut = (uint8*) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardMessage));
+            *ppDataOut = (uint8*) PerDecodeMalloc(stream, sizeof(S_NonStandardMessage));
             Decode_NonStandardMessage((PS_NonStandardMessage) *ppDataOut, stream);
             break;
         case 1:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MasterSlaveDetermination));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_MasterSlaveDetermination));
             Decode_MasterSlaveDetermination((PS_MasterSlaveDetermination) *ppDataOut, stream);
             break;
         case 2:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_TerminalCapabilitySet));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_TerminalCapabilitySet));
             Decode_TerminalCapabilitySet((PS_TerminalCapabilitySet) *ppDataOut, stream);
             break;
         case 3:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_OpenLogicalChannel));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_OpenLogicalChannel));
             Decode_OpenLogicalChannel((PS_OpenLogicalChannel) *ppDataOut, stream);
             break;
         case 4:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_CloseLogicalChannel));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_CloseLogicalChannel));
             Decode_CloseLogicalChannel((PS_CloseLogicalChannel) *ppDataOut, stream);
             break;
         case 5:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestChannelClose));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_RequestChannelClose));
             Decode_RequestChannelClose((PS_RequestChannelClose) *ppDataOut, stream);
             break;
         case 6:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MultiplexEntrySend));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_MultiplexEntrySend));
             Decode_MultiplexEntrySend((PS_MultiplexEntrySend) *ppDataOut, stream);
             break;
         case 7:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestMultiplexEntry));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_RequestMultiplexEntry));
             Decode_RequestMultiplexEntry((PS_RequestMultiplexEntry) *ppDataOut, stream);
             break;
         case 8:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestMode));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_RequestMode));
             Decode_RequestMode((PS_RequestMode) *ppDataOut, stream);
             break;
         case 9:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RoundTripDelayRequest));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_RoundTripDelayRequest));
             Decode_RoundTripDelayRequest((PS_RoundTripDelayRequest) *ppDataOut, stream);
             break;
         case 10:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MaintenanceLoopRequest));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_MaintenanceLoopRequest));
             Decode_MaintenanceLoopRequest((PS_MaintenanceLoopRequest) *ppDataOut, stream);
             break;
             /* ------------------------------- */
@@ -858,25 +849,25 @@ void PER::RequestMessage_decode(uint8* *ppDataOut, uint8* pType2, PS_InStream st
             /* ------------------------------- */
         case 11:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_CommunicationModeRequest));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_CommunicationModeRequest));
             Decode_CommunicationModeRequest((PS_CommunicationModeRequest) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 12:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_ConferenceRequest));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_ConferenceRequest));
             Decode_ConferenceRequest((PS_ConferenceRequest) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 13:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MultilinkRequest));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_MultilinkRequest));
             Decode_MultilinkRequest((PS_MultilinkRequest) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 14:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_LogicalChannelRateRequest));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_LogicalChannelRateRequest));
             Decode_LogicalChannelRateRequest((PS_LogicalChannelRateRequest) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
@@ -896,79 +887,79 @@ void PER::ResponseMessage_decode(uint8* *ppDataOut, uint8* pType2, PS_InStream s
     switch (*pType2)
     {
         case 0:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardMessage));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_NonStandardMessage));
             Decode_NonStandardMessage((PS_NonStandardMessage) *ppDataOut, stream);
             break;
         case 1:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MasterSlaveDeterminationAck));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_MasterSlaveDeterminationAck));
             Decode_MasterSlaveDeterminationAck((PS_MasterSlaveDeterminationAck) *ppDataOut, stream);
             break;
         case 2:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MasterSlaveDeterminationReject));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_MasterSlaveDeterminationReject));
             Decode_MasterSlaveDeterminationReject((PS_MasterSlaveDeterminationReject) *ppDataOut, stream);
             break;
         case 3:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_TerminalCapabilitySetAck));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_TerminalCapabilitySetAck));
             Decode_TerminalCapabilitySetAck((PS_TerminalCapabilitySetAck) *ppDataOut, stream);
             break;
         case 4:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_TerminalCapabilitySetReject));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_TerminalCapabilitySetReject));
             Decode_TerminalCapabilitySetReject((PS_TerminalCapabilitySetReject) *ppDataOut, stream);
             break;
         case 5:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_OpenLogicalChannelAck));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_OpenLogicalChannelAck));
             Decode_OpenLogicalChannelAck((PS_OpenLogicalChannelAck) *ppDataOut, stream);
             break;
         case 6:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_OpenLogicalChannelReject));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_OpenLogicalChannelReject));
             Decode_OpenLogicalChannelReject((PS_OpenLogicalChannelReject) *ppDataOut, stream);
             break;
         case 7:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_CloseLogicalChannelAck));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_CloseLogicalChannelAck));
             Decode_CloseLogicalChannelAck((PS_CloseLogicalChannelAck) *ppDataOut, stream);
             break;
         case 8:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestChannelCloseAck));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_RequestChannelCloseAck));
             Decode_RequestChannelCloseAck((PS_RequestChannelCloseAck) *ppDataOut, stream);
             break;
         case 9:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestChannelCloseReject));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_RequestChannelCloseReject));
             Decode_RequestChannelCloseReject((PS_RequestChannelCloseReject) *ppDataOut, stream);
             break;
         case 10:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MultiplexEntrySendAck));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_MultiplexEntrySendAck));
             Decode_MultiplexEntrySendAck((PS_MultiplexEntrySendAck) *ppDataOut, stream);
             break;
         case 11:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MultiplexEntrySendReject));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_MultiplexEntrySendReject));
             Decode_MultiplexEntrySendReject((PS_MultiplexEntrySendReject) *ppDataOut, stream);
             break;
         case 12:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestMultiplexEntryAck));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_RequestMultiplexEntryAck));
             Decode_RequestMultiplexEntryAck((PS_RequestMultiplexEntryAck) *ppDataOut, stream);
             break;
         case 13:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestMultiplexEntryReject));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_RequestMultiplexEntryReject));
             Decode_RequestMultiplexEntryReject((PS_RequestMultiplexEntryReject) *ppDataOut, stream);
             break;
         case 14:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestModeAck));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_RequestModeAck));
             Decode_RequestModeAck((PS_RequestModeAck) *ppDataOut, stream);
             break;
         case 15:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestModeReject));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_RequestModeReject));
             Decode_RequestModeReject((PS_RequestModeReject) *ppDataOut, stream);
             break;
         case 16:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RoundTripDelayResponse));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_RoundTripDelayResponse));
             Decode_RoundTripDelayResponse((PS_RoundTripDelayResponse) *ppDataOut, stream);
             break;
         case 17:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MaintenanceLoopAck));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_MaintenanceLoopAck));
             Decode_MaintenanceLoopAck((PS_MaintenanceLoopAck) *ppDataOut, stream);
             break;
         case 18:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MaintenanceLoopReject));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_MaintenanceLoopReject));
             Decode_MaintenanceLoopReject((PS_MaintenanceLoopReject) *ppDataOut, stream);
             break;
             /* ------------------------------- */
@@ -976,31 +967,31 @@ void PER::ResponseMessage_decode(uint8* *ppDataOut, uint8* pType2, PS_InStream s
             /* ------------------------------- */
         case 19:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_CommunicationModeResponse));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_CommunicationModeResponse));
             Decode_CommunicationModeResponse((PS_CommunicationModeResponse) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 20:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_ConferenceResponse));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_ConferenceResponse));
             Decode_ConferenceResponse((PS_ConferenceResponse) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 21:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MultilinkResponse));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_MultilinkResponse));
             Decode_MultilinkResponse((PS_MultilinkResponse) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 22:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_LogicalChannelRateAcknowledge));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_LogicalChannelRateAcknowledge));
             Decode_LogicalChannelRateAcknowledge((PS_LogicalChannelRateAcknowledge) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 23:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_LogicalChannelRateReject));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_LogicalChannelRateReject));
             Decode_LogicalChannelRateReject((PS_LogicalChannelRateReject) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
@@ -1020,31 +1011,31 @@ void PER::CommandMessage_decode(uint8* *ppDataOut, uint8* pType2, PS_InStream st
     switch (*pType2)
     {
         case 0:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardMessage));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_NonStandardMessage));
             Decode_NonStandardMessage((PS_NonStandardMessage) *ppDataOut, stream);
             break;
         case 1:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MaintenanceLoopOffCommand));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_MaintenanceLoopOffCommand));
             Decode_MaintenanceLoopOffCommand((PS_MaintenanceLoopOffCommand) *ppDataOut, stream);
             break;
         case 2:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_SendTerminalCapabilitySet));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_SendTerminalCapabilitySet));
             Decode_SendTerminalCapabilitySet((PS_SendTerminalCapabilitySet) *ppDataOut, stream);
             break;
         case 3:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_EncryptionCommand));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_EncryptionCommand));
             Decode_EncryptionCommand((PS_EncryptionCommand) *ppDataOut, stream);
             break;
         case 4:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_FlowControlCommand));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_FlowControlCommand));
             Decode_FlowControlCommand((PS_FlowControlCommand) *ppDataOut, stream);
             break;
         case 5:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_EndSessionCommand));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_EndSessionCommand));
             Decode_EndSessionCommand((PS_EndSessionCommand) *ppDataOut, stream);
             break;
         case 6:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MiscellaneousCommand));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_MiscellaneousCommand));
             Decode_MiscellaneousCommand((PS_MiscellaneousCommand) *ppDataOut, stream);
             break;
             /* ------------------------------- */
@@ -1052,25 +1043,25 @@ void PER::CommandMessage_decode(uint8* *ppDataOut, uint8* pType2, PS_InStream st
             /* ------------------------------- */
         case 7:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_CommunicationModeCommand));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_CommunicationModeCommand));
             Decode_CommunicationModeCommand((PS_CommunicationModeCommand) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 8:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_ConferenceCommand));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_ConferenceCommand));
             Decode_ConferenceCommand((PS_ConferenceCommand) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 9:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_H223MultiplexReconfiguration));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_H223MultiplexReconfiguration));
             Decode_H223MultiplexReconfiguration((PS_H223MultiplexReconfiguration) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 10:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_NewATMVCCommand));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_NewATMVCCommand));
             Decode_NewATMVCCommand((PS_NewATMVCCommand) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
@@ -1090,59 +1081,59 @@ void PER::IndicationMessage_decode(uint8* *ppDataOut, uint8* pType2, PS_InStream
     switch (*pType2)
     {
         case 0:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardMessage));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_NonStandardMessage));
             Decode_NonStandardMessage((PS_NonStandardMessage) *ppDataOut, stream);
             break;
         case 1:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_FunctionNotUnderstood));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_FunctionNotUnderstood));
             Decode_FunctionNotUnderstood((PS_FunctionNotUnderstood) *ppDataOut, stream);
             break;
         case 2:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MasterSlaveDeterminationRelease));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_MasterSlaveDeterminationRelease));
             Decode_MasterSlaveDeterminationRelease((PS_MasterSlaveDeterminationRelease) *ppDataOut, stream);
             break;
         case 3:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_TerminalCapabilitySetRelease));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_TerminalCapabilitySetRelease));
             Decode_TerminalCapabilitySetRelease((PS_TerminalCapabilitySetRelease) *ppDataOut, stream);
             break;
         case 4:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_OpenLogicalChannelConfirm));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_OpenLogicalChannelConfirm));
             Decode_OpenLogicalChannelConfirm((PS_OpenLogicalChannelConfirm) *ppDataOut, stream);
             break;
         case 5:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestChannelCloseRelease));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_RequestChannelCloseRelease));
             Decode_RequestChannelCloseRelease((PS_RequestChannelCloseRelease) *ppDataOut, stream);
             break;
         case 6:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MultiplexEntrySendRelease));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_MultiplexEntrySendRelease));
             Decode_MultiplexEntrySendRelease((PS_MultiplexEntrySendRelease) *ppDataOut, stream);
             break;
         case 7:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestMultiplexEntryRelease));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_RequestMultiplexEntryRelease));
             Decode_RequestMultiplexEntryRelease((PS_RequestMultiplexEntryRelease) *ppDataOut, stream);
             break;
         case 8:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestModeRelease));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_RequestModeRelease));
             Decode_RequestModeRelease((PS_RequestModeRelease) *ppDataOut, stream);
             break;
         case 9:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MiscellaneousIndication));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_MiscellaneousIndication));
             Decode_MiscellaneousIndication((PS_MiscellaneousIndication) *ppDataOut, stream);
             break;
         case 10:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_JitterIndication));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_JitterIndication));
             Decode_JitterIndication((PS_JitterIndication) *ppDataOut, stream);
             break;
         case 11:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_H223SkewIndication));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_H223SkewIndication));
             Decode_H223SkewIndication((PS_H223SkewIndication) *ppDataOut, stream);
             break;
         case 12:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_NewATMVCIndication));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_NewATMVCIndication));
             Decode_NewATMVCIndication((PS_NewATMVCIndication) *ppDataOut, stream);
             break;
         case 13:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_UserInputIndication));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_UserInputIndication));
             Decode_UserInputIndication((PS_UserInputIndication) *ppDataOut, stream);
             break;
             /* ------------------------------- */
@@ -1150,49 +1141,49 @@ void PER::IndicationMessage_decode(uint8* *ppDataOut, uint8* pType2, PS_InStream
             /* ------------------------------- */
         case 14:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_H2250MaximumSkewIndication));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_H2250MaximumSkewIndication));
             Decode_H2250MaximumSkewIndication((PS_H2250MaximumSkewIndication) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 15:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MCLocationIndication));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_MCLocationIndication));
             Decode_MCLocationIndication((PS_MCLocationIndication) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 16:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_ConferenceIndication));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_ConferenceIndication));
             Decode_ConferenceIndication((PS_ConferenceIndication) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 17:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_VendorIdentification));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_VendorIdentification));
             Decode_VendorIdentification((PS_VendorIdentification) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 18:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_FunctionNotSupported));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_FunctionNotSupported));
             Decode_FunctionNotSupported((PS_FunctionNotSupported) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 19:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MultilinkIndication));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_MultilinkIndication));
             Decode_MultilinkIndication((PS_MultilinkIndication) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 20:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_LogicalChannelRateRelease));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_LogicalChannelRateRelease));
             Decode_LogicalChannelRateRelease((PS_LogicalChannelRateRelease) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 21:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_FlowControlIndication));
+            *ppDataOut = (uint8*)PerDecodeMalloc(stream, sizeof(S_FlowControlIndication));
             Decode_FlowControlIndication((PS_FlowControlIndication) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
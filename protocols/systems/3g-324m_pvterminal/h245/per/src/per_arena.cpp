@@ -0,0 +1,101 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#include "per_arena.h"
+
+#ifndef OSCL_MEM_H_INCLUDED
+#include "oscl_mem.h"
+#endif
+
+#ifndef OSCL_ERROR_CODES_H_INCLUDED
+#include "oscl_error_codes.h"
+#endif
+
+#ifndef OSCL_EXCEPTION_H_INCLUDED
+#include "oscl_exception.h"
+#endif
+
+PerArena::PerArena(OsclAny* aBuffer, uint32 aSize) :
+        iBuffer(NULL),
+        iBufferEnd(NULL),
+        iBlockStart(NULL),
+        iCur(NULL),
+        iEnd(NULL),
+        iBlocks(NULL),
+        iNextBlockSize(PER_ARENA_BLOCK_SIZE),
+        iUsedInBlocks(0)
+{
+    if (aBuffer)
+    {
+        iBuffer = (uint8*)aBuffer;
+        iBufferEnd = iBuffer + aSize;
+    }
+    Reset();
+}
+
+PerArena::~PerArena()
+{
+    FreeBlocks();
+}
+
+void PerArena::Reset()
+{
+    FreeBlocks();
+    iBlockStart = iCur = iBuffer;
+    iEnd = iBufferEnd;
+    iNextBlockSize = PER_ARENA_BLOCK_SIZE;
+    iUsedInBlocks = 0;
+}
+
+void PerArena::FreeBlocks()
+{
+    while (iBlocks)
+    {
+        Block* next = iBlocks->iNext;
+        OSCL_DEFAULT_FREE(iBlocks);
+        iBlocks = next;
+    }
+}
+
+OsclAny* PerArena::AllocBlock(uint32 aSize)
+{
+    uint32 header = PER_ARENA_ROUND(sizeof(Block));
+    uint32 size = iNextBlockSize;
+    if (size < aSize + header)
+    {
+        // oversized request, give it a block of its own
+        size = aSize + header;
+    }
+    else if (iNextBlockSize < PER_ARENA_MAX_BLOCK_SIZE)
+    {
+        iNextBlockSize <<= 1;
+    }
+
+    Block* block = (Block*)OSCL_DEFAULT_MALLOC(size);
+    if (block == NULL)
+    {
+        OSCL_LEAVE(OsclErrNoMemory);
+    }
+    block->iNext = iBlocks;
+    iBlocks = block;
+
+    iUsedInBlocks += (uint32)(iCur - iBlockStart);
+    iBlockStart = (uint8*)block + header;
+    iCur = iBlockStart + aSize;
+    iEnd = (uint8*)block + size;
+    return iBlockStart;
+}
@@ -0,0 +1,30 @@
+LOCAL_PATH := $(call my-dir)
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES := \
+ 	src/h245_per_benchmark.cpp
+
+
+LOCAL_MODULE := pv_h245_per_benchmark
+
+LOCAL_CFLAGS :=  $(PV_CFLAGS)
+
+
+
+LOCAL_STATIC_LIBRARIES :=  
+
+LOCAL_SHARED_LIBRARIES := libopencore_2way libopencore_common
+
+LOCAL_C_INCLUDES := \
+	$(PV_TOP)/protocols/systems/3g-324m_pvterminal/h245/per/test/src \
+ 	$(PV_TOP)/protocols/systems/3g-324m_pvterminal/h245/per/test/src \
+ 	$(PV_INCLUDES)
+
+LOCAL_COPY_HEADERS_TO := $(PV_COPY_HEADERS_TO)
+
+LOCAL_COPY_HEADERS := \
+ 	
+
+-include $(PV_TOP)/Android_system_extras.mk
+
+include $(BUILD_EXECUTABLE)
@@ -0,0 +1,21 @@
+# Get the current local path as the first operation
+LOCAL_PATH := $(call get_makefile_dir)
+
+# Clear out the variables used in the local makefiles
+include $(MK)/clear.mk
+
+TARGET := pv_h245_per_benchmark
+
+
+XCXXFLAGS += $(FLAG_COMPILE_WARNINGS_AS_ERRORS)
+
+SRCDIR := ../../src
+INCSRCDIR := ../../src
+
+SRCS := h245_per_benchmark.cpp
+
+LIBS := opencore_2way opencore_common
+
+SYSLIBS += $(SYS_THREAD_LIB)
+
+include $(MK)/prog.mk
@@ -0,0 +1,167 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+// Decodes, copies and encodes a TerminalCapabilitySet in a loop and
+// reports the message rate.  Decoding is timed both on the heap and into
+// a PerArena the way PER::Decode does it, one block per message.  The
+// decoded message must re-encode to the original or the run fails.
+
+#include "stdio.h"
+#include "oscl_base.h"
+#include "oscl_mem.h"
+#include "oscl_error.h"
+#include "oscl_tickcount.h"
+#include "per_arena.h"
+#include "h245def.h"
+#include "h245_decoder.h"
+#include "h245_encoder.h"
+#include "h245_deleter.h"
+#include "h245_copier.h"
+
+#define BENCH_LOOPS         20000
+#define BENCH_ARENA_SIZE    2048
+
+// TerminalCapabilitySet sent by this terminal for AMR, G.723, H.263
+// and MPEG-4 in both directions plus DTMF and basic string input.
+static const uint8 BenchTcs[] =
+{
+    0x70, 0x00, 0x06, 0x00, 0x08, 0x81, 0x75, 0x00, 0x06, 0x57, 0x40, 0x01,
+    0x00, 0x01, 0x00, 0x00, 0x0a, 0x03, 0xe0, 0x01, 0x80, 0x01, 0x80, 0x01,
+    0x08, 0x09, 0x80, 0x00, 0x00, 0x24, 0x30, 0x11, 0x60, 0x00, 0x07, 0x00,
+    0x08, 0x81, 0x75, 0x01, 0x01, 0x01, 0x00, 0x7a, 0x01, 0x00, 0x02, 0x00,
+    0x01, 0x80, 0x00, 0x01, 0x22, 0x00, 0x00, 0x40, 0x00, 0x02, 0x09, 0xf0,
+    0x04, 0x28, 0x02, 0x08, 0x08, 0x70, 0x40, 0x01, 0x00, 0x80, 0x00, 0x03,
+    0x0c, 0x00, 0x12, 0x50, 0x00, 0x07, 0x00, 0x08, 0x81, 0x75, 0x01, 0x00,
+    0x00, 0x40, 0x02, 0x09, 0x01, 0x00, 0x03, 0x00, 0x08, 0x80, 0x00, 0x04,
+    0x83, 0x01, 0x40, 0x80, 0x00, 0x05, 0x83, 0x01, 0x10, 0x80, 0x00, 0x06,
+    0x2c, 0x30, 0x11, 0x60, 0x00, 0x07, 0x00, 0x08, 0x81, 0x75, 0x01, 0x01,
+    0x01, 0x00, 0x7a, 0x01, 0x00, 0x02, 0x00, 0x01, 0x80, 0x00, 0x07, 0x2a,
+    0x00, 0x00, 0x40, 0x00, 0x08, 0x11, 0xf0, 0x04, 0x28, 0x02, 0x08, 0x08,
+    0x70, 0x40, 0x01, 0x00, 0x80, 0x00, 0x09, 0x14, 0x00, 0x12, 0x50, 0x00,
+    0x07, 0x00, 0x08, 0x81, 0x75, 0x01, 0x00, 0x00, 0x40, 0x02, 0x09, 0x01,
+    0x00, 0x03, 0x00, 0x08, 0x00, 0x80, 0x00, 0x02, 0x01, 0x00, 0x00, 0x00,
+    0x01, 0x01, 0x00, 0x02, 0x00, 0x03, 0x01, 0x00, 0x04, 0x00, 0x05
+};
+
+static void StartInStream(S_InStream& aStream, PerArena* aArena)
+{
+    aStream.data = (uint8*)BenchTcs;
+    aStream.bitIndex = 0;
+    aStream.arena = aArena;
+}
+
+static PS_TerminalCapabilitySet DecodeTcs(PerArena* aArena)
+{
+    S_InStream stream;
+    StartInStream(stream, aArena);
+    PS_TerminalCapabilitySet tcs = (PS_TerminalCapabilitySet)PerDecodeMalloc(&stream, sizeof(S_TerminalCapabilitySet));
+    Decode_TerminalCapabilitySet(tcs, &stream);
+    return tcs;
+}
+
+static void FreeTcs(PS_TerminalCapabilitySet aTcs)
+{
+    Delete_TerminalCapabilitySet(aTcs);
+    OSCL_DEFAULT_FREE(aTcs);
+}
+
+static void PrintRate(const char* aName, uint32 aStartTicks)
+{
+    uint32 msec = OsclTickCount::TicksToMsec(OsclTickCount::TickCount() - aStartTicks);
+    if (msec == 0)
+    {
+        msec = 1;
+    }
+    printf("%-24s %d messages in %d ms, %d msgs/s\n", aName, BENCH_LOOPS, msec,
+           (uint32)((BENCH_LOOPS * 1000.0) / msec));
+}
+
+static int RunBenchmark()
+{
+    PS_TerminalCapabilitySet tcs = DecodeTcs(NULL);
+    PS_OutStream out = NewOutStream();
+    Encode_TerminalCapabilitySet(tcs, out);
+    WriteRemainingBits(out);
+    bool same = (out->byteIndex == sizeof(BenchTcs) &&
+                 oscl_memcmp(out->data, BenchTcs, sizeof(BenchTcs)) == 0);
+    FreeOutStream(out);
+    if (!same)
+    {
+        printf("decoded TerminalCapabilitySet does not re-encode to the original\n");
+        FreeTcs(tcs);
+        return 1;
+    }
+    printf("TerminalCapabilitySet of %d bytes\n", (int)sizeof(BenchTcs));
+
+    uint32 start = OsclTickCount::TickCount();
+    for (uint32 i = 0; i < BENCH_LOOPS; i++)
+    {
+        FreeTcs(DecodeTcs(NULL));
+    }
+    PrintRate("heap decode+delete:", start);
+
+    start = OsclTickCount::TickCount();
+    for (uint32 i = 0; i < BENCH_LOOPS; i++)
+    {
+        uint8* space = (uint8*)OSCL_DEFAULT_MALLOC(oscl_mem_aligned_size(sizeof(PerArena)) + BENCH_ARENA_SIZE);
+        PerArena* arena = new(space) PerArena(space + oscl_mem_aligned_size(sizeof(PerArena)), BENCH_ARENA_SIZE);
+        DecodeTcs(arena);
+        arena->~PerArena();
+        OSCL_DEFAULT_FREE(space);
+    }
+    PrintRate("arena decode+release:", start);
+
+    start = OsclTickCount::TickCount();
+    for (uint32 i = 0; i < BENCH_LOOPS; i++)
+    {
+        FreeTcs(Copy_TerminalCapabilitySet(tcs));
+    }
+    PrintRate("copy+delete:", start);
+
+    start = OsclTickCount::TickCount();
+    for (uint32 i = 0; i < BENCH_LOOPS; i++)
+    {
+        out = NewOutStream();
+        Encode_TerminalCapabilitySet(tcs, out);
+        WriteRemainingBits(out);
+        FreeOutStream(out);
+    }
+    PrintRate("encode:", start);
+
+    FreeTcs(tcs);
+    return 0;
+}
+
+int main()
+{
+    OsclBase::Init();
+    OsclErrorTrap::Init();
+    OsclMem::Init();
+
+    int result = 1;
+    int32 err = 0;
+    OSCL_TRY(err, result = RunBenchmark(););
+    if (err)
+    {
+        printf("leave %d\n", err);
+    }
+
+    OsclMem::Cleanup();
+    OsclErrorTrap::Cleanup();
+    OsclBase::Cleanup();
+    return result;
+}
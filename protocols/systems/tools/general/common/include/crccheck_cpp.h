@@ -32,6 +32,17 @@
 #define CRC_ERR     1
 #define SN_ERR      2
 
+/* Register values for the incremental CRC interface */
+#define CRC8_INIT       0x00U
+#define CRC16_INIT      0xffffU
+/* Register value after running a CRC over a frame including its
+ * CRC field, when the frame is good */
+#define CRC8_RESIDUE    0x00U
+#define CRC16_RESIDUE   0xf0b8U
+
+/* Number of bytes handled per step by the slicing tables */
+#define CRC_SLICES      8
+
 class CRC
 {
     public:
@@ -45,8 +56,18 @@ class CRC
         OSCL_IMPORT_REF uint16 Crc16Check(Packet *pPkt);
         OSCL_IMPORT_REF uint16 Crc16Check(OsclSharedPtr<PVMFMediaDataImpl>& mediaData, bool hasCRC = false);
 
-        uint16  CrcTbl8[256];
-        uint16  CrcTbl16[256];
+        /* Incremental interface.  Start the register at CRC8_INIT or
+         * CRC16_INIT and feed the fragments of a frame in order.  The
+         * CRC-8 result is the register itself, the CRC-16 result is the
+         * register xor 0xffff. */
+        OSCL_IMPORT_REF uint8 Crc8Update(uint8 aCrc, const uint8 *pData, uint32 Size) const;
+        OSCL_IMPORT_REF uint16 Crc16Update(uint16 aCrc, const uint8 *pData, uint32 Size) const;
+
+    private:
+        /* Slicing-by-8 tables.  Table 0 is the classic byte table,
+         * table k advances a byte through k more zero bytes. */
+        uint8   CrcTbl8[CRC_SLICES][256];
+        uint16  CrcTbl16[CRC_SLICES][256];
 };
 
 #endif  /* _CRCCHECK_H */
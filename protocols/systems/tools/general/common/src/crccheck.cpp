@@ -32,7 +32,7 @@
 //Initialize both tables.
 OSCL_EXPORT_REF CRC::CRC()
 {
-    int i;
+    int i, k;
     uint8 j, Crc;
 
     for (i = 0 ; i <= (int) UCHAR_MAX ; i ++)
@@ -45,7 +45,7 @@ OSCL_EXPORT_REF CRC::CRC()
             else
                 Crc >>= 1;
         }
-        CrcTbl8[i] = Crc;
+        CrcTbl8[0][i] = Crc;
     }
 
 
@@ -61,58 +61,98 @@ OSCL_EXPORT_REF CRC::CRC()
             else
                 Crc16 >>= 1;
         }
-        CrcTbl16[ n ] = Crc16;          /* CRC Infomaiton Set           */
+        CrcTbl16[0][ n ] = Crc16;          /* CRC Infomaiton Set           */
+    }
+
+    /* Slicing tables: entry k is entry k-1 run through one more zero byte */
+    for (k = 1 ; k < CRC_SLICES ; k++)
+    {
+        for (i = 0 ; i <= (int) UCHAR_MAX ; i++)
+        {
+            CrcTbl8[k][i] = CrcTbl8[0][CrcTbl8[k-1][i]];
+            CrcTbl16[k][i] = (uint16)((CrcTbl16[k-1][i] >> CHAR_BIT) ^ CrcTbl16[0][(uint8)CrcTbl16[k-1][i]]);
+        }
     }
 }
 
 
-OSCL_EXPORT_REF uint8 CRC::Crc8Check(uint8 *pAlPdu, int16 Size)
+OSCL_EXPORT_REF uint8 CRC::Crc8Update(uint8 aCrc, const uint8 *pData, uint32 Size) const
 {
-    uint8   crc;
+    uint8 crc = aCrc;
 
-    crc = 0;
-    while (--Size >= 0)
+    /* 8 bytes per step.  The register is only 8 bits wide, so it is
+     * folded into the first byte and the other seven go straight to
+     * their tables.  Bytes are loaded one at a time so the data needs
+     * no alignment and the result does not depend on byte order. */
+    while (Size >= CRC_SLICES)
     {
-        crc = (uint8)((crc >> CHAR_BIT) ^ CrcTbl8[ crc ^ *pAlPdu++ ]);
+        crc = (uint8)(CrcTbl8[7][crc ^ pData[0]] ^ CrcTbl8[6][pData[1]] ^
+                      CrcTbl8[5][pData[2]] ^ CrcTbl8[4][pData[3]] ^
+                      CrcTbl8[3][pData[4]] ^ CrcTbl8[2][pData[5]] ^
+                      CrcTbl8[1][pData[6]] ^ CrcTbl8[0][pData[7]]);
+        pData += CRC_SLICES;
+        Size -= CRC_SLICES;
     }
-    return (uint8)(crc & 0xffU);
+    while (Size--)
+    {
+        crc = CrcTbl8[0][crc ^ *pData++];
+    }
+    return crc;
+}
+
+OSCL_EXPORT_REF uint16 CRC::Crc16Update(uint16 aCrc, const uint8 *pData, uint32 Size) const
+{
+    uint16 crc = aCrc;
+
+    /* As Crc8Update, with the 16 bit register folded into the first
+     * two bytes. */
+    while (Size >= CRC_SLICES)
+    {
+        crc = (uint16)(CrcTbl16[7][(uint8)crc ^ pData[0]] ^ CrcTbl16[6][(uint8)(crc >> CHAR_BIT) ^ pData[1]] ^
+                       CrcTbl16[5][pData[2]] ^ CrcTbl16[4][pData[3]] ^
+                       CrcTbl16[3][pData[4]] ^ CrcTbl16[2][pData[5]] ^
+                       CrcTbl16[1][pData[6]] ^ CrcTbl16[0][pData[7]]);
+        pData += CRC_SLICES;
+        Size -= CRC_SLICES;
+    }
+    while (Size--)
+    {
+        crc = (uint16)((crc >> CHAR_BIT) ^ CrcTbl16[0][(uint8)crc ^ *pData++]);
+    }
+    return crc;
+}
+
+
+OSCL_EXPORT_REF uint8 CRC::Crc8Check(uint8 *pAlPdu, int16 Size)
+{
+    if (Size <= 0)
+        return CRC8_INIT;
+    return Crc8Update(CRC8_INIT, pAlPdu, (uint32)Size);
 }
 
 OSCL_EXPORT_REF uint8 CRC::Crc8Check(Packet *pPkt)
 {
-    uint8   crc;
-    uint8   *pData = NULL;
-    int32   fragIdx, curSize, dataSize;
+    uint8   crc = CRC8_INIT;
+    int32   fragIdx, dataSize;
     BufferFragment* frag = NULL;
 
-    crc = 0;
-    fragIdx = 0;
     dataSize = pPkt->GetMediaSize();
-    curSize = 0;
-    while (--dataSize >= 0)
+    for (fragIdx = 0 ; dataSize > 0 ; fragIdx++)
     {
-
-        if ((--curSize) <= 0)
-        {
-            frag = pPkt->GetMediaFragment(fragIdx);
-            fragIdx++;
-            curSize = frag->len;
-            pData = (uint8 *) frag->ptr;
-        }
-        crc = (uint8)((crc >> CHAR_BIT) ^ CrcTbl8[ crc ^ *pData++ ]);
+        frag = pPkt->GetMediaFragment(fragIdx);
+        int32 len = (frag->len < (uint32)dataSize) ? frag->len : dataSize;
+        crc = Crc8Update(crc, (uint8 *) frag->ptr, len);
+        dataSize -= len;
     }
-    return (uint8)(crc & 0xffU);
+    return crc;
 }
 
 OSCL_EXPORT_REF uint8 CRC::Crc8Check(OsclSharedPtr<PVMFMediaDataImpl>& mediaData, bool hasCRC)
 {
-    uint8   crc;
-    uint8   *pData = NULL;
-    int32   fragIdx, curSize, dataSize;
+    uint8   crc = CRC8_INIT;
+    int32   fragIdx, dataSize;
     OsclRefCounterMemFrag frag;
 
-    crc = 0;
-    fragIdx = 0;
     //Don't include CRC field in calculation
     if (hasCRC)
     {
@@ -122,81 +162,47 @@ OSCL_EXPORT_REF uint8 CRC::Crc8Check(OsclSharedPtr<PVMFMediaDataImpl>& mediaData
     {
         dataSize = mediaData->getFilledSize();
     }
-    curSize = 0;
-    while (--dataSize >= 0)
+    for (fragIdx = 0 ; dataSize > 0 ; fragIdx++)
     {
-
-        if ((--curSize) <= 0)
-        {
-            mediaData->getMediaFragment(fragIdx, frag);
-            fragIdx++;
-            curSize = frag.getMemFragSize();
-            pData = (uint8 *) frag.getMemFragPtr();
-        }
-        crc = (uint8)((crc >> CHAR_BIT) ^ CrcTbl8[ crc ^ *pData++ ]);
+        mediaData->getMediaFragment(fragIdx, frag);
+        int32 len = (frag.getMemFragSize() < (uint32)dataSize) ? frag.getMemFragSize() : dataSize;
+        crc = Crc8Update(crc, (uint8 *) frag.getMemFragPtr(), len);
+        dataSize -= len;
     }
-    return (uint8)(crc & 0xffU);
+    return crc;
 }
 
 
 OSCL_EXPORT_REF uint16 CRC::Crc16Check(uint8 *pAlPdu, int16 Size)
 {
-    uint16  crc;
-
-    crc = 0xffffU;
-    while (--Size >= 0)
-    {
-        crc = (uint16)((crc >> CHAR_BIT) ^ CrcTbl16[(uint8)crc ^ *pAlPdu++ ]);
-    }
-    return (uint16)(crc ^ 0xffffU);
-    /*
-    crc ^= 0xffffU;
-    crc = (crc&0xff)<<8 | crc>>8;
-    return crc;
-    */
+    if (Size <= 0)
+        return (uint16)(CRC16_INIT ^ 0xffffU);
+    return (uint16)(Crc16Update(CRC16_INIT, pAlPdu, (uint32)Size) ^ 0xffffU);
 }
 
 OSCL_EXPORT_REF uint16 CRC::Crc16Check(Packet *pPkt)
 {
-    uint16  crc;
-    uint8   *pData = NULL;
-    int32   fragIdx, curSize, dataSize;
+    uint16  crc = CRC16_INIT;
+    int32   fragIdx, dataSize;
     BufferFragment* frag = NULL;
 
-    crc = 0xffffU;
-    fragIdx = 0;
     dataSize = pPkt->GetMediaSize();
-    curSize = 0;
-    while (--dataSize >= 0)
+    for (fragIdx = 0 ; dataSize > 0 ; fragIdx++)
     {
-
-        if ((--curSize) <= 0)
-        {
-            frag = pPkt->GetMediaFragment(fragIdx);
-            fragIdx++;
-            curSize = frag->len;
-            pData = (uint8 *) frag->ptr;
-        }
-        crc = (uint16)((crc >> CHAR_BIT) ^ CrcTbl16[(uint8)crc ^ *pData++ ]);
+        frag = pPkt->GetMediaFragment(fragIdx);
+        int32 len = (frag->len < (uint32)dataSize) ? frag->len : dataSize;
+        crc = Crc16Update(crc, (uint8 *) frag->ptr, len);
+        dataSize -= len;
     }
     return (uint16)(crc ^ 0xffffU);
-    /*
-    crc ^= 0xffffU;
-    crc = (crc&0xff)<<8 | crc>>8;
-    return crc;
-    */
-
 }
 
 OSCL_EXPORT_REF uint16 CRC::Crc16Check(OsclSharedPtr<PVMFMediaDataImpl>& mediaData, bool hasCRC)
 {
-    uint16  crc;
-    uint8   *pData = NULL;
-    int32   fragIdx, curSize, dataSize;
+    uint16  crc = CRC16_INIT;
+    int32   fragIdx, dataSize;
     OsclRefCounterMemFrag frag;
 
-    crc = 0xffffU;
-    fragIdx = 0;
     //Don't include CRC field in calculation
     if (hasCRC)
     {
@@ -206,19 +212,12 @@ OSCL_EXPORT_REF uint16 CRC::Crc16Check(OsclSharedPtr<PVMFMediaDataImpl>& mediaDa
     {
         dataSize = mediaData->getFilledSize();
     }
-    curSize = 0;
-
-    while (--dataSize >= 0)
+    for (fragIdx = 0 ; dataSize > 0 ; fragIdx++)
     {
-
-        if ((--curSize) <= 0)
-        {
-            mediaData->getMediaFragment(fragIdx, frag);
-            fragIdx++;
-            curSize = frag.getMemFragSize();
-            pData = (uint8 *) frag.getMemFragPtr();
-        }
-        crc = (uint16)((crc >> CHAR_BIT) ^ CrcTbl16[(uint8)crc ^ *pData++ ]);
+        mediaData->getMediaFragment(fragIdx, frag);
+        int32 len = (frag.getMemFragSize() < (uint32)dataSize) ? frag.getMemFragSize() : dataSize;
+        crc = Crc16Update(crc, (uint8 *) frag.getMemFragPtr(), len);
+        dataSize -= len;
     }
     return (uint16)(crc ^ 0xffffU);
 }
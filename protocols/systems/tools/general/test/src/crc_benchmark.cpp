@@ -0,0 +1,154 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+// Reports the throughput of the H.223 CRC8 and CRC16 for a range of
+// PDU sizes, against the bitwise form of the same CRCs.  The results are
+// checked against the bitwise form first, so a wrong table fails the
+// run instead of producing a fast number.
+
+#include "stdio.h"
+#include "oscl_base.h"
+#include "oscl_mem.h"
+#include "oscl_error.h"
+#include "oscl_tickcount.h"
+#include "crccheck_cpp.h"
+
+#define BENCH_MAX_SIZE      4096
+#define BENCH_BYTES         (16 * 1024 * 1024)
+#define BENCH_BITWISE_BYTES (1024 * 1024)
+
+static const uint32 BenchSizes[] = {8, 64, 256, 1500, BENCH_MAX_SIZE};
+
+static uint8 BenchBuf[BENCH_MAX_SIZE];
+static CRC BenchCrc;
+
+static uint8 RefCrc8(const uint8* aData, uint32 aSize)
+{
+    uint8 crc = CRC8_INIT;
+    for (uint32 i = 0; i < aSize; i++)
+    {
+        crc ^= aData[i];
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (uint8)((crc & 1) ? ((crc >> 1) ^ 0xe0) : (crc >> 1));
+        }
+    }
+    return crc;
+}
+
+static uint16 RefCrc16(const uint8* aData, uint32 aSize)
+{
+    uint16 crc = CRC16_INIT;
+    for (uint32 i = 0; i < aSize; i++)
+    {
+        crc ^= aData[i];
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (uint16)((crc & 1) ? ((crc >> 1) ^ 0x8408) : (crc >> 1));
+        }
+    }
+    return (uint16)(crc ^ 0xffff);
+}
+
+static uint32 MBytesPerSec(uint32 aBytes, uint32 aMsec)
+{
+    if (aMsec == 0)
+    {
+        aMsec = 1;
+    }
+    return (uint32)((aBytes * 1000.0) / (aMsec * 1048576.0));
+}
+
+static int RunBenchmark()
+{
+    uint32 seed = 0x12345678;
+    for (uint32 i = 0; i < BENCH_MAX_SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        BenchBuf[i] = (uint8)(seed >> 16);
+    }
+
+    for (uint32 i = 0; i < sizeof(BenchSizes) / sizeof(BenchSizes[0]); i++)
+    {
+        uint32 size = BenchSizes[i];
+        if ((BenchCrc.Crc8Check(BenchBuf, (int16)size) != RefCrc8(BenchBuf, size)) ||
+                (BenchCrc.Crc16Check(BenchBuf, (int16)size) != RefCrc16(BenchBuf, size)))
+        {
+            printf("%d byte buffer: crc does not match the bitwise reference\n", size);
+            return 1;
+        }
+    }
+
+    // keeps the compiler from dropping the loops
+    uint32 sink = 0;
+    for (uint32 i = 0; i < sizeof(BenchSizes) / sizeof(BenchSizes[0]); i++)
+    {
+        uint32 size = BenchSizes[i];
+        uint32 loops = BENCH_BYTES / size;
+
+        uint32 start = OsclTickCount::TickCount();
+        for (uint32 j = 0; j < loops; j++)
+        {
+            sink += BenchCrc.Crc8Check(BenchBuf, (int16)size);
+        }
+        uint32 crc8Msec = OsclTickCount::TicksToMsec(OsclTickCount::TickCount() - start);
+
+        start = OsclTickCount::TickCount();
+        for (uint32 j = 0; j < loops; j++)
+        {
+            sink += BenchCrc.Crc16Check(BenchBuf, (int16)size);
+        }
+        uint32 crc16Msec = OsclTickCount::TicksToMsec(OsclTickCount::TickCount() - start);
+
+        printf("%4d byte buffers: crc8 %d MB/s, crc16 %d MB/s\n", size,
+               MBytesPerSec(loops * size, crc8Msec), MBytesPerSec(loops * size, crc16Msec));
+    }
+
+    uint32 loops = BENCH_BITWISE_BYTES / BENCH_MAX_SIZE;
+    uint32 start = OsclTickCount::TickCount();
+    for (uint32 j = 0; j < loops; j++)
+    {
+        sink += RefCrc8(BenchBuf, BENCH_MAX_SIZE);
+    }
+    uint32 crc8Msec = OsclTickCount::TicksToMsec(OsclTickCount::TickCount() - start);
+
+    start = OsclTickCount::TickCount();
+    for (uint32 j = 0; j < loops; j++)
+    {
+        sink += RefCrc16(BenchBuf, BENCH_MAX_SIZE);
+    }
+    uint32 crc16Msec = OsclTickCount::TicksToMsec(OsclTickCount::TickCount() - start);
+
+    printf("bitwise reference: crc8 %d MB/s, crc16 %d MB/s (%x)\n",
+           MBytesPerSec(loops * BENCH_MAX_SIZE, crc8Msec),
+           MBytesPerSec(loops * BENCH_MAX_SIZE, crc16Msec), sink & 0xff);
+    return 0;
+}
+
+int main()
+{
+    OsclBase::Init();
+    OsclErrorTrap::Init();
+    OsclMem::Init();
+
+    int result = RunBenchmark();
+
+    OsclMem::Cleanup();
+    OsclErrorTrap::Cleanup();
+    OsclBase::Cleanup();
+    return result;
+}
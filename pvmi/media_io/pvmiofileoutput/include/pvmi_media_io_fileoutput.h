@@ -42,6 +42,9 @@
 #ifndef PVMI_MEDIA_IO_CLOCK_EXTENSION_H_INCLUDED
 #include "pvmi_media_io_clock_extension.h"
 #endif
+#ifndef PVMI_MEDIA_TRANSFER_BATCH_EXTENSION_H_INCLUDED
+#include "pvmi_media_transfer_batch_extension.h"
+#endif
 
 #ifndef AVI_WRITE_H_INCLUDED
 #include "avi_write.h"
@@ -66,6 +69,9 @@ class PVRefFileOutput;
 
 #define DEFAULT_NUM_DECODED_FRAMES_CAPABILITY   6
 
+// Largest batch taken by writeBatchAsync
+#define PVREFFILEOUTPUT_MAX_BATCH_ENTRIES 16
+
 // To maintain the count of supported uncompressed audio formats.
 // Should be updated whenever new format is added
 #define PVMF_SUPPORTED_UNCOMPRESSED_AUDIO_FORMATS_COUNT 6
@@ -171,6 +177,7 @@ class PVRefFileOutput : public OsclTimerObject
         , public PvmiMediaTransfer
         , public PvmiCapabilityAndConfig
         , public PvmiClockExtensionInterface
+        , public PvmiMediaTransferBatchExtensionInterface
 
 {
     public:
@@ -263,6 +270,18 @@ class PVRefFileOutput : public OsclTimerObject
 
         void setUserClockExtnInterface(bool aEnable);
 
+        // Advertises the batch extension when enabled.  Off by default.
+        void setUserBatchExtnInterface(bool aEnable);
+
+        // APIs from PvmiMediaTransferBatchExtensionInterface
+
+        uint32 getMaxBatchEntries();
+
+        PVMFCommandId writeBatchAsync(uint8 format_type, int32 format_index,
+                                      const PvmiMediaXferBatchEntry* entries,
+                                      uint32 num_entries,
+                                      OsclAny* aContext = NULL);
+
         // Pure virtuals from PvmiCapabilityAndConfig
 
         void setObserver(PvmiConfigAndCapabilityCmdObserver* aObserver);
@@ -319,6 +338,9 @@ class PVRefFileOutput : public OsclTimerObject
         void Cleanup();
         void ResetData();
 
+        PVMFStatus WriteMediaData(uint8* aData, uint32 aDataLen,
+                                  const PvmiMediaXferHeader& data_header_info, bool& aDiscard);
+
         PvmiMediaTransfer* iPeer;
 
         // The PvmiMIOControl class observer.
@@ -439,6 +461,9 @@ class PVRefFileOutput : public OsclTimerObject
         //if iUseClockExtension set to true, no data is dropped
         bool iUseClockExtension;
 
+        //if iUseBatchExtension set to true, the batch extension is advertised
+        bool iUseBatchExtension;
+
         //Used for deciding when to send ConfigComplete event to MIO node
         bool iIsMIOConfigured;
 
@@ -180,6 +180,7 @@ void PVRefFileOutput::initData()
     iFormatMask = 0;
     iTextFormat = PVMF_MIME_FORMAT_UNKNOWN;
     iUseClockExtension = false;
+    iUseBatchExtension = false;
     iRIFFChunk.chunkID = FOURCC_RIFF;//0x46464952;   //"RIFF" in ASCII form, big-endian form
     iRIFFChunk.chunkSize = 0;
     iRIFFChunk.format  = FOURCC_WAVE;//0x45564157;   //"WAVE" in ASCII form, big-endian form
@@ -232,6 +233,11 @@ void PVRefFileOutput::setUserClockExtnInterface(bool aEnable)
 
 }
 
+void PVRefFileOutput::setUserBatchExtnInterface(bool aEnable)
+{
+    iUseBatchExtension = aEnable;
+}
+
 void PVRefFileOutput::ResetData()
 //reset all data from this session.
 {
@@ -394,6 +400,10 @@ PVMFCommandId PVRefFileOutput::QueryUUID(const PvmfMimeString& aMimeType,
     PVUuid uuid;
     iActiveTiming->queryUuid(uuid);
         aUuids.push_back(uuid);
+    }
+    if (iUseBatchExtension)
+{
+    aUuids.push_back(PvmiMediaTransferBatchExtensionInterfaceUuid);
     }
             );
     if (err == OsclErrNone)
@@ -441,6 +451,20 @@ PVMFCommandId PVRefFileOutput::QueryInterface(const PVUuid& aUuid, PVInterface*&
             status = PVMFFailure;
         }
     }
+    else if (aUuid == PvmiMediaTransferBatchExtensionInterfaceUuid)
+    {
+        //the batch extension interface is present only when it is enabled.
+        if (iUseBatchExtension)
+        {
+            PvmiMediaTransferBatchExtensionInterface* myInterface = OSCL_STATIC_CAST(PvmiMediaTransferBatchExtensionInterface*, this);
+            aInterfacePtr = OSCL_STATIC_CAST(PVInterface*, myInterface);
+            status = PVMFSuccess;
+        }
+        else
+        {
+            status = PVMFFailure;
+        }
+    }
     else
     {
         status = PVMFFailure;
@@ -1027,160 +1051,7 @@ PVMFCommandId PVRefFileOutput::writeAsync(uint8 aFormatType, int32 aFormatIndex,
                     else
                     {
                         // Just write out the passed in data to file
-                        if (iLogStrings)
-                        {
-                            if (!iParametersLogged)
-                            {
-                                LogParameters();
-                            }
-                        }
-
-                        if (aDataLen > 0)
-                        {
-                            //check whether the player clock is in frame-step mode.
-                            //do not render audio in frame-step mode.
-                            if (iAudioFormat != PVMF_MIME_FORMAT_UNKNOWN
-                                    && iActiveTiming
-                                    && iActiveTiming->FrameStepMode())
-                            {
-                                discard = true;
-                            }
-
-                            LogFrame(data_header_info.seq_num, data_header_info.timestamp, aDataLen);
-                            if (iTextFormat == PVMF_MIME_3GPP_TIMEDTEXT)
-                            {
-                                // Guard against somebody setting this MIO component for multiple data types
-                                OSCL_ASSERT(iVideoFormat == PVMF_MIME_FORMAT_UNKNOWN && iAudioFormat == PVMF_MIME_FORMAT_UNKNOWN);
-
-                                PVMFTimedTextMediaData* textmediadata = (PVMFTimedTextMediaData*)aData;
-
-                                // Write out the text sample entry
-                                if (textmediadata->iTextSampleEntry.GetRep() != NULL)
-                                {
-                                    // @todo Write out the text sample entry in a better format
-                                    if (iLogOutputToFile && iOutputFile.Write((OsclAny*)(textmediadata->iTextSampleEntry.GetRep()), sizeof(PVMFTimedTextSampleEntry), 1) != 1)
-                                    {
-                                        PVLOGGER_LOGMSG(PVLOGMSG_INST_REL, iLogger, PVLOGMSG_ERR,
-                                                        (0, "PVRefFileOutput::writeAsync: Error - File write failed for text sample entry"));
-                                        status = PVMFFailure;
-                                        break;
-                                    }
-                                }
-
-                                // Write out the raw text sample
-                                if (iLogOutputToFile && iOutputFile.Write(textmediadata->iTextSample, sizeof(uint8), textmediadata->iTextSampleLength) != textmediadata->iTextSampleLength)
-                                {
-                                    PVLOGGER_LOGMSG(PVLOGMSG_INST_REL, iLogger, PVLOGMSG_ERR,
-                                                    (0, "PVRefFileOutput::writeAsync: Error - File write failed for text sample data"));
-                                    status = PVMFFailure;
-                                }
-                                else
-                                {
-                                    status = PVMFSuccess;
-                                }
-                            }
-                            else if (discard)
-                            {
-                                //do not render this frame.
-                                char string[128];
-                                int32 len = oscl_snprintf(string, 128, "discard-- frame-step mode");
-                                if (iLogOutputToFile && iOutputFile.Write(string, sizeof(uint8), len) != (uint32)len)
-                                {
-                                    PVLOGGER_LOGMSG(PVLOGMSG_INST_REL, iLogger, PVLOGMSG_ERR,
-                                                    (0, "PVRefFileOutput::writeAsync: Error - File write failed"));
-                                    status = PVMFFailure;
-                                }
-                            }
-                            else
-                            {
-                                if (iHeaderWritten != true && (iAudioFormat == PVMF_MIME_PCM16 || iAudioFormat == PVMF_MIME_PCM8))
-                                {
-                                    if (iLogOutputToFile)
-                                    {
-                                        iOutputFile.Write(&iRIFFChunk, sizeof(uint8), sizeof(RIFFChunk));
-                                        iOutputFile.Write(&iFmtSubchunk, sizeof(uint8), sizeof(fmtSubchunk));
-                                        iOutputFile.Write(&iDataSubchunk, sizeof(uint8), sizeof(dataSubchunk));
-                                    }
-                                    iHeaderWritten = true;
-                                }
-                                if (iHeaderWritten != true && (iVideoFormat == PVMF_MIME_YUV420 || iVideoFormat == PVMF_MIME_YUV422))
-                                {
-                                    WriteHeaders();
-                                    iHeaderWritten = true;
-                                }
-
-                                if (iAudioFormat == PVMF_MIME_AMR_IETF ||
-                                        iAudioFormat == PVMF_MIME_AMR_IF2 ||
-                                        iVideoFormat == PVMF_MIME_H2631998 ||
-                                        iVideoFormat == PVMF_MIME_H2632000 ||
-                                        iVideoFormat == PVMF_MIME_M4V)
-                                {
-                                    if (iLogOutputToFile && iOutputFile.Write(aData, sizeof(uint8), aDataLen) != aDataLen)
-                                    {
-                                        PVLOGGER_LOGMSG(PVLOGMSG_INST_REL, iLogger, PVLOGMSG_ERR,
-                                                        (0, "PVRefFileOutput::writeAsync: Error - File write failed"));
-                                        status = PVMFFailure;
-                                    }
-                                    else
-                                    {
-                                        status = PVMFSuccess;
-                                    }
-                                }
-                                //'render' this frame
-                                if (iAudioFormat == PVMF_MIME_PCM16 || iAudioFormat == PVMF_MIME_PCM8)
-                                {
-                                    if (iLogOutputToFile && iOutputFile.Write(aData, sizeof(uint8), aDataLen) != aDataLen)
-                                    {
-                                        PVLOGGER_LOGMSG(PVLOGMSG_INST_REL, iLogger, PVLOGMSG_ERR,
-                                                        (0, "PVRefFileOutput::writeAsync: Error - File write failed"));
-                                        status = PVMFFailure;
-                                    }
-                                    else
-                                    {
-                                        if (iAudioFormat == PVMF_MIME_PCM16 || iAudioFormat == PVMF_MIME_PCM8)
-                                            iDataSubchunk.subchunk2Size += aDataLen;
-                                        status = PVMFSuccess;
-                                    }
-                                }
-
-                                if (iVideoFormat == PVMF_MIME_YUV420 || iVideoFormat == PVMF_MIME_YUV422)
-                                {
-#ifdef AVI_OUTPUT
-                                    unsigned char *u, *v, ch;
-                                    uint32 fsize = iVideoWidth * iVideoHeight;
-                                    uint32 bsize = iVideoWidth * iVideoHeight * 3 / 2;
-                                    u = aData + fsize;
-                                    v = aData + fsize * 5 / 4;
-                                    for (int j = 0; j < fsize / 4; j++)
-                                    {
-                                        ch = u[j];
-                                        u[j] = v[j];
-                                        v[j] = ch;
-                                    }
-                                    AddChunk(aData, bsize, videoChunkID);
-                                    iVideoLastTimeStamp = data_header_info.timestamp;
-                                    iAVIChunkSize += bsize + 4 + 4;
-                                    status = PVMFSuccess;
-#else
-                                    uint32 size = iVideoWidth * iVideoHeight * 3 / 2;
-                                    if (iLogOutputToFile && iOutputFile.Write(aData, sizeof(uint8), size) != size)
-                                    {
-                                        PVLOGGER_LOGMSG(PVLOGMSG_INST_REL, iLogger, PVLOGMSG_ERR,
-                                                        (0, "PVRefFileOutput::writeAsync: Error - File write failed"));
-                                        status = PVMFFailure;
-                                    }
-                                    else
-                                        status = PVMFSuccess;
-#endif
-                                }
-                            }
-                        }
-                        else
-                        {
-                            PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_INFO,
-                                            (0, "PVRefFileOutput::writeAsync() called aDataLen==0."));
-                            status = PVMFSuccess;
-                        }
+                        status = WriteMediaData(aData, aDataLen, data_header_info, discard);
                     }
                     break;
 
@@ -1208,6 +1079,249 @@ PVMFCommandId PVRefFileOutput::writeAsync(uint8 aFormatType, int32 aFormatIndex,
 
 }
 
+PVMFStatus PVRefFileOutput::WriteMediaData(uint8* aData, uint32 aDataLen,
+        const PvmiMediaXferHeader& data_header_info, bool& aDiscard)
+//Writes out one media data buffer, once the component has accepted it.
+{
+    PVMFStatus status = PVMFFailure;
+
+    if (iLogStrings)
+    {
+        if (!iParametersLogged)
+        {
+            LogParameters();
+        }
+    }
+
+    if (aDataLen > 0)
+    {
+        //check whether the player clock is in frame-step mode.
+        //do not render audio in frame-step mode.
+        if (iAudioFormat != PVMF_MIME_FORMAT_UNKNOWN
+                && iActiveTiming
+                && iActiveTiming->FrameStepMode())
+        {
+            aDiscard = true;
+        }
+
+        LogFrame(data_header_info.seq_num, data_header_info.timestamp, aDataLen);
+        if (iTextFormat == PVMF_MIME_3GPP_TIMEDTEXT)
+        {
+            // Guard against somebody setting this MIO component for multiple data types
+            OSCL_ASSERT(iVideoFormat == PVMF_MIME_FORMAT_UNKNOWN && iAudioFormat == PVMF_MIME_FORMAT_UNKNOWN);
+
+            PVMFTimedTextMediaData* textmediadata = (PVMFTimedTextMediaData*)aData;
+
+            // Write out the text sample entry
+            if (textmediadata->iTextSampleEntry.GetRep() != NULL)
+            {
+                // @todo Write out the text sample entry in a better format
+                if (iLogOutputToFile && iOutputFile.Write((OsclAny*)(textmediadata->iTextSampleEntry.GetRep()), sizeof(PVMFTimedTextSampleEntry), 1) != 1)
+                {
+                    PVLOGGER_LOGMSG(PVLOGMSG_INST_REL, iLogger, PVLOGMSG_ERR,
+                                    (0, "PVRefFileOutput::WriteMediaData: Error - File write failed for text sample entry"));
+                    return PVMFFailure;
+                }
+            }
+
+            // Write out the raw text sample
+            if (iLogOutputToFile && iOutputFile.Write(textmediadata->iTextSample, sizeof(uint8), textmediadata->iTextSampleLength) != textmediadata->iTextSampleLength)
+            {
+                PVLOGGER_LOGMSG(PVLOGMSG_INST_REL, iLogger, PVLOGMSG_ERR,
+                                (0, "PVRefFileOutput::WriteMediaData: Error - File write failed for text sample data"));
+                status = PVMFFailure;
+            }
+            else
+            {
+                status = PVMFSuccess;
+            }
+        }
+        else if (aDiscard)
+        {
+            //do not render this frame.
+            char string[128];
+            int32 len = oscl_snprintf(string, 128, "discard-- frame-step mode");
+            if (iLogOutputToFile && iOutputFile.Write(string, sizeof(uint8), len) != (uint32)len)
+            {
+                PVLOGGER_LOGMSG(PVLOGMSG_INST_REL, iLogger, PVLOGMSG_ERR,
+                                (0, "PVRefFileOutput::WriteMediaData: Error - File write failed"));
+                status = PVMFFailure;
+            }
+        }
+        else
+        {
+            if (iHeaderWritten != true && (iAudioFormat == PVMF_MIME_PCM16 || iAudioFormat == PVMF_MIME_PCM8))
+            {
+                if (iLogOutputToFile)
+                {
+                    iOutputFile.Write(&iRIFFChunk, sizeof(uint8), sizeof(RIFFChunk));
+                    iOutputFile.Write(&iFmtSubchunk, sizeof(uint8), sizeof(fmtSubchunk));
+                    iOutputFile.Write(&iDataSubchunk, sizeof(uint8), sizeof(dataSubchunk));
+                }
+                iHeaderWritten = true;
+            }
+            if (iHeaderWritten != true && (iVideoFormat == PVMF_MIME_YUV420 || iVideoFormat == PVMF_MIME_YUV422))
+            {
+                WriteHeaders();
+                iHeaderWritten = true;
+            }
+
+            if (iAudioFormat == PVMF_MIME_AMR_IETF ||
+                    iAudioFormat == PVMF_MIME_AMR_IF2 ||
+                    iVideoFormat == PVMF_MIME_H2631998 ||
+                    iVideoFormat == PVMF_MIME_H2632000 ||
+                    iVideoFormat == PVMF_MIME_M4V)
+            {
+                if (iLogOutputToFile && iOutputFile.Write(aData, sizeof(uint8), aDataLen) != aDataLen)
+                {
+                    PVLOGGER_LOGMSG(PVLOGMSG_INST_REL, iLogger, PVLOGMSG_ERR,
+                                    (0, "PVRefFileOutput::WriteMediaData: Error - File write failed"));
+                    status = PVMFFailure;
+                }
+                else
+                {
+                    status = PVMFSuccess;
+                }
+            }
+            //'render' this frame
+            if (iAudioFormat == PVMF_MIME_PCM16 || iAudioFormat == PVMF_MIME_PCM8)
+            {
+                if (iLogOutputToFile && iOutputFile.Write(aData, sizeof(uint8), aDataLen) != aDataLen)
+                {
+                    PVLOGGER_LOGMSG(PVLOGMSG_INST_REL, iLogger, PVLOGMSG_ERR,
+                                    (0, "PVRefFileOutput::WriteMediaData: Error - File write failed"));
+                    status = PVMFFailure;
+                }
+                else
+                {
+                    if (iAudioFormat == PVMF_MIME_PCM16 || iAudioFormat == PVMF_MIME_PCM8)
+                        iDataSubchunk.subchunk2Size += aDataLen;
+                    status = PVMFSuccess;
+                }
+            }
+
+            if (iVideoFormat == PVMF_MIME_YUV420 || iVideoFormat == PVMF_MIME_YUV422)
+            {
+#ifdef AVI_OUTPUT
+                unsigned char *u, *v, ch;
+                uint32 fsize = iVideoWidth * iVideoHeight;
+                uint32 bsize = iVideoWidth * iVideoHeight * 3 / 2;
+                u = aData + fsize;
+                v = aData + fsize * 5 / 4;
+                for (int j = 0; j < fsize / 4; j++)
+                {
+                    ch = u[j];
+                    u[j] = v[j];
+                    v[j] = ch;
+                }
+                AddChunk(aData, bsize, videoChunkID);
+                iVideoLastTimeStamp = data_header_info.timestamp;
+                iAVIChunkSize += bsize + 4 + 4;
+                status = PVMFSuccess;
+#else
+                uint32 size = iVideoWidth * iVideoHeight * 3 / 2;
+                if (iLogOutputToFile && iOutputFile.Write(aData, sizeof(uint8), size) != size)
+                {
+                    PVLOGGER_LOGMSG(PVLOGMSG_INST_REL, iLogger, PVLOGMSG_ERR,
+                                    (0, "PVRefFileOutput::WriteMediaData: Error - File write failed"));
+                    status = PVMFFailure;
+                }
+                else
+                    status = PVMFSuccess;
+#endif
+            }
+        }
+    }
+    else
+    {
+        PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_INFO,
+                        (0, "PVRefFileOutput::WriteMediaData() called aDataLen==0."));
+        status = PVMFSuccess;
+    }
+    return status;
+}
+
+uint32 PVRefFileOutput::getMaxBatchEntries()
+{
+    return PVREFFILEOUTPUT_MAX_BATCH_ENTRIES;
+}
+
+PVMFCommandId PVRefFileOutput::writeBatchAsync(uint8 aFormatType, int32 aFormatIndex,
+        const PvmiMediaXferBatchEntry* aEntries, uint32 aNumEntries, OsclAny* aContext)
+//Writes out a batch of media data buffers and queues a single write response
+//for the whole batch.  Only media data is taken in a batch.
+{
+    PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_STACK_TRACE,
+                    (0, "PVRefFileOutput::writeBatchAsync() entries %d context %d",
+                     aNumEntries, aContext));
+
+    if (aFormatType != PVMI_MEDIAXFER_FMT_TYPE_DATA
+            || aFormatIndex != PVMI_MEDIAXFER_FMT_INDEX_DATA)
+    {
+        PVLOGGER_LOGMSG(PVLOGMSG_INST_REL, iLogger, PVLOGMSG_ERR,
+                        (0, "PVRefFileOutput::writeBatchAsync: Error - unsupported format"));
+        OSCL_LEAVE(OsclErrNotSupported);
+        return -1;
+    }
+
+    if (!iUseBatchExtension
+            || aEntries == NULL
+            || aNumEntries == 0
+            || aNumEntries > PVREFFILEOUTPUT_MAX_BATCH_ENTRIES)
+    {
+        PVLOGGER_LOGMSG(PVLOGMSG_INST_REL, iLogger, PVLOGMSG_ERR,
+                        (0, "PVRefFileOutput::writeBatchAsync: Error - invalid batch"));
+        OSCL_LEAVE(OsclErrArgument);
+        return -1;
+    }
+
+    //the batch is accepted or refused as a whole, so check the state and
+    //the flow control once, before any entry is written.
+    if (iState != STATE_STARTED)
+    {
+        PVLOGGER_LOGMSG(PVLOGMSG_INST_REL, iLogger, PVLOGMSG_ERR,
+                        (0, "PVRefFileOutput::writeBatchAsync: Error - Invalid state"));
+        iWriteBusy = true;
+        OSCL_LEAVE(OsclErrInvalidState);
+        return -1;
+    }
+    if (CheckWriteBusy(aEntries[0].data_header_info.seq_num))
+    {
+        PVLOGGER_LOGMSG(PVLOGMSG_INST_REL, iLogger, PVLOGMSG_ERR,
+                        (0, "PVRefFileOutput::writeBatchAsync: Entering busy state"));
+
+        //schedule an event to re-start the data flow.
+        iWriteBusy = true;
+        iWriteBusySeqNum = aEntries[0].data_header_info.seq_num;
+        RunIfNotReady();
+
+        OSCL_LEAVE(OsclErrBusy);
+    }
+
+    //the batch completes with the status of the first failed entry, and
+    //is timed by its last entry.
+    PVMFStatus status = PVMFSuccess;
+    bool discard = true;
+    for (uint32 i = 0; i < aNumEntries; i++)
+    {
+        bool entryDiscard = false;
+        PVMFStatus entryStatus = WriteMediaData(aEntries[i].data, aEntries[i].data_len,
+                                                aEntries[i].data_header_info, entryDiscard);
+        if (status == PVMFSuccess)
+        {
+            status = entryStatus;
+        }
+        discard = discard && entryDiscard;
+    }
+
+    //Schedule asynchronous response
+    PVMFCommandId cmdid = iCommandCounter++;
+    WriteResponse resp(status, cmdid, aContext, aEntries[aNumEntries - 1].data_header_info.timestamp, discard);
+    iWriteResponseQueue.push_back(resp);
+    RunIfNotReady();
+    return cmdid;
+}
+
 void PVRefFileOutput::writeComplete(PVMFStatus aStatus, PVMFCommandId  write_cmd_id, OsclAny* aContext)
 {
     OSCL_UNUSED_ARG(aStatus);
@@ -0,0 +1,33 @@
+LOCAL_PATH := $(call my-dir)
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES := \
+ 	src/pvmi_media_io_fileoutput_batch_test.cpp
+
+
+LOCAL_MODULE := pv_mio_fileoutput_batch_test
+
+LOCAL_CFLAGS :=  $(PV_CFLAGS)
+
+
+
+LOCAL_STATIC_LIBRARIES := 
+
+LOCAL_SHARED_LIBRARIES := libopencore_common
+
+LOCAL_C_INCLUDES := \
+	$(PV_TOP)/pvmi/media_io/pvmiofileoutput/test/src \
+ 	$(PV_TOP)/pvmi/media_io/pvmiofileoutput/test/src \
+ 	$(PV_TOP)/pvmi/media_io/pvmiofileoutput/include \
+ 	$(PV_TOP)/pvmi/pvmf/include \
+ 	$(PV_TOP)/nodes/common/include \
+ 	$(PV_INCLUDES)
+
+LOCAL_COPY_HEADERS_TO := $(PV_COPY_HEADERS_TO)
+
+LOCAL_COPY_HEADERS := \
+ 	
+
+-include $(PV_TOP)/Android_system_extras.mk
+
+include $(BUILD_EXECUTABLE)
@@ -0,0 +1,26 @@
+# Get the current local path as the first operation
+LOCAL_PATH := $(call get_makefile_dir)
+
+# Clear out the variables used in the local makefiles
+include $(MK)/clear.mk
+
+TARGET := pv_mio_fileoutput_batch_test
+
+
+XCXXFLAGS += $(FLAG_COMPILE_WARNINGS_AS_ERRORS)
+
+XINCDIRS += \
+  ../../../include \
+  ../../../../../pvmf/include \
+  ../../../../../../nodes/common/include
+
+SRCDIR := ../../src
+INCSRCDIR := ../../src
+
+SRCS := pvmi_media_io_fileoutput_batch_test.cpp
+
+LIBS := opencore_common
+
+SYSLIBS += $(SYS_THREAD_LIB)
+
+include $(MK)/prog.mk
@@ -0,0 +1,532 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+// Drives the batch extension of the reference file output component the way
+// the media output node does.  Checks that every accepted batch completes
+// with exactly one writeComplete, in order with the single writes, that a
+// refused batch takes none of its entries, and that the component completes
+// the outstanding batches before a reset completes.
+
+#include "stdio.h"
+#include "oscl_base.h"
+#include "oscl_mem.h"
+#include "oscl_error.h"
+#include "oscl_scheduler.h"
+#include "oscl_file_io.h"
+#include "oscl_utf8conv.h"
+#include "pvlogger.h"
+#include "pvmi_kvp.h"
+#include "pvmi_media_io_fileoutput.h"
+
+#define TEST_OUTPUT_FILE        "pvmiofileoutput_batch_test.out"
+#define TEST_WAV_HEADER_SIZE    44
+#define TEST_MAX_SEQ            64
+#define TEST_MAX_ENTRY_SIZE     256
+#define TEST_MAX_EVENTS         64
+
+static uint8 TestData[TEST_MAX_SEQ][TEST_MAX_ENTRY_SIZE];
+
+static uint32 TestEntrySize(uint32 aSeqNum)
+{
+    return 100 + (aSeqNum * 37) % (TEST_MAX_ENTRY_SIZE - 100);
+}
+
+enum TestEventType
+{
+    EVENT_WRITE_COMPLETE
+    , EVENT_REQUEST_COMPLETED
+};
+
+struct TestEvent
+{
+    TestEventType iType;
+    PVMFCommandId iCmdId;
+    PVMFStatus iStatus;
+    const OsclAny* iContext;
+};
+
+// Records the completions from the component, in the order they are made
+class TestEventLog
+{
+    public:
+        TestEventLog(): iNumEvents(0) {}
+
+        void Add(TestEventType aType, PVMFCommandId aCmdId, PVMFStatus aStatus, const OsclAny* aContext)
+        {
+            if (iNumEvents < TEST_MAX_EVENTS)
+            {
+                iEvents[iNumEvents].iType = aType;
+                iEvents[iNumEvents].iCmdId = aCmdId;
+                iEvents[iNumEvents].iStatus = aStatus;
+                iEvents[iNumEvents].iContext = aContext;
+            }
+            iNumEvents++;
+        }
+
+        uint32 Count(TestEventType aType)
+        {
+            uint32 count = 0;
+            for (uint32 i = 0; (i < iNumEvents) && (i < TEST_MAX_EVENTS); i++)
+            {
+                if (iEvents[i].iType == aType)
+                {
+                    count++;
+                }
+            }
+            return count;
+        }
+
+        // checks that event aIndex is a successful completion of aCmdId
+        bool Is(uint32 aIndex, TestEventType aType, PVMFCommandId aCmdId, const OsclAny* aContext)
+        {
+            if ((aIndex >= iNumEvents) || (aIndex >= TEST_MAX_EVENTS))
+            {
+                printf("  event %d missing\n", aIndex);
+                return false;
+            }
+            TestEvent& event = iEvents[aIndex];
+            if ((event.iType != aType) || (event.iCmdId != aCmdId)
+                    || (event.iStatus != PVMFSuccess) || (event.iContext != aContext))
+            {
+                printf("  event %d: type %d cmd %d status %d, expected type %d cmd %d\n",
+                       aIndex, event.iType, event.iCmdId, event.iStatus, aType, aCmdId);
+                return false;
+            }
+            return true;
+        }
+
+        TestEvent iEvents[TEST_MAX_EVENTS];
+        uint32 iNumEvents;
+};
+
+// Plays the media output node port: the writer of the media transfer
+class TestPeer : public PvmiMediaTransfer
+{
+    public:
+        TestPeer(TestEventLog& aLog): iLog(aLog), iNumStatusUpdates(0) {}
+
+        void setPeer(PvmiMediaTransfer* aPeer)
+        {
+            OSCL_UNUSED_ARG(aPeer);
+        }
+        void useMemoryAllocators(OsclMemAllocator* write_alloc)
+        {
+            OSCL_UNUSED_ARG(write_alloc);
+        }
+        PVMFCommandId writeAsync(uint8 format_type, int32 format_index, uint8* data, uint32 data_len,
+                                 const PvmiMediaXferHeader& data_header_info, OsclAny* aContext)
+        {
+            OSCL_UNUSED_ARG(format_type);
+            OSCL_UNUSED_ARG(format_index);
+            OSCL_UNUSED_ARG(data);
+            OSCL_UNUSED_ARG(data_len);
+            OSCL_UNUSED_ARG(data_header_info);
+            OSCL_UNUSED_ARG(aContext);
+            OsclError::Leave(OsclErrNotSupported);
+            return -1;
+        }
+        void writeComplete(PVMFStatus aStatus, PVMFCommandId write_cmd_id, OsclAny* aContext)
+        {
+            iLog.Add(EVENT_WRITE_COMPLETE, write_cmd_id, aStatus, aContext);
+        }
+        PVMFCommandId readAsync(uint8* data, uint32 max_data_len, OsclAny* aContext,
+                                int32* formats, uint16 num_formats)
+        {
+            OSCL_UNUSED_ARG(data);
+            OSCL_UNUSED_ARG(max_data_len);
+            OSCL_UNUSED_ARG(aContext);
+            OSCL_UNUSED_ARG(formats);
+            OSCL_UNUSED_ARG(num_formats);
+            OsclError::Leave(OsclErrNotSupported);
+            return -1;
+        }
+        void readComplete(PVMFStatus aStatus, PVMFCommandId read_cmd_id, int32 format_index,
+                          const PvmiMediaXferHeader& data_header_info, OsclAny* aContext)
+        {
+            OSCL_UNUSED_ARG(aStatus);
+            OSCL_UNUSED_ARG(read_cmd_id);
+            OSCL_UNUSED_ARG(format_index);
+            OSCL_UNUSED_ARG(data_header_info);
+            OSCL_UNUSED_ARG(aContext);
+        }
+        void statusUpdate(uint32 status_flags)
+        {
+            if (status_flags & PVMI_MEDIAXFER_STATUS_WRITE)
+            {
+                iNumStatusUpdates++;
+            }
+        }
+        void cancelCommand(PVMFCommandId command_id)
+        {
+            OSCL_UNUSED_ARG(command_id);
+        }
+        void cancelAllCommands()
+        {
+        }
+
+        TestEventLog& iLog;
+        uint32 iNumStatusUpdates;
+};
+
+// Plays the media output node: the observer of the control commands
+class TestMIOObserver : public PvmiMIOObserver
+{
+    public:
+        TestMIOObserver(TestEventLog& aLog): iLog(aLog) {}
+
+        void RequestCompleted(const PVMFCmdResp& aResponse)
+        {
+            iLog.Add(EVENT_REQUEST_COMPLETED, aResponse.GetCmdId(), aResponse.GetCmdStatus(), aResponse.GetContext());
+        }
+        void ReportErrorEvent(PVMFEventType aEventType, PVInterface* aExtMsg)
+        {
+            OSCL_UNUSED_ARG(aEventType);
+            OSCL_UNUSED_ARG(aExtMsg);
+        }
+        void ReportInfoEvent(PVMFEventType aEventType, PVInterface* aExtMsg)
+        {
+            OSCL_UNUSED_ARG(aEventType);
+            OSCL_UNUSED_ARG(aExtMsg);
+        }
+
+        TestEventLog& iLog;
+};
+
+static void RunScheduler()
+{
+    int32 ready = 1;
+    uint32 delay = 0;
+    while (ready > 0)
+    {
+        OsclExecScheduler::Current()->RunSchedulerNonBlocking(100, ready, delay);
+    }
+}
+
+// One component, logged on and started, with the batch extension queried
+class TestSession
+{
+    public:
+        TestSession(bool aSimFlowControl, bool aBatchExtension)
+                : iPeer(iLog)
+                , iObserver(iLog)
+                , iMIO(NULL)
+                , iBatch(NULL)
+                , iSession(0)
+        {
+            oscl_wchar fileName[64];
+            oscl_UTF8ToUnicode(TEST_OUTPUT_FILE, sizeof(TEST_OUTPUT_FILE) - 1, fileName, 64);
+            OSCL_wHeapString<OsclMemAllocator> name(fileName);
+            iMIO = OSCL_NEW(PVRefFileOutput, (name, NULL, false, 0, aSimFlowControl, false));
+            iMIO->setUserBatchExtnInterface(aBatchExtension);
+        }
+
+        ~TestSession()
+        {
+            iMIO->ThreadLogoff();
+            iMIO->disconnect(iSession);
+            OSCL_DELETE(iMIO);
+        }
+
+        // returns false when a control command fails
+        bool Start()
+        {
+            iMIO->connect(iSession, &iObserver);
+            iMIO->ThreadLogon();
+            iMIO->setPeer(&iPeer);
+
+            PVInterface* pvi = NULL;
+            iMIO->QueryInterface(PvmiMediaTransferBatchExtensionInterfaceUuid, pvi);
+            RunScheduler();
+            if ((iLog.iNumEvents == 1) && (iLog.iEvents[0].iStatus == PVMFSuccess))
+            {
+                iBatch = OSCL_STATIC_CAST(PvmiMediaTransferBatchExtensionInterface*, pvi);
+            }
+
+            PvmiKvp kvp;
+            kvp.key = (PvmiKeyType)MOUT_AUDIO_FORMAT_KEY;
+            kvp.value.pChar_value = (char*)"audio/L16";
+            PvmiKvp* retKvp = NULL;
+            iMIO->setParametersSync(iSession, &kvp, 1, retKvp);
+
+            iMIO->Init();
+            iMIO->Start();
+            RunScheduler();
+            bool ok = (iLog.iNumEvents == 3)
+                      && (iLog.iEvents[1].iStatus == PVMFSuccess)
+                      && (iLog.iEvents[2].iStatus == PVMFSuccess);
+            iLog.iNumEvents = 0;
+            return ok;
+        }
+
+        // leave code of a batch of the data of aNumEntries seq nums from aFirstSeqNum
+        int32 WriteBatch(uint32 aFirstSeqNum, uint32 aNumEntries, PVMFCommandId& aCmdId, OsclAny* aContext)
+        {
+            PvmiMediaXferBatchEntry entries[PVREFFILEOUTPUT_MAX_BATCH_ENTRIES + 1];
+            oscl_memset(entries, 0, sizeof(entries));
+            for (uint32 i = 0; (i < aNumEntries) && (i <= PVREFFILEOUTPUT_MAX_BATCH_ENTRIES); i++)
+            {
+                uint32 seqNum = aFirstSeqNum + i;
+                entries[i].data = TestData[seqNum];
+                entries[i].data_len = TestEntrySize(seqNum);
+                entries[i].data_header_info.seq_num = seqNum;
+                entries[i].data_header_info.timestamp = seqNum * 20;
+            }
+            int32 err = OsclErrNone;
+            OSCL_TRY(err, aCmdId = iBatch->writeBatchAsync(PVMI_MEDIAXFER_FMT_TYPE_DATA,
+                                   PVMI_MEDIAXFER_FMT_INDEX_DATA,
+                                   entries, aNumEntries, aContext););
+            return err;
+        }
+
+        int32 Write(uint32 aSeqNum, PVMFCommandId& aCmdId, OsclAny* aContext)
+        {
+            PvmiMediaXferHeader hdr;
+            oscl_memset(&hdr, 0, sizeof(hdr));
+            hdr.seq_num = aSeqNum;
+            hdr.timestamp = aSeqNum * 20;
+            int32 err = OsclErrNone;
+            OSCL_TRY(err, aCmdId = iMIO->writeAsync(PVMI_MEDIAXFER_FMT_TYPE_DATA,
+                                   PVMI_MEDIAXFER_FMT_INDEX_DATA,
+                                   TestData[aSeqNum], TestEntrySize(aSeqNum), hdr, aContext););
+            return err;
+        }
+
+        TestEventLog iLog;
+        TestPeer iPeer;
+        TestMIOObserver iObserver;
+        PVRefFileOutput* iMIO;
+        PvmiMediaTransferBatchExtensionInterface* iBatch;
+        PvmiMIOSession iSession;
+};
+
+// checks that the output file holds the data of seq nums 0 to aNumSeq - 1,
+// once each and in order
+static bool CheckOutputFile(uint32 aNumSeq)
+{
+    static uint8 buffer[TEST_WAV_HEADER_SIZE + TEST_MAX_SEQ * TEST_MAX_ENTRY_SIZE + 1];
+    Oscl_FileServer fs;
+    fs.Connect();
+    Oscl_File file;
+    bool ok = (file.Open(TEST_OUTPUT_FILE, Oscl_File::MODE_READ | Oscl_File::MODE_BINARY, fs) == 0);
+    uint32 size = 0;
+    if (ok)
+    {
+        size = file.Read(buffer, sizeof(uint8), sizeof(buffer));
+        file.Close();
+    }
+    fs.Close();
+
+    uint32 expected = TEST_WAV_HEADER_SIZE;
+    for (uint32 seqNum = 0; ok && (seqNum < aNumSeq); seqNum++)
+    {
+        uint32 entrySize = TestEntrySize(seqNum);
+        if ((expected + entrySize > size)
+                || (oscl_memcmp(buffer + expected, TestData[seqNum], entrySize) != 0))
+        {
+            printf("  seq %d is not where expected in the output file\n", seqNum);
+            ok = false;
+        }
+        expected += entrySize;
+    }
+    if (ok && (size != expected))
+    {
+        printf("  output file is %d bytes, expected %d\n", size, expected);
+        ok = false;
+    }
+    return ok;
+}
+
+// The extension is advertised only when enabled
+static bool TestExtensionOptIn()
+{
+    TestSession off(false, false);
+    TestSession on(false, true);
+    return off.Start() && (off.iBatch == NULL) && on.Start() && (on.iBatch != NULL);
+}
+
+// Batches of 1, 5 and the maximum entries, with a single write in between
+static bool TestBatchedWriteComplete()
+{
+    TestSession session(false, true);
+    if (!session.Start() || (session.iBatch == NULL))
+    {
+        printf("  start failed\n");
+        return false;
+    }
+    if (session.iBatch->getMaxBatchEntries() != PVREFFILEOUTPUT_MAX_BATCH_ENTRIES)
+    {
+        return false;
+    }
+
+    int32 context[4];
+    PVMFCommandId cmdId[4];
+    bool ok = (session.WriteBatch(0, 1, cmdId[0], &context[0]) == OsclErrNone)
+              && (session.WriteBatch(1, 5, cmdId[1], &context[1]) == OsclErrNone)
+              && (session.Write(6, cmdId[2], &context[2]) == OsclErrNone)
+              && (session.WriteBatch(7, PVREFFILEOUTPUT_MAX_BATCH_ENTRIES, cmdId[3], &context[3]) == OsclErrNone);
+    if (!ok)
+    {
+        printf("  write refused\n");
+        return false;
+    }
+
+    // refused as a whole, with no completion
+    PVMFCommandId refused;
+    ok = (session.WriteBatch(30, 0, refused, NULL) == OsclErrArgument)
+         && (session.WriteBatch(30, PVREFFILEOUTPUT_MAX_BATCH_ENTRIES + 1, refused, NULL) == OsclErrArgument);
+    if (!ok)
+    {
+        printf("  invalid batch accepted\n");
+        return false;
+    }
+
+    // nothing completes before the component runs
+    ok = (session.iLog.iNumEvents == 0);
+    RunScheduler();
+    ok = ok && (session.iLog.iNumEvents == 4);
+    for (uint32 i = 0; ok && (i < 4); i++)
+    {
+        ok = session.iLog.Is(i, EVENT_WRITE_COMPLETE, cmdId[i], &context[i]);
+    }
+
+    session.iMIO->Reset();
+    RunScheduler();
+    return ok && CheckOutputFile(7 + PVREFFILEOUTPUT_MAX_BATCH_ENTRIES);
+}
+
+// A batch refused with a busy leave takes none of its entries, and is
+// taken when sent again after the statusUpdate
+static bool TestBusyBatchRefusedWhole()
+{
+    // busy on every 5th buffer, so seq num 4 is refused the first time
+    TestSession session(true, true);
+    if (!session.Start() || (session.iBatch == NULL))
+    {
+        printf("  start failed\n");
+        return false;
+    }
+
+    PVMFCommandId cmdId[2];
+    bool ok = (session.WriteBatch(0, 4, cmdId[0], NULL) == OsclErrNone)
+              && (session.WriteBatch(4, 3, cmdId[1], NULL) == OsclErrBusy);
+    RunScheduler();
+    ok = ok && (session.iPeer.iNumStatusUpdates == 1)
+         && (session.iLog.iNumEvents == 1)
+         && session.iLog.Is(0, EVENT_WRITE_COMPLETE, cmdId[0], NULL);
+    if (!ok)
+    {
+        printf("  busy batch not refused\n");
+        return false;
+    }
+
+    ok = (session.WriteBatch(4, 3, cmdId[1], NULL) == OsclErrNone);
+    RunScheduler();
+    ok = ok && (session.iLog.iNumEvents == 2)
+         && session.iLog.Is(1, EVENT_WRITE_COMPLETE, cmdId[1], NULL);
+
+    session.iMIO->Reset();
+    RunScheduler();
+    return ok && CheckOutputFile(7);
+}
+
+// Outstanding writes keep the media transfer, and a reset completes them in
+// order before the reset itself completes
+static bool TestCleanupOrdering()
+{
+    TestSession session(false, true);
+    if (!session.Start() || (session.iBatch == NULL))
+    {
+        printf("  start failed\n");
+        return false;
+    }
+
+    int32 context[3];
+    PVMFCommandId cmdId[3];
+    bool ok = (session.WriteBatch(0, 3, cmdId[0], &context[0]) == OsclErrNone)
+              && (session.Write(3, cmdId[1], &context[1]) == OsclErrNone)
+              && (session.WriteBatch(4, 2, cmdId[2], &context[2]) == OsclErrNone);
+
+    int32 err = OsclErrNone;
+    OSCL_TRY(err, session.iMIO->deleteMediaTransfer(session.iSession, session.iMIO););
+    if (ok && (err != OsclErrBusy))
+    {
+        printf("  media transfer deleted with writes outstanding\n");
+        ok = false;
+    }
+
+    PVMFCommandId resetId = session.iMIO->Reset();
+    ok = ok && (session.iLog.iNumEvents == 3);
+    RunScheduler();
+    ok = ok && (session.iLog.iNumEvents == 4);
+    for (uint32 i = 0; ok && (i < 3); i++)
+    {
+        ok = session.iLog.Is(i, EVENT_WRITE_COMPLETE, cmdId[i], &context[i]);
+    }
+    ok = ok && session.iLog.Is(3, EVENT_REQUEST_COMPLETED, resetId, NULL);
+
+    OSCL_TRY(err, session.iMIO->deleteMediaTransfer(session.iSession, session.iMIO););
+    if (ok && (err != OsclErrNone))
+    {
+        printf("  media transfer not deleted after the writes completed\n");
+        ok = false;
+    }
+    return ok && CheckOutputFile(6);
+}
+
+int main(int argc, char** argv)
+{
+    OSCL_UNUSED_ARG(argc);
+    OSCL_UNUSED_ARG(argv);
+
+    OsclBase::Init();
+    OsclErrorTrap::Init();
+    OsclMem::Init();
+    PVLogger::Init();
+    OsclScheduler::Init("PVRefFileOutputBatchTest");
+
+    for (uint32 seqNum = 0; seqNum < TEST_MAX_SEQ; seqNum++)
+    {
+        for (uint32 i = 0; i < TEST_MAX_ENTRY_SIZE; i++)
+        {
+            TestData[seqNum][i] = (uint8)(seqNum * 7 + i);
+        }
+    }
+
+    uint32 failures = 0;
+    bool ok = TestExtensionOptIn();
+    printf("batch extension advertised only when enabled: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    ok = TestBatchedWriteComplete();
+    printf("one writeComplete per batch, in order: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    ok = TestBusyBatchRefusedWhole();
+    printf("busy batch refused as a whole: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    ok = TestCleanupOrdering();
+    printf("reset completes outstanding batches first: %s\n", ok ? "pass" : "FAIL");
+    failures += ok ? 0 : 1;
+
+    OsclScheduler::Cleanup();
+    PVLogger::Cleanup();
+    OsclMem::Cleanup();
+    OsclErrorTrap::Cleanup();
+    OsclBase::Cleanup();
+    return (failures == 0) ? 0 : 1;
+}
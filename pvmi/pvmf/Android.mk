@@ -14,6 +14,7 @@ LOCAL_SRC_FILES := \
         src/pvmf_node_interface.cpp \
         src/pvmf_pool_buffer_allocator.cpp \
         src/pvmf_port_base_impl.cpp \
+        src/pvmf_telemetry.cpp \
         src/pvmf_return_codes.cpp \
         src/pvmf_simple_media_buffer.cpp \
         src/pvmf_sync_util.cpp \
@@ -53,6 +54,7 @@ LOCAL_COPY_HEADERS := \
         include/pvmf_media_msg_format_ids.h \
         include/pvmf_media_cmd.h \
         include/pvmf_port_base_impl.h \
+        include/pvmf_telemetry.h \
         include/pvmi_config_and_capability_utils.h \
         include/pvmf_media_data.h \
         include/pvmf_port_interface.h \
@@ -75,6 +77,7 @@ LOCAL_COPY_HEADERS := \
         include/pvmf_basic_errorinfomessage.h \
         include/pvmf_errorinfomessage_extension.h \
         include/pvmi_media_io_clock_extension.h \
+        include/pvmi_media_transfer_batch_extension.h \
         include/pvmf_fileformat_events.h \
         include/pvmi_kvp_util.h \
         include/pvmf_mempool.h \
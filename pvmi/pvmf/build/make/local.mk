@@ -15,6 +15,7 @@ SRCS := pvmf_format_type.cpp \
 	pvmf_media_cmd.cpp \
 	pvmf_media_data.cpp \
 	pvmf_port_base_impl.cpp \
+	pvmf_telemetry.cpp \
 	pvmf_timestamp.cpp \
 	pvmf_simple_media_buffer.cpp \
 	pvmi_config_and_capability_utils.cpp \
@@ -40,6 +41,7 @@ HDRS :=  pv_interface.h \
          pvmf_media_msg_format_ids.h \
          pvmf_media_cmd.h \
          pvmf_port_base_impl.h \
+         pvmf_telemetry.h \
          pvmi_config_and_capability_utils.h \
          pvmf_media_data.h \
          pvmf_port_interface.h \
@@ -62,6 +64,7 @@ HDRS :=  pv_interface.h \
          pvmf_basic_errorinfomessage.h \
          pvmf_errorinfomessage_extension.h \
          pvmi_media_io_clock_extension.h \
+         pvmi_media_transfer_batch_extension.h \
          pvmf_fileformat_events.h \
          pvmi_kvp_util.h \
          pvmf_mempool.h \
@@ -41,6 +41,11 @@
 #ifndef OSCL_MEM_H_INCLUDED
 #include "oscl_mem.h"
 #endif
+#ifndef PVMF_TELEMETRY_H_INCLUDED
+#include "pvmf_telemetry.h"
+#endif
+
+class PVActiveBase;
 
 typedef struct
 {
@@ -477,10 +482,24 @@ class OSCL_IMPORT_REF PVMFNodeInterface: public PVMFPortActivityHandler
             return iOsclSharedLibrary;
         }
 
+        /**
+         * Retrieves runtime telemetry of this node: Run() time of the node's
+         * active object, if one was registered with SetTelemetryActiveObject,
+         * and the telemetry of each port returned by GetPorts.  Nodes that
+         * don't expose their ports through GetPorts should override this and
+         * call GetNodeTelemetryForPorts.
+         * The call is synchronous and must be made from the node's thread.
+         *
+         * @param aTelemetry Output parameter filled in with the node telemetry.
+         * @returns PVMFSuccess or PVMFErrNoMemory
+         */
+        OSCL_IMPORT_REF virtual PVMFStatus GetNodeTelemetry(PVMFNodeTelemetry& aTelemetry);
+
     protected:
         PVMFNodeInterface(int32 aSessionReserve = PVMF_NODE_DEFAULT_SESSION_RESERVE):
                 iInterfaceState(EPVMFNodeCreated)
                 , iOsclSharedLibrary(NULL)
+                , iTelemetryAO(NULL)
         {
             iSessions.reserve(aSessionReserve);
         }
@@ -490,6 +509,27 @@ class OSCL_IMPORT_REF PVMFNodeInterface: public PVMFPortActivityHandler
 
         OsclSharedLibrary* iOsclSharedLibrary;
 
+        /** Nodes that are active objects call this, typically from the
+         ** constructor, so GetNodeTelemetry can report their Run() time.
+         */
+        void SetTelemetryActiveObject(PVActiveBase* aActiveObject)
+        {
+            iTelemetryAO = aActiveObject;
+        }
+
+        /** Appends the telemetry of aPort to aTelemetry, if the port keeps any.
+         */
+        OSCL_IMPORT_REF void AddPortTelemetry(PVMFNodeTelemetry& aTelemetry, PVMFPortInterface* aPort);
+
+        /** GetNodeTelemetry for nodes that don't expose their ports through
+         ** GetPorts: fills in the base telemetry, then adds the given ports.
+         ** Entries of aPorts may be NULL.
+         */
+        OSCL_IMPORT_REF PVMFStatus GetNodeTelemetryForPorts(PVMFNodeTelemetry& aTelemetry,
+                PVMFPortInterface* const* aPorts, uint32 aNumPorts);
+
+        PVActiveBase* iTelemetryAO;
+
         /** This method can be used to update the state and
          ** notify observers of the state change event.
          */
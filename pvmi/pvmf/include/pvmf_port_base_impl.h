@@ -39,6 +39,9 @@
 #ifndef PVMF_MEDIA_DATA_H_INCLUDED
 #include "pvmf_media_data.h"
 #endif
+#ifndef PVMF_TELEMETRY_H_INCLUDED
+#include "pvmf_telemetry.h"
+#endif
 
 /**
  * When this macro is defined to 1, statistics of this port will be tracked and can be
@@ -70,6 +73,16 @@ class PvmfPortBaseImplQueue
 
         Oscl_Queue<PVMFSharedMediaMsgPtr, OsclMemAllocator> iQ;
 
+        // Telemetry, always collected.  Must be called around every push/pop of iQ.
+        void TelemetryPush();
+        void TelemetryPop();
+        void TelemetryClear();
+        void TelemetryReset();
+        Oscl_Queue<uint32, OsclMemAllocator> iEnqueueTime; /**< Enqueue time of each queued message */
+        uint32 iMsgCount;
+        PVMFTelemetryHistogram iDepth;
+        PVMFTelemetryHistogram iQueueTime;
+
         // Flow control
         uint32 iCapacity;
         uint32 iThresholdPercent; /**< Threshold for allowing new messages, in terms of percentage of capacity. */
@@ -207,6 +220,14 @@ class PvmfPortBaseImpl : public PVMFPortInterface
          */
         OSCL_IMPORT_REF PVMFStatus GetStats(PvmfPortBaseImplStats& aStats);
 
+        /**
+         * Return runtime telemetry of this port.  Unlike GetStats this is
+         * available in all builds.
+         * @param aTelemetry Output parameter where port telemetry will be reported to.
+         * @return Completion status.
+         */
+        OSCL_IMPORT_REF PVMFStatus GetPortTelemetry(PVMFPortTelemetry& aTelemetry);
+
         /**
          * Reports port activity to the activity handler (usually
          * the node).
@@ -243,6 +264,8 @@ class PvmfPortBaseImpl : public PVMFPortInterface
         // Logging and statistics
         PVLogger* iLogger;
         PvmfPortBaseImplStats iStats;
+        uint32 iTelemetryStartUsec;
+        void ResetTelemetry();
 
         //For datapath logging.  If a port name is provided, either in
         //the constructor or by calling SetName, then datapath logging will
@@ -41,6 +41,7 @@
 // Forward declaration
 class PVMFNodeInterface;
 class PVMFPortInterface;
+class PVMFPortTelemetry;
 
 /**
  * Enumerated list of port activity. This enumerated type is used to notify the owner
@@ -251,6 +252,19 @@ class PVMFPortInterface
          */
         virtual PVMFStatus PeerDisconnect() = 0;
 
+        /**
+         * Retrieves runtime telemetry of this port: message counts, queue depth
+         * and time-in-queue histograms since the port was last connected.
+         *
+         * @param aTelemetry Output parameter filled in with the port telemetry.
+         * @return PVMFSuccess, or PVMFErrNotSupported if the port does not keep telemetry.
+         */
+        virtual PVMFStatus GetPortTelemetry(PVMFPortTelemetry& aTelemetry)
+        {
+            OSCL_UNUSED_ARG(aTelemetry);
+            return PVMFErrNotSupported;
+        }
+
     protected:
         PVMFPortInterface()
                 : iConnectedPort(NULL)
@@ -0,0 +1,172 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#ifndef PVMF_TELEMETRY_H_INCLUDED
+#define PVMF_TELEMETRY_H_INCLUDED
+
+#ifndef OSCL_BASE_H_INCLUDED
+#include "oscl_base.h"
+#endif
+#ifndef OSCL_TIME_H_INCLUDED
+#include "oscl_time.h"
+#endif
+#ifndef OSCL_VECTOR_H_INCLUDED
+#include "oscl_vector.h"
+#endif
+#ifndef OSCL_STRING_H_INCLUDED
+#include "oscl_string.h"
+#endif
+#ifndef OSCL_MEM_H_INCLUDED
+#include "oscl_mem.h"
+#endif
+
+/**
+ * Number of histogram buckets.  Bucket 0 holds zero values, bucket i holds
+ * values in [2^(i-1), 2^i) and the last bucket holds everything larger.
+ * With microsecond samples the last bucket starts at about 0.5 seconds.
+ */
+#define PVMF_TELEMETRY_HISTOGRAM_BUCKETS 20
+
+/**
+ * Returns a free-running microsecond counter for telemetry timestamps.
+ * Only differences between two values are meaningful; the counter wraps
+ * roughly every 71 minutes.
+ */
+inline uint32 PVMFTelemetryTimeUsec()
+{
+    TimeValue now;
+    return now.get_sec() * 1000000 + now.get_usec();
+}
+
+/**
+ * Log2-bucketed histogram used for queue depths and time-in-queue samples.
+ * Percentiles are reported as the upper bound of the bucket in which they
+ * fall, which is accurate to within a factor of two.
+ */
+class PVMFTelemetryHistogram
+{
+    public:
+        PVMFTelemetryHistogram()
+        {
+            Reset();
+        }
+
+        void Reset()
+        {
+            oscl_memset(iBucket, 0, sizeof(iBucket));
+            iCount = 0;
+            iSum = 0;
+            iMax = 0;
+        }
+
+        void Add(uint32 aValue)
+        {
+            uint32 bucket = 0;
+            uint32 v = aValue;
+            while (v && bucket < PVMF_TELEMETRY_HISTOGRAM_BUCKETS - 1)
+            {
+                v >>= 1;
+                bucket++;
+            }
+            iBucket[bucket]++;
+            iCount++;
+            iSum += aValue;
+            if (aValue > iMax)
+                iMax = aValue;
+        }
+
+        uint32 Mean() const
+        {
+            return iCount ? (uint32)(iSum / iCount) : 0;
+        }
+
+        /**
+         * Returns the value below which aPercent percent of the samples fall.
+         * @param aPercent Percentile between 0 and 100.
+         */
+        OSCL_IMPORT_REF uint32 Percentile(uint32 aPercent) const;
+
+        uint32 iBucket[PVMF_TELEMETRY_HISTOGRAM_BUCKETS];
+        uint32 iCount;
+        uint64 iSum;
+        uint32 iMax;
+};
+
+/** Runtime telemetry for one port, see PVMFPortInterface::GetPortTelemetry */
+class PVMFPortTelemetry
+{
+    public:
+        PVMFPortTelemetry()
+                : iPortTag(0)
+                , iConnected(false)
+                , iElapsedUsec(0)
+                , iIncomingMsgs(0)
+                , iOutgoingMsgs(0)
+        {}
+
+        int32 iPortTag;
+        bool iConnected;
+        uint32 iElapsedUsec;        /**< Time since the counters were last reset (connect) */
+        uint32 iIncomingMsgs;       /**< Messages received into the incoming queue */
+        uint32 iOutgoingMsgs;       /**< Messages queued for the connected port */
+        PVMFTelemetryHistogram iIncomingDepth;      /**< Incoming queue depth, sampled on each enqueue */
+        PVMFTelemetryHistogram iOutgoingDepth;      /**< Outgoing queue depth, sampled on each enqueue */
+        PVMFTelemetryHistogram iIncomingQueueTime;  /**< Microseconds between Receive and dequeue by the node */
+        PVMFTelemetryHistogram iOutgoingQueueTime;  /**< Microseconds between QueueOutgoingMsg and delivery */
+};
+
+/** Runtime telemetry for one node, see PVMFNodeInterface::GetNodeTelemetry */
+class PVMFNodeTelemetry
+{
+    public:
+        PVMFNodeTelemetry()
+                : iRunTimeValid(false)
+                , iRunCount(0)
+                , iRunTimeUsec(0)
+                , iMaxRunUsec(0)
+        {
+            iName[0] = '\0';
+        }
+
+        char iName[32];             /**< Active object name, when known */
+        bool iRunTimeValid;         /**< False if the node does not report its Run() time */
+        uint32 iRunCount;           /**< Number of Run() calls */
+        uint64 iRunTimeUsec;        /**< Total time spent in Run() */
+        uint32 iMaxRunUsec;         /**< Longest single Run() call */
+        Oscl_Vector<PVMFPortTelemetry, OsclMemAllocator> iPorts;
+};
+
+/**
+ * Helpers to export telemetry as JSON so it can be dumped from a live
+ * graph and compared offline.
+ */
+class PVMFTelemetryJSON
+{
+    public:
+        /**
+         * Appends a JSON object describing the node and its ports.
+         * @param aOut String to append to.
+         * @param aLabel Role of the node in the graph, e.g. "source" (may be NULL).
+         */
+        OSCL_IMPORT_REF static void AppendNode(OSCL_String& aOut, const char* aLabel, const PVMFNodeTelemetry& aNode);
+        OSCL_IMPORT_REF static void AppendPort(OSCL_String& aOut, const PVMFPortTelemetry& aPort);
+
+    private:
+        static void AppendHistogram(OSCL_String& aOut, const char* aName, const PVMFTelemetryHistogram& aHist);
+};
+
+#endif // PVMF_TELEMETRY_H_INCLUDED
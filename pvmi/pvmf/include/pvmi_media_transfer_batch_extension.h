@@ -0,0 +1,112 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/**
+ * @file pvmi_media_transfer_batch_extension.h
+ * @brief Extension interface for batched media transfer to media i/o components
+ */
+
+#ifndef PVMI_MEDIA_TRANSFER_BATCH_EXTENSION_H_INCLUDED
+#define PVMI_MEDIA_TRANSFER_BATCH_EXTENSION_H_INCLUDED
+
+#ifndef OSCL_BASE_H_INCLUDED
+#include "oscl_base.h"
+#endif
+#ifndef PVMI_MEDIA_TRANSFER_H_INCLUDED
+#include "pvmi_media_transfer.h"
+#endif
+#ifndef PV_UUID_H_INCLUDED
+#include "pv_uuid.h"
+#endif
+#ifndef PV_INTERFACE_H_INCLUDED
+#include "pv_interface.h"
+#endif
+
+
+#define PvmiMediaTransferBatchExtensionInterfaceUuid PVUuid(0x4be99587,0x9007,0x47eb,0x8f,0x87,0x1e,0xf2,0x82,0x9c,0x22,0x98)
+
+/* One buffer of a batched write, with the info that would go with it in writeAsync */
+typedef struct __PvmiMediaXferBatchEntry
+{
+    uint8* data;
+    uint32 data_len;
+    PvmiMediaXferHeader data_header_info;
+} PvmiMediaXferBatchEntry;
+
+/**
+ * PvmiMediaTransferBatchExtensionInterface lets the writer of a media
+ * transfer hand the media I/O component several buffers in one call.
+ * A media I/O component advertises it through PvmiMIOControl::QueryInterface.
+ *
+ * A batch is accepted or refused as a whole.  An accepted batch is completed
+ * with a single writeComplete call, with the command id returned by
+ * writeBatchAsync, on the peer set on the component's media transfer.
+ * Every buffer of the batch may be reused once that call is made.
+ */
+class PvmiMediaTransferBatchExtensionInterface : public PVInterface
+{
+    public:
+        /**
+         * Register a reference to this interface.
+         */
+        virtual void addRef() = 0;
+
+        /**
+         * Remove a reference to this interface.
+         */
+        virtual void removeRef() = 0;
+
+        /**
+         * Query for an instance of a particular interface.
+         *
+         * @param uuid Uuid of the requested interface
+         * @param iface Output parameter where pointer to an instance of the
+         * requested interface will be stored if it is supported by this object
+         * @return true if the requested interface is supported, else false
+         */
+        virtual bool queryInterface(const PVUuid& uuid, PVInterface*& iface) = 0;
+
+        /**
+         * Returns the largest number of entries the component accepts in one
+         * writeBatchAsync call.
+         */
+        virtual uint32 getMaxBatchEntries() = 0;
+
+        /**
+         * Writes a batch of buffers of the same format, in order.
+         *
+         * @param format_type          Identifies whether the buffers are data/command/notification
+         * @param format_index         As for writeAsync
+         * @param entries              The buffers and the info associated with each one
+         * @param num_entries          Number of entries, at most getMaxBatchEntries()
+         * @param aContext             Optional opaque data to be passed back to
+         *                             user with the writeComplete response
+         *
+         * @returns    A unique command id for the whole batch.
+         * @throw  if the batch is not accepted, it leaves with an appropriate error
+         *         code and none of the entries have been taken.  A Busy leave
+         *         is resolved by a statusUpdate call, as for writeAsync.
+         */
+        virtual PVMFCommandId writeBatchAsync(uint8 format_type, int32 format_index,
+                                              const PvmiMediaXferBatchEntry* entries,
+                                              uint32 num_entries,
+                                              OsclAny* aContext = NULL) = 0;
+};
+
+#endif // PVMI_MEDIA_TRANSFER_BATCH_EXTENSION_H_INCLUDED
+
+
@@ -17,6 +17,8 @@
  */
 
 #include "pvmf_node_interface.h"
+#include "oscl_scheduler_ao.h"
+#include "oscl_error.h"
 
 // TODO: Both the info and error handling look very similar, we should
 // try to refactor them at some point (but beware of the info/error
@@ -126,3 +128,66 @@ OSCL_EXPORT_REF void PVMFNodeInterface::ReportInfoEvent(
         }
     }
 }
+
+OSCL_EXPORT_REF PVMFStatus PVMFNodeInterface::GetNodeTelemetry(PVMFNodeTelemetry& aTelemetry)
+{
+    aTelemetry.iPorts.clear();
+    aTelemetry.iRunTimeValid = false;
+    aTelemetry.iName[0] = '\0';
+
+    if (iTelemetryAO)
+    {
+        oscl_strncpy(aTelemetry.iName, (const char*)iTelemetryAO->iName.Str(), sizeof(aTelemetry.iName) - 1);
+        aTelemetry.iName[sizeof(aTelemetry.iName) - 1] = '\0';
+        aTelemetry.iRunTimeValid = true;
+        aTelemetry.iRunCount = iTelemetryAO->iRunCount;
+        aTelemetry.iRunTimeUsec = iTelemetryAO->iRunTimeUsec;
+        aTelemetry.iMaxRunUsec = iTelemetryAO->iMaxRunUsec;
+    }
+
+    int32 err = OsclErrNone;
+    OSCL_TRY(err,
+             PVMFPortIter* iter = GetPorts();
+             if (iter)
+             {
+                 iter->Reset();
+                 PVMFPortInterface* port;
+                 while ((port = iter->GetNext()) != NULL)
+                     AddPortTelemetry(aTelemetry, port);
+             }
+            );
+    OSCL_FIRST_CATCH_ANY(err,
+                         return PVMFErrNoMemory;
+                        );
+    return PVMFSuccess;
+}
+
+OSCL_EXPORT_REF PVMFStatus PVMFNodeInterface::GetNodeTelemetryForPorts(PVMFNodeTelemetry& aTelemetry,
+        PVMFPortInterface* const* aPorts, uint32 aNumPorts)
+{
+    PVMFStatus status = PVMFNodeInterface::GetNodeTelemetry(aTelemetry);
+    if (status != PVMFSuccess)
+        return status;
+
+    int32 err = OsclErrNone;
+    OSCL_TRY(err,
+             for (uint32 i = 0; i < aNumPorts; i++)
+                 AddPortTelemetry(aTelemetry, aPorts[i]);
+            );
+    OSCL_FIRST_CATCH_ANY(err,
+                         return PVMFErrNoMemory;
+                        );
+    return PVMFSuccess;
+}
+
+OSCL_EXPORT_REF void PVMFNodeInterface::AddPortTelemetry(PVMFNodeTelemetry& aTelemetry, PVMFPortInterface* aPort)
+{
+    if (!aPort)
+        return;
+
+    PVMFPortTelemetry portTelemetry;
+    if (aPort->GetPortTelemetry(portTelemetry) == PVMFSuccess)
+    {
+        aTelemetry.iPorts.push_back(portTelemetry);
+    }
+}
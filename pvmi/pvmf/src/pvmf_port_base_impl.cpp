@@ -41,7 +41,10 @@ void PvmfPortBaseImplQueue::Construct(uint32 aCap, uint32 aReserve, uint32 aThre
     iCapacity = aCap;
 
     if (aReserve > 0)
+    {
         iQ.reserve(aReserve);
+        iEnqueueTime.reserve(aReserve);
+    }
 
     if (aThresh > 100)
         aThresh = 100;
@@ -62,6 +65,7 @@ PVMFStatus PvmfPortBaseImplQueue::SetReserve(uint32 aReserve)
     if (aReserve > 0)
     {
         iQ.reserve(aReserve);
+        iEnqueueTime.reserve(aReserve);
         return PVMFSuccess;
     }
     return PVMFFailure;
@@ -77,6 +81,41 @@ PVMFStatus PvmfPortBaseImplQueue::SetThreshold(uint32 aThresh)
     return PVMFSuccess;
 }
 
+void PvmfPortBaseImplQueue::TelemetryPush()
+{
+    //called after the message is pushed on iQ.
+    iEnqueueTime.push(PVMFTelemetryTimeUsec());
+    ++iMsgCount;
+    iDepth.Add(iQ.size());
+}
+
+void PvmfPortBaseImplQueue::TelemetryPop()
+{
+    //called before the message is popped from iQ.
+    //a derived port may have popped iQ directly, in which case the
+    //oldest timestamps no longer have a message.
+    while (iEnqueueTime.size() > iQ.size())
+        iEnqueueTime.pop();
+    if (!iEnqueueTime.empty() && iEnqueueTime.size() == iQ.size())
+    {
+        iQueueTime.Add(PVMFTelemetryTimeUsec() - iEnqueueTime.front());
+        iEnqueueTime.pop();
+    }
+}
+
+void PvmfPortBaseImplQueue::TelemetryClear()
+{
+    while (!iEnqueueTime.empty())
+        iEnqueueTime.pop();
+}
+
+void PvmfPortBaseImplQueue::TelemetryReset()
+{
+    iMsgCount = 0;
+    iDepth.Reset();
+    iQueueTime.Reset();
+}
+
 ////////////////////////////////////////////////////////////////////////////
 
 OSCL_EXPORT_REF int32 PvmfPortBaseImpl::GetPortTag() const
@@ -171,6 +210,7 @@ OSCL_EXPORT_REF PvmfPortBaseImpl::PvmfPortBaseImpl(int32 aTag, PVMFPortActivityH
     iLogger = PVLogger::GetLoggerObject("PvmfPortBaseImpl");
     iIncomingQueue.Construct(DEFAULT_DATA_QUEUE_CAPACITY, DEFAULT_DATA_QUEUE_CAPACITY, DEFAULT_READY_TO_RECEIVE_THRESHOLD_PERCENT);
     iOutgoingQueue.Construct(DEFAULT_DATA_QUEUE_CAPACITY, DEFAULT_DATA_QUEUE_CAPACITY, DEFAULT_READY_TO_RECEIVE_THRESHOLD_PERCENT);
+    ResetTelemetry();
     SetName(name);
 }
 
@@ -192,6 +232,7 @@ OSCL_EXPORT_REF PvmfPortBaseImpl::PvmfPortBaseImpl(int32 aTag
     iLogger = PVLogger::GetLoggerObject("PvmfPortBaseImpl");
     iIncomingQueue.Construct(aInCapacity, aInReserve, aInThreshold);
     iOutgoingQueue.Construct(aOutCapacity, aOutReserve, aOutThreshold);
+    ResetTelemetry();
     SetName(name);
 }
 
@@ -269,6 +310,7 @@ OSCL_EXPORT_REF PVMFStatus PvmfPortBaseImpl::Connect(PVMFPortInterface* aPort)
     // Reset statistics
     oscl_memset(&iStats, 0, sizeof(PvmfPortBaseImplStats));
 #endif
+    ResetTelemetry();
 
     PortActivity(PVMF_PORT_ACTIVITY_CONNECT);
     return PVMFSuccess;
@@ -300,6 +342,7 @@ OSCL_EXPORT_REF PVMFStatus PvmfPortBaseImpl::PeerConnect(PVMFPortInterface* aPor
     // Reset statistics
     oscl_memset(&iStats, 0, sizeof(PvmfPortBaseImplStats));
 #endif
+    ResetTelemetry();
 
     PortActivity(PVMF_PORT_ACTIVITY_CONNECT);
     return PVMFSuccess;
@@ -410,6 +453,7 @@ OSCL_EXPORT_REF PVMFStatus PvmfPortBaseImpl::QueueOutgoingMsg(PVMFSharedMediaMsg
     // port queues grow indefinitely (we either a connected port busy or outgoing Q busy
     // before we reach the reserved limit
     iOutgoingQueue.iQ.push(aMsg);
+    iOutgoingQueue.TelemetryPush();
 
 #if PVMF_PORT_BASE_IMPL_STATS
     ++iStats.iOutgoingMsgQueued;
@@ -424,6 +468,7 @@ OSCL_EXPORT_REF PVMFStatus PvmfPortBaseImpl::QueueOutgoingMsg(PVMFSharedMediaMsg
     {
         // Dequeue the message
         PVMFSharedMediaMsgPtr msg = iOutgoingQueue.iQ.front();
+        iOutgoingQueue.TelemetryPop();
         iOutgoingQueue.iQ.pop();
 #if (PVLOGGER_INST_LEVEL > PVLOGMSG_INST_LLDBG)
         //log to datapath
@@ -507,6 +552,7 @@ OSCL_EXPORT_REF PVMFStatus PvmfPortBaseImpl::Send()
     // Dequeue the message
     {
         PVMFSharedMediaMsgPtr msg = iOutgoingQueue.iQ.front();
+        iOutgoingQueue.TelemetryPop();
         iOutgoingQueue.iQ.pop();
 #if (PVLOGGER_INST_LEVEL > PVLOGMSG_INST_LLDBG)
         //log to datapath
@@ -762,6 +808,7 @@ OSCL_EXPORT_REF PVMFStatus PvmfPortBaseImpl::Receive(PVMFSharedMediaMsgPtr aMsg)
     // port queues grow indefinitely (we either a connected port busy or outgoing Q busy
     // before we reach the reserved limit
     iIncomingQueue.iQ.push(aMsg);
+    iIncomingQueue.TelemetryPush();
 
     PortActivity(PVMF_PORT_ACTIVITY_INCOMING_MSG);
 #if PVMF_PORT_BASE_IMPL_STATS
@@ -809,6 +856,7 @@ OSCL_EXPORT_REF PVMFStatus PvmfPortBaseImpl::DequeueIncomingMsg(PVMFSharedMediaM
 
     // Save message to output parameter and remove it from queue
     aMsg = iIncomingQueue.iQ.front();
+    iIncomingQueue.TelemetryPop();
     iIncomingQueue.iQ.pop();
 
 #if (PVLOGGER_INST_LEVEL > PVLOGMSG_INST_LLDBG)
@@ -901,6 +949,7 @@ OSCL_EXPORT_REF PVMFStatus PvmfPortBaseImpl::ClearMsgQueues()
             LogMediaMsgInfo(msg, "In Msg Cleared", iIncomingQueue);
 #endif
     }
+    iIncomingQueue.TelemetryClear();
     if (iIncomingQueue.iBusy)
         EvaluateIncomingBusy();
 
@@ -913,6 +962,7 @@ OSCL_EXPORT_REF PVMFStatus PvmfPortBaseImpl::ClearMsgQueues()
             LogMediaMsgInfo(msg, "Out Msg Cleared", iOutgoingQueue);
 #endif
     }
+    iOutgoingQueue.TelemetryClear();
     if (iOutgoingQueue.iBusy)
         EvaluateOutgoingBusy();
     return PVMFSuccess;
@@ -1047,9 +1097,25 @@ OSCL_EXPORT_REF PVMFStatus PvmfPortBaseImpl::GetStats(PvmfPortBaseImplStats& aSt
 #endif
 }
 
+////////////////////////////////////////////////////////////////////////////
+OSCL_EXPORT_REF PVMFStatus PvmfPortBaseImpl::GetPortTelemetry(PVMFPortTelemetry& aTelemetry)
+{
+    aTelemetry.iPortTag = iTag;
+    aTelemetry.iConnected = (iConnectedPort != NULL);
+    aTelemetry.iElapsedUsec = PVMFTelemetryTimeUsec() - iTelemetryStartUsec;
+    aTelemetry.iIncomingMsgs = iIncomingQueue.iMsgCount;
+    aTelemetry.iOutgoingMsgs = iOutgoingQueue.iMsgCount;
+    aTelemetry.iIncomingDepth = iIncomingQueue.iDepth;
+    aTelemetry.iOutgoingDepth = iOutgoingQueue.iDepth;
+    aTelemetry.iIncomingQueueTime = iIncomingQueue.iQueueTime;
+    aTelemetry.iOutgoingQueueTime = iOutgoingQueue.iQueueTime;
+    return PVMFSuccess;
+}
 
-
-
-
-
-
+////////////////////////////////////////////////////////////////////////////
+void PvmfPortBaseImpl::ResetTelemetry()
+{
+    iIncomingQueue.TelemetryReset();
+    iOutgoingQueue.TelemetryReset();
+    iTelemetryStartUsec = PVMFTelemetryTimeUsec();
+}
@@ -0,0 +1,138 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+
+#include "pvmf_telemetry.h"
+
+#ifndef OSCL_SNPRINTF_H_INCLUDED
+#include "oscl_snprintf.h"
+#endif
+
+#ifndef OSCL_STRING_JSON_H
+#include "oscl_string_json.h"
+#endif
+
+#define PVMF_TELEMETRY_JSON_BUF_SIZE 256
+
+OSCL_EXPORT_REF uint32 PVMFTelemetryHistogram::Percentile(uint32 aPercent) const
+{
+    if (iCount == 0)
+        return 0;
+
+    // rank of the requested sample, rounded up so that the 100th
+    // percentile is the last sample.
+    uint32 rank = (uint32)(((uint64)iCount * aPercent + 99) / 100);
+    if (rank == 0)
+        rank = 1;
+
+    uint32 seen = 0;
+    for (uint32 i = 0; i < PVMF_TELEMETRY_HISTOGRAM_BUCKETS; i++)
+    {
+        seen += iBucket[i];
+        if (seen >= rank)
+        {
+            if (i == 0)
+                return 0;
+            if (i == PVMF_TELEMETRY_HISTOGRAM_BUCKETS - 1)
+                return iMax;
+            uint32 upper = (1 << i) - 1;
+            return (upper < iMax) ? upper : iMax;
+        }
+    }
+    return iMax;
+}
+
+void PVMFTelemetryJSON::AppendHistogram(OSCL_String& aOut, const char* aName, const PVMFTelemetryHistogram& aHist)
+{
+    char buf[PVMF_TELEMETRY_JSON_BUF_SIZE];
+    oscl_snprintf(buf, PVMF_TELEMETRY_JSON_BUF_SIZE,
+                  "\"%s\":{\"count\":%u,\"mean\":%u,\"p50\":%u,\"p90\":%u,\"p99\":%u,\"max\":%u,\"buckets\":[",
+                  aName, aHist.iCount, aHist.Mean(), aHist.Percentile(50), aHist.Percentile(90),
+                  aHist.Percentile(99), aHist.iMax);
+    aOut += buf;
+
+    // trailing empty buckets are left out to keep the output short.
+    int32 last = PVMF_TELEMETRY_HISTOGRAM_BUCKETS - 1;
+    while (last >= 0 && aHist.iBucket[last] == 0)
+        last--;
+    for (int32 i = 0; i <= last; i++)
+    {
+        oscl_snprintf(buf, PVMF_TELEMETRY_JSON_BUF_SIZE, (i == 0) ? "%u" : ",%u", aHist.iBucket[i]);
+        aOut += buf;
+    }
+    aOut += "]}";
+}
+
+OSCL_EXPORT_REF void PVMFTelemetryJSON::AppendPort(OSCL_String& aOut, const PVMFPortTelemetry& aPort)
+{
+    char buf[PVMF_TELEMETRY_JSON_BUF_SIZE];
+
+    // message rates in messages per second, with one decimal place.
+    uint32 inRate = 0;
+    uint32 outRate = 0;
+    if (aPort.iElapsedUsec >= 1000)
+    {
+        uint32 elapsedMsec = aPort.iElapsedUsec / 1000;
+        inRate = (uint32)(((uint64)aPort.iIncomingMsgs * 10000) / elapsedMsec);
+        outRate = (uint32)(((uint64)aPort.iOutgoingMsgs * 10000) / elapsedMsec);
+    }
+
+    oscl_snprintf(buf, PVMF_TELEMETRY_JSON_BUF_SIZE,
+                  "{\"tag\":%d,\"connected\":%s,\"elapsedMs\":%u,\"inMsgs\":%u,\"outMsgs\":%u,\"inRate\":%u.%u,\"outRate\":%u.%u,",
+                  aPort.iPortTag, aPort.iConnected ? "true" : "false", aPort.iElapsedUsec / 1000,
+                  aPort.iIncomingMsgs, aPort.iOutgoingMsgs, inRate / 10, inRate % 10, outRate / 10, outRate % 10);
+    aOut += buf;
+
+    AppendHistogram(aOut, "inDepth", aPort.iIncomingDepth);
+    aOut += ",";
+    AppendHistogram(aOut, "outDepth", aPort.iOutgoingDepth);
+    aOut += ",";
+    AppendHistogram(aOut, "inQueueUs", aPort.iIncomingQueueTime);
+    aOut += ",";
+    AppendHistogram(aOut, "outQueueUs", aPort.iOutgoingQueueTime);
+    aOut += "}";
+}
+
+OSCL_EXPORT_REF void PVMFTelemetryJSON::AppendNode(OSCL_String& aOut, const char* aLabel, const PVMFNodeTelemetry& aNode)
+{
+    char buf[PVMF_TELEMETRY_JSON_BUF_SIZE];
+
+    aOut += "{\"label\":";
+    oscl_str_append_json(aOut, aLabel);
+    aOut += ",\"name\":";
+    oscl_str_append_json(aOut, aNode.iName);
+
+    if (aNode.iRunTimeValid)
+    {
+        // split the 64-bit total, oscl_snprintf has no portable 64-bit conversion.
+        uint32 totalMsec = (uint32)(aNode.iRunTimeUsec / 1000);
+        uint32 meanUsec = aNode.iRunCount ? (uint32)(aNode.iRunTimeUsec / aNode.iRunCount) : 0;
+        oscl_snprintf(buf, PVMF_TELEMETRY_JSON_BUF_SIZE,
+                      ",\"runCount\":%u,\"runTotalMs\":%u,\"runMeanUs\":%u,\"runMaxUs\":%u",
+                      aNode.iRunCount, totalMsec, meanUsec, aNode.iMaxRunUsec);
+        aOut += buf;
+    }
+
+    aOut += ",\"ports\":[";
+    for (uint32 i = 0; i < aNode.iPorts.size(); i++)
+    {
+        if (i > 0)
+            aOut += ",";
+        AppendPort(aOut, aNode.iPorts[i]);
+    }
+    aOut += "]}";
+}